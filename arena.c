@@ -0,0 +1,86 @@
+#include "arena.h"
+
+#include <stdint.h>
+#include <string.h>
+#include "common.h"
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+typedef struct Chunk {
+  struct Chunk *prev;
+  size_t size;  ///< bytes available in data
+  size_t used;
+  _Alignas(ARENA_ALIGN) unsigned char data[];
+} Chunk;
+
+typedef struct Arena {
+  Chunk *chunk;  ///< the chunk being filled; older ones are reachable through prev
+  void *last;  ///< last allocation, which can be grown in place
+  size_t bytes_used;
+} Arena;
+
+static size_t round_up(size_t n) {
+  return (n + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+}
+
+Arena *new_arena(void) {
+  return checked_calloc(1, sizeof(Arena));
+}
+
+static Chunk *new_chunk(Chunk *prev, size_t min_size) {
+  size_t size = min_size > ARENA_CHUNK_SIZE ? min_size : ARENA_CHUNK_SIZE;
+  Chunk *ret = checked_malloc(sizeof(Chunk) + size);
+  ret->prev = prev;
+  ret->size = size;
+  ret->used = 0;
+  return ret;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  size = round_up(size ? size : 1);
+  if (!arena->chunk || arena->chunk->size - arena->chunk->used < size) {
+    arena->chunk = new_chunk(arena->chunk, size);
+  }
+  void *ret = arena->chunk->data + arena->chunk->used;
+  arena->chunk->used += size;
+  arena->bytes_used += size;
+  arena->last = ret;
+  memset(ret, 0, size);
+  return ret;
+}
+
+void *arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t new_size) {
+  if (!ptr) {
+    return arena_alloc(arena, new_size);
+  }
+  if (new_size <= old_size) {
+    return ptr;
+  }
+  Chunk *chunk = arena->chunk;
+  size_t old_rounded = round_up(old_size ? old_size : 1);
+  size_t new_rounded = round_up(new_size);
+  if (ptr == arena->last && chunk->size - chunk->used >= new_rounded - old_rounded) {
+    memset((unsigned char *) ptr + old_rounded, 0, new_rounded - old_rounded);
+    chunk->used += new_rounded - old_rounded;
+    arena->bytes_used += new_rounded - old_rounded;
+    return ptr;
+  }
+  void *ret = arena_alloc(arena, new_size);
+  memcpy(ret, ptr, old_size);
+  return ret;
+}
+
+void free_arena(Arena *arena) {
+  Chunk *chunk = arena->chunk;
+  while (chunk) {
+    Chunk *prev = chunk->prev;
+    free(chunk);
+    chunk = prev;
+  }
+  free(arena);
+}
+
+size_t arena_bytes_used(const Arena *arena) {
+  return arena->bytes_used;
+}
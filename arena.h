@@ -0,0 +1,16 @@
+/** Bump allocator for data that dies together, such as the IR of one function. */
+
+#pragma once
+#include <stddef.h>
+
+typedef struct Arena Arena;
+
+Arena *new_arena(void);
+/** Zeroed memory, aligned for any type. Lives until free_arena. */
+void *arena_alloc(Arena *arena, size_t size);
+/** Grow an allocation of old_size bytes to new_size, in place if it was the last one. The extension is zeroed. */
+void *arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+/** Release everything allocated from arena, and arena itself. */
+void free_arena(Arena *arena);
+/** Total bytes handed out, for statistics */
+size_t arena_bytes_used(const Arena *arena);
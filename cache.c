@@ -0,0 +1,91 @@
+#include "cache.h"
+
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common.h"
+
+uint64_t hash_bytes(uint64_t h, const void *data, size_t n) {
+  const unsigned char *p = data;
+  for (size_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+uint64_t hash_u64(uint64_t h, uint64_t val) {
+  return hash_bytes(h, &val, sizeof(val));
+}
+
+uint64_t hash_str(uint64_t h, const char *s) {
+  // include the terminator so "ab" "c" and "a" "bc" differ
+  return hash_bytes(h, s, strlen(s) + 1);
+}
+
+typedef struct FunctionCache {
+  const char *dir;
+  uint64_t salt;
+  int hits;
+  int misses;
+} FunctionCache;
+
+FunctionCache *new_function_cache(const char *dir, const char *salt) {
+  DIE_IF(mkdir(dir, 0777) == -1 && errno != EEXIST, "could not create cache directory");
+  FunctionCache *ret = checked_calloc(1, sizeof(*ret));
+  *ret = (FunctionCache) {
+    .dir = dir,
+    .salt = hash_str(HASH_INIT, salt),
+  };
+  return ret;
+}
+
+uint64_t function_cache_key(const FunctionCache *cache, uint64_t hash) {
+  return hash_u64(cache->salt, hash);
+}
+
+static char *entry_path(const FunctionCache *cache, uint64_t key) {
+  return fmtstr("%s/%016llx.s", cache->dir, (unsigned long long) key);
+}
+
+char *function_cache_lookup(FunctionCache *cache, uint64_t key) {
+  char *path = entry_path(cache, key);
+  FILE *in = fopen(path, "r");
+  free(path);
+  if (!in) {
+    cache->misses++;
+    return 0;
+  }
+  DIE_IF(fseek(in, 0, SEEK_END) == -1, "seek end");
+  long size = ftell(in);
+  DIE_IF(size == -1, "ftell");
+  DIE_IF(fseek(in, 0, SEEK_SET) == -1, "seek begin");
+  char *buf = checked_malloc(size + 1);
+  DIE_IF(fread(buf, 1, size, in) < (size_t) size, "fread did not read enough characters");
+  buf[size] = '\0';
+  checked_fclose(in);
+  cache->hits++;
+  return buf;
+}
+
+void function_cache_store(FunctionCache *cache, uint64_t key, const char *text) {
+  // Write to a private file and rename it into place, so concurrent compilers never see a partial entry.
+  char *path = entry_path(cache, key);
+  char *tmp_path = fmtstr("%s.%d.tmp", path, (int) getpid());
+  FILE *out = fopen(tmp_path, "w");
+  if (out) {
+    size_t len = strlen(text);
+    int ok = fwrite(text, 1, len, out) == len;
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmp_path, path) == -1) {
+      unlink(tmp_path);
+    }
+  }
+  free(tmp_path);
+  free(path);
+}
+
+void fprint_function_cache_stats(FILE *f, const FunctionCache *cache) {
+  fprintf(f, "function cache %s: %d hits, %d misses\n", cache->dir, cache->hits, cache->misses);
+}
@@ -0,0 +1,28 @@
+/** On-disk cache of emitted code for function definitions, keyed by a hash of their tokens and dependencies. */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// FNV-1a, 64 bits. Not cryptographic, but cheap and stable across runs and platforms.
+#define HASH_INIT 14695981039346656037ULL
+uint64_t hash_bytes(uint64_t h, const void *data, size_t n);
+uint64_t hash_u64(uint64_t h, uint64_t val);
+uint64_t hash_str(uint64_t h, const char *s);
+
+typedef struct FunctionCache FunctionCache;
+
+/**
+ * Open the cache stored in directory dir, creating it if it does not exist. Keys are salted with salt, which should
+ * describe everything besides the source that changes the output (backend, options...).
+ */
+FunctionCache *new_function_cache(const char *dir, const char *salt);
+/** Return the cached text for key, or NULL on a miss. The caller owns the returned buffer. */
+char *function_cache_lookup(FunctionCache *cache, uint64_t key);
+/** Store text under key. Failing to write is not an error; the entry is simply not cached. */
+void function_cache_store(FunctionCache *cache, uint64_t key, const char *text);
+/** Salt a key computed by the parser. */
+uint64_t function_cache_key(const FunctionCache *cache, uint64_t hash);
+/** Print hit/miss counts to f */
+void fprint_function_cache_stats(FILE *f, const FunctionCache *cache);
@@ -116,6 +116,8 @@ char *fmtstr(const char *format, ...);
 // Basic utilities
 #define MIN(x, y) (x) < (y) ? (x) : (y)
 #define MAX(x, y) (x) > (y) ? (x) : (y)
+/** Round x up to a multiple of the power of two n */
+#define ROUND_UP(x, n) (((x) + (n) - 1) & -(n))
 
 typedef struct {
   ExceptionKind kind;
@@ -0,0 +1,277 @@
+#include <assert.h>
+#include <stdarg.h>
+#include <string.h>
+#include "fanout_visitor.h"
+#include "common.h"
+
+typedef struct {
+  const Type *type;  ///< type given by the first child that produced a value
+  void *values[];  ///< one per child, in order; NULL where the child returned NULL
+} FanoutValue;
+
+typedef struct {
+  Visitor _visitor;
+  int n_children;
+  Visitor **children;
+  char *function_text;  ///< function texts of all children, each prefixed by its length
+  size_t function_text_size;
+} FanoutVisitor;
+
+#define FOR_EACH_CHILD(v, c, i) \
+  for (int i = 0; i < (v)->n_children; i++) \
+    for (Visitor *c = (v)->children[i]; c; c = 0)
+
+static const Type *type_of(const FanoutValue *val) {
+  return val->type;
+}
+
+static void *child_value(const FanoutValue *val, int i) {
+  return val ? val->values[i] : 0;
+}
+
+void *fanout_value(const void *value, int i) {
+  return child_value(value, i);
+}
+
+static FanoutValue *new_value(FanoutVisitor *v) {
+  return checked_calloc(1, sizeof(FanoutValue) + v->n_children * sizeof(void *));
+}
+
+/** Take the type from the first child that produced a value; if none did, the tuple itself is NULL. */
+static FanoutValue *finish_value(FanoutVisitor *v, FanoutValue *ret) {
+  FOR_EACH_CHILD(v, c, i) {
+    if (ret->values[i]) {
+      ret->type = c->type_of(ret->values[i]);
+      return ret;
+    }
+  }
+  free(ret);
+  return 0;
+}
+
+static FanoutValue *convert_type(FanoutVisitor *v, FanoutValue *value, const Type *new_type) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->convert_type(c, child_value(value, i), new_type);
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_float_literal(FanoutVisitor *v, double double_val) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_float_literal(c, double_val);
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_integer_literal(FanoutVisitor *v, int64_t int64_val) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_integer_literal(c, int64_val);
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_binop(FanoutVisitor *v, TokenKind op, FanoutValue *left, FanoutValue *right) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_binop(c, op, child_value(left, i), child_value(right, i));
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_assign(FanoutVisitor *v, TokenKind op, FanoutValue *left, FanoutValue *right) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_assign(c, op, child_value(left, i), child_value(right, i));
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_declaration(FanoutVisitor *v, const Type *type, const char *ident) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_declaration(c, type, ident);
+  }
+  return finish_value(v, ret);
+}
+
+static void visit_function_definition_start(
+  FanoutVisitor *v,
+  const char *ident,
+  const Type *type,
+  FunctionSpecifiers specifiers
+) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_function_definition_start(c, ident, type, specifiers);
+  }
+}
+
+static FanoutValue *visit_function_definition_param(FanoutVisitor *v, const Type *type, const char *ident) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_function_definition_param(c, type, ident);
+  }
+  return finish_value(v, ret);
+}
+
+static void visit_function_end(FanoutVisitor *v) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_function_end(c);
+  }
+}
+
+static void visit_return(FanoutVisitor *v, FanoutValue *retval) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_return(c, child_value(retval, i));
+  }
+}
+
+static FanoutValue *visit_array_reference(FanoutVisitor *v, FanoutValue *array, FanoutValue *index, int lvalue) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_array_reference(c, child_value(array, i), child_value(index, i), lvalue);
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_struct_reference(FanoutVisitor *v, FanoutValue *left, const Member *member) {
+  FanoutValue *ret = new_value(v);
+  FOR_EACH_CHILD(v, c, i) {
+    ret->values[i] = c->visit_struct_reference(c, child_value(left, i), member);
+  }
+  return finish_value(v, ret);
+}
+
+static FanoutValue *visit_call(FanoutVisitor *v, FanoutValue *function, int n_args, FanoutValue **args) {
+  FanoutValue *ret = new_value(v);
+  void **child_args = checked_calloc(n_args + 1, sizeof(void *));
+  FOR_EACH_CHILD(v, c, i) {
+    for (int k = 0; k < n_args; k++) {
+      child_args[k] = child_value(args[k], i);
+    }
+    ret->values[i] = c->visit_call(c, child_value(function, i), n_args, child_args);
+  }
+  free(child_args);
+  return finish_value(v, ret);
+}
+
+static void visit_zero_object(FanoutVisitor *v, FanoutValue *object) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_zero_object(c, child_value(object, i));
+  }
+}
+
+static void visit_assign_offset(FanoutVisitor *v, FanoutValue *aggregate, int offset, FanoutValue *right) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_assign_offset(c, child_value(aggregate, i), offset, child_value(right, i));
+  }
+}
+
+/** One label per child, in order */
+static void **new_label(FanoutVisitor *v) {
+  void **ret = checked_calloc(v->n_children, sizeof(void *));
+  FOR_EACH_CHILD(v, c, i) {
+    ret[i] = c->new_label(c);
+  }
+  return ret;
+}
+
+static void visit_label(FanoutVisitor *v, void **label) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_label(c, label[i]);
+  }
+}
+
+static void visit_jump(FanoutVisitor *v, void **label) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_jump(c, label[i]);
+  }
+}
+
+static void visit_branch(FanoutVisitor *v, FanoutValue *cond, int jump_if, void **label) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->visit_branch(c, child_value(cond, i), jump_if, label[i]);
+  }
+}
+
+static void visit_switch(FanoutVisitor *v, FanoutValue *value, int n_cases, const int64_t *values, void ***labels,
+  void **default_label) {
+  void **child_labels = checked_calloc(n_cases + 1, sizeof(void *));
+  FOR_EACH_CHILD(v, c, i) {
+    for (int k = 0; k < n_cases; k++) {
+      child_labels[k] = labels[k][i];
+    }
+    c->visit_switch(c, child_value(value, i), n_cases, values, child_labels, default_label[i]);
+  }
+  free(child_labels);
+}
+
+static void seal_label(FanoutVisitor *v, void **label) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->seal_label(c, label[i]);
+  }
+}
+
+static void emit_comment(FanoutVisitor *v, const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  char *comment;
+  DIE_IF(vasprintf(&comment, fmt, ap) == -1, "vasprintf failed to allocate");
+  va_end(ap);
+  FOR_EACH_CHILD(v, c, i) {
+    c->emit_comment(c, "%s", comment);
+  }
+  free(comment);
+}
+
+/**
+ * The texts of all children, each as its decimal length, a newline, then the text itself, so that
+ * visit_cached_function can hand each child its own part. NULL if any child produces no text, which makes the
+ * function uncacheable.
+ */
+static const char *function_text(FanoutVisitor *v) {
+  free(v->function_text);
+  v->function_text = 0;
+  FILE *out = checked_open_memstream(&v->function_text, &v->function_text_size);
+  FOR_EACH_CHILD(v, c, i) {
+    const char *text = c->function_text(c);
+    if (!text) {
+      checked_fclose(out);
+      return 0;
+    }
+    fprintf(out, "%zu\n%s", strlen(text), text);
+  }
+  checked_fclose(out);
+  return v->function_text;
+}
+
+static void visit_cached_function(FanoutVisitor *v, const char *text) {
+  FOR_EACH_CHILD(v, c, i) {
+    char *end;
+    size_t len = strtoul(text, &end, 10);
+    THROW_IF(*end != '\n' || strlen(end + 1) < len, EXC_SYSTEM, "corrupt fan-out function text");
+    char *child_text = strndup(end + 1, len);
+    c->visit_cached_function(c, child_text);
+    free(child_text);
+    text = end + 1 + len;
+  }
+}
+
+static void finalize(FanoutVisitor *v) {
+  FOR_EACH_CHILD(v, c, i) {
+    c->finalize(c);
+  }
+}
+
+Visitor *new_fanout_visitor(int n_children, Visitor **children) {
+  assert(n_children > 0);
+  FanoutVisitor *v = checked_calloc(1, sizeof(FanoutVisitor));
+  INSTALL_VISITOR_METHODS(v)
+  copy_primitive_types((Visitor *) v, children[0]);
+  v->n_children = n_children;
+  v->children = checked_calloc(n_children, sizeof(Visitor *));
+  memcpy(v->children, children, n_children * sizeof(Visitor *));
+  return (Visitor *) v;
+}
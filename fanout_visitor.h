@@ -0,0 +1,14 @@
+/** Fan-out: drive several backends with one parse. */
+
+#pragma once
+#include "visitor.h"
+
+/**
+ * A visitor that forwards every call to each of children, in order, and returns the tuple of their values. Each child
+ * only ever sees its own value objects. Primitive types and type_of come from the first child, so the children must
+ * agree on type layout.
+ */
+Visitor *new_fanout_visitor(int n_children, Visitor **children);
+
+/** The value that child i produced, given a value returned by a fan-out visitor. */
+void *fanout_value(const void *value, int i);
@@ -0,0 +1,457 @@
+#include <assert.h>
+#include <stdarg.h>
+#include <string.h>
+#include "fold_visitor.h"
+#include "common.h"
+
+typedef struct {
+  const Type *type;
+  int is_const;
+  union {
+    int64_t int_val;  ///< for integer constants, already converted to type
+    double float_val;  ///< for floating constants
+  };
+  void *inner;  ///< value object of the inner visitor; for constants, NULL until materialized
+} FoldValue;
+
+typedef struct {
+  Visitor _visitor;
+  Visitor *inner;  ///< NULL for the constant evaluator
+  int n_folded;
+} FoldingVisitor;
+
+static const Type *type_of(const FoldValue *val) {
+  return val->type;
+}
+
+static Visitor *backend(FoldingVisitor *v) {
+  THROW_IF(!v->inner, EXC_PARSE_SYNTAX, "expected a constant expression");
+  return v->inner;
+}
+
+static FoldValue *new_constant(const Type *type) {
+  FoldValue *ret = checked_calloc(1, sizeof(*ret));
+  ret->type = type;
+  ret->is_const = 1;
+  return ret;
+}
+
+static FoldValue *wrap(FoldingVisitor *v, void *inner_val) {
+  if (!inner_val)
+    return 0;
+  FoldValue *ret = checked_calloc(1, sizeof(*ret));
+  ret->type = v->inner->type_of(inner_val);
+  ret->inner = inner_val;
+  return ret;
+}
+
+static int is_same_type(const Type *t1, const Type *t2) {
+  return t1->kind == t2->kind && t1->size == t2->size && (t1->kind != TY_INTEGER || t1->is_unsigned == t2->is_unsigned);
+}
+
+/** Materialize a constant in the inner visitor the first time a non-constant operation needs it. */
+static void *unwrap(FoldingVisitor *v, FoldValue *val) {
+  if (!val)
+    return 0;
+  if (val->inner)
+    return val->inner;
+  assert(val->is_const);
+  Visitor *inner = backend(v);
+  void *lit = val->type->kind == TY_FLOAT
+    ? inner->visit_float_literal(inner, val->float_val)
+    : inner->visit_integer_literal(inner, val->int_val);
+  if (!is_same_type(inner->type_of(lit), val->type)) {
+    lit = inner->convert_type(inner, lit, val->type);
+  }
+  val->inner = lit;
+  return lit;
+}
+
+/** Convert val to the integer type, i.e. truncate to its width and sign or zero extend back to 64 bits. */
+static int64_t wrap_to_type(int64_t val, const Type *type) {
+  int bits = type->size * 8;
+  if (bits >= 64)
+    return val;
+  uint64_t mask = (1ULL << bits) - 1;
+  uint64_t u = (uint64_t) val & mask;
+  if (!type->is_unsigned && (u >> (bits - 1)))
+    u |= ~mask;
+  return (int64_t) u;
+}
+
+static int fits_type(int64_t val, const Type *type) {
+  return wrap_to_type(val, type) == val;
+}
+
+static int is_comparison(TokenKind op) {
+  switch (op) {
+    case TOK_LT_OP: case TOK_RT_OP: case TOK_LE_OP: case TOK_GE_OP: case TOK_EQ_OP: case TOK_NE_OP:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+/** Operations whose behavior is undefined cannot be folded, and make a constant expression invalid. */
+static FoldValue *undefined(FoldingVisitor *v, const char *what) {
+  THROWF_IF(!v->inner, EXC_PARSE_SYNTAX, "%s in constant expression", what);
+  fprintf(stderr, "WARNING: %s; not folded\n", what);
+  return 0;
+}
+
+/** Signed overflow is undefined too, but it is folded with the wraparound the hardware would produce. */
+static void overflow(FoldingVisitor *v) {
+  THROW_IF(!v->inner, EXC_PARSE_SYNTAX, "integer overflow in constant expression");
+  fprintf(stderr, "WARNING: integer overflow in constant folding; result wraps around\n");
+}
+
+/** Evaluate op on integer constants, or return NULL if it cannot be done at compile time. */
+static FoldValue *fold_integer(FoldingVisitor *v, TokenKind op, const FoldValue *left, const FoldValue *right) {
+  if (op == TOK_AND_OP || op == TOK_OR_OP) {
+    FoldValue *ret = new_constant(&v->_visitor.int_type);
+    ret->int_val = op == TOK_AND_OP ? (left->int_val && right->int_val) : (left->int_val || right->int_val);
+    return ret;
+  }
+
+  // Shifts convert each operand separately and have the type of the promoted left operand.
+  int is_shift = op == TOK_LEFT_OP || op == TOK_RIGHT_OP;
+  const Type *type = is_shift
+    ? promoted_type((Visitor *) v, left->type)
+    : common_arithmetic_type((Visitor *) v, left->type, right->type);
+  int bits = type->size * 8;
+  int64_t a = wrap_to_type(left->int_val, type);
+  int64_t b = is_shift ? right->int_val : wrap_to_type(right->int_val, type);
+  uint64_t ua = a, ub = b;
+  int is_unsigned = type->is_unsigned;
+  int64_t exact = 0;  // for signed operations, to detect overflow
+  int64_t min = bits >= 64 ? INT64_MIN : -(1LL << (bits - 1));
+  uint64_t result;
+
+  switch (op) {
+    case TOK_ADD_OP:
+      result = ua + ub;
+      if (!is_unsigned && (__builtin_add_overflow(a, b, &exact) || !fits_type(exact, type)))
+        overflow(v);
+      break;
+    case TOK_SUB_OP:
+      result = ua - ub;
+      if (!is_unsigned && (__builtin_sub_overflow(a, b, &exact) || !fits_type(exact, type)))
+        overflow(v);
+      break;
+    case TOK_STAR_OP:
+      result = ua * ub;
+      if (!is_unsigned && (__builtin_mul_overflow(a, b, &exact) || !fits_type(exact, type)))
+        overflow(v);
+      break;
+    case TOK_DIV_OP: case TOK_MOD_OP:
+      if (b == 0)
+        return undefined(v, "division by zero");
+      if (is_unsigned) {
+        result = op == TOK_DIV_OP ? ua / ub : ua % ub;
+      } else {
+        if (a == min && b == -1)
+          return undefined(v, "signed division overflow");
+        result = op == TOK_DIV_OP ? a / b : a % b;
+      }
+      break;
+    case TOK_LEFT_OP: case TOK_RIGHT_OP:
+      if (b < 0 || b >= bits || (right->type->is_unsigned && (uint64_t) right->int_val >= (uint64_t) bits))
+        return undefined(v, "shift count out of range");
+      if (op == TOK_RIGHT_OP) {
+        // Right shifting a negative value is implementation defined; we shift arithmetically, as x86 sar does.
+        result = is_unsigned ? ua >> b : (uint64_t) (a >> b);
+      } else {
+        result = ua << b;
+        if (!is_unsigned && (a < 0 || (int64_t) result >> b != a || !fits_type((int64_t) result, type)))
+          overflow(v);
+      }
+      break;
+    case TOK_AMPERSAND_OP: result = ua & ub; break;
+    case TOK_BIT_OR_OP: result = ua | ub; break;
+    case TOK_XOR_OP: result = ua ^ ub; break;
+    case TOK_LT_OP: result = is_unsigned ? ua < ub : a < b; break;
+    case TOK_RT_OP: result = is_unsigned ? ua > ub : a > b; break;
+    case TOK_LE_OP: result = is_unsigned ? ua <= ub : a <= b; break;
+    case TOK_GE_OP: result = is_unsigned ? ua >= ub : a >= b; break;
+    case TOK_EQ_OP: result = ua == ub; break;
+    case TOK_NE_OP: result = ua != ub; break;
+    default:
+      return 0;
+  }
+
+  const Type *result_type = is_comparison(op) ? &v->_visitor.int_type : type;
+  FoldValue *ret = new_constant(result_type);
+  ret->int_val = wrap_to_type((int64_t) result, result_type);
+  return ret;
+}
+
+static double to_double(const FoldValue *val) {
+  if (val->type->kind == TY_FLOAT)
+    return val->float_val;
+  return val->type->is_unsigned ? (double) (uint64_t) val->int_val : (double) val->int_val;
+}
+
+/** Evaluate op when at least one operand is a floating constant. long double is left to the backend. */
+static FoldValue *fold_float(FoldingVisitor *v, TokenKind op, const FoldValue *left, const FoldValue *right) {
+  if (left->type->size > 8 || right->type->size > 8)
+    return 0;
+  double a = to_double(left), b = to_double(right), result;
+  switch (op) {
+    case TOK_ADD_OP: result = a + b; break;
+    case TOK_SUB_OP: result = a - b; break;
+    case TOK_STAR_OP: result = a * b; break;
+    case TOK_DIV_OP: result = a / b; break;
+    case TOK_LT_OP: case TOK_RT_OP: case TOK_LE_OP: case TOK_GE_OP: case TOK_EQ_OP: case TOK_NE_OP: {
+      FoldValue *ret = new_constant(&v->_visitor.int_type);
+      ret->int_val = op == TOK_LT_OP ? a < b : op == TOK_RT_OP ? a > b : op == TOK_LE_OP ? a <= b
+        : op == TOK_GE_OP ? a >= b : op == TOK_EQ_OP ? a == b : a != b;
+      return ret;
+    }
+    default:
+      return 0;
+  }
+  int is_double = (left->type->kind == TY_FLOAT && left->type->size == 8)
+    || (right->type->kind == TY_FLOAT && right->type->size == 8);
+  FoldValue *ret = new_constant(is_double ? &v->_visitor.double_type : &v->_visitor.float_type);
+  ret->float_val = is_double ? result : (double) (float) result;
+  return ret;
+}
+
+/**
+ * x + 0, 0 + x, x - 0, x * 1, 1 * x and x / 1 are just x, provided the usual arithmetic conversions leave the type
+ * of x alone. x is already evaluated, so dropping the operation drops no side effects.
+ */
+static FoldValue *simplify(FoldingVisitor *v, TokenKind op, FoldValue *left, FoldValue *right) {
+  if (left->is_const == right->is_const)
+    return 0;
+  FoldValue *k = left->is_const ? left : right;
+  FoldValue *x = left->is_const ? right : left;
+  if (k->type->kind != TY_INTEGER || x->type->kind != TY_INTEGER)
+    return 0;
+  if (!is_same_type(common_arithmetic_type((Visitor *) v, left->type, right->type), x->type))
+    return 0;
+  switch (op) {
+    case TOK_ADD_OP: return k->int_val == 0 ? x : 0;
+    case TOK_SUB_OP: return k == right && k->int_val == 0 ? x : 0;
+    case TOK_STAR_OP: return k->int_val == 1 ? x : 0;
+    case TOK_DIV_OP: return k == right && k->int_val == 1 ? x : 0;
+    default: return 0;
+  }
+}
+
+static FoldValue *visit_integer_literal(FoldingVisitor *v, int64_t int64_val) {
+  // 6.4.4.1: an unsuffixed decimal constant has the first of int, long int, long long int that can represent it.
+  FoldValue *ret = new_constant(&v->_visitor.int_type);
+  if (!fits_type(int64_val, ret->type)) {
+    ret->type = &v->_visitor.long_type;
+  }
+  ret->int_val = int64_val;
+  return ret;
+}
+
+static FoldValue *visit_float_literal(FoldingVisitor *v, double double_val) {
+  FoldValue *ret = new_constant(&v->_visitor.double_type);
+  ret->float_val = double_val;
+  return ret;
+}
+
+static FoldValue *visit_binop(FoldingVisitor *v, TokenKind op, FoldValue *left, FoldValue *right) {
+  THROW_IF(op == TOK_COMMA && !v->inner, EXC_PARSE_SYNTAX, "comma operator in constant expression");
+  if (op != TOK_COMMA && left->is_const && right->is_const) {
+    int is_float = left->type->kind == TY_FLOAT || right->type->kind == TY_FLOAT;
+    FoldValue *ret = is_float ? fold_float(v, op, left, right) : fold_integer(v, op, left, right);
+    if (ret) {
+      v->n_folded++;
+      return ret;
+    }
+  }
+  FoldValue *ret = simplify(v, op, left, right);
+  if (ret) {
+    v->n_folded++;
+    return ret;
+  }
+  Visitor *inner = backend(v);
+  return wrap(v, inner->visit_binop(inner, op, unwrap(v, left), unwrap(v, right)));
+}
+
+static FoldValue *convert_type(FoldingVisitor *v, FoldValue *value, const Type *new_type) {
+  if (value->is_const && IS_PRIMITIVE_TYPE(new_type) && new_type->size <= 8) {
+    FoldValue *ret = new_constant(new_type);
+    if (new_type->kind == TY_FLOAT) {
+      double d = to_double(value);
+      ret->float_val = new_type->size == 8 ? d : (double) (float) d;
+      return ret;
+    }
+    if (value->type->kind == TY_INTEGER) {
+      ret->int_val = wrap_to_type(value->int_val, new_type);
+      return ret;
+    }
+    // 6.3.1.4: floating to integer truncates, and is undefined if the result is out of range.
+    double d = value->float_val;
+    if (d > -9.2e18 && d < 9.2e18 && fits_type((int64_t) d, new_type)) {
+      ret->int_val = (int64_t) d;
+      return ret;
+    }
+    free(ret);
+    undefined(v, "floating constant out of range of integer type");
+  }
+  Visitor *inner = backend(v);
+  return wrap(v, inner->convert_type(inner, unwrap(v, value), new_type));
+}
+
+static FoldValue *visit_assign(FoldingVisitor *v, TokenKind op, FoldValue *left, FoldValue *right) {
+  Visitor *inner = backend(v);
+  return wrap(v, inner->visit_assign(inner, op, unwrap(v, left), unwrap(v, right)));
+}
+
+static FoldValue *visit_declaration(FoldingVisitor *v, const Type *type, const char *ident) {
+  Visitor *inner = backend(v);
+  return wrap(v, inner->visit_declaration(inner, type, ident));
+}
+
+static void visit_function_definition_start(
+  FoldingVisitor *v,
+  const char *ident,
+  const Type *type,
+  FunctionSpecifiers specifiers
+) {
+  Visitor *inner = backend(v);
+  inner->visit_function_definition_start(inner, ident, type, specifiers);
+}
+
+static FoldValue *visit_function_definition_param(FoldingVisitor *v, const Type *type, const char *ident) {
+  Visitor *inner = backend(v);
+  return wrap(v, inner->visit_function_definition_param(inner, type, ident));
+}
+
+static void visit_function_end(FoldingVisitor *v) {
+  Visitor *inner = backend(v);
+  inner->visit_function_end(inner);
+}
+
+static void visit_return(FoldingVisitor *v, FoldValue *retval) {
+  Visitor *inner = backend(v);
+  inner->visit_return(inner, unwrap(v, retval));
+}
+
+static FoldValue *visit_array_reference(FoldingVisitor *v, FoldValue *array, FoldValue *index, int lvalue) {
+  Visitor *inner = backend(v);
+  return wrap(v, inner->visit_array_reference(inner, unwrap(v, array), unwrap(v, index), lvalue));
+}
+
+static FoldValue *visit_struct_reference(FoldingVisitor *v, FoldValue *left, const Member *member) {
+  Visitor *inner = backend(v);
+  return wrap(v, inner->visit_struct_reference(inner, unwrap(v, left), member));
+}
+
+static FoldValue *visit_call(FoldingVisitor *v, FoldValue *function, int n_args, FoldValue **args) {
+  Visitor *inner = backend(v);
+  void **inner_args = checked_calloc(n_args + 1, sizeof(void *));
+  for (int i = 0; i < n_args; i++) {
+    inner_args[i] = unwrap(v, args[i]);
+  }
+  FoldValue *ret = wrap(v, inner->visit_call(inner, unwrap(v, function), n_args, inner_args));
+  free(inner_args);
+  return ret;
+}
+
+static void visit_zero_object(FoldingVisitor *v, FoldValue *object) {
+  Visitor *inner = backend(v);
+  inner->visit_zero_object(inner, unwrap(v, object));
+}
+
+static void visit_assign_offset(FoldingVisitor *v, FoldValue *aggregate, int offset, FoldValue *right) {
+  Visitor *inner = backend(v);
+  inner->visit_assign_offset(inner, unwrap(v, aggregate), offset, unwrap(v, right));
+}
+
+static void *new_label(FoldingVisitor *v) {
+  Visitor *inner = backend(v);
+  return inner->new_label(inner);
+}
+
+static void visit_label(FoldingVisitor *v, void *label) {
+  Visitor *inner = backend(v);
+  inner->visit_label(inner, label);
+}
+
+static void visit_jump(FoldingVisitor *v, void *label) {
+  Visitor *inner = backend(v);
+  inner->visit_jump(inner, label);
+}
+
+/** A constant condition makes the branch a jump, or nothing. */
+static void visit_branch(FoldingVisitor *v, FoldValue *cond, int jump_if, void *label) {
+  Visitor *inner = backend(v);
+  if (cond->is_const && cond->type->kind == TY_INTEGER) {
+    v->n_folded++;
+    if (!cond->int_val == !jump_if) {
+      inner->visit_jump(inner, label);
+    }
+    return;
+  }
+  inner->visit_branch(inner, unwrap(v, cond), jump_if, label);
+}
+
+static void visit_switch(FoldingVisitor *v, FoldValue *value, int n_cases, const int64_t *values, void **labels,
+  void *default_label) {
+  Visitor *inner = backend(v);
+  inner->visit_switch(inner, unwrap(v, value), n_cases, values, labels, default_label);
+}
+
+static void seal_label(FoldingVisitor *v, void *label) {
+  Visitor *inner = backend(v);
+  inner->seal_label(inner, label);
+}
+
+static void emit_comment(FoldingVisitor *v, const char *fmt, ...) {
+  if (!v->inner)
+    return;
+  va_list ap;
+  va_start(ap, fmt);
+  char *comment;
+  DIE_IF(vasprintf(&comment, fmt, ap) == -1, "vasprintf failed to allocate");
+  va_end(ap);
+  v->inner->emit_comment(v->inner, "%s", comment);
+  free(comment);
+}
+
+static const char *function_text(FoldingVisitor *v) {
+  return v->inner ? v->inner->function_text(v->inner) : 0;
+}
+
+static void visit_cached_function(FoldingVisitor *v, const char *text) {
+  Visitor *inner = backend(v);
+  inner->visit_cached_function(inner, text);
+}
+
+static void finalize(FoldingVisitor *v) {
+  fprintf(stderr, "Constant folding: %d operations folded\n", v->n_folded);
+  if (v->inner) {
+    v->inner->finalize(v->inner);
+  }
+}
+
+int get_integer_constant(const void *value, int64_t *p_val) {
+  const FoldValue *val = value;
+  if (!val || !val->is_const || val->type->kind != TY_INTEGER)
+    return 0;
+  *p_val = val->int_val;
+  return 1;
+}
+
+static FoldingVisitor *new_folding_visitor_with_types(Visitor *inner, const Visitor *types) {
+  FoldingVisitor *v = checked_calloc(1, sizeof(FoldingVisitor));
+  INSTALL_VISITOR_METHODS(v)
+  copy_primitive_types((Visitor *) v, types);
+  v->inner = inner;
+  return v;
+}
+
+Visitor *new_folding_visitor(Visitor *inner) {
+  return (Visitor *) new_folding_visitor_with_types(inner, inner);
+}
+
+Visitor *new_constant_evaluator(const Visitor *types) {
+  return (Visitor *) new_folding_visitor_with_types(0, types);
+}
@@ -0,0 +1,21 @@
+/** Constant folding: a visitor decorator, and the integer constant expression evaluator built on it. */
+
+#pragma once
+#include <stdint.h>
+#include "visitor.h"
+
+/**
+ * Wrap inner so that operations whose operands are all constants are evaluated at compile time, following the C
+ * rules for integer promotion, usual arithmetic conversions and wraparound. Only the remaining work reaches inner;
+ * constants are materialized with inner->visit_integer_literal when a non-constant operation needs them.
+ */
+Visitor *new_folding_visitor(Visitor *inner);
+
+/**
+ * A folding visitor without a backend, which evaluates integer constant expressions (6.6). Anything that is not a
+ * constant throws EXC_PARSE_SYNTAX, and so does signed overflow. Primitive types are copied from types.
+ */
+Visitor *new_constant_evaluator(const Visitor *types);
+
+/** If value was produced by a folding visitor and is an integer constant, store it in *p_val and return 1. */
+int get_integer_constant(const void *value, int64_t *p_val);
@@ -0,0 +1,69 @@
+// Clearing and copying aggregates of each size tier: unrolled stores, rep stosb and rep movsb, and non-temporal stores.
+int small_copy(int x, int y) {
+  struct point {
+    int x, y, z;
+  };
+  struct point a;
+  struct point b;
+  a.x = x;
+  a.y = y;
+  a.z = x + y;
+  b = a;
+  a.x = 0;
+  return b.x * 100 + b.y * 10 + b.z + a.x;
+}
+
+long vector_copy(long i) {
+  struct quad {
+    long a, b, c, d;
+  };
+  struct row {
+    struct quad left, middle, right;
+  };
+  struct row a;
+  struct row b;
+  a.left.a = i;
+  a.left.d = i * 2;
+  a.middle.b = i * 3;
+  a.right.c = i * 4;
+  a.right.d = i * 5;
+  b = a;
+  a.right.d = i - i;
+  return b.left.a + b.left.d + b.middle.b + b.right.c + b.right.d + a.right.d;
+}
+
+long string_copy(long i) {
+  struct quad {
+    long a, b, c, d;
+  };
+  struct row {
+    struct quad left, middle, right;
+  };
+  struct table {
+    struct row first, second, third, fourth, fifth;
+  };
+  struct table a;
+  struct table b;
+  a.first.left.a = i;
+  a.third.middle.c = i + 1;
+  a.fifth.right.d = i + 2;
+  b = a;
+  a.fifth.right.d = i - i;
+  return b.first.left.a * 10000 + b.third.middle.c * 100 + b.fifth.right.d + a.fifth.right.d;
+}
+
+int cleared(int i) {
+  int tiny[3] = {0};
+  int mid[40] = {0};
+  int large[1000] = {0};
+  tiny[i] = i;
+  mid[i] = i;
+  large[i * 100] = i;
+  return tiny[0] + tiny[2] + mid[i] + mid[i + 1] + large[i * 100] + large[i * 100 + 7];
+}
+
+int streamed(int i) {
+  int huge[300000] = {7};
+  huge[i * 1000] = huge[i * 1000] + i;
+  return huge[0] + huge[1] + huge[i * 1000] + huge[299999];
+}
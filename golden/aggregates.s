@@ -0,0 +1,275 @@
+	.globl	_small_copy
+	.p2align	4, 0x90
+_small_copy:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+# alloc y (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/aggregates.c:3
+# golden/aggregates.c:6
+# alloc a (12 bytes) at -20(%rbp)
+# golden/aggregates.c:7
+# alloc b (12 bytes) at -32(%rbp)
+# golden/aggregates.c:8
+	movl	%edi, -20(%rbp)
+# golden/aggregates.c:9
+	movl	%esi, -16(%rbp)		# a.y = %esi
+# golden/aggregates.c:10
+	movl	%edi, %esi		# %esi = x
+	addl	-8(%rbp), %esi		# %esi = x + y
+# golden/aggregates.c:11
+	movq	-20(%rbp), %rax
+	movq	%rax, -32(%rbp)
+	movl	%esi, -24(%rbp)
+# golden/aggregates.c:12
+	movl	$0, -20(%rbp)		# a.x = $0
+# golden/aggregates.c:13
+	movl	-32(%rbp), %esi		# %esi = b.x
+	# %esi = b.x * $100
+	leal	(%rsi,%rsi,4), %esi
+	leal	(%rsi,%rsi,4), %esi
+	shll	$2, %esi
+	movl	-28(%rbp), %edi		# %edi = b.y
+	# %edi = b.y * $10
+	leal	(%rdi,%rdi,4), %edi
+	shll	$1, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	addl	-24(%rbp), %esi		# %esi = %esi + b.z
+	addl	-20(%rbp), %esi		# %esi = %esi + a.x
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_vector_copy
+	.p2align	4, 0x90
+_vector_copy:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$208, %rsp
+# alloc i (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/aggregates.c:17
+# golden/aggregates.c:20
+# golden/aggregates.c:23
+# alloc a (96 bytes) at -104(%rbp)
+# golden/aggregates.c:24
+# alloc b (96 bytes) at -200(%rbp)
+# golden/aggregates.c:25
+	movq	%rdi, -104(%rbp)
+# golden/aggregates.c:26
+	movq	%rdi, %rsi		# %rsi = i
+	# %rsi = i * $2
+	shlq	$1, %rsi
+	movq	%rsi, -80(%rbp)		# a.left.d = %rsi
+# golden/aggregates.c:27
+	movq	%rdi, %rsi		# %rsi = i
+	# %rsi = i * $3
+	leaq	(%rsi,%rsi,2), %rsi
+	movq	%rsi, -64(%rbp)		# a.middle.b = %rsi
+# golden/aggregates.c:28
+	movq	%rdi, %rsi		# %rsi = i
+	# %rsi = i * $4
+	shlq	$2, %rsi
+	movq	%rsi, -24(%rbp)		# a.right.c = %rsi
+# golden/aggregates.c:29
+	movq	%rdi, %rsi		# %rsi = i
+	# %rsi = i * $5
+	leaq	(%rsi,%rsi,4), %rsi
+	movq	%rsi, -16(%rbp)		# a.right.d = %rsi
+# golden/aggregates.c:30
+	movups	-104(%rbp), %xmm15
+	movups	%xmm15, -200(%rbp)
+	movups	-88(%rbp), %xmm15
+	movups	%xmm15, -184(%rbp)
+	movups	-72(%rbp), %xmm15
+	movups	%xmm15, -168(%rbp)
+	movups	-56(%rbp), %xmm15
+	movups	%xmm15, -152(%rbp)
+	movups	-40(%rbp), %xmm15
+	movups	%xmm15, -136(%rbp)
+	movups	-24(%rbp), %xmm15
+	movups	%xmm15, -120(%rbp)
+# golden/aggregates.c:31
+	movq	-8(%rbp), %rsi		# %rsi = i
+	subq	-8(%rbp), %rsi		# %rsi = i - i
+	movq	%rsi, -16(%rbp)		# a.right.d = %rsi
+# golden/aggregates.c:32
+	movq	-200(%rbp), %rsi		# %rsi = b.left.a
+	addq	-176(%rbp), %rsi		# %rsi = b.left.a + b.left.d
+	addq	-160(%rbp), %rsi		# %rsi = %rsi + b.middle.b
+	addq	-120(%rbp), %rsi		# %rsi = %rsi + b.right.c
+	addq	-112(%rbp), %rsi		# %rsi = %rsi + b.right.d
+	addq	-16(%rbp), %rsi		# %rsi = %rsi + a.right.d
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_string_copy
+	.p2align	4, 0x90
+_string_copy:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$976, %rsp
+# alloc i (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/aggregates.c:36
+# golden/aggregates.c:39
+# golden/aggregates.c:42
+# golden/aggregates.c:45
+# alloc a (480 bytes) at -488(%rbp)
+# golden/aggregates.c:46
+# alloc b (480 bytes) at -968(%rbp)
+# golden/aggregates.c:47
+	movq	%rdi, -488(%rbp)
+# golden/aggregates.c:48
+	movq	%rdi, %rsi		# %rsi = i
+	addq	$1, %rsi		# %rsi = i + $1
+	movq	%rsi, -248(%rbp)		# a.third.middle.c = %rsi
+# golden/aggregates.c:49
+	movq	%rdi, %rsi		# %rsi = i
+	addq	$2, %rsi		# %rsi = i + $2
+	movq	%rsi, -16(%rbp)		# a.fifth.right.d = %rsi
+# golden/aggregates.c:50
+	leaq	-968(%rbp), %rdi
+	leaq	-488(%rbp), %rsi
+	movl	$480, %ecx
+	rep movsb
+# golden/aggregates.c:51
+	movq	-8(%rbp), %rsi		# %rsi = i
+	subq	-8(%rbp), %rsi		# %rsi = i - i
+	movq	%rsi, -16(%rbp)		# a.fifth.right.d = %rsi
+# golden/aggregates.c:52
+	movq	-968(%rbp), %rsi		# %rsi = b.first.left.a
+	imulq	$10000, %rsi		# %rsi = b.first.left.a * $10000
+	movq	-728(%rbp), %rdi		# %rdi = b.third.middle.c
+	# %rdi = b.third.middle.c * $100
+	leaq	(%rdi,%rdi,4), %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	shlq	$2, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	addq	-496(%rbp), %rsi		# %rsi = %rsi + b.fifth.right.d
+	addq	-16(%rbp), %rsi		# %rsi = %rsi + a.fifth.right.d
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_cleared
+	.p2align	4, 0x90
+_cleared:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$4176, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/aggregates.c:56
+# alloc tiny (12 bytes) at -16(%rbp)
+	movq	$0, -12(%rbp)
+	movl	$0,-16(%rbp)		# tiny[..0] = $0
+# golden/aggregates.c:57
+# alloc mid (160 bytes) at -176(%rbp)
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, -172(%rbp)
+	movups	%xmm15, -156(%rbp)
+	movups	%xmm15, -140(%rbp)
+	movups	%xmm15, -124(%rbp)
+	movups	%xmm15, -108(%rbp)
+	movups	%xmm15, -92(%rbp)
+	movups	%xmm15, -76(%rbp)
+	movups	%xmm15, -60(%rbp)
+	movups	%xmm15, -44(%rbp)
+	movq	$0, -28(%rbp)
+	movl	$0, -20(%rbp)
+	movl	$0,-176(%rbp)		# mid[..0] = $0
+# golden/aggregates.c:58
+# alloc large (4000 bytes) at -4176(%rbp)
+	leaq	-4172(%rbp), %rdi
+	xorl	%eax, %eax
+	movl	$3996, %ecx
+	rep stosb
+	movl	$0,-4176(%rbp)		# large[..0] = $0
+# golden/aggregates.c:59
+	movl	-4(%rbp), %esi		# %esi = i
+	movslq	-4(%rbp), %rcx
+	movl	%esi, -16(%rbp,%rcx,4)		# tiny[i] = %esi
+# golden/aggregates.c:60
+	movl	-4(%rbp), %esi		# %esi = i
+	movslq	-4(%rbp), %rcx
+	movl	%esi, -176(%rbp,%rcx,4)		# mid[i] = %esi
+# golden/aggregates.c:61
+	movl	-4(%rbp), %esi		# %esi = i
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $100
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$2, %edi
+	movslq	%edi, %rcx
+	movl	%esi, -4176(%rbp,%rcx,4)		# large[(i * $100)] = %esi
+# golden/aggregates.c:62
+	movl	-16(%rbp), %esi		# %esi = tiny[$0]
+	addl	-8(%rbp), %esi		# %esi = tiny[$0] + tiny[$2]
+	movslq	-4(%rbp), %rcx
+	addl	-176(%rbp,%rcx,4), %esi		# %esi = %esi + mid[i]
+	movl	-4(%rbp), %edi		# %edi = i
+	addl	$1, %edi		# %edi = i + $1
+	movslq	%edi, %rcx
+	addl	-176(%rbp,%rcx,4), %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $100
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$2, %edi
+	movslq	%edi, %rcx
+	addl	-4176(%rbp,%rcx,4), %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $100
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$2, %edi
+	addl	$7, %edi		# %edi = %edi + $7
+	movslq	%edi, %rcx
+	addl	-4176(%rbp,%rcx,4), %esi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_streamed
+	.p2align	4, 0x90
+_streamed:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$1200016, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/aggregates.c:66
+# alloc huge (1200000 bytes) at -1200004(%rbp)
+	leaq	-1200000(%rbp), %rdi
+	xorl	%eax, %eax
+	movq	$149999, %rcx
+	.p2align	4, 0x90
+Lstreamed_0:
+	movnti	%rax, (%rdi)
+	addq	$8, %rdi
+	subq	$1, %rcx
+	jne	Lstreamed_0
+	sfence
+	movl	$0, (%rdi)
+	movl	$7,-1200004(%rbp)		# huge[..0] = $7
+# golden/aggregates.c:67
+	movl	-4(%rbp), %esi		# %esi = i
+	imull	$1000, %esi		# %esi = i * $1000
+	movslq	%esi, %rcx
+	movl	-1200004(%rbp,%rcx,4), %esi		# %esi = huge[(i * $1000)]
+	addl	-4(%rbp), %esi		# %esi = huge[(i * $1000)] + i
+	movl	-4(%rbp), %edi		# %edi = i
+	imull	$1000, %edi		# %edi = i * $1000
+	movslq	%edi, %rcx
+	movl	%esi, -1200004(%rbp,%rcx,4)		# huge[(i * $1000)] = %esi
+# golden/aggregates.c:68
+	movl	-1200004(%rbp), %esi		# %esi = huge[$0]
+	addl	-1200000(%rbp), %esi		# %esi = huge[$0] + huge[$1]
+	movl	-4(%rbp), %edi		# %edi = i
+	imull	$1000, %edi		# %edi = i * $1000
+	movslq	%edi, %rcx
+	addl	-1200004(%rbp,%rcx,4), %esi
+	addl	-8(%rbp), %esi		# %esi = %esi + huge[$299999]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
@@ -0,0 +1,20 @@
+#include <stdio.h>
+extern int small_copy(int x, int y);
+extern long vector_copy(long i);
+extern long string_copy(long i);
+extern int cleared(int i);
+extern int streamed(int i);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+int main() {
+  print_expr(small_copy(1, 2));
+  print_expr(small_copy(4, 5));
+  print_expr(vector_copy(3));
+  print_expr(vector_copy(7));
+  print_expr(string_copy(0));
+  print_expr(string_copy(42));
+  print_expr(cleared(1));
+  print_expr(cleared(2));
+  print_expr(streamed(0));
+  print_expr(streamed(123));
+}
@@ -0,0 +1,186 @@
+	.globl	_small_copy
+	.p2align	4, 0x90
+_small_copy:
+	movl	%edi, -20(%rsp)
+	movl	%esi, -16(%rsp)
+	addl	%edi, %esi
+	movq	-20(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movl	%esi, -24(%rsp)
+	movl	-32(%rsp), %esi
+	leal	(%rsi,%rsi,4), %esi
+	leal	(%rsi,%rsi,4), %esi
+	shll	$2, %esi
+	movl	-28(%rsp), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$1, %edi
+	addl	%edi, %esi
+	addl	-24(%rsp), %esi
+	movl	%esi, %eax
+	retq
+	.globl	_vector_copy
+	.p2align	4, 0x90
+_vector_copy:
+	subq	$200, %rsp
+	movq	%rdi, 96(%rsp)
+	movq	%rdi, %rsi
+	shlq	$1, %rsi
+	movq	%rsi, 120(%rsp)
+	movq	%rdi, %rsi
+	leaq	(%rsi,%rsi,2), %rsi
+	movq	%rsi, 136(%rsp)
+	movq	%rdi, %rsi
+	shlq	$2, %rsi
+	movq	%rsi, 176(%rsp)
+	movq	%rdi, %rsi
+	leaq	(%rsi,%rsi,4), %rsi
+	movq	%rsi, 184(%rsp)
+	movups	96(%rsp), %xmm15
+	movups	%xmm15, (%rsp)
+	movups	112(%rsp), %xmm15
+	movups	%xmm15, 16(%rsp)
+	movups	128(%rsp), %xmm15
+	movups	%xmm15, 32(%rsp)
+	movups	144(%rsp), %xmm15
+	movups	%xmm15, 48(%rsp)
+	movups	160(%rsp), %xmm15
+	movups	%xmm15, 64(%rsp)
+	movups	176(%rsp), %xmm15
+	movups	%xmm15, 80(%rsp)
+	movq	%rdi, %rsi
+	subq	%rdi, %rsi
+	movq	0(%rsp), %rdi
+	addq	24(%rsp), %rdi
+	addq	40(%rsp), %rdi
+	addq	80(%rsp), %rdi
+	addq	88(%rsp), %rdi
+	addq	%rdi, %rsi
+	movq	%rsi, %rax
+	addq	$200, %rsp
+	retq
+	.globl	_string_copy
+	.p2align	4, 0x90
+_string_copy:
+	subq	$968, %rsp
+	movq	%rdi, %r8
+	movq	%r8, 480(%rsp)
+	movq	%r8, %rsi
+	addq	$1, %rsi
+	movq	%rsi, 720(%rsp)
+	movq	%r8, %rsi
+	addq	$2, %rsi
+	movq	%rsi, 952(%rsp)
+	leaq	0(%rsp), %rdi
+	leaq	480(%rsp), %rsi
+	movl	$480, %ecx
+	rep movsb
+	movq	%r8, %rsi
+	subq	%r8, %rsi
+	movq	0(%rsp), %rdi
+	imulq	$10000, %rdi
+	movq	240(%rsp), %r8
+	leaq	(%r8,%r8,4), %r8
+	leaq	(%r8,%r8,4), %r8
+	shlq	$2, %r8
+	addq	%r8, %rdi
+	addq	472(%rsp), %rdi
+	addq	%rdi, %rsi
+	movq	%rsi, %rax
+	addq	$968, %rsp
+	retq
+	.globl	_cleared
+	.p2align	4, 0x90
+_cleared:
+	subq	$4184, %rsp
+	movq	%rdi, %r8
+	movl	$0, 4172(%rsp)
+	movl	$0, 4164(%rsp)
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, 4008(%rsp)
+	movups	%xmm15, 4024(%rsp)
+	movups	%xmm15, 4040(%rsp)
+	movups	%xmm15, 4056(%rsp)
+	movups	%xmm15, 4072(%rsp)
+	movups	%xmm15, 4088(%rsp)
+	movups	%xmm15, 4104(%rsp)
+	movups	%xmm15, 4120(%rsp)
+	movups	%xmm15, 4136(%rsp)
+	movq	$0, 4152(%rsp)
+	movl	$0, 4160(%rsp)
+	movl	$0, 4004(%rsp)
+	leaq	8(%rsp), %rdi
+	xorl	%eax, %eax
+	movl	$3996, %ecx
+	rep stosb
+	movl	$0, 4(%rsp)
+	movslq	%r8d, %rsi
+	shlq	$2, %rsi
+	leaq	4164(%rsp), %rdi
+	addq	%rsi, %rdi
+	movl	%r8d, (%rdi)
+	leaq	4004(%rsp), %rax
+	addq	%rax, %rsi
+	movl	%r8d, (%rsi)
+	movl	%r8d, %esi
+	leal	(%rsi,%rsi,4), %esi
+	leal	(%rsi,%rsi,4), %esi
+	shll	$2, %esi
+	movslq	%esi, %rdi
+	shlq	$2, %rdi
+	leaq	4(%rsp), %rax
+	addq	%rax, %rdi
+	movl	%r8d, (%rdi)
+	movl	4164(%rsp), %edi
+	addl	4172(%rsp), %edi
+	addl	%r8d, %edi
+	movl	%r8d, %r9d
+	addl	$1, %r9d
+	movslq	%r9d, %r9
+	shlq	$2, %r9
+	leaq	4004(%rsp), %rax
+	addq	%rax, %r9
+	addl	(%r9), %edi
+	addl	%r8d, %edi
+	addl	$7, %esi
+	movslq	%esi, %rsi
+	shlq	$2, %rsi
+	leaq	4(%rsp), %rax
+	addq	%rax, %rsi
+	movl	(%rsi), %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	addq	$4184, %rsp
+	retq
+	.globl	_streamed
+	.p2align	4, 0x90
+_streamed:
+	subq	$1200008, %rsp
+	movq	%rdi, %r8
+	leaq	4(%rsp), %rdi
+	xorl	%eax, %eax
+	movq	$149999, %rcx
+	.p2align	4, 0x90
+Lstreamed_zero50:
+	movnti	%rax, (%rdi)
+	addq	$8, %rdi
+	subq	$1, %rcx
+	jne	Lstreamed_zero50
+	sfence
+	movl	$0, (%rdi)
+	movl	$7, 0(%rsp)
+	movl	%r8d, %esi
+	imull	$1000, %esi
+	movslq	%esi, %rsi
+	shlq	$2, %rsi
+	leaq	0(%rsp), %rax
+	addq	%rax, %rsi
+	movl	(%rsi), %edi
+	addl	%r8d, %edi
+	movl	%edi, (%rsi)
+	movl	0(%rsp), %esi
+	addl	4(%rsp), %esi
+	addl	%edi, %esi
+	addl	1199996(%rsp), %esi
+	movl	%esi, %eax
+	addq	$1200008, %rsp
+	retq
@@ -0,0 +1,70 @@
+	.globl	_f1
+	.p2align	4, 0x90
+_f1:
+	movl	$10, -20(%rsp)
+	movl	$11, -16(%rsp)
+	movl	$12, -12(%rsp)
+	movslq	%edi, %rsi
+	shlq	$2, %rsi
+	leaq	-20(%rsp), %rax
+	addq	%rax, %rsi
+	movl	$10, %edi
+	addl	$11, %edi
+	addl	$12, %edi
+	movl	%edi, (%rsi)
+	movl	-20(%rsp), %esi
+	addl	-16(%rsp), %esi
+	addl	-12(%rsp), %esi
+	movl	%esi, %eax
+	retq
+	.globl	_f2
+	.p2align	4, 0x90
+_f2:
+	pushq	%rbx
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	movl	$1, -100(%rsp)
+	movl	$2, -96(%rsp)
+	movl	$3, -60(%rsp)
+	movl	$4, -56(%rsp)
+	movl	$5, -52(%rsp)
+	movl	$55, -16(%rsp)
+	movl	$56, -12(%rsp)
+	movl	$57, -8(%rsp)
+	movl	$54, -20(%rsp)
+	movl	$90, -92(%rsp)
+	movl	$91, -88(%rsp)
+	movl	$92, -84(%rsp)
+	movslq	%edi, %rdi
+	leaq	(%rdi,%rdi,2), %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	shlq	$2, %rdi
+	leaq	-120(%rsp), %rax
+	addq	%rax, %rdi
+	movslq	%esi, %rsi
+	leaq	(%rsi,%rsi,4), %rsi
+	shlq	$2, %rsi
+	addq	%rdi, %rsi
+	movslq	%r8d, %rdi
+	shlq	$2, %rdi
+	addq	%rdi, %rsi
+	movl	%r9d, (%rsi)
+	movl	-100(%rsp), %esi
+	addl	-96(%rsp), %esi
+	addl	-60(%rsp), %esi
+	addl	-56(%rsp), %esi
+	addl	-52(%rsp), %esi
+	movl	-16(%rsp), %edi
+	addl	-12(%rsp), %edi
+	addl	-8(%rsp), %edi
+	movl	-20(%rsp), %r8d
+	movl	-92(%rsp), %r10d
+	addl	-88(%rsp), %r10d
+	addl	-84(%rsp), %r10d
+	addl	%edi, %esi
+	addl	%r8d, %esi
+	addl	%r10d, %esi
+	addl	%r9d, %esi
+	movl	%esi, %eax
+	popq	%rbx
+	retq
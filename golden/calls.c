@@ -0,0 +1,114 @@
+int scale(int x, int k);
+
+static inline int square(int x) {
+  return x * x;
+}
+
+static int clamp(int x, int lo, int hi) {
+  if (x < lo)
+    return lo;
+  if (x > hi)
+    return hi;
+  return x;
+}
+
+static int weighted(int a, int b, int c) {
+  int v[3];
+  v[0] = a;
+  v[1] = b;
+  v[2] = c;
+  return v[0] + v[1] * 2 + v[2] * 3;
+}
+
+static int triangle(int n) {
+  int sum = 0;
+  while (n > 0) {
+    sum += n;
+    n--;
+  }
+  return sum;
+}
+
+static int fact(int n) {
+  if (n < 2)
+    return 1;
+  return n * fact(n - 1);
+}
+
+int sum_squares(int n) {
+  int sum = 0;
+  for (int i = 1; i <= n; i++) {
+    sum += square(i);
+  }
+  return sum;
+}
+
+int fourth_power(int x) {
+  return square(square(x));
+}
+
+int clamped_sum(int a, int b, int c) {
+  return clamp(a * 3 - b, 0, 10) + clamp(b, 0, 10) + clamp(c, -5, 5);
+}
+
+int weighted_sum(int a, int b) {
+  return weighted(a, b, a + b) - weighted(b, a, 1);
+}
+
+int triangles(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += triangle(i);
+  }
+  return sum;
+}
+
+int factorial(int n) {
+  return fact(n);
+}
+
+int twice_scaled(int x) {
+  return scale(x, 2) + scale(x + 1, 3);
+}
+
+int scale(int x, int k) {
+  int ret = 0;
+  for (int i = 0; i < k; i++) {
+    ret += x;
+  }
+  return ret;
+}
+
+long weigh8(long a, long b, long c, long d, long e, long f, long g, long h) {
+  return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f + 7 * g + 8 * h;
+}
+
+long stack_args(long x) {
+  return weigh8(x, x + 1, x + 2, x + 3, x + 4, x + 5, x + 6, x + 7) - weigh8(1, 2, 3, 4, 5, 6, x, x * x);
+}
+
+double average10(double a, double b, double c, double d, double e, double f, double g, double h, double i, double j) {
+  return (a + b + c + d + e + f + g + h + i * 2 + j * 3) / 13;
+}
+
+long mixed9(long a, double b, long c, double d, long e, long f, long g, long h, long i) {
+  long product = b * d;
+  return a - c + e - f + g - h + i * 100 + product;
+}
+
+long float_stack_args(double x) {
+  long thousandths = average10(x, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, x * 2, x + 0.25) * 1000;
+  long truncated = x;
+  return thousandths + mixed9(1, x, 2, 0.5, 3, 4, 5, 6, truncated);
+}
+
+int twice(int x) {
+  return x + x;
+}
+
+int kept_across_calls(int x, int y) {
+  int product = x * y;
+  int sum = x + y;
+  int doubled = twice(product);
+  return doubled + twice(sum) * product + sum;
+}
@@ -0,0 +1,748 @@
+	.p2align	4, 0x90
+_square:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:4
+	movl	%edi, %esi		# %esi = x
+	imull	-4(%rbp), %esi		# %esi = x * x
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.p2align	4, 0x90
+_clamp:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc lo (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc hi (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/calls.c:8
+	movl	%edi, %esi		# %esi = x
+	cmpl	-8(%rbp), %esi		# %esi = x < lo
+	jge	Lclamp_0
+	movl	-8(%rbp), %eax		# %eax = lo
+	leave
+	retq
+Lclamp_0:
+# golden/calls.c:10
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	-12(%rbp), %esi		# %esi = x > hi
+	jle	Lclamp_1
+	movl	-12(%rbp), %eax		# %eax = hi
+	leave
+	retq
+Lclamp_1:
+# golden/calls.c:12
+	movl	-4(%rbp), %eax		# %eax = x
+	leave
+	retq
+	.p2align	4, 0x90
+_weighted:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+# alloc c (4 bytes) at -12(%rbp)
+# golden/calls.c:16
+# alloc v (12 bytes) at -24(%rbp)
+# golden/calls.c:17
+# golden/calls.c:18
+	movl	%esi, -20(%rbp)		# v[$1] = %esi
+# golden/calls.c:19
+# golden/calls.c:20
+	movl	%edi, %esi		# %esi = v[$0]
+	movl	-20(%rbp), %edi		# %edi = v[$1]
+	# %edi = v[$1] * $2
+	shll	$1, %edi
+	addl	%edi, %esi		# %esi = v[$0] + %edi
+	movl	%edx, %edi		# %edi = v[$2]
+	# %edi = v[$2] * $3
+	leal	(%rdi,%rdi,2), %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.p2align	4, 0x90
+_triangle:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:24
+# alloc sum (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# sum = $0
+# golden/calls.c:25
+	movl	%edi, %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n > $0
+	jle	Ltriangle_2
+Ltriangle_0:
+# golden/calls.c:26
+	movl	-8(%rbp), %esi		# %esi = sum
+	addl	-4(%rbp), %esi		# %esi = sum + n
+	movl	%esi, -8(%rbp)		# sum = %esi
+# golden/calls.c:27
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+	movl	%esi, -4(%rbp)		# n = %esi
+Ltriangle_1:
+	movl	-4(%rbp), %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n > $0
+	jg	Ltriangle_0
+Ltriangle_2:
+# golden/calls.c:29
+	movl	-8(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.p2align	4, 0x90
+_fact:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:33
+	movl	%edi, %esi		# %esi = n
+	cmpl	$2, %esi		# %esi = n < $2
+	jge	Lfact_0
+	movl	$1, %eax		# %eax = $1
+	leave
+	retq
+Lfact_0:
+# golden/calls.c:35
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+	movl	%esi, %edi
+	callq	_fact
+# alloc t2 (4 bytes) at -8(%rbp)
+	movl	%eax, -8(%rbp)		# t2 = fact()
+	movl	-4(%rbp), %esi		# %esi = n
+	imull	-8(%rbp), %esi		# %esi = n * t2
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_sum_squares
+	.p2align	4, 0x90
+_sum_squares:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:39
+# alloc sum (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# sum = $0
+# golden/calls.c:40
+# alloc i (4 bytes) at -12(%rbp)
+	movl	$1, -12(%rbp)		# i = $1
+	movl	$1, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i <= n
+	jg	Lsum_squares_2
+Lsum_squares_0:
+# golden/calls.c:41
+	movl	-12(%rbp), %edi
+	callq	_square
+# alloc t4 (4 bytes) at -16(%rbp)
+	movl	%eax, -16(%rbp)		# t4 = square()
+	movl	-8(%rbp), %esi		# %esi = sum
+	addl	-16(%rbp), %esi		# %esi = sum + t4
+	movl	%esi, -8(%rbp)		# sum = %esi
+Lsum_squares_1:
+	movl	-12(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -12(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i <= n
+	jle	Lsum_squares_0
+Lsum_squares_2:
+# golden/calls.c:43
+	movl	-8(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_fourth_power
+	.p2align	4, 0x90
+_fourth_power:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:47
+	callq	_square
+# alloc t2 (4 bytes) at -8(%rbp)
+	movl	%eax, -8(%rbp)		# t2 = square()
+	movl	%eax, %edi
+	callq	_square
+# alloc t3 (4 bytes) at -12(%rbp)
+	leave
+	retq
+	.globl	_clamped_sum
+	.p2align	4, 0x90
+_clamped_sum:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc c (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/calls.c:51
+	movl	%edi, %esi		# %esi = a
+	# %esi = a * $3
+	leal	(%rsi,%rsi,2), %esi
+	subl	-8(%rbp), %esi		# %esi = %esi - b
+	movl	%esi, %edi
+	movl	$0, %esi
+	movl	$10, %edx
+	callq	_clamp
+# alloc t4 (4 bytes) at -16(%rbp)
+	movl	%eax, -16(%rbp)		# t4 = clamp()
+	movl	-8(%rbp), %edi
+	movl	$0, %esi
+	movl	$10, %edx
+	callq	_clamp
+# alloc t5 (4 bytes) at -20(%rbp)
+	movl	%eax, -20(%rbp)		# t5 = clamp()
+	movl	-12(%rbp), %edi
+	movl	$-5, %esi
+	movl	$5, %edx
+	callq	_clamp
+# alloc t6 (4 bytes) at -24(%rbp)
+	movl	%eax, -24(%rbp)		# t6 = clamp()
+	movl	-16(%rbp), %esi		# %esi = t4
+	addl	-20(%rbp), %esi		# %esi = t4 + t5
+	addl	-24(%rbp), %esi		# %esi = %esi + t6
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_weighted_sum
+	.p2align	4, 0x90
+_weighted_sum:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/calls.c:55
+	movl	%edi, %esi		# %esi = a
+	addl	-8(%rbp), %esi		# %esi = a + b
+	movl	%esi, %edx
+	movl	-8(%rbp), %esi
+	callq	_weighted
+# alloc t3 (4 bytes) at -12(%rbp)
+	movl	%eax, -12(%rbp)		# t3 = weighted()
+	movl	-8(%rbp), %edi
+	movl	-4(%rbp), %esi
+	movl	$1, %edx
+	callq	_weighted
+# alloc t4 (4 bytes) at -16(%rbp)
+	movl	%eax, -16(%rbp)		# t4 = weighted()
+	movl	-12(%rbp), %esi		# %esi = t3
+	subl	-16(%rbp), %esi		# %esi = t3 - t4
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_triangles
+	.p2align	4, 0x90
+_triangles:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:59
+# alloc sum (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# sum = $0
+# golden/calls.c:60
+# alloc i (4 bytes) at -12(%rbp)
+	movl	$0, -12(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Ltriangles_2
+Ltriangles_0:
+# golden/calls.c:61
+	movl	-12(%rbp), %edi
+	callq	_triangle
+# alloc t4 (4 bytes) at -16(%rbp)
+	movl	%eax, -16(%rbp)		# t4 = triangle()
+	movl	-8(%rbp), %esi		# %esi = sum
+	addl	-16(%rbp), %esi		# %esi = sum + t4
+	movl	%esi, -8(%rbp)		# sum = %esi
+Ltriangles_1:
+	movl	-12(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -12(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Ltriangles_0
+Ltriangles_2:
+# golden/calls.c:63
+	movl	-8(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_factorial
+	.p2align	4, 0x90
+_factorial:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:67
+	callq	_fact
+# alloc t2 (4 bytes) at -8(%rbp)
+	leave
+	retq
+	.globl	_twice_scaled
+	.p2align	4, 0x90
+_twice_scaled:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:71
+	movl	$2, %esi
+	callq	_scale
+# alloc t2 (4 bytes) at -8(%rbp)
+	movl	%eax, -8(%rbp)		# t2 = scale()
+	movl	-4(%rbp), %esi		# %esi = x
+	addl	$1, %esi		# %esi = x + $1
+	movl	%esi, %edi
+	movl	$3, %esi
+	callq	_scale
+# alloc t3 (4 bytes) at -12(%rbp)
+	movl	%eax, -12(%rbp)		# t3 = scale()
+	movl	-8(%rbp), %esi		# %esi = t2
+	addl	-12(%rbp), %esi		# %esi = t2 + t3
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_scale
+	.p2align	4, 0x90
+_scale:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc k (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/calls.c:75
+# alloc ret (4 bytes) at -12(%rbp)
+	movl	$0, -12(%rbp)		# ret = $0
+# golden/calls.c:76
+# alloc i (4 bytes) at -16(%rbp)
+	movl	$0, -16(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-8(%rbp), %esi		# %esi = i < k
+	jge	Lscale_2
+Lscale_0:
+# golden/calls.c:77
+	movl	-12(%rbp), %esi		# %esi = ret
+	addl	-4(%rbp), %esi		# %esi = ret + x
+	movl	%esi, -12(%rbp)		# ret = %esi
+Lscale_1:
+	movl	-16(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -16(%rbp)		# i = %esi
+	cmpl	-8(%rbp), %esi		# %esi = i < k
+	jl	Lscale_0
+Lscale_2:
+# golden/calls.c:79
+	movl	-12(%rbp), %eax		# %eax = ret
+	leave
+	retq
+	.globl	_weigh8
+	.p2align	4, 0x90
+_weigh8:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movq	%rsi, -16(%rbp)
+# alloc c (8 bytes) at -24(%rbp)
+	movq	%rdx, -24(%rbp)
+# alloc d (8 bytes) at -32(%rbp)
+	movq	%rcx, -32(%rbp)
+# alloc e (8 bytes) at -40(%rbp)
+	movq	%r8, -40(%rbp)
+# alloc f (8 bytes) at -48(%rbp)
+	movq	%r9, -48(%rbp)
+# alloc g (8 bytes) at -56(%rbp)
+	movq	16(%rbp), %rax
+	movq	%rax, -56(%rbp)
+# alloc h (8 bytes) at -64(%rbp)
+	movq	24(%rbp), %rax
+	movq	%rax, -64(%rbp)
+# golden/calls.c:83
+	movq	%rdi, %rsi		# %rsi = a
+	movq	$2, %rdi		# %rdi = $2
+	imulq	-16(%rbp), %rdi		# %rdi = $2 * b
+	addq	%rdi, %rsi		# %rsi = a + %rdi
+	movq	$3, %rdi		# %rdi = $3
+	imulq	-24(%rbp), %rdi		# %rdi = $3 * c
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	$4, %rdi		# %rdi = $4
+	imulq	-32(%rbp), %rdi		# %rdi = $4 * d
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	$5, %rdi		# %rdi = $5
+	imulq	-40(%rbp), %rdi		# %rdi = $5 * e
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	$6, %rdi		# %rdi = $6
+	imulq	-48(%rbp), %rdi		# %rdi = $6 * f
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	$7, %rdi		# %rdi = $7
+	imulq	-56(%rbp), %rdi		# %rdi = $7 * g
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	$8, %rdi		# %rdi = $8
+	imulq	-64(%rbp), %rdi		# %rdi = $8 * h
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_stack_args
+	.p2align	4, 0x90
+_stack_args:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/calls.c:87
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$1, %rsi		# %rsi = x + $1
+# alloc t2 (8 bytes) at -16(%rbp)
+	movq	%rsi, -16(%rbp)		# t2 = %rsi
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$2, %rsi		# %rsi = x + $2
+# alloc t3 (8 bytes) at -24(%rbp)
+	movq	%rsi, -24(%rbp)		# t3 = %rsi
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$3, %rsi		# %rsi = x + $3
+# alloc t4 (8 bytes) at -32(%rbp)
+	movq	%rsi, -32(%rbp)		# t4 = %rsi
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$4, %rsi		# %rsi = x + $4
+# alloc t5 (8 bytes) at -40(%rbp)
+	movq	%rsi, -40(%rbp)		# t5 = %rsi
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$5, %rsi		# %rsi = x + $5
+# alloc t6 (8 bytes) at -48(%rbp)
+	movq	%rsi, -48(%rbp)		# t6 = %rsi
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$6, %rsi		# %rsi = x + $6
+# alloc t7 (8 bytes) at -56(%rbp)
+	movq	%rsi, -56(%rbp)		# t7 = %rsi
+	movq	%rdi, %rsi		# %rsi = x
+	addq	$7, %rsi		# %rsi = x + $7
+	subq	$16, %rsp
+	movq	%rsi, 8(%rsp)
+	movq	-56(%rbp), %rax
+	movq	%rax, 0(%rsp)
+	movq	-8(%rbp), %rdi
+	movq	-16(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movq	-40(%rbp), %r8
+	movq	-48(%rbp), %r9
+	callq	_weigh8
+	addq	$16, %rsp
+	movq	%rax, -56(%rbp)		# t7 = weigh8()
+	movq	-8(%rbp), %rsi		# %rsi = x
+	imulq	-8(%rbp), %rsi		# %rsi = x * x
+	subq	$16, %rsp
+	movq	%rsi, 8(%rsp)
+	movq	-8(%rbp), %rax
+	movq	%rax, 0(%rsp)
+	movq	$1, %rdi
+	movq	$2, %rsi
+	movq	$3, %rdx
+	movq	$4, %rcx
+	movq	$5, %r8
+	movq	$6, %r9
+	callq	_weigh8
+	addq	$16, %rsp
+	movq	%rax, -48(%rbp)		# t6 = weigh8()
+	movq	-56(%rbp), %rsi		# %rsi = t7
+	subq	-48(%rbp), %rsi		# %rsi = t7 - t6
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_average10
+	.p2align	4, 0x90
+_average10:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$80, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movsd	%xmm1, -16(%rbp)
+# alloc c (8 bytes) at -24(%rbp)
+	movsd	%xmm2, -24(%rbp)
+# alloc d (8 bytes) at -32(%rbp)
+	movsd	%xmm3, -32(%rbp)
+# alloc e (8 bytes) at -40(%rbp)
+	movsd	%xmm4, -40(%rbp)
+# alloc f (8 bytes) at -48(%rbp)
+	movsd	%xmm5, -48(%rbp)
+# alloc g (8 bytes) at -56(%rbp)
+	movsd	%xmm6, -56(%rbp)
+# alloc h (8 bytes) at -64(%rbp)
+	movsd	%xmm7, -64(%rbp)
+# alloc i (8 bytes) at -72(%rbp)
+	movsd	16(%rbp), %xmm0
+	movsd	%xmm0, -72(%rbp)
+# alloc j (8 bytes) at -80(%rbp)
+	movsd	24(%rbp), %xmm0
+	movsd	%xmm0, -80(%rbp)
+# golden/calls.c:91
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	addsd	-16(%rbp), %xmm8		# %xmm8 = a + b
+	addsd	-24(%rbp), %xmm8		# %xmm8 = %xmm8 + c
+	addsd	-32(%rbp), %xmm8		# %xmm8 = %xmm8 + d
+	addsd	-40(%rbp), %xmm8		# %xmm8 = %xmm8 + e
+	addsd	-48(%rbp), %xmm8		# %xmm8 = %xmm8 + f
+	addsd	-56(%rbp), %xmm8		# %xmm8 = %xmm8 + g
+	addsd	-64(%rbp), %xmm8		# %xmm8 = %xmm8 + h
+	movsd	-72(%rbp), %xmm9		# %xmm9 = i
+	mulsd	LCPI_average10_0(%rip), %xmm9		# %xmm9 = i * 2
+	addsd	%xmm9, %xmm8		# %xmm8 = %xmm8 + %xmm9
+	movsd	-80(%rbp), %xmm9		# %xmm9 = j
+	mulsd	LCPI_average10_1(%rip), %xmm9		# %xmm9 = j * 3
+	addsd	%xmm9, %xmm8		# %xmm8 = %xmm8 + %xmm9
+	divsd	LCPI_average10_2(%rip), %xmm8		# %xmm8 = %xmm8 / 13
+	movsd	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_average10_0:
+	.quad	0x4000000000000000		# 2
+	.literal8
+	.p2align	3
+LCPI_average10_1:
+	.quad	0x4008000000000000		# 3
+	.literal8
+	.p2align	3
+LCPI_average10_2:
+	.quad	0x402a000000000000		# 13
+	.text
+	.globl	_mixed9
+	.p2align	4, 0x90
+_mixed9:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$80, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movsd	%xmm0, -16(%rbp)
+# alloc c (8 bytes) at -24(%rbp)
+	movq	%rsi, -24(%rbp)
+# alloc d (8 bytes) at -32(%rbp)
+	movsd	%xmm1, -32(%rbp)
+# alloc e (8 bytes) at -40(%rbp)
+	movq	%rdx, -40(%rbp)
+# alloc f (8 bytes) at -48(%rbp)
+	movq	%rcx, -48(%rbp)
+# alloc g (8 bytes) at -56(%rbp)
+	movq	%r8, -56(%rbp)
+# alloc h (8 bytes) at -64(%rbp)
+	movq	%r9, -64(%rbp)
+# alloc i (8 bytes) at -72(%rbp)
+	movq	16(%rbp), %rax
+	movq	%rax, -72(%rbp)
+# golden/calls.c:95
+# alloc product (8 bytes) at -80(%rbp)
+	movsd	-16(%rbp), %xmm8		# %xmm8 = b
+	mulsd	-32(%rbp), %xmm8		# %xmm8 = b * d
+	cvttsd2si	%xmm8, %rsi		# (long) (b * d)
+	movq	%rsi, -80(%rbp)		# product = %rsi
+# golden/calls.c:96
+	movq	-8(%rbp), %rsi		# %rsi = a
+	subq	-24(%rbp), %rsi		# %rsi = a - c
+	addq	-40(%rbp), %rsi		# %rsi = %rsi + e
+	subq	-48(%rbp), %rsi		# %rsi = %rsi - f
+	addq	-56(%rbp), %rsi		# %rsi = %rsi + g
+	subq	-64(%rbp), %rsi		# %rsi = %rsi - h
+	movq	-72(%rbp), %rdi		# %rdi = i
+	# %rdi = i * $100
+	leaq	(%rdi,%rdi,4), %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	shlq	$2, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	addq	-80(%rbp), %rsi		# %rsi = %rsi + product
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_float_stack_args
+	.p2align	4, 0x90
+_float_stack_args:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# golden/calls.c:100
+# alloc thousandths (8 bytes) at -16(%rbp)
+	movsd	-8(%rbp), %xmm8		# %xmm8 = x
+	mulsd	LCPI_float_stack_args_0(%rip), %xmm8		# %xmm8 = x * 2
+# alloc t3 (8 bytes) at -24(%rbp)
+	movsd	%xmm8, -24(%rbp)		# t3 = %xmm8
+	movsd	-8(%rbp), %xmm8		# %xmm8 = x
+	addsd	LCPI_float_stack_args_1(%rip), %xmm8		# %xmm8 = x + 0.25
+	subq	$16, %rsp
+	movsd	%xmm8, 8(%rsp)
+	movsd	-24(%rbp), %xmm0
+	movsd	%xmm0, 0(%rsp)
+	movsd	-8(%rbp), %xmm0
+	movsd	LCPI_float_stack_args_2(%rip), %xmm1
+	movsd	LCPI_float_stack_args_3(%rip), %xmm2
+	movsd	LCPI_float_stack_args_4(%rip), %xmm3
+	movsd	LCPI_float_stack_args_5(%rip), %xmm4
+	movsd	LCPI_float_stack_args_6(%rip), %xmm5
+	movsd	LCPI_float_stack_args_7(%rip), %xmm6
+	movsd	LCPI_float_stack_args_8(%rip), %xmm7
+	callq	_average10
+	addq	$16, %rsp
+	movsd	%xmm0, -24(%rbp)		# t3 = average10()
+	movsd	-24(%rbp), %xmm8		# %xmm8 = t3
+	mulsd	LCPI_float_stack_args_9(%rip), %xmm8		# %xmm8 = t3 * 1000
+	cvttsd2si	%xmm8, %rsi		# (long) (t3 * 1000)
+	movq	%rsi, -16(%rbp)		# thousandths = %rsi
+# golden/calls.c:101
+# alloc truncated (8 bytes) at -32(%rbp)
+	cvttsd2si	-8(%rbp), %rsi		# (long) x
+	movq	%rsi, -32(%rbp)		# truncated = %rsi
+# golden/calls.c:102
+	subq	$16, %rsp
+	movq	%rsi, %rax
+	movq	%rax, 0(%rsp)
+	movq	$1, %rdi
+	movsd	-8(%rbp), %xmm0
+	movq	$2, %rsi
+	movsd	LCPI_float_stack_args_10(%rip), %xmm1
+	movq	$3, %rdx
+	movq	$4, %rcx
+	movq	$5, %r8
+	movq	$6, %r9
+	callq	_mixed9
+	addq	$16, %rsp
+# alloc t5 (8 bytes) at -40(%rbp)
+	movq	%rax, -40(%rbp)		# t5 = mixed9()
+	movq	-16(%rbp), %rsi		# %rsi = thousandths
+	addq	-40(%rbp), %rsi		# %rsi = thousandths + t5
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_0:
+	.quad	0x4000000000000000		# 2
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_1:
+	.quad	0x3fd0000000000000		# 0.25
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_2:
+	.quad	0x3ff8000000000000		# 1.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_3:
+	.quad	0x4004000000000000		# 2.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_4:
+	.quad	0x400c000000000000		# 3.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_5:
+	.quad	0x4012000000000000		# 4.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_6:
+	.quad	0x4016000000000000		# 5.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_7:
+	.quad	0x401a000000000000		# 6.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_8:
+	.quad	0x401e000000000000		# 7.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_9:
+	.quad	0x408f400000000000		# 1000
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_10:
+	.quad	0x3fe0000000000000		# 0.5
+	.text
+	.globl	_twice
+	.p2align	4, 0x90
+_twice:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/calls.c:106
+	movl	%edi, %esi		# %esi = x
+	addl	-4(%rbp), %esi		# %esi = x + x
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_kept_across_calls
+	.p2align	4, 0x90
+_kept_across_calls:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc y (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/calls.c:110
+# alloc product (4 bytes) at -12(%rbp)
+	movl	%edi, %esi		# %esi = x
+	imull	-8(%rbp), %esi		# %esi = x * y
+	movl	%esi, -12(%rbp)		# product = %esi
+# golden/calls.c:111
+# alloc sum (4 bytes) at -16(%rbp)
+	movl	%edi, %esi		# %esi = x
+	addl	-8(%rbp), %esi		# %esi = x + y
+	movl	%esi, -16(%rbp)		# sum = %esi
+# golden/calls.c:112
+# alloc doubled (4 bytes) at -20(%rbp)
+	movl	-12(%rbp), %edi
+	callq	_twice
+# alloc t6 (4 bytes) at -24(%rbp)
+	movl	%eax, -24(%rbp)		# t6 = twice()
+	movl	%eax, %esi		# %esi = t6
+	movl	%esi, -20(%rbp)		# doubled = %esi
+# golden/calls.c:113
+	movl	-16(%rbp), %edi
+	callq	_twice
+# alloc t7 (4 bytes) at -28(%rbp)
+	movl	-20(%rbp), %esi		# %esi = doubled
+	movl	%eax, %edi		# %edi = t7
+	imull	-12(%rbp), %edi		# %edi = t7 * product
+	addl	%edi, %esi		# %esi = doubled + %edi
+	addl	-16(%rbp), %esi		# %esi = %esi + sum
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
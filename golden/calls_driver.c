@@ -0,0 +1,40 @@
+#include <stdio.h>
+
+extern int sum_squares(int n);
+extern int fourth_power(int x);
+extern int clamped_sum(int a, int b, int c);
+extern int weighted_sum(int a, int b);
+extern int triangles(int n);
+extern int factorial(int n);
+extern int twice_scaled(int x);
+extern long stack_args(long x);
+extern long weigh8(long a, long b, long c, long d, long e, long f, long g, long h);
+extern long float_stack_args(double x);
+extern int kept_across_calls(int x, int y);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(sum_squares(0));
+  print_expr(sum_squares(10));
+  print_expr(fourth_power(3));
+  print_expr(fourth_power(-7));
+  print_expr(clamped_sum(1, 2, 3));
+  print_expr(clamped_sum(-4, 20, -9));
+  print_expr(clamped_sum(5, 1, 7));
+  print_expr(weighted_sum(4, 5));
+  print_expr(weighted_sum(-2, 9));
+  print_expr(triangles(0));
+  print_expr(triangles(8));
+  print_expr(factorial(1));
+  print_expr(factorial(10));
+  print_expr(twice_scaled(7));
+  print_expr(twice_scaled(-3));
+  print_expr(stack_args(3));
+  print_expr(stack_args(-10));
+  print_expr(weigh8(1, 1, 1, 1, 1, 1, 1, 100));
+  print_expr(float_stack_args(2.0));
+  print_expr(float_stack_args(-7.5));
+  print_expr(kept_across_calls(3, 4));
+  print_expr(kept_across_calls(-6, 11));
+}
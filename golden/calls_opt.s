@@ -0,0 +1,588 @@
+	.p2align	4, 0x90
+_square:
+	movl	%edi, %esi
+	imull	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.p2align	4, 0x90
+_clamp:
+	movq	%rdx, %r8
+	cmpl	%esi, %edi
+	jge	Lclamp_2
+Lclamp_3:
+	movl	%esi, %eax
+	retq
+Lclamp_2:
+	cmpl	%r8d, %edi
+	jle	Lclamp_4
+Lclamp_5:
+	movl	%r8d, %eax
+	retq
+Lclamp_4:
+	movl	%edi, %eax
+	retq
+	.p2align	4, 0x90
+_weighted:
+	movq	%rdx, %r8
+	shll	$1, %esi
+	addl	%edi, %esi
+	movl	%r8d, %edi
+	leal	(%rdi,%rdi,2), %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.p2align	4, 0x90
+_triangle:
+	cmpl	$0, %edi
+	jle	Ltriangle_7
+Ltriangle_5:
+	xorl	%esi, %esi
+	.p2align	4, 0x90
+Ltriangle_2:
+	addl	%edi, %esi
+	subl	$1, %edi
+Ltriangle_3:
+	cmpl	$0, %edi
+	jg	Ltriangle_2
+Ltriangle_4:
+	movl	%esi, %eax
+	retq
+Ltriangle_7:
+	xorl	%esi, %esi
+	jmp	Ltriangle_4
+	.p2align	4, 0x90
+_fact:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	subq	$8, %rsp
+	movq	%rdi, %rbx
+	cmpl	$2, %ebx
+	jge	Lfact_2
+Lfact_3:
+	movl	$1, %eax
+	leaq	-8(%rbp), %rsp
+	popq	%rbx
+	popq	%rbp
+	retq
+Lfact_2:
+	movl	%ebx, %esi
+	subl	$1, %esi
+	movq	%rsi, %rdi
+	callq	_fact
+	movl	%eax, %esi
+	imull	%ebx, %esi
+	movl	%esi, %eax
+	leaq	-8(%rbp), %rsp
+	popq	%rbx
+	popq	%rbp
+	retq
+	.globl	_sum_squares
+	.p2align	4, 0x90
+_sum_squares:
+	movl	$1, %r11d
+	cmpl	%edi, %r11d
+	jg	Lsum_squares_9
+Lsum_squares_5:
+	movq	$1, %rsi
+	xorl	%r8d, %r8d
+	.p2align	4, 0x90
+Lsum_squares_2:
+Lsum_squares_8:
+	movl	%esi, %r9d
+	imull	%esi, %r9d
+Lsum_squares_7:
+	addl	%r9d, %r8d
+Lsum_squares_3:
+	addl	$1, %esi
+	cmpl	%edi, %esi
+	jle	Lsum_squares_2
+Lsum_squares_4:
+	movl	%r8d, %eax
+	retq
+Lsum_squares_9:
+	xorl	%r8d, %r8d
+	jmp	Lsum_squares_4
+	.globl	_fourth_power
+	.p2align	4, 0x90
+_fourth_power:
+Lfourth_power_3:
+	movl	%edi, %esi
+	imull	%edi, %esi
+Lfourth_power_5:
+	movl	%esi, %r11d
+	imull	%esi, %r11d
+	movl	%r11d, %esi
+Lfourth_power_4:
+	movl	%esi, %eax
+	retq
+	.globl	_clamped_sum
+	.p2align	4, 0x90
+_clamped_sum:
+	pushq	%rbx
+	movq	%rdx, %r8
+	leal	(%rdi,%rdi,2), %edi
+	subl	%esi, %edi
+Lclamped_sum_3:
+	cmpl	$0, %edi
+	jge	Lclamped_sum_4
+Lclamped_sum_7:
+	xorl	%r9d, %r9d
+Lclamped_sum_2:
+Lclamped_sum_9:
+	cmpl	$0, %esi
+	jge	Lclamped_sum_10
+Lclamped_sum_13:
+	xorl	%r10d, %r10d
+Lclamped_sum_8:
+	addl	%r9d, %r10d
+Lclamped_sum_15:
+	cmpl	$-5, %r8d
+	jge	Lclamped_sum_16
+Lclamped_sum_19:
+	movq	$-5, %rbx
+Lclamped_sum_14:
+	addl	%r10d, %ebx
+	movl	%ebx, %eax
+	popq	%rbx
+	retq
+Lclamped_sum_4:
+	cmpl	$10, %edi
+	jle	Lclamped_sum_5
+Lclamped_sum_6:
+	movq	$10, %r9
+	jmp	Lclamped_sum_2
+Lclamped_sum_5:
+	movq	%rdi, %r9
+	jmp	Lclamped_sum_2
+Lclamped_sum_10:
+	cmpl	$10, %esi
+	jle	Lclamped_sum_11
+Lclamped_sum_12:
+	movq	$10, %r10
+	jmp	Lclamped_sum_8
+Lclamped_sum_11:
+	movq	%rsi, %r10
+	jmp	Lclamped_sum_8
+Lclamped_sum_16:
+	cmpl	$5, %r8d
+	jle	Lclamped_sum_17
+Lclamped_sum_18:
+	movq	$5, %rbx
+	jmp	Lclamped_sum_14
+Lclamped_sum_17:
+	movq	%r8, %rbx
+	jmp	Lclamped_sum_14
+	.globl	_weighted_sum
+	.p2align	4, 0x90
+_weighted_sum:
+	movl	%edi, %r8d
+	addl	%esi, %r8d
+Lweighted_sum_3:
+	movl	%esi, %r9d
+	shll	$1, %r9d
+	addl	%edi, %r9d
+	leal	(%r8,%r8,2), %r8d
+	addl	%r9d, %r8d
+Lweighted_sum_5:
+	shll	$1, %edi
+	addl	%edi, %esi
+	addl	$3, %esi
+Lweighted_sum_4:
+	movl	%r8d, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %eax
+	retq
+	.globl	_triangles
+	.p2align	4, 0x90
+_triangles:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Ltriangles_14
+Ltriangles_5:
+	xorl	%esi, %esi
+	xorl	%r8d, %r8d
+	.p2align	4, 0x90
+Ltriangles_2:
+Ltriangles_8:
+	cmpl	$0, %esi
+	jle	Ltriangles_16
+Ltriangles_9:
+	xorl	%r9d, %r9d
+	movq	%rsi, %r10
+	.p2align	4, 0x90
+Ltriangles_10:
+	addl	%r10d, %r9d
+	subl	$1, %r10d
+Ltriangles_11:
+	cmpl	$0, %r10d
+	jg	Ltriangles_10
+Ltriangles_13:
+Ltriangles_7:
+	addl	%r8d, %r9d
+Ltriangles_3:
+	movl	%esi, %r10d
+	addl	$1, %r10d
+	cmpl	%edi, %r10d
+	jge	Ltriangles_4
+Ltriangles_15:
+	movq	%r10, %rsi
+	movq	%r9, %r8
+	jmp	Ltriangles_2
+Ltriangles_4:
+	movl	%r9d, %eax
+	retq
+Ltriangles_14:
+	xorl	%r9d, %r9d
+	jmp	Ltriangles_4
+Ltriangles_16:
+	xorl	%r9d, %r9d
+	jmp	Ltriangles_13
+	.globl	_factorial
+	.p2align	4, 0x90
+_factorial:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	subq	$8, %rsp
+	movq	%rdi, %rbx
+Lfactorial_3:
+	cmpl	$2, %ebx
+	jge	Lfactorial_4
+Lfactorial_5:
+	movq	$1, %rsi
+Lfactorial_2:
+	movl	%esi, %eax
+	leaq	-8(%rbp), %rsp
+	popq	%rbx
+	popq	%rbp
+	retq
+Lfactorial_4:
+	movl	%ebx, %esi
+	subl	$1, %esi
+	movq	%rsi, %rdi
+	callq	_fact
+	movl	%eax, %esi
+	imull	%ebx, %esi
+	jmp	Lfactorial_2
+	.globl	_twice_scaled
+	.p2align	4, 0x90
+_twice_scaled:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	pushq	%r12
+	movq	%rdi, %rbx
+	movq	%rbx, %rdi
+	movq	$2, %rsi
+	callq	_scale
+	movl	%eax, %r12d
+	movl	%ebx, %esi
+	addl	$1, %esi
+	movq	%rsi, %rdi
+	movq	$3, %rsi
+	callq	_scale
+	movl	%eax, %esi
+	addl	%r12d, %esi
+	movl	%esi, %eax
+	leaq	-16(%rbp), %rsp
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	retq
+	.globl	_scale
+	.p2align	4, 0x90
+_scale:
+	xorl	%r11d, %r11d
+	cmpl	%esi, %r11d
+	jge	Lscale_7
+Lscale_5:
+	xorl	%r8d, %r8d
+	xorl	%r9d, %r9d
+	.p2align	4, 0x90
+Lscale_2:
+	addl	%edi, %r8d
+Lscale_3:
+	addl	$1, %r9d
+	cmpl	%esi, %r9d
+	jl	Lscale_2
+Lscale_4:
+	movl	%r8d, %eax
+	retq
+Lscale_7:
+	xorl	%r8d, %r8d
+	jmp	Lscale_4
+	.globl	_weigh8
+	.p2align	4, 0x90
+_weigh8:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	movq	40(%rsp), %r13
+	movq	32(%rsp), %r12
+	movq	%r9, %rbx
+	movq	%r8, %r10
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	shlq	$1, %rsi
+	addq	%rdi, %rsi
+	movq	%r8, %rdi
+	leaq	(%rdi,%rdi,2), %rdi
+	addq	%rdi, %rsi
+	movq	%r9, %rdi
+	shlq	$2, %rdi
+	addq	%rdi, %rsi
+	movq	%r10, %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	addq	%rdi, %rsi
+	movq	%rbx, %rdi
+	leaq	(%rdi,%rdi,2), %rdi
+	shlq	$1, %rdi
+	addq	%rdi, %rsi
+	movq	%r12, %rdi
+	movq	%rdi, %rax
+	shlq	$3, %rdi
+	subq	%rax, %rdi
+	addq	%rdi, %rsi
+	movq	%r13, %rdi
+	shlq	$3, %rdi
+	addq	%rdi, %rsi
+	movq	%rsi, %rax
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+	.globl	_stack_args
+	.p2align	4, 0x90
+_stack_args:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	subq	$24, %rsp
+	movq	%rdi, %rbx
+	movq	%rbx, %rsi
+	addq	$1, %rsi
+	movq	%rbx, %rdi
+	addq	$2, %rdi
+	movq	%rbx, %r8
+	addq	$3, %r8
+	movq	%rbx, %r9
+	addq	$4, %r9
+	movq	%rbx, %r10
+	addq	$5, %r10
+	movq	%rbx, %r12
+	addq	$6, %r12
+	movq	%rbx, %r13
+	addq	$7, %r13
+	movq	%r13, -40(%rbp)
+	movq	%r12, -48(%rbp)
+	movq	%rdi, %rdx
+	movq	%r8, %rcx
+	movq	%rbx, %rdi
+	movq	%r9, %r8
+	movq	%r10, %r9
+	callq	_weigh8
+	movq	%rax, %r12
+	movq	%rbx, %rsi
+	imulq	%rbx, %rsi
+	movq	$1, %rdi
+	movq	%rsi, -40(%rbp)
+	movq	%rbx, -48(%rbp)
+	movq	$6, %r9
+	movq	$5, %r8
+	movq	$4, %rcx
+	movq	$3, %rdx
+	movq	$2, %rsi
+	callq	_weigh8
+	movq	%rax, %rsi
+	movq	%r12, %r11
+	subq	%rsi, %r11
+	movq	%r11, %rax
+	leaq	-24(%rbp), %rsp
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	retq
+	.globl	_average10
+	.p2align	4, 0x90
+_average10:
+	movsd	16(%rsp), %xmm9
+	movsd	8(%rsp), %xmm8
+	addsd	%xmm1, %xmm0
+	addsd	%xmm2, %xmm0
+	addsd	%xmm3, %xmm0
+	addsd	%xmm4, %xmm0
+	addsd	%xmm5, %xmm0
+	addsd	%xmm6, %xmm0
+	addsd	%xmm7, %xmm0
+	movaps	%xmm8, %xmm1
+	mulsd	LCPI_average10_0(%rip), %xmm1
+	addsd	%xmm1, %xmm0
+	movaps	%xmm9, %xmm1
+	mulsd	LCPI_average10_1(%rip), %xmm1
+	addsd	%xmm1, %xmm0
+	divsd	LCPI_average10_2(%rip), %xmm0
+	retq
+	.literal8
+	.p2align	3
+LCPI_average10_0:
+	.quad	0x4000000000000000		# 2
+	.literal8
+	.p2align	3
+LCPI_average10_1:
+	.quad	0x4008000000000000		# 3
+	.literal8
+	.p2align	3
+LCPI_average10_2:
+	.quad	0x402a000000000000		# 13
+	.text
+	.globl	_mixed9
+	.p2align	4, 0x90
+_mixed9:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	movq	32(%rsp), %r12
+	movq	%r9, %rbx
+	movq	%r8, %r10
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	mulsd	%xmm1, %xmm0
+	cvttsd2si	%xmm0, %r13
+	movq	%rdi, %r11
+	subq	%rsi, %r11
+	movq	%r11, %rsi
+	addq	%r8, %rsi
+	subq	%r9, %rsi
+	addq	%r10, %rsi
+	subq	%rbx, %rsi
+	movq	%r12, %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	shlq	$2, %rdi
+	addq	%rdi, %rsi
+	addq	%r13, %rsi
+	movq	%rsi, %rax
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+	.globl	_float_stack_args
+	.p2align	4, 0x90
+_float_stack_args:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	subq	$24, %rsp
+	movaps	%xmm0, %xmm10
+	movaps	%xmm10, %xmm0
+	mulsd	LCPI_float_stack_args_0(%rip), %xmm0
+	movaps	%xmm10, %xmm1
+	addsd	LCPI_float_stack_args_1(%rip), %xmm1
+	movsd	LCPI_float_stack_args_3(%rip), %xmm2
+	movsd	%xmm1, -24(%rbp)
+	movsd	%xmm0, -32(%rbp)
+	movsd	LCPI_float_stack_args_8(%rip), %xmm7
+	movsd	LCPI_float_stack_args_7(%rip), %xmm6
+	movsd	LCPI_float_stack_args_6(%rip), %xmm5
+	movsd	LCPI_float_stack_args_5(%rip), %xmm4
+	movsd	LCPI_float_stack_args_4(%rip), %xmm3
+	movaps	%xmm10, %xmm0
+	movsd	LCPI_float_stack_args_2(%rip), %xmm1
+	callq	_average10
+	mulsd	LCPI_float_stack_args_9(%rip), %xmm0
+	cvttsd2si	%xmm0, %rbx
+	cvttsd2si	%xmm10, %rsi
+	movq	$1, %rdi
+	movq	%rsi, -32(%rbp)
+	movq	$6, %r9
+	movq	$5, %r8
+	movq	$4, %rcx
+	movq	$3, %rdx
+	movsd	LCPI_float_stack_args_10(%rip), %xmm1
+	movq	$2, %rsi
+	movaps	%xmm10, %xmm0
+	callq	_mixed9
+	movq	%rax, %rsi
+	addq	%rbx, %rsi
+	movq	%rsi, %rax
+	leaq	-8(%rbp), %rsp
+	popq	%rbx
+	popq	%rbp
+	retq
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_0:
+	.quad	0x4000000000000000		# 2
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_1:
+	.quad	0x3fd0000000000000		# 0.25
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_2:
+	.quad	0x3ff8000000000000		# 1.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_3:
+	.quad	0x4004000000000000		# 2.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_4:
+	.quad	0x400c000000000000		# 3.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_5:
+	.quad	0x4012000000000000		# 4.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_6:
+	.quad	0x4016000000000000		# 5.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_7:
+	.quad	0x401a000000000000		# 6.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_8:
+	.quad	0x401e000000000000		# 7.5
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_9:
+	.quad	0x408f400000000000		# 1000
+	.literal8
+	.p2align	3
+LCPI_float_stack_args_10:
+	.quad	0x3fe0000000000000		# 0.5
+	.text
+	.globl	_twice
+	.p2align	4, 0x90
+_twice:
+	movl	%edi, %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_kept_across_calls
+	.p2align	4, 0x90
+_kept_across_calls:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	movl	%edi, %r8d
+	imull	%esi, %r8d
+	movl	%edi, %r9d
+	addl	%esi, %r9d
+	movq	%r8, %rdi
+	callq	_twice
+	movl	%eax, %r10d
+	movq	%r9, %rdi
+	callq	_twice
+	movl	%eax, %esi
+	imull	%r8d, %esi
+	addl	%r10d, %esi
+	addl	%r9d, %esi
+	movl	%esi, %eax
+	leave
+	retq
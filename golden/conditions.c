@@ -0,0 +1,82 @@
+int in_range(int x, int lo, int hi) {
+  return x >= lo && x <= hi;
+}
+
+int outside(int x, int lo, int hi) {
+  return x < lo || x > hi;
+}
+
+int negations(int x, int y) {
+  return !x + !!y * 2 + !(x < y) * 4;
+}
+
+int safe_ratio_above(int a, int b, int limit) {
+  if (b != 0 && a / b > limit)
+    return 1;
+  if (b == 0 || a / b < 0 - limit)
+    return 2;
+  return 0;
+}
+
+int count_matches(int n, int lo, int hi, int step) {
+  int count = 0;
+  for (int i = 0; i < n && count < 1000; i++) {
+    int v = i * step - 50;
+    if (v > lo && (v < hi || v == 500) && !(v == 7 || v == 11))
+      count++;
+  }
+  return count;
+}
+
+int first_gap(int n) {
+  int values[32];
+  for (int i = 0; i < 32; i++) {
+    values[i] = i * 3 - i / 4 * 2;
+  }
+  int i = 1;
+  while (i < n && (values[i] - values[i - 1] == 3 || values[i] - values[i - 1] == 1))
+    i++;
+  return i;
+}
+
+int collatz_steps(int x) {
+  int steps = 0;
+  do {
+    if (x / 2 * 2 == x)
+      x = x / 2;
+    else
+      x = 3 * x + 1;
+    steps++;
+  } while (x != 1 && (steps < 100 || x < 0));
+  return steps;
+}
+
+int either_positive(double a, double b) {
+  return a > 0 || b > 0 ? 10 : 20;
+}
+
+int truthy(double d, long l) {
+  int r = d && l;
+  if (!d || !l)
+    r += 2;
+  return r;
+}
+
+int with_comma(int x) {
+  int t;
+  if (t = x * 2, t > 10 && t < 20)
+    return t;
+  return 0 - t;
+}
+
+int constant_cases(int x) {
+  switch (x) {
+    case 1 && 2:
+      return 10;
+    case !0 + 4:
+      return 20;
+    case (3 || 0) + 6:
+      return 30;
+  }
+  return 0;
+}
@@ -0,0 +1,546 @@
+	.globl	_in_range
+	.p2align	4, 0x90
+_in_range:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc lo (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc hi (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/conditions.c:2
+	movl	%edi, %esi		# %esi = x
+	cmpl	-8(%rbp), %esi		# %esi = x >= lo
+	jl	Lin_range_0
+# alloc condition (4 bytes) at -16(%rbp)
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	-12(%rbp), %esi		# %esi = x <= hi
+	setle	%sil
+	movzbl	%sil, %esi
+	movl	%esi, -16(%rbp)		# condition = %esi
+	jmp	Lin_range_1
+Lin_range_0:
+	movl	$0, -16(%rbp)		# condition = $0
+Lin_range_1:
+	movl	-16(%rbp), %eax		# %eax = condition
+	leave
+	retq
+	.globl	_outside
+	.p2align	4, 0x90
+_outside:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc lo (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc hi (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/conditions.c:6
+	movl	%edi, %esi		# %esi = x
+	cmpl	-8(%rbp), %esi		# %esi = x < lo
+	jl	Loutside_0
+# alloc condition (4 bytes) at -16(%rbp)
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	-12(%rbp), %esi		# %esi = x > hi
+	setg	%sil
+	movzbl	%sil, %esi
+	movl	%esi, -16(%rbp)		# condition = %esi
+	jmp	Loutside_1
+Loutside_0:
+	movl	$1, -16(%rbp)		# condition = $1
+Loutside_1:
+	movl	-16(%rbp), %eax		# %eax = condition
+	leave
+	retq
+	.globl	_negations
+	.p2align	4, 0x90
+_negations:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc y (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/conditions.c:10
+	movl	%edi, %esi		# %esi = x
+	cmpl	$0, %esi		# %esi = x == $0
+	sete	%sil
+	movzbl	%sil, %esi
+	movl	-8(%rbp), %edi		# %edi = y
+	cmpl	$0, %edi		# %edi = y != $0
+	setne	%dil
+	movzbl	%dil, %edi
+	# %edi = %edi * $2
+	shll	$1, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	cmpl	-8(%rbp), %edi		# %edi = x < y
+	setl	%dil
+	movzbl	%dil, %edi
+	cmpl	$0, %edi		# %edi = %edi == $0
+	sete	%dil
+	movzbl	%dil, %edi
+	# %edi = %edi * $4
+	shll	$2, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_safe_ratio_above
+	.p2align	4, 0x90
+_safe_ratio_above:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc limit (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/conditions.c:14
+	cmpl	$0, %esi		# %esi = b != $0
+	je	Lsafe_ratio_above_1
+	movl	-4(%rbp), %eax		# %eax = a
+	cdq
+	idivl	-8(%rbp)		# %eax = a / b
+	movl	%eax, %esi
+	cmpl	-12(%rbp), %esi		# %esi = %esi > limit
+	jle	Lsafe_ratio_above_0
+	movl	$1, %eax		# %eax = $1
+	leave
+	retq
+Lsafe_ratio_above_0:
+Lsafe_ratio_above_1:
+# golden/conditions.c:16
+	movl	-8(%rbp), %esi		# %esi = b
+	cmpl	$0, %esi		# %esi = b == $0
+	je	Lsafe_ratio_above_3
+	movl	-4(%rbp), %eax		# %eax = a
+	cdq
+	idivl	-8(%rbp)		# %eax = a / b
+	movl	%eax, %esi
+	movl	$0, %edi		# %edi = $0
+	subl	-12(%rbp), %edi		# %edi = $0 - limit
+	cmpl	%edi, %esi		# %esi = %esi < %edi
+	jge	Lsafe_ratio_above_2
+Lsafe_ratio_above_3:
+	movl	$2, %eax		# %eax = $2
+	leave
+	retq
+Lsafe_ratio_above_2:
+# golden/conditions.c:18
+	movl	$0, %eax		# %eax = $0
+	leave
+	retq
+	.globl	_count_matches
+	.p2align	4, 0x90
+_count_matches:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc lo (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc hi (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# alloc step (4 bytes) at -16(%rbp)
+	movl	%ecx, -16(%rbp)
+# golden/conditions.c:22
+# alloc count (4 bytes) at -20(%rbp)
+	movl	$0, -20(%rbp)		# count = $0
+# golden/conditions.c:23
+# alloc i (4 bytes) at -24(%rbp)
+	movl	$0, -24(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lcount_matches_3
+	movl	-20(%rbp), %esi		# %esi = count
+	cmpl	$1000, %esi		# %esi = count < $1000
+	jge	Lcount_matches_2
+Lcount_matches_0:
+# golden/conditions.c:24
+# alloc v (4 bytes) at -28(%rbp)
+	movl	-24(%rbp), %esi		# %esi = i
+	imull	-16(%rbp), %esi		# %esi = i * step
+	subl	$50, %esi		# %esi = %esi - $50
+	movl	%esi, -28(%rbp)		# v = %esi
+# golden/conditions.c:25
+	cmpl	-8(%rbp), %esi		# %esi = v > lo
+	jle	Lcount_matches_5
+	movl	-28(%rbp), %esi		# %esi = v
+	cmpl	-12(%rbp), %esi		# %esi = v < hi
+	jl	Lcount_matches_6
+	movl	-28(%rbp), %esi		# %esi = v
+	cmpl	$500, %esi		# %esi = v == $500
+	jne	Lcount_matches_5
+Lcount_matches_6:
+	movl	-28(%rbp), %esi		# %esi = v
+	cmpl	$7, %esi		# %esi = v == $7
+	je	Lcount_matches_7
+	movl	-28(%rbp), %esi		# %esi = v
+	cmpl	$11, %esi		# %esi = v == $11
+	je	Lcount_matches_4
+	movl	-20(%rbp), %esi		# %esi = count
+	addl	$1, %esi		# %esi = count + $1
+	movl	%esi, -20(%rbp)		# count = %esi
+Lcount_matches_4:
+Lcount_matches_5:
+Lcount_matches_7:
+Lcount_matches_1:
+	movl	-24(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -24(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lcount_matches_8
+	movl	-20(%rbp), %esi		# %esi = count
+	cmpl	$1000, %esi		# %esi = count < $1000
+	jl	Lcount_matches_0
+Lcount_matches_8:
+Lcount_matches_2:
+Lcount_matches_3:
+# golden/conditions.c:28
+	movl	-20(%rbp), %eax		# %eax = count
+	leave
+	retq
+	.globl	_first_gap
+	.p2align	4, 0x90
+_first_gap:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$144, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/conditions.c:32
+# alloc values (128 bytes) at -132(%rbp)
+# golden/conditions.c:33
+# alloc i (4 bytes) at -136(%rbp)
+	movl	$0, -136(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	$32, %esi		# %esi = i < $32
+	jge	Lfirst_gap_2
+Lfirst_gap_0:
+# golden/conditions.c:34
+	movl	-136(%rbp), %esi		# %esi = i
+	# %esi = i * $3
+	leal	(%rsi,%rsi,2), %esi
+	movl	-136(%rbp), %edi		# %edi = i
+	# %edi = i / $4
+	leal	3(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$2, %eax
+	movl	%eax, %edi
+	# %edi = %edi * $2
+	shll	$1, %edi
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movslq	-136(%rbp), %rcx
+	movl	%esi, -132(%rbp,%rcx,4)		# values[i] = %esi
+Lfirst_gap_1:
+	movl	-136(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -136(%rbp)		# i = %esi
+	cmpl	$32, %esi		# %esi = i < $32
+	jl	Lfirst_gap_0
+Lfirst_gap_2:
+# golden/conditions.c:36
+# alloc i (4 bytes) at -140(%rbp)
+	movl	$1, -140(%rbp)		# i = $1
+# golden/conditions.c:37
+	movl	$1, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lfirst_gap_6
+	movslq	-140(%rbp), %rcx
+	movl	-132(%rbp,%rcx,4), %esi		# %esi = values[i]
+	movl	-140(%rbp), %edi		# %edi = i
+	subl	$1, %edi		# %edi = i - $1
+	movslq	%edi, %rcx
+	movl	-132(%rbp,%rcx,4), %edi		# %edi = values[(i - $1)]
+	subl	%edi, %esi		# %esi = values[i] - values[(i - $1)]
+	cmpl	$3, %esi		# %esi = %esi == $3
+	je	Lfirst_gap_7
+	movslq	-140(%rbp), %rcx
+	movl	-132(%rbp,%rcx,4), %esi		# %esi = values[i]
+	movl	-140(%rbp), %edi		# %edi = i
+	subl	$1, %edi		# %edi = i - $1
+	movslq	%edi, %rcx
+	movl	-132(%rbp,%rcx,4), %edi		# %edi = values[(i - $1)]
+	subl	%edi, %esi		# %esi = values[i] - values[(i - $1)]
+	cmpl	$1, %esi		# %esi = %esi == $1
+	jne	Lfirst_gap_5
+Lfirst_gap_7:
+Lfirst_gap_3:
+	movl	-140(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -140(%rbp)		# i = %esi
+Lfirst_gap_4:
+	movl	-140(%rbp), %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lfirst_gap_8
+	movslq	-140(%rbp), %rcx
+	movl	-132(%rbp,%rcx,4), %esi		# %esi = values[i]
+	movl	-140(%rbp), %edi		# %edi = i
+	subl	$1, %edi		# %edi = i - $1
+	movslq	%edi, %rcx
+	movl	-132(%rbp,%rcx,4), %edi		# %edi = values[(i - $1)]
+	subl	%edi, %esi		# %esi = values[i] - values[(i - $1)]
+	cmpl	$3, %esi		# %esi = %esi == $3
+	je	Lfirst_gap_9
+	movslq	-140(%rbp), %rcx
+	movl	-132(%rbp,%rcx,4), %esi		# %esi = values[i]
+	movl	-140(%rbp), %edi		# %edi = i
+	subl	$1, %edi		# %edi = i - $1
+	movslq	%edi, %rcx
+	movl	-132(%rbp,%rcx,4), %edi		# %edi = values[(i - $1)]
+	subl	%edi, %esi		# %esi = values[i] - values[(i - $1)]
+	cmpl	$1, %esi		# %esi = %esi == $1
+	jne	Lfirst_gap_10
+Lfirst_gap_9:
+	jmp	Lfirst_gap_3
+Lfirst_gap_10:
+Lfirst_gap_8:
+Lfirst_gap_5:
+Lfirst_gap_6:
+# golden/conditions.c:39
+	movl	-140(%rbp), %eax		# %eax = i
+	leave
+	retq
+	.globl	_collatz_steps
+	.p2align	4, 0x90
+_collatz_steps:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/conditions.c:43
+# alloc steps (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# steps = $0
+# golden/conditions.c:44
+Lcollatz_steps_0:
+# golden/conditions.c:45
+	movl	-4(%rbp), %esi		# %esi = x
+	# %esi = x / $2
+	leal	1(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$1, %eax
+	movl	%eax, %esi
+	# %esi = %esi * $2
+	shll	$1, %esi
+	cmpl	-4(%rbp), %esi		# %esi = %esi == x
+	jne	Lcollatz_steps_3
+	movl	-4(%rbp), %esi		# %esi = x
+	# %esi = x / $2
+	leal	1(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$1, %eax
+	movl	%eax, %esi
+	movl	%esi, -4(%rbp)		# x = %esi
+	jmp	Lcollatz_steps_4
+Lcollatz_steps_3:
+	movl	$3, %esi		# %esi = $3
+	imull	-4(%rbp), %esi		# %esi = $3 * x
+	addl	$1, %esi		# %esi = %esi + $1
+	movl	%esi, -4(%rbp)		# x = %esi
+Lcollatz_steps_4:
+# golden/conditions.c:49
+	movl	-8(%rbp), %esi		# %esi = steps
+	addl	$1, %esi		# %esi = steps + $1
+	movl	%esi, -8(%rbp)		# steps = %esi
+Lcollatz_steps_1:
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	$1, %esi		# %esi = x != $1
+	je	Lcollatz_steps_5
+	movl	-8(%rbp), %esi		# %esi = steps
+	cmpl	$100, %esi		# %esi = steps < $100
+	jl	Lcollatz_steps_6
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	$0, %esi		# %esi = x < $0
+	jge	Lcollatz_steps_7
+Lcollatz_steps_6:
+	jmp	Lcollatz_steps_0
+Lcollatz_steps_7:
+Lcollatz_steps_5:
+Lcollatz_steps_2:
+# golden/conditions.c:51
+	movl	-8(%rbp), %eax		# %eax = steps
+	leave
+	retq
+	.globl	_either_positive
+	.p2align	4, 0x90
+_either_positive:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movsd	%xmm1, -16(%rbp)
+# golden/conditions.c:55
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	ucomisd	LCPI_either_positive_0(%rip), %xmm8		# %xmm8 = a > 0
+	ja	Leither_positive_0
+	movsd	-16(%rbp), %xmm8		# %xmm8 = b
+	ucomisd	LCPI_either_positive_0(%rip), %xmm8		# %xmm8 = b > 0
+	jbe	Leither_positive_1
+Leither_positive_0:
+# alloc ?: (4 bytes) at -20(%rbp)
+	movl	$10, -20(%rbp)		# ?: = $10
+	jmp	Leither_positive_2
+Leither_positive_1:
+	movl	$20, -20(%rbp)		# ?: = $20
+Leither_positive_2:
+	movl	-20(%rbp), %eax		# %eax = ?:
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_either_positive_0:
+	.quad	0x0		# 0
+	.text
+	.globl	_truthy
+	.p2align	4, 0x90
+_truthy:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc d (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc l (8 bytes) at -16(%rbp)
+	movq	%rdi, -16(%rbp)
+# golden/conditions.c:59
+# alloc r (4 bytes) at -20(%rbp)
+	movsd	-8(%rbp), %xmm8		# %xmm8 = d
+	ucomisd	LCPI_truthy_0(%rip), %xmm8		# %xmm8 = d != 0
+	setne	%sil
+	setp	%al
+	orb	%al, %sil
+	movzbl	%sil, %esi
+	testl	%esi, %esi
+	je	Ltruthy_0
+# alloc condition (4 bytes) at -24(%rbp)
+	movq	-16(%rbp), %rsi		# %rsi = l
+	cmpq	$0, %rsi		# %rsi = l != $0
+	setne	%sil
+	movzbl	%sil, %esi
+	movl	%esi, -24(%rbp)		# condition = %rsi
+	jmp	Ltruthy_1
+Ltruthy_0:
+	movl	$0, -24(%rbp)		# condition = $0
+Ltruthy_1:
+	movl	-24(%rbp), %esi		# %esi = condition
+	movl	%esi, -20(%rbp)		# r = %esi
+# golden/conditions.c:60
+	movsd	-8(%rbp), %xmm8		# %xmm8 = d
+	ucomisd	LCPI_truthy_0(%rip), %xmm8		# %xmm8 = d != 0
+	setne	%sil
+	setp	%al
+	orb	%al, %sil
+	movzbl	%sil, %esi
+	testl	%esi, %esi
+	je	Ltruthy_3
+	cmpq	$0, -16(%rbp)		# l
+	jne	Ltruthy_2
+Ltruthy_3:
+	movl	-20(%rbp), %esi		# %esi = r
+	addl	$2, %esi		# %esi = r + $2
+	movl	%esi, -20(%rbp)		# r = %esi
+Ltruthy_2:
+# golden/conditions.c:62
+	movl	-20(%rbp), %eax		# %eax = r
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_truthy_0:
+	.quad	0x0		# 0
+	.text
+	.globl	_with_comma
+	.p2align	4, 0x90
+_with_comma:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/conditions.c:66
+# alloc t (4 bytes) at -8(%rbp)
+# golden/conditions.c:67
+	movl	%edi, %esi		# %esi = x
+	# %esi = x * $2
+	shll	$1, %esi
+	movl	%esi, -8(%rbp)		# t = %esi
+	cmpl	$10, %esi		# %esi = t > $10
+	jle	Lwith_comma_1
+# alloc condition (4 bytes) at -12(%rbp)
+	movl	-8(%rbp), %esi		# %esi = t
+	cmpl	$20, %esi		# %esi = t < $20
+	setl	%sil
+	movzbl	%sil, %esi
+	movl	%esi, -12(%rbp)		# condition = %esi
+	jmp	Lwith_comma_2
+Lwith_comma_1:
+	movl	$0, -12(%rbp)		# condition = $0
+Lwith_comma_2:
+	cmpl	$0, -12(%rbp)		# condition
+	je	Lwith_comma_0
+	movl	-8(%rbp), %eax		# %eax = t
+	leave
+	retq
+Lwith_comma_0:
+# golden/conditions.c:69
+	movl	$0, %esi		# %esi = $0
+	subl	-8(%rbp), %esi		# %esi = $0 - t
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_constant_cases
+	.p2align	4, 0x90
+_constant_cases:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/conditions.c:73
+# alloc switch (4 bytes) at -8(%rbp)
+	movl	%edi, %esi		# %esi = x
+	movl	%esi, -8(%rbp)		# switch = %esi
+	jmp	Lconstant_cases_0
+# golden/conditions.c:74
+Lconstant_cases_2:
+	movl	$10, %eax		# %eax = $10
+	leave
+	retq
+# golden/conditions.c:76
+Lconstant_cases_3:
+	movl	$20, %eax		# %eax = $20
+	leave
+	retq
+# golden/conditions.c:78
+Lconstant_cases_4:
+	movl	$30, %eax		# %eax = $30
+	leave
+	retq
+Lconstant_cases_0:
+	movl	-8(%rbp), %eax		# %eax = switch
+	cmpl	$1, %eax
+	je	Lconstant_cases_2
+	cmpl	$5, %eax
+	je	Lconstant_cases_3
+	cmpl	$7, %eax
+	je	Lconstant_cases_4
+	jmp	Lconstant_cases_1
+Lconstant_cases_1:
+# golden/conditions.c:81
+	movl	$0, %eax		# %eax = $0
+	leave
+	retq
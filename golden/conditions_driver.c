@@ -0,0 +1,49 @@
+#include <stdio.h>
+
+extern int in_range(int x, int lo, int hi);
+extern int outside(int x, int lo, int hi);
+extern int negations(int x, int y);
+extern int safe_ratio_above(int a, int b, int limit);
+extern int count_matches(int n, int lo, int hi, int step);
+extern int first_gap(int n);
+extern int collatz_steps(int x);
+extern int either_positive(double a, double b);
+extern int truthy(double d, long l);
+extern int with_comma(int x);
+extern int constant_cases(int x);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(in_range(5, 0, 10));
+  print_expr(in_range(-5, 0, 10));
+  print_expr(in_range(15, 0, 10));
+  print_expr(outside(5, 0, 10));
+  print_expr(outside(-5, 0, 10));
+  print_expr(outside(15, 0, 10));
+  print_expr(negations(0, 0));
+  print_expr(negations(3, 5));
+  print_expr(negations(5, 3));
+  print_expr(safe_ratio_above(10, 0, 2));
+  print_expr(safe_ratio_above(10, 2, 2));
+  print_expr(safe_ratio_above(-10, 2, 2));
+  print_expr(safe_ratio_above(2, 2, 2));
+  print_expr(count_matches(64, -20, 40, 3));
+  print_expr(count_matches(64, 0, 20, 1));
+  print_expr(first_gap(32));
+  print_expr(first_gap(3));
+  print_expr(collatz_steps(27));
+  print_expr(collatz_steps(6));
+  print_expr(either_positive(-1.5, 2.5));
+  print_expr(either_positive(-1.5, -2.5));
+  print_expr(truthy(0.5, 3));
+  print_expr(truthy(0.0, 3));
+  print_expr(truthy(0.5, 0));
+  print_expr(with_comma(7));
+  print_expr(with_comma(2));
+  print_expr(constant_cases(1));
+  print_expr(constant_cases(5));
+  print_expr(constant_cases(7));
+  print_expr(constant_cases(2));
+  return 0;
+}
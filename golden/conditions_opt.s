@@ -0,0 +1,392 @@
+	.globl	_in_range
+	.p2align	4, 0x90
+_in_range:
+	movq	%rdx, %r8
+	cmpl	%r8d, %edi
+	setle	%al
+	movzbl	%al, %eax
+	movl	%eax, %r8d
+	xorl	%edx, %edx
+	cmpl	%esi, %edi
+	cmovgel	%r8d, %edx
+	movl	%edx, %esi
+Lin_range_3:
+	movl	%esi, %eax
+	retq
+	.globl	_outside
+	.p2align	4, 0x90
+_outside:
+	movq	%rdx, %r8
+	cmpl	%r8d, %edi
+	setg	%al
+	movzbl	%al, %eax
+	movl	%eax, %r8d
+	movl	$1, %ecx
+	movl	%r8d, %edx
+	cmpl	%esi, %edi
+	cmovll	%ecx, %edx
+	movl	%edx, %esi
+Loutside_3:
+	movl	%esi, %eax
+	retq
+	.globl	_negations
+	.p2align	4, 0x90
+_negations:
+	cmpl	$0, %edi
+	sete	%al
+	movzbl	%al, %eax
+	movl	%eax, %r8d
+	cmpl	$0, %esi
+	setne	%al
+	movzbl	%al, %eax
+	movl	%eax, %r9d
+	shll	$1, %r9d
+	addl	%r9d, %r8d
+	cmpl	%esi, %edi
+	setl	%al
+	movzbl	%al, %eax
+	movl	%eax, %esi
+	cmpl	$0, %esi
+	sete	%al
+	movzbl	%al, %eax
+	movl	%eax, %esi
+	shll	$2, %esi
+	addl	%r8d, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_safe_ratio_above
+	.p2align	4, 0x90
+_safe_ratio_above:
+	movq	%rdx, %r8
+	cmpl	$0, %esi
+	je	Lsafe_ratio_above_3
+Lsafe_ratio_above_4:
+	movl	%edi, %eax
+	cltd
+	idivl	%esi
+	movl	%eax, %r9d
+	cmpl	%r8d, %r9d
+	jle	Lsafe_ratio_above_3
+Lsafe_ratio_above_5:
+	movl	$1, %eax
+	retq
+Lsafe_ratio_above_3:
+	cmpl	$0, %esi
+	jne	Lsafe_ratio_above_8
+Lsafe_ratio_above_7:
+	movl	$2, %eax
+	retq
+Lsafe_ratio_above_8:
+	movl	%edi, %eax
+	cltd
+	idivl	%esi
+	movl	%eax, %esi
+	xorl	%edi, %edi
+	subl	%r8d, %edi
+	cmpl	%edi, %esi
+	jl	Lsafe_ratio_above_7
+Lsafe_ratio_above_6:
+	xorl	%eax, %eax
+	retq
+	.globl	_count_matches
+	.p2align	4, 0x90
+_count_matches:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lcount_matches_19
+Lcount_matches_6:
+Lcount_matches_7:
+	xorl	%r10d, %r10d
+	xorl	%ebx, %ebx
+	.p2align	4, 0x90
+Lcount_matches_2:
+	movl	%r10d, %r12d
+	imull	%r9d, %r12d
+	subl	$50, %r12d
+	cmpl	%esi, %r12d
+	jle	Lcount_matches_20
+Lcount_matches_10:
+	cmpl	%r8d, %r12d
+	jge	Lcount_matches_12
+Lcount_matches_11:
+	cmpl	$7, %r12d
+	jne	Lcount_matches_15
+Lcount_matches_23:
+	movq	%rbx, %r13
+Lcount_matches_14:
+Lcount_matches_3:
+	movl	%r10d, %r14d
+	addl	$1, %r14d
+	cmpl	%edi, %r14d
+	jge	Lcount_matches_4
+Lcount_matches_17:
+	cmpl	$1000, %r13d
+	jge	Lcount_matches_4
+Lcount_matches_25:
+	movq	%r14, %r10
+	movq	%r13, %rbx
+	jmp	Lcount_matches_2
+Lcount_matches_4:
+	movq	%r13, %r14
+Lcount_matches_5:
+	movl	%r14d, %eax
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+Lcount_matches_19:
+	xorl	%r14d, %r14d
+	jmp	Lcount_matches_5
+Lcount_matches_20:
+	movq	%rbx, %r14
+Lcount_matches_9:
+	movq	%r14, %r13
+	jmp	Lcount_matches_14
+Lcount_matches_12:
+	cmpl	$500, %r12d
+	je	Lcount_matches_11
+Lcount_matches_24:
+	movq	%rbx, %r14
+	jmp	Lcount_matches_9
+Lcount_matches_15:
+	movl	%ebx, %r14d
+	addl	$1, %r14d
+	cmpl	$11, %r12d
+	cmovel	%ebx, %r14d
+	jmp	Lcount_matches_9
+	.globl	_first_gap
+	.p2align	4, 0x90
+_first_gap:
+	subq	$136, %rsp
+Lfirst_gap_5:
+	xorl	%esi, %esi
+	leaq	0(%rsp), %r8
+	.p2align	4, 0x90
+Lfirst_gap_2:
+	movl	%esi, %r9d
+	leal	(%r9,%r9,2), %r9d
+	leal	3(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$2, %eax
+	movl	%eax, %r10d
+	shll	$1, %r10d
+	subl	%r10d, %r9d
+	movl	%r9d, (%r8)
+Lfirst_gap_3:
+	addl	$1, %esi
+	addq	$4, %r8
+	cmpl	$32, %esi
+	jl	Lfirst_gap_2
+Lfirst_gap_4:
+	movl	$1, %r11d
+	cmpl	%edi, %r11d
+	jge	Lfirst_gap_22
+Lfirst_gap_11:
+	movl	$1, %esi
+	subl	$1, %esi
+	movslq	%esi, %rsi
+	shlq	$2, %rsi
+	leaq	0(%rsp), %rax
+	addq	%rax, %rsi
+	movl	4(%rsp), %r8d
+	movl	(%rsi), %esi
+	movl	%r8d, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %esi
+	cmpl	$3, %esi
+	jne	Lfirst_gap_13
+Lfirst_gap_12:
+	movq	$1, %r8
+	.p2align	4, 0x90
+Lfirst_gap_7:
+	addl	$1, %r8d
+	movl	%r8d, %r9d
+	subl	$1, %r9d
+Lfirst_gap_8:
+	cmpl	%edi, %r8d
+	jge	Lfirst_gap_15
+Lfirst_gap_16:
+	movslq	%r8d, %r10
+	shlq	$2, %r10
+	leaq	0(%rsp), %rax
+	addq	%rax, %r10
+	movslq	%r9d, %r9
+	shlq	$2, %r9
+	leaq	0(%rsp), %rax
+	addq	%rax, %r9
+	movl	(%r10), %r10d
+	movl	(%r9), %r9d
+	movl	%r10d, %r11d
+	subl	%r9d, %r11d
+	movl	%r11d, %r9d
+	cmpl	$3, %r9d
+	je	Lfirst_gap_7
+	jmp	Lfirst_gap_18
+Lfirst_gap_22:
+	movq	$1, %r10
+Lfirst_gap_10:
+	movl	%r10d, %eax
+	addq	$136, %rsp
+	retq
+Lfirst_gap_13:
+	cmpl	$1, %esi
+	je	Lfirst_gap_12
+Lfirst_gap_25:
+	movq	$1, %r10
+Lfirst_gap_9:
+	jmp	Lfirst_gap_10
+Lfirst_gap_15:
+	movq	%r8, %r10
+	jmp	Lfirst_gap_9
+Lfirst_gap_18:
+	cmpl	$1, %r9d
+	je	Lfirst_gap_7
+	jmp	Lfirst_gap_15
+	.globl	_collatz_steps
+	.p2align	4, 0x90
+_collatz_steps:
+	xorl	%esi, %esi
+	.p2align	4, 0x90
+Lcollatz_steps_2:
+	leal	1(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$1, %eax
+	movl	%eax, %r8d
+	movl	%r8d, %r9d
+	shll	$1, %r9d
+	movl	%edi, %r10d
+	leal	(%r10,%r10,2), %r10d
+	addl	$1, %r10d
+	movl	%r10d, %edx
+	cmpl	%edi, %r9d
+	cmovel	%r8d, %edx
+	movl	%edx, %edi
+Lcollatz_steps_6:
+	addl	$1, %esi
+Lcollatz_steps_3:
+	cmpl	$1, %edi
+	je	Lcollatz_steps_4
+Lcollatz_steps_8:
+	cmpl	$100, %esi
+	jl	Lcollatz_steps_2
+Lcollatz_steps_10:
+	cmpl	$0, %edi
+	jl	Lcollatz_steps_2
+Lcollatz_steps_4:
+	movl	%esi, %eax
+	retq
+	.globl	_either_positive
+	.p2align	4, 0x90
+_either_positive:
+	ucomisd	LCPI_either_positive_0(%rip), %xmm0
+	jbe	Leither_positive_3
+Leither_positive_2:
+	movq	$10, %rsi
+Leither_positive_5:
+	movl	%esi, %eax
+	retq
+Leither_positive_3:
+	ucomisd	LCPI_either_positive_0(%rip), %xmm1
+	ja	Leither_positive_2
+Leither_positive_4:
+	movq	$20, %rsi
+	jmp	Leither_positive_5
+	.literal8
+	.p2align	3
+LCPI_either_positive_0:
+	.quad	0x0		# 0
+	.text
+	.globl	_truthy
+	.p2align	4, 0x90
+_truthy:
+	ucomisd	LCPI_truthy_0(%rip), %xmm0
+	setne	%al
+	setp	%cl
+	orb	%cl, %al
+	movzbl	%al, %eax
+	movl	%eax, %esi
+	cmpq	$0, %rdi
+	setne	%al
+	movzbl	%al, %eax
+	movl	%eax, %r8d
+	xorl	%edx, %edx
+	testl	%esi, %esi
+	cmovnel	%r8d, %edx
+	movl	%edx, %r8d
+Ltruthy_3:
+	testl	%esi, %esi
+	je	Ltruthy_5
+Ltruthy_6:
+	testq	%rdi, %rdi
+	je	Ltruthy_5
+Ltruthy_9:
+	movq	%r8, %rsi
+Ltruthy_4:
+	movl	%esi, %eax
+	retq
+Ltruthy_5:
+	movl	%r8d, %esi
+	addl	$2, %esi
+	jmp	Ltruthy_4
+	.literal8
+	.p2align	3
+LCPI_truthy_0:
+	.quad	0x0		# 0
+	.text
+	.globl	_with_comma
+	.p2align	4, 0x90
+_with_comma:
+	movl	%edi, %esi
+	shll	$1, %esi
+	cmpl	$20, %esi
+	setl	%al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	xorl	%edx, %edx
+	cmpl	$10, %esi
+	cmovgl	%edi, %edx
+	movl	%edx, %edi
+Lwith_comma_4:
+	testl	%edi, %edi
+	je	Lwith_comma_2
+Lwith_comma_5:
+	movl	%esi, %eax
+	retq
+Lwith_comma_2:
+	xorl	%r11d, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %eax
+	retq
+	.globl	_constant_cases
+	.p2align	4, 0x90
+_constant_cases:
+Lconstant_cases_2:
+	movl	%edi, %eax
+	cmpl	$1, %eax
+	je	Lconstant_cases_4
+	cmpl	$5, %eax
+	je	Lconstant_cases_5
+	cmpl	$7, %eax
+	je	Lconstant_cases_6
+	jmp	Lconstant_cases_3
+Lconstant_cases_3:
+	xorl	%eax, %eax
+	retq
+Lconstant_cases_4:
+	movl	$10, %eax
+	retq
+Lconstant_cases_6:
+	movl	$30, %eax
+	retq
+Lconstant_cases_5:
+	movl	$20, %eax
+	retq
@@ -0,0 +1,9 @@
+_Static_assert(2 * 3 + 1 - 6, "folds to one");
+
+int fold(int x) {
+  int a[2 * 3 + 10 / 3];
+  _Static_assert(16 / 2 - 8 + 1, "block scope");
+  a[8 - 1] = x * 1 + 0;
+  a[0] = (1 + 2) * (3 + 4) - 5 % 3;
+  return a[7] - 0 + a[2 * 2 - 4] / 1;
+}
@@ -0,0 +1,19 @@
+	.globl	_fold
+	.p2align	4, 0x90
+_fold:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+# golden/constant_folding.c:4
+# alloc a (36 bytes) at -40(%rbp)
+# golden/constant_folding.c:5
+# golden/constant_folding.c:6
+# golden/constant_folding.c:7
+	movl	$19, -40(%rbp)		# a[$0] = $19
+# golden/constant_folding.c:8
+	movl	%edi, %esi		# %esi = a[$7]
+	addl	-40(%rbp), %esi		# %esi = a[$7] + a[$0]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
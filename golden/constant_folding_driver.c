@@ -0,0 +1,10 @@
+#include <stdio.h>
+
+extern int fold();
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(fold(5));
+  print_expr(fold(-12));
+}
@@ -0,0 +1,23 @@
+int overwritten(int x, int y) {
+  int a[4] = {1, 2, 3, 4};
+  int unused = x * y + 7;
+  a[1] = x;
+  a[1] = y;
+  a[2] = a[1] + 1;
+  unused = unused / 3;
+  return a[0] + a[1] + a[2] + a[3];
+}
+
+int sparse(int i) {
+  int big[32] = {1, 2, [20] = 3, [31] = 4};
+  int small[6] = {[1] = 9, 8, [5] = 7};
+  int j = i - i / 6 * 6;
+  big[i] = big[i] + small[j];
+  return big[0] + big[1] + big[20] + big[31] + big[i] + small[0] + small[4];
+}
+
+int covered(int n) {
+  int row[6] = {1, 2, 3, 4, 5, 6};
+  row[n] = n;
+  return row[0] + row[2] + row[3] + row[5] + row[n];
+}
@@ -0,0 +1,138 @@
+	.globl	_overwritten
+	.p2align	4, 0x90
+_overwritten:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+# alloc y (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/dead_stores.c:2
+# alloc a (16 bytes) at -24(%rbp)
+	movl	$4,-12(%rbp)		# a[..12] = $4
+# golden/dead_stores.c:3
+# alloc unused (4 bytes) at -28(%rbp)
+	movl	%edi, %esi		# %esi = x
+	imull	-8(%rbp), %esi		# %esi = x * y
+	addl	$7, %esi		# %esi = %esi + $7
+	movl	%esi, -28(%rbp)		# unused = %esi
+# golden/dead_stores.c:4
+	movl	%edi, %esi		# %esi = x
+# golden/dead_stores.c:5
+	movl	-8(%rbp), %esi		# %esi = y
+	movl	%esi, -20(%rbp)		# a[$1] = %esi
+# golden/dead_stores.c:6
+	addl	$1, %esi		# %esi = a[$1] + $1
+	movl	%esi, -16(%rbp)		# a[$2] = %esi
+# golden/dead_stores.c:7
+	movl	-28(%rbp), %esi		# %esi = unused
+	# %esi = unused / $3
+	movl	$1431655766, %eax
+	imull	%esi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+# golden/dead_stores.c:8
+	movl	$1, %esi		# %esi = a[$0]
+	addl	-20(%rbp), %esi		# %esi = a[$0] + a[$1]
+	addl	-16(%rbp), %esi		# %esi = %esi + a[$2]
+	addl	-12(%rbp), %esi		# %esi = %esi + a[$3]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_sparse
+	.p2align	4, 0x90
+_sparse:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$160, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/dead_stores.c:12
+# alloc big (128 bytes) at -132(%rbp)
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, -124(%rbp)
+	movups	%xmm15, -108(%rbp)
+	movups	%xmm15, -92(%rbp)
+	movups	%xmm15, -76(%rbp)
+	movq	$0, -60(%rbp)
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, -48(%rbp)
+	movups	%xmm15, -32(%rbp)
+	movq	$0, -16(%rbp)
+	movl	$1,-132(%rbp)		# big[..0] = $1
+	movl	$2,-128(%rbp)		# big[..4] = $2
+	movl	$3,-52(%rbp)		# big[..80] = $3
+	movl	$4,-8(%rbp)		# big[..124] = $4
+# golden/dead_stores.c:13
+# alloc small (24 bytes) at -156(%rbp)
+	movl	$0, -156(%rbp)
+	movq	$0, -144(%rbp)
+	movl	$9,-152(%rbp)		# small[..4] = $9
+	movl	$8,-148(%rbp)		# small[..8] = $8
+	movl	$7,-136(%rbp)		# small[..20] = $7
+# golden/dead_stores.c:14
+# alloc j (4 bytes) at -160(%rbp)
+	movl	-4(%rbp), %esi		# %esi = i
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i / $6
+	movl	$715827883, %eax
+	imull	%edi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	# %edi = %edi * $6
+	leal	(%rdi,%rdi,2), %edi
+	shll	$1, %edi
+	subl	%edi, %esi		# %esi = i - %edi
+	movl	%esi, -160(%rbp)		# j = %esi
+# golden/dead_stores.c:15
+	movslq	-4(%rbp), %rcx
+	movl	-132(%rbp,%rcx,4), %esi		# %esi = big[i]
+	movslq	-160(%rbp), %rcx
+	addl	-156(%rbp,%rcx,4), %esi		# %esi = big[i] + small[j]
+	movslq	-4(%rbp), %rcx
+	movl	%esi, -132(%rbp,%rcx,4)		# big[i] = %esi
+# golden/dead_stores.c:16
+	movl	-132(%rbp), %esi		# %esi = big[$0]
+	addl	-128(%rbp), %esi		# %esi = big[$0] + big[$1]
+	addl	-52(%rbp), %esi		# %esi = %esi + big[$20]
+	addl	-8(%rbp), %esi		# %esi = %esi + big[$31]
+	movslq	-4(%rbp), %rcx
+	addl	-132(%rbp,%rcx,4), %esi		# %esi = %esi + big[i]
+	addl	-156(%rbp), %esi		# %esi = %esi + small[$0]
+	addl	-140(%rbp), %esi		# %esi = %esi + small[$4]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_covered
+	.p2align	4, 0x90
+_covered:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/dead_stores.c:20
+# alloc row (24 bytes) at -28(%rbp)
+	movl	$1,-28(%rbp)		# row[..0] = $1
+	movl	$2,-24(%rbp)		# row[..4] = $2
+	movl	$3,-20(%rbp)		# row[..8] = $3
+	movl	$4,-16(%rbp)		# row[..12] = $4
+	movl	$5,-12(%rbp)		# row[..16] = $5
+	movl	$6,-8(%rbp)		# row[..20] = $6
+# golden/dead_stores.c:21
+	movl	%edi, %esi		# %esi = n
+	movslq	-4(%rbp), %rcx
+	movl	%esi, -28(%rbp,%rcx,4)		# row[n] = %esi
+# golden/dead_stores.c:22
+	movl	-28(%rbp), %esi		# %esi = row[$0]
+	addl	-20(%rbp), %esi		# %esi = row[$0] + row[$2]
+	addl	-16(%rbp), %esi		# %esi = %esi + row[$3]
+	addl	-8(%rbp), %esi		# %esi = %esi + row[$5]
+	movslq	-4(%rbp), %rcx
+	addl	-28(%rbp,%rcx,4), %esi		# %esi = %esi + row[n]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
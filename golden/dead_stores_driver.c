@@ -0,0 +1,17 @@
+#include <stdio.h>
+
+extern int overwritten(int x, int y);
+extern int sparse(int i);
+extern int covered(int n);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(overwritten(3, 5));
+  print_expr(overwritten(-4, 10));
+  print_expr(sparse(0));
+  print_expr(sparse(5));
+  print_expr(sparse(20));
+  print_expr(covered(0));
+  print_expr(covered(2));
+}
@@ -0,0 +1,94 @@
+	.globl	_overwritten
+	.p2align	4, 0x90
+_overwritten:
+	imull	%esi, %edi
+	addl	$7, %edi
+	addl	$1, %esi
+	movl	$1431655766, %eax
+	imull	%edi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	movl	%esi, %r11d
+	addl	%esi, %r11d
+	movl	%r11d, %esi
+	addl	$4, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_sparse
+	.p2align	4, 0x90
+_sparse:
+	subq	$168, %rsp
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, 40(%rsp)
+	movups	%xmm15, 56(%rsp)
+	movups	%xmm15, 72(%rsp)
+	movups	%xmm15, 88(%rsp)
+	movq	$0, 104(%rsp)
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, 116(%rsp)
+	movups	%xmm15, 132(%rsp)
+	movq	$0, 148(%rsp)
+	movl	$1, 32(%rsp)
+	movl	$2, 36(%rsp)
+	movl	$3, 112(%rsp)
+	movl	$4, 156(%rsp)
+	movl	$0, 8(%rsp)
+	movl	$0, 20(%rsp)
+	movl	$0, 24(%rsp)
+	movl	$9, 12(%rsp)
+	movl	$8, 16(%rsp)
+	movl	$7, 28(%rsp)
+	movl	$715827883, %eax
+	imull	%edi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %esi
+	leal	(%rsi,%rsi,2), %esi
+	shll	$1, %esi
+	movl	%edi, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %esi
+	movslq	%edi, %rdi
+	shlq	$2, %rdi
+	leaq	32(%rsp), %rax
+	addq	%rax, %rdi
+	movslq	%esi, %rsi
+	shlq	$2, %rsi
+	leaq	8(%rsp), %rax
+	addq	%rax, %rsi
+	movl	(%rdi), %r8d
+	movl	(%rsi), %esi
+	addl	%r8d, %esi
+	movl	%esi, (%rdi)
+	movl	32(%rsp), %edi
+	addl	36(%rsp), %edi
+	addl	112(%rsp), %edi
+	addl	156(%rsp), %edi
+	addl	%edi, %esi
+	addl	8(%rsp), %esi
+	addl	24(%rsp), %esi
+	movl	%esi, %eax
+	addq	$168, %rsp
+	retq
+	.globl	_covered
+	.p2align	4, 0x90
+_covered:
+	movl	$1, -32(%rsp)
+	movl	$3, -24(%rsp)
+	movl	$4, -20(%rsp)
+	movl	$6, -12(%rsp)
+	movslq	%edi, %rsi
+	shlq	$2, %rsi
+	leaq	-32(%rsp), %rax
+	addq	%rax, %rsi
+	movl	%edi, (%rsi)
+	movl	-32(%rsp), %esi
+	addl	-24(%rsp), %esi
+	addl	-20(%rsp), %esi
+	addl	-12(%rsp), %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
@@ -1,15 +1,14 @@
-# KUI'S COMPILER at Tue Oct 10 01:29:07 2023
-	subq	$4, %rsp		# alloc x (4 bytes) at -4(%rbp) 
-	subq	$4, %rsp		# alloc y (4 bytes) at -8(%rbp) 
-	subq	$2, %rsp		# alloc z (2 bytes) at -10(%rbp) 
-	subq	$2, %rsp		# alloc a (2 bytes) at -12(%rbp) 
-	subq	$8, %rsp		# alloc b (8 bytes) at -20(%rbp) 
-	subq	$4, %rsp		# alloc c (4 bytes) at -24(%rbp) 
-	subq	$4, %rsp		# alloc d (4 bytes) at -28(%rbp) 
-	subq	$8, %rsp		# alloc e (8 bytes) at -36(%rbp) 
-	subq	$16, %rsp		# alloc f (16 bytes) at -52(%rbp) 
-	subq	$4, %rsp		# alloc g (4 bytes) at -56(%rbp) 
-	subq	$2, %rsp		# alloc h (2 bytes) at -58(%rbp) 
-	subq	$2, %rsp		# alloc i (2 bytes) at -60(%rbp) 
-	subq	$8, %rsp		# alloc j (8 bytes) at -68(%rbp) 
-	subq	$4, %rsp		# alloc k (4 bytes) at -72(%rbp) 
+	.comm	_x,4,2
+	.comm	_y,4,2
+	.comm	_z,2,1
+	.comm	_a,2,1
+	.comm	_b,8,3
+	.comm	_c,4,2
+	.comm	_d,4,2
+	.comm	_e,8,3
+	.comm	_f,16,4
+	.comm	_g,4,2
+	.comm	_h,2,1
+	.comm	_i,2,1
+	.comm	_j,4,2
+	.comm	_k,4,2
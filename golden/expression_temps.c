@@ -0,0 +1,20 @@
+int deep(int a, int b, int c, int d) {
+  int x[8];
+  int y[4];
+  x[0] = a;
+  x[1] = b;
+  x[2] = c;
+  x[3] = d;
+  x[a - b + c] = (a + b) * (c - d) - (a - c) * (b + d);
+  y[x[3] - d + (b - a) * (b - a)] = x[a] / (d - c);
+  return ((a + b) * (c + d) + (a - b) * (c - d)) - (((a * b) - (c * d)) * ((a + d) - (b + c)))
+    + ((((a + 1) * (b + 2)) - ((c + 3) * (d + 4))) * (((a - 5) * (b - 6)) + ((c - 7) * (d - 8))))
+    + x[a - b + c] / (a + 8) - y[b - a];
+}
+
+int wide(int a, int b, int c, int d) {
+  return ((((((b * c) + (d * a)) - ((c * b) + (d * a))) + (((b * a) + (d * a)) - ((c * b) + (c * a))))
+        - ((((b * c) + (d * a)) - ((c * b) + (d * a))) + (((c * c) + (d * a)) - ((c * a) + (d * a)))))
+      + (((((b * c) + (c * a)) - ((c * b) + (d * a))) + (((b * c) + (d * a)) - ((c * b) + (d * a))))
+        - ((((b * a) + (d * a)) - ((c * b) + (c * a))) + (((b * c) + (d * a)) - ((c * b) + (d * a))))));
+}
@@ -0,0 +1,243 @@
+	.globl	_deep
+	.p2align	4, 0x90
+_deep:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc c (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# alloc d (4 bytes) at -16(%rbp)
+	movl	%ecx, -16(%rbp)
+# golden/expression_temps.c:2
+# alloc x (32 bytes) at -48(%rbp)
+# golden/expression_temps.c:3
+# alloc y (16 bytes) at -64(%rbp)
+# golden/expression_temps.c:4
+	movl	%edi, -48(%rbp)
+# golden/expression_temps.c:5
+	movl	%esi, -44(%rbp)		# x[$1] = %esi
+# golden/expression_temps.c:6
+	movl	%edx, -40(%rbp)
+# golden/expression_temps.c:7
+	movl	%ecx, -36(%rbp)
+# golden/expression_temps.c:8
+	movl	%edi, %esi		# %esi = a
+	addl	-8(%rbp), %esi		# %esi = a + b
+	movl	%edx, %edi		# %edi = c
+	subl	-16(%rbp), %edi		# %edi = c - d
+	imull	%edi, %esi		# %esi = %esi * %edi
+	movl	-4(%rbp), %edi		# %edi = a
+	subl	-12(%rbp), %edi		# %edi = a - c
+	movl	-8(%rbp), %r8d		# %r8d = b
+	addl	-16(%rbp), %r8d		# %r8d = b + d
+	imull	%r8d, %edi		# %edi = %edi * %r8d
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-4(%rbp), %edi		# %edi = a
+	subl	-8(%rbp), %edi		# %edi = a - b
+	addl	-12(%rbp), %edi		# %edi = %edi + c
+	movslq	%edi, %rcx
+	movl	%esi, -48(%rbp,%rcx,4)		# x[((a - b) + c)] = %esi
+# golden/expression_temps.c:9
+	movslq	-4(%rbp), %rcx
+	movl	-48(%rbp,%rcx,4), %esi		# %esi = x[a]
+	movl	-16(%rbp), %edi		# %edi = d
+	subl	-12(%rbp), %edi		# %edi = d - c
+	movl	%esi, %eax		# %eax = %esi
+	cdq
+	idivl	%edi		# %eax = x[a] / %edi
+	movl	%eax, %esi
+	movl	-8(%rbp), %edi		# %edi = b
+	subl	-4(%rbp), %edi		# %edi = b - a
+	movl	-8(%rbp), %r8d		# %r8d = b
+	subl	-4(%rbp), %r8d		# %r8d = b - a
+	imull	%r8d, %edi		# %edi = %edi * %r8d
+	movl	-36(%rbp), %r8d		# %r8d = x[$3]
+	subl	-16(%rbp), %r8d		# %r8d = x[$3] - d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	movl	%esi, -64(%rbp,%rcx,4)		# y[((x[$3] - d) + ((b - a) * (b - a)))] = %esi
+# golden/expression_temps.c:10
+	movl	-4(%rbp), %esi		# %esi = a
+	addl	-8(%rbp), %esi		# %esi = a + b
+	movl	-12(%rbp), %edi		# %edi = c
+	addl	-16(%rbp), %edi		# %edi = c + d
+	imull	%edi, %esi		# %esi = %esi * %edi
+	movl	-4(%rbp), %edi		# %edi = a
+	subl	-8(%rbp), %edi		# %edi = a - b
+	movl	-12(%rbp), %r8d		# %r8d = c
+	subl	-16(%rbp), %r8d		# %r8d = c - d
+	imull	%r8d, %edi		# %edi = %edi * %r8d
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = a
+	imull	-8(%rbp), %edi		# %edi = a * b
+	movl	-12(%rbp), %r8d		# %r8d = c
+	imull	-16(%rbp), %r8d		# %r8d = c * d
+	subl	%r8d, %edi		# %edi = %edi - %r8d
+	movl	-4(%rbp), %r8d		# %r8d = a
+	addl	-16(%rbp), %r8d		# %r8d = a + d
+	movl	-8(%rbp), %r9d		# %r9d = b
+	addl	-12(%rbp), %r9d		# %r9d = b + c
+	subl	%r9d, %r8d		# %r8d = %r8d - %r9d
+	imull	%r8d, %edi		# %edi = %edi * %r8d
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-4(%rbp), %edi		# %edi = a
+	addl	$1, %edi		# %edi = a + $1
+	movl	-8(%rbp), %r8d		# %r8d = b
+	addl	$2, %r8d		# %r8d = b + $2
+	imull	%r8d, %edi		# %edi = %edi * %r8d
+	movl	-12(%rbp), %r8d		# %r8d = c
+	addl	$3, %r8d		# %r8d = c + $3
+	movl	-16(%rbp), %r9d		# %r9d = d
+	addl	$4, %r9d		# %r9d = d + $4
+	imull	%r9d, %r8d		# %r8d = %r8d * %r9d
+	subl	%r8d, %edi		# %edi = %edi - %r8d
+	movl	-4(%rbp), %r8d		# %r8d = a
+	subl	$5, %r8d		# %r8d = a - $5
+	movl	-8(%rbp), %r9d		# %r9d = b
+	subl	$6, %r9d		# %r9d = b - $6
+	imull	%r9d, %r8d		# %r8d = %r8d * %r9d
+	movl	-12(%rbp), %r9d		# %r9d = c
+	subl	$7, %r9d		# %r9d = c - $7
+	movl	-16(%rbp), %r11d		# %r11d = d
+	subl	$8, %r11d		# %r11d = d - $8
+	imull	%r11d, %r9d		# %r9d = %r9d * %r11d
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	imull	%r8d, %edi		# %edi = %edi * %r8d
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = a
+	subl	-8(%rbp), %edi		# %edi = a - b
+	addl	-12(%rbp), %edi		# %edi = %edi + c
+	movslq	%edi, %rcx
+	movl	-48(%rbp,%rcx,4), %edi		# %edi = x[((a - b) + c)]
+	movl	-4(%rbp), %r8d		# %r8d = a
+	addl	$8, %r8d		# %r8d = a + $8
+	movl	%edi, %eax		# %eax = %edi
+	cdq
+	idivl	%r8d		# %eax = x[((a - b) + c)] / %r8d
+	movl	%eax, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-8(%rbp), %edi		# %edi = b
+	subl	-4(%rbp), %edi		# %edi = b - a
+	movslq	%edi, %rcx
+	subl	-64(%rbp,%rcx,4), %esi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_wide
+	.p2align	4, 0x90
+_wide:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc c (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# alloc d (4 bytes) at -16(%rbp)
+# golden/expression_temps.c:16
+	imull	-12(%rbp), %esi		# %esi = b * c
+	movl	%ecx, %edi		# %edi = d
+	imull	-4(%rbp), %edi		# %edi = d * a
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%edx, %edi		# %edi = c
+	imull	-8(%rbp), %edi		# %edi = c * b
+	movl	%ecx, %r8d		# %r8d = d
+	imull	-4(%rbp), %r8d		# %r8d = d * a
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-8(%rbp), %edi		# %edi = b
+	imull	-4(%rbp), %edi		# %edi = b * a
+	movl	%ecx, %r8d		# %r8d = d
+	imull	-4(%rbp), %r8d		# %r8d = d * a
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	%edx, %r8d		# %r8d = c
+	imull	-8(%rbp), %r8d		# %r8d = c * b
+	movl	%edx, %r9d		# %r9d = c
+	imull	-4(%rbp), %r9d		# %r9d = c * a
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	subl	%r8d, %edi		# %edi = %edi - %r8d
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-8(%rbp), %edi		# %edi = b
+	imull	-12(%rbp), %edi		# %edi = b * c
+	movl	%ecx, %r8d		# %r8d = d
+	imull	-4(%rbp), %r8d		# %r8d = d * a
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	%edx, %r8d		# %r8d = c
+	imull	-8(%rbp), %r8d		# %r8d = c * b
+	movl	%ecx, %r9d		# %r9d = d
+	imull	-4(%rbp), %r9d		# %r9d = d * a
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	subl	%r8d, %edi		# %edi = %edi - %r8d
+	movl	%edx, %r8d		# %r8d = c
+	imull	-12(%rbp), %r8d		# %r8d = c * c
+	movl	%ecx, %r9d		# %r9d = d
+	imull	-4(%rbp), %r9d		# %r9d = d * a
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	movl	%edx, %r9d		# %r9d = c
+	imull	-4(%rbp), %r9d		# %r9d = c * a
+	movl	%ecx, %r11d		# %r11d = d
+	imull	-4(%rbp), %r11d		# %r11d = d * a
+	addl	%r11d, %r9d		# %r9d = %r9d + %r11d
+	subl	%r9d, %r8d		# %r8d = %r8d - %r9d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	subl	%edi, %esi		# %esi = %esi - %edi
+# alloc t5 (4 bytes) at -20(%rbp)
+	movl	%esi, -20(%rbp)		# t5 = %esi
+	movl	-8(%rbp), %esi		# %esi = b
+	imull	-12(%rbp), %esi		# %esi = b * c
+	movl	%edx, %edi		# %edi = c
+	imull	-4(%rbp), %edi		# %edi = c * a
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%edx, %edi		# %edi = c
+	imull	-8(%rbp), %edi		# %edi = c * b
+	movl	%ecx, %r8d		# %r8d = d
+	imull	-4(%rbp), %r8d		# %r8d = d * a
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-8(%rbp), %edi		# %edi = b
+	imull	-12(%rbp), %edi		# %edi = b * c
+	movl	%ecx, %r8d		# %r8d = d
+	imull	-4(%rbp), %r8d		# %r8d = d * a
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	%edx, %r8d		# %r8d = c
+	imull	-8(%rbp), %r8d		# %r8d = c * b
+	movl	%ecx, %r9d		# %r9d = d
+	imull	-4(%rbp), %r9d		# %r9d = d * a
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	subl	%r8d, %edi		# %edi = %edi - %r8d
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-8(%rbp), %edi		# %edi = b
+	imull	-4(%rbp), %edi		# %edi = b * a
+	movl	%ecx, %r8d		# %r8d = d
+	imull	-4(%rbp), %r8d		# %r8d = d * a
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	%edx, %r8d		# %r8d = c
+	imull	-8(%rbp), %r8d		# %r8d = c * b
+	movl	%edx, %r9d		# %r9d = c
+	imull	-4(%rbp), %r9d		# %r9d = c * a
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	subl	%r8d, %edi		# %edi = %edi - %r8d
+	movl	-8(%rbp), %r8d		# %r8d = b
+	imull	-12(%rbp), %r8d		# %r8d = b * c
+	movl	%ecx, %r9d		# %r9d = d
+	imull	-4(%rbp), %r9d		# %r9d = d * a
+	addl	%r9d, %r8d		# %r8d = %r8d + %r9d
+	movl	%edx, %r9d		# %r9d = c
+	imull	-8(%rbp), %r9d		# %r9d = c * b
+	movl	%ecx, %r11d		# %r11d = d
+	imull	-4(%rbp), %r11d		# %r11d = d * a
+	addl	%r11d, %r9d		# %r9d = %r9d + %r11d
+	subl	%r9d, %r8d		# %r8d = %r8d - %r9d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-20(%rbp), %edi		# %edi = t5
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movl	%edi, %eax		# %eax = %edi
+	leave
+	retq
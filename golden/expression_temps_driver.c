@@ -0,0 +1,15 @@
+#include <stdio.h>
+
+extern int deep(int a, int b, int c, int d);
+extern int wide(int a, int b, int c, int d);
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(deep(1, 2, 3, 4));
+  print_expr(deep(2, 2, 1, 7));
+  print_expr(deep(2, 3, 1, 5));
+  print_expr(wide(1, 2, 3, 4));
+  print_expr(wide(2, 2, 1, 7));
+  print_expr(wide(2, 3, 1, 5));
+}
@@ -0,0 +1,161 @@
+	.globl	_deep
+	.p2align	4, 0x90
+_deep:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	pushq	%r15
+	movq	%rdi, -56(%rsp)
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	movl	-56(%rsp), %r11d
+	movl	%r11d, -32(%rsp)
+	movl	%esi, -28(%rsp)
+	movl	%r8d, -24(%rsp)
+	movl	%r9d, -20(%rsp)
+	movl	-56(%rsp), %r10d
+	subl	%esi, %r10d
+	movl	%r10d, %ebx
+	addl	%r8d, %ebx
+	movslq	%ebx, %rbx
+	shlq	$2, %rbx
+	leaq	-32(%rsp), %rax
+	addq	%rax, %rbx
+	movl	-56(%rsp), %r12d
+	addl	%esi, %r12d
+	movl	%r8d, %r13d
+	subl	%r9d, %r13d
+	movl	%r12d, %r14d
+	imull	%r13d, %r14d
+	movl	-56(%rsp), %r15d
+	subl	%r8d, %r15d
+	movl	%esi, %edi
+	addl	%r9d, %edi
+	imull	%r15d, %edi
+	movl	%r14d, %r11d
+	subl	%edi, %r11d
+	movl	%r11d, %edi
+	movl	%edi, (%rbx)
+	movl	-20(%rsp), %ebx
+	subl	%r9d, %ebx
+	movl	%esi, %r11d
+	subl	-56(%rsp), %r11d
+	movl	%r11d, -64(%rsp)
+	movl	%r11d, %r15d
+	imull	-64(%rsp), %r15d
+	addl	%r15d, %ebx
+	movslq	%ebx, %rbx
+	shlq	$2, %rbx
+	leaq	-48(%rsp), %rax
+	addq	%rax, %rbx
+	movslq	-56(%rsp), %r15
+	shlq	$2, %r15
+	leaq	-32(%rsp), %rax
+	addq	%rax, %r15
+	movl	%r9d, %r14d
+	subl	%r8d, %r14d
+	movl	(%r15), %eax
+	cltd
+	idivl	%r14d
+	movl	%eax, (%rbx)
+	movl	%r8d, %ebx
+	addl	%r9d, %ebx
+	imull	%r12d, %ebx
+	imull	%r13d, %r10d
+	addl	%ebx, %r10d
+	movl	-56(%rsp), %ebx
+	imull	%esi, %ebx
+	movl	%r8d, %r12d
+	imull	%r9d, %r12d
+	subl	%r12d, %ebx
+	movl	-56(%rsp), %r12d
+	addl	%r9d, %r12d
+	movl	%esi, %r13d
+	addl	%r8d, %r13d
+	subl	%r13d, %r12d
+	imull	%r12d, %ebx
+	subl	%ebx, %r10d
+	movl	-56(%rsp), %ebx
+	addl	$1, %ebx
+	movl	%esi, %r12d
+	addl	$2, %r12d
+	imull	%r12d, %ebx
+	movl	%r8d, %r12d
+	addl	$3, %r12d
+	movl	%r9d, %r13d
+	addl	$4, %r13d
+	imull	%r13d, %r12d
+	subl	%r12d, %ebx
+	movl	-56(%rsp), %r12d
+	subl	$5, %r12d
+	subl	$6, %esi
+	imull	%r12d, %esi
+	subl	$7, %r8d
+	subl	$8, %r9d
+	imull	%r9d, %r8d
+	addl	%r8d, %esi
+	imull	%ebx, %esi
+	addl	%r10d, %esi
+	movl	-56(%rsp), %r8d
+	addl	$8, %r8d
+	movl	%edi, %eax
+	cltd
+	idivl	%r8d
+	movl	%eax, %edi
+	addl	%edi, %esi
+	movslq	-64(%rsp), %rdi
+	shlq	$2, %rdi
+	leaq	-48(%rsp), %rax
+	addq	%rax, %rdi
+	subl	(%rdi), %esi
+	movl	%esi, %eax
+	popq	%r15
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+	.globl	_wide
+	.p2align	4, 0x90
+_wide:
+	pushq	%rbx
+	pushq	%r12
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	movl	%esi, %r10d
+	imull	%r8d, %r10d
+	imull	%edi, %r9d
+	movl	%r10d, %ebx
+	addl	%r9d, %ebx
+	movl	%ebx, %r12d
+	subl	%ebx, %r12d
+	imull	%edi, %esi
+	addl	%r9d, %esi
+	imull	%r8d, %edi
+	addl	%edi, %r10d
+	subl	%r10d, %esi
+	addl	%r12d, %esi
+	movl	%r8d, %r11d
+	imull	%r8d, %r11d
+	movl	%r11d, %r8d
+	addl	%r9d, %r8d
+	addl	%r9d, %edi
+	movl	%r8d, %r11d
+	subl	%edi, %r11d
+	movl	%r11d, %edi
+	addl	%r12d, %edi
+	movl	%esi, %r11d
+	subl	%edi, %r11d
+	movl	%r11d, %edi
+	movl	%r10d, %r8d
+	subl	%ebx, %r8d
+	addl	%r12d, %r8d
+	movl	%r8d, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	popq	%r12
+	popq	%rbx
+	retq
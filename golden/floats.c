@@ -0,0 +1,70 @@
+double average(double a, double b) {
+  return (a + b) / 2;
+}
+
+double polynomial(double x) {
+  return 3.5 * x * x - 2.25 * x + 1.0;
+}
+
+float scale(float x, int n) {
+  return x * n + 0.5;
+}
+
+int to_int(double x) {
+  return x;
+}
+
+unsigned to_unsigned(double x) {
+  return x;
+}
+
+double widen(unsigned u, char c) {
+  double d = c;
+  return u + d;
+}
+
+double mixed(int i, double d, long l, float f) {
+  return i * d + l - f;
+}
+
+int compare(double a, double b) {
+  return (a < b) + 2 * (a <= b) + 4 * (a > b) + 8 * (a >= b) + 16 * (a == b) + 32 * (a != b);
+}
+
+int count_true(double x, float y, double z) {
+  int n = 0;
+  if (x) {
+    n++;
+  }
+  if (y > 1.5) {
+    n++;
+  }
+  if (z != z) {
+    n += 10;
+  }
+  return n;
+}
+
+double halve_until(double x, double limit) {
+  while (x > limit) {
+    x = x / 2;
+  }
+  return x;
+}
+
+double sum_halves(int n) {
+  double a[8];
+  double sum = 0;
+  for (int i = 0; i < n; i++) {
+    a[i] = i * 0.5;
+  }
+  for (int i = 0; i < n; i++) {
+    sum += a[i];
+  }
+  return sum;
+}
+
+double average_of_polynomial(double x) {
+  double y = polynomial(x);
+  return average(x, y) + polynomial(y);
+}
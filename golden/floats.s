@@ -0,0 +1,402 @@
+	.globl	_average
+	.p2align	4, 0x90
+_average:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movsd	%xmm1, -16(%rbp)
+# golden/floats.c:2
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	addsd	-16(%rbp), %xmm8		# %xmm8 = a + b
+	divsd	LCPI_average_0(%rip), %xmm8		# %xmm8 = %xmm8 / 2
+	movsd	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_average_0:
+	.quad	0x4000000000000000		# 2
+	.text
+	.globl	_polynomial
+	.p2align	4, 0x90
+_polynomial:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# golden/floats.c:6
+	movsd	LCPI_polynomial_0(%rip), %xmm8		# %xmm8 = 3.5
+	mulsd	-8(%rbp), %xmm8		# %xmm8 = 3.5 * x
+	mulsd	-8(%rbp), %xmm8		# %xmm8 = %xmm8 * x
+	movsd	LCPI_polynomial_1(%rip), %xmm9		# %xmm9 = 2.25
+	mulsd	-8(%rbp), %xmm9		# %xmm9 = 2.25 * x
+	subsd	%xmm9, %xmm8		# %xmm8 = %xmm8 - %xmm9
+	addsd	LCPI_polynomial_2(%rip), %xmm8		# %xmm8 = %xmm8 + 1
+	movsd	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_polynomial_0:
+	.quad	0x400c000000000000		# 3.5
+	.literal8
+	.p2align	3
+LCPI_polynomial_1:
+	.quad	0x4002000000000000		# 2.25
+	.literal8
+	.p2align	3
+LCPI_polynomial_2:
+	.quad	0x3ff0000000000000		# 1
+	.text
+	.globl	_scale
+	.p2align	4, 0x90
+_scale:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movss	%xmm0, -4(%rbp)
+# alloc n (4 bytes) at -8(%rbp)
+	movl	%edi, -8(%rbp)
+# golden/floats.c:10
+	movss	-4(%rbp), %xmm8		# %xmm8 = x
+	cvtsi2ssl	-8(%rbp), %xmm9		# (float) n
+	mulss	%xmm9, %xmm8		# %xmm8 = x * %xmm9
+	cvtss2sd	%xmm8, %xmm9		# (double) (x * (float) n)
+	addsd	LCPI_scale_0(%rip), %xmm9		# %xmm9 = %xmm9 + 0.5
+	cvtsd2ss	%xmm9, %xmm8		# (float) ((double) (x * (float) n) + 0.5)
+	movss	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_scale_0:
+	.quad	0x3fe0000000000000		# 0.5
+	.text
+	.globl	_to_int
+	.p2align	4, 0x90
+_to_int:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# golden/floats.c:14
+	cvttsd2si	-8(%rbp), %esi		# (int) x
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_to_unsigned
+	.p2align	4, 0x90
+_to_unsigned:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# golden/floats.c:18
+	cvttsd2si	-8(%rbp), %rsi		# (int) x
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_widen
+	.p2align	4, 0x90
+_widen:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc u (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc c (1 bytes) at -5(%rbp)
+	movb	%sil, -5(%rbp)
+# golden/floats.c:22
+# alloc d (8 bytes) at -16(%rbp)
+	movsbq	-5(%rbp), %rsi
+	cvtsi2sdq	%rsi, %xmm8		# (double) c
+	movsd	%xmm8, -16(%rbp)		# d = %xmm8
+# golden/floats.c:23
+	movl	-4(%rbp), %esi
+	cvtsi2sdq	%rsi, %xmm8		# (double) u
+	addsd	-16(%rbp), %xmm8		# %xmm8 = %xmm8 + d
+	movsd	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
+	.globl	_mixed
+	.p2align	4, 0x90
+_mixed:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc d (8 bytes) at -16(%rbp)
+	movsd	%xmm0, -16(%rbp)
+# alloc l (8 bytes) at -24(%rbp)
+	movq	%rsi, -24(%rbp)
+# alloc f (4 bytes) at -28(%rbp)
+	movss	%xmm1, -28(%rbp)
+# golden/floats.c:27
+	cvtsi2sdl	-4(%rbp), %xmm8		# (double) i
+	mulsd	-16(%rbp), %xmm8		# %xmm8 = %xmm8 * d
+	cvtsi2sdq	-24(%rbp), %xmm9		# (double) l
+	addsd	%xmm9, %xmm8		# %xmm8 = %xmm8 + %xmm9
+	cvtss2sd	-28(%rbp), %xmm9		# (double) f
+	subsd	%xmm9, %xmm8		# %xmm8 = %xmm8 - %xmm9
+	movsd	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
+	.globl	_compare
+	.p2align	4, 0x90
+_compare:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movsd	%xmm1, -16(%rbp)
+# golden/floats.c:31
+	movl	$2, %esi		# %esi = $2
+	movsd	-16(%rbp), %xmm8		# %xmm8 = b
+	ucomisd	-8(%rbp), %xmm8		# %xmm8 = b >= a
+	setae	%dil
+	movzbl	%dil, %edi
+	imull	%edi, %esi		# %esi = $2 * %edi
+	movsd	-16(%rbp), %xmm8		# %xmm8 = b
+	ucomisd	-8(%rbp), %xmm8		# %xmm8 = b > a
+	seta	%dil
+	movzbl	%dil, %edi
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movl	$4, %esi		# %esi = $4
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = a > b
+	seta	%r8b
+	movzbl	%r8b, %r8d
+	imull	%r8d, %esi		# %esi = $4 * %r8d
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movl	$8, %esi		# %esi = $8
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = a >= b
+	setae	%r8b
+	movzbl	%r8b, %r8d
+	imull	%r8d, %esi		# %esi = $8 * %r8d
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movl	$16, %esi		# %esi = $16
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = a == b
+	sete	%r8b
+	setnp	%al
+	andb	%al, %r8b
+	movzbl	%r8b, %r8d
+	imull	%r8d, %esi		# %esi = $16 * %r8d
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movl	$32, %esi		# %esi = $32
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = a != b
+	setne	%r8b
+	setp	%al
+	orb	%al, %r8b
+	movzbl	%r8b, %r8d
+	imull	%r8d, %esi		# %esi = $32 * %r8d
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movl	%edi, %eax		# %eax = %edi
+	leave
+	retq
+	.globl	_count_true
+	.p2align	4, 0x90
+_count_true:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc y (4 bytes) at -12(%rbp)
+	movss	%xmm1, -12(%rbp)
+# alloc z (8 bytes) at -24(%rbp)
+	movsd	%xmm2, -24(%rbp)
+# golden/floats.c:35
+# alloc n (4 bytes) at -28(%rbp)
+	movl	$0, -28(%rbp)		# n = $0
+# golden/floats.c:36
+	movsd	-8(%rbp), %xmm8		# %xmm8 = x
+	ucomisd	LCPI_count_true_0(%rip), %xmm8		# %xmm8 = x != 0
+	setne	%sil
+	setp	%al
+	orb	%al, %sil
+	movzbl	%sil, %esi
+	testl	%esi, %esi
+	je	Lcount_true_0
+# golden/floats.c:37
+	movl	-28(%rbp), %esi		# %esi = n
+	addl	$1, %esi		# %esi = n + $1
+	movl	%esi, -28(%rbp)		# n = %esi
+Lcount_true_0:
+# golden/floats.c:39
+	cvtss2sd	-12(%rbp), %xmm8		# (double) y
+	ucomisd	LCPI_count_true_1(%rip), %xmm8		# %xmm8 = %xmm8 > 1.5
+	jbe	Lcount_true_1
+# golden/floats.c:40
+	movl	-28(%rbp), %esi		# %esi = n
+	addl	$1, %esi		# %esi = n + $1
+	movl	%esi, -28(%rbp)		# n = %esi
+Lcount_true_1:
+# golden/floats.c:42
+	movsd	-24(%rbp), %xmm8		# %xmm8 = z
+	ucomisd	-24(%rbp), %xmm8		# %xmm8 = z != z
+	setne	%sil
+	setp	%al
+	orb	%al, %sil
+	movzbl	%sil, %esi
+	testl	%esi, %esi
+	je	Lcount_true_2
+# golden/floats.c:43
+	movl	-28(%rbp), %esi		# %esi = n
+	addl	$10, %esi		# %esi = n + $10
+	movl	%esi, -28(%rbp)		# n = %esi
+Lcount_true_2:
+# golden/floats.c:45
+	movl	-28(%rbp), %eax		# %eax = n
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_count_true_0:
+	.quad	0x0		# 0
+	.literal8
+	.p2align	3
+LCPI_count_true_1:
+	.quad	0x3ff8000000000000		# 1.5
+	.text
+	.globl	_halve_until
+	.p2align	4, 0x90
+_halve_until:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc limit (8 bytes) at -16(%rbp)
+	movsd	%xmm1, -16(%rbp)
+# golden/floats.c:49
+	movsd	-8(%rbp), %xmm8		# %xmm8 = x
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = x > limit
+	jbe	Lhalve_until_2
+Lhalve_until_0:
+# golden/floats.c:50
+	movsd	-8(%rbp), %xmm8		# %xmm8 = x
+	divsd	LCPI_halve_until_0(%rip), %xmm8		# %xmm8 = x / 2
+	movsd	%xmm8, -8(%rbp)		# x = %xmm8
+Lhalve_until_1:
+	movsd	-8(%rbp), %xmm8		# %xmm8 = x
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = x > limit
+	ja	Lhalve_until_0
+Lhalve_until_2:
+# golden/floats.c:52
+	movsd	-8(%rbp), %xmm0		# %xmm0 = x
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_halve_until_0:
+	.quad	0x4000000000000000		# 2
+	.text
+	.globl	_sum_halves
+	.p2align	4, 0x90
+_sum_halves:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$96, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/floats.c:56
+# alloc a (64 bytes) at -72(%rbp)
+# golden/floats.c:57
+# alloc sum (8 bytes) at -80(%rbp)
+	movsd	LCPI_sum_halves_0(%rip), %xmm8		# %xmm8 = 0
+	movsd	%xmm8, -80(%rbp)		# sum = %xmm8
+# golden/floats.c:58
+# alloc i (4 bytes) at -84(%rbp)
+	movl	$0, -84(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lsum_halves_2
+Lsum_halves_0:
+# golden/floats.c:59
+	cvtsi2sdl	-84(%rbp), %xmm8		# (double) i
+	mulsd	LCPI_sum_halves_1(%rip), %xmm8		# %xmm8 = %xmm8 * 0.5
+	movslq	-84(%rbp), %rcx
+	movsd	%xmm8, -72(%rbp,%rcx,8)		# a[i] = %xmm8
+Lsum_halves_1:
+	movl	-84(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -84(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lsum_halves_0
+Lsum_halves_2:
+# golden/floats.c:61
+# alloc i (4 bytes) at -88(%rbp)
+	movl	$0, -88(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lsum_halves_5
+Lsum_halves_3:
+# golden/floats.c:62
+	movsd	-80(%rbp), %xmm8		# %xmm8 = sum
+	movslq	-88(%rbp), %rcx
+	addsd	-72(%rbp,%rcx,8), %xmm8		# %xmm8 = sum + a[i]
+	movsd	%xmm8, -80(%rbp)		# sum = %xmm8
+Lsum_halves_4:
+	movl	-88(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -88(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lsum_halves_3
+Lsum_halves_5:
+# golden/floats.c:64
+	movsd	-80(%rbp), %xmm0		# %xmm0 = sum
+	leave
+	retq
+	.literal8
+	.p2align	3
+LCPI_sum_halves_0:
+	.quad	0x0		# 0
+	.literal8
+	.p2align	3
+LCPI_sum_halves_1:
+	.quad	0x3fe0000000000000		# 0.5
+	.text
+	.globl	_average_of_polynomial
+	.p2align	4, 0x90
+_average_of_polynomial:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# golden/floats.c:68
+# alloc y (8 bytes) at -16(%rbp)
+	movsd	-8(%rbp), %xmm0
+	callq	_polynomial
+# alloc t3 (8 bytes) at -24(%rbp)
+	movsd	%xmm0, -24(%rbp)		# t3 = polynomial()
+	movsd	-24(%rbp), %xmm8		# %xmm8 = t3
+	movsd	%xmm8, -16(%rbp)		# y = %xmm8
+# golden/floats.c:69
+	movsd	-8(%rbp), %xmm0
+	movsd	-16(%rbp), %xmm1
+	callq	_average
+# alloc t4 (8 bytes) at -32(%rbp)
+	movsd	%xmm0, -32(%rbp)		# t4 = average()
+	movsd	-16(%rbp), %xmm0
+	callq	_polynomial
+# alloc t5 (8 bytes) at -40(%rbp)
+	movsd	%xmm0, -40(%rbp)		# t5 = polynomial()
+	movsd	-32(%rbp), %xmm8		# %xmm8 = t4
+	addsd	-40(%rbp), %xmm8		# %xmm8 = t4 + t5
+	movsd	%xmm8, %xmm0		# %xmm0 = %xmm8
+	leave
+	retq
@@ -0,0 +1,44 @@
+#include <stdio.h>
+
+extern double average(double a, double b);
+extern double polynomial(double x);
+extern float scale(float x, int n);
+extern int to_int(double x);
+extern unsigned to_unsigned(double x);
+extern double widen(unsigned u, char c);
+extern double mixed(int i, double d, long l, float f);
+extern int compare(double a, double b);
+extern int count_true(double x, float y, double z);
+extern double halve_until(double x, double limit);
+extern double sum_halves(int n);
+extern double average_of_polynomial(double x);
+
+#define print_expr(expr) printf(#expr " = %.17g\n", (double) (expr))
+
+int main(int argc, char *argv[]) {
+  double nan = 0.0 / 0.0;
+  print_expr(average(1, 2));
+  print_expr(average(-1.5, 1e300));
+  print_expr(polynomial(0));
+  print_expr(polynomial(2.5));
+  print_expr(scale(1.25f, 3));
+  print_expr(scale(-0.1f, 7));
+  print_expr(to_int(2.99));
+  print_expr(to_int(-2.99));
+  print_expr(to_unsigned(3000000000.5));
+  print_expr(widen(4000000000u, -3));
+  print_expr(mixed(3, 0.25, 10000000000L, 0.125f));
+  print_expr(compare(1, 2));
+  print_expr(compare(2, 2));
+  print_expr(compare(3, 2));
+  print_expr(compare(nan, 2));
+  print_expr(compare(2, nan));
+  print_expr(count_true(0, 0, 0));
+  print_expr(count_true(-0.5, 2, nan));
+  print_expr(count_true(nan, 1.5f, 1));
+  print_expr(halve_until(100, 1));
+  print_expr(halve_until(0.5, 1));
+  print_expr(sum_halves(0));
+  print_expr(sum_halves(8));
+  print_expr(average_of_polynomial(1.5));
+}
@@ -0,0 +1,270 @@
+	.globl	_average
+	.p2align	4, 0x90
+_average:
+	addsd	%xmm1, %xmm0
+	divsd	LCPI_average_0(%rip), %xmm0
+	retq
+	.literal8
+	.p2align	3
+LCPI_average_0:
+	.quad	0x4000000000000000		# 2
+	.text
+	.globl	_polynomial
+	.p2align	4, 0x90
+_polynomial:
+	movsd	LCPI_polynomial_0(%rip), %xmm1
+	mulsd	%xmm0, %xmm1
+	mulsd	%xmm0, %xmm1
+	mulsd	LCPI_polynomial_1(%rip), %xmm0
+	movaps	%xmm1, %xmm15
+	subsd	%xmm0, %xmm15
+	movaps	%xmm15, %xmm0
+	addsd	LCPI_polynomial_2(%rip), %xmm0
+	retq
+	.literal8
+	.p2align	3
+LCPI_polynomial_0:
+	.quad	0x400c000000000000		# 3.5
+	.literal8
+	.p2align	3
+LCPI_polynomial_1:
+	.quad	0x4002000000000000		# 2.25
+	.literal8
+	.p2align	3
+LCPI_polynomial_2:
+	.quad	0x3ff0000000000000		# 1
+	.text
+	.globl	_scale
+	.p2align	4, 0x90
+_scale:
+	xorps	%xmm1, %xmm1
+	cvtsi2ssl	%edi, %xmm1
+	mulss	%xmm1, %xmm0
+	cvtss2sd	%xmm0, %xmm0
+	addsd	LCPI_scale_0(%rip), %xmm0
+	cvtsd2ss	%xmm0, %xmm0
+	retq
+	.literal8
+	.p2align	3
+LCPI_scale_0:
+	.quad	0x3fe0000000000000		# 0.5
+	.text
+	.globl	_to_int
+	.p2align	4, 0x90
+_to_int:
+	cvttsd2si	%xmm0, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_to_unsigned
+	.p2align	4, 0x90
+_to_unsigned:
+	cvttsd2si	%xmm0, %rsi
+	movl	%esi, %eax
+	retq
+	.globl	_widen
+	.p2align	4, 0x90
+_widen:
+	movsbl	%sil, %esi
+	xorps	%xmm0, %xmm0
+	cvtsi2sdl	%esi, %xmm0
+	movl	%edi, %esi
+	xorps	%xmm1, %xmm1
+	cvtsi2sdq	%rsi, %xmm1
+	addsd	%xmm1, %xmm0
+	retq
+	.globl	_mixed
+	.p2align	4, 0x90
+_mixed:
+	xorps	%xmm2, %xmm2
+	cvtsi2sdl	%edi, %xmm2
+	mulsd	%xmm2, %xmm0
+	xorps	%xmm2, %xmm2
+	cvtsi2sdq	%rsi, %xmm2
+	addsd	%xmm2, %xmm0
+	cvtss2sd	%xmm1, %xmm1
+	subsd	%xmm1, %xmm0
+	retq
+	.globl	_compare
+	.p2align	4, 0x90
+_compare:
+	ucomisd	%xmm0, %xmm1
+	seta	%al
+	movzbl	%al, %eax
+	movl	%eax, %esi
+	ucomisd	%xmm0, %xmm1
+	setae	%al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	shll	$1, %edi
+	addl	%edi, %esi
+	ucomisd	%xmm1, %xmm0
+	seta	%al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	shll	$2, %edi
+	addl	%edi, %esi
+	ucomisd	%xmm1, %xmm0
+	setae	%al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	shll	$3, %edi
+	addl	%edi, %esi
+	ucomisd	%xmm1, %xmm0
+	sete	%al
+	setnp	%cl
+	andb	%cl, %al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	shll	$4, %edi
+	addl	%edi, %esi
+	ucomisd	%xmm1, %xmm0
+	setne	%al
+	setp	%cl
+	orb	%cl, %al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	shll	$5, %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_count_true
+	.p2align	4, 0x90
+_count_true:
+	ucomisd	LCPI_count_true_0(%rip), %xmm0
+	setne	%al
+	setp	%cl
+	orb	%cl, %al
+	movzbl	%al, %eax
+	movl	%eax, %esi
+	movl	$1, %ecx
+	xorl	%edx, %edx
+	testl	%esi, %esi
+	cmovnel	%ecx, %edx
+	movl	%edx, %esi
+Lcount_true_2:
+	cvtss2sd	%xmm1, %xmm0
+	movl	%esi, %edi
+	addl	$1, %edi
+	ucomisd	LCPI_count_true_1(%rip), %xmm0
+	cmoval	%edi, %esi
+Lcount_true_4:
+	ucomisd	%xmm2, %xmm2
+	setne	%al
+	setp	%cl
+	orb	%cl, %al
+	movzbl	%al, %eax
+	movl	%eax, %edi
+	movl	%esi, %r8d
+	addl	$10, %r8d
+	testl	%edi, %edi
+	cmovnel	%r8d, %esi
+Lcount_true_6:
+	movl	%esi, %eax
+	retq
+	.literal8
+	.p2align	3
+LCPI_count_true_0:
+	.quad	0x0		# 0
+	.literal8
+	.p2align	3
+LCPI_count_true_1:
+	.quad	0x3ff8000000000000		# 1.5
+	.text
+	.globl	_halve_until
+	.p2align	4, 0x90
+_halve_until:
+	ucomisd	%xmm1, %xmm0
+	jbe	Lhalve_until_7
+Lhalve_until_5:
+	movaps	%xmm0, %xmm2
+	.p2align	4, 0x90
+Lhalve_until_2:
+	divsd	LCPI_halve_until_0(%rip), %xmm2
+Lhalve_until_3:
+	ucomisd	%xmm1, %xmm2
+	ja	Lhalve_until_2
+Lhalve_until_6:
+	movaps	%xmm2, %xmm1
+Lhalve_until_4:
+	movaps	%xmm1, %xmm0
+	retq
+Lhalve_until_7:
+	movaps	%xmm0, %xmm1
+	jmp	Lhalve_until_4
+	.literal8
+	.p2align	3
+LCPI_halve_until_0:
+	.quad	0x4000000000000000		# 2
+	.text
+	.globl	_sum_halves
+	.p2align	4, 0x90
+_sum_halves:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	setl	%al
+	movzbl	%al, %eax
+	movl	%eax, %esi
+	testl	%esi, %esi
+	je	Lsum_halves_4
+Lsum_halves_5:
+	xorl	%r8d, %r8d
+	leaq	-72(%rsp), %r9
+	.p2align	4, 0x90
+Lsum_halves_2:
+	xorps	%xmm0, %xmm0
+	cvtsi2sdl	%r8d, %xmm0
+	mulsd	LCPI_sum_halves_1(%rip), %xmm0
+	movsd	%xmm0, (%r9)
+Lsum_halves_3:
+	addl	$1, %r8d
+	addq	$8, %r9
+	cmpl	%edi, %r8d
+	jl	Lsum_halves_2
+Lsum_halves_4:
+	testl	%esi, %esi
+	je	Lsum_halves_14
+Lsum_halves_10:
+	xorl	%r8d, %r8d
+	leaq	-72(%rsp), %r9
+	xorps	%xmm0, %xmm0
+	.p2align	4, 0x90
+Lsum_halves_7:
+	movsd	(%r9), %xmm1
+	addsd	%xmm1, %xmm0
+Lsum_halves_8:
+	addl	$1, %r8d
+	addq	$8, %r9
+	cmpl	%edi, %r8d
+	jl	Lsum_halves_7
+Lsum_halves_9:
+	retq
+Lsum_halves_14:
+	xorps	%xmm0, %xmm0
+	jmp	Lsum_halves_9
+	.literal8
+	.p2align	3
+LCPI_sum_halves_0:
+	.quad	0x0		# 0
+	.literal8
+	.p2align	3
+LCPI_sum_halves_1:
+	.quad	0x3fe0000000000000		# 0.5
+	.text
+	.globl	_average_of_polynomial
+	.p2align	4, 0x90
+_average_of_polynomial:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	movaps	%xmm0, %xmm2
+	movaps	%xmm2, %xmm0
+	callq	_polynomial
+	movaps	%xmm0, %xmm3
+	movaps	%xmm2, %xmm0
+	movaps	%xmm3, %xmm1
+	callq	_average
+	movaps	%xmm0, %xmm2
+	movaps	%xmm3, %xmm0
+	callq	_polynomial
+	addsd	%xmm2, %xmm0
+	leave
+	retq
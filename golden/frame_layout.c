@@ -0,0 +1,15 @@
+int mixed(int n) {
+  char tag;
+  long total;
+  struct {
+    char c;
+    long l;
+    int i;
+  } s;
+  char bytes[3];
+  long longs[2] = {5, 6};
+  int ints[5] = {7};
+  s.i = n * 2;
+  ints[n] = s.i + ints[0];
+  return ints[n] + ints[1] + s.i;
+}
@@ -0,0 +1,44 @@
+	.globl	_mixed
+	.p2align	4, 0x90
+_mixed:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$96, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/frame_layout.c:2
+# alloc tag (1 bytes) at -5(%rbp)
+# golden/frame_layout.c:3
+# alloc total (8 bytes) at -16(%rbp)
+# golden/frame_layout.c:4
+# alloc s (24 bytes) at -40(%rbp)
+# golden/frame_layout.c:9
+# alloc bytes (3 bytes) at -43(%rbp)
+# golden/frame_layout.c:10
+# alloc longs (16 bytes) at -64(%rbp)
+	movl	$0, -60(%rbp)
+	movl	$0, -52(%rbp)
+	movl	$5,-64(%rbp)		# longs[..0] = $5
+	movl	$6,-56(%rbp)		# longs[..8] = $6
+# golden/frame_layout.c:11
+# alloc ints (20 bytes) at -84(%rbp)
+	xorps	%xmm15, %xmm15
+	movups	%xmm15, -80(%rbp)
+	movl	$7,-84(%rbp)		# ints[..0] = $7
+# golden/frame_layout.c:12
+	movl	-4(%rbp), %esi		# %esi = n
+	# %esi = n * $2
+	shll	$1, %esi
+	movl	%esi, -24(%rbp)		# s.i = %esi
+# golden/frame_layout.c:13
+	addl	-84(%rbp), %esi		# %esi = s.i + ints[$0]
+	movslq	-4(%rbp), %rcx
+	movl	%esi, -84(%rbp,%rcx,4)		# ints[n] = %esi
+# golden/frame_layout.c:14
+	movslq	-4(%rbp), %rcx
+	movl	-84(%rbp,%rcx,4), %esi		# %esi = ints[n]
+	addl	-80(%rbp), %esi		# %esi = ints[n] + ints[$1]
+	addl	-24(%rbp), %esi		# %esi = %esi + s.i
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
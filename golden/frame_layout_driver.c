@@ -0,0 +1,10 @@
+#include <stdio.h>
+
+extern int mixed(int n);
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(mixed(1));
+  print_expr(mixed(4));
+}
@@ -0,0 +1,18 @@
+	.globl	_mixed
+	.p2align	4, 0x90
+_mixed:
+	movl	$0, -72(%rsp)
+	movl	%edi, %esi
+	shll	$1, %esi
+	movslq	%edi, %rdi
+	shlq	$2, %rdi
+	leaq	-76(%rsp), %rax
+	addq	%rax, %rdi
+	movl	%esi, %r8d
+	addl	$7, %r8d
+	movl	%r8d, (%rdi)
+	movl	-72(%rsp), %edi
+	addl	%r8d, %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
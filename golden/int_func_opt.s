@@ -0,0 +1,14 @@
+	.globl	_my_func
+	.p2align	4, 0x90
+_my_func:
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	movl	%edi, %eax
+	cltd
+	idivl	%esi
+	movl	%eax, %esi
+	movl	%r8d, %edi
+	addl	%r9d, %edi
+	imull	%edi, %esi
+	movl	%esi, %eax
+	retq
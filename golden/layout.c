@@ -0,0 +1,43 @@
+_Noreturn void fail(int code);
+void abort(void);
+
+int checked_div(int a, int b) {
+  if (b == 0)
+    fail(1);
+  return a / b;
+}
+
+int lookup(int i) {
+  int table[4];
+  table[0] = 2;
+  table[1] = 3;
+  table[2] = 5;
+  table[3] = 7;
+  if (i < 0 || i >= 4)
+    abort();
+  return table[i];
+}
+
+int sum_checked(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    if (sum > 1000000)
+      fail(2);
+    sum += lookup(i - i / 4 * 4) * i;
+  }
+  return sum;
+}
+
+_Noreturn void fail_twice(int code) {
+  fail(code * 2);
+}
+
+int pick(int op, int x) {
+  switch (op) {
+    case 0: return x;
+    case 1: return x + 1;
+    case 2: return x * 2;
+    case 3: return x * x;
+    default: fail(3);
+  }
+}
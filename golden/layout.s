@@ -0,0 +1,195 @@
+	.globl	_checked_div
+	.p2align	4, 0x90
+_checked_div:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/layout.c:5
+	cmpl	$0, %esi		# %esi = b == $0
+	jne	Lchecked_div_0
+	movl	$1, %edi
+	callq	_fail
+Lchecked_div_0:
+# golden/layout.c:7
+	movl	-4(%rbp), %eax		# %eax = a
+	cdq
+	idivl	-8(%rbp)		# %eax = a / b
+	movl	%eax, %eax
+	leave
+	retq
+	.globl	_lookup
+	.p2align	4, 0x90
+_lookup:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/layout.c:11
+# alloc table (16 bytes) at -20(%rbp)
+# golden/layout.c:12
+	movl	$2, -20(%rbp)		# table[$0] = $2
+# golden/layout.c:13
+	movl	$3, -16(%rbp)		# table[$1] = $3
+# golden/layout.c:14
+	movl	$5, -12(%rbp)		# table[$2] = $5
+# golden/layout.c:15
+	movl	$7, -8(%rbp)		# table[$3] = $7
+# golden/layout.c:16
+	movl	%edi, %esi		# %esi = i
+	cmpl	$0, %esi		# %esi = i < $0
+	jl	Llookup_1
+	movl	-4(%rbp), %esi		# %esi = i
+	cmpl	$4, %esi		# %esi = i >= $4
+	jl	Llookup_0
+Llookup_1:
+	callq	_abort
+Llookup_0:
+# golden/layout.c:18
+	movslq	-4(%rbp), %rcx
+	movl	-20(%rbp,%rcx,4), %eax		# %eax = table[i]
+	leave
+	retq
+	.globl	_sum_checked
+	.p2align	4, 0x90
+_sum_checked:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/layout.c:22
+# alloc sum (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# sum = $0
+# golden/layout.c:23
+# alloc i (4 bytes) at -12(%rbp)
+	movl	$0, -12(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lsum_checked_2
+Lsum_checked_0:
+# golden/layout.c:24
+	movl	-8(%rbp), %esi		# %esi = sum
+	cmpl	$1000000, %esi		# %esi = sum > $1000000
+	jle	Lsum_checked_3
+	movl	$2, %edi
+	callq	_fail
+Lsum_checked_3:
+# golden/layout.c:26
+	movl	-12(%rbp), %esi		# %esi = i
+	movl	-12(%rbp), %edi		# %edi = i
+	# %edi = i / $4
+	leal	3(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$2, %eax
+	movl	%eax, %edi
+	# %edi = %edi * $4
+	shll	$2, %edi
+	subl	%edi, %esi		# %esi = i - %edi
+	movl	%esi, %edi
+	callq	_lookup
+# alloc t4 (4 bytes) at -16(%rbp)
+	movl	%eax, -16(%rbp)		# t4 = lookup()
+	movl	-8(%rbp), %esi		# %esi = sum
+	movl	%eax, %edi		# %edi = t4
+	imull	-12(%rbp), %edi		# %edi = t4 * i
+	addl	%edi, %esi		# %esi = sum + %edi
+	movl	%esi, -8(%rbp)		# sum = %esi
+Lsum_checked_1:
+	movl	-12(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -12(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lsum_checked_0
+Lsum_checked_2:
+# golden/layout.c:28
+	movl	-8(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_fail_twice
+	.p2align	4, 0x90
+_fail_twice:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc code (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/layout.c:32
+	movl	%edi, %esi		# %esi = code
+	# %esi = code * $2
+	shll	$1, %esi
+	movl	%esi, %edi
+	callq	_fail
+	leave
+	retq
+	.globl	_pick
+	.p2align	4, 0x90
+_pick:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc op (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc x (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/layout.c:36
+# alloc switch (4 bytes) at -12(%rbp)
+	movl	%edi, %esi		# %esi = op
+	movl	%esi, -12(%rbp)		# switch = %esi
+	jmp	Lpick_0
+# golden/layout.c:37
+Lpick_2:
+	movl	-8(%rbp), %eax		# %eax = x
+	leave
+	retq
+# golden/layout.c:38
+Lpick_3:
+	movl	-8(%rbp), %esi		# %esi = x
+	addl	$1, %esi		# %esi = x + $1
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+# golden/layout.c:39
+Lpick_4:
+	movl	-8(%rbp), %esi		# %esi = x
+	# %esi = x * $2
+	shll	$1, %esi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+# golden/layout.c:40
+Lpick_5:
+	movl	-8(%rbp), %esi		# %esi = x
+	imull	-8(%rbp), %esi		# %esi = x * x
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+# golden/layout.c:41
+Lpick_6:
+	movl	$3, %edi
+	callq	_fail
+	jmp	Lpick_1
+Lpick_0:
+	movl	-12(%rbp), %eax		# %eax = switch
+	cmpl	$3, %eax
+	ja	Lpick_6
+	leaq	Lpick_7_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+Lpick_7_table:
+	.long	Lpick_2-Lpick_7_table
+	.long	Lpick_3-Lpick_7_table
+	.long	Lpick_4-Lpick_7_table
+	.long	Lpick_5-Lpick_7_table
+	.text
+Lpick_1:
+	leave
+	retq
@@ -0,0 +1,28 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+extern int checked_div(int a, int b);
+extern int lookup(int i);
+extern int sum_checked(int n);
+extern _Noreturn void fail_twice(int code);
+extern int pick(int op, int x);
+
+_Noreturn void fail(int code) {
+  printf("fail(%d)\n", code);
+  exit(0);
+}
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(checked_div(17, 5));
+  print_expr(checked_div(-9, 2));
+  print_expr(lookup(0));
+  print_expr(lookup(3));
+  print_expr(sum_checked(0));
+  print_expr(sum_checked(100));
+  print_expr(pick(0, 6));
+  print_expr(pick(3, 6));
+  print_expr(checked_div(1, 0));
+  return 0;
+}
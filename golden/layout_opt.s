@@ -0,0 +1,182 @@
+	.globl	_checked_div
+	.p2align	4, 0x90
+_checked_div:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	pushq	%r12
+	movq	%rdi, %rbx
+	movq	%rsi, %r12
+	cmpl	$0, %r12d
+	je	Lchecked_div_3
+Lchecked_div_2:
+	movl	%ebx, %eax
+	cltd
+	idivl	%r12d
+	movl	%eax, %eax
+	leaq	-16(%rbp), %rsp
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	retq
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lchecked_div_3:
+	movq	$1, %rdi
+	callq	_fail
+	jmp	Lchecked_div_2
+	.text
+	.globl	_lookup
+	.p2align	4, 0x90
+_lookup:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	subq	$24, %rsp
+	movq	%rdi, %rbx
+	movl	$2, -24(%rbp)
+	movl	$3, -20(%rbp)
+	movl	$5, -16(%rbp)
+	movl	$7, -12(%rbp)
+	cmpl	$0, %ebx
+	jl	Llookup_3
+Llookup_4:
+	cmpl	$4, %ebx
+	jge	Llookup_3
+Llookup_2:
+	movslq	%ebx, %rsi
+	shlq	$2, %rsi
+	leaq	-24(%rbp), %rax
+	addq	%rax, %rsi
+	movl	(%rsi), %eax
+	leaq	-8(%rbp), %rsp
+	popq	%rbx
+	popq	%rbp
+	retq
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Llookup_3:
+	callq	_abort
+	jmp	Llookup_2
+	.text
+	.globl	_sum_checked
+	.p2align	4, 0x90
+_sum_checked:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	subq	$8, %rsp
+	movq	%rdi, %rbx
+	xorl	%r11d, %r11d
+	cmpl	%ebx, %r11d
+	jge	Lsum_checked_9
+Lsum_checked_5:
+	xorl	%r12d, %r12d
+	xorl	%r13d, %r13d
+	.p2align	4, 0x90
+Lsum_checked_2:
+	cmpl	$1000000, %r12d
+	jg	Lsum_checked_7
+Lsum_checked_6:
+	leal	3(%r13), %eax
+	testl	%r13d, %r13d
+	cmovnsl	%r13d, %eax
+	sarl	$2, %eax
+	movl	%eax, %esi
+	shll	$2, %esi
+	movl	%r13d, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %esi
+	movq	%rsi, %rdi
+	callq	_lookup
+	movl	%eax, %esi
+	imull	%r13d, %esi
+	addl	%r12d, %esi
+Lsum_checked_3:
+	movl	%r13d, %edi
+	addl	$1, %edi
+	cmpl	%ebx, %edi
+	jge	Lsum_checked_4
+Lsum_checked_11:
+	movq	%rsi, %r12
+	movq	%rdi, %r13
+	jmp	Lsum_checked_2
+Lsum_checked_4:
+	movl	%esi, %eax
+	leaq	-24(%rbp), %rsp
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	retq
+Lsum_checked_9:
+	xorl	%esi, %esi
+	jmp	Lsum_checked_4
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lsum_checked_7:
+	movq	$2, %rdi
+	callq	_fail
+	jmp	Lsum_checked_6
+	.text
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+	.globl	_fail_twice
+	.p2align	4, 0x90
+_fail_twice:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	movl	%edi, %esi
+	shll	$1, %esi
+	movq	%rsi, %rdi
+	leave
+	jmp	_fail
+	.text
+	.globl	_pick
+	.p2align	4, 0x90
+_pick:
+	pushq	%rbp
+	movq	%rsp, %rbp
+Lpick_2:
+	movl	%edi, %eax
+	cmpl	$3, %eax
+	ja	Lpick_8
+	leaq	LSW_pick_2_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+LSW_pick_2_table:
+	.long	Lpick_4-LSW_pick_2_table
+	.long	Lpick_5-LSW_pick_2_table
+	.long	Lpick_6-LSW_pick_2_table
+	.long	Lpick_7-LSW_pick_2_table
+	.text
+Lpick_4:
+	movl	%esi, %eax
+	leave
+	retq
+Lpick_5:
+	movl	%esi, %edi
+	addl	$1, %edi
+	movl	%edi, %eax
+	leave
+	retq
+Lpick_7:
+	movl	%esi, %edi
+	imull	%esi, %edi
+	movl	%edi, %eax
+	leave
+	retq
+Lpick_6:
+	shll	$1, %esi
+	movl	%esi, %eax
+	leave
+	retq
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lpick_8:
+	movq	$3, %rdi
+	callq	_fail
+Lpick_3:
+	leave
+	retq
+	.text
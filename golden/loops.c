@@ -0,0 +1,126 @@
+int sum_to(int n) {
+  int sum = 0;
+  for (int i = 1; i <= n; i++) {
+    sum += i;
+  }
+  return sum;
+}
+
+int count_down(int n) {
+  int steps = 0;
+  while (n > 0) {
+    n -= 3;
+    ++steps;
+  }
+  return steps * 100 + n;
+}
+
+int do_once(int n) {
+  int runs = 0;
+  do {
+    runs++;
+    n--;
+  } while (n > 0);
+  return runs;
+}
+
+int collatz(int n) {
+  int steps = 0;
+  while (n != 1) {
+    int half = n / 2;
+    if (half * 2 == n) {
+      n = half;
+    } else {
+      n = 3 * n + 1;
+    }
+    steps++;
+  }
+  return steps;
+}
+
+int skip_and_stop(int n, int stop) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    if (i == stop)
+      break;
+    int third = i / 3;
+    if (third * 3 == i)
+      continue;
+    sum += i;
+  }
+  return sum;
+}
+
+int nested(int n) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = i; j < n; j++) {
+      if (j - i > 2)
+        break;
+      count += i * j;
+    }
+  }
+  return count;
+}
+
+int fill_table(int scale) {
+  int table[8][10];
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 10; j++) {
+      table[i][j] = i * scale + j;
+    }
+  }
+  int sum = 0;
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 10; j++) {
+      sum += table[i][j];
+    }
+  }
+  return sum + table[7][9];
+}
+
+int invariant_math(int n, int x, int y) {
+  int a[16];
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    a[i] = x * y + x / 4 + i;
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    sum += a[i] - (x * y + x / 4);
+  }
+  return sum;
+}
+
+int invariant_load(int n) {
+  int limits[2] = {3, 7};
+  int sum = 0;
+  int i = 0;
+  while (i < n) {
+    sum += limits[1] * i + limits[0];
+    i += 2;
+  }
+  return sum;
+}
+
+int empty_bodies(int n) {
+  int i = 0;
+  for (; i < n; i++)
+    ;
+  for (;;) {
+    if (i >= n + 5)
+      break;
+    i++;
+  }
+  return i;
+}
+
+int unreachable_loop(int p) {
+  int v = 8;
+  if (1) {
+  } else {
+    do {
+    } while (p);
+    p = v;
+  }
+  return p;
+}
@@ -0,0 +1,567 @@
+	.globl	_sum_to
+	.p2align	4, 0x90
+_sum_to:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:2
+# alloc sum (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# sum = $0
+# golden/loops.c:3
+# alloc i (4 bytes) at -12(%rbp)
+	movl	$1, -12(%rbp)		# i = $1
+	movl	$1, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i <= n
+	jg	Lsum_to_2
+Lsum_to_0:
+# golden/loops.c:4
+	movl	-8(%rbp), %esi		# %esi = sum
+	addl	-12(%rbp), %esi		# %esi = sum + i
+	movl	%esi, -8(%rbp)		# sum = %esi
+Lsum_to_1:
+	movl	-12(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -12(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i <= n
+	jle	Lsum_to_0
+Lsum_to_2:
+# golden/loops.c:6
+	movl	-8(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_count_down
+	.p2align	4, 0x90
+_count_down:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:10
+# alloc steps (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# steps = $0
+# golden/loops.c:11
+	movl	%edi, %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n > $0
+	jle	Lcount_down_2
+Lcount_down_0:
+# golden/loops.c:12
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$3, %esi		# %esi = n - $3
+	movl	%esi, -4(%rbp)		# n = %esi
+# golden/loops.c:13
+	movl	-8(%rbp), %esi		# %esi = steps
+	addl	$1, %esi		# %esi = steps + $1
+	movl	%esi, -8(%rbp)		# steps = %esi
+Lcount_down_1:
+	movl	-4(%rbp), %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n > $0
+	jg	Lcount_down_0
+Lcount_down_2:
+# golden/loops.c:15
+	movl	-8(%rbp), %esi		# %esi = steps
+	# %esi = steps * $100
+	leal	(%rsi,%rsi,4), %esi
+	leal	(%rsi,%rsi,4), %esi
+	shll	$2, %esi
+	addl	-4(%rbp), %esi		# %esi = %esi + n
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_do_once
+	.p2align	4, 0x90
+_do_once:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:19
+# alloc runs (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# runs = $0
+# golden/loops.c:20
+Ldo_once_0:
+# golden/loops.c:21
+	movl	-8(%rbp), %esi		# %esi = runs
+	addl	$1, %esi		# %esi = runs + $1
+	movl	%esi, -8(%rbp)		# runs = %esi
+# golden/loops.c:22
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+	movl	%esi, -4(%rbp)		# n = %esi
+Ldo_once_1:
+	movl	-4(%rbp), %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n > $0
+	jg	Ldo_once_0
+Ldo_once_2:
+# golden/loops.c:24
+	movl	-8(%rbp), %eax		# %eax = runs
+	leave
+	retq
+	.globl	_collatz
+	.p2align	4, 0x90
+_collatz:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:28
+# alloc steps (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# steps = $0
+# golden/loops.c:29
+	movl	%edi, %esi		# %esi = n
+	cmpl	$1, %esi		# %esi = n != $1
+	je	Lcollatz_2
+Lcollatz_0:
+# golden/loops.c:30
+# alloc half (4 bytes) at -12(%rbp)
+	movl	-4(%rbp), %esi		# %esi = n
+	# %esi = n / $2
+	leal	1(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$1, %eax
+	movl	%eax, -12(%rbp)
+# golden/loops.c:31
+	movl	%eax, %esi		# %esi = half
+	# %esi = half * $2
+	shll	$1, %esi
+	cmpl	-4(%rbp), %esi		# %esi = %esi == n
+	jne	Lcollatz_3
+# golden/loops.c:32
+	movl	-12(%rbp), %esi		# %esi = half
+	movl	%esi, -4(%rbp)		# n = %esi
+	jmp	Lcollatz_4
+Lcollatz_3:
+# golden/loops.c:34
+	movl	$3, %esi		# %esi = $3
+	imull	-4(%rbp), %esi		# %esi = $3 * n
+	addl	$1, %esi		# %esi = %esi + $1
+	movl	%esi, -4(%rbp)		# n = %esi
+Lcollatz_4:
+# golden/loops.c:36
+	movl	-8(%rbp), %esi		# %esi = steps
+	addl	$1, %esi		# %esi = steps + $1
+	movl	%esi, -8(%rbp)		# steps = %esi
+Lcollatz_1:
+	movl	-4(%rbp), %esi		# %esi = n
+	cmpl	$1, %esi		# %esi = n != $1
+	jne	Lcollatz_0
+Lcollatz_2:
+# golden/loops.c:38
+	movl	-8(%rbp), %eax		# %eax = steps
+	leave
+	retq
+	.globl	_skip_and_stop
+	.p2align	4, 0x90
+_skip_and_stop:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc stop (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/loops.c:42
+# alloc sum (4 bytes) at -12(%rbp)
+	movl	$0, -12(%rbp)		# sum = $0
+# golden/loops.c:43
+# alloc i (4 bytes) at -16(%rbp)
+	movl	$0, -16(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lskip_and_stop_2
+Lskip_and_stop_0:
+# golden/loops.c:44
+	movl	-16(%rbp), %esi		# %esi = i
+	cmpl	-8(%rbp), %esi		# %esi = i == stop
+	je	Lskip_and_stop_2
+Lskip_and_stop_3:
+# golden/loops.c:46
+# alloc third (4 bytes) at -20(%rbp)
+	movl	-16(%rbp), %esi		# %esi = i
+	# %esi = i / $3
+	movl	$1431655766, %eax
+	imull	%esi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, -20(%rbp)
+# golden/loops.c:47
+	movl	%edx, %esi		# %esi = third
+	# %esi = third * $3
+	leal	(%rsi,%rsi,2), %esi
+	cmpl	-16(%rbp), %esi		# %esi = %esi == i
+	je	Lskip_and_stop_1
+Lskip_and_stop_4:
+# golden/loops.c:49
+	movl	-12(%rbp), %esi		# %esi = sum
+	addl	-16(%rbp), %esi		# %esi = sum + i
+	movl	%esi, -12(%rbp)		# sum = %esi
+Lskip_and_stop_1:
+	movl	-16(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -16(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lskip_and_stop_0
+Lskip_and_stop_2:
+# golden/loops.c:51
+	movl	-12(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_nested
+	.p2align	4, 0x90
+_nested:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:55
+# alloc count (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# count = $0
+# golden/loops.c:56
+# alloc i (4 bytes) at -12(%rbp)
+	movl	$0, -12(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lnested_2
+Lnested_0:
+# golden/loops.c:57
+# alloc j (4 bytes) at -16(%rbp)
+	movl	-12(%rbp), %esi		# %esi = i
+	movl	%esi, -16(%rbp)		# j = %esi
+	cmpl	-4(%rbp), %esi		# %esi = j < n
+	jge	Lnested_5
+Lnested_3:
+# golden/loops.c:58
+	movl	-16(%rbp), %esi		# %esi = j
+	subl	-12(%rbp), %esi		# %esi = j - i
+	cmpl	$2, %esi		# %esi = %esi > $2
+	jg	Lnested_5
+Lnested_6:
+# golden/loops.c:60
+	movl	-8(%rbp), %esi		# %esi = count
+	movl	-12(%rbp), %edi		# %edi = i
+	imull	-16(%rbp), %edi		# %edi = i * j
+	addl	%edi, %esi		# %esi = count + %edi
+	movl	%esi, -8(%rbp)		# count = %esi
+Lnested_4:
+	movl	-16(%rbp), %esi		# %esi = j
+	addl	$1, %esi		# %esi = j + $1
+	movl	%esi, -16(%rbp)		# j = %esi
+	cmpl	-4(%rbp), %esi		# %esi = j < n
+	jl	Lnested_3
+Lnested_5:
+Lnested_1:
+	movl	-12(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -12(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lnested_0
+Lnested_2:
+# golden/loops.c:63
+	movl	-8(%rbp), %eax		# %eax = count
+	leave
+	retq
+	.globl	_fill_table
+	.p2align	4, 0x90
+_fill_table:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$352, %rsp
+# alloc scale (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:67
+# alloc table (320 bytes) at -324(%rbp)
+# golden/loops.c:68
+# alloc i (4 bytes) at -328(%rbp)
+	movl	$0, -328(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	$8, %esi		# %esi = i < $8
+	jge	Lfill_table_2
+Lfill_table_0:
+# golden/loops.c:69
+# alloc j (4 bytes) at -332(%rbp)
+	movl	$0, -332(%rbp)		# j = $0
+	movl	$0, %esi		# %esi = j
+	cmpl	$10, %esi		# %esi = j < $10
+	jge	Lfill_table_5
+Lfill_table_3:
+# golden/loops.c:70
+	movl	-328(%rbp), %esi		# %esi = i
+	imull	-4(%rbp), %esi		# %esi = i * scale
+	addl	-332(%rbp), %esi		# %esi = %esi + j
+	movl	-332(%rbp), %edi		# %edi = j
+	# %edi = j * $4
+	shll	$2, %edi
+	movl	-328(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $40
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movslq	%edi, %rcx
+	movl	%esi, -324(%rbp,%rcx)		# table[i][j] = %esi
+Lfill_table_4:
+	movl	-332(%rbp), %esi		# %esi = j
+	addl	$1, %esi		# %esi = j + $1
+	movl	%esi, -332(%rbp)		# j = %esi
+	cmpl	$10, %esi		# %esi = j < $10
+	jl	Lfill_table_3
+Lfill_table_5:
+Lfill_table_1:
+	movl	-328(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -328(%rbp)		# i = %esi
+	cmpl	$8, %esi		# %esi = i < $8
+	jl	Lfill_table_0
+Lfill_table_2:
+# golden/loops.c:73
+# alloc sum (4 bytes) at -336(%rbp)
+	movl	$0, -336(%rbp)		# sum = $0
+# golden/loops.c:74
+# alloc i (4 bytes) at -340(%rbp)
+	movl	$0, -340(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	$8, %esi		# %esi = i < $8
+	jge	Lfill_table_8
+Lfill_table_6:
+# golden/loops.c:75
+# alloc j (4 bytes) at -344(%rbp)
+	movl	$0, -344(%rbp)		# j = $0
+	movl	$0, %esi		# %esi = j
+	cmpl	$10, %esi		# %esi = j < $10
+	jge	Lfill_table_11
+Lfill_table_9:
+# golden/loops.c:76
+	movl	-344(%rbp), %esi		# %esi = j
+	# %esi = j * $4
+	shll	$2, %esi
+	movl	-340(%rbp), %edi		# %edi = i
+	# %edi = i * $40
+	leal	(%rdi,%rdi,4), %edi
+	shll	$3, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movslq	%esi, %rcx
+	movl	-324(%rbp,%rcx), %esi		# %esi = table[i][j]
+	movl	-336(%rbp), %edi		# %edi = sum
+	addl	%esi, %edi		# %edi = sum + table[i][j]
+	movl	%edi, -336(%rbp)		# sum = %edi
+Lfill_table_10:
+	movl	-344(%rbp), %esi		# %esi = j
+	addl	$1, %esi		# %esi = j + $1
+	movl	%esi, -344(%rbp)		# j = %esi
+	cmpl	$10, %esi		# %esi = j < $10
+	jl	Lfill_table_9
+Lfill_table_11:
+Lfill_table_7:
+	movl	-340(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -340(%rbp)		# i = %esi
+	cmpl	$8, %esi		# %esi = i < $8
+	jl	Lfill_table_6
+Lfill_table_8:
+# golden/loops.c:79
+	movl	-336(%rbp), %esi		# %esi = sum
+	addl	-8(%rbp), %esi		# %esi = sum + table[$7][$9]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_invariant_math
+	.p2align	4, 0x90
+_invariant_math:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$96, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc x (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc y (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/loops.c:83
+# alloc a (64 bytes) at -76(%rbp)
+# golden/loops.c:84
+# alloc sum (4 bytes) at -80(%rbp)
+	movl	$0, -80(%rbp)		# sum = $0
+# golden/loops.c:85
+# alloc i (4 bytes) at -84(%rbp)
+	movl	$0, -84(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Linvariant_math_2
+Linvariant_math_0:
+# golden/loops.c:86
+	movl	-8(%rbp), %esi		# %esi = x
+	imull	-12(%rbp), %esi		# %esi = x * y
+	movl	-8(%rbp), %edi		# %edi = x
+	# %edi = x / $4
+	leal	3(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$2, %eax
+	movl	%eax, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	addl	-84(%rbp), %esi		# %esi = %esi + i
+	movslq	-84(%rbp), %rcx
+	movl	%esi, -76(%rbp,%rcx,4)		# a[i] = %esi
+Linvariant_math_1:
+	movl	-84(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -84(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Linvariant_math_0
+Linvariant_math_2:
+# golden/loops.c:88
+# alloc i (4 bytes) at -88(%rbp)
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+	movl	%esi, -88(%rbp)		# i = %esi
+	cmpl	$0, %esi		# %esi = i >= $0
+	jl	Linvariant_math_5
+Linvariant_math_3:
+# golden/loops.c:89
+	movl	-8(%rbp), %esi		# %esi = x
+	imull	-12(%rbp), %esi		# %esi = x * y
+	movl	-8(%rbp), %edi		# %edi = x
+	# %edi = x / $4
+	leal	3(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$2, %eax
+	movl	%eax, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movslq	-88(%rbp), %rcx
+	movl	-76(%rbp,%rcx,4), %edi		# %edi = a[i]
+	subl	%esi, %edi		# %edi = a[i] - %esi
+	movl	-80(%rbp), %esi		# %esi = sum
+	addl	%edi, %esi		# %esi = sum + %edi
+	movl	%esi, -80(%rbp)		# sum = %esi
+Linvariant_math_4:
+	movl	-88(%rbp), %esi		# %esi = i
+	subl	$1, %esi		# %esi = i - $1
+	movl	%esi, -88(%rbp)		# i = %esi
+	cmpl	$0, %esi		# %esi = i >= $0
+	jge	Linvariant_math_3
+Linvariant_math_5:
+# golden/loops.c:91
+	movl	-80(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_invariant_load
+	.p2align	4, 0x90
+_invariant_load:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:95
+# alloc limits (8 bytes) at -12(%rbp)
+	movl	$3,-12(%rbp)		# limits[..0] = $3
+	movl	$7,-8(%rbp)		# limits[..4] = $7
+# golden/loops.c:96
+# alloc sum (4 bytes) at -16(%rbp)
+	movl	$0, -16(%rbp)		# sum = $0
+# golden/loops.c:97
+# alloc i (4 bytes) at -20(%rbp)
+	movl	$0, -20(%rbp)		# i = $0
+# golden/loops.c:98
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Linvariant_load_2
+Linvariant_load_0:
+# golden/loops.c:99
+	movl	-16(%rbp), %esi		# %esi = sum
+	movl	-8(%rbp), %edi		# %edi = limits[$1]
+	imull	-20(%rbp), %edi		# %edi = limits[$1] * i
+	addl	-12(%rbp), %edi		# %edi = %edi + limits[$0]
+	addl	%edi, %esi		# %esi = sum + %edi
+	movl	%esi, -16(%rbp)		# sum = %esi
+# golden/loops.c:100
+	movl	-20(%rbp), %esi		# %esi = i
+	addl	$2, %esi		# %esi = i + $2
+	movl	%esi, -20(%rbp)		# i = %esi
+Linvariant_load_1:
+	movl	-20(%rbp), %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Linvariant_load_0
+Linvariant_load_2:
+# golden/loops.c:102
+	movl	-16(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_empty_bodies
+	.p2align	4, 0x90
+_empty_bodies:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:106
+# alloc i (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# i = $0
+# golden/loops.c:107
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lempty_bodies_2
+Lempty_bodies_0:
+Lempty_bodies_1:
+	movl	-8(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -8(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lempty_bodies_0
+Lempty_bodies_2:
+# golden/loops.c:109
+Lempty_bodies_3:
+# golden/loops.c:110
+	movl	-8(%rbp), %esi		# %esi = i
+	movl	-4(%rbp), %edi		# %edi = n
+	addl	$5, %edi		# %edi = n + $5
+	cmpl	%edi, %esi		# %esi = i >= %edi
+	jge	Lempty_bodies_5
+Lempty_bodies_6:
+# golden/loops.c:112
+	movl	-8(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -8(%rbp)		# i = %esi
+Lempty_bodies_4:
+	jmp	Lempty_bodies_3
+Lempty_bodies_5:
+# golden/loops.c:114
+	movl	-8(%rbp), %eax		# %eax = i
+	leave
+	retq
+	.globl	_unreachable_loop
+	.p2align	4, 0x90
+_unreachable_loop:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc p (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/loops.c:118
+# alloc v (4 bytes) at -8(%rbp)
+	movl	$8, -8(%rbp)		# v = $8
+# golden/loops.c:119
+	jmp	Lunreachable_loop_1
+Lunreachable_loop_0:
+# golden/loops.c:121
+Lunreachable_loop_2:
+Lunreachable_loop_3:
+	cmpl	$0, -4(%rbp)		# p
+	jne	Lunreachable_loop_2
+Lunreachable_loop_4:
+# golden/loops.c:123
+	movl	-8(%rbp), %esi		# %esi = v
+	movl	%esi, -4(%rbp)		# p = %esi
+Lunreachable_loop_1:
+# golden/loops.c:125
+	movl	-4(%rbp), %eax		# %eax = p
+	leave
+	retq
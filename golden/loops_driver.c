@@ -0,0 +1,41 @@
+#include <stdio.h>
+
+extern int sum_to(int n);
+extern int count_down(int n);
+extern int do_once(int n);
+extern int collatz(int n);
+extern int skip_and_stop(int n, int stop);
+extern int nested(int n);
+extern int fill_table(int scale);
+extern int invariant_math(int n, int x, int y);
+extern int invariant_load(int n);
+extern int empty_bodies(int n);
+extern int unreachable_loop(int p);
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(sum_to(0));
+  print_expr(sum_to(10));
+  print_expr(sum_to(1000));
+  print_expr(count_down(0));
+  print_expr(count_down(10));
+  print_expr(do_once(0));
+  print_expr(do_once(5));
+  print_expr(collatz(1));
+  print_expr(collatz(27));
+  print_expr(skip_and_stop(20, 100));
+  print_expr(skip_and_stop(20, 11));
+  print_expr(nested(0));
+  print_expr(nested(6));
+  print_expr(fill_table(10));
+  print_expr(fill_table(-3));
+  print_expr(invariant_math(0, 5, 6));
+  print_expr(invariant_math(16, 5, 6));
+  print_expr(invariant_math(9, -13, 7));
+  print_expr(invariant_load(0));
+  print_expr(invariant_load(9));
+  print_expr(empty_bodies(4));
+  print_expr(empty_bodies(-2));
+  print_expr(unreachable_loop(3));
+}
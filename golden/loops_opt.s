@@ -0,0 +1,427 @@
+	.globl	_sum_to
+	.p2align	4, 0x90
+_sum_to:
+	movl	$1, %r11d
+	cmpl	%edi, %r11d
+	jg	Lsum_to_7
+Lsum_to_5:
+	xorl	%esi, %esi
+	movq	$1, %r8
+	.p2align	4, 0x90
+Lsum_to_2:
+	addl	%r8d, %esi
+Lsum_to_3:
+	addl	$1, %r8d
+	cmpl	%edi, %r8d
+	jle	Lsum_to_2
+Lsum_to_4:
+	movl	%esi, %eax
+	retq
+Lsum_to_7:
+	xorl	%esi, %esi
+	jmp	Lsum_to_4
+	.globl	_count_down
+	.p2align	4, 0x90
+_count_down:
+	cmpl	$0, %edi
+	jle	Lcount_down_7
+Lcount_down_5:
+	movq	%rdi, %rsi
+	xorl	%r8d, %r8d
+	.p2align	4, 0x90
+Lcount_down_2:
+	subl	$3, %esi
+	addl	$1, %r8d
+Lcount_down_3:
+	cmpl	$0, %esi
+	jg	Lcount_down_2
+Lcount_down_4:
+	leal	(%r8,%r8,4), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$2, %r8d
+	addl	%r8d, %esi
+	movl	%esi, %eax
+	retq
+Lcount_down_7:
+	xorl	%r8d, %r8d
+	movq	%rdi, %rsi
+	jmp	Lcount_down_4
+	.globl	_do_once
+	.p2align	4, 0x90
+_do_once:
+	xorl	%esi, %esi
+	.p2align	4, 0x90
+Ldo_once_2:
+	addl	$1, %esi
+	subl	$1, %edi
+Ldo_once_3:
+	cmpl	$0, %edi
+	jg	Ldo_once_2
+Ldo_once_4:
+	movl	%esi, %eax
+	retq
+	.globl	_collatz
+	.p2align	4, 0x90
+_collatz:
+	cmpl	$1, %edi
+	je	Lcollatz_9
+Lcollatz_5:
+	xorl	%esi, %esi
+	.p2align	4, 0x90
+Lcollatz_2:
+	leal	1(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$1, %eax
+	movl	%eax, %r8d
+	movl	%r8d, %r9d
+	shll	$1, %r9d
+	movl	%edi, %r10d
+	leal	(%r10,%r10,2), %r10d
+	addl	$1, %r10d
+	movl	%r10d, %edx
+	cmpl	%edi, %r9d
+	cmovel	%r8d, %edx
+	movl	%edx, %edi
+Lcollatz_7:
+	addl	$1, %esi
+Lcollatz_3:
+	cmpl	$1, %edi
+	jne	Lcollatz_2
+Lcollatz_4:
+	movl	%esi, %eax
+	retq
+Lcollatz_9:
+	xorl	%esi, %esi
+	jmp	Lcollatz_4
+	.globl	_skip_and_stop
+	.p2align	4, 0x90
+_skip_and_stop:
+	pushq	%rbx
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lskip_and_stop_10
+Lskip_and_stop_5:
+	xorl	%r8d, %r8d
+	xorl	%r9d, %r9d
+	.p2align	4, 0x90
+Lskip_and_stop_2:
+	cmpl	%esi, %r8d
+	je	Lskip_and_stop_7
+Lskip_and_stop_6:
+	movl	$1431655766, %eax
+	imull	%r8d
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r10d
+	leal	(%r10,%r10,2), %r10d
+	movl	%r9d, %ebx
+	addl	%r8d, %ebx
+	movl	%ebx, %edx
+	cmpl	%r8d, %r10d
+	cmovel	%r9d, %edx
+	movl	%edx, %r10d
+Lskip_and_stop_3:
+	addl	$1, %r8d
+	cmpl	%edi, %r8d
+	jge	Lskip_and_stop_9
+Lskip_and_stop_11:
+	movq	%r10, %r9
+	jmp	Lskip_and_stop_2
+Lskip_and_stop_9:
+	movq	%r10, %rsi
+Lskip_and_stop_4:
+	movl	%esi, %eax
+	popq	%rbx
+	retq
+Lskip_and_stop_10:
+	xorl	%esi, %esi
+	jmp	Lskip_and_stop_4
+Lskip_and_stop_7:
+	movq	%r9, %rsi
+	jmp	Lskip_and_stop_4
+	.globl	_nested
+	.p2align	4, 0x90
+_nested:
+	pushq	%rbx
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lnested_14
+Lnested_5:
+	xorl	%esi, %esi
+	xorl	%r8d, %r8d
+	.p2align	4, 0x90
+Lnested_2:
+	cmpl	%edi, %esi
+	jge	Lnested_15
+Lnested_9:
+	movq	%rsi, %r9
+	movq	%r8, %r10
+	.p2align	4, 0x90
+Lnested_6:
+	movl	%r9d, %ebx
+	subl	%esi, %ebx
+	cmpl	$2, %ebx
+	jg	Lnested_11
+Lnested_10:
+	movl	%esi, %ebx
+	imull	%r9d, %ebx
+	addl	%r10d, %ebx
+Lnested_7:
+	addl	$1, %r9d
+	cmpl	%edi, %r9d
+	jge	Lnested_12
+Lnested_17:
+	movq	%rbx, %r10
+	jmp	Lnested_6
+Lnested_12:
+	movq	%rbx, %r9
+Lnested_8:
+Lnested_3:
+	movl	%esi, %ebx
+	addl	$1, %ebx
+	cmpl	%edi, %ebx
+	jge	Lnested_4
+Lnested_16:
+	movq	%rbx, %rsi
+	movq	%r9, %r8
+	jmp	Lnested_2
+Lnested_4:
+	movl	%r9d, %eax
+	popq	%rbx
+	retq
+Lnested_14:
+	xorl	%r9d, %r9d
+	jmp	Lnested_4
+Lnested_15:
+	movq	%r8, %r9
+	jmp	Lnested_8
+Lnested_11:
+	movq	%r10, %r9
+	jmp	Lnested_8
+	.globl	_fill_table
+	.p2align	4, 0x90
+_fill_table:
+	pushq	%rbx
+	pushq	%r12
+	subq	$328, %rsp
+Lfill_table_5:
+	xorl	%esi, %esi
+	leaq	8(%rsp), %r8
+	.p2align	4, 0x90
+Lfill_table_2:
+Lfill_table_9:
+	movl	%esi, %r9d
+	imull	%edi, %r9d
+	xorl	%r10d, %r10d
+	movq	%r8, %rbx
+	.p2align	4, 0x90
+Lfill_table_6:
+	movl	%r9d, %r12d
+	addl	%r10d, %r12d
+	movl	%r12d, (%rbx)
+Lfill_table_7:
+	addl	$1, %r10d
+	addq	$4, %rbx
+	cmpl	$10, %r10d
+	jl	Lfill_table_6
+Lfill_table_3:
+	addl	$1, %esi
+	addq	$40, %r8
+	cmpl	$8, %esi
+	jl	Lfill_table_2
+Lfill_table_15:
+	xorl	%esi, %esi
+	leaq	8(%rsp), %r8
+	xorl	%edi, %edi
+	.p2align	4, 0x90
+Lfill_table_12:
+Lfill_table_19:
+Lfill_table_23:
+	pxor	%xmm0, %xmm0
+	xorl	%r9d, %r9d
+	movq	%r8, %r10
+	.p2align	4, 0x90
+Lfill_table_24:
+	movdqu	(%r10), %xmm1
+	paddd	%xmm1, %xmm0
+	addq	$4, %r9
+	addq	$16, %r10
+	cmpq	$6, %r9
+	jl	Lfill_table_24
+Lfill_table_25:
+	movdqa	%xmm0, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %r10d
+	addl	%r10d, %edi
+Lfill_table_22:
+	movslq	%r9d, %r10
+	shlq	$2, %r10
+	addq	%r8, %r10
+	.p2align	4, 0x90
+Lfill_table_16:
+	movl	(%r10), %ebx
+	addl	%ebx, %edi
+Lfill_table_17:
+	addl	$1, %r9d
+	addq	$4, %r10
+	cmpl	$10, %r9d
+	jl	Lfill_table_16
+Lfill_table_13:
+	addl	$1, %esi
+	addq	$40, %r8
+	cmpl	$8, %esi
+	jl	Lfill_table_12
+Lfill_table_14:
+	movl	324(%rsp), %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	addq	$328, %rsp
+	popq	%r12
+	popq	%rbx
+	retq
+	.globl	_invariant_math
+	.p2align	4, 0x90
+_invariant_math:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	movq	%rdx, %r8
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Linvariant_math_4
+Linvariant_math_5:
+	movl	%esi, %r9d
+	imull	%r8d, %r9d
+	leal	3(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$2, %eax
+	movl	%eax, %r10d
+	addl	%r10d, %r9d
+	xorl	%r10d, %r10d
+	leaq	-64(%rsp), %rbx
+	.p2align	4, 0x90
+Linvariant_math_2:
+	movl	%r9d, %r12d
+	addl	%r10d, %r12d
+	movl	%r12d, (%rbx)
+Linvariant_math_3:
+	addl	$1, %r10d
+	addq	$4, %rbx
+	cmpl	%edi, %r10d
+	jl	Linvariant_math_2
+Linvariant_math_4:
+	movl	%edi, %r9d
+	subl	$1, %r9d
+	cmpl	$0, %r9d
+	jl	Linvariant_math_14
+Linvariant_math_10:
+	movl	%esi, %r10d
+	imull	%r8d, %r10d
+	leal	3(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$2, %eax
+	movl	%eax, %ebx
+	addl	%ebx, %r10d
+	movslq	%r9d, %rbx
+	shlq	$2, %rbx
+	leaq	-64(%rsp), %rax
+	addq	%rax, %rbx
+	movq	%rbx, %r12
+	xorl	%ebx, %ebx
+	.p2align	4, 0x90
+Linvariant_math_7:
+	movl	(%r12), %r13d
+	subl	%r10d, %r13d
+	addl	%r13d, %ebx
+Linvariant_math_8:
+	subl	$1, %r9d
+	addq	$-4, %r12
+	cmpl	$0, %r9d
+	jge	Linvariant_math_7
+Linvariant_math_9:
+	movl	%ebx, %eax
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+Linvariant_math_14:
+	xorl	%ebx, %ebx
+	jmp	Linvariant_math_9
+	.globl	_invariant_load
+	.p2align	4, 0x90
+_invariant_load:
+	pushq	%rbx
+	movl	$3, -8(%rsp)
+	movl	$7, -4(%rsp)
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Linvariant_load_7
+Linvariant_load_5:
+	movl	-4(%rsp), %esi
+	movl	-8(%rsp), %r8d
+	xorl	%r9d, %r9d
+	xorl	%r10d, %r10d
+	.p2align	4, 0x90
+Linvariant_load_2:
+	movl	%esi, %ebx
+	imull	%r9d, %ebx
+	addl	%r8d, %ebx
+	addl	%ebx, %r10d
+	addl	$2, %r9d
+Linvariant_load_3:
+	cmpl	%edi, %r9d
+	jl	Linvariant_load_2
+Linvariant_load_4:
+	movl	%r10d, %eax
+	popq	%rbx
+	retq
+Linvariant_load_7:
+	xorl	%r10d, %r10d
+	jmp	Linvariant_load_4
+	.globl	_empty_bodies
+	.p2align	4, 0x90
+_empty_bodies:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lempty_bodies_12
+Lempty_bodies_5:
+	xorl	%esi, %esi
+	.p2align	4, 0x90
+Lempty_bodies_2:
+Lempty_bodies_3:
+	addl	$1, %esi
+	cmpl	%edi, %esi
+	jl	Lempty_bodies_2
+Lempty_bodies_4:
+	movl	%edi, %r8d
+	addl	$5, %r8d
+	.p2align	4, 0x90
+Lempty_bodies_7:
+	cmpl	%r8d, %esi
+	jge	Lempty_bodies_9
+Lempty_bodies_10:
+	movl	%esi, %r9d
+	addl	$1, %r9d
+Lempty_bodies_8:
+	movq	%r9, %rsi
+	jmp	Lempty_bodies_7
+Lempty_bodies_12:
+	xorl	%esi, %esi
+	jmp	Lempty_bodies_4
+Lempty_bodies_9:
+	movl	%esi, %eax
+	retq
+	.globl	_unreachable_loop
+	.p2align	4, 0x90
+_unreachable_loop:
+Lunreachable_loop_2:
+	movl	%edi, %eax
+	retq
@@ -0,0 +1,5 @@
+	.globl	_f
+	.p2align	4, 0x90
+_f:
+	movl	$2, %eax
+	retq
@@ -0,0 +1,37 @@
+static int mix(int x, int k) {
+  int a = x * k + 3;
+  int b = a * a - x;
+  int c = b / 7 + a * 5;
+  if (c > 100000)
+    c = c / 3;
+  return c + b * 2 - a;
+}
+
+int classify(int x) {
+  if (x > 1000)
+    return x / 1000 + mix(x, 3);
+  return x + 1;
+}
+
+int dispatch(int op, int x) {
+  switch (op) {
+    case 1: return x + 1;
+    case 2: return x - 1;
+    case 3: return x * 2;
+    case 4: return x * 3;
+    case 5: return x + 5;
+  }
+  return 0;
+}
+
+int never_called(int x) {
+  return mix(x, x) + dispatch(x, x);
+}
+
+int run(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += classify(i) + dispatch(i < 12 ? i / 2 : 5, i) + mix(i, 2) / 64;
+  }
+  return sum;
+}
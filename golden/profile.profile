@@ -0,0 +1,5 @@
+mix f27935636a21a0a1 3 2000 2000 1591
+classify f734354543d13c62 3 1502 1002 500
+dispatch 2c862e15a5762442 8 1503 1503 3 2 2 3 2 1491
+never_called 261c4b49872994e7 1 0
+run f2d8a4fba3333a4d 9 2 1500 1500 2 1 1488 1500 12 1
@@ -0,0 +1,20 @@
+#include <stdio.h>
+
+extern int classify(int x);
+extern int dispatch(int op, int x);
+extern int never_called(int x);
+extern int run(int n);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(classify(5));
+  print_expr(classify(5000));
+  print_expr(dispatch(0, 7));
+  print_expr(dispatch(3, 7));
+  print_expr(dispatch(5, 7));
+  print_expr(run(0));
+  print_expr(run(1500));
+  print_expr(argc > 1 ? never_called(3) : 0);
+  return 0;
+}
@@ -0,0 +1,290 @@
+	.section	__TEXT,__text_hot,regular,pure_instructions
+	.p2align	4, 0x90
+_mix:
+	imull	%edi, %esi
+	addl	$3, %esi
+	movl	%esi, %r8d
+	imull	%esi, %r8d
+	movl	%r8d, %r11d
+	subl	%edi, %r11d
+	movl	%r11d, %edi
+	movl	$-1840700269, %eax
+	imull	%edi
+	addl	%edi, %edx
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r8d
+	movl	%esi, %r9d
+	leal	(%r9,%r9,4), %r9d
+	addl	%r9d, %r8d
+	cmpl	$100000, %r8d
+	jle	Lmix_4
+Lmix_3:
+	movl	$1431655766, %eax
+	imull	%r8d
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r9d
+Lmix_2:
+	movl	%edi, %r10d
+	shll	$1, %r10d
+	addl	%r10d, %r9d
+	subl	%esi, %r9d
+	movl	%r9d, %eax
+	retq
+Lmix_4:
+	movq	%r8, %r9
+	jmp	Lmix_2
+	.text
+	.section	__TEXT,__text_hot,regular,pure_instructions
+	.globl	_dispatch
+	.p2align	4, 0x90
+_dispatch:
+Ldispatch_2:
+	movl	%edi, %eax
+	cmpl	$5, %eax
+	je	Ldispatch_8
+	subl	$1, %eax
+	cmpl	$4, %eax
+	ja	Ldispatch_3
+	leaq	LSW_dispatch_2_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+LSW_dispatch_2_table:
+	.long	Ldispatch_4-LSW_dispatch_2_table
+	.long	Ldispatch_5-LSW_dispatch_2_table
+	.long	Ldispatch_6-LSW_dispatch_2_table
+	.long	Ldispatch_7-LSW_dispatch_2_table
+	.long	Ldispatch_8-LSW_dispatch_2_table
+	.text
+	.section	__TEXT,__text_hot,regular,pure_instructions
+Ldispatch_8:
+	movl	%esi, %edi
+	addl	$5, %edi
+	movl	%edi, %eax
+	retq
+Ldispatch_3:
+	xorl	%eax, %eax
+	retq
+Ldispatch_7:
+	movl	%esi, %edi
+	leal	(%rdi,%rdi,2), %edi
+	movl	%edi, %eax
+	retq
+Ldispatch_6:
+	movl	%esi, %edi
+	shll	$1, %edi
+	movl	%edi, %eax
+	retq
+Ldispatch_5:
+	movl	%esi, %edi
+	subl	$1, %edi
+	movl	%edi, %eax
+	retq
+Ldispatch_4:
+	addl	$1, %esi
+	movl	%esi, %eax
+	retq
+	.text
+	.section	__TEXT,__text_hot,regular,pure_instructions
+	.globl	_classify
+	.p2align	4, 0x90
+_classify:
+	pushq	%rbx
+	cmpl	$1000, %edi
+	jg	Lclassify_3
+Lclassify_2:
+	movl	%edi, %esi
+	addl	$1, %esi
+	movl	%esi, %eax
+	popq	%rbx
+	retq
+Lclassify_3:
+	movl	$274877907, %eax
+	imull	%edi
+	sarl	$6, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %esi
+Lclassify_5:
+	movl	%edi, %r8d
+	leal	(%r8,%r8,2), %r8d
+	addl	$3, %r8d
+	movl	%r8d, %r9d
+	imull	%r8d, %r9d
+	movl	%r9d, %r11d
+	subl	%edi, %r11d
+	movl	%r11d, %edi
+	movl	$-1840700269, %eax
+	imull	%edi
+	addl	%edi, %edx
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r9d
+	movl	%r8d, %r10d
+	leal	(%r10,%r10,4), %r10d
+	addl	%r10d, %r9d
+	cmpl	$100000, %r9d
+	jle	Lclassify_8
+Lclassify_6:
+	movl	$1431655766, %eax
+	imull	%r9d
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r10d
+Lclassify_7:
+	movl	%edi, %ebx
+	shll	$1, %ebx
+	addl	%ebx, %r10d
+	subl	%r8d, %r10d
+Lclassify_4:
+	addl	%esi, %r10d
+	movl	%r10d, %eax
+	popq	%rbx
+	retq
+Lclassify_8:
+	movq	%r9, %r10
+	jmp	Lclassify_7
+	.text
+	.section	__TEXT,__text_hot,regular,pure_instructions
+	.globl	_run
+	.p2align	4, 0x90
+_run:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	pushq	%r15
+	subq	$8, %rsp
+	movq	%rdi, %rbx
+	xorl	%r11d, %r11d
+	cmpl	%ebx, %r11d
+	jge	Lrun_14
+Lrun_5:
+	xorl	%r12d, %r12d
+	xorl	%r13d, %r13d
+	.p2align	4, 0x90
+Lrun_2:
+	movq	%r12, %rdi
+	callq	_classify
+	movl	%eax, %r8d
+	cmpl	$12, %r12d
+	jl	Lrun_8
+Lrun_6:
+	movq	$5, %rsi
+Lrun_7:
+	movq	%rsi, %rdi
+	movq	%r12, %rsi
+	callq	_dispatch
+	movl	%eax, %esi
+	addl	%r8d, %esi
+Lrun_11:
+	movl	%r12d, %edi
+	shll	$1, %edi
+	addl	$3, %edi
+	movl	%edi, %r9d
+	imull	%edi, %r9d
+	subl	%r12d, %r9d
+	movl	$-1840700269, %eax
+	imull	%r9d
+	addl	%r9d, %edx
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r10d
+	movl	%edi, %r14d
+	leal	(%r14,%r14,4), %r14d
+	addl	%r14d, %r10d
+	cmpl	$100000, %r10d
+	jle	Lrun_16
+Lrun_12:
+	movl	$1431655766, %eax
+	imull	%r10d
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r14d
+Lrun_13:
+	movl	%r9d, %r15d
+	shll	$1, %r15d
+	addl	%r15d, %r14d
+	subl	%edi, %r14d
+Lrun_10:
+	leal	63(%r14), %eax
+	testl	%r14d, %r14d
+	cmovnsl	%r14d, %eax
+	sarl	$6, %eax
+	movl	%eax, %r14d
+	addl	%esi, %r14d
+	addl	%r13d, %r14d
+Lrun_3:
+	movl	%r12d, %r15d
+	addl	$1, %r15d
+	cmpl	%ebx, %r15d
+	jge	Lrun_4
+Lrun_15:
+	movq	%r15, %r12
+	movq	%r14, %r13
+	jmp	Lrun_2
+Lrun_4:
+	movl	%r14d, %eax
+	leaq	-40(%rbp), %rsp
+	popq	%r15
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	retq
+Lrun_14:
+	xorl	%r14d, %r14d
+	jmp	Lrun_4
+Lrun_8:
+	leal	1(%r12), %eax
+	testl	%r12d, %r12d
+	cmovnsl	%r12d, %eax
+	sarl	$1, %eax
+	movl	%eax, %r14d
+	movq	%r14, %rsi
+	jmp	Lrun_7
+Lrun_16:
+	movq	%r10, %r14
+	jmp	Lrun_13
+	.text
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+	.globl	_never_called
+	.p2align	4, 0x90
+_never_called:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	pushq	%rbx
+	subq	$8, %rsp
+	movq	%rdi, %rbx
+	movq	%rbx, %rdi
+	movq	%rbx, %rsi
+	callq	_mix
+	movl	%eax, %r8d
+	movq	%rbx, %rdi
+	movq	%rbx, %rsi
+	callq	_dispatch
+	movl	%eax, %esi
+	addl	%r8d, %esi
+	movl	%esi, %eax
+	leaq	-8(%rbp), %rsp
+	popq	%rbx
+	popq	%rbp
+	retq
+	.text
@@ -0,0 +1,21 @@
+int pressure(int a, int b, int c, int d) {
+  int t0 = a + b;
+  int t1 = a - c;
+  int t2 = b * d;
+  int t3 = c + d;
+  int t4 = t0 * 3;
+  int t5 = t1 + t2;
+  int t6 = t2 - t3;
+  int t7 = a * a;
+  int t8 = b * b;
+  int t9 = c * c;
+  int t10 = d * d;
+  int t11 = t7 + t8;
+  int t12 = t9 - t10;
+  int t13 = t4 / (d + 1);
+  long wide = t5;
+  wide *= 100000;
+  wide = wide % 999983;
+  t0 += t13;
+  return t0 + t1 + t2 + t3 + t4 + t5 + t6 + t7 + t8 + t9 + t10 + t11 + t12 + t13 + wide + a + b + c + d;
+}
@@ -0,0 +1,11 @@
+#include <stdio.h>
+
+extern int pressure();
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(pressure(1, 2, 3, 4));
+  print_expr(pressure(-7, 11, 5, 9));
+  print_expr(pressure(1000, -3000, 77, 2));
+}
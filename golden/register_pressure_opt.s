@@ -0,0 +1,90 @@
+	.globl	_pressure
+	.p2align	4, 0x90
+_pressure:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	pushq	%r15
+	movq	%rdi, -32(%rsp)
+	movq	%rcx, -8(%rsp)
+	movq	%rdx, -16(%rsp)
+	movq	%rsi, -24(%rsp)
+	movl	-32(%rsp), %r10d
+	addl	-24(%rsp), %r10d
+	movl	-32(%rsp), %ebx
+	subl	-16(%rsp), %ebx
+	movl	-24(%rsp), %r12d
+	imull	-8(%rsp), %r12d
+	movl	-16(%rsp), %r13d
+	addl	-8(%rsp), %r13d
+	movl	%r10d, %r14d
+	leal	(%r14,%r14,2), %r14d
+	movl	%ebx, %r15d
+	addl	%r12d, %r15d
+	movl	%r12d, %r9d
+	subl	%r13d, %r9d
+	movl	-32(%rsp), %r8d
+	imull	-32(%rsp), %r8d
+	movl	-24(%rsp), %esi
+	imull	-24(%rsp), %esi
+	movl	-16(%rsp), %r11d
+	imull	-16(%rsp), %r11d
+	movl	%r11d, -64(%rsp)
+	movl	-8(%rsp), %r11d
+	imull	-8(%rsp), %r11d
+	movl	%r11d, -40(%rsp)
+	movl	%r8d, %r11d
+	addl	%esi, %r11d
+	movl	%r11d, -48(%rsp)
+	movl	-64(%rsp), %r11d
+	subl	-40(%rsp), %r11d
+	movl	%r11d, -56(%rsp)
+	movl	-8(%rsp), %edi
+	addl	$1, %edi
+	movl	%r14d, %eax
+	cltd
+	idivl	%edi
+	movl	%eax, -72(%rsp)
+	movslq	%r15d, %rdi
+	imulq	$100000, %rdi
+	movabsq	$-8775173100085966617, %rax
+	imulq	%rdi
+	addq	%rdi, %rdx
+	sarq	$19, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$999983, %rdx, %rdx
+	subq	%rdx, %rdi
+	addl	-72(%rsp), %r10d
+	addl	%ebx, %r10d
+	addl	%r12d, %r10d
+	addl	%r13d, %r10d
+	addl	%r14d, %r10d
+	addl	%r15d, %r10d
+	addl	%r10d, %r9d
+	addl	%r9d, %r8d
+	addl	%r8d, %esi
+	addl	-64(%rsp), %esi
+	addl	-40(%rsp), %esi
+	addl	-48(%rsp), %esi
+	addl	-56(%rsp), %esi
+	addl	-72(%rsp), %esi
+	movslq	%esi, %rsi
+	addq	%rdi, %rsi
+	movslq	-32(%rsp), %rdi
+	addq	%rdi, %rsi
+	movslq	-24(%rsp), %rdi
+	addq	%rdi, %rsi
+	movslq	-16(%rsp), %rdi
+	addq	%rdi, %rsi
+	movslq	-8(%rsp), %rdi
+	addq	%rdi, %rsi
+	movl	%esi, %eax
+	popq	%r15
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
@@ -0,0 +1,68 @@
+int max(int a, int b) {
+  return a > b ? a : b;
+}
+
+int clamp(int x, int lo, int hi) {
+  return x < lo ? lo : x > hi ? hi : x;
+}
+
+int abs_diff(int a, int b) {
+  int d;
+  if (a > b)
+    d = a - b;
+  else
+    d = b - a;
+  return d;
+}
+
+long sign_or_value(int x, long y) {
+  return x < 0 ? -1 : x == 0 ? 0 : y;
+}
+
+long widened(int c, int a, long b) {
+  return c ? a : b;
+}
+
+int clipped_sum(int n, int lo, int hi) {
+  int samples[64];
+  for (int i = 0; i < 64; i++) {
+    samples[i] = i * 37 - i * 37 / 101 * 101 - 50;
+  }
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    int s = samples[i];
+    sum += s < lo ? lo : s > hi ? hi : s;
+  }
+  return sum;
+}
+
+int count_above(int n, int threshold) {
+  int samples[64];
+  for (int i = 0; i < 64; i++) {
+    samples[i] = i * 29 - i * 29 / 97 * 97 - 48;
+  }
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    if (samples[i] > threshold)
+      count++;
+  }
+  return count;
+}
+
+double larger(double a, double b) {
+  return a > b ? a : b;
+}
+
+int checked_divide(int a, int b) {
+  return b != 0 ? a / b : 0;
+}
+
+static int pick(int c, int a, int b, int d) {
+  int x = c < 0 ? a : b;
+  int y = c < 0 ? a : d;
+  return x * 100 + y;
+}
+
+int pick_inlined(int c, int a, int b, int d) {
+  return pick(c, a, b, d);
+}
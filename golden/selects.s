@@ -0,0 +1,461 @@
+	.globl	_max
+	.p2align	4, 0x90
+_max:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/selects.c:2
+	movl	%edi, %esi		# %esi = a
+	cmpl	-8(%rbp), %esi		# %esi = a > b
+	jle	Lmax_0
+# alloc ?: (4 bytes) at -12(%rbp)
+	movl	-4(%rbp), %esi		# %esi = a
+	movl	%esi, -12(%rbp)		# ?: = %esi
+	jmp	Lmax_1
+Lmax_0:
+	movl	-8(%rbp), %esi		# %esi = b
+	movl	%esi, -12(%rbp)		# ?: = %esi
+Lmax_1:
+	movl	-12(%rbp), %eax		# %eax = ?:
+	leave
+	retq
+	.globl	_clamp
+	.p2align	4, 0x90
+_clamp:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc lo (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc hi (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/selects.c:6
+	movl	%edi, %esi		# %esi = x
+	cmpl	-8(%rbp), %esi		# %esi = x < lo
+	jge	Lclamp_0
+# alloc ?: (4 bytes) at -16(%rbp)
+	movl	-8(%rbp), %esi		# %esi = lo
+	movl	%esi, -16(%rbp)		# ?: = %esi
+	jmp	Lclamp_1
+Lclamp_0:
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	-12(%rbp), %esi		# %esi = x > hi
+	jle	Lclamp_2
+# alloc ?: (4 bytes) at -20(%rbp)
+	movl	-12(%rbp), %esi		# %esi = hi
+	movl	%esi, -20(%rbp)		# ?: = %esi
+	jmp	Lclamp_3
+Lclamp_2:
+	movl	-4(%rbp), %esi		# %esi = x
+	movl	%esi, -20(%rbp)		# ?: = %esi
+Lclamp_3:
+	movl	-20(%rbp), %esi		# %esi = ?:
+	movl	%esi, -16(%rbp)		# ?: = %esi
+Lclamp_1:
+	movl	-16(%rbp), %eax		# %eax = ?:
+	leave
+	retq
+	.globl	_abs_diff
+	.p2align	4, 0x90
+_abs_diff:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/selects.c:10
+# alloc d (4 bytes) at -12(%rbp)
+# golden/selects.c:11
+	movl	%edi, %esi		# %esi = a
+	cmpl	-8(%rbp), %esi		# %esi = a > b
+	jle	Labs_diff_0
+	movl	-4(%rbp), %esi		# %esi = a
+	subl	-8(%rbp), %esi		# %esi = a - b
+	movl	%esi, -12(%rbp)		# d = %esi
+	jmp	Labs_diff_1
+Labs_diff_0:
+	movl	-8(%rbp), %esi		# %esi = b
+	subl	-4(%rbp), %esi		# %esi = b - a
+	movl	%esi, -12(%rbp)		# d = %esi
+Labs_diff_1:
+# golden/selects.c:15
+	movl	-12(%rbp), %eax		# %eax = d
+	leave
+	retq
+	.globl	_sign_or_value
+	.p2align	4, 0x90
+_sign_or_value:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc y (8 bytes) at -16(%rbp)
+	movq	%rsi, -16(%rbp)
+# golden/selects.c:19
+	movl	%edi, %esi		# %esi = x
+	cmpl	$0, %esi		# %esi = x < $0
+	jge	Lsign_or_value_0
+# alloc ?: (4 bytes) at -20(%rbp)
+	movl	$-1, -20(%rbp)		# ?: = $-1
+	jmp	Lsign_or_value_1
+Lsign_or_value_0:
+	movl	-4(%rbp), %esi		# %esi = x
+	cmpl	$0, %esi		# %esi = x == $0
+	jne	Lsign_or_value_2
+# alloc ?: (4 bytes) at -24(%rbp)
+	movl	$0, -24(%rbp)		# ?: = $0
+	jmp	Lsign_or_value_3
+Lsign_or_value_2:
+# alloc ?: (8 bytes) at -32(%rbp)
+	movq	-16(%rbp), %rsi		# %rsi = y
+	movq	%rsi, -32(%rbp)		# ?: = %rsi
+	jmp	Lsign_or_value_4
+Lsign_or_value_3:
+	movslq	-24(%rbp), %rsi		# (long) ?:
+	movq	%rsi, -32(%rbp)		# ?: = %rsi
+Lsign_or_value_4:
+# alloc ?: (8 bytes) at -40(%rbp)
+	movq	-32(%rbp), %rsi		# %rsi = ?:
+	movq	%rsi, -40(%rbp)		# ?: = %rsi
+	jmp	Lsign_or_value_5
+Lsign_or_value_1:
+	movslq	-20(%rbp), %rsi		# (long) ?:
+	movq	%rsi, -40(%rbp)		# ?: = %rsi
+Lsign_or_value_5:
+	movq	-40(%rbp), %rax		# %rax = ?:
+	leave
+	retq
+	.globl	_widened
+	.p2align	4, 0x90
+_widened:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc c (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc a (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movq	%rdx, -16(%rbp)
+# golden/selects.c:23
+	cmpl	$0, -4(%rbp)		# c
+	je	Lwidened_0
+# alloc ?: (4 bytes) at -20(%rbp)
+	movl	-8(%rbp), %esi		# %esi = a
+	movl	%esi, -20(%rbp)		# ?: = %esi
+	jmp	Lwidened_1
+Lwidened_0:
+# alloc ?: (8 bytes) at -32(%rbp)
+	movq	-16(%rbp), %rsi		# %rsi = b
+	movq	%rsi, -32(%rbp)		# ?: = %rsi
+	jmp	Lwidened_2
+Lwidened_1:
+	movslq	-20(%rbp), %rsi		# (long) ?:
+	movq	%rsi, -32(%rbp)		# ?: = %rsi
+Lwidened_2:
+	movq	-32(%rbp), %rax		# %rax = ?:
+	leave
+	retq
+	.globl	_clipped_sum
+	.p2align	4, 0x90
+_clipped_sum:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$304, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc lo (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc hi (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/selects.c:27
+# alloc samples (256 bytes) at -268(%rbp)
+# golden/selects.c:28
+# alloc i (4 bytes) at -272(%rbp)
+	movl	$0, -272(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	$64, %esi		# %esi = i < $64
+	jge	Lclipped_sum_2
+Lclipped_sum_0:
+# golden/selects.c:29
+	movl	-272(%rbp), %esi		# %esi = i
+	imull	$37, %esi		# %esi = i * $37
+	movl	-272(%rbp), %edi		# %edi = i
+	imull	$37, %edi		# %edi = i * $37
+	# %edi = %edi / $101
+	movl	$680390859, %eax
+	imull	%edi
+	sarl	$4, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	imull	$101, %edi		# %edi = %edi * $101
+	subl	%edi, %esi		# %esi = %esi - %edi
+	subl	$50, %esi		# %esi = %esi - $50
+	movslq	-272(%rbp), %rcx
+	movl	%esi, -268(%rbp,%rcx,4)		# samples[i] = %esi
+Lclipped_sum_1:
+	movl	-272(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -272(%rbp)		# i = %esi
+	cmpl	$64, %esi		# %esi = i < $64
+	jl	Lclipped_sum_0
+Lclipped_sum_2:
+# golden/selects.c:31
+# alloc sum (4 bytes) at -276(%rbp)
+	movl	$0, -276(%rbp)		# sum = $0
+# golden/selects.c:32
+# alloc i (4 bytes) at -280(%rbp)
+	movl	$0, -280(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lclipped_sum_5
+Lclipped_sum_3:
+# golden/selects.c:33
+# alloc s (4 bytes) at -284(%rbp)
+	movslq	-280(%rbp), %rcx
+	movl	-268(%rbp,%rcx,4), %esi		# %esi = samples[i]
+	movl	%esi, -284(%rbp)		# s = %esi
+# golden/selects.c:34
+	cmpl	-8(%rbp), %esi		# %esi = s < lo
+	jge	Lclipped_sum_6
+# alloc ?: (4 bytes) at -288(%rbp)
+	movl	-8(%rbp), %esi		# %esi = lo
+	movl	%esi, -288(%rbp)		# ?: = %esi
+	jmp	Lclipped_sum_7
+Lclipped_sum_6:
+	movl	-284(%rbp), %esi		# %esi = s
+	cmpl	-12(%rbp), %esi		# %esi = s > hi
+	jle	Lclipped_sum_8
+# alloc ?: (4 bytes) at -292(%rbp)
+	movl	-12(%rbp), %esi		# %esi = hi
+	movl	%esi, -292(%rbp)		# ?: = %esi
+	jmp	Lclipped_sum_9
+Lclipped_sum_8:
+	movl	-284(%rbp), %esi		# %esi = s
+	movl	%esi, -292(%rbp)		# ?: = %esi
+Lclipped_sum_9:
+	movl	-292(%rbp), %esi		# %esi = ?:
+	movl	%esi, -288(%rbp)		# ?: = %esi
+Lclipped_sum_7:
+	movl	-276(%rbp), %esi		# %esi = sum
+	addl	-288(%rbp), %esi		# %esi = sum + ?:
+	movl	%esi, -276(%rbp)		# sum = %esi
+Lclipped_sum_4:
+	movl	-280(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -280(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lclipped_sum_3
+Lclipped_sum_5:
+# golden/selects.c:36
+	movl	-276(%rbp), %eax		# %eax = sum
+	leave
+	retq
+	.globl	_count_above
+	.p2align	4, 0x90
+_count_above:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$288, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc threshold (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/selects.c:40
+# alloc samples (256 bytes) at -264(%rbp)
+# golden/selects.c:41
+# alloc i (4 bytes) at -268(%rbp)
+	movl	$0, -268(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	$64, %esi		# %esi = i < $64
+	jge	Lcount_above_2
+Lcount_above_0:
+# golden/selects.c:42
+	movl	-268(%rbp), %esi		# %esi = i
+	imull	$29, %esi		# %esi = i * $29
+	movl	-268(%rbp), %edi		# %edi = i
+	imull	$29, %edi		# %edi = i * $29
+	# %edi = %edi / $97
+	movl	$354224107, %eax
+	imull	%edi
+	sarl	$3, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	imull	$97, %edi		# %edi = %edi * $97
+	subl	%edi, %esi		# %esi = %esi - %edi
+	subl	$48, %esi		# %esi = %esi - $48
+	movslq	-268(%rbp), %rcx
+	movl	%esi, -264(%rbp,%rcx,4)		# samples[i] = %esi
+Lcount_above_1:
+	movl	-268(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -268(%rbp)		# i = %esi
+	cmpl	$64, %esi		# %esi = i < $64
+	jl	Lcount_above_0
+Lcount_above_2:
+# golden/selects.c:44
+# alloc count (4 bytes) at -272(%rbp)
+	movl	$0, -272(%rbp)		# count = $0
+# golden/selects.c:45
+# alloc i (4 bytes) at -276(%rbp)
+	movl	$0, -276(%rbp)		# i = $0
+	movl	$0, %esi		# %esi = i
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jge	Lcount_above_5
+Lcount_above_3:
+# golden/selects.c:46
+	movslq	-276(%rbp), %rcx
+	movl	-264(%rbp,%rcx,4), %esi		# %esi = samples[i]
+	cmpl	-8(%rbp), %esi		# %esi = samples[i] > threshold
+	jle	Lcount_above_6
+	movl	-272(%rbp), %esi		# %esi = count
+	addl	$1, %esi		# %esi = count + $1
+	movl	%esi, -272(%rbp)		# count = %esi
+Lcount_above_6:
+Lcount_above_4:
+	movl	-276(%rbp), %esi		# %esi = i
+	addl	$1, %esi		# %esi = i + $1
+	movl	%esi, -276(%rbp)		# i = %esi
+	cmpl	-4(%rbp), %esi		# %esi = i < n
+	jl	Lcount_above_3
+Lcount_above_5:
+# golden/selects.c:49
+	movl	-272(%rbp), %eax		# %eax = count
+	leave
+	retq
+	.globl	_larger
+	.p2align	4, 0x90
+_larger:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc a (8 bytes) at -8(%rbp)
+	movsd	%xmm0, -8(%rbp)
+# alloc b (8 bytes) at -16(%rbp)
+	movsd	%xmm1, -16(%rbp)
+# golden/selects.c:53
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	ucomisd	-16(%rbp), %xmm8		# %xmm8 = a > b
+	jbe	Llarger_0
+# alloc ?: (8 bytes) at -24(%rbp)
+	movsd	-8(%rbp), %xmm8		# %xmm8 = a
+	movsd	%xmm8, -24(%rbp)		# ?: = %xmm8
+	jmp	Llarger_1
+Llarger_0:
+	movsd	-16(%rbp), %xmm8		# %xmm8 = b
+	movsd	%xmm8, -24(%rbp)		# ?: = %xmm8
+Llarger_1:
+	movsd	-24(%rbp), %xmm0		# %xmm0 = ?:
+	leave
+	retq
+	.globl	_checked_divide
+	.p2align	4, 0x90
+_checked_divide:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/selects.c:57
+	cmpl	$0, %esi		# %esi = b != $0
+	je	Lchecked_divide_0
+# alloc ?: (4 bytes) at -12(%rbp)
+	movl	-4(%rbp), %eax		# %eax = a
+	cdq
+	idivl	-8(%rbp)		# %eax = a / b
+	movl	%eax, %esi
+	movl	%esi, -12(%rbp)		# ?: = %esi
+	jmp	Lchecked_divide_1
+Lchecked_divide_0:
+	movl	$0, -12(%rbp)		# ?: = $0
+Lchecked_divide_1:
+	movl	-12(%rbp), %eax		# %eax = ?:
+	leave
+	retq
+	.p2align	4, 0x90
+_pick:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc c (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc a (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc b (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# alloc d (4 bytes) at -16(%rbp)
+	movl	%ecx, -16(%rbp)
+# golden/selects.c:61
+# alloc x (4 bytes) at -20(%rbp)
+	movl	%edi, %esi		# %esi = c
+	cmpl	$0, %esi		# %esi = c < $0
+	jge	Lpick_0
+# alloc ?: (4 bytes) at -24(%rbp)
+	movl	-8(%rbp), %esi		# %esi = a
+	movl	%esi, -24(%rbp)		# ?: = %esi
+	jmp	Lpick_1
+Lpick_0:
+	movl	-12(%rbp), %esi		# %esi = b
+	movl	%esi, -24(%rbp)		# ?: = %esi
+Lpick_1:
+	movl	-24(%rbp), %esi		# %esi = ?:
+	movl	%esi, -20(%rbp)		# x = %esi
+# golden/selects.c:62
+# alloc y (4 bytes) at -28(%rbp)
+	movl	-4(%rbp), %esi		# %esi = c
+	cmpl	$0, %esi		# %esi = c < $0
+	jge	Lpick_2
+# alloc ?: (4 bytes) at -32(%rbp)
+	movl	-8(%rbp), %esi		# %esi = a
+	movl	%esi, -32(%rbp)		# ?: = %esi
+	jmp	Lpick_3
+Lpick_2:
+	movl	-16(%rbp), %esi		# %esi = d
+	movl	%esi, -32(%rbp)		# ?: = %esi
+Lpick_3:
+	movl	-32(%rbp), %esi		# %esi = ?:
+	movl	%esi, -28(%rbp)		# y = %esi
+# golden/selects.c:63
+	movl	-20(%rbp), %esi		# %esi = x
+	# %esi = x * $100
+	leal	(%rsi,%rsi,4), %esi
+	leal	(%rsi,%rsi,4), %esi
+	shll	$2, %esi
+	addl	-28(%rbp), %esi		# %esi = %esi + y
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_pick_inlined
+	.p2align	4, 0x90
+_pick_inlined:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc c (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc a (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc b (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# alloc d (4 bytes) at -16(%rbp)
+	movl	%ecx, -16(%rbp)
+# golden/selects.c:67
+	callq	_pick
+# alloc t5 (4 bytes) at -20(%rbp)
+	leave
+	retq
@@ -0,0 +1,38 @@
+#include <stdio.h>
+
+extern int max(int a, int b);
+extern int clamp(int x, int lo, int hi);
+extern int abs_diff(int a, int b);
+extern long sign_or_value(int x, long y);
+extern long widened(int c, int a, long b);
+extern int clipped_sum(int n, int lo, int hi);
+extern int count_above(int n, int threshold);
+extern double larger(double a, double b);
+extern int checked_divide(int a, int b);
+extern int pick_inlined(int c, int a, int b, int d);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(max(3, 7));
+  print_expr(max(-3, -7));
+  print_expr(clamp(5, 0, 10));
+  print_expr(clamp(-5, 0, 10));
+  print_expr(clamp(50, 0, 10));
+  print_expr(abs_diff(3, 10));
+  print_expr(abs_diff(10, 3));
+  print_expr(sign_or_value(-4, 1L << 40));
+  print_expr(sign_or_value(0, 1L << 40));
+  print_expr(sign_or_value(4, 1L << 40));
+  print_expr(widened(1, -5, 1L << 40));
+  print_expr(widened(0, -5, 1L << 40));
+  print_expr(clipped_sum(64, -20, 20));
+  print_expr(clipped_sum(10, 0, 100));
+  print_expr(count_above(64, 0));
+  print_expr(count_above(64, 40));
+  print_expr(larger(1.5, 2.5) * 10);
+  print_expr(checked_divide(17, 5));
+  print_expr(checked_divide(17, 0));
+  print_expr(pick_inlined(1, 2, 3, 4));
+  print_expr(pick_inlined(-1, 2, 3, 4));
+}
@@ -0,0 +1,254 @@
+	.globl	_max
+	.p2align	4, 0x90
+_max:
+	movl	%esi, %edx
+	cmpl	%esi, %edi
+	cmovgl	%edi, %edx
+	movl	%edx, %esi
+Lmax_2:
+	movl	%esi, %eax
+	retq
+	.globl	_clamp
+	.p2align	4, 0x90
+_clamp:
+	movq	%rdx, %r8
+	movl	%edi, %edx
+	cmpl	%r8d, %edi
+	cmovgl	%r8d, %edx
+	movl	%edx, %r8d
+	movl	%r8d, %edx
+	cmpl	%esi, %edi
+	cmovll	%esi, %edx
+	movl	%edx, %esi
+Lclamp_2:
+	movl	%esi, %eax
+	retq
+	.globl	_abs_diff
+	.p2align	4, 0x90
+_abs_diff:
+	movl	%edi, %r8d
+	subl	%esi, %r8d
+	movl	%esi, %r9d
+	subl	%edi, %r9d
+	movl	%r9d, %edx
+	cmpl	%esi, %edi
+	cmovgl	%r8d, %edx
+	movl	%edx, %esi
+Labs_diff_3:
+	movl	%esi, %eax
+	retq
+	.globl	_sign_or_value
+	.p2align	4, 0x90
+_sign_or_value:
+	xorl	%ecx, %ecx
+	cmpl	$0, %edi
+	cmoveq	%rcx, %rsi
+	movq	$-1, %rcx
+	cmpl	$0, %edi
+	cmovlq	%rcx, %rsi
+Lsign_or_value_4:
+	movq	%rsi, %rax
+	retq
+	.globl	_widened
+	.p2align	4, 0x90
+_widened:
+	movq	%rdx, %r8
+	movslq	%esi, %rsi
+	movq	%r8, %rdx
+	testl	%edi, %edi
+	cmovneq	%rsi, %rdx
+	movq	%rdx, %rsi
+Lwidened_4:
+	movq	%rsi, %rax
+	retq
+	.globl	_clipped_sum
+	.p2align	4, 0x90
+_clipped_sum:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	subq	$256, %rsp
+	movq	%rdx, %r8
+Lclipped_sum_5:
+	xorl	%r9d, %r9d
+	leaq	0(%rsp), %r10
+	.p2align	4, 0x90
+Lclipped_sum_2:
+	movl	%r9d, %ebx
+	imull	$37, %ebx
+	movl	$680390859, %eax
+	imull	%ebx
+	sarl	$4, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r12d
+	imull	$101, %r12d
+	subl	%r12d, %ebx
+	subl	$50, %ebx
+	movl	%ebx, (%r10)
+Lclipped_sum_3:
+	addl	$1, %r9d
+	addq	$4, %r10
+	cmpl	$64, %r9d
+	jl	Lclipped_sum_2
+Lclipped_sum_4:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lclipped_sum_15
+Lclipped_sum_10:
+	xorl	%r9d, %r9d
+	leaq	0(%rsp), %rbx
+	xorl	%r10d, %r10d
+	.p2align	4, 0x90
+Lclipped_sum_7:
+	movl	(%rbx), %r12d
+	movl	%r12d, %r13d
+	cmpl	%r8d, %r12d
+	cmovgl	%r8d, %r13d
+	movl	%r13d, %edx
+	cmpl	%esi, %r12d
+	cmovll	%esi, %edx
+	movl	%edx, %r12d
+Lclipped_sum_11:
+	addl	%r12d, %r10d
+Lclipped_sum_8:
+	addl	$1, %r9d
+	addq	$4, %rbx
+	cmpl	%edi, %r9d
+	jl	Lclipped_sum_7
+Lclipped_sum_9:
+	movl	%r10d, %eax
+	addq	$256, %rsp
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+Lclipped_sum_15:
+	xorl	%r10d, %r10d
+	jmp	Lclipped_sum_9
+	.globl	_count_above
+	.p2align	4, 0x90
+_count_above:
+	pushq	%rbx
+	pushq	%r12
+	subq	$264, %rsp
+Lcount_above_5:
+	xorl	%r8d, %r8d
+	leaq	8(%rsp), %r9
+	.p2align	4, 0x90
+Lcount_above_2:
+	movl	%r8d, %r10d
+	imull	$29, %r10d
+	movl	$354224107, %eax
+	imull	%r10d
+	sarl	$3, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %ebx
+	imull	$97, %ebx
+	subl	%ebx, %r10d
+	subl	$48, %r10d
+	movl	%r10d, (%r9)
+Lcount_above_3:
+	addl	$1, %r8d
+	addq	$4, %r9
+	cmpl	$64, %r8d
+	jl	Lcount_above_2
+Lcount_above_4:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lcount_above_15
+Lcount_above_10:
+	xorl	%r8d, %r8d
+	leaq	8(%rsp), %r10
+	xorl	%r9d, %r9d
+	.p2align	4, 0x90
+Lcount_above_7:
+	movl	(%r10), %ebx
+	movl	%r9d, %r12d
+	addl	$1, %r12d
+	cmpl	%esi, %ebx
+	cmovgl	%r12d, %r9d
+Lcount_above_8:
+	addl	$1, %r8d
+	addq	$4, %r10
+	cmpl	%edi, %r8d
+	jl	Lcount_above_7
+Lcount_above_9:
+	movl	%r9d, %eax
+	addq	$264, %rsp
+	popq	%r12
+	popq	%rbx
+	retq
+Lcount_above_15:
+	xorl	%r9d, %r9d
+	jmp	Lcount_above_9
+	.globl	_larger
+	.p2align	4, 0x90
+_larger:
+	ucomisd	%xmm1, %xmm0
+	jbe	Llarger_2
+Llarger_3:
+	retq
+Llarger_2:
+	movaps	%xmm1, %xmm0
+	jmp	Llarger_3
+	.globl	_checked_divide
+	.p2align	4, 0x90
+_checked_divide:
+	cmpl	$0, %esi
+	je	Lchecked_divide_2
+Lchecked_divide_4:
+	movl	%edi, %eax
+	cltd
+	idivl	%esi
+	movl	%eax, %esi
+Lchecked_divide_3:
+	movl	%esi, %eax
+	retq
+Lchecked_divide_2:
+	xorl	%esi, %esi
+	jmp	Lchecked_divide_3
+	.p2align	4, 0x90
+_pick:
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+	cmpl	$0, %edi
+	cmovll	%esi, %r8d
+Lpick_2:
+	movl	%r9d, %edx
+	cmpl	$0, %edi
+	cmovll	%esi, %edx
+	movl	%edx, %esi
+Lpick_4:
+	movl	%r8d, %edi
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$2, %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_pick_inlined
+	.p2align	4, 0x90
+_pick_inlined:
+	movq	%rcx, %r9
+	movq	%rdx, %r8
+Lpick_inlined_3:
+	cmpl	$0, %edi
+	cmovll	%esi, %r8d
+Lpick_inlined_5:
+	movl	%r9d, %edx
+	cmpl	$0, %edi
+	cmovll	%esi, %edx
+	movl	%edx, %esi
+Lpick_inlined_7:
+	movl	%r8d, %edi
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$2, %edi
+	addl	%edi, %esi
+Lpick_inlined_2:
+	movl	%esi, %eax
+	retq
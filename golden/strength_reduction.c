@@ -0,0 +1,43 @@
+int mul_lea(int x) {
+  return x * 3 + x * 10 - x * 24 + x * 45;
+}
+
+int mul_shift(int x) {
+  return x * 17 - x * 31 + x * -8 + x * -5;
+}
+
+int mul_imul(int x) {
+  return x * 11 + x * 4099 + x * -7;
+}
+
+long mul_long(long x) {
+  return x * 40 + x * 1024 + x * 63;
+}
+
+int div_pow2(int x) {
+  return x / 8 + x / -4 + x / 2 + x / 1 - x / 65536;
+}
+
+int div_magic(int x) {
+  return x / 7 + x / 10 + x / -3 + x / 641 + x / 1000000;
+}
+
+unsigned udiv(unsigned x) {
+  return x / 3 + x / 7 + x / 16 + x / 1000 + x / 641;
+}
+
+long ldiv(long x) {
+  return x / 10 + x / 3 + x / -1000 + x / 4096 + x / 7;
+}
+
+unsigned long uldiv(unsigned long x) {
+  return x / 10 + x / 7 + x / 64 + x / 1000000007;
+}
+
+int stride(int i, int j) {
+  int grid[6][3];
+  int cells[4][5][3];
+  grid[i][j] = i * 7 + j;
+  cells[j][i][2] = grid[i][j] * 9;
+  return grid[i][j] + cells[j][i][2];
+}
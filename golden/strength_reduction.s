@@ -0,0 +1,441 @@
+	.globl	_mul_lea
+	.p2align	4, 0x90
+_mul_lea:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/strength_reduction.c:2
+	movl	%edi, %esi		# %esi = x
+	# %esi = x * $3
+	leal	(%rsi,%rsi,2), %esi
+	# %edi = x * $10
+	leal	(%rdi,%rdi,4), %edi
+	shll	$1, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x * $45
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,8), %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_mul_shift
+	.p2align	4, 0x90
+_mul_shift:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/strength_reduction.c:6
+	movl	%edi, %esi		# %esi = x
+	# %esi = x * $17
+	movl	%esi, %eax
+	shll	$4, %esi
+	addl	%eax, %esi
+	# %edi = x * $31
+	movl	%edi, %eax
+	shll	$5, %edi
+	subl	%eax, %edi
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x * $-8
+	shll	$3, %edi
+	negl	%edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x * $-5
+	leal	(%rdi,%rdi,4), %edi
+	negl	%edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_mul_imul
+	.p2align	4, 0x90
+_mul_imul:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/strength_reduction.c:10
+	movl	%edi, %esi		# %esi = x
+	imull	$11, %esi		# %esi = x * $11
+	imull	$4099, %edi		# %edi = x * $4099
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	imull	$-7, %edi		# %edi = x * $-7
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_mul_long
+	.p2align	4, 0x90
+_mul_long:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/strength_reduction.c:14
+	movq	%rdi, %rsi		# %rsi = x
+	# %rsi = x * $40
+	leaq	(%rsi,%rsi,4), %rsi
+	shlq	$3, %rsi
+	# %rdi = x * $1024
+	shlq	$10, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	-8(%rbp), %rdi		# %rdi = x
+	# %rdi = x * $63
+	movq	%rdi, %rax
+	shlq	$6, %rdi
+	subq	%rax, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_div_pow2
+	.p2align	4, 0x90
+_div_pow2:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/strength_reduction.c:18
+	movl	%edi, %esi		# %esi = x
+	# %esi = x / $8
+	leal	7(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$3, %eax
+	movl	%eax, %esi
+	# %edi = x / $-4
+	leal	3(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$2, %eax
+	negl	%eax
+	movl	%eax, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $2
+	leal	1(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$1, %eax
+	movl	%eax, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	addl	-4(%rbp), %esi		# %esi = %esi + x
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $65536
+	leal	65535(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$16, %eax
+	movl	%eax, %edi
+	subl	%edi, %esi		# %esi = %esi - %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_div_magic
+	.p2align	4, 0x90
+_div_magic:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/strength_reduction.c:22
+	movl	%edi, %esi		# %esi = x
+	# %esi = x / $7
+	movl	$-1840700269, %eax
+	imull	%esi
+	addl	%esi, %edx
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %esi
+	# %edi = x / $10
+	movl	$1717986919, %eax
+	imull	%edi
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $-3
+	movl	$1431655765, %eax
+	imull	%edi
+	subl	%edi, %edx
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $641
+	movl	$6700417, %eax
+	imull	%edi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $1000000
+	movl	$1125899907, %eax
+	imull	%edi
+	sarl	$18, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_udiv
+	.p2align	4, 0x90
+_udiv:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/strength_reduction.c:26
+	movl	%edi, %esi		# %esi = x
+	# %esi = x / $3
+	movl	$-1431655765, %eax
+	mull	%esi
+	shrl	$1, %edx
+	movl	%edx, %esi
+	# %edi = x / $7
+	movl	$613566757, %eax
+	mull	%edi
+	movl	%edi, %eax
+	subl	%edx, %eax
+	shrl	%eax
+	addl	%eax, %edx
+	shrl	$2, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $16
+	shrl	$4, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $1000
+	movl	$274877907, %eax
+	mull	%edi
+	shrl	$6, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x / $641
+	movl	$6700417, %eax
+	mull	%edi
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_ldiv
+	.p2align	4, 0x90
+_ldiv:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/strength_reduction.c:30
+	movq	%rdi, %rsi		# %rsi = x
+	# %rsi = x / $10
+	movabsq	$7378697629483820647, %rax
+	imulq	%rsi
+	sarq	$2, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %rsi
+	# %rdi = x / $3
+	movabsq	$6148914691236517206, %rax
+	imulq	%rdi
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	-8(%rbp), %rdi		# %rdi = x
+	# %rdi = x / $-1000
+	movabsq	$-2361183241434822607, %rax
+	imulq	%rdi
+	sarq	$7, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	-8(%rbp), %rdi		# %rdi = x
+	# %rdi = x / $4096
+	leaq	4095(%rdi), %rax
+	testq	%rdi, %rdi
+	cmovnsq	%rdi, %rax
+	sarq	$12, %rax
+	movq	%rax, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	-8(%rbp), %rdi		# %rdi = x
+	# %rdi = x / $7
+	movabsq	$5270498306774157605, %rax
+	imulq	%rdi
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_uldiv
+	.p2align	4, 0x90
+_uldiv:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/strength_reduction.c:34
+	movq	%rdi, %rsi		# %rsi = x
+	# %rsi = x / $10
+	movabsq	$-3689348814741910323, %rax
+	mulq	%rsi
+	shrq	$3, %rdx
+	movq	%rdx, %rsi
+	# %rdi = x / $7
+	movabsq	$2635249153387078803, %rax
+	mulq	%rdi
+	movq	%rdi, %rax
+	subq	%rdx, %rax
+	shrq	%rax
+	addq	%rax, %rdx
+	shrq	$2, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	-8(%rbp), %rdi		# %rdi = x
+	# %rdi = x / $64
+	shrq	$6, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	-8(%rbp), %rdi		# %rdi = x
+	# %rdi = x / $1000000007
+	movabsq	$-8543223828751151131, %rax
+	mulq	%rdi
+	shrq	$29, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi		# %rsi = %rsi + %rdi
+	movq	%rsi, %rax		# %rax = %rsi
+	leave
+	retq
+	.globl	_stride
+	.p2align	4, 0x90
+_stride:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$320, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc j (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/strength_reduction.c:38
+# alloc grid (72 bytes) at -80(%rbp)
+# golden/strength_reduction.c:39
+# alloc cells (240 bytes) at -320(%rbp)
+# golden/strength_reduction.c:40
+	movl	%edi, %esi		# %esi = i
+	# %esi = i * $7
+	movl	%esi, %eax
+	shll	$3, %esi
+	subl	%eax, %esi
+	addl	-8(%rbp), %esi		# %esi = %esi + j
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $4
+	shll	$2, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $12
+	leal	(%r8,%r8,2), %r8d
+	shll	$2, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movslq	%edi, %rcx
+	movl	%esi, -80(%rbp,%rcx)		# grid[i][j] = %esi
+# golden/strength_reduction.c:41
+	movl	-8(%rbp), %esi		# %esi = j
+	# %esi = j * $4
+	shll	$2, %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $12
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movslq	%esi, %rcx
+	movl	-80(%rbp,%rcx), %esi		# %esi = grid[i][j]
+	# %esi = grid[i][j] * $9
+	leal	(%rsi,%rsi,8), %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $12
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	movl	-8(%rbp), %r8d		# %r8d = j
+	# %r8d = j * $60
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$2, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	$2, %r8d		# %r8d = $2
+	# %r8d = $2 * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	movl	%esi, -320(%rbp,%rcx)		# cells[j][i][$2] = %esi
+# golden/strength_reduction.c:42
+	movl	-8(%rbp), %esi		# %esi = j
+	# %esi = j * $4
+	shll	$2, %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $12
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movslq	%esi, %rcx
+	movl	-80(%rbp,%rcx), %esi		# %esi = grid[i][j]
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $12
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	movl	-8(%rbp), %r8d		# %r8d = j
+	# %r8d = j * $60
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$2, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	$2, %r8d		# %r8d = $2
+	# %r8d = $2 * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	addl	-320(%rbp,%rcx), %esi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
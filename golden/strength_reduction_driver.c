@@ -0,0 +1,25 @@
+#include <limits.h>
+#include <stdio.h>
+
+extern int mul_lea(int x);
+extern int mul_shift(int x);
+extern int mul_imul(int x);
+extern long mul_long(long x);
+extern int div_pow2(int x);
+extern int div_magic(int x);
+extern unsigned udiv(unsigned x);
+extern long ldiv(long x);
+extern unsigned long uldiv(unsigned long x);
+extern int stride(int i, int j);
+
+int main(int argc, char *argv[]) {
+  int ints[] = {0, 1, -1, 7, -7, 12345, -12345, 999999, INT_MAX, INT_MIN + 1};
+  for (int i = 0; i < (int) (sizeof(ints) / sizeof(ints[0])); i++) {
+    int x = ints[i];
+    printf("%d: %d %d %d %d %d\n", x, mul_lea(x), mul_shift(x), mul_imul(x), div_pow2(x), div_magic(x));
+    printf("%u: %u\n", (unsigned) x, udiv((unsigned) x));
+    printf("%ld: %ld %ld %lu\n", (long) x * 100003, mul_long(x), ldiv((long) x * 100003), uldiv((unsigned long) x));
+  }
+  printf("%ld %ld %lu\n", ldiv(LONG_MAX), ldiv(LONG_MIN + 1), uldiv(ULONG_MAX));
+  printf("%d %d %d\n", stride(0, 0), stride(5, 2), stride(3, 1));
+}
@@ -0,0 +1,273 @@
+	.globl	_mul_lea
+	.p2align	4, 0x90
+_mul_lea:
+	movl	%edi, %esi
+	leal	(%rsi,%rsi,2), %esi
+	movl	%edi, %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$1, %r8d
+	addl	%r8d, %esi
+	movl	%edi, %r8d
+	leal	(%r8,%r8,2), %r8d
+	shll	$3, %r8d
+	subl	%r8d, %esi
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,8), %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_mul_shift
+	.p2align	4, 0x90
+_mul_shift:
+	movl	%edi, %esi
+	movl	%esi, %eax
+	shll	$4, %esi
+	addl	%eax, %esi
+	movl	%edi, %r8d
+	movl	%r8d, %eax
+	shll	$5, %r8d
+	subl	%eax, %r8d
+	subl	%r8d, %esi
+	movl	%edi, %r8d
+	shll	$3, %r8d
+	negl	%r8d
+	addl	%r8d, %esi
+	leal	(%rdi,%rdi,4), %edi
+	negl	%edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_mul_imul
+	.p2align	4, 0x90
+_mul_imul:
+	movl	%edi, %esi
+	imull	$11, %esi
+	movl	%edi, %r8d
+	imull	$4099, %r8d
+	addl	%r8d, %esi
+	imull	$-7, %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_mul_long
+	.p2align	4, 0x90
+_mul_long:
+	movq	%rdi, %rsi
+	leaq	(%rsi,%rsi,4), %rsi
+	shlq	$3, %rsi
+	movq	%rdi, %r8
+	shlq	$10, %r8
+	addq	%r8, %rsi
+	movq	%rdi, %rax
+	shlq	$6, %rdi
+	subq	%rax, %rdi
+	addq	%rdi, %rsi
+	movq	%rsi, %rax
+	retq
+	.globl	_div_pow2
+	.p2align	4, 0x90
+_div_pow2:
+	leal	7(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$3, %eax
+	movl	%eax, %esi
+	leal	3(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$2, %eax
+	negl	%eax
+	movl	%eax, %r8d
+	addl	%r8d, %esi
+	leal	1(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$1, %eax
+	movl	%eax, %r8d
+	addl	%r8d, %esi
+	addl	%edi, %esi
+	leal	65535(%rdi), %eax
+	testl	%edi, %edi
+	cmovnsl	%edi, %eax
+	sarl	$16, %eax
+	movl	%eax, %edi
+	subl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_div_magic
+	.p2align	4, 0x90
+_div_magic:
+	movl	$-1840700269, %eax
+	imull	%edi
+	addl	%edi, %edx
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %esi
+	movl	$1717986919, %eax
+	imull	%edi
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r8d
+	addl	%r8d, %esi
+	movl	$1431655765, %eax
+	imull	%edi
+	subl	%edi, %edx
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r8d
+	addl	%r8d, %esi
+	movl	$6700417, %eax
+	imull	%edi
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %r8d
+	addl	%r8d, %esi
+	movl	$1125899907, %eax
+	imull	%edi
+	sarl	$18, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_udiv
+	.p2align	4, 0x90
+_udiv:
+	movl	$-1431655765, %eax
+	mull	%edi
+	shrl	$1, %edx
+	movl	%edx, %esi
+	movl	$613566757, %eax
+	mull	%edi
+	movl	%edi, %eax
+	subl	%edx, %eax
+	shrl	%eax
+	addl	%eax, %edx
+	shrl	$2, %edx
+	movl	%edx, %r8d
+	addl	%r8d, %esi
+	movl	%edi, %r8d
+	shrl	$4, %r8d
+	addl	%r8d, %esi
+	movl	$274877907, %eax
+	mull	%edi
+	shrl	$6, %edx
+	movl	%edx, %r8d
+	addl	%r8d, %esi
+	movl	$6700417, %eax
+	mull	%edi
+	movl	%edx, %edi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_ldiv
+	.p2align	4, 0x90
+_ldiv:
+	movabsq	$7378697629483820647, %rax
+	imulq	%rdi
+	sarq	$2, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %rsi
+	movabsq	$6148914691236517206, %rax
+	imulq	%rdi
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %r8
+	addq	%r8, %rsi
+	movabsq	$-2361183241434822607, %rax
+	imulq	%rdi
+	sarq	$7, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %r8
+	addq	%r8, %rsi
+	leaq	4095(%rdi), %rax
+	testq	%rdi, %rdi
+	cmovnsq	%rdi, %rax
+	sarq	$12, %rax
+	movq	%rax, %r8
+	addq	%r8, %rsi
+	movabsq	$5270498306774157605, %rax
+	imulq	%rdi
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi
+	movq	%rsi, %rax
+	retq
+	.globl	_uldiv
+	.p2align	4, 0x90
+_uldiv:
+	movabsq	$-3689348814741910323, %rax
+	mulq	%rdi
+	shrq	$3, %rdx
+	movq	%rdx, %rsi
+	movabsq	$2635249153387078803, %rax
+	mulq	%rdi
+	movq	%rdi, %rax
+	subq	%rdx, %rax
+	shrq	%rax
+	addq	%rax, %rdx
+	shrq	$2, %rdx
+	movq	%rdx, %r8
+	addq	%r8, %rsi
+	movq	%rdi, %r8
+	shrq	$6, %r8
+	addq	%r8, %rsi
+	movabsq	$-8543223828751151131, %rax
+	mulq	%rdi
+	shrq	$29, %rdx
+	movq	%rdx, %rdi
+	addq	%rdi, %rsi
+	movq	%rsi, %rax
+	retq
+	.globl	_stride
+	.p2align	4, 0x90
+_stride:
+	pushq	%rbx
+	subq	$320, %rsp
+	movslq	%edi, %r8
+	leaq	(%r8,%r8,2), %r8
+	shlq	$2, %r8
+	leaq	248(%rsp), %r9
+	addq	%r8, %r9
+	movslq	%esi, %r10
+	movq	%r10, %rbx
+	shlq	$2, %rbx
+	addq	%rbx, %r9
+	movl	%edi, %eax
+	shll	$3, %edi
+	subl	%eax, %edi
+	addl	%edi, %esi
+	movl	%esi, (%r9)
+	movq	%r10, %rdi
+	leaq	(%rdi,%rdi,2), %rdi
+	leaq	(%rdi,%rdi,4), %rdi
+	shlq	$2, %rdi
+	leaq	8(%rsp), %rax
+	addq	%rax, %rdi
+	addq	%r8, %rdi
+	addq	$8, %rdi
+	movl	%esi, %r8d
+	leal	(%r8,%r8,8), %r8d
+	movl	%r8d, (%rdi)
+	addl	%r8d, %esi
+	movl	%esi, %eax
+	addq	$320, %rsp
+	popq	%rbx
+	retq
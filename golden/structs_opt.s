@@ -0,0 +1,16 @@
+	.globl	_f
+	.p2align	4, 0x90
+_f:
+	movl	%esi, %r8d
+	leal	(%r8,%r8,2), %r8d
+	movl	%edi, %r9d
+	leal	(%r9,%r9,4), %r9d
+	addl	%edi, %esi
+	addl	$10, %esi
+	addl	$20, %esi
+	addl	%r8d, %esi
+	addl	%r9d, %esi
+	addl	$200, %esi
+	addl	-28(%rsp), %esi
+	movl	%esi, %eax
+	retq
@@ -0,0 +1,116 @@
+int is_vowel(int c) {
+  switch (c) {
+    case 97: case 101: case 105: case 111: case 117:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+int status_class(int code) {
+  int ret = 0;
+  switch (code) {
+    case 100: ret = 1; break;
+    case 200: ret = 2; break;
+    case 204: ret = 3; break;
+    case 301: ret = 4; break;
+    case 404: ret = 5; break;
+    case 500: ret = 6; break;
+    case 503: ret = 7; break;
+    case -1: ret = 8; break;
+  }
+  return ret;
+}
+
+int run(int n) {
+  int program[8];
+  program[0] = 0;
+  program[1] = 1;
+  program[2] = 2;
+  program[3] = 3;
+  program[4] = 1;
+  program[5] = 4;
+  program[6] = 5;
+  program[7] = 6;
+  int acc = n, pc = 0, steps = 0;
+  while (pc < 8) {
+    steps++;
+    switch (program[pc]) {
+      case 0: acc = acc + 1; break;
+      case 1: acc = acc * 2; break;
+      case 2: acc = acc - 3; break;
+      case 3:
+        if (acc > 100) {
+          pc = pc + 2;
+          continue;
+        }
+        break;
+      case 4: acc = acc - 5; break;
+      case 5: acc = acc + steps;
+      case 6: acc = acc + 1; break;
+      default: acc = 0;
+    }
+    pc++;
+  }
+  return acc;
+}
+
+long big_cases(long x) {
+  switch (x) {
+    case 1099511627776: return 1;
+    case -1099511627776: return 2;
+    case 3: return 3;
+    case 8589934592: return 4;
+    case 5000000000: return 5;
+    default: return 6;
+  }
+}
+
+int unsigned_cases(unsigned x) {
+  switch (x) {
+    case 4294967295: return 1;
+    case 0: return 2;
+    case 2147483648: return 3;
+    case 7: return 4;
+  }
+  return 5;
+}
+
+int nested(int a, int b) {
+  int ret = 0;
+  switch (a) {
+    case 1:
+      switch (b) {
+        case 1: ret = 11; break;
+        case 2: ret = 12; break;
+        default: ret = 10;
+      }
+      ret = ret + 100;
+      break;
+    default:
+      ret = -1;
+    case 2 * 8 + 1:
+      ret = ret + 17;
+  }
+  return ret;
+}
+
+int only_default(int x) {
+  switch (x) {
+    default:
+      x = x + 1;
+  }
+  return x;
+}
+
+int narrow(char c) {
+  switch (c) {
+    case -1: return 1;
+    case 0: return 2;
+    case 1: return 3;
+    case 2: return 4;
+    case 3: return 5;
+    case 4: return 6;
+  }
+  return 0;
+}
@@ -0,0 +1,546 @@
+	.globl	_is_vowel
+	.p2align	4, 0x90
+_is_vowel:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc c (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/switches.c:2
+# alloc switch (4 bytes) at -8(%rbp)
+	movl	%edi, %esi		# %esi = c
+	movl	%esi, -8(%rbp)		# switch = %esi
+	jmp	Lis_vowel_0
+# golden/switches.c:3
+Lis_vowel_2:
+	movl	$1, %eax		# %eax = $1
+	leave
+	retq
+# golden/switches.c:5
+Lis_vowel_3:
+	movl	$0, %eax		# %eax = $0
+	leave
+	retq
+Lis_vowel_0:
+	movl	-8(%rbp), %eax		# %eax = switch
+	subl	$97, %eax
+	cmpl	$20, %eax
+	ja	Lis_vowel_3
+	movl	$1065233, %ecx
+	btq	%rax, %rcx
+	jb	Lis_vowel_2
+	jmp	Lis_vowel_3
+Lis_vowel_1:
+	leave
+	retq
+	.globl	_status_class
+	.p2align	4, 0x90
+_status_class:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc code (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/switches.c:11
+# alloc ret (4 bytes) at -8(%rbp)
+	movl	$0, -8(%rbp)		# ret = $0
+# golden/switches.c:12
+# alloc switch (4 bytes) at -12(%rbp)
+	movl	%edi, %esi		# %esi = code
+	movl	%esi, -12(%rbp)		# switch = %esi
+	jmp	Lstatus_class_0
+# golden/switches.c:13
+Lstatus_class_2:
+	movl	$1, -8(%rbp)		# ret = $1
+# golden/switches.c:13
+	jmp	Lstatus_class_1
+# golden/switches.c:14
+Lstatus_class_3:
+	movl	$2, -8(%rbp)		# ret = $2
+# golden/switches.c:14
+	jmp	Lstatus_class_1
+# golden/switches.c:15
+Lstatus_class_4:
+	movl	$3, -8(%rbp)		# ret = $3
+# golden/switches.c:15
+	jmp	Lstatus_class_1
+# golden/switches.c:16
+Lstatus_class_5:
+	movl	$4, -8(%rbp)		# ret = $4
+# golden/switches.c:16
+	jmp	Lstatus_class_1
+# golden/switches.c:17
+Lstatus_class_6:
+	movl	$5, -8(%rbp)		# ret = $5
+# golden/switches.c:17
+	jmp	Lstatus_class_1
+# golden/switches.c:18
+Lstatus_class_7:
+	movl	$6, -8(%rbp)		# ret = $6
+# golden/switches.c:18
+	jmp	Lstatus_class_1
+# golden/switches.c:19
+Lstatus_class_8:
+	movl	$7, -8(%rbp)		# ret = $7
+# golden/switches.c:19
+	jmp	Lstatus_class_1
+# golden/switches.c:20
+Lstatus_class_9:
+	movl	$8, -8(%rbp)		# ret = $8
+# golden/switches.c:20
+	jmp	Lstatus_class_1
+Lstatus_class_0:
+	movl	-12(%rbp), %eax		# %eax = switch
+	cmpl	$301, %eax
+	je	Lstatus_class_5
+	jg	Lstatus_class_10_0
+	cmpl	$200, %eax
+	je	Lstatus_class_3
+	jg	Lstatus_class_10_1
+	cmpl	$-1, %eax
+	je	Lstatus_class_9
+	cmpl	$100, %eax
+	je	Lstatus_class_2
+	jmp	Lstatus_class_1
+Lstatus_class_10_1:
+	cmpl	$204, %eax
+	je	Lstatus_class_4
+	jmp	Lstatus_class_1
+Lstatus_class_10_0:
+	cmpl	$404, %eax
+	je	Lstatus_class_6
+	cmpl	$500, %eax
+	je	Lstatus_class_7
+	cmpl	$503, %eax
+	je	Lstatus_class_8
+	jmp	Lstatus_class_1
+Lstatus_class_1:
+# golden/switches.c:22
+	movl	-8(%rbp), %eax		# %eax = ret
+	leave
+	retq
+	.globl	_run
+	.p2align	4, 0x90
+_run:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/switches.c:26
+# alloc program (32 bytes) at -36(%rbp)
+# golden/switches.c:27
+	movl	$0, -36(%rbp)		# program[$0] = $0
+# golden/switches.c:28
+	movl	$1, -32(%rbp)		# program[$1] = $1
+# golden/switches.c:29
+	movl	$2, -28(%rbp)		# program[$2] = $2
+# golden/switches.c:30
+	movl	$3, -24(%rbp)		# program[$3] = $3
+# golden/switches.c:31
+	movl	$1, -20(%rbp)		# program[$4] = $1
+# golden/switches.c:32
+	movl	$4, -16(%rbp)		# program[$5] = $4
+# golden/switches.c:33
+	movl	$5, -12(%rbp)		# program[$6] = $5
+# golden/switches.c:34
+	movl	$6, -8(%rbp)		# program[$7] = $6
+# golden/switches.c:35
+# alloc acc (4 bytes) at -40(%rbp)
+	movl	%edi, -40(%rbp)
+# alloc pc (4 bytes) at -44(%rbp)
+	movl	$0, -44(%rbp)		# pc = $0
+# alloc steps (4 bytes) at -48(%rbp)
+	movl	$0, -48(%rbp)		# steps = $0
+# golden/switches.c:36
+	movl	$0, %esi		# %esi = pc
+	cmpl	$8, %esi		# %esi = pc < $8
+	jge	Lrun_2
+Lrun_0:
+# golden/switches.c:37
+	movl	-48(%rbp), %esi		# %esi = steps
+	addl	$1, %esi		# %esi = steps + $1
+	movl	%esi, -48(%rbp)		# steps = %esi
+# golden/switches.c:38
+# alloc switch (4 bytes) at -52(%rbp)
+	movslq	-44(%rbp), %rcx
+	movl	-36(%rbp,%rcx,4), %esi		# %esi = program[pc]
+	movl	%esi, -52(%rbp)		# switch = %esi
+	jmp	Lrun_3
+# golden/switches.c:39
+Lrun_5:
+	movl	-40(%rbp), %esi		# %esi = acc
+	addl	$1, %esi		# %esi = acc + $1
+	movl	%esi, -40(%rbp)		# acc = %esi
+# golden/switches.c:39
+	jmp	Lrun_4
+# golden/switches.c:40
+Lrun_6:
+	movl	-40(%rbp), %esi		# %esi = acc
+	# %esi = acc * $2
+	shll	$1, %esi
+	movl	%esi, -40(%rbp)		# acc = %esi
+# golden/switches.c:40
+	jmp	Lrun_4
+# golden/switches.c:41
+Lrun_7:
+	movl	-40(%rbp), %esi		# %esi = acc
+	subl	$3, %esi		# %esi = acc - $3
+	movl	%esi, -40(%rbp)		# acc = %esi
+# golden/switches.c:41
+	jmp	Lrun_4
+# golden/switches.c:42
+Lrun_8:
+	movl	-40(%rbp), %esi		# %esi = acc
+	cmpl	$100, %esi		# %esi = acc > $100
+	jle	Lrun_9
+# golden/switches.c:44
+	movl	-44(%rbp), %esi		# %esi = pc
+	addl	$2, %esi		# %esi = pc + $2
+	movl	%esi, -44(%rbp)		# pc = %esi
+# golden/switches.c:45
+	jmp	Lrun_1
+Lrun_9:
+# golden/switches.c:47
+	jmp	Lrun_4
+# golden/switches.c:48
+Lrun_10:
+	movl	-40(%rbp), %esi		# %esi = acc
+	subl	$5, %esi		# %esi = acc - $5
+	movl	%esi, -40(%rbp)		# acc = %esi
+# golden/switches.c:48
+	jmp	Lrun_4
+# golden/switches.c:49
+Lrun_11:
+	movl	-40(%rbp), %esi		# %esi = acc
+	addl	-48(%rbp), %esi		# %esi = acc + steps
+	movl	%esi, -40(%rbp)		# acc = %esi
+# golden/switches.c:50
+Lrun_12:
+	movl	-40(%rbp), %esi		# %esi = acc
+	addl	$1, %esi		# %esi = acc + $1
+	movl	%esi, -40(%rbp)		# acc = %esi
+# golden/switches.c:50
+	jmp	Lrun_4
+# golden/switches.c:51
+Lrun_13:
+	movl	$0, -40(%rbp)		# acc = $0
+	jmp	Lrun_4
+Lrun_3:
+	movl	-52(%rbp), %eax		# %eax = switch
+	cmpl	$6, %eax
+	ja	Lrun_13
+	leaq	Lrun_14_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+Lrun_14_table:
+	.long	Lrun_5-Lrun_14_table
+	.long	Lrun_6-Lrun_14_table
+	.long	Lrun_7-Lrun_14_table
+	.long	Lrun_8-Lrun_14_table
+	.long	Lrun_10-Lrun_14_table
+	.long	Lrun_11-Lrun_14_table
+	.long	Lrun_12-Lrun_14_table
+	.text
+Lrun_4:
+# golden/switches.c:53
+	movl	-44(%rbp), %esi		# %esi = pc
+	addl	$1, %esi		# %esi = pc + $1
+	movl	%esi, -44(%rbp)		# pc = %esi
+Lrun_1:
+	movl	-44(%rbp), %esi		# %esi = pc
+	cmpl	$8, %esi		# %esi = pc < $8
+	jl	Lrun_0
+Lrun_2:
+# golden/switches.c:55
+	movl	-40(%rbp), %eax		# %eax = acc
+	leave
+	retq
+	.globl	_big_cases
+	.p2align	4, 0x90
+_big_cases:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (8 bytes) at -8(%rbp)
+	movq	%rdi, -8(%rbp)
+# golden/switches.c:59
+# alloc switch (8 bytes) at -16(%rbp)
+	movq	%rdi, %rsi		# %rsi = x
+	movq	%rsi, -16(%rbp)		# switch = %rsi
+	jmp	Lbig_cases_0
+# golden/switches.c:60
+Lbig_cases_2:
+	movq	$1, %rax		# %rax = $1
+	leave
+	retq
+# golden/switches.c:61
+Lbig_cases_3:
+	movq	$2, %rax		# %rax = $2
+	leave
+	retq
+# golden/switches.c:62
+Lbig_cases_4:
+	movq	$3, %rax		# %rax = $3
+	leave
+	retq
+# golden/switches.c:63
+Lbig_cases_5:
+	movq	$4, %rax		# %rax = $4
+	leave
+	retq
+# golden/switches.c:64
+Lbig_cases_6:
+	movq	$5, %rax		# %rax = $5
+	leave
+	retq
+# golden/switches.c:65
+Lbig_cases_7:
+	movq	$6, %rax		# %rax = $6
+	leave
+	retq
+Lbig_cases_0:
+	movq	-16(%rbp), %rax		# %rax = switch
+	movabsq	$5000000000, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_6
+	jg	Lbig_cases_8_0
+	movabsq	$-1099511627776, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_3
+	cmpq	$3, %rax
+	je	Lbig_cases_4
+	jmp	Lbig_cases_7
+Lbig_cases_8_0:
+	movabsq	$8589934592, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_5
+	movabsq	$1099511627776, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_2
+	jmp	Lbig_cases_7
+Lbig_cases_1:
+	leave
+	retq
+	.globl	_unsigned_cases
+	.p2align	4, 0x90
+_unsigned_cases:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/switches.c:70
+# alloc switch (4 bytes) at -8(%rbp)
+	movl	%edi, %esi		# %esi = x
+	movl	%esi, -8(%rbp)		# switch = %esi
+	jmp	Lunsigned_cases_0
+# golden/switches.c:71
+Lunsigned_cases_2:
+	movl	$1, %eax		# %eax = $1
+	leave
+	retq
+# golden/switches.c:72
+Lunsigned_cases_3:
+	movl	$2, %eax		# %eax = $2
+	leave
+	retq
+# golden/switches.c:73
+Lunsigned_cases_4:
+	movl	$3, %eax		# %eax = $3
+	leave
+	retq
+# golden/switches.c:74
+Lunsigned_cases_5:
+	movl	$4, %eax		# %eax = $4
+	leave
+	retq
+Lunsigned_cases_0:
+	movl	-8(%rbp), %eax		# %eax = switch
+	cmpl	$0, %eax
+	je	Lunsigned_cases_3
+	jg	Lunsigned_cases_6_0
+	cmpl	$-2147483648, %eax
+	je	Lunsigned_cases_4
+	cmpl	$-1, %eax
+	je	Lunsigned_cases_2
+	jmp	Lunsigned_cases_1
+Lunsigned_cases_6_0:
+	cmpl	$7, %eax
+	je	Lunsigned_cases_5
+	jmp	Lunsigned_cases_1
+Lunsigned_cases_1:
+# golden/switches.c:76
+	movl	$5, %eax		# %eax = $5
+	leave
+	retq
+	.globl	_nested
+	.p2align	4, 0x90
+_nested:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/switches.c:80
+# alloc ret (4 bytes) at -12(%rbp)
+	movl	$0, -12(%rbp)		# ret = $0
+# golden/switches.c:81
+# alloc switch (4 bytes) at -16(%rbp)
+	movl	%edi, %esi		# %esi = a
+	movl	%esi, -16(%rbp)		# switch = %esi
+	jmp	Lnested_0
+# golden/switches.c:82
+Lnested_2:
+# alloc switch (4 bytes) at -20(%rbp)
+	movl	-8(%rbp), %esi		# %esi = b
+	movl	%esi, -20(%rbp)		# switch = %esi
+	jmp	Lnested_3
+# golden/switches.c:84
+Lnested_5:
+	movl	$11, -12(%rbp)		# ret = $11
+# golden/switches.c:84
+	jmp	Lnested_4
+# golden/switches.c:85
+Lnested_6:
+	movl	$12, -12(%rbp)		# ret = $12
+# golden/switches.c:85
+	jmp	Lnested_4
+# golden/switches.c:86
+Lnested_7:
+	movl	$10, -12(%rbp)		# ret = $10
+	jmp	Lnested_4
+Lnested_3:
+	movl	-20(%rbp), %eax		# %eax = switch
+	cmpl	$1, %eax
+	je	Lnested_5
+	cmpl	$2, %eax
+	je	Lnested_6
+	jmp	Lnested_7
+Lnested_4:
+# golden/switches.c:88
+	movl	-12(%rbp), %esi		# %esi = ret
+	addl	$100, %esi		# %esi = ret + $100
+	movl	%esi, -12(%rbp)		# ret = %esi
+# golden/switches.c:89
+	jmp	Lnested_1
+# golden/switches.c:90
+Lnested_9:
+	movl	$-1, -12(%rbp)		# ret = $-1
+# golden/switches.c:92
+Lnested_10:
+	movl	-12(%rbp), %esi		# %esi = ret
+	addl	$17, %esi		# %esi = ret + $17
+	movl	%esi, -12(%rbp)		# ret = %esi
+	jmp	Lnested_1
+Lnested_0:
+	movl	-16(%rbp), %eax		# %eax = switch
+	cmpl	$1, %eax
+	je	Lnested_2
+	cmpl	$17, %eax
+	je	Lnested_10
+	jmp	Lnested_9
+Lnested_1:
+# golden/switches.c:95
+	movl	-12(%rbp), %eax		# %eax = ret
+	leave
+	retq
+	.globl	_only_default
+	.p2align	4, 0x90
+_only_default:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/switches.c:99
+# alloc switch (4 bytes) at -8(%rbp)
+	movl	%edi, %esi		# %esi = x
+	movl	%esi, -8(%rbp)		# switch = %esi
+	jmp	Lonly_default_0
+# golden/switches.c:100
+Lonly_default_2:
+	movl	-4(%rbp), %esi		# %esi = x
+	addl	$1, %esi		# %esi = x + $1
+	movl	%esi, -4(%rbp)		# x = %esi
+	jmp	Lonly_default_1
+Lonly_default_0:
+	movl	-8(%rbp), %eax		# %eax = switch
+	jmp	Lonly_default_2
+Lonly_default_1:
+# golden/switches.c:103
+	movl	-4(%rbp), %eax		# %eax = x
+	leave
+	retq
+	.globl	_narrow
+	.p2align	4, 0x90
+_narrow:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc c (1 bytes) at -1(%rbp)
+	movb	%dil, -1(%rbp)
+# golden/switches.c:107
+# alloc switch (4 bytes) at -8(%rbp)
+	movsbl	-1(%rbp), %esi		# (int) c
+	movl	%esi, -8(%rbp)		# switch = %esi
+	jmp	Lnarrow_0
+# golden/switches.c:108
+Lnarrow_2:
+	movl	$1, %eax		# %eax = $1
+	leave
+	retq
+# golden/switches.c:109
+Lnarrow_3:
+	movl	$2, %eax		# %eax = $2
+	leave
+	retq
+# golden/switches.c:110
+Lnarrow_4:
+	movl	$3, %eax		# %eax = $3
+	leave
+	retq
+# golden/switches.c:111
+Lnarrow_5:
+	movl	$4, %eax		# %eax = $4
+	leave
+	retq
+# golden/switches.c:112
+Lnarrow_6:
+	movl	$5, %eax		# %eax = $5
+	leave
+	retq
+# golden/switches.c:113
+Lnarrow_7:
+	movl	$6, %eax		# %eax = $6
+	leave
+	retq
+Lnarrow_0:
+	movl	-8(%rbp), %eax		# %eax = switch
+	subl	$-1, %eax
+	cmpl	$5, %eax
+	ja	Lnarrow_1
+	leaq	Lnarrow_8_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+Lnarrow_8_table:
+	.long	Lnarrow_2-Lnarrow_8_table
+	.long	Lnarrow_3-Lnarrow_8_table
+	.long	Lnarrow_4-Lnarrow_8_table
+	.long	Lnarrow_5-Lnarrow_8_table
+	.long	Lnarrow_6-Lnarrow_8_table
+	.long	Lnarrow_7-Lnarrow_8_table
+	.text
+Lnarrow_1:
+# golden/switches.c:115
+	movl	$0, %eax		# %eax = $0
+	leave
+	retq
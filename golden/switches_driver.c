@@ -0,0 +1,50 @@
+#include <stdio.h>
+
+extern int is_vowel(int c);
+extern int status_class(int code);
+extern int run(int n);
+extern long big_cases(long x);
+extern int unsigned_cases(unsigned x);
+extern int nested(int a, int b);
+extern int only_default(int x);
+extern int narrow(char c);
+
+#define print_expr(expr) printf(#expr " = %ld\n", (long) (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(is_vowel('a'));
+  print_expr(is_vowel('b'));
+  print_expr(is_vowel('u'));
+  print_expr(is_vowel('z'));
+  print_expr(is_vowel(-1000));
+  print_expr(status_class(100));
+  print_expr(status_class(204));
+  print_expr(status_class(205));
+  print_expr(status_class(404));
+  print_expr(status_class(503));
+  print_expr(status_class(-1));
+  print_expr(status_class(0));
+  print_expr(run(1));
+  print_expr(run(60));
+  print_expr(big_cases(1L << 40));
+  print_expr(big_cases(-(1L << 40)));
+  print_expr(big_cases(3));
+  print_expr(big_cases(1L << 33));
+  print_expr(big_cases(5000000000));
+  print_expr(big_cases(4));
+  print_expr(unsigned_cases(4294967295u));
+  print_expr(unsigned_cases(0));
+  print_expr(unsigned_cases(2147483648u));
+  print_expr(unsigned_cases(7));
+  print_expr(unsigned_cases(8));
+  print_expr(nested(1, 1));
+  print_expr(nested(1, 2));
+  print_expr(nested(1, 3));
+  print_expr(nested(17, 0));
+  print_expr(nested(5, 0));
+  print_expr(only_default(41));
+  print_expr(narrow(255));
+  print_expr(narrow(258));
+  print_expr(narrow(4));
+  print_expr(narrow(5));
+}
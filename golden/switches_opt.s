@@ -0,0 +1,345 @@
+	.globl	_is_vowel
+	.p2align	4, 0x90
+_is_vowel:
+Lis_vowel_2:
+	movl	%edi, %eax
+	subl	$97, %eax
+	cmpl	$20, %eax
+	ja	Lis_vowel_4
+	movl	$1065233, %ecx
+	btq	%rax, %rcx
+	jb	Lis_vowel_3
+	jmp	Lis_vowel_4
+Lis_vowel_4:
+	xorl	%eax, %eax
+	retq
+Lis_vowel_3:
+	movl	$1, %eax
+	retq
+	.globl	_status_class
+	.p2align	4, 0x90
+_status_class:
+Lstatus_class_2:
+	movl	%edi, %eax
+	cmpl	$301, %eax
+	je	Lstatus_class_7
+	jg	LSW_status_class_2_0
+	cmpl	$200, %eax
+	je	Lstatus_class_5
+	jg	LSW_status_class_2_1
+	cmpl	$-1, %eax
+	je	Lstatus_class_11
+	cmpl	$100, %eax
+	je	Lstatus_class_4
+	jmp	Lstatus_class_12
+LSW_status_class_2_1:
+	cmpl	$204, %eax
+	je	Lstatus_class_6
+	jmp	Lstatus_class_12
+LSW_status_class_2_0:
+	cmpl	$404, %eax
+	je	Lstatus_class_8
+	cmpl	$500, %eax
+	je	Lstatus_class_9
+	cmpl	$503, %eax
+	je	Lstatus_class_10
+	jmp	Lstatus_class_12
+Lstatus_class_4:
+	movq	$1, %rsi
+Lstatus_class_3:
+	movl	%esi, %eax
+	retq
+Lstatus_class_11:
+	movq	$8, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_10:
+	movq	$7, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_9:
+	movq	$6, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_8:
+	movq	$5, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_7:
+	movq	$4, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_6:
+	movq	$3, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_5:
+	movq	$2, %rsi
+	jmp	Lstatus_class_3
+Lstatus_class_12:
+	xorl	%esi, %esi
+	jmp	Lstatus_class_3
+	.globl	_run
+	.p2align	4, 0x90
+_run:
+	movl	$0, -40(%rsp)
+	movl	$1, -36(%rsp)
+	movl	$2, -32(%rsp)
+	movl	$3, -28(%rsp)
+	movl	$1, -24(%rsp)
+	movl	$4, -20(%rsp)
+	movl	$5, -16(%rsp)
+	movl	$6, -12(%rsp)
+Lrun_5:
+	xorl	%esi, %esi
+	movq	%rdi, %r8
+	xorl	%edi, %edi
+	.p2align	4, 0x90
+Lrun_2:
+	addl	$1, %esi
+	movslq	%edi, %r9
+	shlq	$2, %r9
+	leaq	-40(%rsp), %rax
+	addq	%rax, %r9
+	movl	(%r9), %r9d
+Lrun_6:
+	movl	%r9d, %eax
+	cmpl	$6, %eax
+	ja	Lrun_17
+	leaq	LSW_run_6_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+LSW_run_6_table:
+	.long	Lrun_8-LSW_run_6_table
+	.long	Lrun_9-LSW_run_6_table
+	.long	Lrun_10-LSW_run_6_table
+	.long	Lrun_11-LSW_run_6_table
+	.long	Lrun_14-LSW_run_6_table
+	.long	Lrun_15-LSW_run_6_table
+	.long	Lrun_20-LSW_run_6_table
+	.text
+Lrun_17:
+	xorl	%r9d, %r9d
+Lrun_7:
+	movl	%edi, %r10d
+	addl	$1, %r10d
+	movq	%r9, %rax
+	movq	%r10, %r9
+	movq	%rax, %r10
+Lrun_3:
+	cmpl	$8, %r9d
+	jge	Lrun_4
+Lrun_19:
+	movq	%r10, %r8
+	movq	%r9, %rdi
+	jmp	Lrun_2
+Lrun_4:
+	movl	%r10d, %eax
+	retq
+Lrun_20:
+	movq	%r8, %r9
+Lrun_16:
+	addl	$1, %r9d
+	jmp	Lrun_7
+Lrun_15:
+	movl	%r8d, %r9d
+	addl	%esi, %r9d
+	jmp	Lrun_16
+Lrun_14:
+	movl	%r8d, %r9d
+	subl	$5, %r9d
+	jmp	Lrun_7
+Lrun_11:
+	cmpl	$100, %r8d
+	jle	Lrun_12
+Lrun_13:
+	movl	%edi, %r9d
+	addl	$2, %r9d
+	movq	%r8, %r10
+	jmp	Lrun_3
+Lrun_12:
+	movq	%r8, %r9
+	jmp	Lrun_7
+Lrun_10:
+	movl	%r8d, %r9d
+	subl	$3, %r9d
+	jmp	Lrun_7
+Lrun_9:
+	movl	%r8d, %r9d
+	shll	$1, %r9d
+	jmp	Lrun_7
+Lrun_8:
+	movl	%r8d, %r9d
+	addl	$1, %r9d
+	jmp	Lrun_7
+	.globl	_big_cases
+	.p2align	4, 0x90
+_big_cases:
+Lbig_cases_2:
+	movabsq	$1099511627776, %rsi
+	movabsq	$-1099511627776, %r8
+	movabsq	$8589934592, %r9
+	movabsq	$5000000000, %r10
+	movq	%rdi, %rax
+	movabsq	$5000000000, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_7
+	jg	LSW_big_cases_2_0
+	movabsq	$-1099511627776, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_4
+	cmpq	$3, %rax
+	je	Lbig_cases_5
+	jmp	Lbig_cases_8
+LSW_big_cases_2_0:
+	movabsq	$8589934592, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_6
+	movabsq	$1099511627776, %rdx
+	cmpq	%rdx, %rax
+	je	Lbig_cases_3
+	jmp	Lbig_cases_8
+Lbig_cases_8:
+	movq	$6, %rax
+	retq
+Lbig_cases_3:
+	movq	$1, %rax
+	retq
+Lbig_cases_7:
+	movq	$5, %rax
+	retq
+Lbig_cases_6:
+	movq	$4, %rax
+	retq
+Lbig_cases_5:
+	movq	$3, %rax
+	retq
+Lbig_cases_4:
+	movq	$2, %rax
+	retq
+	.globl	_unsigned_cases
+	.p2align	4, 0x90
+_unsigned_cases:
+Lunsigned_cases_2:
+	movabsq	$4294967295, %rsi
+	movabsq	$2147483648, %r8
+	movl	%edi, %eax
+	cmpl	$0, %eax
+	je	Lunsigned_cases_5
+	jg	LSW_unsigned_cases_2_0
+	cmpl	$-2147483648, %eax
+	je	Lunsigned_cases_6
+	cmpl	$-1, %eax
+	je	Lunsigned_cases_4
+	jmp	Lunsigned_cases_3
+LSW_unsigned_cases_2_0:
+	cmpl	$7, %eax
+	je	Lunsigned_cases_7
+	jmp	Lunsigned_cases_3
+Lunsigned_cases_3:
+	movl	$5, %eax
+	retq
+Lunsigned_cases_4:
+	movl	$1, %eax
+	retq
+Lunsigned_cases_7:
+	movl	$4, %eax
+	retq
+Lunsigned_cases_6:
+	movl	$3, %eax
+	retq
+Lunsigned_cases_5:
+	movl	$2, %eax
+	retq
+	.globl	_nested
+	.p2align	4, 0x90
+_nested:
+Lnested_2:
+	movl	%edi, %eax
+	cmpl	$17, %eax
+	je	Lnested_12
+	cmpl	$1, %eax
+	je	Lnested_5
+	jmp	Lnested_10
+Lnested_12:
+	xorl	%edi, %edi
+Lnested_11:
+	addl	$17, %edi
+Lnested_3:
+	movl	%edi, %eax
+	retq
+Lnested_5:
+	movl	%esi, %eax
+	cmpl	$1, %eax
+	je	Lnested_7
+	cmpl	$2, %eax
+	je	Lnested_8
+	jmp	Lnested_9
+Lnested_9:
+	movq	$10, %rsi
+Lnested_6:
+	movl	%esi, %edi
+	addl	$100, %edi
+	jmp	Lnested_3
+Lnested_8:
+	movq	$12, %rsi
+	jmp	Lnested_6
+Lnested_7:
+	movq	$11, %rsi
+	jmp	Lnested_6
+Lnested_10:
+	movq	$-1, %rdi
+	jmp	Lnested_11
+	.globl	_only_default
+	.p2align	4, 0x90
+_only_default:
+Lonly_default_2:
+	movl	%edi, %eax
+	jmp	Lonly_default_4
+Lonly_default_4:
+	movl	%edi, %esi
+	addl	$1, %esi
+Lonly_default_3:
+	movl	%esi, %eax
+	retq
+	.globl	_narrow
+	.p2align	4, 0x90
+_narrow:
+	movsbl	%dil, %esi
+Lnarrow_2:
+	movl	%esi, %eax
+	subl	$-1, %eax
+	cmpl	$5, %eax
+	ja	Lnarrow_3
+	leaq	LSW_narrow_2_table(%rip), %rcx
+	movslq	(%rcx,%rax,4), %rdx
+	addq	%rcx, %rdx
+	jmpq	*%rdx
+	.const
+	.p2align	2
+LSW_narrow_2_table:
+	.long	Lnarrow_4-LSW_narrow_2_table
+	.long	Lnarrow_5-LSW_narrow_2_table
+	.long	Lnarrow_6-LSW_narrow_2_table
+	.long	Lnarrow_7-LSW_narrow_2_table
+	.long	Lnarrow_8-LSW_narrow_2_table
+	.long	Lnarrow_9-LSW_narrow_2_table
+	.text
+Lnarrow_3:
+	xorl	%eax, %eax
+	retq
+Lnarrow_4:
+	movl	$1, %eax
+	retq
+Lnarrow_9:
+	movl	$6, %eax
+	retq
+Lnarrow_8:
+	movl	$5, %eax
+	retq
+Lnarrow_7:
+	movl	$4, %eax
+	retq
+Lnarrow_6:
+	movl	$3, %eax
+	retq
+Lnarrow_5:
+	movl	$2, %eax
+	retq
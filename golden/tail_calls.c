@@ -0,0 +1,48 @@
+int is_odd(int n);
+
+int sum_down(int n, int acc) {
+  if (n == 0)
+    return acc;
+  return sum_down(n - 1, acc + n);
+}
+
+static int gcd(int a, int b) {
+  if (b == 0)
+    return a;
+  return gcd(b, a - a / b * b);
+}
+
+int lcm(int a, int b) {
+  return a / gcd(a, b) * b;
+}
+
+int is_even(int n) {
+  if (n == 0)
+    return 1;
+  return is_odd(n - 1);
+}
+
+int is_odd(int n) {
+  if (n == 0)
+    return 0;
+  return is_even(n - 1);
+}
+
+int count_digits(int n, int count) {
+  int digits[10];
+  digits[0] = n / 10;
+  if (digits[0] == 0)
+    return count + 1;
+  return count_digits(digits[0], count + 1);
+}
+
+int power(int base, int exp, int acc) {
+  while (exp > 0) {
+    if (exp / 2 * 2 == exp) {
+      return power(base * base, exp / 2, acc);
+    }
+    acc = acc * base;
+    exp--;
+  }
+  return acc;
+}
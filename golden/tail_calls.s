@@ -0,0 +1,233 @@
+	.globl	_sum_down
+	.p2align	4, 0x90
+_sum_down:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc acc (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/tail_calls.c:4
+	movl	%edi, %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n == $0
+	jne	Lsum_down_0
+	movl	-8(%rbp), %eax		# %eax = acc
+	leave
+	retq
+Lsum_down_0:
+# golden/tail_calls.c:6
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+# alloc t3 (4 bytes) at -12(%rbp)
+	movl	%esi, -12(%rbp)		# t3 = %esi
+	movl	-8(%rbp), %esi		# %esi = acc
+	addl	-4(%rbp), %esi		# %esi = acc + n
+	movl	-12(%rbp), %edi
+	callq	_sum_down
+	leave
+	retq
+	.p2align	4, 0x90
+_gcd:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/tail_calls.c:10
+	cmpl	$0, %esi		# %esi = b == $0
+	jne	Lgcd_0
+	movl	-4(%rbp), %eax		# %eax = a
+	leave
+	retq
+Lgcd_0:
+# golden/tail_calls.c:12
+	movl	-4(%rbp), %esi		# %esi = a
+	movl	-4(%rbp), %eax		# %eax = a
+	cdq
+	idivl	-8(%rbp)		# %eax = a / b
+	movl	%eax, %edi
+	imull	-8(%rbp), %edi		# %edi = %edi * b
+	subl	%edi, %esi		# %esi = a - %edi
+	movl	-8(%rbp), %edi
+	callq	_gcd
+# alloc t3 (4 bytes) at -12(%rbp)
+	leave
+	retq
+	.globl	_lcm
+	.p2align	4, 0x90
+_lcm:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc a (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc b (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/tail_calls.c:16
+	callq	_gcd
+# alloc t3 (4 bytes) at -12(%rbp)
+	movl	%eax, -12(%rbp)		# t3 = gcd()
+	movl	-4(%rbp), %eax		# %eax = a
+	cdq
+	idivl	-12(%rbp)		# %eax = a / t3
+	movl	%eax, %esi
+	imull	-8(%rbp), %esi		# %esi = %esi * b
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_is_even
+	.p2align	4, 0x90
+_is_even:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/tail_calls.c:20
+	movl	%edi, %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n == $0
+	jne	Lis_even_0
+	movl	$1, %eax		# %eax = $1
+	leave
+	retq
+Lis_even_0:
+# golden/tail_calls.c:22
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+	movl	%esi, %edi
+	callq	_is_odd
+# alloc t2 (4 bytes) at -8(%rbp)
+	leave
+	retq
+	.globl	_is_odd
+	.p2align	4, 0x90
+_is_odd:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/tail_calls.c:26
+	movl	%edi, %esi		# %esi = n
+	cmpl	$0, %esi		# %esi = n == $0
+	jne	Lis_odd_0
+	movl	$0, %eax		# %eax = $0
+	leave
+	retq
+Lis_odd_0:
+# golden/tail_calls.c:28
+	movl	-4(%rbp), %esi		# %esi = n
+	subl	$1, %esi		# %esi = n - $1
+	movl	%esi, %edi
+	callq	_is_even
+# alloc t2 (4 bytes) at -8(%rbp)
+	leave
+	retq
+	.globl	_count_digits
+	.p2align	4, 0x90
+_count_digits:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+# alloc n (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc count (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/tail_calls.c:32
+# alloc digits (40 bytes) at -48(%rbp)
+# golden/tail_calls.c:33
+	movl	%edi, %esi		# %esi = n
+	# %esi = n / $10
+	movl	$1717986919, %eax
+	imull	%esi
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, -48(%rbp)
+# golden/tail_calls.c:34
+	movl	%edx, %esi		# %esi = digits[$0]
+	cmpl	$0, %esi		# %esi = digits[$0] == $0
+	jne	Lcount_digits_0
+	movl	-8(%rbp), %esi		# %esi = count
+	addl	$1, %esi		# %esi = count + $1
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+Lcount_digits_0:
+# golden/tail_calls.c:36
+	movl	-48(%rbp), %esi		# %esi = digits[$0]
+# alloc t4 (4 bytes) at -52(%rbp)
+	movl	%esi, -52(%rbp)		# t4 = %esi
+	movl	-8(%rbp), %esi		# %esi = count
+	addl	$1, %esi		# %esi = count + $1
+	movl	-52(%rbp), %edi
+	callq	_count_digits
+	leave
+	retq
+	.globl	_power
+	.p2align	4, 0x90
+_power:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc base (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc exp (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc acc (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/tail_calls.c:40
+	cmpl	$0, %esi		# %esi = exp > $0
+	jle	Lpower_2
+Lpower_0:
+# golden/tail_calls.c:41
+	movl	-8(%rbp), %esi		# %esi = exp
+	# %esi = exp / $2
+	leal	1(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$1, %eax
+	movl	%eax, %esi
+	# %esi = %esi * $2
+	shll	$1, %esi
+	cmpl	-8(%rbp), %esi		# %esi = %esi == exp
+	jne	Lpower_3
+# golden/tail_calls.c:42
+	movl	-4(%rbp), %esi		# %esi = base
+	imull	-4(%rbp), %esi		# %esi = base * base
+# alloc t4 (4 bytes) at -16(%rbp)
+	movl	%esi, -16(%rbp)		# t4 = %esi
+	movl	-8(%rbp), %esi		# %esi = exp
+	# %esi = exp / $2
+	leal	1(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$1, %eax
+	movl	%eax, %esi
+	movl	-16(%rbp), %edi
+	movl	-12(%rbp), %edx
+	callq	_power
+	leave
+	retq
+Lpower_3:
+# golden/tail_calls.c:44
+	movl	-12(%rbp), %esi		# %esi = acc
+	imull	-4(%rbp), %esi		# %esi = acc * base
+	movl	%esi, -12(%rbp)		# acc = %esi
+# golden/tail_calls.c:45
+	movl	-8(%rbp), %esi		# %esi = exp
+	subl	$1, %esi		# %esi = exp - $1
+	movl	%esi, -8(%rbp)		# exp = %esi
+Lpower_1:
+	movl	-8(%rbp), %esi		# %esi = exp
+	cmpl	$0, %esi		# %esi = exp > $0
+	jg	Lpower_0
+Lpower_2:
+# golden/tail_calls.c:47
+	movl	-12(%rbp), %eax		# %eax = acc
+	leave
+	retq
@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+extern int sum_down(int n, int acc);
+extern int lcm(int a, int b);
+extern int is_even(int n);
+extern int is_odd(int n);
+extern int count_digits(int n, int count);
+extern int power(int base, int exp, int acc);
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(sum_down(0, 0));
+  print_expr(sum_down(10, 0));
+  print_expr(sum_down(50000, 7));
+  print_expr(lcm(4, 6));
+  print_expr(lcm(21, 35));
+  print_expr(is_even(0));
+  print_expr(is_even(10001));
+  print_expr(is_odd(30000));
+  print_expr(count_digits(7, 0));
+  print_expr(count_digits(2147483647, 0));
+  print_expr(power(3, 0, 1));
+  print_expr(power(3, 13, 1));
+  print_expr(power(-2, 10, 1));
+}
@@ -0,0 +1,170 @@
+	.globl	_sum_down
+	.p2align	4, 0x90
+_sum_down:
+	.p2align	4, 0x90
+Lsum_down_4:
+	cmpl	$0, %edi
+	jne	Lsum_down_2
+Lsum_down_3:
+	movl	%esi, %eax
+	retq
+Lsum_down_2:
+	movl	%edi, %r8d
+	subl	$1, %r8d
+	addl	%edi, %esi
+	movq	%r8, %rdi
+	jmp	Lsum_down_4
+	.p2align	4, 0x90
+_gcd:
+	.p2align	4, 0x90
+Lgcd_4:
+	cmpl	$0, %esi
+	jne	Lgcd_2
+Lgcd_3:
+	movl	%edi, %eax
+	retq
+Lgcd_2:
+	movl	%edi, %eax
+	cltd
+	idivl	%esi
+	movl	%eax, %r8d
+	imull	%esi, %r8d
+	subl	%r8d, %edi
+	movq	%rdi, %rax
+	movq	%rsi, %rdi
+	movq	%rax, %rsi
+	jmp	Lgcd_4
+	.globl	_lcm
+	.p2align	4, 0x90
+_lcm:
+Llcm_3:
+	movq	%rdi, %r8
+	movq	%rsi, %r9
+	.p2align	4, 0x90
+Llcm_4:
+	cmpl	$0, %r9d
+	jne	Llcm_5
+Llcm_2:
+	movl	%edi, %eax
+	cltd
+	idivl	%r8d
+	movl	%eax, %r10d
+	imull	%esi, %r10d
+	movl	%r10d, %eax
+	retq
+Llcm_5:
+	movl	%r8d, %eax
+	cltd
+	idivl	%r9d
+	movl	%eax, %r10d
+	imull	%r9d, %r10d
+	subl	%r10d, %r8d
+	movq	%r8, %rax
+	movq	%r9, %r8
+	movq	%rax, %r9
+	jmp	Llcm_4
+	.globl	_is_even
+	.p2align	4, 0x90
+_is_even:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	cmpl	$0, %edi
+	jne	Lis_even_2
+Lis_even_3:
+	movl	$1, %eax
+	leave
+	retq
+Lis_even_2:
+	movl	%edi, %esi
+	subl	$1, %esi
+	movq	%rsi, %rdi
+	leave
+	jmp	_is_odd
+	.globl	_is_odd
+	.p2align	4, 0x90
+_is_odd:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	cmpl	$0, %edi
+	jne	Lis_odd_2
+Lis_odd_3:
+	xorl	%eax, %eax
+	leave
+	retq
+Lis_odd_2:
+	movl	%edi, %esi
+	subl	$1, %esi
+	movq	%rsi, %rdi
+	leave
+	jmp	_is_even
+	.globl	_count_digits
+	.p2align	4, 0x90
+_count_digits:
+	.p2align	4, 0x90
+Lcount_digits_4:
+	movl	$1717986919, %eax
+	imull	%edi
+	sarl	$2, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	movl	%edi, -48(%rsp)
+	cmpl	$0, %edi
+	jne	Lcount_digits_2
+Lcount_digits_3:
+	movl	%esi, %r8d
+	addl	$1, %r8d
+	movl	%r8d, %eax
+	retq
+Lcount_digits_2:
+	addl	$1, %esi
+	jmp	Lcount_digits_4
+	.globl	_power
+	.p2align	4, 0x90
+_power:
+	pushq	%rbx
+	movq	%rdx, %r8
+	.p2align	4, 0x90
+Lpower_9:
+	cmpl	$0, %esi
+	jle	Lpower_11
+Lpower_5:
+	movq	%r8, %r9
+	.p2align	4, 0x90
+Lpower_2:
+	leal	1(%rsi), %eax
+	testl	%esi, %esi
+	cmovnsl	%esi, %eax
+	sarl	$1, %eax
+	movl	%eax, %r10d
+	movl	%r10d, %ebx
+	shll	$1, %ebx
+	cmpl	%esi, %ebx
+	je	Lpower_7
+Lpower_6:
+	movl	%r9d, %ebx
+	imull	%edi, %ebx
+	subl	$1, %esi
+Lpower_3:
+	cmpl	$0, %esi
+	jle	Lpower_8
+Lpower_10:
+	movq	%rbx, %r9
+	jmp	Lpower_2
+Lpower_8:
+	movq	%rbx, %rsi
+Lpower_4:
+	movl	%esi, %eax
+	popq	%rbx
+	retq
+Lpower_11:
+	movq	%r8, %rsi
+	jmp	Lpower_4
+Lpower_7:
+	movl	%edi, %r11d
+	imull	%edi, %r11d
+	movl	%r11d, %edi
+	movq	%r9, %r8
+	movq	%r10, %rsi
+	jmp	Lpower_9
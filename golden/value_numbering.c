@@ -0,0 +1,32 @@
+int grid[4][5][6];
+
+int same_index(int i, int j, int k) {
+  int a[4][5][6];
+  a[i][j][k] = i + j * k;
+  a[i][j][k] = a[i][j][k] + a[i][j][k] * (j * k);
+  return a[i][j][k] - i * (j * k);
+}
+
+int aliasing_store(int i) {
+  int a[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  int b[2] = {10, 20};
+  int first = a[1] + a[2];
+  b[1] = 30;
+  int second = a[1] + a[2];
+  a[i] = 100;
+  int third = a[1] + a[2];
+  return first * 10000 + second * 100 + third + b[1];
+}
+
+int repeated_math(int x, int y) {
+  int p = (x + y) * (x - y);
+  int q = (y + x) * (x - y);
+  int r = x * 12 / 5 + y * 12 / 5;
+  return p + q + r + x * 12 / 5;
+}
+
+int global_grid(int i, int j) {
+  grid[i][j][1] = i;
+  grid[i][j][2] = j;
+  return grid[i][j][1] + grid[i][j][2] + grid[i][j][1];
+}
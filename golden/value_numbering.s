@@ -0,0 +1,338 @@
+	.comm	_grid,480,2
+	.globl	_same_index
+	.p2align	4, 0x90
+_same_index:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$496, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc j (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# alloc k (4 bytes) at -12(%rbp)
+	movl	%edx, -12(%rbp)
+# golden/value_numbering.c:4
+# alloc a (480 bytes) at -492(%rbp)
+# golden/value_numbering.c:5
+	movl	%edi, %esi		# %esi = i
+	movl	-8(%rbp), %edi		# %edi = j
+	imull	-12(%rbp), %edi		# %edi = j * k
+	addl	%edi, %esi		# %esi = i + %edi
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	%edx, %r8d		# %r8d = k
+	# %r8d = k * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	movl	%esi, -492(%rbp,%rcx)		# a[i][j][k] = %esi
+# golden/value_numbering.c:6
+	movl	-8(%rbp), %esi		# %esi = j
+	# %esi = j * $24
+	leal	(%rsi,%rsi,2), %esi
+	shll	$3, %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $120
+	leal	(%rdi,%rdi,2), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$3, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-12(%rbp), %edi		# %edi = k
+	# %edi = k * $4
+	shll	$2, %edi
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movslq	%edi, %rcx
+	movl	-492(%rbp,%rcx), %esi		# %esi = a[i][j][k]
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	-12(%rbp), %r8d		# %r8d = k
+	# %r8d = k * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	movl	-492(%rbp,%rcx), %edi		# %edi = a[i][j][k]
+	movl	-8(%rbp), %r8d		# %r8d = j
+	imull	-12(%rbp), %r8d		# %r8d = j * k
+	imull	%r8d, %edi		# %edi = a[i][j][k] * %r8d
+	addl	%edi, %esi		# %esi = a[i][j][k] + %edi
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	-12(%rbp), %r8d		# %r8d = k
+	# %r8d = k * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	movl	%esi, -492(%rbp,%rcx)		# a[i][j][k] = %esi
+# golden/value_numbering.c:7
+	movl	-8(%rbp), %esi		# %esi = j
+	# %esi = j * $24
+	leal	(%rsi,%rsi,2), %esi
+	shll	$3, %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $120
+	leal	(%rdi,%rdi,2), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$3, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	-12(%rbp), %edi		# %edi = k
+	# %edi = k * $4
+	shll	$2, %edi
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movslq	%edi, %rcx
+	movl	-492(%rbp,%rcx), %esi		# %esi = a[i][j][k]
+	movl	-4(%rbp), %edi		# %edi = i
+	movl	-8(%rbp), %r8d		# %r8d = j
+	imull	-12(%rbp), %r8d		# %r8d = j * k
+	imull	%r8d, %edi		# %edi = i * %r8d
+	subl	%edi, %esi		# %esi = a[i][j][k] - %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_aliasing_store
+	.p2align	4, 0x90
+_aliasing_store:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# golden/value_numbering.c:11
+# alloc a (32 bytes) at -36(%rbp)
+	movl	$2,-32(%rbp)		# a[..4] = $2
+	movl	$3,-28(%rbp)		# a[..8] = $3
+# golden/value_numbering.c:12
+# alloc b (8 bytes) at -44(%rbp)
+# golden/value_numbering.c:13
+# alloc first (4 bytes) at -48(%rbp)
+	movl	$2, %esi		# %esi = a[$1]
+	addl	-28(%rbp), %esi		# %esi = a[$1] + a[$2]
+	movl	%esi, -48(%rbp)		# first = %esi
+# golden/value_numbering.c:14
+	movl	$30, -40(%rbp)		# b[$1] = $30
+# golden/value_numbering.c:15
+# alloc second (4 bytes) at -52(%rbp)
+	movl	$2, %esi		# %esi = a[$1]
+	addl	-28(%rbp), %esi		# %esi = a[$1] + a[$2]
+	movl	%esi, -52(%rbp)		# second = %esi
+# golden/value_numbering.c:16
+	movslq	-4(%rbp), %rcx
+	movl	$100, -36(%rbp,%rcx,4)		# a[i] = $100
+# golden/value_numbering.c:17
+# alloc third (4 bytes) at -56(%rbp)
+	movl	-32(%rbp), %esi		# %esi = a[$1]
+	addl	-28(%rbp), %esi		# %esi = a[$1] + a[$2]
+	movl	%esi, -56(%rbp)		# third = %esi
+# golden/value_numbering.c:18
+	movl	-48(%rbp), %esi		# %esi = first
+	imull	$10000, %esi		# %esi = first * $10000
+	movl	-52(%rbp), %edi		# %edi = second
+	# %edi = second * $100
+	leal	(%rdi,%rdi,4), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$2, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	addl	-56(%rbp), %esi		# %esi = %esi + third
+	addl	-40(%rbp), %esi		# %esi = %esi + b[$1]
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_repeated_math
+	.p2align	4, 0x90
+_repeated_math:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+# alloc x (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc y (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/value_numbering.c:22
+# alloc p (4 bytes) at -12(%rbp)
+	movl	%edi, %esi		# %esi = x
+	addl	-8(%rbp), %esi		# %esi = x + y
+	subl	-8(%rbp), %edi		# %edi = x - y
+	imull	%edi, %esi		# %esi = %esi * %edi
+	movl	%esi, -12(%rbp)		# p = %esi
+# golden/value_numbering.c:23
+# alloc q (4 bytes) at -16(%rbp)
+	movl	-8(%rbp), %esi		# %esi = y
+	addl	-4(%rbp), %esi		# %esi = y + x
+	movl	-4(%rbp), %edi		# %edi = x
+	subl	-8(%rbp), %edi		# %edi = x - y
+	imull	%edi, %esi		# %esi = %esi * %edi
+	movl	%esi, -16(%rbp)		# q = %esi
+# golden/value_numbering.c:24
+# alloc r (4 bytes) at -20(%rbp)
+	movl	-4(%rbp), %esi		# %esi = x
+	# %esi = x * $12
+	leal	(%rsi,%rsi,2), %esi
+	shll	$2, %esi
+	# %esi = %esi / $5
+	movl	$1717986919, %eax
+	imull	%esi
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %esi
+	movl	-8(%rbp), %edi		# %edi = y
+	# %edi = y * $12
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	# %edi = %edi / $5
+	movl	$1717986919, %eax
+	imull	%edi
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, -20(%rbp)		# r = %esi
+# golden/value_numbering.c:25
+	movl	-12(%rbp), %esi		# %esi = p
+	addl	-16(%rbp), %esi		# %esi = p + q
+	addl	-20(%rbp), %esi		# %esi = %esi + r
+	movl	-4(%rbp), %edi		# %edi = x
+	# %edi = x * $12
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	# %edi = %edi / $5
+	movl	$1717986919, %eax
+	imull	%edi
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
+	.globl	_global_grid
+	.p2align	4, 0x90
+_global_grid:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+# alloc i (4 bytes) at -4(%rbp)
+	movl	%edi, -4(%rbp)
+# alloc j (4 bytes) at -8(%rbp)
+	movl	%esi, -8(%rbp)
+# golden/value_numbering.c:29
+	movl	%edi, %esi		# %esi = i
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	$1, %r8d		# %r8d = $1
+	# %r8d = $1 * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	leaq	_grid(%rip), %r10
+	movl	%esi, (%r10,%rcx)		# grid[i][j][$1] = %esi
+# golden/value_numbering.c:30
+	movl	-8(%rbp), %esi		# %esi = j
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	$2, %r8d		# %r8d = $2
+	# %r8d = $2 * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	leaq	_grid(%rip), %r10
+	movl	%esi, (%r10,%rcx)		# grid[i][j][$2] = %esi
+# golden/value_numbering.c:31
+	movl	-8(%rbp), %esi		# %esi = j
+	# %esi = j * $24
+	leal	(%rsi,%rsi,2), %esi
+	shll	$3, %esi
+	movl	-4(%rbp), %edi		# %edi = i
+	# %edi = i * $120
+	leal	(%rdi,%rdi,2), %edi
+	leal	(%rdi,%rdi,4), %edi
+	shll	$3, %edi
+	addl	%edi, %esi		# %esi = %esi + %edi
+	movl	$1, %edi		# %edi = $1
+	# %edi = $1 * $4
+	shll	$2, %edi
+	addl	%esi, %edi		# %edi = %edi + %esi
+	movslq	%edi, %rcx
+	leaq	_grid(%rip), %r10
+	movl	(%r10,%rcx), %esi		# %esi = grid[i][j][$1]
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	$2, %r8d		# %r8d = $2
+	# %r8d = $2 * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	leaq	_grid(%rip), %r10
+	addl	(%r10,%rcx), %esi
+	movl	-8(%rbp), %edi		# %edi = j
+	# %edi = j * $24
+	leal	(%rdi,%rdi,2), %edi
+	shll	$3, %edi
+	movl	-4(%rbp), %r8d		# %r8d = i
+	# %r8d = i * $120
+	leal	(%r8,%r8,2), %r8d
+	leal	(%r8,%r8,4), %r8d
+	shll	$3, %r8d
+	addl	%r8d, %edi		# %edi = %edi + %r8d
+	movl	$1, %r8d		# %r8d = $1
+	# %r8d = $1 * $4
+	shll	$2, %r8d
+	addl	%edi, %r8d		# %r8d = %r8d + %edi
+	movslq	%r8d, %rcx
+	leaq	_grid(%rip), %r10
+	addl	(%r10,%rcx), %esi
+	movl	%esi, %eax		# %eax = %esi
+	leave
+	retq
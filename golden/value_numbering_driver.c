@@ -0,0 +1,28 @@
+#include <stdio.h>
+
+extern int same_index(int i, int j, int k);
+extern int aliasing_store(int i);
+extern int repeated_math(int x, int y);
+extern int global_grid(int i, int j);
+extern int grid[4][5][6];
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(same_index(0, 0, 0));
+  print_expr(same_index(3, 4, 5));
+  print_expr(same_index(1, 2, 3));
+  print_expr(aliasing_store(0));
+  print_expr(aliasing_store(1));
+  print_expr(aliasing_store(2));
+  print_expr(aliasing_store(7));
+  print_expr(repeated_math(7, 3));
+  print_expr(repeated_math(-11, 4));
+  print_expr(global_grid(2, 3));
+  print_expr(global_grid(3, 4));
+  print_expr(grid[2][3][1]);
+  print_expr(grid[2][3][2]);
+  print_expr(grid[3][4][1]);
+  print_expr(grid[3][4][2]);
+  print_expr(grid[2][3][0]);
+}
@@ -0,0 +1,114 @@
+	.comm	_grid,480,2
+	.globl	_same_index
+	.p2align	4, 0x90
+_same_index:
+	subq	$488, %rsp
+	movq	%rdx, %r8
+	movslq	%edi, %r9
+	leaq	(%r9,%r9,2), %r9
+	leaq	(%r9,%r9,4), %r9
+	shlq	$3, %r9
+	leaq	0(%rsp), %rax
+	addq	%rax, %r9
+	movslq	%esi, %r10
+	leaq	(%r10,%r10,2), %r10
+	shlq	$3, %r10
+	addq	%r10, %r9
+	movslq	%r8d, %r10
+	shlq	$2, %r10
+	addq	%r10, %r9
+	imull	%r8d, %esi
+	movl	%edi, %r8d
+	addl	%esi, %r8d
+	movl	%r8d, %r10d
+	imull	%esi, %r10d
+	addl	%r10d, %r8d
+	movl	%r8d, (%r9)
+	imull	%edi, %esi
+	movl	%r8d, %r11d
+	subl	%esi, %r11d
+	movl	%r11d, %eax
+	addq	$488, %rsp
+	retq
+	.globl	_aliasing_store
+	.p2align	4, 0x90
+_aliasing_store:
+	movl	$2, -36(%rsp)
+	movl	$3, -32(%rsp)
+	movl	$2, %esi
+	addl	$3, %esi
+	movslq	%edi, %rdi
+	shlq	$2, %rdi
+	leaq	-40(%rsp), %rax
+	addq	%rax, %rdi
+	movl	$100, (%rdi)
+	movl	-36(%rsp), %edi
+	addl	-32(%rsp), %edi
+	movl	%esi, %r8d
+	imull	$10000, %r8d
+	leal	(%rsi,%rsi,4), %esi
+	leal	(%rsi,%rsi,4), %esi
+	shll	$2, %esi
+	addl	%r8d, %esi
+	addl	%edi, %esi
+	addl	$30, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_repeated_math
+	.p2align	4, 0x90
+_repeated_math:
+	movl	%edi, %r8d
+	addl	%esi, %r8d
+	movl	%edi, %r9d
+	subl	%esi, %r9d
+	imull	%r9d, %r8d
+	leal	(%rdi,%rdi,2), %edi
+	shll	$2, %edi
+	movl	$1717986919, %eax
+	imull	%edi
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %edi
+	leal	(%rsi,%rsi,2), %esi
+	shll	$2, %esi
+	movl	$1717986919, %eax
+	imull	%esi
+	sarl	$1, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	movl	%edx, %esi
+	addl	%edi, %esi
+	movl	%r8d, %r11d
+	addl	%r8d, %r11d
+	movl	%r11d, %r8d
+	addl	%r8d, %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
+	.globl	_global_grid
+	.p2align	4, 0x90
+_global_grid:
+	movslq	%edi, %r8
+	leaq	(%r8,%r8,2), %r8
+	leaq	(%r8,%r8,4), %r8
+	shlq	$3, %r8
+	leaq	_grid(%rip), %rax
+	addq	%rax, %r8
+	movslq	%esi, %r9
+	leaq	(%r9,%r9,2), %r9
+	shlq	$3, %r9
+	addq	%r9, %r8
+	movq	%r8, %r9
+	addq	$4, %r9
+	movl	%edi, (%r9)
+	movq	%r8, %rdi
+	addq	$8, %rdi
+	movl	%esi, (%rdi)
+	movl	(%r9), %edi
+	addl	%edi, %esi
+	addl	%edi, %esi
+	movl	%esi, %eax
+	retq
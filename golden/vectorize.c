@@ -0,0 +1,104 @@
+int totals[40];
+
+int sum_squares(int n) {
+  int a[64];
+  for (int i = 0; i < 64; i++) {
+    a[i] = i * i - 50;
+  }
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += a[i];
+  }
+  return sum;
+}
+
+int mix(int n, int k) {
+  int a[64];
+  int b[64];
+  int c[64];
+  for (int i = 0; i < 64; i++) {
+    a[i] = i * 7 - 100;
+    b[i] = 3 - i;
+  }
+  for (int i = 0; i < n; i++) {
+    int mixed = a[i] * k + b[i];
+    int shifted = a[i];
+    shifted <<= 3;
+    mixed ^= shifted;
+    c[i] = mixed;
+  }
+  for (int i = 0; i < n; i++) {
+    int high = c[i];
+    high >>= 2;
+    int low = b[i];
+    low &= 12;
+    high -= low;
+    high |= 1;
+    b[i] = high;
+  }
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum = sum - c[i] + b[i] * 2;
+  }
+  return sum;
+}
+
+int from_to(int start, int end, int scale) {
+  int a[64];
+  for (int i = 0; i < 64; i++) {
+    a[i] = i;
+  }
+  for (int i = start; i <= end; i++) {
+    a[i] = a[i] * scale + 1;
+  }
+  int sum = 0;
+  int odd = 0;
+  for (int i = 0; i < 64; i++) {
+    sum += a[i];
+    int bit = a[i];
+    bit &= 1;
+    odd += bit;
+  }
+  return sum * 100 + odd;
+}
+
+int global_running(int n) {
+  for (int i = 0; i < 40; i++) {
+    totals[i] = i * 11 % 17;
+  }
+  for (int i = 0; i < n; i++) {
+    totals[i] = totals[i] * 2 + n;
+  }
+  int sum = 0;
+  for (int i = 0; i < 40; i++) {
+    sum += totals[i];
+  }
+  return sum;
+}
+
+int shifted(int n) {
+  int a[64];
+  for (int i = 0; i < 64; i++) {
+    a[i] = i + 1;
+  }
+  for (int i = 0; i < n; i++) {
+    a[i + 1] = a[i] + a[i + 1];
+  }
+  return a[n];
+}
+
+int short_loops(void) {
+  int a[16];
+  for (int i = 0; i < 16; i++) {
+    a[i] = 16 - i;
+  }
+  int three = 0;
+  for (int i = 0; i < 3; i++) {
+    three += a[i];
+  }
+  int ten = 0;
+  for (int i = 2; i < 12; i++) {
+    ten += a[i];
+  }
+  return three * 1000 + ten;
+}
@@ -0,0 +1,35 @@
+#include <stdio.h>
+
+extern int sum_squares(int n);
+extern int mix(int n, int k);
+extern int from_to(int start, int end, int scale);
+extern int global_running(int n);
+extern int shifted(int n);
+extern int short_loops(void);
+
+#define print_expr(expr) printf(#expr " = %d\n", (expr))
+
+int main(int argc, char *argv[]) {
+  print_expr(sum_squares(0));
+  print_expr(sum_squares(1));
+  print_expr(sum_squares(4));
+  print_expr(sum_squares(5));
+  print_expr(sum_squares(31));
+  print_expr(sum_squares(64));
+  print_expr(mix(0, 3));
+  print_expr(mix(3, -5));
+  print_expr(mix(8, 9));
+  print_expr(mix(17, 2));
+  print_expr(mix(64, -1));
+  print_expr(from_to(0, 63, 2));
+  print_expr(from_to(5, 5, 3));
+  print_expr(from_to(9, 4, 3));
+  print_expr(from_to(3, 40, -7));
+  print_expr(global_running(0));
+  print_expr(global_running(7));
+  print_expr(global_running(40));
+  print_expr(shifted(0));
+  print_expr(shifted(9));
+  print_expr(shifted(40));
+  print_expr(short_loops());
+}
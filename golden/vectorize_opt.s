@@ -0,0 +1,729 @@
+	.comm	_totals,160,2
+	.globl	_sum_squares
+	.p2align	4, 0x90
+_sum_squares:
+	subq	$264, %rsp
+Lsum_squares_5:
+	xorl	%esi, %esi
+	leaq	0(%rsp), %r8
+	.p2align	4, 0x90
+Lsum_squares_2:
+	movl	%esi, %r9d
+	imull	%esi, %r9d
+	subl	$50, %r9d
+	movl	%r9d, (%r8)
+Lsum_squares_3:
+	addl	$1, %esi
+	addq	$4, %r8
+	cmpl	$64, %esi
+	jl	Lsum_squares_2
+Lsum_squares_4:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lsum_squares_17
+Lsum_squares_10:
+	movslq	%edi, %rsi
+	subq	$4, %rsi
+	xorl	%r11d, %r11d
+	cmpq	%rsi, %r11
+	jge	Lsum_squares_19
+Lsum_squares_13:
+	pxor	%xmm0, %xmm0
+	xorl	%r8d, %r8d
+	leaq	0(%rsp), %r9
+	.p2align	4, 0x90
+Lsum_squares_14:
+	movdqu	(%r9), %xmm1
+	paddd	%xmm1, %xmm0
+	addq	$4, %r8
+	addq	$16, %r9
+	cmpq	%rsi, %r8
+	jl	Lsum_squares_14
+Lsum_squares_15:
+	movl	%r8d, %esi
+	movdqa	%xmm0, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %r8d
+Lsum_squares_12:
+	movslq	%esi, %r9
+	shlq	$2, %r9
+	leaq	0(%rsp), %rax
+	addq	%rax, %r9
+	.p2align	4, 0x90
+Lsum_squares_7:
+	movl	(%r9), %r10d
+	addl	%r10d, %r8d
+Lsum_squares_8:
+	addl	$1, %esi
+	addq	$4, %r9
+	cmpl	%edi, %esi
+	jl	Lsum_squares_7
+Lsum_squares_9:
+	movl	%r8d, %eax
+	addq	$264, %rsp
+	retq
+Lsum_squares_17:
+	xorl	%r8d, %r8d
+	jmp	Lsum_squares_9
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lsum_squares_19:
+	xorl	%esi, %esi
+	xorl	%r8d, %r8d
+	jmp	Lsum_squares_12
+	.text
+	.globl	_mix
+	.p2align	4, 0x90
+_mix:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	pushq	%r15
+	subq	$768, %rsp
+Lmix_5:
+	xorl	%r8d, %r8d
+	leaq	256(%rsp), %r10
+	leaq	512(%rsp), %r9
+	.p2align	4, 0x90
+Lmix_2:
+	movl	%r8d, %ebx
+	movl	%ebx, %eax
+	shll	$3, %ebx
+	subl	%eax, %ebx
+	subl	$100, %ebx
+	movl	%ebx, (%r9)
+	movl	$3, %ebx
+	subl	%r8d, %ebx
+	movl	%ebx, (%r10)
+Lmix_3:
+	addl	$1, %r8d
+	addq	$4, %r10
+	addq	$4, %r9
+	cmpl	$64, %r8d
+	jl	Lmix_2
+Lmix_4:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	setl	%al
+	movzbl	%al, %eax
+	movl	%eax, %r8d
+	testl	%r8d, %r8d
+	je	Lmix_9
+Lmix_10:
+	movslq	%edi, %r9
+	subq	$4, %r9
+	xorl	%r11d, %r11d
+	cmpq	%r9, %r11
+	jge	Lmix_38
+Lmix_23:
+	movd	%esi, %xmm0
+	pshufd	$0, %xmm0, %xmm0
+	xorl	%r10d, %r10d
+	leaq	0(%rsp), %r13
+	leaq	256(%rsp), %r12
+	leaq	512(%rsp), %rbx
+	.p2align	4, 0x90
+Lmix_24:
+	movdqu	(%rbx), %xmm1
+	movdqa	%xmm1, %xmm15
+	movdqa	%xmm0, %xmm14
+	movdqa	%xmm1, %xmm13
+	pmuludq	%xmm14, %xmm15
+	psrlq	$32, %xmm14
+	psrlq	$32, %xmm13
+	pmuludq	%xmm14, %xmm13
+	pshufd	$8, %xmm15, %xmm15
+	pshufd	$8, %xmm13, %xmm13
+	punpckldq	%xmm13, %xmm15
+	movdqa	%xmm15, %xmm2
+	movdqu	(%r12), %xmm3
+	paddd	%xmm3, %xmm2
+	pslld	$3, %xmm1
+	pxor	%xmm2, %xmm1
+	movdqu	%xmm1, (%r13)
+	addq	$4, %r10
+	addq	$16, %r13
+	addq	$16, %r12
+	addq	$16, %rbx
+	cmpq	%r9, %r10
+	jl	Lmix_24
+Lmix_25:
+	movl	%r10d, %r9d
+Lmix_22:
+	movslq	%r9d, %r10
+	shlq	$2, %r10
+	leaq	512(%rsp), %rax
+	addq	%rax, %r10
+	movslq	%r9d, %rbx
+	shlq	$2, %rbx
+	leaq	256(%rsp), %rax
+	addq	%rax, %rbx
+	movslq	%r9d, %r12
+	shlq	$2, %r12
+	leaq	0(%rsp), %rax
+	addq	%rax, %r12
+	.p2align	4, 0x90
+Lmix_7:
+	movl	(%r10), %r13d
+	movl	%r13d, %r14d
+	imull	%esi, %r14d
+	movl	(%rbx), %r15d
+	addl	%r15d, %r14d
+	shll	$3, %r13d
+	xorl	%r14d, %r13d
+	movl	%r13d, (%r12)
+Lmix_8:
+	addl	$1, %r9d
+	addq	$4, %r12
+	addq	$4, %rbx
+	addq	$4, %r10
+	cmpl	%edi, %r9d
+	jl	Lmix_7
+Lmix_9:
+	testl	%r8d, %r8d
+	je	Lmix_14
+Lmix_15:
+	movslq	%edi, %r9
+	subq	$4, %r9
+	xorl	%r11d, %r11d
+	cmpq	%r9, %r11
+	jge	Lmix_41
+Lmix_27:
+	movl	$12, %eax
+	movd	%eax, %xmm0
+	pshufd	$0, %xmm0, %xmm0
+	movl	$1, %eax
+	movd	%eax, %xmm1
+	pshufd	$0, %xmm1, %xmm1
+	xorl	%r10d, %r10d
+	leaq	256(%rsp), %r12
+	leaq	0(%rsp), %rbx
+	.p2align	4, 0x90
+Lmix_28:
+	movdqu	(%rbx), %xmm2
+	psrad	$2, %xmm2
+	movdqu	(%r12), %xmm3
+	pand	%xmm0, %xmm3
+	psubd	%xmm3, %xmm2
+	por	%xmm1, %xmm2
+	movdqu	%xmm2, (%r12)
+	addq	$4, %r10
+	addq	$16, %r12
+	addq	$16, %rbx
+	cmpq	%r9, %r10
+	jl	Lmix_28
+Lmix_29:
+	movl	%r10d, %r9d
+Lmix_26:
+	movslq	%r9d, %r10
+	shlq	$2, %r10
+	leaq	0(%rsp), %rax
+	addq	%rax, %r10
+	movslq	%r9d, %rbx
+	shlq	$2, %rbx
+	leaq	256(%rsp), %rax
+	addq	%rax, %rbx
+	.p2align	4, 0x90
+Lmix_12:
+	movl	(%r10), %r12d
+	sarl	$2, %r12d
+	movl	(%rbx), %r13d
+	andl	$12, %r13d
+	subl	%r13d, %r12d
+	orl	$1, %r12d
+	movl	%r12d, (%rbx)
+Lmix_13:
+	addl	$1, %r9d
+	addq	$4, %rbx
+	addq	$4, %r10
+	cmpl	%edi, %r9d
+	jl	Lmix_12
+Lmix_14:
+	testl	%r8d, %r8d
+	je	Lmix_40
+Lmix_20:
+	movslq	%edi, %r9
+	subq	$4, %r9
+	xorl	%r11d, %r11d
+	cmpq	%r9, %r11
+	jge	Lmix_43
+Lmix_31:
+	movl	$2, %eax
+	movd	%eax, %xmm0
+	pshufd	$0, %xmm0, %xmm0
+	pxor	%xmm1, %xmm1
+	xorl	%r10d, %r10d
+	leaq	256(%rsp), %r12
+	leaq	0(%rsp), %rbx
+	.p2align	4, 0x90
+Lmix_32:
+	movdqu	(%rbx), %xmm2
+	psubd	%xmm2, %xmm1
+	movdqu	(%r12), %xmm2
+	movdqa	%xmm2, %xmm15
+	movdqa	%xmm0, %xmm14
+	movdqa	%xmm2, %xmm13
+	pmuludq	%xmm14, %xmm15
+	psrlq	$32, %xmm14
+	psrlq	$32, %xmm13
+	pmuludq	%xmm14, %xmm13
+	pshufd	$8, %xmm15, %xmm15
+	pshufd	$8, %xmm13, %xmm13
+	punpckldq	%xmm13, %xmm15
+	movdqa	%xmm15, %xmm2
+	paddd	%xmm2, %xmm1
+	addq	$4, %r10
+	addq	$16, %r12
+	addq	$16, %rbx
+	cmpq	%r9, %r10
+	jl	Lmix_32
+Lmix_33:
+	movl	%r10d, %r9d
+	movdqa	%xmm1, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %r10d
+Lmix_30:
+	movslq	%r9d, %rbx
+	shlq	$2, %rbx
+	leaq	0(%rsp), %rax
+	addq	%rax, %rbx
+	movslq	%r9d, %r12
+	shlq	$2, %r12
+	leaq	256(%rsp), %rax
+	addq	%rax, %r12
+	.p2align	4, 0x90
+Lmix_17:
+	subl	(%rbx), %r10d
+	movl	(%r12), %r13d
+	shll	$1, %r13d
+	addl	%r13d, %r10d
+Lmix_18:
+	addl	$1, %r9d
+	addq	$4, %r12
+	addq	$4, %rbx
+	cmpl	%edi, %r9d
+	jl	Lmix_17
+Lmix_19:
+	movl	%r10d, %eax
+	addq	$768, %rsp
+	popq	%r15
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+Lmix_40:
+	xorl	%r10d, %r10d
+	jmp	Lmix_19
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lmix_38:
+	xorl	%r9d, %r9d
+	jmp	Lmix_22
+Lmix_41:
+	xorl	%r9d, %r9d
+	jmp	Lmix_26
+Lmix_43:
+	xorl	%r9d, %r9d
+	xorl	%r10d, %r10d
+	jmp	Lmix_30
+	.text
+	.globl	_from_to
+	.p2align	4, 0x90
+_from_to:
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	subq	$256, %rsp
+	movq	%rdx, %r8
+Lfrom_to_5:
+	xorl	%r9d, %r9d
+	leaq	0(%rsp), %r10
+	.p2align	4, 0x90
+Lfrom_to_2:
+	movl	%r9d, (%r10)
+Lfrom_to_3:
+	addl	$1, %r9d
+	addq	$4, %r10
+	cmpl	$64, %r9d
+	jl	Lfrom_to_2
+Lfrom_to_4:
+	cmpl	%esi, %edi
+	jg	Lfrom_to_15
+Lfrom_to_10:
+	movslq	%edi, %r9
+	movslq	%esi, %r10
+	subq	$4, %r10
+	cmpq	%r10, %r9
+	jg	Lfrom_to_28
+Lfrom_to_18:
+	movd	%r8d, %xmm0
+	pshufd	$0, %xmm0, %xmm0
+	movl	$1, %eax
+	movd	%eax, %xmm1
+	pshufd	$0, %xmm1, %xmm1
+	movq	%r9, %rbx
+	shlq	$2, %rbx
+	leaq	0(%rsp), %rax
+	addq	%rax, %rbx
+	.p2align	4, 0x90
+Lfrom_to_19:
+	movdqu	(%rbx), %xmm2
+	movdqa	%xmm2, %xmm15
+	movdqa	%xmm0, %xmm14
+	movdqa	%xmm2, %xmm13
+	pmuludq	%xmm14, %xmm15
+	psrlq	$32, %xmm14
+	psrlq	$32, %xmm13
+	pmuludq	%xmm14, %xmm13
+	pshufd	$8, %xmm15, %xmm15
+	pshufd	$8, %xmm13, %xmm13
+	punpckldq	%xmm13, %xmm15
+	movdqa	%xmm15, %xmm2
+	paddd	%xmm1, %xmm2
+	movdqu	%xmm2, (%rbx)
+	addq	$4, %r9
+	addq	$16, %rbx
+	cmpq	%r10, %r9
+	jle	Lfrom_to_19
+Lfrom_to_20:
+Lfrom_to_17:
+	movslq	%r9d, %r10
+	shlq	$2, %r10
+	leaq	0(%rsp), %rax
+	addq	%rax, %r10
+	.p2align	4, 0x90
+Lfrom_to_7:
+	movl	(%r10), %ebx
+	imull	%r8d, %ebx
+	addl	$1, %ebx
+	movl	%ebx, (%r10)
+Lfrom_to_8:
+	addl	$1, %r9d
+	addq	$4, %r10
+	cmpl	%esi, %r9d
+	jle	Lfrom_to_7
+Lfrom_to_15:
+Lfrom_to_22:
+	movl	$1, %eax
+	movd	%eax, %xmm0
+	pshufd	$0, %xmm0, %xmm0
+	pxor	%xmm1, %xmm1
+	pxor	%xmm2, %xmm2
+	xorl	%r9d, %r9d
+	leaq	0(%rsp), %r10
+	.p2align	4, 0x90
+Lfrom_to_23:
+	movdqu	(%r10), %xmm3
+	paddd	%xmm3, %xmm1
+	pand	%xmm0, %xmm3
+	paddd	%xmm3, %xmm2
+	addq	$4, %r9
+	addq	$16, %r10
+	cmpq	$60, %r9
+	jl	Lfrom_to_23
+Lfrom_to_24:
+	movdqa	%xmm1, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %r10d
+	movdqa	%xmm2, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %ebx
+Lfrom_to_21:
+	movslq	%r9d, %r12
+	shlq	$2, %r12
+	leaq	0(%rsp), %rax
+	addq	%rax, %r12
+	.p2align	4, 0x90
+Lfrom_to_12:
+	movl	(%r12), %r13d
+	addl	%r13d, %r10d
+	andl	$1, %r13d
+	addl	%r13d, %ebx
+Lfrom_to_13:
+	addl	$1, %r9d
+	addq	$4, %r12
+	cmpl	$64, %r9d
+	jl	Lfrom_to_12
+Lfrom_to_14:
+	movl	%r10d, %r9d
+	leal	(%r9,%r9,4), %r9d
+	leal	(%r9,%r9,4), %r9d
+	shll	$2, %r9d
+	addl	%ebx, %r9d
+	movl	%r9d, %eax
+	addq	$256, %rsp
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	retq
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lfrom_to_28:
+	movq	%rdi, %r9
+	jmp	Lfrom_to_17
+	.text
+	.globl	_global_running
+	.p2align	4, 0x90
+_global_running:
+Lglobal_running_5:
+	xorl	%esi, %esi
+	leaq	_totals(%rip), %r8
+	.p2align	4, 0x90
+Lglobal_running_2:
+	movl	%esi, %r9d
+	imull	$11, %r9d
+	movl	$2021161081, %eax
+	imull	%r9d
+	sarl	$3, %edx
+	movl	%edx, %eax
+	shrl	$31, %eax
+	addl	%eax, %edx
+	imull	$17, %edx, %edx
+	subl	%edx, %r9d
+	movl	%r9d, (%r8)
+Lglobal_running_3:
+	addl	$1, %esi
+	addq	$4, %r8
+	cmpl	$40, %esi
+	jl	Lglobal_running_2
+Lglobal_running_4:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lglobal_running_15
+Lglobal_running_10:
+	movslq	%edi, %rsi
+	subq	$4, %rsi
+	xorl	%r11d, %r11d
+	cmpq	%rsi, %r11
+	jge	Lglobal_running_28
+Lglobal_running_18:
+	movl	$2, %eax
+	movd	%eax, %xmm0
+	pshufd	$0, %xmm0, %xmm0
+	movd	%edi, %xmm1
+	pshufd	$0, %xmm1, %xmm1
+	xorl	%r8d, %r8d
+	leaq	_totals(%rip), %r9
+	.p2align	4, 0x90
+Lglobal_running_19:
+	movdqu	(%r9), %xmm2
+	movdqa	%xmm2, %xmm15
+	movdqa	%xmm0, %xmm14
+	movdqa	%xmm2, %xmm13
+	pmuludq	%xmm14, %xmm15
+	psrlq	$32, %xmm14
+	psrlq	$32, %xmm13
+	pmuludq	%xmm14, %xmm13
+	pshufd	$8, %xmm15, %xmm15
+	pshufd	$8, %xmm13, %xmm13
+	punpckldq	%xmm13, %xmm15
+	movdqa	%xmm15, %xmm2
+	paddd	%xmm1, %xmm2
+	movdqu	%xmm2, (%r9)
+	addq	$4, %r8
+	addq	$16, %r9
+	cmpq	%rsi, %r8
+	jl	Lglobal_running_19
+Lglobal_running_20:
+	movl	%r8d, %esi
+Lglobal_running_17:
+	movslq	%esi, %r8
+	shlq	$2, %r8
+	leaq	_totals(%rip), %rax
+	addq	%rax, %r8
+	.p2align	4, 0x90
+Lglobal_running_7:
+	movl	(%r8), %r9d
+	shll	$1, %r9d
+	addl	%edi, %r9d
+	movl	%r9d, (%r8)
+Lglobal_running_8:
+	addl	$1, %esi
+	addq	$4, %r8
+	cmpl	%edi, %esi
+	jl	Lglobal_running_7
+Lglobal_running_15:
+Lglobal_running_22:
+	pxor	%xmm0, %xmm0
+	xorl	%esi, %esi
+	leaq	_totals(%rip), %r8
+	.p2align	4, 0x90
+Lglobal_running_23:
+	movdqu	(%r8), %xmm1
+	paddd	%xmm1, %xmm0
+	addq	$4, %rsi
+	addq	$16, %r8
+	cmpq	$36, %rsi
+	jl	Lglobal_running_23
+Lglobal_running_24:
+	movdqa	%xmm0, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %r8d
+Lglobal_running_21:
+	movslq	%esi, %r9
+	shlq	$2, %r9
+	leaq	_totals(%rip), %rax
+	addq	%rax, %r9
+	.p2align	4, 0x90
+Lglobal_running_12:
+	movl	(%r9), %r10d
+	addl	%r10d, %r8d
+Lglobal_running_13:
+	addl	$1, %esi
+	addq	$4, %r9
+	cmpl	$40, %esi
+	jl	Lglobal_running_12
+Lglobal_running_14:
+	movl	%r8d, %eax
+	retq
+	.section	__TEXT,__text_unlikely,regular,pure_instructions
+Lglobal_running_28:
+	xorl	%esi, %esi
+	jmp	Lglobal_running_17
+	.text
+	.globl	_shifted
+	.p2align	4, 0x90
+_shifted:
+	pushq	%rbx
+	subq	$256, %rsp
+Lshifted_5:
+	xorl	%esi, %esi
+	leaq	0(%rsp), %r8
+	.p2align	4, 0x90
+Lshifted_2:
+	addl	$1, %esi
+	movq	%r8, %r9
+	addq	$4, %r9
+	movl	%esi, (%r8)
+Lshifted_3:
+	cmpl	$64, %esi
+	jge	Lshifted_4
+Lshifted_12:
+	movq	%r9, %r8
+	jmp	Lshifted_2
+Lshifted_4:
+	xorl	%r11d, %r11d
+	cmpl	%edi, %r11d
+	jge	Lshifted_9
+Lshifted_10:
+	xorl	%esi, %esi
+	leaq	0(%rsp), %r8
+	.p2align	4, 0x90
+Lshifted_7:
+	addl	$1, %esi
+	movq	%r8, %r9
+	addq	$4, %r9
+	movslq	%esi, %r10
+	shlq	$2, %r10
+	leaq	0(%rsp), %rax
+	addq	%rax, %r10
+	movl	(%r8), %r8d
+	movl	(%r10), %ebx
+	addl	%ebx, %r8d
+	movl	%r8d, (%r10)
+Lshifted_8:
+	cmpl	%edi, %esi
+	jge	Lshifted_9
+Lshifted_14:
+	movq	%r9, %r8
+	jmp	Lshifted_7
+Lshifted_9:
+	movslq	%edi, %rsi
+	shlq	$2, %rsi
+	leaq	0(%rsp), %rax
+	addq	%rax, %rsi
+	movl	(%rsi), %eax
+	addq	$256, %rsp
+	popq	%rbx
+	retq
+	.globl	_short_loops
+	.p2align	4, 0x90
+_short_loops:
+Lshort_loops_5:
+	xorl	%esi, %esi
+	leaq	-72(%rsp), %rdi
+	.p2align	4, 0x90
+Lshort_loops_2:
+	movl	$16, %r8d
+	subl	%esi, %r8d
+	movl	%r8d, (%rdi)
+Lshort_loops_3:
+	addl	$1, %esi
+	addq	$4, %rdi
+	cmpl	$16, %esi
+	jl	Lshort_loops_2
+Lshort_loops_4:
+Lshort_loops_10:
+	xorl	%esi, %esi
+	leaq	-72(%rsp), %r8
+	xorl	%edi, %edi
+	.p2align	4, 0x90
+Lshort_loops_7:
+	movl	(%r8), %r9d
+	addl	%r9d, %edi
+Lshort_loops_8:
+	addl	$1, %esi
+	addq	$4, %r8
+	cmpl	$3, %esi
+	jl	Lshort_loops_7
+Lshort_loops_9:
+Lshort_loops_15:
+Lshort_loops_18:
+	pxor	%xmm0, %xmm0
+	movq	$2, %rsi
+	leaq	-64(%rsp), %r8
+	.p2align	4, 0x90
+Lshort_loops_19:
+	movdqu	(%r8), %xmm1
+	paddd	%xmm1, %xmm0
+	addq	$4, %rsi
+	addq	$16, %r8
+	cmpq	$8, %rsi
+	jl	Lshort_loops_19
+Lshort_loops_20:
+	movdqa	%xmm0, %xmm15
+	pshufd	$78, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	pshufd	$177, %xmm15, %xmm14
+	paddd	%xmm14, %xmm15
+	movd	%xmm15, %eax
+	movl	%eax, %r8d
+Lshort_loops_17:
+	movslq	%esi, %r9
+	shlq	$2, %r9
+	leaq	-72(%rsp), %rax
+	addq	%rax, %r9
+	.p2align	4, 0x90
+Lshort_loops_12:
+	movl	(%r9), %r10d
+	addl	%r10d, %r8d
+Lshort_loops_13:
+	addl	$1, %esi
+	addq	$4, %r9
+	cmpl	$12, %esi
+	jl	Lshort_loops_12
+Lshort_loops_14:
+	movl	%edi, %esi
+	imull	$1000, %esi
+	addl	%r8d, %esi
+	movl	%esi, %eax
+	retq
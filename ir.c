@@ -0,0 +1,1110 @@
+#include "ir.h"
+
+#include <assert.h>
+#include <string.h>
+#include "common.h"
+
+#define IR_OP_NAME_(name, text, n_args, flags) text,
+#define IR_OP_N_ARGS_(name, text, n_args, flags) n_args,
+#define IR_OP_FLAGS_(name, text, n_args, flags) flags,
+#define IR_TYPE_NAME_(name, text, size) text,
+#define IR_TYPE_SIZE_(name, text, size) size,
+const char *IR_OP_NAMES[] = { IR_OPS(IR_OP_NAME_) };
+const int IR_OP_N_ARGS[] = { IR_OPS(IR_OP_N_ARGS_) };
+const int IR_OP_FLAGS[] = { IR_OPS(IR_OP_FLAGS_) };
+const char *IR_TYPE_NAMES[] = { IR_TYPES(IR_TYPE_NAME_) };
+const int IR_TYPE_SIZES[] = { IR_TYPES(IR_TYPE_SIZE_) };
+#undef IR_OP_NAME_
+#undef IR_OP_N_ARGS_
+#undef IR_OP_FLAGS_
+#undef IR_TYPE_NAME_
+#undef IR_TYPE_SIZE_
+
+#define IR_INITIAL_CAPACITY 64
+
+// Grow f->array from old_cap to new_cap elements
+#define GROW(f, array, old_cap, new_cap) \
+  (f)->array = arena_realloc((f)->arena, (f)->array, (old_cap) * sizeof(*(f)->array), (new_cap) * sizeof(*(f)->array))
+
+IrFunction *new_ir_function(const char *name) {
+  Arena *arena = new_arena();
+  IrFunction *f = arena_alloc(arena, sizeof(IrFunction));
+  f->arena = arena;
+  f->name = name;
+  // Reserve index 0 of everything for IR_NONE.
+  f->n_insts = f->n_operands = f->n_blocks = 1;
+  f->n_slots = f->n_symbols = 0;
+  IrBlockRef entry = ir_new_block(f);
+  assert(entry == IR_ENTRY_BLOCK);
+  return f;
+}
+
+void free_ir_function(IrFunction *f) {
+  free_arena(f->arena);
+}
+
+static void *copy_array(Arena *arena, const void *array, size_t size) {
+  void *ret = arena_alloc(arena, size);
+  if (size) {
+    memcpy(ret, array, size);
+  }
+  return ret;
+}
+
+// Copy the first n elements of array from f to g, into an array of capacity n
+#define COPY(g, f, array, n) ((g)->array = copy_array((g)->arena, (f)->array, (n) * sizeof(*(f)->array)))
+
+IrFunction *ir_copy_function(const IrFunction *f) {
+  Arena *arena = new_arena();
+  IrFunction *g = arena_alloc(arena, sizeof(IrFunction));
+  *g = *f;
+  g->arena = arena;
+  g->insts_capacity = f->n_insts;
+  COPY(g, f, op, f->n_insts);
+  COPY(g, f, type, f->n_insts);
+  COPY(g, f, block, f->n_insts);
+  COPY(g, f, next, f->n_insts);
+  COPY(g, f, prev, f->n_insts);
+  COPY(g, f, args, f->n_insts);
+  COPY(g, f, n_args, f->n_insts);
+  COPY(g, f, imm, f->n_insts);
+  COPY(g, f, first_use, f->n_insts);
+  g->operands_capacity = f->n_operands;
+  COPY(g, f, operand, f->n_operands);
+  COPY(g, f, user, f->n_operands);
+  COPY(g, f, next_use, f->n_operands);
+  COPY(g, f, prev_use, f->n_operands);
+  g->blocks_capacity = f->n_blocks;
+  COPY(g, f, blocks, f->n_blocks);
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    IrBlock *block = &g->blocks[b];
+    block->preds_capacity = block->n_preds;
+    block->preds = copy_array(arena, block->preds, block->n_preds * sizeof(IrBlockRef));
+    block->succs_capacity = block->n_succs;
+    block->succs = copy_array(arena, block->succs, block->n_succs * sizeof(IrBlockRef));
+  }
+  g->slots_capacity = f->n_slots;
+  COPY(g, f, slots, f->n_slots);
+  g->symbols_capacity = f->n_symbols;
+  COPY(g, f, symbols, f->n_symbols);
+  return g;
+}
+
+#undef COPY
+
+static void ensure_insts(IrFunction *f) {
+  if (f->n_insts < f->insts_capacity)
+    return;
+  uint32_t cap = f->insts_capacity ? f->insts_capacity * 2 : IR_INITIAL_CAPACITY;
+  GROW(f, op, f->insts_capacity, cap);
+  GROW(f, type, f->insts_capacity, cap);
+  GROW(f, block, f->insts_capacity, cap);
+  GROW(f, next, f->insts_capacity, cap);
+  GROW(f, prev, f->insts_capacity, cap);
+  GROW(f, args, f->insts_capacity, cap);
+  GROW(f, n_args, f->insts_capacity, cap);
+  GROW(f, imm, f->insts_capacity, cap);
+  GROW(f, first_use, f->insts_capacity, cap);
+  f->insts_capacity = cap;
+}
+
+static void ensure_operands(IrFunction *f, uint32_t n) {
+  if (f->n_operands + n <= f->operands_capacity)
+    return;
+  uint32_t cap = f->operands_capacity ? f->operands_capacity : IR_INITIAL_CAPACITY;
+  while (cap < f->n_operands + n) {
+    cap *= 2;
+  }
+  GROW(f, operand, f->operands_capacity, cap);
+  GROW(f, user, f->operands_capacity, cap);
+  GROW(f, next_use, f->operands_capacity, cap);
+  GROW(f, prev_use, f->operands_capacity, cap);
+  f->operands_capacity = cap;
+}
+
+static void link_use(IrFunction *f, IrUse u) {
+  IrRef def = f->operand[u];
+  if (!def)
+    return;
+  f->prev_use[u] = IR_NONE;
+  f->next_use[u] = f->first_use[def];
+  if (f->first_use[def]) {
+    f->prev_use[f->first_use[def]] = u;
+  }
+  f->first_use[def] = u;
+}
+
+static void unlink_use(IrFunction *f, IrUse u) {
+  IrRef def = f->operand[u];
+  if (!def)
+    return;
+  if (f->prev_use[u]) {
+    f->next_use[f->prev_use[u]] = f->next_use[u];
+  } else {
+    f->first_use[def] = f->next_use[u];
+  }
+  if (f->next_use[u]) {
+    f->prev_use[f->next_use[u]] = f->prev_use[u];
+  }
+  f->next_use[u] = f->prev_use[u] = IR_NONE;
+}
+
+static void alloc_args(IrFunction *f, IrRef inst, int n_args, const IrRef *args) {
+  ensure_operands(f, n_args);
+  f->args[inst] = f->n_operands;
+  f->n_args[inst] = n_args;
+  for (int i = 0; i < n_args; i++) {
+    IrUse u = f->n_operands++;
+    f->operand[u] = args[i];
+    f->user[u] = inst;
+    link_use(f, u);
+  }
+}
+
+static IrRef new_inst(IrFunction *f, IrOp op, IrType type, int n_args, const IrRef *args, int64_t imm) {
+  assert(IR_OP_N_ARGS[op] < 0 || IR_OP_N_ARGS[op] == n_args);
+  ensure_insts(f);
+  IrRef inst = f->n_insts++;
+  f->op[inst] = op;
+  f->type[inst] = type;
+  f->imm[inst] = imm;
+  f->first_use[inst] = IR_NONE;
+  alloc_args(f, inst, n_args, args);
+  return inst;
+}
+
+IrBlockRef ir_new_block(IrFunction *f) {
+  if (f->n_blocks >= f->blocks_capacity) {
+    uint32_t cap = f->blocks_capacity ? f->blocks_capacity * 2 : IR_INITIAL_CAPACITY / 4;
+    GROW(f, blocks, f->blocks_capacity, cap);
+    f->blocks_capacity = cap;
+  }
+  IrBlockRef b = f->n_blocks++;
+  f->blocks[b] = (IrBlock) {0};
+  return b;
+}
+
+static void append_block_ref(Arena *arena, IrBlockRef **p_array, uint32_t *p_size, uint32_t *p_capacity, IrBlockRef b) {
+  if (*p_size == *p_capacity) {
+    uint32_t cap = *p_capacity ? *p_capacity * 2 : 2;
+    *p_array = arena_realloc(arena, *p_array, *p_capacity * sizeof(IrBlockRef), cap * sizeof(IrBlockRef));
+    *p_capacity = cap;
+  }
+  (*p_array)[(*p_size)++] = b;
+}
+
+void ir_add_edge(IrFunction *f, IrBlockRef from, IrBlockRef to) {
+  IrBlock *src = &f->blocks[from], *dst = &f->blocks[to];
+  append_block_ref(f->arena, &src->succs, &src->n_succs, &src->succs_capacity, to);
+  append_block_ref(f->arena, &dst->preds, &dst->n_preds, &dst->preds_capacity, from);
+}
+
+IrRef ir_append(IrFunction *f, IrBlockRef b, IrOp op, IrType type, int n_args, const IrRef *args, int64_t imm) {
+  assert(!ir_terminator(f, b) && "appending to a terminated block");
+  IrRef inst = new_inst(f, op, type, n_args, args, imm);
+  IrBlock *block = &f->blocks[b];
+  f->block[inst] = b;
+  f->prev[inst] = block->last;
+  f->next[inst] = IR_NONE;
+  if (block->last) {
+    f->next[block->last] = inst;
+  } else {
+    block->first = inst;
+  }
+  block->last = inst;
+  return inst;
+}
+
+static void link_before(IrFunction *f, IrRef inst, IrRef before) {
+  IrBlockRef b = f->block[before];
+  IrRef p = f->prev[before];
+  f->block[inst] = b;
+  f->prev[inst] = p;
+  f->next[inst] = before;
+  f->prev[before] = inst;
+  if (p) {
+    f->next[p] = inst;
+  } else {
+    f->blocks[b].first = inst;
+  }
+}
+
+static void unlink_inst(IrFunction *f, IrRef inst) {
+  IrBlock *block = &f->blocks[f->block[inst]];
+  if (f->prev[inst]) {
+    f->next[f->prev[inst]] = f->next[inst];
+  } else {
+    block->first = f->next[inst];
+  }
+  if (f->next[inst]) {
+    f->prev[f->next[inst]] = f->prev[inst];
+  } else {
+    block->last = f->prev[inst];
+  }
+  f->block[inst] = IR_NONE;
+}
+
+IrRef ir_insert_before(IrFunction *f, IrRef before, IrOp op, IrType type, int n_args, const IrRef *args, int64_t imm) {
+  IrRef inst = new_inst(f, op, type, n_args, args, imm);
+  link_before(f, inst, before);
+  return inst;
+}
+
+void ir_move_before(IrFunction *f, IrRef inst, IrRef before) {
+  assert(inst != before);
+  unlink_inst(f, inst);
+  link_before(f, inst, before);
+}
+
+IrRef ir_insert_phi(IrFunction *f, IrBlockRef b, IrType type) {
+  IrRef first_non_phi = f->blocks[b].first;
+  while (first_non_phi && f->op[first_non_phi] == IR_PHI) {
+    first_non_phi = f->next[first_non_phi];
+  }
+  if (first_non_phi) {
+    return ir_insert_before(f, first_non_phi, IR_PHI, type, 0, 0, 0);
+  }
+  // The block is still empty but for phis, so it cannot be terminated yet.
+  return ir_append(f, b, IR_PHI, type, 0, 0, 0);
+}
+
+void ir_set_phi_args(IrFunction *f, IrRef phi, const IrRef *values) {
+  assert(f->op[phi] == IR_PHI && f->n_args[phi] == 0);
+  alloc_args(f, phi, f->blocks[f->block[phi]].n_preds, values);
+}
+
+void ir_set_arg(IrFunction *f, IrRef inst, int i, IrRef value) {
+  assert((uint32_t) i < f->n_args[inst]);
+  IrUse u = f->args[inst] + i;
+  unlink_use(f, u);
+  f->operand[u] = value;
+  link_use(f, u);
+}
+
+void ir_replace_uses(IrFunction *f, IrRef old, IrRef new) {
+  assert(old != new);
+  while (f->first_use[old]) {
+    IrUse u = f->first_use[old];
+    unlink_use(f, u);
+    f->operand[u] = new;
+    link_use(f, u);
+  }
+}
+
+void ir_remove(IrFunction *f, IrRef inst) {
+  assert(!f->first_use[inst] && "removing an instruction whose value is still used");
+  for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+    IrUse u = f->args[inst] + i;
+    unlink_use(f, u);
+    f->operand[u] = IR_NONE;
+  }
+  unlink_inst(f, inst);
+  f->op[inst] = IR_NOP;
+  f->n_args[inst] = 0;
+}
+
+int ir_n_uses(const IrFunction *f, IrRef inst) {
+  int n = 0;
+  IR_FOR_EACH_USE(f, inst, u) {
+    n++;
+  }
+  return n;
+}
+
+IrRef ir_terminator(const IrFunction *f, IrBlockRef b) {
+  IrRef last = f->blocks[b].last;
+  return last && IR_IS_TERMINATOR(f, last) ? last : IR_NONE;
+}
+
+int ir_new_slot(IrFunction *f, int size, int align) {
+  if (f->n_slots == f->slots_capacity) {
+    uint32_t cap = f->slots_capacity ? f->slots_capacity * 2 : 8;
+    GROW(f, slots, f->slots_capacity, cap);
+    f->slots_capacity = cap;
+  }
+  f->slots[f->n_slots] = (IrSlot) { .size = size, .align = align };
+  return f->n_slots++;
+}
+
+int ir_intern_symbol(IrFunction *f, const char *name) {
+  for (uint32_t i = 0; i < f->n_symbols; i++) {
+    if (strcmp(f->symbols[i], name) == 0)
+      return i;
+  }
+  if (f->n_symbols == f->symbols_capacity) {
+    uint32_t cap = f->symbols_capacity ? f->symbols_capacity * 2 : 8;
+    GROW(f, symbols, f->symbols_capacity, cap);
+    f->symbols_capacity = cap;
+  }
+  f->symbols[f->n_symbols] = name;
+  return f->n_symbols++;
+}
+
+int64_t ir_float_bits(IrType type, double value) {
+  if (type == IR_F32) {
+    float narrow = (float) value;
+    uint32_t bits;
+    memcpy(&bits, &narrow, sizeof(bits));
+    return bits;
+  }
+  assert(type == IR_F64);
+  int64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double ir_float_value(IrType type, int64_t bits) {
+  if (type == IR_F32) {
+    uint32_t narrow_bits = (uint32_t) bits;
+    float narrow;
+    memcpy(&narrow, &narrow_bits, sizeof(narrow));
+    return narrow;
+  }
+  assert(type == IR_F64);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/** Drop operand i of phi, keeping the others in order. */
+static void remove_phi_arg(IrFunction *f, IrRef phi, uint32_t i) {
+  uint32_t n = f->n_args[phi];
+  for (uint32_t k = i; k + 1 < n; k++) {
+    ir_set_arg(f, phi, k, IR_ARG(f, phi, k + 1));
+  }
+  ir_set_arg(f, phi, n - 1, IR_NONE);
+  f->n_args[phi] = n - 1;
+}
+
+/** Remove the edge from -> to from the preds of to, with the matching phi operands. */
+static void remove_pred(IrFunction *f, IrBlockRef to, IrBlockRef from) {
+  IrBlock *block = &f->blocks[to];
+  for (uint32_t i = 0; i < block->n_preds; i++) {
+    if (block->preds[i] != from)
+      continue;
+    IR_FOR_EACH_INST(f, to, inst) {
+      if (f->op[inst] != IR_PHI)
+        break;
+      remove_phi_arg(f, inst, i);
+    }
+    memmove(&block->preds[i], &block->preds[i + 1], (block->n_preds - i - 1) * sizeof(IrBlockRef));
+    block->n_preds--;
+    i--;
+  }
+}
+
+void ir_fold_branch(IrFunction *f, IrBlockRef b, int taken) {
+  IrRef branch = ir_terminator(f, b);
+  assert(branch && (f->op[branch] == IR_BR || f->op[branch] == IR_SWITCH));
+  ir_remove(f, branch);
+  ir_append(f, b, IR_JMP, IR_VOID, 0, 0, 0);
+  IrBlock *block = &f->blocks[b];
+  for (uint32_t k = 0; k < block->n_succs; k++) {
+    if (k == (uint32_t) taken)
+      continue;
+    // Only the one edge goes, even if others went to the same block.
+    IrBlock *target = &f->blocks[block->succs[k]];
+    uint32_t i = 0;
+    while (target->preds[i] != b) {
+      i++;
+    }
+    for (IrRef phi = target->first; phi && f->op[phi] == IR_PHI; phi = f->next[phi]) {
+      remove_phi_arg(f, phi, i);
+    }
+    memmove(&target->preds[i], &target->preds[i + 1], (target->n_preds - i - 1) * sizeof(IrBlockRef));
+    target->n_preds--;
+  }
+  block->succs[0] = block->succs[taken];
+  block->n_succs = 1;
+}
+
+void ir_remove_unreachable_blocks(IrFunction *f) {
+  // Depth first search from the entry
+  uint8_t *reachable = arena_alloc(f->arena, f->n_blocks);
+  IrBlockRef *stack = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int top = 0;
+  stack[top++] = IR_ENTRY_BLOCK;
+  reachable[IR_ENTRY_BLOCK] = 1;
+  while (top > 0) {
+    IrBlock *block = &f->blocks[stack[--top]];
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      IrBlockRef s = block->succs[i];
+      if (!reachable[s]) {
+        reachable[s] = 1;
+        stack[top++] = s;
+      }
+    }
+  }
+
+  // Unreachable code may only be used by unreachable code, or by phis through edges being removed.
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    if (reachable[b])
+      continue;
+    for (uint32_t i = 0; i < f->blocks[b].n_succs; i++) {
+      if (reachable[f->blocks[b].succs[i]]) {
+        remove_pred(f, f->blocks[b].succs[i], b);
+      }
+    }
+    IR_FOR_EACH_INST(f, b, inst) {
+      for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+        ir_set_arg(f, inst, i, IR_NONE);
+      }
+    }
+  }
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    if (reachable[b])
+      continue;
+    IR_FOR_EACH_INST(f, b, inst) {
+      ir_remove(f, inst);
+    }
+  }
+
+  // Renumber the survivors
+  IrBlockRef *renumber = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  IrBlockRef n = 1;
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    if (reachable[b]) {
+      renumber[b] = n;
+      f->blocks[n++] = f->blocks[b];
+    }
+  }
+  f->n_blocks = n;
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    IrBlock *block = &f->blocks[b];
+    uint32_t n_preds = 0;
+    for (uint32_t i = 0; i < block->n_preds; i++) {
+      assert(reachable[block->preds[i]]);
+      block->preds[n_preds++] = renumber[block->preds[i]];
+    }
+    block->n_preds = n_preds;
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      block->succs[i] = renumber[block->succs[i]];
+    }
+    IR_FOR_EACH_INST(f, b, inst) {
+      f->block[inst] = b;
+    }
+  }
+}
+
+IrBlockRef ir_split_block(IrFunction *f, IrRef inst) {
+  IrBlockRef b = f->block[inst];
+  IrBlockRef rest = ir_new_block(f);  // may move f->blocks
+  IrBlock *old = &f->blocks[b], *new = &f->blocks[rest];
+  new->first = inst;
+  new->last = old->last;
+  old->last = f->prev[inst];
+  if (old->last) {
+    f->next[old->last] = IR_NONE;
+  } else {
+    old->first = IR_NONE;
+  }
+  f->prev[inst] = IR_NONE;
+  for (IrRef i = inst; i; i = f->next[i]) {
+    f->block[i] = rest;
+  }
+  new->count = old->count;
+  // The successors keep their preds in place, so their phi operands keep their order.
+  new->succs = old->succs;
+  new->n_succs = old->n_succs;
+  new->succs_capacity = old->succs_capacity;
+  old->succs = 0;
+  old->n_succs = old->succs_capacity = 0;
+  for (uint32_t i = 0; i < new->n_succs; i++) {
+    IrBlock *succ = &f->blocks[new->succs[i]];
+    for (uint32_t k = 0; k < succ->n_preds; k++) {
+      if (succ->preds[k] == b) {
+        succ->preds[k] = rest;
+      }
+    }
+  }
+  return rest;
+}
+
+uint64_t ir_edge_count(const IrFunction *f, IrBlockRef b, uint32_t i) {
+  const IrBlock *block = &f->blocks[b];
+  const IrBlock *succ = &f->blocks[block->succs[i]];
+  if (block->n_succs == 1)
+    return block->count;
+  if (succ->n_preds == 1)
+    return succ->count;
+  uint64_t known = 0, shared = 0;
+  for (uint32_t k = 0; k < block->n_succs; k++) {
+    const IrBlock *other = &f->blocks[block->succs[k]];
+    if (other->n_preds == 1) {
+      known += other->count;
+    } else {
+      shared += other->count;
+    }
+  }
+  if (known >= block->count || !shared)
+    return 0;
+  uint64_t ret = (uint64_t) ((double) (block->count - known) * succ->count / shared);
+  return ret < succ->count ? ret : succ->count;
+}
+
+IrBlockRef ir_split_edge(IrFunction *f, IrBlockRef b, uint32_t i) {
+  IrBlockRef s = f->blocks[b].succs[i];
+  uint64_t count = ir_edge_count(f, b, i);
+  IrBlockRef mid = ir_new_block(f);  // may move f->blocks
+  f->blocks[mid].count = count;
+  ir_append(f, mid, IR_JMP, IR_VOID, 0, 0, 0);
+  // Reroute the edge in place, so the phi operands of s keep their order.
+  IrBlock *succ = &f->blocks[s];
+  uint32_t k = 0;
+  while (succ->preds[k] != b) {
+    k++;
+  }
+  succ->preds[k] = mid;
+  f->blocks[b].succs[i] = mid;
+  append_block_ref(f->arena, &f->blocks[mid].preds, &f->blocks[mid].n_preds, &f->blocks[mid].preds_capacity, b);
+  append_block_ref(f->arena, &f->blocks[mid].succs, &f->blocks[mid].n_succs, &f->blocks[mid].succs_capacity, s);
+  return mid;
+}
+
+void ir_split_critical_edges(IrFunction *f) {
+  uint32_t n_blocks = f->n_blocks;
+  for (IrBlockRef b = 1; b < n_blocks; b++) {
+    for (uint32_t i = 0; i < f->blocks[b].n_succs; i++) {
+      if (f->blocks[b].n_succs >= 2 && f->blocks[f->blocks[b].succs[i]].n_preds >= 2) {
+        ir_split_edge(f, b, i);
+      }
+    }
+  }
+}
+
+int ir_reverse_postorder(const IrFunction *f, IrBlockRef *order) {
+  uint8_t *visited = arena_alloc(f->arena, f->n_blocks);
+  // Explicit stack of (block, index of the next successor to visit)
+  IrBlockRef *stack = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  uint32_t *next_succ = arena_alloc(f->arena, f->n_blocks * sizeof(uint32_t));
+  int top = 0;
+  int n = f->n_blocks - 1;
+  stack[top++] = IR_ENTRY_BLOCK;
+  visited[IR_ENTRY_BLOCK] = 1;
+  while (top > 0) {
+    IrBlockRef b = stack[top - 1];
+    const IrBlock *block = &f->blocks[b];
+    if (next_succ[top - 1] < block->n_succs) {
+      IrBlockRef s = block->succs[next_succ[top - 1]++];
+      if (!visited[s]) {
+        visited[s] = 1;
+        next_succ[top] = 0;
+        stack[top++] = s;
+      }
+    } else {
+      order[--n] = b;
+      top--;
+    }
+  }
+  // Unreachable blocks get no place; move the reachable ones to the front.
+  int n_reachable = f->n_blocks - 1 - n;
+  memmove(order, order + n, n_reachable * sizeof(IrBlockRef));
+  return n_reachable;
+}
+
+/** The nearest common dominator of a and b, walking up idom by position in reverse postorder */
+static IrBlockRef intersect(const IrBlockRef *idom, const int *position, IrBlockRef a, IrBlockRef b) {
+  while (a != b) {
+    while (position[a] > position[b]) {
+      a = idom[a];
+    }
+    while (position[b] > position[a]) {
+      b = idom[b];
+    }
+  }
+  return a;
+}
+
+void ir_immediate_dominators(const IrFunction *f, IrBlockRef *idom) {
+  IrBlockRef *order = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int n_order = ir_reverse_postorder(f, order);
+  int *position = arena_alloc(f->arena, f->n_blocks * sizeof(int));
+  for (int k = 0; k < n_order; k++) {
+    position[order[k]] = k;
+  }
+  memset(idom, 0, f->n_blocks * sizeof(IrBlockRef));
+  idom[IR_ENTRY_BLOCK] = IR_ENTRY_BLOCK;
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (int k = 1; k < n_order; k++) {
+      IrBlockRef b = order[k], new_idom = IR_NONE;
+      for (uint32_t i = 0; i < f->blocks[b].n_preds; i++) {
+        IrBlockRef p = f->blocks[b].preds[i];
+        if (idom[p]) {
+          new_idom = new_idom ? intersect(idom, position, p, new_idom) : p;
+        }
+      }
+      if (idom[b] != new_idom) {
+        idom[b] = new_idom;
+        changed = 1;
+      }
+    }
+  }
+  idom[IR_ENTRY_BLOCK] = IR_NONE;
+}
+
+int ir_dominates(const IrBlockRef *idom, IrBlockRef a, IrBlockRef b) {
+  while (b && b != a) {
+    b = idom[b];
+  }
+  return b == a;
+}
+
+static int compare_loop_sizes(const void *a, const void *b) {
+  const IrLoop *x = a, *y = b;
+  if (x->n_blocks != y->n_blocks)
+    return x->n_blocks < y->n_blocks ? -1 : 1;
+  return x->header < y->header ? -1 : x->header > y->header;
+}
+
+IrLoopForest *ir_find_loops(IrFunction *f) {
+  IrLoopForest *forest = arena_alloc(f->arena, sizeof(IrLoopForest));
+  IrBlockRef *idom = forest->idom = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  ir_immediate_dominators(f, idom);
+  IrBlockRef *order = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int n_order = ir_reverse_postorder(f, order);
+  uint8_t *reachable = arena_alloc(f->arena, f->n_blocks);
+  for (int k = 0; k < n_order; k++) {
+    reachable[order[k]] = 1;
+  }
+
+  // One loop per header, merging the back edges to it
+  forest->loops = arena_alloc(f->arena, (n_order + 1) * sizeof(IrLoop));
+  uint8_t *in_loop = arena_alloc(f->arena, f->n_blocks);
+  IrBlockRef *stack = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  for (int k = 0; k < n_order; k++) {
+    IrBlockRef h = order[k];
+    const IrBlock *header = &f->blocks[h];
+    IrLoop loop = { .header = h, .parent = -1 };
+    loop.latches = arena_alloc(f->arena, header->n_preds * sizeof(IrBlockRef));
+    for (uint32_t i = 0; i < header->n_preds; i++) {
+      IrBlockRef p = header->preds[i];
+      if (reachable[p] && ir_dominates(idom, h, p)) {
+        loop.latches[loop.n_latches++] = p;
+      }
+    }
+    if (!loop.n_latches)
+      continue;
+
+    // The body: what reaches a latch backward without crossing the header
+    memset(in_loop, 0, f->n_blocks);
+    in_loop[h] = 1;
+    int top = 0;
+    for (uint32_t i = 0; i < loop.n_latches; i++) {
+      if (!in_loop[loop.latches[i]]) {
+        in_loop[loop.latches[i]] = 1;
+        stack[top++] = loop.latches[i];
+      }
+    }
+    while (top > 0) {
+      const IrBlock *block = &f->blocks[stack[--top]];
+      for (uint32_t i = 0; i < block->n_preds; i++) {
+        IrBlockRef p = block->preds[i];
+        if (reachable[p] && !in_loop[p]) {
+          in_loop[p] = 1;
+          stack[top++] = p;
+        }
+      }
+    }
+    loop.blocks = arena_alloc(f->arena, n_order * sizeof(IrBlockRef));
+    loop.exits = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+    for (int j = k; j < n_order; j++) {
+      IrBlockRef b = order[j];
+      if (in_loop[b] != 1)
+        continue;
+      loop.blocks[loop.n_blocks++] = b;
+      for (uint32_t i = 0; i < f->blocks[b].n_succs; i++) {
+        IrBlockRef s = f->blocks[b].succs[i];
+        if (!in_loop[s]) {
+          in_loop[s] = 2;  // listed as an exit
+          loop.exits[loop.n_exits++] = s;
+        }
+      }
+    }
+
+    IrBlockRef outside = IR_NONE;
+    int n_outside = 0;
+    for (uint32_t i = 0; i < header->n_preds; i++) {
+      if (in_loop[header->preds[i]] != 1 && reachable[header->preds[i]]) {
+        outside = header->preds[i];
+        n_outside++;
+      }
+    }
+    loop.preheader = n_outside == 1 && f->blocks[outside].n_succs == 1 ? outside : IR_NONE;
+    forest->loops[forest->n_loops++] = loop;
+  }
+
+  // A loop nested in another has fewer blocks.
+  qsort(forest->loops, forest->n_loops, sizeof(IrLoop), compare_loop_sizes);
+  forest->n_blocks = f->n_blocks;
+  forest->innermost = arena_alloc(f->arena, f->n_blocks * sizeof(int));
+  for (IrBlockRef b = 0; b < f->n_blocks; b++) {
+    forest->innermost[b] = -1;
+  }
+  for (int i = 0; i < forest->n_loops; i++) {
+    IrLoop *loop = &forest->loops[i];
+    for (uint32_t j = 0; j < loop->n_blocks; j++) {
+      if (forest->innermost[loop->blocks[j]] < 0) {
+        forest->innermost[loop->blocks[j]] = i;
+      }
+    }
+  }
+  for (int i = 0; i < forest->n_loops; i++) {
+    // The next larger loop containing the header, if any, as the header is innermost in this one
+    int l = forest->innermost[forest->loops[i].header];
+    assert(l == i);
+    for (int j = i + 1; j < forest->n_loops && forest->loops[i].parent < 0; j++) {
+      for (uint32_t k = 0; k < forest->loops[j].n_blocks; k++) {
+        if (forest->loops[j].blocks[k] == forest->loops[i].header) {
+          forest->loops[i].parent = j;
+          break;
+        }
+      }
+    }
+  }
+  for (int i = forest->n_loops - 1; i >= 0; i--) {
+    int parent = forest->loops[i].parent;
+    forest->loops[i].depth = parent < 0 ? 1 : forest->loops[parent].depth + 1;
+  }
+  return forest;
+}
+
+int ir_loop_contains(const IrLoopForest *forest, int loop, IrBlockRef b) {
+  if (b >= forest->n_blocks)
+    return 0;
+  for (int l = forest->innermost[b]; l >= 0; l = forest->loops[l].parent) {
+    if (l == loop)
+      return 1;
+  }
+  return 0;
+}
+
+int ir_insert_preheader(IrFunction *f, const IrLoop *loop) {
+  if (loop->preheader)
+    return 0;
+  IrBlockRef h = loop->header;
+  IrBlockRef pre = ir_new_block(f);  // may move f->blocks
+  IrBlock *header = &f->blocks[h];
+  uint32_t n_preds = header->n_preds;
+  uint8_t *is_latch = arena_alloc(f->arena, n_preds);
+  int n_outside = n_preds;
+  for (uint32_t k = 0; k < n_preds; k++) {
+    for (uint32_t i = 0; i < loop->n_latches && !is_latch[k]; i++) {
+      is_latch[k] = header->preds[k] == loop->latches[i];
+    }
+    n_outside -= is_latch[k];
+  }
+  if (!n_outside)
+    return 0;  // only reached by its back edges, as the entry can be
+
+  // The outside edges now go to the preheader, and each phi of the header takes their value from a phi there.
+  IrBlock *block = &f->blocks[pre];
+  for (uint32_t k = 0; k < n_preds; k++) {
+    if (is_latch[k])
+      continue;
+    IrBlock *from = &f->blocks[header->preds[k]];
+    uint32_t i = 0;
+    while (from->succs[i] != h) {
+      i++;
+    }
+    block->count += ir_edge_count(f, header->preds[k], i);
+    from->succs[i] = pre;
+    append_block_ref(f->arena, &block->preds, &block->n_preds, &block->preds_capacity, header->preds[k]);
+  }
+  ir_append(f, pre, IR_JMP, IR_VOID, 0, 0, 0);
+  append_block_ref(f->arena, &block->succs, &block->n_succs, &block->succs_capacity, h);
+  IrRef *values = arena_alloc(f->arena, n_preds * sizeof(IrRef));
+  for (IrRef phi = header->first; phi && f->op[phi] == IR_PHI; phi = f->next[phi]) {
+    int n = 0;
+    for (uint32_t k = 0; k < n_preds; k++) {
+      if (!is_latch[k]) {
+        values[n++] = IR_ARG(f, phi, k);
+      }
+    }
+    IrRef incoming = values[0];
+    if (n > 1) {
+      incoming = ir_insert_phi(f, pre, f->type[phi]);
+      ir_set_phi_args(f, incoming, values);
+    }
+    // Rewrite the operands in place, the preheader's first.
+    n = 0;
+    values[n++] = incoming;
+    for (uint32_t k = 0; k < n_preds; k++) {
+      if (is_latch[k]) {
+        values[n++] = IR_ARG(f, phi, k);
+      }
+    }
+    for (uint32_t k = 0; k < n_preds; k++) {
+      ir_set_arg(f, phi, k, k < (uint32_t) n ? values[k] : IR_NONE);
+    }
+    f->n_args[phi] = n;
+  }
+  uint32_t n = 0;
+  header->preds[n++] = pre;
+  for (uint32_t k = 0; k < n_preds; k++) {
+    if (is_latch[k]) {
+      header->preds[n++] = header->preds[k];
+    }
+  }
+  header->n_preds = n;
+  return 1;
+}
+
+#define VERIFY(cond, ...) THROWF_IF(!(cond), EXC_INTERNAL, "IR is invalid: " __VA_ARGS__)
+
+void ir_verify(const IrFunction *f) {
+  int n_operand_uses = 0;
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    const IrBlock *block = &f->blocks[b];
+    IrRef terminator = ir_terminator(f, b);
+    VERIFY(terminator, "%s, block b%u is not terminated", f->name, b);
+    int n_succs = f->op[terminator] == IR_BR ? 2 : f->op[terminator] == IR_JMP ? 1 : 0;
+    if (f->op[terminator] == IR_SWITCH) {
+      n_succs = f->n_args[terminator];
+      for (uint32_t i = 1; i < f->n_args[terminator]; i++) {
+        VERIFY(f->op[IR_ARG(f, terminator, i)] == IR_CONST, "%s, case %u of %%%u is not a constant", f->name, i,
+          terminator);
+      }
+    }
+    VERIFY((int) block->n_succs == n_succs, "%s, block b%u has %u succs", f->name, b, block->n_succs);
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      const IrBlock *succ = &f->blocks[block->succs[i]];
+      int found = 0;
+      for (uint32_t k = 0; k < succ->n_preds; k++) {
+        found |= succ->preds[k] == b;
+      }
+      VERIFY(found, "%s, edge b%u -> b%u is missing from preds", f->name, b, block->succs[i]);
+    }
+
+    int seen_non_phi = 0;
+    IrRef prev = IR_NONE;
+    for (IrRef inst = block->first; inst; prev = inst, inst = f->next[inst]) {
+      VERIFY(f->block[inst] == b && f->prev[inst] == prev, "%s, %%%u is mislinked", f->name, inst);
+      VERIFY(!IR_IS_TERMINATOR(f, inst) || inst == block->last, "%s, %%%u terminates mid-block", f->name, inst);
+      if (f->op[inst] == IR_PHI) {
+        VERIFY(!seen_non_phi, "%s, phi %%%u follows other instructions", f->name, inst);
+        VERIFY(f->n_args[inst] == block->n_preds, "%s, phi %%%u has %u operands", f->name, inst, f->n_args[inst]);
+      } else {
+        seen_non_phi = 1;
+      }
+      for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+        IrUse u = f->args[inst] + i;
+        IrRef def = f->operand[u];
+        VERIFY(f->user[u] == inst, "%s, operand %u of %%%u has the wrong user", f->name, i, inst);
+        VERIFY(def && f->block[def], "%s, operand %u of %%%u is not a live value", f->name, i, inst);
+        VERIFY(f->type[def] != IR_VOID, "%s, operand %u of %%%u has no value", f->name, i, inst);
+        n_operand_uses++;
+      }
+    }
+    VERIFY(prev == block->last, "%s, block b%u has the wrong last instruction", f->name, b);
+  }
+
+  int n_listed_uses = 0;
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    IR_FOR_EACH_USE(f, inst, u) {
+      VERIFY(f->operand[u] == inst && f->block[f->user[u]], "%s, use list of %%%u is corrupt", f->name, inst);
+      n_listed_uses++;
+    }
+  }
+  VERIFY(n_listed_uses == n_operand_uses, "%s, %d uses listed but %d operands", f->name, n_listed_uses, n_operand_uses);
+}
+
+#undef VERIFY
+
+void fprint_ir_function(FILE *out, const IrFunction *f) {
+  // Number values consecutively in block order, skipping removed instructions, so dumps are stable.
+  uint32_t *number = arena_alloc(f->arena, f->n_insts * sizeof(uint32_t));
+  uint32_t n = 0;
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    for (IrRef inst = f->blocks[b].first; inst; inst = f->next[inst]) {
+      if (f->type[inst] != IR_VOID) {
+        number[inst] = ++n;
+      }
+    }
+  }
+
+  fprintf(out, "function %s (%d params, %u slots)\n", f->name, f->n_params, f->n_slots);
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    const IrBlock *block = &f->blocks[b];
+    fprintf(out, "b%u:", b);
+    for (uint32_t i = 0; i < block->n_preds; i++) {
+      fprintf(out, "%s b%u", i ? "," : "\t\t; preds", block->preds[i]);
+    }
+    fputc('\n', out);
+    for (IrRef inst = block->first; inst; inst = f->next[inst]) {
+      IrOp op = f->op[inst];
+      fputs("  ", out);
+      if (f->type[inst] != IR_VOID) {
+        fprintf(out, "%%%u = %s ", number[inst], IR_TYPE_NAMES[f->type[inst]]);
+      }
+      fputs(IR_OP_NAMES[op], out);
+      for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+        fprintf(out, i ? ", " : " ");
+        if (op == IR_PHI) {
+          fprintf(out, "[%%%u, b%u]", number[IR_ARG(f, inst, i)], block->preds[i]);
+        } else {
+          fprintf(out, "%%%u", number[IR_ARG(f, inst, i)]);
+        }
+      }
+      switch (op) {
+        case IR_CONST: case IR_PARAM:
+          if (op == IR_CONST && IR_IS_FLOAT_TYPE(f->type[inst])) {
+            fprintf(out, " %.17g", ir_float_value(f->type[inst], f->imm[inst]));
+          } else {
+            fprintf(out, " %lld", (long long) f->imm[inst]);
+          }
+          break;
+        case IR_SLOT:
+          fprintf(out, " %lld\t\t; %d bytes, align %d", (long long) f->imm[inst],
+            f->slots[f->imm[inst]].size, f->slots[f->imm[inst]].align);
+          break;
+        case IR_GLOBAL: case IR_CALL:
+          fprintf(out, " @%s", f->symbols[f->imm[inst]]);
+          break;
+        case IR_ZERO: case IR_COPY: case IR_COUNT:
+          fprintf(out, ", %lld", (long long) f->imm[inst]);
+          break;
+        default:
+          break;
+      }
+      if (IR_IS_TERMINATOR(f, inst)) {
+        for (uint32_t i = 0; i < block->n_succs; i++) {
+          fprintf(out, "%sb%u", i || f->n_args[inst] ? ", " : " ", block->succs[i]);
+        }
+      }
+      fputc('\n', out);
+    }
+  }
+}
+
+void fwrite_ir_function(FILE *out, const IrFunction *f) {
+  fprintf(out, "%s %d %d %d %d %u %u %u %u %u\n", f->name, f->n_params, f->is_static, f->is_inline, f->has_profile,
+    f->n_insts, f->n_operands, f->n_blocks, f->n_slots, f->n_symbols);
+  // Index 0 of everything is IR_NONE, left zero.
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    fprintf(out, "%d %d %u %u %u %u %u %lld %u\n", f->op[inst], f->type[inst], f->block[inst], f->next[inst],
+      f->prev[inst], f->args[inst], f->n_args[inst], (long long) f->imm[inst], f->first_use[inst]);
+  }
+  for (IrUse u = 1; u < f->n_operands; u++) {
+    fprintf(out, "%u %u %u %u\n", f->operand[u], f->user[u], f->next_use[u], f->prev_use[u]);
+  }
+  for (IrBlockRef b = 1; b < f->n_blocks; b++) {
+    const IrBlock *block = &f->blocks[b];
+    fprintf(out, "%u %u %llu %d %u", block->first, block->last, (unsigned long long) block->count,
+      block->calls_noreturn, block->n_preds);
+    for (uint32_t i = 0; i < block->n_preds; i++) {
+      fprintf(out, " %u", block->preds[i]);
+    }
+    fprintf(out, " %u", block->n_succs);
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      fprintf(out, " %u", block->succs[i]);
+    }
+    fputc('\n', out);
+  }
+  for (uint32_t i = 0; i < f->n_slots; i++) {
+    fprintf(out, "%d %d\n", f->slots[i].size, f->slots[i].align);
+  }
+  for (uint32_t i = 0; i < f->n_symbols; i++) {
+    fprintf(out, "%s\n", f->symbols[i]);
+  }
+}
+
+/** Read a number below limit, as fwrite_ir_function wrote it */
+static uint32_t read_index(FILE *in, uint32_t limit) {
+  unsigned long long value;
+  THROW_IF(fscanf(in, "%llu", &value) != 1 || value >= limit, EXC_SYSTEM, "corrupt IR function");
+  return (uint32_t) value;
+}
+
+// Allocate f->array for n elements, at capacity
+#define ALLOC(f, array, n) ((f)->array = arena_alloc((f)->arena, (n) * sizeof(*(f)->array)))
+
+IrFunction *read_ir_function(FILE *in) {
+  char name[1024];
+  int n_params, is_static, is_inline, has_profile;
+  unsigned n_insts, n_operands, n_blocks, n_slots, n_symbols;
+  int n_read = fscanf(in, "%1023s %d %d %d %d %u %u %u %u %u", name, &n_params, &is_static, &is_inline, &has_profile,
+    &n_insts, &n_operands, &n_blocks, &n_slots, &n_symbols);
+  if (n_read == EOF)
+    return 0;
+  THROW_IF(n_read != 10 || !n_insts || !n_operands || n_blocks <= IR_ENTRY_BLOCK, EXC_SYSTEM, "corrupt IR function");
+
+  Arena *arena = new_arena();
+  IrFunction *f = arena_alloc(arena, sizeof(IrFunction));
+  f->arena = arena;
+  f->name = copy_array(arena, name, strlen(name) + 1);
+  f->n_params = n_params;
+  f->is_static = is_static;
+  f->is_inline = is_inline;
+  f->has_profile = has_profile;
+  f->n_insts = f->insts_capacity = n_insts;
+  ALLOC(f, op, n_insts);
+  ALLOC(f, type, n_insts);
+  ALLOC(f, block, n_insts);
+  ALLOC(f, next, n_insts);
+  ALLOC(f, prev, n_insts);
+  ALLOC(f, args, n_insts);
+  ALLOC(f, n_args, n_insts);
+  ALLOC(f, imm, n_insts);
+  ALLOC(f, first_use, n_insts);
+  for (IrRef inst = 1; inst < n_insts; inst++) {
+    f->op[inst] = read_index(in, N_IR_OPS);
+    f->type[inst] = read_index(in, N_IR_TYPES);
+    f->block[inst] = read_index(in, n_blocks);
+    f->next[inst] = read_index(in, n_insts);
+    f->prev[inst] = read_index(in, n_insts);
+    f->args[inst] = read_index(in, n_operands + 1);
+    f->n_args[inst] = read_index(in, n_operands - f->args[inst] + 1);
+    long long imm;
+    THROW_IF(fscanf(in, "%lld", &imm) != 1, EXC_SYSTEM, "corrupt IR function");
+    f->imm[inst] = imm;
+    f->first_use[inst] = read_index(in, n_operands);
+  }
+  f->n_operands = f->operands_capacity = n_operands;
+  ALLOC(f, operand, n_operands);
+  ALLOC(f, user, n_operands);
+  ALLOC(f, next_use, n_operands);
+  ALLOC(f, prev_use, n_operands);
+  for (IrUse u = 1; u < n_operands; u++) {
+    f->operand[u] = read_index(in, n_insts);
+    f->user[u] = read_index(in, n_insts);
+    f->next_use[u] = read_index(in, n_operands);
+    f->prev_use[u] = read_index(in, n_operands);
+  }
+  f->n_blocks = f->blocks_capacity = n_blocks;
+  ALLOC(f, blocks, n_blocks);
+  for (IrBlockRef b = 1; b < n_blocks; b++) {
+    IrBlock *block = &f->blocks[b];
+    block->first = read_index(in, n_insts);
+    block->last = read_index(in, n_insts);
+    unsigned long long count;
+    THROW_IF(fscanf(in, "%llu", &count) != 1, EXC_SYSTEM, "corrupt IR function");
+    block->count = count;
+    block->calls_noreturn = read_index(in, 2);
+    block->n_preds = block->preds_capacity = read_index(in, UINT32_MAX);
+    block->preds = arena_alloc(arena, block->n_preds * sizeof(IrBlockRef));
+    for (uint32_t i = 0; i < block->n_preds; i++) {
+      block->preds[i] = read_index(in, n_blocks);
+    }
+    block->n_succs = block->succs_capacity = read_index(in, UINT32_MAX);
+    block->succs = arena_alloc(arena, block->n_succs * sizeof(IrBlockRef));
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      block->succs[i] = read_index(in, n_blocks);
+    }
+  }
+  f->n_slots = f->slots_capacity = n_slots;
+  ALLOC(f, slots, n_slots);
+  for (uint32_t i = 0; i < n_slots; i++) {
+    THROW_IF(fscanf(in, "%d %d", &f->slots[i].size, &f->slots[i].align) != 2, EXC_SYSTEM, "corrupt IR function");
+  }
+  f->n_symbols = f->symbols_capacity = n_symbols;
+  ALLOC(f, symbols, n_symbols);
+  for (uint32_t i = 0; i < n_symbols; i++) {
+    THROW_IF(fscanf(in, "%1023s", name) != 1, EXC_SYSTEM, "corrupt IR function");
+    f->symbols[i] = copy_array(arena, name, strlen(name) + 1);
+  }
+  ir_verify(f);
+  return f;
+}
+
+#undef ALLOC
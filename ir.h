@@ -0,0 +1,296 @@
+/**
+ * SSA intermediate representation of one function.
+ *
+ * Instructions, operands and blocks are identified by 32-bit indices, and their fields are stored as parallel arrays
+ * (structure of arrays) allocated from the function's arena, so that passes scanning one field touch only that
+ * field's cache lines. Index 0 of every array is reserved, so IR_NONE doubles as "no instruction/block/operand".
+ *
+ * Every instruction defines at most one value, named by the instruction itself. Each operand slot is on the use list
+ * of the value it refers to, giving def-use chains; use-def is just the operand. Phis live at the start of their
+ * block and have one operand per predecessor, in the order of the block's preds.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include "arena.h"
+
+typedef uint32_t IrRef;  ///< instruction, and the value it defines
+typedef uint32_t IrBlockRef;
+typedef uint32_t IrUse;  ///< operand slot
+#define IR_NONE 0
+
+// Value types. Signedness is in the operations, as in the machine. Vectors hold lanes of i32, and the arithmetic ops
+// apply to them lane by lane. Floating values have operations of their own, and constants of them hold their bits.
+#define IR_TYPES(f) \
+  f(VOID,  "void",  0) \
+  f(I8,    "i8",    1) \
+  f(I16,   "i16",   2) \
+  f(I32,   "i32",   4) \
+  f(I64,   "i64",   8) \
+  f(PTR,   "ptr",   8) \
+  f(F32,   "f32",   4) \
+  f(F64,   "f64",   8) \
+  f(V4I32, "v4i32", 16) \
+  f(V8I32, "v8i32", 32)
+
+#define IR_TYPE_ENUM_(name, text, size) IR_##name,
+typedef enum {
+  IR_TYPES(IR_TYPE_ENUM_)
+  N_IR_TYPES
+} IrType;
+#undef IR_TYPE_ENUM_
+
+// Operation flags
+#define IR_PURE 1  ///< no side effects and cannot trap: removable if unused, and equal operands give equal results
+#define IR_TERMINATOR 2  ///< ends a block; successors are the block's succs, in order
+#define IR_COMMUTATIVE 4
+
+// name, mnemonic, number of operands (-1 if variable), flags
+#define IR_OPS(f) \
+  f(NOP,    "nop",     0, 0) \
+  f(UNDEF,  "undef",   0, IR_PURE) \
+  f(CONST,  "const",   0, IR_PURE)  /* imm is the value */ \
+  f(PARAM,  "param",   0, 0)  /* imm is the parameter index */ \
+  f(PHI,    "phi",    -1, IR_PURE) \
+  f(SLOT,   "slot",    0, IR_PURE)  /* address of stack slot imm */ \
+  f(GLOBAL, "global",  0, IR_PURE)  /* address of symbol imm */ \
+  f(ADD,    "add",     2, IR_PURE | IR_COMMUTATIVE) \
+  f(SUB,    "sub",     2, IR_PURE) \
+  f(MUL,    "mul",     2, IR_PURE | IR_COMMUTATIVE) \
+  f(SDIV,   "sdiv",    2, 0) \
+  f(UDIV,   "udiv",    2, 0) \
+  f(SREM,   "srem",    2, 0) \
+  f(UREM,   "urem",    2, 0) \
+  f(AND,    "and",     2, IR_PURE | IR_COMMUTATIVE) \
+  f(OR,     "or",      2, IR_PURE | IR_COMMUTATIVE) \
+  f(XOR,    "xor",     2, IR_PURE | IR_COMMUTATIVE) \
+  f(SHL,    "shl",     2, IR_PURE) \
+  f(SHR,    "shr",     2, IR_PURE)  /* logical */ \
+  f(SAR,    "sar",     2, IR_PURE)  /* arithmetic */ \
+  f(EQ,     "eq",      2, IR_PURE | IR_COMMUTATIVE) \
+  f(NE,     "ne",      2, IR_PURE | IR_COMMUTATIVE) \
+  f(SLT,    "slt",     2, IR_PURE) \
+  f(SLE,    "sle",     2, IR_PURE) \
+  f(SGT,    "sgt",     2, IR_PURE) \
+  f(SGE,    "sge",     2, IR_PURE) \
+  f(ULT,    "ult",     2, IR_PURE) \
+  f(ULE,    "ule",     2, IR_PURE) \
+  f(UGT,    "ugt",     2, IR_PURE) \
+  f(UGE,    "uge",     2, IR_PURE) \
+  f(FADD,   "fadd",    2, IR_PURE | IR_COMMUTATIVE) \
+  f(FSUB,   "fsub",    2, IR_PURE) \
+  f(FMUL,   "fmul",    2, IR_PURE | IR_COMMUTATIVE) \
+  f(FDIV,   "fdiv",    2, IR_PURE)  /* floating division does not trap */ \
+  f(FEQ,    "feq",     2, IR_PURE | IR_COMMUTATIVE)  /* the ordered comparisons: false if either is NaN */ \
+  f(FNE,    "fne",     2, IR_PURE | IR_COMMUTATIVE)  /* true if either is NaN */ \
+  f(FLT,    "flt",     2, IR_PURE) \
+  f(FLE,    "fle",     2, IR_PURE) \
+  f(FGT,    "fgt",     2, IR_PURE) \
+  f(FGE,    "fge",     2, IR_PURE) \
+  f(SEXT,   "sext",    1, IR_PURE) \
+  f(ZEXT,   "zext",    1, IR_PURE) \
+  f(TRUNC,  "trunc",   1, IR_PURE) \
+  f(SITOFP, "sitofp",  1, IR_PURE)  /* signed i32 or i64 to floating */ \
+  f(FPTOSI, "fptosi",  1, IR_PURE)  /* floating to signed i32 or i64, rounding toward zero */ \
+  f(FPEXT,  "fpext",   1, IR_PURE)  /* f32 to f64 */ \
+  f(FPTRUNC, "fptrunc", 1, IR_PURE)  /* f64 to f32 */ \
+  f(SELECT, "select",  3, IR_PURE)  /* the second operand if the first is nonzero, else the third */ \
+  f(SPLAT,  "splat",   1, IR_PURE)  /* a vector with the scalar operand in every lane */ \
+  f(HSUM,   "hsum",    1, IR_PURE)  /* the sum of the lanes of the vector operand */ \
+  f(LOAD,   "load",    1, 0) \
+  f(STORE,  "store",   2, 0)  /* address, value */ \
+  f(ZERO,   "zero",    1, 0)  /* clear imm bytes at the address */ \
+  f(COPY,   "copy",    2, 0)  /* copy imm bytes from the second address to the first; the two are equal or disjoint */ \
+  f(CALL,   "call",   -1, 0)  /* call symbol imm with the operands as arguments */ \
+  f(COUNT,  "count",   1, 0)  /* add one, atomically, to 8-byte counter imm of the profile counters at the address */ \
+  f(RET,    "ret",    -1, IR_TERMINATOR) \
+  f(JMP,    "jmp",     0, IR_TERMINATOR) \
+  f(BR,     "br",      1, IR_TERMINATOR)  /* to succs[0] if the operand is nonzero, else succs[1] */ \
+  f(SWITCH, "switch", -1, IR_TERMINATOR)  /* to succs[i] if operand 0 equals constant operand i, else succs[0] */
+
+#define IR_OP_ENUM_(name, text, n_args, flags) IR_##name,
+typedef enum {
+  IR_OPS(IR_OP_ENUM_)
+  N_IR_OPS
+} IrOp;
+#undef IR_OP_ENUM_
+
+extern const char *IR_OP_NAMES[];
+extern const int IR_OP_N_ARGS[];
+extern const int IR_OP_FLAGS[];
+extern const char *IR_TYPE_NAMES[];
+extern const int IR_TYPE_SIZES[];
+
+typedef struct {
+  IrRef first, last;  ///< instructions, linked through next/prev
+  IrBlockRef *preds;
+  IrBlockRef *succs;
+  uint32_t n_preds, preds_capacity;
+  uint32_t n_succs, succs_capacity;
+  uint64_t count;  ///< times the block ran, by a profile or an estimate; kept roughly right as blocks change
+  unsigned calls_noreturn : 1;  ///< as the front end built it, calls a function that does not return
+} IrBlock;
+
+typedef struct {
+  int size;
+  int align;
+} IrSlot;
+
+typedef struct IrFunction {
+  Arena *arena;
+  const char *name;
+  int n_params;
+  unsigned is_static : 1;  ///< not visible outside the translation unit
+  unsigned is_inline : 1;  ///< declared inline
+  unsigned has_profile : 1;  ///< whether the counts of the blocks come from a profile
+
+  // Instructions, indexed by IrRef
+  uint32_t n_insts, insts_capacity;
+  uint8_t *op;  ///< IrOp
+  uint8_t *type;  ///< IrType of the value defined; IR_VOID if none
+  IrBlockRef *block;  ///< IR_NONE once removed
+  IrRef *next, *prev;
+  IrUse *args;  ///< first operand slot
+  uint32_t *n_args;
+  int64_t *imm;
+  IrUse *first_use;
+
+  // Operand slots, indexed by IrUse
+  uint32_t n_operands, operands_capacity;
+  IrRef *operand;  ///< the value used
+  IrRef *user;  ///< the instruction using it
+  IrUse *next_use, *prev_use;  ///< use list of operand[u]
+
+  // Blocks, indexed by IrBlockRef. The entry block is 1.
+  uint32_t n_blocks, blocks_capacity;
+  IrBlock *blocks;
+
+  IrSlot *slots;
+  uint32_t n_slots, slots_capacity;
+  const char **symbols;
+  uint32_t n_symbols, symbols_capacity;
+} IrFunction;
+
+#define IR_ENTRY_BLOCK 1
+
+#define IR_IS_VECTOR_TYPE(type) ((type) == IR_V4I32 || (type) == IR_V8I32)
+#define IR_IS_FLOAT_TYPE(type) ((type) == IR_F32 || (type) == IR_F64)
+#define IR_ARG(f, inst, i) ((f)->operand[(f)->args[inst] + (i)])
+#define IR_IS_PURE(f, inst) (IR_OP_FLAGS[(f)->op[inst]] & IR_PURE)
+#define IR_IS_TERMINATOR(f, inst) (IR_OP_FLAGS[(f)->op[inst]] & IR_TERMINATOR)
+/** Iterate over the instructions of block b; inst may be removed in the body. */
+#define IR_FOR_EACH_INST(f, b, inst) \
+  for (IrRef inst = (f)->blocks[b].first, inst##_next_ = inst ? (f)->next[inst] : 0; inst; \
+    inst = inst##_next_, inst##_next_ = inst ? (f)->next[inst] : 0)
+/** Iterate over the operand slots using def; the user of slot use is f->user[use]. */
+#define IR_FOR_EACH_USE(f, def, use) for (IrUse use = (f)->first_use[def]; use; use = (f)->next_use[use])
+
+IrFunction *new_ir_function(const char *name);
+void free_ir_function(IrFunction *f);
+/** A copy of f in an arena of its own, with the same numbering of instructions, operands, blocks and slots */
+IrFunction *ir_copy_function(const IrFunction *f);
+
+IrBlockRef ir_new_block(IrFunction *f);
+void ir_add_edge(IrFunction *f, IrBlockRef from, IrBlockRef to);
+
+/** Append an instruction to block b. */
+IrRef ir_append(IrFunction *f, IrBlockRef b, IrOp op, IrType type, int n_args, const IrRef *args, int64_t imm);
+/** Insert an instruction before inst, in its block. */
+IrRef ir_insert_before(IrFunction *f, IrRef inst, IrOp op, IrType type, int n_args, const IrRef *args, int64_t imm);
+/** Move inst to just before another instruction, which may be in another block. */
+void ir_move_before(IrFunction *f, IrRef inst, IrRef before);
+/** Insert a phi without operands after the phis at the start of b. */
+IrRef ir_insert_phi(IrFunction *f, IrBlockRef b, IrType type);
+/** Give an operand-less phi one operand per predecessor of its block. */
+void ir_set_phi_args(IrFunction *f, IrRef phi, const IrRef *values);
+void ir_set_arg(IrFunction *f, IrRef inst, int i, IrRef value);
+/** Make every use of old a use of new. */
+void ir_replace_uses(IrFunction *f, IrRef old, IrRef new);
+/** Unlink inst from its block and from the use lists of its operands. Its own value must be unused. */
+void ir_remove(IrFunction *f, IrRef inst);
+int ir_n_uses(const IrFunction *f, IrRef inst);
+/** The terminator of b, or IR_NONE if b is still open. */
+IrRef ir_terminator(const IrFunction *f, IrBlockRef b);
+
+/** Allocate a stack slot; the SLOT instruction refers to it by index. */
+int ir_new_slot(IrFunction *f, int size, int align);
+int ir_intern_symbol(IrFunction *f, const char *name);
+
+/** The imm of a CONST of floating type holding value: its bits, of the float or the double */
+int64_t ir_float_bits(IrType type, double value);
+/** The value of a floating constant with the given bits */
+double ir_float_value(IrType type, int64_t bits);
+
+/**
+ * Move inst and the instructions after it to a new block, which takes over the successors of its block, and return
+ * it. The old block is left open, without successors.
+ */
+IrBlockRef ir_split_block(IrFunction *f, IrRef inst);
+/**
+ * The times the edge from b to its successor succs[i] was taken, by the counts of the blocks: that of b if it has no
+ * other successor, or of the successor if it has no other predecessor; otherwise what b's count leaves after its
+ * other edges, shared among the edges like this one by the counts of their targets.
+ */
+uint64_t ir_edge_count(const IrFunction *f, IrBlockRef b, uint32_t i);
+/** Put a new block, which only jumps on, on the edge from b to its successor succs[i], and return it. */
+IrBlockRef ir_split_edge(IrFunction *f, IrBlockRef b, uint32_t i);
+/** Replace the branch or switch ending b by a jump to succs[taken], removing the other edges and their phi operands. */
+void ir_fold_branch(IrFunction *f, IrBlockRef b, int taken);
+/** Delete blocks not reachable from the entry, and renumber the rest in their original order. */
+void ir_remove_unreachable_blocks(IrFunction *f);
+/** Give every edge from a block with several successors to a block with several predecessors a block of its own,
+ * so that moves for the phis of the target have somewhere to go. */
+void ir_split_critical_edges(IrFunction *f);
+/** Fill order with the reachable blocks in reverse postorder, returning how many there are. */
+int ir_reverse_postorder(const IrFunction *f, IrBlockRef *order);
+/**
+ * Fill idom with the immediate dominator of each block, or IR_NONE for the entry and unreachable blocks, by the
+ * algorithm of Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm" (2001).
+ */
+void ir_immediate_dominators(const IrFunction *f, IrBlockRef *idom);
+
+/** Whether a dominates b, given the immediate dominators from ir_immediate_dominators */
+int ir_dominates(const IrBlockRef *idom, IrBlockRef a, IrBlockRef b);
+
+/**
+ * A natural loop: the target of one or more back edges, which are edges to a block dominating their source, and the
+ * blocks that reach a back edge without passing through that target, the header.
+ */
+typedef struct {
+  IrBlockRef header;
+  /** The header's only predecessor outside the loop, if that has no other successor; else IR_NONE */
+  IrBlockRef preheader;
+  IrBlockRef *latches;  ///< sources of the back edges
+  IrBlockRef *blocks;  ///< in reverse postorder, so the header first
+  IrBlockRef *exits;  ///< blocks outside the loop with a predecessor inside it
+  uint32_t n_latches, n_blocks, n_exits;
+  int parent;  ///< index of the innermost loop enclosing this one, or -1
+  int depth;  ///< 1 for outermost loops
+} IrLoop;
+
+typedef struct {
+  IrLoop *loops;  ///< inner loops before the ones enclosing them
+  int n_loops;
+  uint32_t n_blocks;  ///< blocks in the function when the loops were found; any added since are in none
+  int *innermost;  ///< by block: index of the innermost loop containing it, or -1
+  IrBlockRef *idom;  ///< by block: see ir_immediate_dominators
+} IrLoopForest;
+
+/** Find the natural loops of f, allocated from its arena. */
+IrLoopForest *ir_find_loops(IrFunction *f);
+/** Whether block b is in loop, or in a loop nested in it */
+int ir_loop_contains(const IrLoopForest *forest, int loop, IrBlockRef b);
+/**
+ * Give the header of a loop a preheader, if it has none: a new block, jumping to the header, that the edges from
+ * outside the loop are redirected to. Return whether one was added; the loop forest of f is out of date if so.
+ */
+int ir_insert_preheader(IrFunction *f, const IrLoop *loop);
+
+/** Check structural invariants, throwing EXC_INTERNAL on the first violation. */
+void ir_verify(const IrFunction *f);
+void fprint_ir_function(FILE *out, const IrFunction *f);
+/** Write f for read_ir_function, which reads back an exact copy, with the same numbering of everything. */
+void fwrite_ir_function(FILE *out, const IrFunction *f);
+/** Read a function written by fwrite_ir_function, or return NULL at the end of in. Throws EXC_SYSTEM if malformed. */
+IrFunction *read_ir_function(FILE *in);
@@ -0,0 +1,1667 @@
+#include "ir_opt.h"
+
+#include <string.h>
+#include "common.h"
+#include "vendor/klib/khash.h"
+
+static int is_dead(const IrFunction *f, IrRef inst) {
+  return f->block[inst] && f->type[inst] != IR_VOID && !f->first_use[inst]
+    && (IR_IS_PURE(f, inst) || f->op[inst] == IR_LOAD);
+}
+
+void eliminate_dead_code(IrFunction *f, IrOptStats *stats) {
+  // Operands come before their users except around loops, so a backward sweep removes most chains at once.
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (IrBlockRef b = f->n_blocks - 1; b >= IR_ENTRY_BLOCK; b--) {
+      for (IrRef inst = f->blocks[b].last, prev; inst; inst = prev) {
+        prev = f->prev[inst];
+        if (is_dead(f, inst)) {
+          ir_remove(f, inst);
+          stats->n_dead_insts++;
+          changed = 1;
+        }
+      }
+    }
+  }
+}
+
+#define UNKNOWN_OFFSET -1
+
+/** The stack slot address points into, or -1 if none; its offset into the slot goes in *offset, if constant. */
+static int slot_of(const IrFunction *f, IrRef address, int64_t *offset) {
+  switch (f->op[address]) {
+    case IR_SLOT:
+      *offset = 0;
+      return f->imm[address];
+    case IR_ADD: {
+      IrRef base = IR_ARG(f, address, 0), index = IR_ARG(f, address, 1);
+      if (f->type[base] != IR_PTR) {
+        IrRef tmp = base;
+        base = index;
+        index = tmp;
+      }
+      int slot = slot_of(f, base, offset);
+      if (slot >= 0 && *offset != UNKNOWN_OFFSET) {
+        *offset = f->op[index] == IR_CONST && *offset + f->imm[index] >= 0 ? *offset + f->imm[index] : UNKNOWN_OFFSET;
+      }
+      return slot;
+    }
+    default:
+      return -1;
+  }
+}
+
+/** Whether the address of a slot, or of something in it, is used other than to load, store, zero and copy at it */
+static int escapes(const IrFunction *f, IrRef address) {
+  IR_FOR_EACH_USE(f, address, use) {
+    IrRef user = f->user[use];
+    switch (f->op[user]) {
+      case IR_LOAD:
+      case IR_ZERO:
+      case IR_COPY:
+        break;
+      case IR_STORE:
+        if (use != f->args[user])
+          return 1;  // the address itself is stored
+        break;
+      case IR_ADD:
+        if (f->type[user] != IR_PTR || escapes(f, user))
+          return 1;
+        break;
+      default:
+        return 1;
+    }
+  }
+  return 0;
+}
+
+/** By slot: whether its address escapes */
+static uint8_t *find_escaped_slots(IrFunction *f) {
+  uint8_t *escaped = arena_alloc(f->arena, f->n_slots + 1);
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    if (f->block[inst] && f->op[inst] == IR_SLOT && escapes(f, inst)) {
+      escaped[f->imm[inst]] = 1;
+    }
+  }
+  return escaped;
+}
+
+int frame_escapes(IrFunction *f) {
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    if (f->block[inst] && f->op[inst] == IR_SLOT && escapes(f, inst))
+      return 1;
+  }
+  return 0;
+}
+
+typedef struct {
+  IrFunction *f;
+  IrOptStats *stats;
+  /**
+   * By slot: one flag per byte, set if the byte is written, or the function returns, before the byte is next read.
+   * The flags describe the point just after the instruction being visited, walking each block backward.
+   */
+  uint8_t **dead;
+  uint8_t *escaped;  ///< by slot: see escapes()
+} DeadStores;
+
+static void clear_escaped(DeadStores *d) {
+  for (uint32_t s = 0; s < d->f->n_slots; s++) {
+    if (d->escaped[s]) {
+      memset(d->dead[s], 0, d->f->slots[s].size);
+    }
+  }
+}
+
+/** Record a read of size bytes at address, or of an unknown amount if size is 0. */
+static void note_read(DeadStores *d, IrRef address, int size) {
+  int64_t offset;
+  int slot = slot_of(d->f, address, &offset);
+  int slot_size = slot >= 0 ? d->f->slots[slot].size : 0;
+  if (slot < 0) {
+    clear_escaped(d);
+  } else if (offset == UNKNOWN_OFFSET || !size || offset + size > slot_size) {
+    memset(d->dead[slot], 0, slot_size);
+  } else {
+    memset(d->dead[slot] + offset, 0, size);
+  }
+}
+
+// Holes up to this size are cleared by stores of zero, and larger ones by a smaller zero.
+#define MAX_INLINE_ZERO 32
+
+static const IrType INT_TYPES[] = {[1] = IR_I8, [2] = IR_I16, [4] = IR_I32, [8] = IR_I64};
+
+/** The address of the byte delta bytes past address, computed before inst */
+static IrRef offset_address(IrFunction *f, IrRef inst, IrRef address, int64_t delta) {
+  if (!delta)
+    return address;
+  IrRef args[] = {address, ir_insert_before(f, inst, IR_CONST, IR_I64, 0, 0, delta)};
+  return ir_insert_before(f, inst, IR_ADD, IR_PTR, 2, args, 0);
+}
+
+/**
+ * Clear bytes [start, end) past the address of zero inst, itself at offset in its slot, before inst: with stores of
+ * the widest aligned integers that fit, or another zero if the hole is large.
+ */
+static void clear_hole(IrFunction *f, IrRef inst, int64_t offset, int64_t start, int64_t end) {
+  IrRef address = IR_ARG(f, inst, 0);
+  if (end - start > MAX_INLINE_ZERO) {
+    IrRef hole = offset_address(f, inst, address, start);
+    ir_insert_before(f, inst, IR_ZERO, IR_VOID, 1, &hole, end - start);
+    return;
+  }
+  IrRef zeros[9] = {0};
+  while (start < end) {
+    int size = 8;
+    while (size > end - start || (offset + start) % size) {
+      size /= 2;
+    }
+    if (!zeros[size]) {
+      zeros[size] = ir_insert_before(f, inst, IR_CONST, INT_TYPES[size], 0, 0, 0);
+    }
+    IrRef args[] = {offset_address(f, inst, address, start), zeros[size]};
+    ir_insert_before(f, inst, IR_STORE, IR_VOID, 2, args, 0);
+    start += size;
+  }
+}
+
+static void visit_zero(DeadStores *d, IrRef inst) {
+  IrFunction *f = d->f;
+  int64_t offset, size = f->imm[inst];
+  int slot = slot_of(f, IR_ARG(f, inst, 0), &offset);
+  if (slot < 0 || offset == UNKNOWN_OFFSET || offset + size > f->slots[slot].size)
+    return;
+  uint8_t *dead = d->dead[slot] + offset;
+  int64_t n_holes = 0;
+  for (int64_t i = 0; i < size; i++) {
+    n_holes += !dead[i];
+  }
+  if (n_holes < size) {
+    for (int64_t start = 0; start < size; start++) {
+      if (dead[start])
+        continue;
+      int64_t end = start;
+      while (end < size && !dead[end]) {
+        end++;
+      }
+      clear_hole(f, inst, offset, start, end);
+      start = end;
+    }
+    ir_remove(f, inst);
+    d->stats->n_zero_bytes_saved += size - n_holes;
+  }
+  memset(dead, 1, size);
+}
+
+/** Record a write of size bytes at address, and return whether they were all dead already, making the write so. */
+static int note_write(DeadStores *d, IrRef address, int64_t size) {
+  int64_t offset;
+  int slot = slot_of(d->f, address, &offset);
+  if (slot < 0 || offset == UNKNOWN_OFFSET || offset + size > d->f->slots[slot].size)
+    return 0;  // may write anything, so kills nothing
+  uint8_t *dead = d->dead[slot] + offset;
+  int is_dead = 1;
+  for (int64_t i = 0; i < size; i++) {
+    is_dead &= dead[i];
+  }
+  memset(dead, 1, size);
+  return is_dead;
+}
+
+static void visit_store(DeadStores *d, IrRef inst) {
+  IrFunction *f = d->f;
+  if (note_write(d, IR_ARG(f, inst, 0), IR_TYPE_SIZES[f->type[IR_ARG(f, inst, 1)]])) {
+    ir_remove(f, inst);
+    d->stats->n_dead_stores++;
+  }
+}
+
+/** A copy writes its destination, and reads its source unless the write is dead. */
+static void visit_copy(DeadStores *d, IrRef inst) {
+  IrFunction *f = d->f;
+  if (note_write(d, IR_ARG(f, inst, 0), f->imm[inst])) {
+    ir_remove(f, inst);
+    d->stats->n_dead_stores++;
+    return;
+  }
+  note_read(d, IR_ARG(f, inst, 1), f->imm[inst]);
+}
+
+void eliminate_dead_stores(IrFunction *f, IrOptStats *stats) {
+  DeadStores d = { .f = f, .stats = stats };
+  d.dead = arena_alloc(f->arena, (f->n_slots + 1) * sizeof(uint8_t *));
+  d.escaped = find_escaped_slots(f);
+  for (uint32_t s = 0; s < f->n_slots; s++) {
+    d.dead[s] = arena_alloc(f->arena, f->slots[s].size);
+  }
+
+  // Within each block. Only a return is known to end the lifetime of the slots, except escaped ones.
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    IrRef last = ir_terminator(f, b);
+    int returns = last && f->op[last] == IR_RET;
+    for (uint32_t s = 0; s < f->n_slots; s++) {
+      memset(d.dead[s], returns && !d.escaped[s], f->slots[s].size);
+    }
+    for (IrRef inst = f->blocks[b].last, prev; inst; inst = prev) {
+      prev = f->prev[inst];
+      switch (f->op[inst]) {
+        case IR_LOAD:
+          note_read(&d, IR_ARG(f, inst, 0), IR_TYPE_SIZES[f->type[inst]]);
+          break;
+        case IR_STORE:
+          visit_store(&d, inst);
+          break;
+        case IR_ZERO:
+          visit_zero(&d, inst);
+          break;
+        case IR_COPY:
+          visit_copy(&d, inst);
+          break;
+        case IR_COUNT:
+          break;  // its counter is not in a slot
+        default:
+          if (!IR_IS_PURE(f, inst) && !IR_IS_TERMINATOR(f, inst) && f->op[inst] != IR_PARAM) {
+            clear_escaped(&d);  // may read memory through pointers to escaped slots
+          }
+          break;
+      }
+    }
+  }
+}
+
+// Value numbering
+
+/** What a numbered instruction computes: equal keys give equal values. */
+typedef struct {
+  uint8_t op, type;
+  IrRef args[3];  // as many as a select has
+  int64_t imm;
+} ValueKey;
+
+static khint_t hash_value_key(ValueKey key) {
+  uint64_t h = (uint64_t) key.op << 8 | key.type;
+  h = h * 0x9e3779b97f4a7c15 ^ key.args[0];
+  h = h * 0x9e3779b97f4a7c15 ^ key.args[1];
+  h = h * 0x9e3779b97f4a7c15 ^ key.args[2];
+  h = h * 0x9e3779b97f4a7c15 ^ (uint64_t) key.imm;
+  return (khint_t) (h >> 32 ^ h);
+}
+
+static int value_keys_equal(ValueKey a, ValueKey b) {
+  return a.op == b.op && a.type == b.type && a.args[0] == b.args[0] && a.args[1] == b.args[1]
+    && a.args[2] == b.args[2] && a.imm == b.imm;
+}
+
+KHASH_INIT(ValueTable, ValueKey, IrRef, 1, hash_value_key, value_keys_equal)
+
+/** A value known to be in memory at an address */
+typedef struct {
+  IrRef address;
+  IrRef value;
+} MemoryFact;
+
+typedef struct {
+  IrFunction *f;
+  IrOptStats *stats;
+  IrBlockRef **children;  ///< by block: the blocks it immediately dominates
+  uint32_t *n_children;
+  uint8_t *escaped;  ///< by slot: see escapes()
+  kh_ValueTable_t *values;  ///< the first instruction computing each key, among the dominators of the current one
+  DECLARE_VECTOR(ValueKey, scope)  ///< keys added to values, to remove on leaving the blocks that define them
+} ValueNumbering;
+
+/**
+ * Whether inst computes the same value as any other instruction with the same operands. Division traps on the same
+ * operands each time, so the first one to execute leaves the others nothing to do.
+ */
+static int is_numbered(const IrFunction *f, IrRef inst) {
+  switch (f->op[inst]) {
+    case IR_PHI: case IR_UNDEF:
+      return 0;
+    case IR_SDIV: case IR_UDIV: case IR_SREM: case IR_UREM:
+      return 1;
+    default:
+      return IR_IS_PURE(f, inst);
+  }
+}
+
+static int is_const(const IrFunction *f, IrRef value, int64_t imm) {
+  return f->op[value] == IR_CONST && f->imm[value] == imm;
+}
+
+/** An existing value inst merely copies, such as x for x + 0, or IR_NONE */
+static IrRef identity(const IrFunction *f, IrRef inst) {
+  if (f->n_args[inst] != 2)
+    return IR_NONE;
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1), ret = IR_NONE;
+  switch (f->op[inst]) {
+    case IR_ADD: case IR_OR: case IR_XOR:
+      ret = is_const(f, b, 0) ? a : is_const(f, a, 0) ? b : IR_NONE;
+      break;
+    case IR_SUB: case IR_SHL: case IR_SHR: case IR_SAR:
+      ret = is_const(f, b, 0) ? a : IR_NONE;
+      break;
+    case IR_MUL:
+      ret = is_const(f, b, 1) ? a : is_const(f, a, 1) ? b : IR_NONE;
+      break;
+    case IR_SDIV: case IR_UDIV:
+      ret = is_const(f, b, 1) ? a : IR_NONE;
+      break;
+    case IR_NE: {
+      // A comparison is 0 or 1 already, as when a condition is turned into a value.
+      IrOp op = f->op[a];
+      ret = is_const(f, b, 0) && ((op >= IR_EQ && op <= IR_UGE) || (op >= IR_FEQ && op <= IR_FGE)) ? a : IR_NONE;
+      break;
+    }
+    default:
+      break;
+  }
+  return ret && f->type[ret] == f->type[inst] ? ret : IR_NONE;
+}
+
+/** The low size bytes of value, extended to 64 bits as the signedness says */
+static int64_t extend(int64_t value, int size, int is_signed) {
+  if (size == 8)
+    return value;
+  int shift = 64 - 8 * size;
+  return is_signed ? (int64_t) ((uint64_t) value << shift) >> shift : (int64_t) ((uint64_t) value << shift >> shift);
+}
+
+/** Whether inst compares two constants, which may have been extended either way; if so, its result goes in *result. */
+static int compare_constants(const IrFunction *f, IrRef inst, int64_t *result) {
+  IrOp op = f->op[inst];
+  if (op < IR_EQ || op > IR_UGE)
+    return 0;
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  if (f->op[a] != IR_CONST || f->op[b] != IR_CONST)
+    return 0;
+  int size = IR_TYPE_SIZES[f->type[a]], is_signed = op < IR_ULT;
+  int64_t x = extend(f->imm[a], size, is_signed), y = extend(f->imm[b], size, is_signed);
+  uint64_t ux = x, uy = y;
+  switch (op) {
+    case IR_EQ: *result = x == y; break;
+    case IR_NE: *result = x != y; break;
+    case IR_SLT: *result = x < y; break;
+    case IR_SLE: *result = x <= y; break;
+    case IR_SGT: *result = x > y; break;
+    case IR_SGE: *result = x >= y; break;
+    case IR_ULT: *result = ux < uy; break;
+    case IR_ULE: *result = ux <= uy; break;
+    case IR_UGT: *result = ux > uy; break;
+    default: *result = ux >= uy; break;
+  }
+  return 1;
+}
+
+static ValueKey value_key(const IrFunction *f, IrRef inst) {
+  ValueKey key = { .op = f->op[inst], .type = f->type[inst], .imm = f->imm[inst] };
+  assert(f->n_args[inst] <= 3);
+  for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+    key.args[i] = IR_ARG(f, inst, i);
+  }
+  if (IR_OP_FLAGS[key.op] & IR_COMMUTATIVE && key.args[0] > key.args[1]) {
+    IrRef tmp = key.args[0];
+    key.args[0] = key.args[1];
+    key.args[1] = tmp;
+  }
+  return key;
+}
+
+/** Whether a and b are the same place in memory, as far as can be told */
+static int same_address(const IrFunction *f, IrRef a, IrRef b) {
+  int64_t a_offset, b_offset;
+  int slot = slot_of(f, a, &a_offset);
+  return a == b
+    || (slot >= 0 && slot == slot_of(f, b, &b_offset) && a_offset != UNKNOWN_OFFSET && a_offset == b_offset);
+}
+
+/** Whether the a_size bytes at a may overlap the b_size bytes at b */
+static int may_alias(const IrFunction *f, const uint8_t *escaped, IrRef a, int a_size, IrRef b, int b_size) {
+  int64_t a_offset, b_offset;
+  int a_slot = slot_of(f, a, &a_offset), b_slot = slot_of(f, b, &b_offset);
+  if (a_slot >= 0 && b_slot >= 0) {
+    return a_slot == b_slot && (a_offset == UNKNOWN_OFFSET || b_offset == UNKNOWN_OFFSET
+      || (a_offset < b_offset + b_size && b_offset < a_offset + a_size));
+  }
+  // Only pointers that escaped may point into a slot.
+  return (a_slot < 0 || escaped[a_slot]) && (b_slot < 0 || escaped[b_slot]);
+}
+
+/** Whether inst may write memory other than through its address operand, as a store does */
+static int clobbers_memory(const IrFunction *f, IrRef inst) {
+  switch (f->op[inst]) {
+    case IR_PARAM: case IR_LOAD: case IR_STORE: case IR_ZERO: case IR_COPY:
+    case IR_SDIV: case IR_UDIV: case IR_SREM: case IR_UREM:
+    case IR_COUNT:  // profile counters, which the program never reads
+      return 0;
+    default:
+      return !IR_IS_PURE(f, inst) && !IR_IS_TERMINATOR(f, inst);
+  }
+}
+
+/** Forget the facts about memory a write of size bytes at address may invalidate. */
+static int kill_facts(const ValueNumbering *vn, MemoryFact *facts, int n_facts, IrRef address, int size) {
+  const IrFunction *f = vn->f;
+  int n = 0;
+  for (int i = 0; i < n_facts; i++) {
+    int fact_size = IR_TYPE_SIZES[f->type[facts[i].value]];
+    if (!may_alias(f, vn->escaped, facts[i].address, fact_size, address, size)) {
+      facts[n++] = facts[i];
+    }
+  }
+  return n;
+}
+
+static void replace(ValueNumbering *vn, IrRef inst, IrRef value) {
+  ir_replace_uses(vn->f, inst, value);
+  ir_remove(vn->f, inst);
+}
+
+/** Number the instructions of b and then of the blocks it dominates, given what is known to be in memory on entry. */
+static void number_block(ValueNumbering *vn, IrBlockRef b, const MemoryFact *known_facts, int n_known_facts) {
+  IrFunction *f = vn->f;
+  int scope_start = vn->scope_size;
+  DECLARE_VECTOR(MemoryFact, facts)
+  NEW_VECTOR(facts, sizeof(MemoryFact));
+  for (int i = 0; i < n_known_facts; i++) {
+    APPEND_VECTOR(facts, known_facts[i]);
+  }
+  IR_FOR_EACH_INST(f, b, inst) {
+    IrOp op = f->op[inst];
+    int64_t result;
+    if (compare_constants(f, inst, &result)) {
+      // As in the test in front of a rotated loop whose variable starts at a constant
+      replace(vn, inst, ir_insert_before(f, inst, IR_CONST, f->type[inst], 0, 0, result));
+      vn->stats->n_folded_comparisons++;
+    } else if (is_numbered(f, inst)) {
+      IrRef same = identity(f, inst);
+      if (same) {
+        replace(vn, inst, same);
+        vn->stats->n_redundant_values++;
+        continue;
+      }
+      int ret;
+      ValueKey key = value_key(f, inst);
+      khiter_t iter = kh_put_ValueTable(vn->values, key, &ret);
+      THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+      if (ret) {
+        kh_val(vn->values, iter) = inst;
+        APPEND_VECTOR(vn->scope, key);
+      } else {
+        replace(vn, inst, kh_val(vn->values, iter));
+        vn->stats->n_redundant_values++;
+      }
+    } else if (op == IR_LOAD) {
+      IrRef address = IR_ARG(f, inst, 0), known = IR_NONE;
+      for (int i = 0; i < facts_size && !known; i++) {
+        if (f->type[facts[i].value] == f->type[inst] && same_address(f, facts[i].address, address)) {
+          known = facts[i].value;
+        }
+      }
+      if (known) {
+        replace(vn, inst, known);
+        vn->stats->n_redundant_loads++;
+      } else {
+        APPEND_VECTOR(facts, ((MemoryFact) { .address = address, .value = inst }));
+      }
+    } else if (op == IR_STORE || op == IR_ZERO || op == IR_COPY) {
+      IrRef address = IR_ARG(f, inst, 0);
+      int size = op == IR_STORE ? IR_TYPE_SIZES[f->type[IR_ARG(f, inst, 1)]] : f->imm[inst];
+      facts_size = kill_facts(vn, facts, facts_size, address, size);
+      if (op == IR_STORE) {
+        APPEND_VECTOR(facts, ((MemoryFact) { .address = address, .value = IR_ARG(f, inst, 1) }));
+      }
+    } else if (clobbers_memory(f, inst)) {
+      facts_size = 0;
+    }
+  }
+
+  // Memory is as b leaves it only in successors reached from nowhere else.
+  for (uint32_t i = 0; i < vn->n_children[b]; i++) {
+    IrBlockRef child = vn->children[b][i];
+    number_block(vn, child, facts, f->blocks[child].n_preds == 1 ? facts_size : 0);
+  }
+  free(facts);
+
+  while (vn->scope_size > scope_start) {
+    kh_del_ValueTable(vn->values, kh_get_ValueTable(vn->values, VECTOR_LAST(vn->scope)));
+    POP_VECTOR_VOID(vn->scope);
+  }
+}
+
+void number_values(IrFunction *f, IrOptStats *stats) {
+  ValueNumbering vn = { .f = f, .stats = stats };
+  IrBlockRef *idom = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  ir_immediate_dominators(f, idom);
+  vn.children = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef *));
+  vn.n_children = arena_alloc(f->arena, f->n_blocks * sizeof(uint32_t));
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    vn.n_children[idom[b]]++;
+  }
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    vn.children[b] = arena_alloc(f->arena, (vn.n_children[b] + 1) * sizeof(IrBlockRef));
+    vn.n_children[b] = 0;
+  }
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    if (idom[b]) {
+      vn.children[idom[b]][vn.n_children[idom[b]]++] = b;
+    }
+  }
+  vn.escaped = find_escaped_slots(f);
+  vn.values = kh_init_ValueTable();
+  NEW_VECTOR(vn.scope, sizeof(ValueKey));
+  number_block(&vn, IR_ENTRY_BLOCK, 0, 0);
+
+  kh_destroy_ValueTable(vn.values);
+  free(vn.scope);
+}
+
+// Branches
+
+/** If every operand of phi is one value or phi itself, return that value, else IR_NONE. */
+static IrRef trivial_phi_value(const IrFunction *f, IrRef phi) {
+  IrRef value = IR_NONE;
+  for (uint32_t i = 0; i < f->n_args[phi]; i++) {
+    IrRef arg = IR_ARG(f, phi, i);
+    if (arg == phi || arg == value)
+      continue;
+    if (value)
+      return IR_NONE;
+    value = arg;
+  }
+  return value;
+}
+
+/** The operand of phi for the edge from block from, such as the preheader of its loop or its latch */
+static IrRef incoming_value(const IrFunction *f, IrBlockRef from, IrRef phi) {
+  const IrBlock *block = &f->blocks[f->block[phi]];
+  for (uint32_t k = 0;; k++) {
+    if (block->preds[k] == from)
+      return IR_ARG(f, phi, k);
+  }
+}
+
+/** Which successor a switch on a constant takes: that of the case equal to it in the bits of its type, else 0 */
+static int switch_target(const IrFunction *f, IrRef inst) {
+  IrRef value = IR_ARG(f, inst, 0);
+  int shift = 64 - 8 * IR_TYPE_SIZES[f->type[value]];
+  for (uint32_t i = 1; i < f->n_args[inst]; i++) {
+    if ((uint64_t) (f->imm[IR_ARG(f, inst, i)] ^ f->imm[value]) << shift == 0)
+      return i;
+  }
+  return 0;
+}
+
+void fold_constant_branches(IrFunction *f, IrOptStats *stats) {
+  int folded = 0;
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    IrRef last = ir_terminator(f, b);
+    if (!last || (f->op[last] != IR_BR && f->op[last] != IR_SWITCH) || f->op[IR_ARG(f, last, 0)] != IR_CONST)
+      continue;
+    ir_fold_branch(f, b, f->op[last] == IR_BR ? !f->imm[IR_ARG(f, last, 0)] : switch_target(f, last));
+    stats->n_folded_branches++;
+    folded = 1;
+  }
+  if (!folded)
+    return;
+  ir_remove_unreachable_blocks(f);
+  // Merges that lost all but one of their incoming values
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+      IR_FOR_EACH_INST(f, b, inst) {
+        if (f->op[inst] != IR_PHI)
+          break;
+        IrRef value = trivial_phi_value(f, inst);
+        if (value) {
+          ir_replace_uses(f, inst, value);
+          ir_remove(f, inst);
+          changed = 1;
+        }
+      }
+    }
+  }
+}
+
+// Instructions the arms of a branch may compute between them to have them all computed unconditionally instead
+#define MAX_SPECULATED 4
+
+/**
+ * Follow the arm of the branch ending block from that starts at its successor start: the blocks only the one before
+ * reaches, that compute nothing but pure values and jump on. Return the block the arm ends in a jump to, and set *last
+ * to the one jumping there, which is from itself if the arm is empty. Its instructions other than constants are added
+ * to *n_speculated.
+ */
+static IrBlockRef follow_arm(const IrFunction *f, IrBlockRef from, IrBlockRef start, IrBlockRef *last,
+  int *n_speculated) {
+  *last = from;
+  for (IrBlockRef b = start;; b = f->blocks[b].succs[0]) {
+    IrRef jump = ir_terminator(f, b);
+    if (b == from || f->blocks[b].n_preds != 1 || f->op[jump] != IR_JMP)
+      return b;
+    int n = 0;
+    for (IrRef inst = f->blocks[b].first; inst != jump; inst = f->next[inst]) {
+      if (f->op[inst] == IR_PHI || !IR_IS_PURE(f, inst))
+        return b;
+      n += f->op[inst] != IR_CONST;
+    }
+    *n_speculated += n;
+    *last = b;
+  }
+}
+
+/** Whether every phi of b merges integers or pointers, which conditional moves can select between, and there is one */
+static int has_selectable_phis(const IrFunction *f, IrBlockRef b) {
+  IrRef inst = f->blocks[b].first;
+  if (f->op[inst] != IR_PHI)
+    return 0;
+  for (; f->op[inst] == IR_PHI; inst = f->next[inst]) {
+    if (IR_IS_FLOAT_TYPE(f->type[inst]) || IR_IS_VECTOR_TYPE(f->type[inst]))
+      return 0;
+  }
+  return 1;
+}
+
+/** Move the instructions of the arm from start to last into b, before its branch. */
+static void hoist_arm(IrFunction *f, IrBlockRef b, IrBlockRef start, IrBlockRef last) {
+  if (last == b)
+    return;
+  IrRef branch = ir_terminator(f, b);
+  for (IrBlockRef arm = start;; arm = f->blocks[arm].succs[0]) {
+    IR_FOR_EACH_INST(f, arm, inst) {
+      if (!IR_IS_TERMINATOR(f, inst)) {
+        ir_move_before(f, inst, branch);
+      }
+    }
+    if (arm == last)
+      return;
+  }
+}
+
+/** If the branch ending b only chooses between values to merge, compute both and select one; return whether so. */
+static int convert_branch(IrFunction *f, IrBlockRef b) {
+  IrRef branch = ir_terminator(f, b);
+  if (f->op[branch] != IR_BR || f->blocks[b].succs[0] == f->blocks[b].succs[1])
+    return 0;
+  IrBlockRef then_start = f->blocks[b].succs[0], else_start = f->blocks[b].succs[1], then_last, else_last;
+  int n_speculated = 0;
+  IrBlockRef join = follow_arm(f, b, then_start, &then_last, &n_speculated);
+  if (join == b || follow_arm(f, b, else_start, &else_last, &n_speculated) != join || n_speculated > MAX_SPECULATED
+    || f->blocks[join].n_preds != 2 || !has_selectable_phis(f, join))
+    return 0;
+  hoist_arm(f, b, then_start, then_last);
+  hoist_arm(f, b, else_start, else_last);
+  IrRef cond = IR_ARG(f, branch, 0);
+  IR_FOR_EACH_INST(f, join, phi) {
+    if (f->op[phi] != IR_PHI)
+      break;
+    IrRef args[] = {cond, incoming_value(f, then_last, phi), incoming_value(f, else_last, phi)};
+    ir_replace_uses(f, phi, ir_insert_before(f, branch, IR_SELECT, f->type[phi], 3, args, 0));
+    ir_remove(f, phi);
+  }
+  // The then arm is left to jump on to the join, empty; the else arm is no longer reached.
+  ir_fold_branch(f, b, 0);
+  return 1;
+}
+
+void convert_branches_to_selects(IrFunction *f, IrOptStats *stats) {
+  // Converting an inner branch can leave the arms of the one around it pure, once the else arm it no longer reaches
+  // stops counting as a predecessor of the join.
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+      if (convert_branch(f, b)) {
+        stats->n_selects++;
+        changed = 1;
+      }
+    }
+    if (changed) {
+      ir_remove_unreachable_blocks(f);
+    }
+  }
+}
+
+// Loops
+
+typedef struct {
+  IrFunction *f;
+  IrLoopForest *forest;
+  int loop;  ///< index in forest
+  uint8_t *escaped;  ///< by slot: see escapes()
+  int clobbers;  ///< whether the loop calls something that may write memory
+} LoopContext;
+
+static int is_in_loop(const LoopContext *c, IrRef value) {
+  return ir_loop_contains(c->forest, c->loop, c->f->block[value]);
+}
+
+/** Whether inst, a load in the loop, reads memory nothing in the loop may write */
+static int reads_invariant_memory(const LoopContext *c, IrRef inst) {
+  const IrFunction *f = c->f;
+  const IrLoop *loop = &c->forest->loops[c->loop];
+  IrRef address = IR_ARG(f, inst, 0);
+  int size = IR_TYPE_SIZES[f->type[inst]];
+  int64_t offset;
+  int slot = slot_of(f, address, &offset);
+  if (c->clobbers && (slot < 0 || c->escaped[slot]))
+    return 0;
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    IR_FOR_EACH_INST(f, loop->blocks[i], other) {
+      if (f->op[other] == IR_STORE) {
+        int other_size = IR_TYPE_SIZES[f->type[IR_ARG(f, other, 1)]];
+        if (may_alias(f, c->escaped, IR_ARG(f, other, 0), other_size, address, size))
+          return 0;
+      } else if (f->op[other] == IR_ZERO || f->op[other] == IR_COPY) {
+        if (may_alias(f, c->escaped, IR_ARG(f, other, 0), f->imm[other], address, size))
+          return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+/**
+ * Whether inst, a load, may execute whenever the loop is entered: if its address is always valid, or it executes
+ * before the loop can be left, in every iteration.
+ */
+static int may_load_early(const LoopContext *c, IrRef inst) {
+  const IrFunction *f = c->f;
+  const IrLoop *loop = &c->forest->loops[c->loop];
+  IrRef address = IR_ARG(f, inst, 0);
+  int64_t offset;
+  int slot = slot_of(f, address, &offset);
+  if (f->op[address] == IR_GLOBAL
+    || (slot >= 0 && offset != UNKNOWN_OFFSET && offset + IR_TYPE_SIZES[f->type[inst]] <= f->slots[slot].size))
+    return 1;
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    const IrBlock *block = &f->blocks[loop->blocks[i]];
+    for (uint32_t j = 0; j < block->n_succs; j++) {
+      if (!ir_loop_contains(c->forest, c->loop, block->succs[j])
+        && !ir_dominates(c->forest->idom, f->block[inst], loop->blocks[i]))
+        return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * Whether inst computes the same value in every iteration of the loop, and may be computed once before it instead:
+ * pure instructions, divisions that cannot trap, and loads of memory the loop does not write, all of invariant
+ * operands.
+ */
+static int is_loop_invariant(const LoopContext *c, IrRef inst) {
+  const IrFunction *f = c->f;
+  switch (f->op[inst]) {
+    case IR_PHI: case IR_UNDEF:
+      return 0;
+    case IR_SDIV: case IR_UDIV: case IR_SREM: case IR_UREM: {
+      // Division traps only by zero, and by -1 on overflow.
+      IrRef divisor = IR_ARG(f, inst, 1);
+      if (f->op[divisor] != IR_CONST || is_const(f, divisor, 0) || is_const(f, divisor, -1))
+        return 0;
+      break;
+    }
+    case IR_LOAD:
+      break;
+    default:
+      if (!IR_IS_PURE(f, inst))
+        return 0;
+      break;
+  }
+  for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+    if (is_in_loop(c, IR_ARG(f, inst, i)))
+      return 0;
+  }
+  return f->op[inst] != IR_LOAD || (reads_invariant_memory(c, inst) && may_load_early(c, inst));
+}
+
+static void hoist_from_loop(LoopContext *c, IrOptStats *stats) {
+  IrFunction *f = c->f;
+  const IrLoop *loop = &c->forest->loops[c->loop];
+  IrRef before = ir_terminator(f, loop->preheader);
+  c->clobbers = 0;
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    IR_FOR_EACH_INST(f, loop->blocks[i], inst) {
+      c->clobbers |= clobbers_memory(f, inst);
+    }
+  }
+  // In reverse postorder, operands are hoisted before their users.
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    IR_FOR_EACH_INST(f, loop->blocks[i], inst) {
+      if (is_loop_invariant(c, inst)) {
+        ir_move_before(f, inst, before);
+        stats->n_hoisted += f->op[inst] != IR_CONST;
+      }
+    }
+  }
+}
+
+void hoist_loop_invariants(IrFunction *f, IrOptStats *stats) {
+  LoopContext c = { .f = f, .forest = ir_find_loops(f), .escaped = find_escaped_slots(f) };
+  int added = 0;
+  for (int i = 0; i < c.forest->n_loops; i++) {
+    added |= ir_insert_preheader(f, &c.forest->loops[i]);
+  }
+  if (added) {
+    c.forest = ir_find_loops(f);
+  }
+  // Inner loops first, so what they hoist may be hoisted again out of the loops enclosing them
+  for (c.loop = 0; c.loop < c.forest->n_loops; c.loop++) {
+    if (c.forest->loops[c.loop].preheader) {
+      hoist_from_loop(&c, stats);
+    }
+  }
+}
+
+/** If phi, in the header of a loop with one latch, is i = i +/- step on the back edge, return the step, else 0. */
+static int64_t induction_step(const IrFunction *f, const IrLoop *loop, IrRef phi) {
+  if (f->op[phi] != IR_PHI || (f->type[phi] != IR_I32 && f->type[phi] != IR_I64))
+    return 0;
+  const IrBlock *header = &f->blocks[loop->header];
+  for (uint32_t k = 0; k < header->n_preds; k++) {
+    if (header->preds[k] != loop->latches[0])
+      continue;
+    IrRef next = IR_ARG(f, phi, k);
+    if ((f->op[next] != IR_ADD && f->op[next] != IR_SUB) || IR_ARG(f, next, 0) != phi
+      || f->op[IR_ARG(f, next, 1)] != IR_CONST)
+      return 0;
+    int64_t step = extend(f->imm[IR_ARG(f, next, 1)], IR_TYPE_SIZES[f->type[phi]], 1);
+    return f->op[next] == IR_ADD ? step : -step;
+  }
+  return 0;
+}
+
+/**
+ * If address is base + i * scale, for an induction variable i of the loop and a base and scale that do not change in
+ * it, find them. i is an i64 phi, or the sign extension of an i32 one, as signed overflow is undefined.
+ */
+static int match_scaled_index(const LoopContext *c, IrRef address, IrRef *base, IrRef *phi, int64_t *scale) {
+  const IrFunction *f = c->f;
+  if (f->op[address] != IR_ADD || f->type[address] != IR_PTR)
+    return 0;
+  *base = IR_ARG(f, address, 0);
+  IrRef index = IR_ARG(f, address, 1);
+  *scale = 1;
+  if (f->type[*base] != IR_PTR || is_in_loop(c, *base))
+    return 0;
+  if (f->op[index] == IR_MUL && f->op[IR_ARG(f, index, 1)] == IR_CONST) {
+    *scale = f->imm[IR_ARG(f, index, 1)];
+    index = IR_ARG(f, index, 0);
+  }
+  if (f->op[index] == IR_SEXT && f->type[IR_ARG(f, index, 0)] == IR_I32) {
+    index = IR_ARG(f, index, 0);
+  } else if (f->type[index] != IR_I64) {
+    return 0;
+  }
+  *phi = index;
+  return f->block[index] == c->forest->loops[c->loop].header
+    && induction_step(f, &c->forest->loops[c->loop], index) != 0;
+}
+
+/** Replace address, base + phi * scale, by a pointer of its own incremented on the back edge. */
+static void reduce_address(LoopContext *c, IrRef address, IrRef base, IrRef phi, int64_t scale) {
+  IrFunction *f = c->f;
+  const IrLoop *loop = &c->forest->loops[c->loop];
+  IrRef before = ir_terminator(f, loop->preheader);
+  IrRef init = incoming_value(f, loop->preheader, phi), offset, start = base;
+  if (f->op[init] == IR_CONST) {
+    int64_t value = extend(f->imm[init], IR_TYPE_SIZES[f->type[init]], 1) * scale;
+    offset = value ? ir_insert_before(f, before, IR_CONST, IR_I64, 0, 0, value) : IR_NONE;
+  } else {
+    offset = f->type[init] == IR_I64 ? init : ir_insert_before(f, before, IR_SEXT, IR_I64, 1, &init, 0);
+    if (scale != 1) {
+      IrRef args[] = {offset, ir_insert_before(f, before, IR_CONST, IR_I64, 0, 0, scale)};
+      offset = ir_insert_before(f, before, IR_MUL, IR_I64, 2, args, 0);
+    }
+  }
+  if (offset) {
+    IrRef args[] = {base, offset};
+    start = ir_insert_before(f, before, IR_ADD, IR_PTR, 2, args, 0);
+  }
+
+  // Step the pointer along with the variable, which leaves the test of the variable next to its branch.
+  IrRef pointer = ir_insert_phi(f, loop->header, IR_PTR);
+  IrRef after = f->next[incoming_value(f, loop->latches[0], phi)];
+  IrRef next_args[] = {pointer, ir_insert_before(f, after, IR_CONST, IR_I64, 0, 0,
+    induction_step(f, loop, phi) * scale)};
+  IrRef next = ir_insert_before(f, after, IR_ADD, IR_PTR, 2, next_args, 0);
+  const IrBlock *header = &f->blocks[loop->header];
+  IrRef *values = arena_alloc(f->arena, header->n_preds * sizeof(IrRef));
+  for (uint32_t k = 0; k < header->n_preds; k++) {
+    values[k] = header->preds[k] == loop->preheader ? start : next;
+  }
+  ir_set_phi_args(f, pointer, values);
+  ir_replace_uses(f, address, pointer);
+}
+
+void reduce_induction_variables(IrFunction *f, IrOptStats *stats) {
+  LoopContext c = { .f = f, .forest = ir_find_loops(f) };
+  for (c.loop = 0; c.loop < c.forest->n_loops; c.loop++) {
+    const IrLoop *loop = &c.forest->loops[c.loop];
+    if (!loop->preheader || loop->n_latches != 1)
+      continue;
+    for (uint32_t i = 0; i < loop->n_blocks; i++) {
+      IR_FOR_EACH_INST(f, loop->blocks[i], inst) {
+        IrRef base, phi;
+        int64_t scale;
+        if (f->first_use[inst] && match_scaled_index(&c, inst, &base, &phi, &scale)) {
+          reduce_address(&c, inst, base, phi, scale);
+          stats->n_reduced_addresses++;
+        }
+      }
+    }
+  }
+}
+
+// Vectorization
+
+/** What an instruction of a loop being vectorized becomes */
+typedef enum {
+  LANE_UNKNOWN,  ///< not classified yet, or not vectorizable
+  LANE_CONTROL,  ///< the induction variable, its increment and test, and the jumps: the vector loop has its own
+  LANE_ADDRESS,  ///< base + i * 4, or part of it: the vector loop computes the address from its own index
+  LANE_VECTOR,  ///< computed lane by lane, one iteration per lane
+  LANE_REDUCTION,  ///< a phi summing across iterations, or an addition to it: summed per lane, then across the lanes
+} LaneKind;
+
+typedef struct {
+  LoopContext c;
+  IrType vector_type;
+  int n_lanes;
+  IrBlockRef *chain;  ///< the blocks of the loop, each jumping to the next, from the header to the latch
+  IrRef iv;  ///< the i32 induction variable, going up by one
+  IrRef exit_test;  ///< i + 1 < n or <=, signed or unsigned, on which the latch branches back
+  uint8_t *kind;  ///< by instruction: a LaneKind
+  IrRef *base;  ///< by load and store: the start of the array it accesses element i of
+  IrRef *lanes;  ///< by instruction in the loop: its counterpart in the vector loop
+  IrRef *splat;  ///< by value outside the loop: a vector with it in every lane, once made
+  IrRef *address;  ///< by base: the address of element j, once computed in the vector loop
+} Vectorizer;
+
+/** Whether user, of some value, is in the loop and not about to be removed, like the i - 1 that i++ leaves behind */
+static int is_live_in_loop(const LoopContext *c, IrRef user) {
+  return is_in_loop(c, user) && !is_dead(c->f, user);
+}
+
+static int n_uses_in_loop(const LoopContext *c, IrRef value) {
+  int n = 0;
+  IR_FOR_EACH_USE(c->f, value, use) {
+    n += is_live_in_loop(c, c->f->user[use]);
+  }
+  return n;
+}
+
+/** Find the blocks of the loop as a chain from the header to a latch ending in the only branch out of the loop. */
+static int find_chain(Vectorizer *v) {
+  const IrFunction *f = v->c.f;
+  const IrLoop *loop = &v->c.forest->loops[v->c.loop];
+  if (!loop->preheader || loop->n_latches != 1 || f->blocks[loop->header].n_preds != 2)
+    return 0;
+  IrBlockRef b = loop->header;
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    if (v->c.forest->innermost[b] != v->c.loop || (b != loop->header && f->blocks[b].n_preds != 1))
+      return 0;
+    v->chain[i] = b;
+    IrRef terminator = ir_terminator(f, b);
+    v->kind[terminator] = LANE_CONTROL;
+    if (b == loop->latches[0]) {
+      return i + 1 == loop->n_blocks && f->op[terminator] == IR_BR && f->blocks[b].succs[0] == loop->header
+        && !is_in_loop(&v->c, f->blocks[f->blocks[b].succs[1]].first);
+    }
+    if (f->op[terminator] != IR_JMP)
+      return 0;
+    b = f->blocks[b].succs[0];
+  }
+  return 0;
+}
+
+/** Find the induction variable i from the test i + 1 < n, or <=, the latch branches on, with n outside the loop. */
+static int find_exit_test(Vectorizer *v) {
+  const IrFunction *f = v->c.f;
+  const IrLoop *loop = &v->c.forest->loops[v->c.loop];
+  IrRef test = IR_ARG(f, ir_terminator(f, loop->latches[0]), 0);
+  IrOp op = f->op[test];
+  if ((op != IR_SLT && op != IR_SLE && op != IR_ULT && op != IR_ULE) || n_uses_in_loop(&v->c, test) != 1)
+    return 0;
+  IrRef next = IR_ARG(f, test, 0), bound = IR_ARG(f, test, 1);
+  if (f->op[next] != IR_ADD || f->type[next] != IR_I32 || is_in_loop(&v->c, bound) || n_uses_in_loop(&v->c, next) != 2)
+    return 0;
+  v->iv = IR_ARG(f, next, 0);
+  v->exit_test = test;
+  v->kind[v->iv] = v->kind[next] = v->kind[test] = LANE_CONTROL;
+  return f->block[v->iv] == loop->header && induction_step(f, loop, v->iv) == 1
+    && incoming_value(f, loop->latches[0], v->iv) == next;
+}
+
+/** Classify the additions to phi, in the header, if it is a sum only they use, as s += a[i] makes. */
+static int find_reduction(Vectorizer *v, IrRef phi) {
+  const IrFunction *f = v->c.f;
+  IrRef last = incoming_value(f, v->c.forest->loops[v->c.loop].latches[0], phi);
+  if (f->type[phi] != IR_I32)
+    return 0;
+  v->kind[phi] = LANE_REDUCTION;
+  for (IrRef sum = phi; sum != last;) {
+    if (n_uses_in_loop(&v->c, sum) != 1)
+      return 0;
+    IrRef user = IR_NONE;
+    IR_FOR_EACH_USE(f, sum, use) {
+      if (is_live_in_loop(&v->c, f->user[use])) {
+        user = f->user[use];
+      }
+    }
+    if (f->type[user] != IR_I32 || IR_ARG(f, user, 0) == IR_ARG(f, user, 1)
+      || (f->op[user] != IR_ADD && (f->op[user] != IR_SUB || IR_ARG(f, user, 0) != sum)))
+      return 0;
+    v->kind[user] = LANE_REDUCTION;
+    sum = user;
+  }
+  return n_uses_in_loop(&v->c, last) == 1;  // by the phi
+}
+
+/** Classify a load or store of element i of an array of i32, and the computation of its address. */
+static int find_lane_access(Vectorizer *v, IrRef inst) {
+  const IrFunction *f = v->c.f;
+  IrRef address = IR_ARG(f, inst, 0), base, phi;
+  int64_t scale;
+  IrType type = f->op[inst] == IR_LOAD ? f->type[inst] : f->type[IR_ARG(f, inst, 1)];
+  if (type != IR_I32 || !match_scaled_index(&v->c, address, &base, &phi, &scale) || phi != v->iv || scale != 4)
+    return 0;
+  v->kind[inst] = LANE_VECTOR;
+  v->base[inst] = base;
+  // base + (i64) i * 4, which addresses nothing else
+  IrRef product = IR_ARG(f, address, 1);
+  v->kind[address] = v->kind[product] = v->kind[IR_ARG(f, product, 0)] = LANE_ADDRESS;
+  return 1;
+}
+
+/** Whether value, an operand of an instruction computed lane by lane, can be too */
+static int is_lane_operand(const Vectorizer *v, IrRef value) {
+  if (is_in_loop(&v->c, value))
+    return v->kind[value] == LANE_VECTOR;
+  return v->c.f->type[value] == IR_I32;
+}
+
+/** Classify inst, of no other kind, if the vector loop can compute it lane by lane. */
+static int find_lane_op(Vectorizer *v, IrRef inst) {
+  const IrFunction *f = v->c.f;
+  if (f->type[inst] != IR_I32)
+    return 0;
+  switch (f->op[inst]) {
+    case IR_ADD: case IR_SUB: case IR_MUL: case IR_AND: case IR_OR: case IR_XOR:
+      break;
+    case IR_SHL: case IR_SHR: case IR_SAR: {
+      IrRef count = IR_ARG(f, inst, 1);
+      if (f->op[count] != IR_CONST || f->imm[count] < 0 || f->imm[count] >= 32)
+        return 0;
+      v->kind[inst] = LANE_VECTOR;
+      return is_lane_operand(v, IR_ARG(f, inst, 0));
+    }
+    default:
+      return 0;
+  }
+  v->kind[inst] = LANE_VECTOR;
+  return is_lane_operand(v, IR_ARG(f, inst, 0)) && is_lane_operand(v, IR_ARG(f, inst, 1));
+}
+
+/** The slot or global address points into, as its SLOT or GLOBAL instruction; or IR_NONE if not known */
+static IrRef object_of(const IrFunction *f, IrRef address) {
+  while (f->op[address] == IR_ADD && f->type[address] == IR_PTR) {
+    address = f->type[IR_ARG(f, address, 0)] == IR_PTR ? IR_ARG(f, address, 0) : IR_ARG(f, address, 1);
+  }
+  return f->op[address] == IR_SLOT || f->op[address] == IR_GLOBAL ? address : IR_NONE;
+}
+
+/**
+ * Whether an iteration may read or write what another one writes, so that running them side by side changes the
+ * result. Accesses to element i of the same array, or to different objects, never do.
+ */
+static int has_dependences(const Vectorizer *v, const IrRef *accesses, int n_accesses) {
+  const IrFunction *f = v->c.f;
+  for (int i = 0; i < n_accesses; i++) {
+    for (int k = 0; k < n_accesses; k++) {
+      IrRef a = v->base[accesses[i]], b = v->base[accesses[k]];
+      if (f->op[accesses[i]] != IR_STORE || a == b)
+        continue;
+      IrRef a_object = object_of(f, a), b_object = object_of(f, b);
+      if (!a_object || !b_object || (f->op[a_object] == f->op[b_object] && f->imm[a_object] == f->imm[b_object]))
+        return 1;
+    }
+  }
+  return 0;
+}
+
+/** Whether a vector iteration is sure to run, or sure not to, when the bounds of the loop are constants */
+static int runs_vector_iteration(const Vectorizer *v, int *known) {
+  const IrFunction *f = v->c.f;
+  IrRef init = incoming_value(f, v->c.forest->loops[v->c.loop].preheader, v->iv);
+  IrRef bound = IR_ARG(f, v->exit_test, 1);
+  *known = f->op[init] == IR_CONST && f->op[bound] == IR_CONST;
+  int is_signed = f->op[v->exit_test] == IR_SLT || f->op[v->exit_test] == IR_SLE;
+  int64_t start = extend(f->imm[init], 4, is_signed), limit = extend(f->imm[bound], 4, is_signed) - v->n_lanes;
+  return f->op[v->exit_test] == IR_SLT || f->op[v->exit_test] == IR_ULT ? start < limit : start <= limit;
+}
+
+/**
+ * Whether the loop can run n_lanes iterations at a time: a straight line of blocks counting i up by one to a bound,
+ * accessing element i of arrays of i32 that no other iteration touches, and computing lane by lane or summing.
+ */
+static int can_vectorize(Vectorizer *v) {
+  IrFunction *f = v->c.f;
+  const IrLoop *loop = &v->c.forest->loops[v->c.loop];
+  if (!find_chain(v) || !find_exit_test(v))
+    return 0;
+  for (IrRef phi = f->blocks[loop->header].first; f->op[phi] == IR_PHI; phi = f->next[phi]) {
+    if (phi != v->iv && !find_reduction(v, phi))
+      return 0;
+  }
+  int known;
+  if (!runs_vector_iteration(v, &known) && known)
+    return 0;
+
+  IrRef *accesses = arena_alloc(f->arena, f->n_insts * sizeof(IrRef));
+  int n_accesses = 0;
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    IR_FOR_EACH_INST(f, v->chain[i], inst) {
+      if (f->op[inst] == IR_LOAD || f->op[inst] == IR_STORE) {
+        if (!find_lane_access(v, inst))
+          return 0;
+        accesses[n_accesses++] = inst;
+      }
+    }
+  }
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    IR_FOR_EACH_INST(f, v->chain[i], inst) {
+      switch (v->kind[inst]) {
+        case LANE_UNKNOWN:
+          if (!is_dead(f, inst) && !find_lane_op(v, inst))
+            return 0;
+          break;
+        case LANE_VECTOR:
+          if (f->op[inst] == IR_STORE && !is_lane_operand(v, IR_ARG(f, inst, 1)))
+            return 0;
+          break;
+        case LANE_REDUCTION: {
+          // What is added to the sum, or subtracted from it
+          int i = v->kind[IR_ARG(f, inst, 0)] == LANE_REDUCTION;
+          if (f->op[inst] != IR_PHI && !is_lane_operand(v, IR_ARG(f, inst, i)))
+            return 0;
+          break;
+        }
+        case LANE_ADDRESS:
+          // Only used to address element i
+          IR_FOR_EACH_USE(f, inst, use) {
+            IrRef user = f->user[use];
+            if (is_live_in_loop(&v->c, user) && v->kind[user] != LANE_ADDRESS
+              && ((f->op[user] != IR_LOAD && f->op[user] != IR_STORE) || use != f->args[user]))
+              return 0;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  IR_FOR_EACH_USE(f, v->iv, use) {
+    if (is_live_in_loop(&v->c, f->user[use]) && v->kind[f->user[use]] != LANE_CONTROL
+      && v->kind[f->user[use]] != LANE_ADDRESS)
+      return 0;
+  }
+  return n_accesses && !has_dependences(v, accesses, n_accesses);  // a loop that only counts is left alone
+}
+
+/** The vector counterpart of value, an operand of an instruction of the loop computed lane by lane */
+static IrRef lanes_of(Vectorizer *v, IrRef value, IrRef setup) {
+  if (is_in_loop(&v->c, value))
+    return v->lanes[value];
+  if (!v->splat[value]) {
+    v->splat[value] = ir_insert_before(v->c.f, setup, IR_SPLAT, v->vector_type, 1, &value, 0);
+  }
+  return v->splat[value];
+}
+
+/** value, an i32, extended to i64 before the instruction before */
+static IrRef widen(IrFunction *f, IrRef value, int is_signed, IrRef before) {
+  if (f->op[value] == IR_CONST)
+    return ir_insert_before(f, before, IR_CONST, IR_I64, 0, 0, extend(f->imm[value], 4, is_signed));
+  return ir_insert_before(f, before, is_signed ? IR_SEXT : IR_ZEXT, IR_I64, 1, &value, 0);
+}
+
+/**
+ * Put a vector loop, counting j up by n_lanes, in front of the loop, which goes on from where it stops. It stops while
+ * the loop still has an iteration to go, so the loop runs at least once as before, and what it leaves in the
+ * variables and memory is what it always did.
+ */
+static void vectorize_loop(Vectorizer *v) {
+  IrFunction *f = v->c.f;
+  const IrLoop *loop = &v->c.forest->loops[v->c.loop];
+  IrBlockRef pre = loop->preheader, header = loop->header;
+  IrOp test_op = f->op[v->exit_test];
+  int is_signed = test_op == IR_SLT || test_op == IR_SLE;
+  IrOp continues = test_op == IR_SLT || test_op == IR_ULT ? IR_SLT : IR_SLE;
+  int known, runs = runs_vector_iteration(v, &known);
+
+  // The preheader now either sets up the vector loop or goes straight to the scalar one, through a new preheader.
+  IrBlockRef scalar_pre = ir_split_edge(f, pre, 0);
+  IrBlockRef setup = ir_new_block(f), body = ir_new_block(f), leave = ir_new_block(f);
+  f->blocks[setup].count = f->blocks[leave].count = f->blocks[pre].count;
+  f->blocks[body].count = f->blocks[header].count / v->n_lanes;
+  IrRef jump = ir_terminator(f, pre), init = incoming_value(f, scalar_pre, v->iv);
+  IrRef start = widen(f, init, is_signed, jump), bound = widen(f, IR_ARG(f, v->exit_test, 1), is_signed, jump);
+  IrRef limit;
+  if (f->op[bound] == IR_CONST) {
+    limit = ir_insert_before(f, jump, IR_CONST, IR_I64, 0, 0, f->imm[bound] - v->n_lanes);
+  } else {
+    IrRef args[] = {bound, ir_insert_before(f, jump, IR_CONST, IR_I64, 0, 0, v->n_lanes)};
+    limit = ir_insert_before(f, jump, IR_SUB, IR_I64, 2, args, 0);
+  }
+  IrRef skip_args[] = {start, limit};
+  IrRef skip = known ? ir_insert_before(f, jump, IR_CONST, IR_I32, 0, 0, !runs)
+    : ir_insert_before(f, jump, continues == IR_SLT ? IR_SGE : IR_SGT, IR_I32, 2, skip_args, 0);
+  ir_remove(f, jump);
+  ir_append(f, pre, IR_BR, IR_VOID, 1, &skip, 0);
+  ir_add_edge(f, pre, setup);
+  if (known) {
+    ir_fold_branch(f, pre, 1);
+  }
+
+  // The vector loop: one block, as the loop is a straight line
+  IrRef setup_jump = ir_append(f, setup, IR_JMP, IR_VOID, 0, 0, 0);
+  ir_add_edge(f, setup, body);
+  ir_add_edge(f, body, body);
+  ir_add_edge(f, body, leave);
+  IrRef index = ir_insert_phi(f, body, IR_I64);
+  IrRef element_size = ir_insert_before(f, setup_jump, IR_CONST, IR_I64, 0, 0, 4);
+  for (IrRef phi = f->blocks[header].first; f->op[phi] == IR_PHI; phi = f->next[phi]) {
+    if (phi != v->iv) {
+      v->lanes[phi] = ir_insert_phi(f, body, v->vector_type);
+    }
+  }
+  for (uint32_t i = 0; i < loop->n_blocks; i++) {
+    IR_FOR_EACH_INST(f, v->chain[i], inst) {
+      if (f->op[inst] == IR_PHI || (v->kind[inst] != LANE_VECTOR && v->kind[inst] != LANE_REDUCTION))
+        continue;
+      IrRef args[2];
+      if (f->op[inst] == IR_LOAD || f->op[inst] == IR_STORE) {
+        IrRef base = v->base[inst];
+        if (!v->address[base]) {
+          IrRef offset_args[] = {index, element_size};
+          IrRef address_args[] = {base, ir_append(f, body, IR_MUL, IR_I64, 2, offset_args, 0)};
+          v->address[base] = ir_append(f, body, IR_ADD, IR_PTR, 2, address_args, 0);
+        }
+        args[0] = v->address[base];
+      } else {
+        args[0] = lanes_of(v, IR_ARG(f, inst, 0), setup_jump);
+      }
+      if (f->op[inst] == IR_SHL || f->op[inst] == IR_SHR || f->op[inst] == IR_SAR) {
+        args[1] = IR_ARG(f, inst, 1);  // the same count for every lane
+      } else if (f->n_args[inst] == 2) {
+        args[1] = lanes_of(v, IR_ARG(f, inst, 1), setup_jump);
+      }
+      v->lanes[inst] = ir_append(f, body, f->op[inst], f->op[inst] == IR_STORE ? IR_VOID : v->vector_type,
+        f->n_args[inst], args, 0);
+    }
+  }
+  IrRef step_args[] = {index, ir_insert_before(f, setup_jump, IR_CONST, IR_I64, 0, 0, v->n_lanes)};
+  IrRef next = ir_append(f, body, IR_ADD, IR_I64, 2, step_args, 0);
+  IrRef test_args[] = {next, limit};
+  IrRef test = ir_append(f, body, continues, IR_I32, 2, test_args, 0);
+  ir_append(f, body, IR_BR, IR_VOID, 1, &test, 0);
+  IrRef index_args[] = {start, next};
+  ir_set_phi_args(f, index, index_args);
+
+  // Leaving it, add up the lanes of each sum, and carry on with the scalar loop from i = j.
+  IrRef zero = ir_insert_before(f, setup_jump, IR_CONST, IR_I32, 0, 0, 0);
+  IrRef resume = ir_append(f, leave, IR_TRUNC, IR_I32, 1, &next, 0);
+  ir_add_edge(f, leave, scalar_pre);
+  uint32_t k = 0;
+  while (f->blocks[header].preds[k] != scalar_pre) {
+    k++;
+  }
+  for (IrRef phi = f->blocks[header].first; f->op[phi] == IR_PHI; phi = f->next[phi]) {
+    IrRef phi_init = IR_ARG(f, phi, k), resumed = resume;
+    if (phi != v->iv) {
+      IrRef last = v->lanes[incoming_value(f, loop->latches[0], phi)];
+      IrRef lane_args[] = {ir_insert_before(f, setup_jump, IR_SPLAT, v->vector_type, 1, &zero, 0), last};
+      ir_set_phi_args(f, v->lanes[phi], lane_args);
+      IrRef sum_args[] = {phi_init, ir_append(f, leave, IR_HSUM, IR_I32, 1, &last, 0)};
+      resumed = is_const(f, phi_init, 0) ? sum_args[1] : ir_append(f, leave, IR_ADD, IR_I32, 2, sum_args, 0);
+    }
+    IrRef merged = resumed;
+    if (!known) {
+      merged = ir_insert_phi(f, scalar_pre, IR_I32);
+      IrRef merged_args[] = {phi_init, resumed};  // from the preheader, then the vector loop
+      ir_set_phi_args(f, merged, merged_args);
+    }
+    ir_set_arg(f, phi, k, merged);
+  }
+  ir_append(f, leave, IR_JMP, IR_VOID, 0, 0, 0);
+}
+
+void vectorize_loops(IrFunction *f, int vector_size, IrOptStats *stats) {
+  if (!vector_size)
+    return;
+  Vectorizer v = {
+    .c = { .f = f, .forest = ir_find_loops(f) },
+    .vector_type = vector_size == 32 ? IR_V8I32 : IR_V4I32,
+    .n_lanes = vector_size / 4,
+  };
+  for (v.c.loop = 0; v.c.loop < v.c.forest->n_loops; v.c.loop++) {
+    v.chain = arena_alloc(f->arena, v.c.forest->loops[v.c.loop].n_blocks * sizeof(IrBlockRef));
+    v.kind = arena_alloc(f->arena, f->n_insts);
+    v.base = arena_alloc(f->arena, f->n_insts * sizeof(IrRef));
+    v.lanes = arena_alloc(f->arena, f->n_insts * sizeof(IrRef));
+    v.splat = arena_alloc(f->arena, f->n_insts * sizeof(IrRef));
+    v.address = arena_alloc(f->arena, f->n_insts * sizeof(IrRef));
+    if (can_vectorize(&v)) {
+      vectorize_loop(&v);
+      stats->n_vectorized_loops++;
+    }
+  }
+}
+
+// Inlining
+
+// Sizes of the bodies worth inlining, in instructions that emit code
+#define INLINE_BUDGET 16
+#define INLINE_HINTED_BUDGET 64  // for functions declared inline
+#define INLINE_HOT_BUDGET 64  // for calls a profile finds hot
+
+KHASH_MAP_INIT_STR(InlineBody, IrFunction *)
+
+struct InlineBodies {
+  kh_InlineBody_t *by_name;
+  uint64_t hot_count;
+};
+
+InlineBodies *new_inline_bodies(uint64_t hot_count) {
+  InlineBodies *bodies = checked_calloc(1, sizeof(InlineBodies));
+  bodies->by_name = kh_init_InlineBody();
+  bodies->hot_count = hot_count;
+  return bodies;
+}
+
+void free_inline_bodies(InlineBodies *bodies) {
+  IrFunction *body;
+  kh_foreach_value(bodies->by_name, body, free_ir_function(body));
+  kh_destroy_InlineBody(bodies->by_name);
+  free(bodies);
+}
+
+static int body_size(const IrFunction *f) {
+  int size = 0;
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    switch (f->op[inst]) {
+      case IR_NOP: case IR_UNDEF: case IR_CONST: case IR_PARAM: case IR_PHI: case IR_SLOT: case IR_GLOBAL:
+      case IR_COUNT:  // so that instrumented code inlines the same calls
+        break;
+      default:
+        size += f->block[inst] != IR_NONE;
+        break;
+    }
+  }
+  return size;
+}
+
+void keep_inline_body(InlineBodies *bodies, const IrFunction *f) {
+  if (!f->is_static && !f->is_inline)
+    return;
+  int is_hot = f->has_profile && f->blocks[IR_ENTRY_BLOCK].count >= bodies->hot_count;
+  int budget = f->is_inline ? INLINE_HINTED_BUDGET : is_hot ? INLINE_HOT_BUDGET : INLINE_BUDGET;
+  // The copy is entered by a jump from the call, so the entry cannot be a loop header.
+  if (body_size(f) > budget || f->blocks[IR_ENTRY_BLOCK].n_preds)
+    return;
+  int returns = 0;
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    IrRef last = ir_terminator(f, b);
+    returns |= last && f->op[last] == IR_RET;
+  }
+  if (!returns)
+    return;
+  int ret;
+  khiter_t iter = kh_put_InlineBody(bodies->by_name, f->name, &ret);
+  THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+  kh_val(bodies->by_name, iter) = ir_copy_function(f);
+}
+
+const IrFunction *kept_inline_body(const InlineBodies *bodies, const char *name) {
+  khiter_t iter = kh_get_InlineBody(bodies->by_name, name);
+  return iter == kh_end(bodies->by_name) ? 0 : kh_val(bodies->by_name, iter);
+}
+
+void restore_inline_body(InlineBodies *bodies, IrFunction *body) {
+  int ret;
+  khiter_t iter = kh_put_InlineBody(bodies->by_name, body->name, &ret);
+  THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+  kh_val(bodies->by_name, iter) = body;
+}
+
+/** Whether the arguments of call and the values callee returns have the types of its parameters and of the call */
+static int types_match(const IrFunction *f, IrRef call, const IrFunction *callee) {
+  if (f->n_args[call] != (uint32_t) callee->n_params)
+    return 0;
+  for (IrRef inst = 1; inst < callee->n_insts; inst++) {
+    if (!callee->block[inst])
+      continue;
+    if (callee->op[inst] == IR_PARAM && callee->type[inst] != f->type[IR_ARG(f, call, callee->imm[inst])])
+      return 0;
+    if (callee->op[inst] == IR_RET && f->type[call] != IR_VOID && callee->n_args[inst]
+      && callee->type[IR_ARG(callee, inst, 0)] != f->type[call])
+      return 0;
+  }
+  return 1;
+}
+
+/** The index among the preds of callee block cb of the one whose copy is pred i of copy, matching repeats in order */
+static uint32_t copied_pred(const IrFunction *callee, IrBlockRef cb, const IrBlock *copy, const IrBlockRef *block_map,
+    uint32_t i) {
+  int occurrence = 0;
+  for (uint32_t j = 0; j < i; j++) {
+    occurrence += copy->preds[j] == copy->preds[i];
+  }
+  uint32_t k = 0;
+  while (block_map[callee->blocks[cb].preds[k]] != copy->preds[i] || occurrence--) {
+    k++;
+  }
+  return k;
+}
+
+/** Replace call by a copy of callee: its block jumps to the copy of the entry, and the copied returns to the rest. */
+static void inline_call(IrFunction *f, IrRef call, const IrFunction *callee) {
+  IrBlockRef from = f->block[call];
+  uint64_t count = f->blocks[from].count, entry_count = callee->blocks[IR_ENTRY_BLOCK].count;
+  IrBlockRef rest = ir_split_block(f, f->next[call]);
+  IrRef *map = arena_alloc(f->arena, callee->n_insts * sizeof(IrRef));
+  IrBlockRef *block_map = arena_alloc(f->arena, callee->n_blocks * sizeof(IrBlockRef));
+  IrBlockRef *order = arena_alloc(f->arena, callee->n_blocks * sizeof(IrBlockRef));
+  IrRef *returned = arena_alloc(f->arena, callee->n_blocks * sizeof(IrRef));
+  int *slot_map = arena_alloc(f->arena, (callee->n_slots + 1) * sizeof(int));
+  uint32_t max_args = 0;
+  for (IrRef inst = 1; inst < callee->n_insts; inst++) {
+    max_args = callee->n_args[inst] > max_args ? callee->n_args[inst] : max_args;
+  }
+  IrRef *args = arena_alloc(f->arena, (max_args + 1) * sizeof(IrRef));
+  for (uint32_t s = 0; s < callee->n_slots; s++) {
+    slot_map[s] = ir_new_slot(f, callee->slots[s].size, callee->slots[s].align);
+  }
+  int n_order = ir_reverse_postorder(callee, order);
+  for (int k = 0; k < n_order; k++) {
+    block_map[order[k]] = ir_new_block(f);
+    // The copy runs as often as the call does, in the proportions of the callee's own counts, and a block that ran
+    // in both is not rounded down to one that never did.
+    uint64_t callee_count = callee->blocks[order[k]].count;
+    uint64_t scaled = entry_count ? (uint64_t) ((double) callee_count * count / entry_count) : 0;
+    f->blocks[block_map[order[k]]].count = scaled || !callee_count || !count ? scaled : 1;
+  }
+
+  // Operands other than those of phis are defined in dominating blocks, which come first in reverse postorder.
+  int n_returns = 0;
+  for (int k = 0; k < n_order; k++) {
+    IrBlockRef cb = order[k], b = block_map[cb];
+    IR_FOR_EACH_INST(callee, cb, inst) {
+      IrOp op = callee->op[inst];
+      int64_t imm = callee->imm[inst];
+      switch (op) {
+        case IR_PARAM:
+          map[inst] = IR_ARG(f, call, imm);
+          continue;
+        case IR_PHI:
+          map[inst] = ir_append(f, b, IR_PHI, callee->type[inst], 0, 0, 0);  // operands once all edges are in
+          continue;
+        case IR_RET:
+          returned[n_returns++] = callee->n_args[inst] ? map[IR_ARG(callee, inst, 0)] : IR_NONE;
+          ir_append(f, b, IR_JMP, IR_VOID, 0, 0, 0);
+          ir_add_edge(f, b, rest);
+          continue;
+        case IR_SLOT:
+          imm = slot_map[imm];
+          break;
+        case IR_GLOBAL: case IR_CALL:
+          imm = ir_intern_symbol(f, callee->symbols[imm]);
+          break;
+        default:
+          break;
+      }
+      for (uint32_t i = 0; i < callee->n_args[inst]; i++) {
+        args[i] = map[IR_ARG(callee, inst, i)];
+      }
+      map[inst] = ir_append(f, b, op, callee->type[inst], callee->n_args[inst], args, imm);
+    }
+    for (uint32_t i = 0; i < callee->blocks[cb].n_succs; i++) {
+      ir_add_edge(f, b, block_map[callee->blocks[cb].succs[i]]);
+    }
+  }
+  for (int k = 0; k < n_order; k++) {
+    IrBlockRef cb = order[k];
+    const IrBlock *copy = &f->blocks[block_map[cb]];
+    IR_FOR_EACH_INST(callee, cb, inst) {
+      if (callee->op[inst] != IR_PHI)
+        break;
+      for (uint32_t i = 0; i < copy->n_preds; i++) {
+        args[i] = map[IR_ARG(callee, inst, copied_pred(callee, cb, copy, block_map, i))];
+      }
+      ir_set_phi_args(f, map[inst], args);
+    }
+  }
+
+  IrType type = f->type[call];
+  if (type != IR_VOID) {
+    for (int i = 0; i < n_returns; i++) {
+      if (!returned[i]) {
+        returned[i] = ir_insert_before(f, f->blocks[IR_ENTRY_BLOCK].first, IR_UNDEF, type, 0, 0, 0);
+      }
+    }
+    IrRef value = returned[0];
+    if (n_returns > 1) {
+      value = ir_insert_phi(f, rest, type);
+      ir_set_phi_args(f, value, returned);
+    }
+    ir_replace_uses(f, call, value);
+  }
+  ir_remove(f, call);
+  ir_append(f, from, IR_JMP, IR_VOID, 0, 0, 0);
+  ir_add_edge(f, from, block_map[IR_ENTRY_BLOCK]);
+}
+
+void inline_calls(IrFunction *f, const InlineBodies *bodies, IrOptStats *stats) {
+  // Only the calls f makes itself, not those in the copies
+  uint32_t n_insts = f->n_insts;
+  for (IrRef inst = 1; inst < n_insts; inst++) {
+    if (!f->block[inst] || f->op[inst] != IR_CALL)
+      continue;
+    khiter_t iter = kh_get_InlineBody(bodies->by_name, f->symbols[f->imm[inst]]);
+    if (iter == kh_end(bodies->by_name) || !types_match(f, inst, kh_val(bodies->by_name, iter)))
+      continue;
+    const IrFunction *callee = kh_val(bodies->by_name, iter);
+    if (f->has_profile) {
+      // Calls the profile never saw are left alone, to keep cold code small, and big bodies go only where it is hot.
+      uint64_t count = f->blocks[f->block[inst]].count;
+      if (!count || (body_size(callee) > INLINE_BUDGET && !callee->is_inline && count < bodies->hot_count))
+        continue;
+    }
+    inline_call(f, inst, callee);
+    stats->n_inlined_calls++;
+  }
+}
+
+// Tail calls
+
+int is_tail_call(const IrFunction *f, IrRef call) {
+  IrRef next = f->next[call];
+  return f->op[call] == IR_CALL && next && f->op[next] == IR_RET && (!f->n_args[next] || IR_ARG(f, next, 0) == call);
+}
+
+void eliminate_tail_recursion(IrFunction *f, IrOptStats *stats) {
+  IrRef *params = arena_alloc(f->arena, (f->n_params + 1) * sizeof(IrRef));
+  for (IrRef inst = f->blocks[IR_ENTRY_BLOCK].first; inst; inst = f->next[inst]) {
+    if (f->op[inst] == IR_PARAM) {
+      params[f->imm[inst]] = inst;
+    }
+  }
+  IrRef *calls = arena_alloc(f->arena, f->n_blocks * sizeof(IrRef));
+  int n_calls = 0;
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    IrRef last = ir_terminator(f, b);
+    IrRef call = last ? f->prev[last] : IR_NONE;
+    if (!call || !is_tail_call(f, call) || strcmp(f->symbols[f->imm[call]], f->name)
+      || f->n_args[call] != (uint32_t) f->n_params)
+      continue;
+    int types_match = 1;
+    for (int i = 0; i < f->n_params; i++) {
+      types_match &= params[i] && f->type[IR_ARG(f, call, i)] == f->type[params[i]];
+    }
+    if (types_match) {
+      calls[n_calls++] = call;
+    }
+  }
+  if (!n_calls || frame_escapes(f))
+    return;
+
+  // The entry keeps only the parameters, and jumps to the rest, which the calls jump back to.
+  IrBlockRef start = ir_split_block(f, f->blocks[IR_ENTRY_BLOCK].first);
+  IrRef jump = ir_append(f, IR_ENTRY_BLOCK, IR_JMP, IR_VOID, 0, 0, 0);
+  ir_add_edge(f, IR_ENTRY_BLOCK, start);
+  IrRef *phis = arena_alloc(f->arena, (f->n_params + 1) * sizeof(IrRef));
+  for (int i = 0; i < f->n_params; i++) {
+    ir_move_before(f, params[i], jump);
+    phis[i] = ir_insert_phi(f, start, f->type[params[i]]);
+    ir_replace_uses(f, params[i], phis[i]);
+  }
+  // By parameter, its values from each predecessor of start
+  IrRef *values = arena_alloc(f->arena, (f->n_params + 1) * (n_calls + 1) * sizeof(IrRef));
+  for (int i = 0; i < f->n_params; i++) {
+    values[i * (n_calls + 1)] = params[i];
+  }
+  for (int k = 0; k < n_calls; k++) {
+    IrRef call = calls[k];
+    IrBlockRef b = f->block[call];
+    for (int i = 0; i < f->n_params; i++) {
+      values[i * (n_calls + 1) + k + 1] = IR_ARG(f, call, i);
+    }
+    ir_remove(f, f->next[call]);
+    ir_remove(f, call);
+    ir_append(f, b, IR_JMP, IR_VOID, 0, 0, 0);
+    ir_add_edge(f, b, start);
+  }
+  for (int i = 0; i < f->n_params; i++) {
+    ir_set_phi_args(f, phis[i], &values[i * (n_calls + 1)]);
+  }
+  stats->n_tail_recursions += n_calls;
+}
+
+void fprint_ir_opt_stats(FILE *out, const IrOptStats *stats) {
+  fprintf(
+    out,
+    "Value numbering: %d redundant values and %d loads removed\n"
+    "Dead code: %d instructions and %d stores removed, %d bytes of zeroing saved\n"
+    "Loops: %d invariant instructions hoisted, %d addresses strength-reduced, %d loops vectorized\n"
+    "Branches: %d comparisons of constants and %d branches on them folded, %d turned into selects\n"
+    "Calls: %d inlined, %d tail calls of the function itself made jumps\n",
+    stats->n_redundant_values, stats->n_redundant_loads,
+    stats->n_dead_insts, stats->n_dead_stores, stats->n_zero_bytes_saved,
+    stats->n_hoisted, stats->n_reduced_addresses, stats->n_vectorized_loops,
+    stats->n_folded_comparisons, stats->n_folded_branches, stats->n_selects,
+    stats->n_inlined_calls, stats->n_tail_recursions
+  );
+}
@@ -0,0 +1,114 @@
+/**
+ * Machine-independent optimizations of the SSA IR, run by the optimizing backend before lowering. Each pass adds what
+ * it did to the counts in an IrOptStats, which the backend reports once per translation unit.
+ */
+
+#pragma once
+#include <stdio.h>
+#include "ir.h"
+
+typedef struct {
+  int n_redundant_values;  ///< instructions replaced by an earlier one computing the same value
+  int n_redundant_loads;  ///< loads replaced by the value last stored or loaded at the address
+  int n_dead_insts;  ///< pure instructions and loads removed because nothing used their values
+  int n_dead_stores;  ///< stores removed because the bytes were overwritten, or the function returned, before a read
+  int n_zero_bytes_saved;  ///< bytes no longer cleared by zero because later stores write them anyway
+  int n_hoisted;  ///< instructions, other than constants, moved out of a loop into its preheader
+  int n_reduced_addresses;  ///< array addresses in loops computed by adding to a pointer instead of multiplying
+  int n_vectorized_loops;  ///< loops given a vector loop running several of their iterations at a time
+  int n_folded_comparisons;  ///< comparisons of two constants replaced by their result
+  int n_folded_branches;  ///< branches on constants replaced by jumps
+  int n_selects;  ///< branches between values replaced by computing both and selecting one
+  int n_inlined_calls;  ///< calls replaced by a copy of the body of the function called
+  int n_tail_recursions;  ///< calls of a function to itself, returning their value, turned into jumps to its start
+} IrOptStats;
+
+/** The bodies of the functions of a translation unit that calls to them may be replaced by, by name */
+typedef struct InlineBodies InlineBodies;
+
+/**
+ * With profiles, calls that ran at least hot_count times may inline bodies bigger than the rest, and calls that never
+ * ran are not inlined.
+ */
+InlineBodies *new_inline_bodies(uint64_t hot_count);
+void free_inline_bodies(InlineBodies *bodies);
+
+/**
+ * Keep a copy of the body of f, as optimized so far, for inline_calls, if it is small enough and calls to it are
+ * all in this translation unit or it was declared inline. What is small enough is more if the profile finds f hot.
+ */
+void keep_inline_body(InlineBodies *bodies, const IrFunction *f);
+/** The body keep_inline_body kept for the function named name, or NULL */
+const IrFunction *kept_inline_body(const InlineBodies *bodies, const char *name);
+/** Keep body, as kept_inline_body returned it for a function that is not compiled again. bodies takes ownership. */
+void restore_inline_body(InlineBodies *bodies, IrFunction *body);
+
+/**
+ * Replace each call to a function with a kept body by a copy of the body, its parameters replaced by the arguments
+ * and its returns by jumps to the code after the call. Calls the copies make are left alone, so recursion stops. The
+ * blocks of the copy get the counts of the callee's, scaled to those of the call.
+ */
+void inline_calls(IrFunction *f, const InlineBodies *bodies, IrOptStats *stats);
+
+/**
+ * Global value numbering: replace each instruction computing the same value as one dominating it, such as repeated
+ * address arithmetic, by that one. A load is likewise replaced by the value last stored to or loaded from the same
+ * address, if nothing that may write there comes between them in the block or its single-predecessor dominators.
+ * Comparisons of constants are replaced by their results.
+ */
+void number_values(IrFunction *f, IrOptStats *stats);
+
+/** Replace branches and switches on constants by jumps, and remove the blocks and phi operands no longer reached. */
+void fold_constant_branches(IrFunction *f, IrOptStats *stats);
+
+/**
+ * If-conversion: a branch whose arms compute no more than a few pure values before meeting again, merging them in phis
+ * of integers or pointers, becomes an unconditional computation of both arms and a select of each merged value, which
+ * conditional moves perform without a branch to mispredict.
+ */
+void convert_branches_to_selects(IrFunction *f, IrOptStats *stats);
+
+/** Remove pure instructions and loads whose values are unused, and then those only they used, and so on. */
+void eliminate_dead_code(IrFunction *f, IrOptStats *stats);
+
+/**
+ * Remove stores and copies to stack slots that are overwritten before being read, or not read before the function
+ * returns, and shrink each zero of a slot to the bytes that are read before being stored to: the holes an initializer
+ * leaves.
+ */
+void eliminate_dead_stores(IrFunction *f, IrOptStats *stats);
+
+/**
+ * Loop-invariant code motion: give each loop a preheader and move into it the pure instructions, divisions that
+ * cannot trap and loads of memory the loop does not write whose operands are all computed outside the loop.
+ */
+void hoist_loop_invariants(IrFunction *f, IrOptStats *stats);
+
+/**
+ * Strength-reduce induction variables: an address base + i * scale in a loop where i goes up by a constant step each
+ * iteration becomes a pointer of its own, starting at base + i0 * scale and going up by step * scale. The loops need
+ * preheaders, as hoist_loop_invariants leaves them.
+ */
+void reduce_induction_variables(IrFunction *f, IrOptStats *stats);
+
+/**
+ * Vectorize loops over arrays of i32: a straight-line loop counting i up by one to a bound, whose iterations access
+ * element i of arrays no other iteration touches and compute lane by lane or add to sums, gets a loop in front of it
+ * running vector_size / 4 iterations at a time, and leaving the rest to it. The loops need preheaders.
+ */
+void vectorize_loops(IrFunction *f, int vector_size, IrOptStats *stats);
+
+/** Whether call returns straight away, with its value if the function returns one */
+int is_tail_call(const IrFunction *f, IrRef call);
+
+/** Whether the address of a stack slot of f is used other than to load, store, zero and copy, as by a call */
+int frame_escapes(IrFunction *f);
+
+/**
+ * Turn each tail call of f to itself into a jump back to its start, where the parameters become phis of their values
+ * on entry and the arguments of the calls, so recursion becomes a loop. Only if no slot escapes, as each level of the
+ * recursion would have slots of its own.
+ */
+void eliminate_tail_recursion(IrFunction *f, IrOptStats *stats);
+
+void fprint_ir_opt_stats(FILE *out, const IrOptStats *stats);
@@ -167,6 +167,60 @@ static void save_pos(ScannerCont *cont) {
   cont->saved_col = cont->col;
 }
 
+ScannerMark mark_scanner(const ScannerCont *cont) {
+  return (ScannerMark) { .pos = cont->pos, .line = cont->line, .col = cont->col };
+}
+
+void reset_scanner(ScannerCont *cont, ScannerMark mark) {
+  assert(mark.pos >= 0 && mark.pos <= cont->size);
+  cont->pos = mark.pos;
+  cont->line = mark.line;
+  cont->col = mark.col;
+}
+
+#define THROW_IF_EOF(cont) THROW_IF(peek(cont) == '\0', EXC_LEX_SYNTAX, "EOF reached while skipping braces")
+
+void skip_braced(ScannerCont *cont, int depth) {
+  while (depth > 0) {
+    char ch = peek(cont);
+    THROW_IF_EOF(cont);
+    if (ch == '/' && peek2(cont) == '/') {
+      while (peek(cont) != '\n' && peek(cont) != '\0')
+        getch(cont);
+      continue;
+    }
+    if (ch == '/' && peek2(cont) == '*') {
+      getch(cont);
+      getch(cont);
+      while (!(peek(cont) == '*' && peek2(cont) == '/')) {
+        THROW_IF_EOF(cont);
+        getch(cont);
+      }
+      getch(cont);
+      getch(cont);
+      continue;
+    }
+    if (ch == '"' || ch == '\'') {
+      getch(cont);
+      while (peek(cont) != ch) {
+        THROW_IF_EOF(cont);
+        if (getch(cont) == '\\') {
+          THROW_IF_EOF(cont);
+          getch(cont);
+        }
+      }
+      getch(cont);
+      continue;
+    }
+    if (ch == '{') {
+      depth++;
+    } else if (ch == '}') {
+      depth--;
+    }
+    getch(cont);
+  }
+}
+
 static int is_ident_start(int c) {
   return (c == '_') || isalpha(c);
 }
@@ -192,11 +246,12 @@ static int match_longest_prefix(ScannerCont *cont, const char **values, const in
   int i = 0;
   int match = 1;
   for (int k = 0; ; k++, getch(cont)) {
-    for(match = 0; i < n_values; i++) {
+    // Candidates must agree with everything consumed so far, which the previous match spells out.
+    for (match = 0, i = 0; i < n_values; i++) {
       if (lens[i] < k + 1) {
         continue;
       }
-      if (values[i][k] == peek(cont)) {
+      if (values[i][k] == peek(cont) && (k == 0 || strncmp(values[i], values[i_prev_match], k) == 0)) {
         i_prev_match = i;
         match = 1;
         break;
@@ -341,7 +396,8 @@ label_start:
   label_throw:
     THROW(EXC_LEX_SYNTAX, "Expected to parse integer or double literal but nothing was parsed");
   }
-  if (ispunct(ch)) {
+  // '_' is punctuation to ispunct, but starts identifiers like _Static_assert
+  if (ispunct(ch) && !is_ident_start(ch)) {
     int i = match_longest_prefix(cont, PUNCT_VALUES, PUNCT_VALUES_len, N_PUNCTS);
     if (i >= 0) {
       return make_partial_token(cont, PUNCT_KIND(i));
@@ -356,7 +412,8 @@ label_start:
   if (is_ident_start(ch)) {
     // identifier_or_keyword
     int i = match_longest_prefix(cont, KEYWORD_VALUES, KEYWORD_VALUES_len, N_KEYWORDS);
-    if (i >= 0) {
+    // A keyword followed by more identifier characters (e.g. integer) is an identifier.
+    if (i >= 0 && !is_ident_rest(peek(cont))) {
       return make_partial_token(cont, KEYWORD_KIND(i));
     }
     // else we are in the middle of an identifier
@@ -22,8 +22,24 @@ typedef struct {
   int col_end;
 } Token;
 
+/** Saved position of a scanner, to rewind and rescan a range of tokens */
+typedef struct {
+  int pos;
+  int line;
+  int col;
+} ScannerMark;
+
 ScannerCont *new_scanner_cont(FILE *in, const char *filename);
 Token consume_next_token(ScannerCont *cont);
+ScannerMark mark_scanner(const ScannerCont *cont);
+/** Rewind (or fast forward) to a position returned by mark_scanner. Interned string ids are preserved. */
+void reset_scanner(ScannerCont *cont, ScannerMark mark);
+/**
+ * Skip characters until depth unmatched right braces have been consumed, without producing tokens. Braces inside
+ * comments, string literals and character constants are ignored.
+ * @throw EXC_LEX_SYNTAX if the input ends first
+ */
+void skip_braced(ScannerCont *cont, int depth);
 void init_lexer_module();
 /** Print contents of string pool to f, for debugging */
 void fprint_string_pool(FILE *f, ScannerCont *cont);
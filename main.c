@@ -1,4 +1,7 @@
+#include "cache.h"
 #include "common.h"
+#include "fanout_visitor.h"
+#include "fold_visitor.h"
 #include "parser.h"
 #include "visitor.h"
 #include <unistd.h>
@@ -10,10 +13,23 @@ extern int optopt;
 extern int opterr;
 extern int optreset;
 
-static void parse_start(FILE *in, const char *filename, Visitor *visitor) {
+typedef struct {
+  FunctionCache *cache;
+  int skip_function_bodies;
+  const char *parse_on_demand;  ///< name of a skipped function body to visit after the declarations
+} DriverOptions;
+
+static void parse_start(FILE *in, const char *filename, Visitor *visitor, const DriverOptions *driver) {
   ParserCont *cont = new_parser_cont(in, filename, visitor);
+  if (driver->cache) {
+    set_function_cache(cont, driver->cache);
+  }
+  set_skip_function_bodies(cont, driver->skip_function_bodies);
   if (setjmp(global_exception_handler) == 0) {
     parse_translation_unit(cont);
+    if (driver->parse_on_demand && !parse_deferred_function_body(cont, driver->parse_on_demand)) {
+      fprintf(stderr, "ERROR: No skipped function body named %s\n", driver->parse_on_demand);
+    }
     visitor->finalize(visitor);
 
     if (peek(cont).kind != TOK_END_OF_FILE) {
@@ -21,6 +37,12 @@ static void parse_start(FILE *in, const char *filename, Visitor *visitor) {
     } else {
       fprintf(stderr, "Translation unit parsed completely and successfully!\n");
     }
+    if (driver->cache) {
+      fprint_function_cache_stats(stderr, driver->cache);
+    }
+    if (driver->skip_function_bodies) {
+      fprintf(stderr, "Skipped %d function bodies\n", n_deferred_function_bodies(cont));
+    }
   } else {
     PRINT_EXCEPTION();
     abort();
@@ -30,34 +52,134 @@ static void parse_start(FILE *in, const char *filename, Visitor *visitor) {
 void usage() {
   fprintf(stderr, "usage: parser_driver [options] file\n\n");
   fprintf(stderr, "options:\n");
-  fprintf(stderr, "  -v <visitor> which visitor to use (choices: ssa, ast, x86_64)\n");
+  fprintf(stderr, "  -v <visitors> comma separated visitors to drive with one parse (choices: x86_64, ssa, stats)\n");
+  fprintf(stderr, "               the first writes to -o; each other one to <file>.<visitor>, or stderr\n");
   fprintf(stderr, "  -o <file>    save output to this file\n");
+  fprintf(stderr, "  -O <level>   optimization level; 0 disables constant folding, 2 compiles through the SSA IR\n");
+  fprintf(stderr, "               with register allocation (default 1)\n");
+  fprintf(stderr, "  -V <bits>    vector width for loops at -O 2: 128 for SSE2 (default), 256 for AVX2, 0 for none\n");
+  fprintf(stderr, "  -F           at -O 2, omit the frame pointer in all functions; leaf functions never set one up\n");
+  fprintf(stderr, "  -G <file>    at -O 2, instrument the code to add the times each block runs to file at exit\n");
+  fprintf(stderr, "  -U <file>    at -O 2, optimize by the counts a build of the same code with -G left in file\n");
+  fprintf(stderr, "  -n           omit the timestamp header, for deterministic output\n");
+  fprintf(stderr, "  -C <dir>     reuse code for unchanged function definitions from the cache in dir\n");
+  fprintf(stderr, "  -s           declarations only: skip function bodies\n");
+  fprintf(stderr, "  -f <name>    with -s, parse the body of function name after the declarations\n");
   exit(1);
 }
 
-extern Visitor *new_x86_64_visitor(FILE *out);
+/**
+ * Identify the compiler binary, so a rebuilt compiler does not reuse code emitted by an older one. Falls back to the
+ * build time if the binary cannot be read (e.g. argv[0] was found through PATH).
+ */
+static uint64_t compiler_hash(const char *argv0) {
+  FILE *self = fopen(argv0, "rb");
+  if (!self) {
+    return hash_str(HASH_INIT, __DATE__ " " __TIME__);
+  }
+  uint64_t h = HASH_INIT;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), self)) > 0) {
+    h = hash_bytes(h, buf, n);
+  }
+  checked_fclose(self);
+  return h;
+}
+
+extern Visitor *new_x86_64_visitor(FILE *out, const VisitorOptions *options);
+extern Visitor *new_x86_64_ir_visitor(FILE *out, const VisitorOptions *options);
+extern Visitor *new_ssa_visitor(FILE *out, const VisitorOptions *options);
+extern Visitor *new_stats_visitor(FILE *out, const VisitorOptions *options);
+
+static const struct {
+  const char *name;
+  VisitorConstructor ctor;
+  VisitorConstructor optimizing_ctor;  ///< replaces ctor from -O 2 on, if set
+} VISITORS[] = {
+  { "x86_64", new_x86_64_visitor, new_x86_64_ir_visitor },
+  { "ssa", new_ssa_visitor, 0 },
+  { "stats", new_stats_visitor, 0 },
+};
+
+/** Construct the visitors in the comma separated list names, fanning out to them if there is more than one. */
+static Visitor *new_visitors(const char *names, FILE *out, const char *out_path, const VisitorOptions *options) {
+  DECLARE_VECTOR(Visitor *, children)
+  NEW_VECTOR(children, sizeof(Visitor *));
+  char *list = fmtstr("%s", names);
+  char *saveptr;
+  for (char *name = strtok_r(list, ",", &saveptr); name; name = strtok_r(0, ",", &saveptr)) {
+    VisitorConstructor ctor = 0;
+    for (size_t i = 0; i < sizeof(VISITORS) / sizeof(VISITORS[0]); i++) {
+      if (strcmp(name, VISITORS[i].name) == 0) {
+        ctor = options->opt_level >= 2 && VISITORS[i].optimizing_ctor ? VISITORS[i].optimizing_ctor : VISITORS[i].ctor;
+      }
+    }
+    if (!ctor) {
+      fprintf(stderr, "ERROR: Unknown visitor %s\n", name);
+      usage();
+    }
+    FILE *child_out = children_size == 0 ? out : out_path ? checked_fopen(fmtstr("%s.%s", out_path, name), "w") : stderr;
+    APPEND_VECTOR(children, ctor(child_out, options));
+  }
+  free(list);
+  return children_size == 1 ? children[0] : new_fanout_visitor(children_size, children);
+}
 
 int main(int argc, char *argv[]) {
   FILE *out = stdout;
-  VisitorConstructor visitor_ctor = 0;
+  const char *out_path = 0;
+  const char *visitor_names = "x86_64";
+  VisitorOptions options = { .opt_level = 1, .vector_size = 16 };
+  DriverOptions driver = {0};
+  const char *cache_dir = 0;
+  // Everything that changes the emitted code goes into the cache salt.
+  char *salt = fmtstr("%016llx", (unsigned long long) compiler_hash(argv[0]));
+  const char *optstring = "v:o:nC:sf:O:V:FG:U:";
   int ch;
-  while ((ch = getopt(argc, argv, "v:o:")) != -1) {
+  while ((ch = getopt(argc, argv, optstring)) != -1) {
+    if (ch != 'o' && ch != 'C') {
+      const char *colon = strchr(optstring, ch);
+      salt = fmtstr("%s -%c%s", salt, ch, colon && colon[1] == ':' ? optarg : "");
+    }
     switch (ch) {
       case 'v':
-        if (strcmp(optarg, "ssa") == 0) {
-          // visitor_ctor = new_ssa_visitor;
-          usage();
-          // break;
-        } else if (strcmp(optarg, "ast") == 0) {
-          // visitor_ctor = new_ast_visitor;
-          usage();
-          // break;
-        } else if (strcmp(optarg, "x86_64") == 0) {
-          visitor_ctor = new_x86_64_visitor;
-          break;
-        }
+        visitor_names = optarg;
+        break;
       case 'o':
         out = checked_fopen(optarg, "w");
+        out_path = optarg;
+        break;
+      case 'O':
+        options.opt_level = atoi(optarg);
+        break;
+      case 'V':
+        options.vector_size = atoi(optarg) / 8;
+        if (options.vector_size != 0 && options.vector_size != 16 && options.vector_size != 32) {
+          fprintf(stderr, "ERROR: Unsupported vector width %s\n", optarg);
+          usage();
+        }
+        break;
+      case 'n':
+        options.no_timestamp = 1;
+        break;
+      case 'F':
+        options.omit_frame_pointer = 1;
+        break;
+      case 'G':
+        options.profile_generate = optarg;
+        break;
+      case 'U':
+        options.profile_use = optarg;
+        break;
+      case 'C':
+        cache_dir = optarg;
+        break;
+      case 's':
+        driver.skip_function_bodies = 1;
+        break;
+      case 'f':
+        driver.parse_on_demand = optarg;
         break;
       case '?':
       default:
@@ -70,10 +192,17 @@ int main(int argc, char *argv[]) {
     usage();
   }
 
-  visitor_ctor = visitor_ctor ? visitor_ctor : new_x86_64_visitor;
   FILE *in = checked_fopen(argv[0], "r");
   init_parser_module();
 
-  parse_start(in, argv[0], visitor_ctor(out));
+  // Instrumented functions count into a table of the whole translation unit, and profiled ones are put in order at its
+  // end, so the text of neither can be replayed by itself.
+  int has_profile = options.profile_generate || options.profile_use;
+  driver.cache = cache_dir && !has_profile ? new_function_cache(cache_dir, salt) : 0;
+  Visitor *visitor = new_visitors(visitor_names, out, out_path, &options);
+  if (options.opt_level >= 1) {
+    visitor = new_folding_visitor(visitor);
+  }
+  parse_start(in, argv[0], visitor, &driver);
   return 0;
 }
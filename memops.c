@@ -0,0 +1,105 @@
+#include "memops.h"
+
+#include "common.h"
+
+// Blocks up to this size are cleared or copied by unrolled stores: at most 16 of 16 bytes.
+#define MAX_INLINE_BLOCK 256
+// From this size on, a block would evict more from the caches than they are likely to hold of it afterward.
+#define MIN_STREAM_BLOCK (1 << 20)
+
+static const char *const rax_names[] = {[1] = "%al", [2] = "%ax", [4] = "%eax", [8] = "%rax"};
+static const char suffixes[] = {[1] = 'b', [2] = 'w', [4] = 'l', [8] = 'q'};
+
+BlockStrategy block_strategy(int64_t size) {
+  if (size <= MAX_INLINE_BLOCK)
+    return BLOCK_INLINE;
+  return size < MIN_STREAM_BLOCK ? BLOCK_REP : BLOCK_STREAM;
+}
+
+/** The operand for the bytes delta past m */
+static const char *mem_text(MemRef m, int64_t delta) {
+  int64_t disp = m.disp + delta;
+  if (m.symbol)
+    return disp ? fmtstr("_%s+%lld(%%rip)", m.symbol, (long long) disp) : fmtstr("_%s(%%rip)", m.symbol);
+  return disp ? fmtstr("%lld(%s)", (long long) disp, m.base) : fmtstr("(%s)", m.base);
+}
+
+/** The widest general register width that fits in the size - offset bytes left */
+static int tail_width(int64_t size, int64_t offset) {
+  int width = 8;
+  while (width > size - offset) {
+    width /= 2;
+  }
+  return width;
+}
+
+void fprint_inline_zero(FILE *out, MemRef dst, int64_t size, int vex) {
+  int64_t offset = 0;
+  if (size >= 16) {
+    // The VEX form clears the upper half of %ymm15 too.
+    fputs(vex ? "\tvpxor\t%xmm15, %xmm15, %xmm15\n" : "\txorps\t%xmm15, %xmm15\n", out);
+    for (; vex && size - offset >= 32; offset += 32) {
+      fprintf(out, "\tvmovdqu\t%%ymm15, %s\n", mem_text(dst, offset));
+    }
+    for (; size - offset >= 16; offset += 16) {
+      fprintf(out, "\t%s\t%%xmm15, %s\n", vex ? "vmovdqu" : "movups", mem_text(dst, offset));
+    }
+  }
+  while (offset < size) {
+    int width = tail_width(size, offset);
+    fprintf(out, "\tmov%c\t$0, %s\n", suffixes[width], mem_text(dst, offset));
+    offset += width;
+  }
+}
+
+void fprint_inline_copy(FILE *out, MemRef dst, MemRef src, int64_t size, int vex) {
+  int64_t offset = 0;
+  for (; vex && size - offset >= 32; offset += 32) {
+    fprintf(out, "\tvmovdqu\t%s, %%ymm15\n", mem_text(src, offset));
+    fprintf(out, "\tvmovdqu\t%%ymm15, %s\n", mem_text(dst, offset));
+  }
+  for (; size - offset >= 16; offset += 16) {
+    fprintf(out, "\t%s\t%s, %%xmm15\n", vex ? "vmovdqu" : "movups", mem_text(src, offset));
+    fprintf(out, "\t%s\t%%xmm15, %s\n", vex ? "vmovdqu" : "movups", mem_text(dst, offset));
+  }
+  while (offset < size) {
+    int width = tail_width(size, offset);
+    fprintf(out, "\tmov%c\t%s, %s\n", suffixes[width], mem_text(src, offset), rax_names[width]);
+    fprintf(out, "\tmov%c\t%s, %s\n", suffixes[width], rax_names[width], mem_text(dst, offset));
+    offset += width;
+  }
+}
+
+/** Print the head of a loop running %rcx times over the 8-byte words of a block of size bytes. */
+static void fprint_stream_loop(FILE *out, int64_t size, const char *label) {
+  fprintf(out, "\tmovq\t$%lld, %%rcx\n\t.p2align\t4, 0x90\n%s:\n", (long long) (size / 8), label);
+}
+
+void fprint_block_zero(FILE *out, int64_t size, const char *label) {
+  fputs("\txorl\t%eax, %eax\n", out);
+  if (block_strategy(size) == BLOCK_REP) {
+    fprintf(out, "\tmovl\t$%lld, %%ecx\n\trep stosb\n", (long long) size);
+    return;
+  }
+  fprint_stream_loop(out, size, label);
+  fprintf(out, "\tmovnti\t%%rax, (%%rdi)\n\taddq\t$8, %%rdi\n\tsubq\t$1, %%rcx\n\tjne\t%s\n", label);
+  // The stores are weakly ordered; the fence makes them visible before anything after it.
+  fputs("\tsfence\n", out);
+  fprint_inline_zero(out, (MemRef) { .base = "%rdi" }, size % 8, 0);
+}
+
+void fprint_block_copy(FILE *out, int64_t size, const char *label) {
+  if (block_strategy(size) == BLOCK_REP) {
+    fprintf(out, "\tmovl\t$%lld, %%ecx\n\trep movsb\n", (long long) size);
+    return;
+  }
+  fprint_stream_loop(out, size, label);
+  fprintf(
+    out,
+    "\tmovq\t(%%rsi), %%rax\n\tmovnti\t%%rax, (%%rdi)\n\taddq\t$8, %%rsi\n\taddq\t$8, %%rdi\n\tsubq\t$1, %%rcx\n"
+    "\tjne\t%s\n",
+    label
+  );
+  fputs("\tsfence\n", out);
+  fprint_inline_copy(out, (MemRef) { .base = "%rdi" }, (MemRef) { .base = "%rsi" }, size % 8, 0);
+}
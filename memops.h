@@ -0,0 +1,43 @@
+/**
+ * Clearing and copying blocks of memory, such as aggregates, shared by the backends. Small blocks take straight-line
+ * stores; larger ones rep stosb and rep movsb, which fast-string microcode runs a cache line at a time; and the largest
+ * non-temporal stores, which bypass the cache rather than evict everything else from it.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+  BLOCK_INLINE,  ///< unrolled stores: of general registers below 16 bytes, else of vector registers
+  BLOCK_REP,  ///< rep stosb or rep movsb
+  BLOCK_STREAM,  ///< a loop of non-temporal stores, then sfence
+} BlockStrategy;
+
+/** How a block of size bytes is cleared or copied */
+BlockStrategy block_strategy(int64_t size);
+
+/** A memory operand: disp(base), or _symbol+disp(%rip) if symbol is set */
+typedef struct {
+  const char *base;
+  const char *symbol;
+  int64_t disp;
+} MemRef;
+
+/**
+ * Print the stores clearing size bytes at dst, for BLOCK_INLINE. They are 16 bytes wide, or 32 in AVX encodings if vex
+ * is set, until fewer bytes are left. %xmm15 is clobbered.
+ */
+void fprint_inline_zero(FILE *out, MemRef dst, int64_t size, int vex);
+
+/** Likewise, print the moves copying size bytes from src to dst, equal or disjoint. %rax and %xmm15 are clobbered. */
+void fprint_inline_copy(FILE *out, MemRef dst, MemRef src, int64_t size, int vex);
+
+/**
+ * Print the instructions clearing size bytes at %rdi, for BLOCK_REP or BLOCK_STREAM, the loop of which is labeled
+ * label. %rax, %rcx and %rdi are clobbered.
+ */
+void fprint_block_zero(FILE *out, int64_t size, const char *label);
+
+/** Likewise, print the instructions copying size bytes from %rsi to %rdi, which also clobber %rsi. */
+void fprint_block_copy(FILE *out, int64_t size, const char *label);
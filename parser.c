@@ -1,9 +1,15 @@
 #include "lexer.h"
 
 #include <stdarg.h>
+#include <string.h>
+#include "cache.h"
 #include "common.h"
+#include "fold_visitor.h"
 #include "types_impl.h"
 #include "visitor.h"
+#include "vendor/klib/khash.h"
+
+KHASH_MAP_INIT_INT(DeclHashMap, uint64_t)
 
 typedef enum {
   SC_NONE = 0,
@@ -65,17 +71,69 @@ typedef struct Declarator {
 
 #define IS_ABSTRACT_DECLARATOR(declarator) !(declarator)->ident
 
+typedef struct Scope {
+  SymbolTable *values;
+  SymbolTable *typedefs;
+  SymbolTable *structs;
+  SymbolTable *unions;
+  SymbolTable *enums;
+} Scope;
+
+/** Saved parser position, to rewind to a token that was already consumed. */
+typedef struct {
+  Token token;
+  ScannerMark scanner;
+} ParserMark;
+
+/** A function body that was skipped in declarations-only mode, with what is needed to parse it later. */
+typedef struct {
+  DeclarationSpecifiers decl_specs;
+  Declarator *declarator;
+  Scope scope;
+  ParserMark body;  ///< just past the opening brace
+} DeferredFunction;
+
+/** Where break and continue jump to within a loop, or a switch statement, where continue is the enclosing loop's */
+typedef struct {
+  void *break_label;
+  void *continue_label;  ///< NULL in a switch statement outside any loop
+} LoopLabels;
+
+/** A case label of an enclosing switch statement */
+typedef struct {
+  int64_t value;  ///< converted to the promoted type of the controlling expression
+  void *label;
+} CaseLabel;
+
+/** An enclosing switch statement, whose case and default labels are collected as its body is parsed */
 typedef struct {
-  ScannerCont *scont;  
+  const Type *type;  ///< of the controlling expression, promoted
+  int first_case;  ///< index of its first case in cases
+  void *default_label;  ///< NULL until its default label is parsed
+} SwitchLabels;
+
+typedef struct {
+  ScannerCont *scont;
   Visitor *visitor;
+  Visitor *constant_evaluator;  ///< takes the place of visitor while parsing an integer constant expression
   Token token;
+  Scope scope;
+  FunctionCache *cache;  ///< NULL unless incremental compilation is enabled
+  int skip_function_bodies;  ///< Declarations only: skip function bodies instead of visiting them
+  DECLARE_VECTOR(DeferredFunction, deferred_functions)
+  DECLARE_VECTOR(LoopLabels, loops)  ///< enclosing loops and switches of the statement being parsed, innermost last
+  DECLARE_VECTOR(SwitchLabels, switches)  ///< enclosing switch statements, innermost last
+  DECLARE_VECTOR(CaseLabel, cases)  ///< the case labels of the enclosing switch statements, innermost last
+  const Type *return_type;  ///< of the function definition being parsed
+  /** While active, hash every consumed token to identify an external declaration. */
   struct {
-    SymbolTable *values;
-    SymbolTable *typedefs;
-    SymbolTable *structs;
-    SymbolTable *unions;
-    SymbolTable *enums;
-  } scope;
+    int active;
+    uint64_t hash;
+    DECLARE_VECTOR(int, idents)  ///< string ids of the identifiers consumed, to look up dependencies
+    DECLARE_VECTOR(int, declared)  ///< string ids of the identifiers and tags declared
+  } recorder;
+  /** File scope identifier or tag -> hash of the external declaration that last declared it, dependencies included */
+  kh_DeclHashMap_t *decl_hashes;
 } ParserCont;
 
 void push_scope(ParserCont *cont) {
@@ -94,10 +152,29 @@ void pop_scope(ParserCont *cont) {
 
 typedef struct {
   int gen_lvalue;  // else gen rvalue
-  int gen_jump;  // else gen rvalue
-  int gen_constexpr;  // ???
+  int gen_constexpr;  // integer constant expression: no objects may be referenced
+  void *primary;  // already parsed, by a condition that turned out to be an operand: parse_primary_expr returns it
 } ParseControl;
 
+/** Labels of one place, which were jumped to before it was known they were the same */
+typedef struct {
+  DECLARE_VECTOR(void *, labels)
+} LabelSet;
+
+/**
+ * An expression parsed as a condition, by the branches it makes rather than a value. The operands of && and || already
+ * tested (6.5.13, 6.5.14) jump to exits[1] where they decide it holds and to exits[0] where they decide it does not;
+ * otherwise they fall through with its truth still to test: that of value, or the opposite if negated is set, as !
+ * leaves it (6.5.3.3p5). A branch to exits of the operands just parsed can only be emitted once the token after them
+ * tells whether they end an operand of && or of ||, or the condition.
+ */
+typedef struct {
+  void *value;
+  int negated;
+  int is_value;  ///< value is the expression's own, with no operator of a condition applied
+  LabelSet exits[2];
+} Condition;
+
 Token peek(ParserCont *cont) {
   return cont->token;
 }
@@ -114,26 +191,118 @@ const char *peek_str(ParserCont *cont) {
   }
 }
 
+static void record_token(ParserCont *cont, Token tok) {
+  if (!cont->recorder.active)
+    return;
+  // Hash token values, not source text, so whitespace and comments do not invalidate the cache.
+  uint64_t h = hash_u64(cont->recorder.hash, tok.kind);
+  switch (tok.kind) {
+    case TOK_IDENT:
+      APPEND_VECTOR(cont->recorder.idents, tok.string_id);
+      h = hash_str(h, tok.string_val);
+      break;
+    case TOK_STRING_LITERAL:
+      h = hash_str(h, tok.string_val);
+      break;
+    case TOK_INTEGER_LITERAL:
+      h = hash_u64(h, tok.int64_val);
+      break;
+    case TOK_FLOAT_LITERAL:
+      h = hash_bytes(h, &tok.double_val, sizeof(tok.double_val));
+      break;
+    default:
+      break;
+  }
+  cont->recorder.hash = h;
+}
+
 #define consume(cont) do { \
   THROW_IF(peek(cont).kind == TOK_END_OF_FILE, EXC_PARSE_SYNTAX, "EOF reached without finishing parse"); \
   DEBUG_PRINT_EXPR("consumed %s", peek_str(cont)); \
+  record_token(cont, peek(cont)); \
   cont->token = consume_next_token(cont->scont); \
 } while (0)
 
+ParserMark mark_parser(const ParserCont *cont) {
+  return (ParserMark) { .token = cont->token, .scanner = mark_scanner(cont->scont) };
+}
+
+void reset_parser(ParserCont *cont, ParserMark mark) {
+  cont->token = mark.token;
+  reset_scanner(cont->scont, mark.scanner);
+}
+
 ParserCont *new_parser_cont(FILE *in, const char *filename, Visitor *visitor) {
   ParserCont *ret = checked_calloc(1, sizeof(*ret));
   *ret = (ParserCont) {
     .scont = new_scanner_cont(in, filename),
     .visitor = visitor,
+    .constant_evaluator = new_constant_evaluator(visitor),
     .scope.values = new_symbol_table(),
     .scope.typedefs = new_symbol_table(),
     .scope.structs = new_symbol_table(),
     .scope.unions = new_symbol_table(),
   };
+  NEW_VECTOR(ret->recorder.idents, sizeof(int));
+  NEW_VECTOR(ret->recorder.declared, sizeof(int));
+  NEW_VECTOR(ret->deferred_functions, sizeof(DeferredFunction));
+  NEW_VECTOR(ret->loops, sizeof(LoopLabels));
+  NEW_VECTOR(ret->switches, sizeof(SwitchLabels));
+  NEW_VECTOR(ret->cases, sizeof(CaseLabel));
   consume(ret);
   return ret;
 }
 
+void set_skip_function_bodies(ParserCont *cont, int skip) {
+  cont->skip_function_bodies = skip;
+}
+
+void set_function_cache(ParserCont *cont, FunctionCache *cache) {
+  cont->cache = cache;
+  cont->decl_hashes = kh_init_DeclHashMap();
+}
+
+void start_recording(ParserCont *cont) {
+  cont->recorder.active = 1;
+  cont->recorder.hash = HASH_INIT;
+  cont->recorder.idents_size = 0;
+  cont->recorder.declared_size = 0;
+}
+
+/** Remember that the external declaration being recorded declares the identifier or tag string_id. */
+void note_declared(ParserCont *cont, int string_id) {
+  if (cont->recorder.active) {
+    APPEND_VECTOR(cont->recorder.declared, string_id);
+  }
+}
+
+/**
+ * Hash of the recorded tokens together with the external declarations they depend on. An identifier that names a
+ * file scope declaration pulls in the hash of that declaration, which in turn covers its own dependencies. Locals
+ * that shadow a file scope name add a spurious dependency, which only costs a cache miss.
+ */
+uint64_t recorded_hash(const ParserCont *cont) {
+  uint64_t h = cont->recorder.hash;
+  for (int i = 0; i < cont->recorder.idents_size; i++) {
+    khiter_t iter = kh_get_DeclHashMap(cont->decl_hashes, cont->recorder.idents[i]);
+    if (iter != kh_end(cont->decl_hashes)) {
+      h = hash_u64(h, kh_val(cont->decl_hashes, iter));
+    }
+  }
+  return h;
+}
+
+void set_decl_hash(ParserCont *cont, int string_id, uint64_t h) {
+  int ret;
+  khiter_t iter = kh_put_DeclHashMap(cont->decl_hashes, string_id, &ret);
+  THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+  kh_val(cont->decl_hashes, iter) = h;
+}
+
+void stop_recording(ParserCont *cont) {
+  cont->recorder.active = 0;
+}
+
 #define EXPECT(cont, tok_kind) \
   THROWF_IF( \
     peek(cont).kind != (tok_kind), \
@@ -167,14 +336,30 @@ int _tok_is_in(TokenKind op, ...) {
 #define CALL0(receiver, method) (receiver)->method(receiver)
 
 void *parse_expr(ParserCont *cont, ParseControl *ctl);
+void *parse_assignment_expr(ParserCont *cont, ParseControl *ctl);
+
+/** Place a label that only earlier jumps target. */
+static void place_forward_label(ParserCont *cont, void *label) {
+  CALL(cont->visitor, visit_label, label);
+  CALL(cont->visitor, seal_label, label);
+}
 
 void *parse_primary_expr(ParserCont *cont, ParseControl *ctl) {
   PRINT_ENTRY();
+  void *ret = ctl->primary;
+  if (ret) {
+    ctl->primary = 0;
+    return ret;
+  }
   Token tok = peek(cont);
   Value *lookup_result;
-  void *ret;
   switch (tok.kind) {
     case TOK_IDENT:
+      THROWF_IF(ctl->gen_constexpr,
+        EXC_PARSE_SYNTAX,
+        "identifier %s is not allowed in a constant expression",
+        tok.string_val
+      );
       consume(cont);
       lookup_result = lookup_value(cont->scope.values, tok.string_id);
       THROWF_IF(!lookup_result,
@@ -200,10 +385,45 @@ void *parse_primary_expr(ParserCont *cont, ParseControl *ctl) {
   }
 }
 
+/**
+ * 6.5.2.2: each argument is converted as if by assignment to the type of its parameter, if the function has a
+ * prototype, or else promoted.
+ */
 void *parse_function_call_rest(ParserCont *cont, void *function) {
   assert(peek(cont).kind == TOK_LEFT_PAREN);
   consume(cont);
-  assert(0 && "Unimplemented");
+  Visitor *v = cont->visitor;
+  const Type *type = v->type_of(function);
+  THROW_IF(type->kind != TY_FUNCTION, EXC_PARSE_SYNTAX, "called object is not a function");
+  DECLARE_VECTOR(void *, args)
+  NEW_VECTOR(args, sizeof(void *));
+  while (peek(cont).kind != TOK_RIGHT_PAREN) {
+    if (args_size) {
+      EXPECT(cont, TOK_COMMA);
+      consume(cont);
+    }
+    THROW_IF(type->n_params >= 0 && args_size == type->n_params, EXC_PARSE_SYNTAX, "too many arguments");
+    ParseControl ctl = {0};
+    void *arg = parse_assignment_expr(cont, &ctl);
+    const Type *arg_type = v->type_of(arg);
+    const Type *param_type = type->n_params >= 0 ? type->param_types[args_size] : argument_promoted_type(v, arg_type);
+    APPEND_VECTOR(args, changes_representation(arg_type, param_type) ? CALL(v, convert_type, arg, param_type) : arg);
+  }
+  consume(cont);
+  THROW_IF(type->n_params >= 0 && args_size < type->n_params, EXC_PARSE_SYNTAX, "too few arguments");
+  void *ret = CALL(v, visit_call, function, args_size, args);
+  free(args);
+  return ret;
+}
+
+/** x++ is (x += 1) - 1, converted back to the type of x in case it is narrower than int. */
+void *parse_postfix_increment(ParserCont *cont, TokenKind op, void *operand) {
+  Visitor *v = cont->visitor;
+  void *one = CALL(v, visit_integer_literal, 1);
+  void *updated = CALL(v, visit_assign, op == TOK_INC_OP ? TOK_ADD_ASSIGN : TOK_SUB_ASSIGN, operand, one);
+  void *ret = CALL(v, visit_binop, op == TOK_INC_OP ? TOK_SUB_OP : TOK_ADD_OP, updated, one);
+  const Type *type = v->type_of(operand);
+  return changes_representation(v->type_of(ret), type) ? CALL(v, convert_type, ret, type) : ret;
 }
 
 // the PARSER should recursively get the array reference.
@@ -230,14 +450,35 @@ void *parse_postfix_expr(ParserCont *cont, ParseControl *ctl) {
         break;
       case TOK_LEFT_PAREN:
         return parse_function_call_rest(cont, left);
+      case TOK_INC_OP:
+      case TOK_DEC_OP:
+        consume(cont);
+        left = parse_postfix_increment(cont, op, left);
+        break;
       default:
         return left;
     }
   }
 }
 
+static void parse_unary_condition(ParserCont *cont, ParseControl *ctl, Condition *c);
+static void *condition_value(ParserCont *cont, Condition *c);
+
 void *parse_unary_expr(ParserCont *cont, ParseControl *ctl) {
   PRINT_ENTRY();
+  TokenKind op = ctl->primary ? TOK_ERROR : peek(cont).kind;
+  if (op == TOK_NOT_OP) {
+    Condition c = {0};
+    parse_unary_condition(cont, ctl, &c);
+    return condition_value(cont, &c);
+  }
+  if (op == TOK_INC_OP || op == TOK_DEC_OP) {
+    // ++x is x += 1
+    consume(cont);
+    void *operand = parse_unary_expr(cont, ctl);
+    void *one = CALL(cont->visitor, visit_integer_literal, 1);
+    return CALL(cont->visitor, visit_assign, op == TOK_INC_OP ? TOK_ADD_ASSIGN : TOK_SUB_ASSIGN, operand, one);
+  }
   void *ret = parse_postfix_expr(cont, ctl);
   return ret;
 }
@@ -274,15 +515,11 @@ void *parse_shift_expr(ParserCont *cont, ParseControl *ctl) {
   return parse_additive_expr(cont, ctl);
 }
 
-void *parse_relational_expr(ParserCont *cont, ParseControl *ctl) {
-  PRINT_ENTRY();
-  return parse_shift_expr(cont, ctl);
-}
+#define relational_pred(op) tok_is_in(op, TOK_LT_OP, TOK_RT_OP, TOK_LE_OP, TOK_GE_OP)
+MAKE_BINOP_PARSER(parse_relational_expr, parse_shift_expr, relational_pred)
 
-void *parse_equality_expr(ParserCont *cont, ParseControl *ctl) {
-  PRINT_ENTRY();
-  return parse_relational_expr(cont, ctl);
-}
+#define equality_pred(op) tok_is_in(op, TOK_EQ_OP, TOK_NE_OP)
+MAKE_BINOP_PARSER(parse_equality_expr, parse_relational_expr, equality_pred)
 
 void *parse_and_expr(ParserCont *cont, ParseControl *ctl) {
   PRINT_ENTRY();
@@ -299,19 +536,297 @@ void *parse_inclusive_or_expr(ParserCont *cont, ParseControl *ctl) {
   return parse_exclusive_or_expr(cont, ctl);
 }
 
-void *parse_logical_and_expr(ParserCont *cont, ParseControl *ctl) {
+/** A label of set, which is given a new one if it has none */
+static void *label_in(ParserCont *cont, LabelSet *set) {
+  if (!set->labels) {
+    NEW_VECTOR(set->labels, sizeof(void *));
+  }
+  if (!set->labels_size) {
+    APPEND_VECTOR(set->labels, CALL0(cont->visitor, new_label));
+  }
+  return set->labels[0];
+}
+
+/** Move the labels of from to into. */
+static void merge_label_sets(LabelSet *into, LabelSet *from) {
+  if (!into->labels_size) {
+    free(into->labels);
+    *into = *from;
+  } else {
+    for (int i = 0; i < from->labels_size; i++) {
+      APPEND_VECTOR(into->labels, from->labels[i]);
+    }
+    free(from->labels);
+  }
+  *from = (LabelSet) {0};
+}
+
+/** Place the labels of set here, and empty it. */
+static void place_label_set(ParserCont *cont, LabelSet *set) {
+  for (int i = 0; i < set->labels_size; i++) {
+    place_forward_label(cont, set->labels[i]);
+  }
+  free(set->labels);
+  *set = (LabelSet) {0};
+}
+
+/** Jump to exits[truth] of c if the truth still to test is truth, else fall through. */
+static void branch_on_value(ParserCont *cont, Condition *c, int truth) {
+  CALL(cont->visitor, visit_branch, c->value, truth != c->negated, label_in(cont, &c->exits[truth]));
+}
+
+static void negate_condition(Condition *c) {
+  LabelSet exit = c->exits[0];
+  c->exits[0] = c->exits[1];
+  c->exits[1] = exit;
+  c->negated = !c->negated;
+  c->is_value = 0;
+}
+
+/**
+ * The value of c: 1 where it holds and 0 where not, unless it is the expression's own. The truth still to test is a
+ * comparison with zero, computed by setcc; where operands jumped out, a local is set to the result instead.
+ */
+static void *condition_value(ParserCont *cont, Condition *c) {
+  if (c->is_value)
+    return c->value;
+  Visitor *v = cont->visitor;
+  void *zero = CALL(v, visit_integer_literal, 0);
+  void *truth = CALL(v, visit_binop, c->negated ? TOK_EQ_OP : TOK_NE_OP, c->value, zero);
+  if (!c->exits[0].labels_size && !c->exits[1].labels_size)
+    return truth;
+  void *ret = CALL(v, visit_declaration, &v->int_type, "condition"), *end_label = CALL0(v, new_label);
+  CALL(v, visit_assign, TOK_ASSIGN_OP, ret, truth);
+  for (int i = 1; i >= 0; i--) {
+    if (c->exits[i].labels_size) {
+      CALL(v, visit_jump, end_label);
+      place_label_set(cont, &c->exits[i]);
+      CALL(v, visit_assign, TOK_ASSIGN_OP, ret, CALL(v, visit_integer_literal, i));
+    }
+  }
+  place_forward_label(cont, end_label);
+  return ret;
+}
+
+/** The truth of c, which the constant evaluator parsed */
+static int constant_truth(ParserCont *cont, Condition *c) {
+  int64_t value;
+  THROW_IF(!get_integer_constant(condition_value(cont, c), &value), EXC_PARSE_SYNTAX,
+    "expected an integer constant expression");
+  return value != 0;
+}
+
+static void parse_expr_condition(ParserCont *cont, ParseControl *ctl, Condition *c);
+
+#define is_postfix_op(op) \
+  tok_is_in(op, TOK_LEFT_BRACKET, TOK_LEFT_PAREN, TOK_DOT_OP, TOK_PTR_OP, TOK_INC_OP, TOK_DEC_OP)
+
+/**
+ * Parse a unary expression as a condition, negated by each ! in front. One in parentheses stays a condition unless a
+ * postfix operator applies to it, which needs its value.
+ */
+static void parse_unary_condition(ParserCont *cont, ParseControl *ctl, Condition *c) {
   PRINT_ENTRY();
-  return parse_inclusive_or_expr(cont, ctl);
+  TokenKind op = ctl->primary ? TOK_ERROR : peek(cont).kind;
+  if (op == TOK_NOT_OP) {
+    consume(cont);
+    parse_unary_condition(cont, ctl, c);
+    negate_condition(c);
+    return;
+  }
+  if (op == TOK_LEFT_PAREN) {
+    consume(cont);
+    parse_expr_condition(cont, ctl, c);
+    EXPECT(cont, TOK_RIGHT_PAREN);
+    consume(cont);
+    if (!is_postfix_op(peek(cont).kind))
+      return;
+    ctl->primary = condition_value(cont, c);
+  }
+  *c = (Condition) { .value = parse_unary_expr(cont, ctl), .is_value = 1 };
 }
 
-void *parse_logical_or_expr(ParserCont *cont, ParseControl *ctl) {
+// The binary operators that bind more tightly than &&
+#define is_operand_binop(op) tok_is_in(op, TOK_STAR_OP, TOK_DIV_OP, TOK_MOD_OP, TOK_ADD_OP, TOK_SUB_OP, TOK_LEFT_OP, \
+  TOK_RIGHT_OP, TOK_LT_OP, TOK_RT_OP, TOK_LE_OP, TOK_GE_OP, TOK_EQ_OP, TOK_NE_OP, TOK_AMPERSAND_OP, TOK_XOR_OP, \
+  TOK_BIT_OR_OP)
+
+/** Parse an operand of &&, an inclusive OR expression, as a condition. */
+static void parse_operand_condition(ParserCont *cont, ParseControl *ctl, Condition *c) {
+  parse_unary_condition(cont, ctl, c);
+  if (is_operand_binop(peek(cont).kind)) {
+    ctl->primary = condition_value(cont, c);
+    *c = (Condition) { .value = parse_inclusive_or_expr(cont, ctl), .is_value = 1 };
+  }
+}
+
+typedef void (*ParseCondition)(ParserCont *cont, ParseControl *ctl, Condition *c);
+
+/**
+ * Parse operands joined by op, && or ||, as a condition. Each operand but the last jumps out where it decides them, as
+ * false for && and true for ||; the rest of its exits, and its fall through, go on to the next operand.
+ */
+static void parse_logical_operands(ParserCont *cont, ParseControl *ctl, TokenKind op, ParseCondition parse_operand,
+  Condition *c) {
   PRINT_ENTRY();
-  return parse_logical_and_expr(cont, ctl);
+  int decides = op == TOK_OR_OP;
+  parse_operand(cont, ctl, c);
+  while (peek(cont).kind == op) {
+    consume(cont);
+    Condition next = {0};
+    if (ctl->gen_constexpr) {
+      // Both operands are constants, so evaluating the second has no effect.
+      int truth = constant_truth(cont, c);
+      parse_operand(cont, ctl, &next);
+      truth = truth == decides ? truth : constant_truth(cont, &next);
+      *c = (Condition) { .value = CALL(cont->visitor, visit_integer_literal, truth), .is_value = 1 };
+      continue;
+    }
+    branch_on_value(cont, c, decides);
+    place_label_set(cont, &c->exits[!decides]);
+    parse_operand(cont, ctl, &next);
+    merge_label_sets(&c->exits[decides], &next.exits[decides]);
+    c->exits[!decides] = next.exits[!decides];
+    c->value = next.value;
+    c->negated = next.negated;
+    c->is_value = 0;
+  }
+}
+
+static void parse_and_condition(ParserCont *cont, ParseControl *ctl, Condition *c) {
+  parse_logical_operands(cont, ctl, TOK_AND_OP, parse_operand_condition, c);
 }
 
+/** Parse a logical OR expression as a condition. */
+static void parse_or_condition(ParserCont *cont, ParseControl *ctl, Condition *c) {
+  parse_logical_operands(cont, ctl, TOK_OR_OP, parse_and_condition, c);
+}
+
+/**
+ * Finish c with a branch to label where its truth is jump_if, falling through elsewhere. Operands that jumped out
+ * before it was known where went to labels of their own. If later is not NULL, those meaning label are added to it,
+ * for the caller to place along with label, which is not placed yet; otherwise label is placed, and they jump to it.
+ */
+static void branch_on_condition(ParserCont *cont, Condition *c, int jump_if, void *label, LabelSet *later) {
+  Visitor *v = cont->visitor;
+  LabelSet *others = &c->exits[jump_if];
+  if (!others->labels_size || later) {
+    CALL(v, visit_branch, c->value, jump_if != c->negated, label);
+    if (later) {
+      merge_label_sets(later, others);
+    }
+  } else {
+    void *skip_label = CALL0(v, new_label);
+    CALL(v, visit_branch, c->value, jump_if == c->negated, skip_label);
+    place_label_set(cont, others);
+    CALL(v, visit_jump, label);
+    place_forward_label(cont, skip_label);
+  }
+  place_label_set(cont, &c->exits[!jump_if]);
+}
+
+/** 6.5.15p5: the type of the result of a conditional operator with operands of the given types */
+static const Type *conditional_type(const Visitor *v, const Type *a, const Type *b) {
+  if (IS_PRIMITIVE_TYPE(a) && IS_PRIMITIVE_TYPE(b))
+    return common_arithmetic_type(v, a, b);
+  // A pointer and a null pointer constant, or two structures or unions of the same type
+  return b->kind == TY_POINTER && a->kind != TY_POINTER ? b : a;
+}
+
+/** Assign value to a local, which converts it to the local's type. */
+static void assign_converted(Visitor *v, void *local, void *value) {
+  const Type *type = v->type_of(local), *value_type = v->type_of(value);
+  if (IS_SCALAR_TYPE(type) && changes_representation(value_type, type)) {
+    value = CALL(v, convert_type, value, type);
+  }
+  CALL(v, visit_assign, TOK_ASSIGN_OP, local, value);
+}
+
+static void *parse_conditional_rest(ParserCont *cont, ParseControl *ctl, Condition *cond);
+
 void *parse_conditional_expr(ParserCont *cont, ParseControl *ctl) {
   PRINT_ENTRY();
-  return parse_logical_or_expr(cont, ctl);
+  Condition cond = {0};
+  parse_or_condition(cont, ctl, &cond);
+  return parse_conditional_rest(cont, ctl, &cond);
+}
+
+/**
+ * The rest of a conditional expression, after its condition, if there is a ? to follow it; else the condition's value.
+ * cond ? a : b branches around the operand not evaluated. Each assigns its value to a local the result is read from,
+ * converted to the type of the result. That is only known once both are parsed, so if the first one's type differs,
+ * it is converted after the second operand, which jumps past that:
+ *
+ *     if (!cond) goto else;  t = a; goto a_done;  else: r = b; goto end;  a_done: r = t;  end: ... r ...
+ *
+ * Otherwise t is the result, and a_done and end are where the second operand falls through to. The optimizing backend
+ * turns the branches into conditional moves if the operands are cheap and free of side effects.
+ */
+static void *parse_conditional_rest(ParserCont *cont, ParseControl *ctl, Condition *cond) {
+  PRINT_ENTRY();
+  if (peek(cont).kind != TOK_QUESTION_OP)
+    return condition_value(cont, cond);
+  consume(cont);
+  Visitor *v = cont->visitor;
+  ParseControl operand_ctl = { .gen_constexpr = ctl->gen_constexpr };
+  if (ctl->gen_constexpr) {
+    // Both operands are constants, so evaluating the one not chosen has no effect.
+    int truth = constant_truth(cont, cond);
+    void *a = parse_expr(cont, &operand_ctl);
+    EXPECT(cont, TOK_COLON_OP);
+    consume(cont);
+    void *b = parse_conditional_expr(cont, &operand_ctl);
+    return truth ? a : b;
+  }
+  void *else_label = CALL0(v, new_label), *a_done_label = CALL0(v, new_label);
+  LabelSet else_labels = {0};
+  branch_on_condition(cont, cond, 0, else_label, &else_labels);
+  void *a = parse_expr(cont, &operand_ctl);
+  const Type *a_type = v->type_of(a);
+  void *a_local = 0;
+  if (a_type->kind != TY_VOID) {
+    a_local = CALL(v, visit_declaration, a_type, "?:");
+    assign_converted(v, a_local, a);
+  }
+  CALL(v, visit_jump, a_done_label);
+  EXPECT(cont, TOK_COLON_OP);
+  consume(cont);
+  place_forward_label(cont, else_label);
+  place_label_set(cont, &else_labels);
+  void *b = parse_conditional_expr(cont, &operand_ctl);
+  const Type *b_type = v->type_of(b);
+  THROW_IF((a_type->kind == TY_VOID) != (b_type->kind == TY_VOID), EXC_PARSE_SYNTAX,
+    "only one operand of ?: is void");
+  if (!a_local) {
+    place_forward_label(cont, a_done_label);
+    return b;
+  }
+  const Type *type = conditional_type(v, a_type, b_type);
+  if (type == a_type) {
+    assign_converted(v, a_local, b);
+    place_forward_label(cont, a_done_label);
+    return a_local;
+  }
+  void *end_label = CALL0(v, new_label), *ret = CALL(v, visit_declaration, type, "?:");
+  assign_converted(v, ret, b);
+  CALL(v, visit_jump, end_label);
+  place_forward_label(cont, a_done_label);
+  assign_converted(v, ret, a_local);
+  place_forward_label(cont, end_label);
+  return ret;
+}
+
+/** Parse an integer constant expression (6.6p6) with the constant evaluator in place of the visitor. */
+int64_t parse_integer_constant_expr(ParserCont *cont) {
+  PRINT_ENTRY();
+  Visitor *visitor = cont->visitor;
+  cont->visitor = cont->constant_evaluator;
+  ParseControl ctl = { .gen_constexpr = 1 };
+  void *value = parse_conditional_expr(cont, &ctl);
+  cont->visitor = visitor;
+  int64_t ret;
+  THROW_IF(!get_integer_constant(value, &ret), EXC_PARSE_SYNTAX, "expected an integer constant expression");
+  return ret;
 }
 
 #define is_assignment_op(op) tok_is_in( \
@@ -336,7 +851,25 @@ void *parse_assignment_expr(ParserCont *cont, ParseControl *ctl) {
   consume(cont);
   assert(ctl->gen_lvalue);
   void *right = parse_assignment_expr(cont, ctl);
-  return CALL(cont->visitor, visit_assign, TOK_ASSIGN_OP, left, right);
+  return CALL(cont->visitor, visit_assign, op, left, right);
+}
+
+/**
+ * Parse an expression as a condition. If an operator that needs the value of a condition follows one, as ?:, a comma
+ * or an assignment does, the expression is parsed on from that value.
+ */
+static void parse_expr_condition(ParserCont *cont, ParseControl *ctl, Condition *c) {
+  PRINT_ENTRY();
+  ctl->gen_lvalue = 1;
+  parse_or_condition(cont, ctl, c);
+  if (peek(cont).kind == TOK_QUESTION_OP) {
+    *c = (Condition) { .value = parse_conditional_rest(cont, ctl, c), .is_value = 1 };
+  }
+  TokenKind op = peek(cont).kind;
+  if (op == TOK_COMMA || is_assignment_op(op)) {
+    ctl->primary = condition_value(cont, c);
+    *c = (Condition) { .value = parse_expr(cont, ctl), .is_value = 1 };
+  }
 }
 
 #define scalar_type_specifier_list TOK_void, TOK_char, TOK_short, TOK_int, TOK_long, TOK_float, TOK_double, \
@@ -489,7 +1022,7 @@ label_finish:
           case 2:  primitive_type = is_unsigned ? &v->unsigned_long_long_type : &v->long_long_type; break;
         }
         break;
-      case TOK_float: primitive_type = &v->float_type;
+      case TOK_float: primitive_type = &v->float_type; break;
       case TOK_double: primitive_type = parsed_long_short == 1 ? &v->long_double_type : &v->double_type; break;
       default: assert(0 && "Unreachable!");
     }
@@ -519,12 +1052,12 @@ void parse_array_declarator_rest(ParserCont *cont, Declarator *declarator) {
   consume(cont);
   declarator->kind = DC_ARRAY;
 
-  THROW_IF(peek(cont).kind != TOK_INTEGER_LITERAL, EXC_INTERNAL, "Only fixed size arrays supported for now.");
-  Token size_tok = peek(cont);
-  THROW_IF(size_tok.int64_val < 0, EXC_PARSE_SYNTAX, "array size must be nonnegative.");
-  consume(cont);
+  // Variable length arrays would be any other expression, so an identifier throws here for now.
+  int64_t size = parse_integer_constant_expr(cont);
+  THROW_IF(size < 0, EXC_PARSE_SYNTAX, "array size must be nonnegative.");
+  THROW_IF(size > INT32_MAX, EXC_PARSE_SYNTAX, "array size is too large.");
 
-  declarator->fixed_size = (int) size_tok.int64_val;
+  declarator->fixed_size = (int) size;
   EXPECT(cont, TOK_RIGHT_BRACKET);
   consume(cont);
 
@@ -816,6 +1349,7 @@ Type *parse_struct(ParserCont *cont) {
   Type *existing_type = lookup_type_norecur(tab, tag.string_id);
   if (!existing_type) { // not found
     insert_symbol(tab, tag.string_id, this_type);
+    note_declared(cont, tag.string_id);
     return this_type;
   }
   // found
@@ -837,10 +1371,8 @@ int parse_array_designator(ParserCont *cont) {
   PRINT_ENTRY();
   EXPECT(cont, TOK_LEFT_BRACKET);
   consume(cont);
-  // only constants, not constexpr, supported now
-  EXPECT(cont, TOK_INTEGER_LITERAL);
-  int ret = peek(cont).int64_val;
-  consume(cont);
+  int64_t ret = parse_integer_constant_expr(cont);
+  THROW_IF(ret < 0 || ret > INT32_MAX, EXC_PARSE_SYNTAX, "array designator out of range.");
   EXPECT(cont, TOK_RIGHT_BRACKET);
   consume(cont);
   return ret;
@@ -959,6 +1491,24 @@ Type *new_array_type(Type *base_type, const Declarator *declarator) {
   return ret;
 }
 
+/** Without a prototype, as declared by an identifier list, n_params is -1 and calls promote their arguments. */
+Type *new_function_type(Type *return_type, const Declarator *declarator) {
+  Type *ret = checked_calloc(1, sizeof(Type));
+  ret->kind = TY_FUNCTION;
+  ret->align = 1;
+  ret->return_type = return_type;
+  ret->n_params = -1;
+  if (declarator->kind == DC_FUNCTION) {
+    ret->n_params = declarator->n_params;
+    const Type **param_types = checked_calloc(declarator->n_params, sizeof(Type *));
+    for (int i = 0; i < declarator->n_params; i++) {
+      param_types[i] = new_type_from_declaration(declarator->param_decl_specs[i], declarator->param_declarators[i]);
+    }
+    ret->param_types = param_types;
+  }
+  return ret;
+}
+
 Type *new_type_from_declaration(DeclarationSpecifiers decl_specs, const Declarator *declarator) {
   Type *ret = 0;
   switch (declarator->kind) {
@@ -970,6 +1520,11 @@ Type *new_type_from_declaration(DeclarationSpecifiers decl_specs, const Declarat
       assert(IS_SCALAR_TYPE(decl_specs.base_type) && !decl_specs.base_type->child_type);
       ret = new_array_type(decl_specs.base_type, declarator);
       break;
+    case DC_FUNCTION:
+    case DC_KR_FUNCTION:
+      ret = new_function_type(decl_specs.base_type, declarator);
+      ret->is_noreturn = decl_specs.is_noreturn;
+      break;
     default:
       THROWF(EXC_INTERNAL, "Unsupported declarator kind %d", declarator->kind);
   }
@@ -980,9 +1535,16 @@ void *finish_declaration(ParserCont *cont, DeclarationSpecifiers decl_specs, Dec
   assert(!IS_ABSTRACT_DECLARATOR(declarator));
 
   Type *type = new_type_from_declaration(decl_specs, declarator);
+  if (type->kind == TY_FUNCTION) {
+    // Every declaration of a function, such as a prototype and then the definition, names the same one.
+    const Value *previous = lookup_value(cont->scope.values, declarator->ident_string_id);
+    if (previous && previous->type->kind == TY_FUNCTION)
+      return previous->value;
+  }
   void *declaration = CALL(cont->visitor, visit_declaration, type, declarator->ident);
   Value *value = new_value(type, declaration);
   insert_symbol(cont->scope.values, declarator->ident_string_id, value);
+  note_declared(cont, declarator->ident_string_id);
   fprintf(stderr, "DEBUG: Declared variable %s with string id %d in symtab %p\n",
     declarator->ident, declarator->ident_string_id, (void *) cont->scope.values);
   return declaration;
@@ -1025,6 +1587,29 @@ void parse_declaration_rest(ParserCont *cont, DeclarationSpecifiers decl_specs,
   }
 }
 
+#define is_static_assert_declaration_first(op) tok_is_in(op, TOK__Static_assert, TOK_static_assert)
+// 6.7.10: _Static_assert ( constant-expression , string-literal ) ;
+// The message is optional as in C23, which also spells the keyword static_assert.
+void parse_static_assert_declaration(ParserCont *cont) {
+  PRINT_ENTRY();
+  consume(cont);
+  EXPECT(cont, TOK_LEFT_PAREN);
+  consume(cont);
+  int64_t cond = parse_integer_constant_expr(cont);
+  const char *note = "";
+  if (peek(cont).kind == TOK_COMMA) {
+    consume(cont);
+    EXPECT(cont, TOK_STRING_LITERAL);
+    note = peek(cont).string_val;
+    consume(cont);
+  }
+  EXPECT(cont, TOK_RIGHT_PAREN);
+  consume(cont);
+  EXPECT(cont, TOK_SEMI);
+  consume(cont);
+  THROWF_IF(!cond, EXC_PARSE_SYNTAX, "static assertion failed: %s", note);
+}
+
 #define is_declaration_first(op) is_declaration_specifier_first(op)
 void parse_declaration(ParserCont *cont) {
   PRINT_ENTRY();
@@ -1057,7 +1642,7 @@ void parse_declaration(ParserCont *cont) {
 void *parse_expression_statement(ParserCont *cont) {
   PRINT_ENTRY();
   ParseControl ctl = {0};
-  void *expr = parse_expr(cont, &ctl);
+  void *expr = peek(cont).kind == TOK_SEMI ? 0 : parse_expr(cont, &ctl);  // or a null statement
   EXPECT(cont, TOK_SEMI);
   consume(cont);
   return expr;
@@ -1066,23 +1651,313 @@ void *parse_expression_statement(ParserCont *cont) {
 #define is_jump_statement_first(op) tok_is_in(op, TOK_goto, TOK_continue, TOK_break, TOK_return)
 void parse_jump_statement(ParserCont *cont) {
   TokenKind op = peek(cont).kind;
-  ParseControl ctl = { .gen_jump = 1 };
+  ParseControl ctl = {0};
   void *retval = 0;
   switch (op) {
     case TOK_return:
       consume(cont);
       if (peek(cont).kind != TOK_SEMI) {
         retval = parse_expr(cont, &ctl);
+        // 6.8.6.4: converted as if by assignment to the return type
+        const Type *type = cont->return_type;
+        if (IS_SCALAR_TYPE(type) && changes_representation(cont->visitor->type_of(retval), type)) {
+          retval = CALL(cont->visitor, convert_type, retval, type);
+        }
       }
       THROW_IF(peek(cont).kind != TOK_SEMI, EXC_PARSE_SYNTAX, "Expected ; after return");
       consume(cont);
       CALL(cont->visitor, visit_return, retval);
       break;
+    case TOK_break:
+    case TOK_continue: {
+      consume(cont);
+      void *label = 0;
+      if (cont->loops_size) {
+        LoopLabels loop = VECTOR_LAST(cont->loops);
+        label = op == TOK_break ? loop.break_label : loop.continue_label;
+      }
+      THROWF_IF(!label, EXC_PARSE_SYNTAX, "%s outside of a loop%s", TOKEN_NAMES[op],
+        op == TOK_break ? " or switch" : "");
+      EXPECT(cont, TOK_SEMI);
+      consume(cont);
+      CALL(cont->visitor, visit_jump, label);
+      break;
+    }
     default:
       THROWF(EXC_INTERNAL, "Unimplemented jump statement %s", TOKEN_NAMES[op]);
   }
 }
 
+void parse_statement(ParserCont *cont);
+
+/**
+ * Parse an expression, then branch to label if its value is nonzero and jump_if is set, or zero and it is not. && and
+ * || branch on each operand straight from its comparison, with no value of 0 or 1 computed, and ! swaps the targets.
+ * later is as for branch_on_condition.
+ */
+static void parse_branch(ParserCont *cont, int jump_if, void *label, LabelSet *later) {
+  ParseControl ctl = {0};
+  Condition cond = {0};
+  parse_expr_condition(cont, &ctl, &cond);
+  branch_on_condition(cont, &cond, jump_if, label, later);
+}
+
+void parse_switch_statement(ParserCont *cont);
+
+#define is_selection_statement_first(op) tok_is_in(op, TOK_if, TOK_switch)
+void parse_selection_statement(ParserCont *cont) {
+  PRINT_ENTRY();
+  if (peek(cont).kind == TOK_switch) {
+    parse_switch_statement(cont);
+    return;
+  }
+  assert(peek(cont).kind == TOK_if);
+  Visitor *v = cont->visitor;
+  consume(cont);
+  EXPECT(cont, TOK_LEFT_PAREN);
+  consume(cont);
+  void *else_label = CALL0(v, new_label);
+  LabelSet else_labels = {0};
+  parse_branch(cont, 0, else_label, &else_labels);
+  EXPECT(cont, TOK_RIGHT_PAREN);
+  consume(cont);
+  parse_statement(cont);
+  if (peek(cont).kind != TOK_else) {
+    place_forward_label(cont, else_label);
+    place_label_set(cont, &else_labels);
+    return;
+  }
+  consume(cont);
+  void *end_label = CALL0(v, new_label);
+  CALL(v, visit_jump, end_label);
+  place_forward_label(cont, else_label);
+  place_label_set(cont, &else_labels);
+  parse_statement(cont);
+  place_forward_label(cont, end_label);
+}
+
+/**
+ * The cases of a switch are only known once its body is parsed, so the dispatch to them goes after it, on the value of
+ * the controlling expression kept in a local:
+ *
+ *     t = value; goto dispatch;  body;  goto break;  dispatch: switch (t) to the case labels;  break:
+ *
+ * The backend lowers the dispatch to a jump table, bit tests or a tree of comparisons, by the number and spread of the
+ * cases.
+ */
+void parse_switch_statement(ParserCont *cont) {
+  PRINT_ENTRY();
+  Visitor *v = cont->visitor;
+  consume(cont);
+  EXPECT(cont, TOK_LEFT_PAREN);
+  consume(cont);
+  ParseControl ctl = {0};
+  void *value = parse_expr(cont, &ctl);
+  EXPECT(cont, TOK_RIGHT_PAREN);
+  consume(cont);
+  THROW_IF(v->type_of(value)->kind != TY_INTEGER, EXC_PARSE_SYNTAX, "switch on a value that is not an integer");
+  // 6.8.4.2p5: the integer promotions apply to the controlling expression, and each case converts to its type.
+  const Type *type = promoted_type(v, v->type_of(value));
+  void *local = CALL(v, visit_declaration, type, "switch");
+  assign_converted(v, local, value);
+  void *dispatch_label = CALL0(v, new_label), *break_label = CALL0(v, new_label);
+  CALL(v, visit_jump, dispatch_label);
+
+  LoopLabels loop = { .break_label = break_label, .continue_label = 0 };
+  if (cont->loops_size) {
+    loop.continue_label = VECTOR_LAST(cont->loops).continue_label;
+  }
+  SwitchLabels labels = { .type = type, .first_case = cont->cases_size };
+  APPEND_VECTOR(cont->loops, loop);
+  APPEND_VECTOR(cont->switches, labels);
+  parse_statement(cont);
+  labels = VECTOR_LAST(cont->switches);
+  POP_VECTOR_VOID(cont->switches);
+  POP_VECTOR_VOID(cont->loops);
+  CALL(v, visit_jump, break_label);
+
+  place_forward_label(cont, dispatch_label);
+  int n_cases = cont->cases_size - labels.first_case;
+  int64_t *values = checked_calloc(n_cases + 1, sizeof(int64_t));
+  void **case_labels = checked_calloc(n_cases + 1, sizeof(void *));
+  for (int i = 0; i < n_cases; i++) {
+    values[i] = cont->cases[labels.first_case + i].value;
+    case_labels[i] = cont->cases[labels.first_case + i].label;
+  }
+  void *default_label = labels.default_label ? labels.default_label : break_label;
+  CALL(v, visit_switch, local, n_cases, values, case_labels, default_label);
+  // Each label of the body gets its last jump from the dispatch. Labels in a row share one, so it is sealed once.
+  int default_is_case = 0;
+  for (int i = 0; i < n_cases; i++) {
+    if (!i || case_labels[i] != case_labels[i - 1]) {
+      CALL(v, seal_label, case_labels[i]);
+    }
+    default_is_case |= case_labels[i] == labels.default_label;
+  }
+  if (labels.default_label && !default_is_case) {
+    CALL(v, seal_label, labels.default_label);
+  }
+  place_forward_label(cont, break_label);
+  cont->cases_size = labels.first_case;
+  free(values);
+  free(case_labels);
+}
+
+/** The value of a case label converted to type, a promoted integer type */
+static int64_t convert_case_value(const Type *type, int64_t value) {
+  if (type->size == 8)
+    return value;
+  return type->is_unsigned ? (int64_t) (uint32_t) value : (int64_t) (int32_t) value;
+}
+
+/**
+ * case and default labels, of the innermost switch. Labels in a row mark the same place, which the switch then knows
+ * its cases share.
+ */
+#define is_labeled_statement_first(op) tok_is_in(op, TOK_case, TOK_default)
+void parse_labeled_statement(ParserCont *cont) {
+  PRINT_ENTRY();
+  Visitor *v = cont->visitor;
+  void *label = CALL0(v, new_label);
+  while (is_labeled_statement_first(peek(cont).kind)) {
+    TokenKind op = peek(cont).kind;
+    consume(cont);
+    THROWF_IF(!cont->switches_size, EXC_PARSE_SYNTAX, "%s label outside of a switch", TOKEN_NAMES[op]);
+    SwitchLabels *labels = &VECTOR_LAST(cont->switches);
+    if (op == TOK_default) {
+      THROW_IF(labels->default_label, EXC_PARSE_SYNTAX, "multiple default labels in one switch");
+      labels->default_label = label;
+    } else {
+      CaseLabel case_label = { .value = convert_case_value(labels->type, parse_integer_constant_expr(cont)) };
+      case_label.label = label;
+      for (int i = labels->first_case; i < cont->cases_size; i++) {
+        THROWF_IF(cont->cases[i].value == case_label.value, EXC_PARSE_SYNTAX, "duplicate case value %lld",
+          (long long) case_label.value);
+      }
+      APPEND_VECTOR(cont->cases, case_label);
+    }
+    EXPECT(cont, TOK_COLON_OP);
+    consume(cont);
+  }
+  CALL(v, visit_label, label);
+  parse_statement(cont);
+}
+
+/** Parse the body of a loop, with break and continue jumping to the given labels. */
+static void parse_loop_body(ParserCont *cont, void *break_label, void *continue_label) {
+  LoopLabels loop = { .break_label = break_label, .continue_label = continue_label };
+  APPEND_VECTOR(cont->loops, loop);
+  parse_statement(cont);
+  POP_VECTOR_VOID(cont->loops);
+}
+
+/** Consume tokens up to, not including, the right parenthesis closing an already consumed left one. */
+static void skip_parenthesized_rest(ParserCont *cont) {
+  for (int depth = 1;;) {
+    switch (peek(cont).kind) {
+      case TOK_LEFT_PAREN: depth++; break;
+      case TOK_RIGHT_PAREN: depth--; break;
+      default: break;
+    }
+    if (!depth)
+      return;
+    consume(cont);
+  }
+}
+
+/**
+ * Loops are emitted rotated, testing the condition at the bottom where it jumps back to the top of the body, with
+ * another test in front to skip a loop that runs zero times:
+ *
+ *     if (!cond) goto break;  top: body; continue: step; if (cond) goto top;  break:
+ *
+ * Each iteration then takes a single branch, and the code in front of the top runs only if the body will, which is
+ * where invariant code can be moved. The condition is parsed twice, and the step of a for loop after the body, by
+ * rewinding the parser.
+ */
+#define is_iteration_statement_first(op) tok_is_in(op, TOK_while, TOK_do, TOK_for)
+void parse_iteration_statement(ParserCont *cont) {
+  PRINT_ENTRY();
+  Visitor *v = cont->visitor;
+  TokenKind op = peek(cont).kind;
+  consume(cont);
+  void *top_label = CALL0(v, new_label), *continue_label = CALL0(v, new_label), *break_label = CALL0(v, new_label);
+  ParserMark cond = {0}, step = {0};
+  LabelSet break_labels = {0};
+  int has_cond = 1;
+  switch (op) {
+    case TOK_while:
+      EXPECT(cont, TOK_LEFT_PAREN);
+      consume(cont);
+      cond = mark_parser(cont);
+      parse_branch(cont, 0, break_label, &break_labels);
+      EXPECT(cont, TOK_RIGHT_PAREN);
+      consume(cont);
+      break;
+    case TOK_for:
+      EXPECT(cont, TOK_LEFT_PAREN);
+      consume(cont);
+      push_scope(cont);
+      if (is_declaration_first(peek(cont).kind)) {
+        parse_declaration(cont);
+      } else {
+        parse_expression_statement(cont);
+      }
+      cond = mark_parser(cont);
+      has_cond = peek(cont).kind != TOK_SEMI;
+      if (has_cond) {
+        parse_branch(cont, 0, break_label, &break_labels);
+      }
+      EXPECT(cont, TOK_SEMI);
+      consume(cont);
+      step = mark_parser(cont);
+      skip_parenthesized_rest(cont);
+      consume(cont);
+      break;
+    case TOK_do:
+      break;
+    default:
+      THROWF(EXC_INTERNAL, "Unimplemented iteration statement %s", TOKEN_NAMES[op]);
+  }
+
+  CALL(v, visit_label, top_label);
+  parse_loop_body(cont, break_label, continue_label);
+  place_forward_label(cont, continue_label);
+  ParserMark end = mark_parser(cont);
+  if (op == TOK_do) {
+    EXPECT(cont, TOK_while);
+    consume(cont);
+    EXPECT(cont, TOK_LEFT_PAREN);
+    consume(cont);
+    parse_branch(cont, 1, top_label, 0);
+    EXPECT(cont, TOK_RIGHT_PAREN);
+    consume(cont);
+    EXPECT(cont, TOK_SEMI);
+    consume(cont);
+  } else {
+    if (op == TOK_for) {
+      reset_parser(cont, step);
+      if (peek(cont).kind != TOK_RIGHT_PAREN) {
+        ParseControl ctl = {0};
+        parse_expr(cont, &ctl);
+      }
+    }
+    if (has_cond) {
+      reset_parser(cont, cond);
+      parse_branch(cont, 1, top_label, 0);
+    } else {
+      CALL(v, visit_jump, top_label);
+    }
+    reset_parser(cont, end);
+  }
+  CALL(v, seal_label, top_label);
+  place_forward_label(cont, break_label);
+  place_label_set(cont, &break_labels);
+  if (op == TOK_for) {
+    pop_scope(cont);
+  }
+}
+
 void parse_compound_statement(ParserCont *cont);
 
 #define is_compound_statement_first(op) tok_is_in(op, TOK_LEFT_BRACE)
@@ -1091,8 +1966,14 @@ void parse_statement(ParserCont *cont) {
   TokenKind op = peek(cont).kind;
   if (is_compound_statement_first(op)) {
     parse_compound_statement(cont);
+  } else if (is_selection_statement_first(op)) {
+    parse_selection_statement(cont);
+  } else if (is_iteration_statement_first(op)) {
+    parse_iteration_statement(cont);
   } else if (is_jump_statement_first(op)) {
     parse_jump_statement(cont);
+  } else if (is_labeled_statement_first(op)) {
+    parse_labeled_statement(cont);
   } else {
     parse_expression_statement(cont);
   }
@@ -1101,7 +1982,14 @@ void parse_statement(ParserCont *cont) {
 void parse_block_item(ParserCont *cont) {
   PRINT_ENTRY()
   TokenKind op = peek(cont).kind;
-  CALL(cont->visitor, emit_comment, "%s:%d", peek(cont).filename, peek(cont).line_start + 1);
+  // Line numbers would tie cached function text to its position in the file.
+  if (!cont->cache) {
+    CALL(cont->visitor, emit_comment, "%s:%d", peek(cont).filename, peek(cont).line_start + 1);
+  }
+  if (is_static_assert_declaration_first(op)) {
+    parse_static_assert_declaration(cont);
+    return;
+  }
   if (is_declaration_first(op)) {
     fprintf(stderr, "parse_block_item saw %s; parsing as declaration\n", TOKEN_NAMES[op]);
     parse_declaration(cont);
@@ -1171,10 +2059,45 @@ void parse_kr_function_declaration_list(ParserCont *cont, Declarator *func_decla
   }
 }
 
+/**
+ * Record where a function body starts, then skip to its closing brace without tokenizing or visiting it, so
+ * declarations-only consumers pay for declarations only. The lookahead token was already scanned, so start the brace
+ * count from it.
+ */
+void defer_function_body(ParserCont *cont, DeclarationSpecifiers decl_specs, Declarator *func_declarator) {
+  PRINT_ENTRY();
+  DeferredFunction deferred = {
+    .decl_specs = decl_specs,
+    .declarator = func_declarator,
+    .scope = cont->scope,
+    .body = mark_parser(cont),
+  };
+  APPEND_VECTOR(cont->deferred_functions, deferred);
+
+  int depth;
+  switch (peek(cont).kind) {
+    case TOK_RIGHT_BRACE: depth = 0; break;
+    case TOK_LEFT_BRACE: depth = 2; break;
+    default: depth = 1; break;
+  }
+  skip_braced(cont->scont, depth);
+  cont->token = consume_next_token(cont->scont);
+}
+
 void parse_function_definition_rest(ParserCont *cont, DeclarationSpecifiers decl_specs, Declarator *func_declarator) {
   PRINT_ENTRY();
   assert(func_declarator->kind == DC_FUNCTION || func_declarator->kind == DC_KR_FUNCTION);
-  CALL(cont->visitor, visit_function_definition_start, func_declarator->ident);
+  if (cont->skip_function_bodies) {
+    defer_function_body(cont, decl_specs, func_declarator);
+    return;
+  }
+  const Type *type = new_type_from_declaration(decl_specs, func_declarator);
+  FunctionSpecifiers specifiers = {
+    .is_inline = decl_specs.is_inline,
+    .is_static = decl_specs.storage_class == SC_STATIC,
+  };
+  CALL(cont->visitor, visit_function_definition_start, func_declarator->ident, type, specifiers);
+  cont->return_type = type->return_type;
   push_scope(cont);
   for (int i = 0; i < func_declarator->n_params; i++) {
     DeclarationSpecifiers param_decl_specs = func_declarator->param_decl_specs[i];
@@ -1196,12 +2119,93 @@ void parse_function_definition_rest(ParserCont *cont, DeclarationSpecifiers decl
   return;
 }
 
-// both external 
+int n_deferred_function_bodies(const ParserCont *cont) {
+  return cont->deferred_functions_size;
+}
+
+int parse_deferred_function_body(ParserCont *cont, const char *ident) {
+  for (int i = 0; i < cont->deferred_functions_size; i++) {
+    DeferredFunction *deferred = &cont->deferred_functions[i];
+    if (strcmp(deferred->declarator->ident, ident) != 0)
+      continue;
+
+    // Parse in the scope the definition appeared in, then come back to where we were.
+    ParserMark resume = mark_parser(cont);
+    Scope scope = cont->scope;
+    int skip = cont->skip_function_bodies;
+    cont->scope = deferred->scope;
+    cont->skip_function_bodies = 0;
+    reset_parser(cont, deferred->body);
+    parse_function_definition_rest(cont, deferred->decl_specs, deferred->declarator);
+    cont->skip_function_bodies = skip;
+    cont->scope = scope;
+    reset_parser(cont, resume);
+    return 1;
+  }
+  return 0;
+}
+
+/** Consume tokens up to and including the right brace matching an already consumed left brace. */
+void skip_braced_rest(ParserCont *cont) {
+  for (int depth = 1; depth > 0; ) {
+    switch (peek(cont).kind) {
+      case TOK_LEFT_BRACE: depth++; break;
+      case TOK_RIGHT_BRACE: depth--; break;
+      default: break;
+    }
+    consume(cont);
+  }
+}
+
+/**
+ * Like parse_function_definition_rest, but reuse the emitted text of an identical earlier compilation. We are just
+ * past the opening brace: skip to the matching brace to finish hashing the definition, then rewind and parse the body
+ * only on a cache miss.
+ */
+void parse_cached_function_definition_rest(
+  ParserCont *cont,
+  DeclarationSpecifiers decl_specs,
+  Declarator *func_declarator
+) {
+  PRINT_ENTRY();
+  ParserMark body = mark_parser(cont);
+  skip_braced_rest(cont);
+  ParserMark end = mark_parser(cont);
+  stop_recording(cont);
+
+  uint64_t key = function_cache_key(cont->cache, recorded_hash(cont));
+  // Callers depend on the whole definition, not just the signature, so that later inlining stays correct.
+  set_decl_hash(cont, func_declarator->ident_string_id, key);
+
+  char *text = function_cache_lookup(cont->cache, key);
+  if (text) {
+    CALL(cont->visitor, visit_cached_function, text);
+    free(text);
+    return;
+  }
+  reset_parser(cont, body);
+  parse_function_definition_rest(cont, decl_specs, func_declarator);
+  assert(peek(cont).pos_start == end.token.pos_start);
+
+  const char *emitted = CALL0(cont->visitor, function_text);
+  if (emitted) {
+    function_cache_store(cont->cache, key, emitted);
+  }
+}
+
+// both external
 // An external declaration can be a declaration or a function definition. Both of them start with
 //   declaration_specifiers declarator
 // and then if the next token is a left brace, we know we have a function definition.
 void parse_external_declaration(ParserCont *cont) {
   PRINT_ENTRY();
+  if (is_static_assert_declaration_first(peek(cont).kind)) {
+    parse_static_assert_declaration(cont);
+    return;
+  }
+  if (cont->cache) {
+    start_recording(cont);
+  }
   DeclarationSpecifiers decl_specs = parse_declaration_specifiers(cont);
   Declarator *first_declarator = parse_declarator_or_abstract_declarator(cont);
 
@@ -1211,9 +2215,22 @@ void parse_external_declaration(ParserCont *cont) {
 
   if (peek(cont).kind == TOK_LEFT_BRACE) {
     consume(cont);
-    parse_function_definition_rest(cont, decl_specs, first_declarator);
-  } else {
-    parse_declaration_rest(cont, decl_specs, first_declarator);
+    // In scope in its own body, for recursion, and in the rest of the file
+    finish_declaration(cont, decl_specs, first_declarator);
+    if (cont->cache && !cont->skip_function_bodies) {
+      parse_cached_function_definition_rest(cont, decl_specs, first_declarator);
+    } else {
+      parse_function_definition_rest(cont, decl_specs, first_declarator);
+    }
+    return;
+  }
+  parse_declaration_rest(cont, decl_specs, first_declarator);
+  if (cont->cache) {
+    stop_recording(cont);
+    uint64_t h = recorded_hash(cont);
+    for (int i = 0; i < cont->recorder.declared_size; i++) {
+      set_decl_hash(cont, cont->recorder.declared[i], h);
+    }
   }
 }
 
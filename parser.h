@@ -4,8 +4,19 @@
 
 typedef struct Visitor Visitor;
 typedef struct ParserCont ParserCont;
+typedef struct FunctionCache FunctionCache;
 
 ParserCont *new_parser_cont(FILE *in, const char *filename, Visitor *visitor);
+/** Reuse emitted code for function definitions found in cache. Source line comments are not emitted. */
+void set_function_cache(ParserCont *cont, FunctionCache *cache);
+/**
+ * Declarations-only mode: record where each function body starts and skip it by brace matching, without visiting it.
+ * Skipped bodies can be parsed on demand with parse_deferred_function_body.
+ */
+void set_skip_function_bodies(ParserCont *cont, int skip);
+int n_deferred_function_bodies(const ParserCont *cont);
+/** Visit the skipped body of function ident, then resume where the parser was. Returns 0 if there is no such body. */
+int parse_deferred_function_body(ParserCont *cont, const char *ident);
 // TODO: Expose methods to parse strings for testing
 void parse_translation_unit(ParserCont *cont);
 void init_parser_module();
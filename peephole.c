@@ -0,0 +1,860 @@
+#include "peephole.h"
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+
+// Registers, numbered as in the instruction encoding
+enum { RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15, N_REGS };
+#define BIT(r) ((uint32_t) 1 << (r))
+#define ALL_REGS (BIT(N_REGS) - 1)
+#define CALLER_SAVED (BIT(RAX) | BIT(RCX) | BIT(RDX) | BIT(RSI) | BIT(RDI) | BIT(R8) | BIT(R9) | BIT(R10) | BIT(R11))
+#define ARGUMENT_REGS (BIT(RDI) | BIT(RSI) | BIT(RDX) | BIT(RCX) | BIT(R8) | BIT(R9))
+#define LIVE_AT_RETURN ((ALL_REGS & ~CALLER_SAVED) | BIT(RAX) | BIT(RDX))
+
+static const char *reg_names[9][N_REGS] = {
+  [1] = {"al", "cl", "dl", "bl", "spl", "bpl", "sil", "dil",
+         "r8b", "r9b", "r10b", "r11b", "r12b", "r13b", "r14b", "r15b"},
+  [2] = {"ax", "cx", "dx", "bx", "sp", "bp", "si", "di",
+         "r8w", "r9w", "r10w", "r11w", "r12w", "r13w", "r14w", "r15w"},
+  [4] = {"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi",
+         "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d"},
+  [8] = {"rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+         "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"},
+};
+
+static const char *RULE_NAMES[] = {
+#define X(name, description) description,
+  PEEPHOLE_RULES(X)
+#undef X
+};
+
+typedef enum {
+  OPERAND_REG,
+  OPERAND_IMM,
+  OPERAND_MEM,
+} OperandKind;
+
+typedef struct {
+  OperandKind kind;
+  int reg;  ///< for OPERAND_REG
+  int size;  ///< for OPERAND_REG: bytes of the register named
+  uint32_t address_regs;  ///< for OPERAND_MEM: registers the address is computed from
+  const char *text;
+} Operand;
+
+typedef enum {
+  LINE_INSN,
+  LINE_COMMENT,  ///< comments and blank lines, which the rules look through
+  LINE_BOUNDARY,  ///< labels and directives, which end a basic block
+} LineKind;
+
+typedef enum {
+  I_OTHER,  ///< not understood: assumed to use every register, flags and memory
+  I_MOV,
+  I_MOVX,  ///< mov with sign or zero extension
+  I_LEA,
+  I_ALU,
+  I_SHIFT,
+  I_CMP,  ///< cmp and test, which only set flags
+  I_UNARY,
+  I_SETCC,
+  I_CMOV,
+  I_JCC,
+  I_JMP,
+  I_CALL,
+  I_RET,
+  I_LEAVE,
+  I_PUSH,
+  I_POP,
+  I_CONVERT,  ///< cltd and friends, extending the accumulator into rdx
+  I_EXTEND_ACCUM,  ///< cltq and friends, extending the accumulator in place
+  I_DIV,
+} InsnKind;
+
+typedef struct {
+  LineKind line_kind;
+  const char *text;  ///< the line as read, without its newline; rebuilt if the instruction is rewritten
+  const char *mnemonic;
+  const char *comment;  ///< what follows the '#', if any
+  int n_operands;
+  Operand operands[3];
+
+  InsnKind kind;
+  int size;  ///< operand size from the mnemonic suffix, or 0
+  int mem_size;  ///< bytes accessed through the memory operand
+  int mem_operand;  ///< index of the memory operand, or -1
+  int reads_memory, writes_memory;  ///< through the memory operand
+  int barrier;  ///< may read and write any memory
+  uint32_t uses, defs;  ///< registers read and written; a partial write counts as both
+  int reads_flags, writes_flags;
+  int deleted, rewritten;
+} Insn;
+
+typedef struct {
+  Insn *insns;
+  int n_insns;
+  PeepholeStats *stats;
+} Peephole;
+
+static int find_reg(const char *name, int len, int *size) {
+  static const char *high_bytes[] = {"ah", "ch", "dh", "bh"};
+  for (int s = 1; s <= 8; s *= 2) {
+    for (int r = 0; r < N_REGS; r++) {
+      if ((int) strlen(reg_names[s][r]) == len && !strncmp(reg_names[s][r], name, len)) {
+        *size = s;
+        return r;
+      }
+    }
+  }
+  for (int r = 0; r < 4; r++) {
+    if (len == 2 && !strncmp(high_bytes[r], name, 2)) {
+      *size = 1;
+      return r;
+    }
+  }
+  return -1;
+}
+
+/** Parse one operand; return 0 if it is beyond what the rules understand. */
+static int parse_operand(const char *text, Operand *ret) {
+  *ret = (Operand) { .text = text };
+  if (text[0] == '$') {
+    ret->kind = OPERAND_IMM;
+    return 1;
+  }
+  if (text[0] == '%') {
+    ret->kind = OPERAND_REG;
+    ret->reg = find_reg(text + 1, strlen(text + 1), &ret->size);
+    return ret->reg >= 0;
+  }
+  if (text[0] == '*')
+    return 0;
+  ret->kind = OPERAND_MEM;
+  for (const char *p = strchr(text, '%'); p; p = strchr(p + 1, '%')) {
+    int len = 0, size;
+    while (isalnum(p[1 + len])) {
+      len++;
+    }
+    if (len == 3 && !strncmp(p + 1, "rip", 3))
+      continue;
+    int reg = find_reg(p + 1, len, &size);
+    if (reg < 0)
+      return 0;
+    ret->address_regs |= BIT(reg);
+  }
+  return 1;
+}
+
+static int suffix_size(char suffix) {
+  switch (suffix) {
+    case 'b': return 1;
+    case 'w': return 2;
+    case 'l': return 4;
+    case 'q': return 8;
+    default: return 0;
+  }
+}
+
+/** Whether mnemonic is base followed by a size suffix, which is stored in size */
+static int has_base(const char *mnemonic, const char *base, int *size) {
+  size_t len = strlen(base);
+  if (strncmp(mnemonic, base, len))
+    return 0;
+  if (!mnemonic[len]) {
+    *size = 0;
+    return 1;
+  }
+  *size = suffix_size(mnemonic[len]);
+  return *size && !mnemonic[len + 1];
+}
+
+static const struct {
+  const char *base;
+  InsnKind kind;
+} MNEMONICS[] = {
+  {"movabs", I_MOV}, {"mov", I_MOV}, {"lea", I_LEA},
+  {"add", I_ALU}, {"sub", I_ALU}, {"imul", I_ALU}, {"mul", I_ALU}, {"and", I_ALU}, {"or", I_ALU}, {"xor", I_ALU},
+  {"adc", I_ALU}, {"sbb", I_ALU},
+  {"shl", I_SHIFT}, {"sal", I_SHIFT}, {"shr", I_SHIFT}, {"sar", I_SHIFT}, {"rol", I_SHIFT}, {"ror", I_SHIFT},
+  {"cmp", I_CMP}, {"test", I_CMP},
+  {"neg", I_UNARY}, {"not", I_UNARY}, {"inc", I_UNARY}, {"dec", I_UNARY},
+  {"idiv", I_DIV}, {"div", I_DIV},
+  {"push", I_PUSH}, {"pop", I_POP},
+  {"call", I_CALL}, {"ret", I_RET}, {"leave", I_LEAVE}, {"jmp", I_JMP},
+  {"cltd", I_CONVERT}, {"cdq", I_CONVERT}, {"cqto", I_CONVERT}, {"cqo", I_CONVERT}, {"cwtd", I_CONVERT},
+  {"cwd", I_CONVERT},
+  {"cltq", I_EXTEND_ACCUM}, {"cdqe", I_EXTEND_ACCUM}, {"cwtl", I_EXTEND_ACCUM}, {"cwde", I_EXTEND_ACCUM},
+  {"cbtw", I_EXTEND_ACCUM}, {"cbw", I_EXTEND_ACCUM},
+};
+
+static void classify(Insn *insn) {
+  const char *m = insn->mnemonic;
+  int len = strlen(m);
+  insn->kind = I_OTHER;
+  if ((!strncmp(m, "movs", 4) || !strncmp(m, "movz", 4)) && len == 6 && suffix_size(m[4]) && suffix_size(m[5])) {
+    insn->kind = I_MOVX;
+    insn->size = suffix_size(m[5]);
+    insn->mem_size = suffix_size(m[4]);
+    return;
+  }
+  for (size_t i = 0; i < sizeof(MNEMONICS) / sizeof(MNEMONICS[0]); i++) {
+    if (has_base(m, MNEMONICS[i].base, &insn->size)) {
+      insn->kind = MNEMONICS[i].kind;
+      insn->mem_size = insn->size;
+      return;
+    }
+  }
+  if (!strncmp(m, "set", 3)) {
+    insn->kind = I_SETCC;
+    insn->size = insn->mem_size = 1;
+  } else if (!strncmp(m, "cmov", 4)) {
+    insn->kind = I_CMOV;
+    insn->size = insn->mem_size = suffix_size(m[len - 1]);
+  } else if (m[0] == 'j') {
+    insn->kind = I_JCC;
+  }
+}
+
+/** Record that operand k is read and/or written, by an access of size bytes for registers. */
+static void note_access(Insn *insn, int k, int read, int write, int size) {
+  Operand *op = &insn->operands[k];
+  switch (op->kind) {
+    case OPERAND_REG:
+      if (read || (write && size < 4)) {  // writing a byte or a word keeps the rest of the register
+        insn->uses |= BIT(op->reg);
+      }
+      if (write) {
+        insn->defs |= BIT(op->reg);
+      }
+      break;
+    case OPERAND_MEM:
+      insn->mem_operand = k;
+      insn->reads_memory |= read;
+      insn->writes_memory |= write;
+      break;
+    case OPERAND_IMM:
+      break;
+  }
+}
+
+/** Work out what insn reads and writes from its mnemonic and operands. */
+static void analyze(Insn *insn) {
+  insn->uses = insn->defs = 0;
+  insn->mem_operand = -1;
+  insn->reads_memory = insn->writes_memory = insn->barrier = 0;
+  insn->reads_flags = insn->writes_flags = 0;
+  classify(insn);
+  for (int k = 0; k < insn->n_operands; k++) {
+    if (!parse_operand(insn->operands[k].text, &insn->operands[k])) {
+      insn->kind = I_OTHER;
+    }
+    insn->uses |= insn->operands[k].address_regs;
+  }
+
+  int n = insn->n_operands;
+  switch (insn->kind) {
+    case I_MOV:
+    case I_MOVX:
+      if (n != 2)
+        break;
+      note_access(insn, 0, 1, 0, insn->size);
+      note_access(insn, 1, 0, 1, insn->size);
+      return;
+    case I_LEA:
+      if (n != 2 || insn->operands[0].kind != OPERAND_MEM)
+        break;
+      note_access(insn, 1, 0, 1, insn->size);
+      return;
+    case I_ALU:
+      insn->writes_flags = 1;
+      insn->reads_flags = !strncmp(insn->mnemonic, "adc", 3) || !strncmp(insn->mnemonic, "sbb", 3);
+      if (n == 2) {
+        note_access(insn, 0, 1, 0, insn->size);
+        note_access(insn, 1, 1, 1, insn->size);
+        return;
+      }
+      if (n == 1) {  // imul or mul src: rdx:rax = rax * src
+        note_access(insn, 0, 1, 0, insn->size);
+        insn->uses |= BIT(RAX);
+        insn->defs |= BIT(RAX) | BIT(RDX);
+        return;
+      }
+      if (n == 3) {  // imul $imm, src, dst
+        note_access(insn, 1, 1, 0, insn->size);
+        note_access(insn, 2, 0, 1, insn->size);
+        return;
+      }
+      break;
+    case I_SHIFT:
+      // A shift by zero leaves the flags alone, so the old flags may survive.
+      insn->reads_flags = insn->writes_flags = 1;
+      if (n == 1 || n == 2) {
+        if (n == 2) {
+          note_access(insn, 0, 1, 0, 1);
+        }
+        note_access(insn, n - 1, 1, 1, insn->size);
+        return;
+      }
+      break;
+    case I_CMP:
+      insn->writes_flags = 1;
+      if (n != 2)
+        break;
+      note_access(insn, 0, 1, 0, insn->size);
+      note_access(insn, 1, 1, 0, insn->size);
+      return;
+    case I_UNARY:
+      insn->writes_flags = strncmp(insn->mnemonic, "not", 3) != 0;
+      if (n != 1)
+        break;
+      note_access(insn, 0, 1, 1, insn->size);
+      return;
+    case I_SETCC:
+      insn->reads_flags = 1;
+      if (n != 1)
+        break;
+      note_access(insn, 0, 0, 1, 1);
+      return;
+    case I_CMOV:
+      insn->reads_flags = 1;
+      if (n != 2)
+        break;
+      note_access(insn, 0, 1, 0, insn->size);
+      note_access(insn, 1, 1, 1, insn->size);
+      return;
+    case I_JCC:
+      insn->reads_flags = 1;
+      if (n == 1 && insn->operands[0].kind == OPERAND_MEM && !insn->operands[0].address_regs) {
+        insn->mem_operand = -1;  // a label, not a load
+        return;
+      }
+      break;
+    case I_JMP:
+      if (n == 1 && insn->operands[0].kind == OPERAND_MEM && !insn->operands[0].address_regs)
+        return;
+      break;
+    case I_CALL:
+      if (n != 1)
+        break;
+      // R10 as well: a callee whose clobbers the backend knows may leave it holding a value live across the call.
+      insn->uses |= ARGUMENT_REGS | BIT(R10) | BIT(RAX) | BIT(RSP);
+      insn->defs |= CALLER_SAVED;
+      insn->barrier = 1;
+      insn->writes_flags = 1;
+      insn->mem_operand = -1;
+      return;
+    case I_RET:
+      insn->uses |= LIVE_AT_RETURN;
+      return;
+    case I_LEAVE:
+      // Restores the caller's rbp, which no rule touches.
+      insn->uses |= BIT(RBP);
+      insn->defs |= BIT(RBP) | BIT(RSP);
+      return;
+    case I_PUSH:
+      if (n != 1)
+        break;
+      note_access(insn, 0, 1, 0, 8);
+      insn->uses |= BIT(RSP);
+      insn->defs |= BIT(RSP);
+      return;
+    case I_POP:
+      if (n != 1 || insn->operands[0].kind != OPERAND_REG)
+        break;
+      note_access(insn, 0, 0, 1, 8);
+      insn->uses |= BIT(RSP);
+      insn->defs |= BIT(RSP);
+      insn->reads_memory = 1;  // the top of the stack, which may be a register saved below rbp
+      return;
+    case I_CONVERT:
+      insn->uses |= BIT(RAX);
+      insn->defs |= BIT(RDX);
+      return;
+    case I_EXTEND_ACCUM:
+      insn->uses |= BIT(RAX);
+      insn->defs |= BIT(RAX);
+      return;
+    case I_DIV:
+      insn->writes_flags = 1;
+      if (n != 1)
+        break;
+      insn->uses |= BIT(RAX) | BIT(RDX);
+      insn->defs |= BIT(RAX) | BIT(RDX);
+      note_access(insn, 0, 1, 0, insn->size);
+      return;
+    case I_OTHER:
+      break;
+  }
+  insn->kind = I_OTHER;
+  insn->uses = insn->defs = ALL_REGS;
+  insn->barrier = insn->reads_flags = insn->writes_flags = 1;
+}
+
+static char *trim(const char *start, const char *end) {
+  while (start < end && isspace(*start)) {
+    start++;
+  }
+  while (end > start && isspace(end[-1])) {
+    end--;
+  }
+  return fmtstr("%.*s", (int) (end - start), start);
+}
+
+static Insn parse_line(const char *line) {
+  Insn ret = { .text = line, .line_kind = LINE_COMMENT };
+  const char *p = line;
+  while (*p == ' ' || *p == '\t') {
+    p++;
+  }
+  if (!*p || *p == '#')
+    return ret;
+  if (p == line || *p == '.') {
+    ret.line_kind = LINE_BOUNDARY;
+    return ret;
+  }
+
+  ret.line_kind = LINE_INSN;
+  const char *end = p;
+  while (*end && !isspace(*end)) {
+    end++;
+  }
+  ret.mnemonic = trim(p, end);
+  const char *comment = strchr(end, '#');
+  if (comment) {
+    ret.comment = comment + 1;
+  } else {
+    comment = end + strlen(end);
+  }
+  // Split the operands at commas outside parentheses.
+  int depth = 0;
+  const char *start = end;
+  for (p = end; p <= comment; p++) {
+    if (p == comment || (*p == ',' && !depth)) {
+      char *operand = trim(start, p);
+      if (*operand && ret.n_operands < 3) {
+        ret.operands[ret.n_operands++].text = operand;
+      } else if (*operand) {
+        ret.n_operands = 4;  // too many for anything we know
+      }
+      start = p + 1;
+    } else if (*p == '(') {
+      depth++;
+    } else if (*p == ')') {
+      depth--;
+    }
+  }
+  if (ret.n_operands > 3) {
+    ret.n_operands = 0;
+    ret.mnemonic = "?";
+  }
+  analyze(&ret);
+  return ret;
+}
+
+static const char *format_insn(const Insn *insn) {
+  const char *ret = fmtstr("\t%s", insn->mnemonic);
+  for (int k = 0; k < insn->n_operands; k++) {
+    ret = fmtstr("%s%s%s", ret, k ? ", " : "\t", insn->operands[k].text);
+  }
+  return insn->comment ? fmtstr("%s\t\t#%s", ret, insn->comment) : ret;
+}
+
+// Navigation within a basic block
+
+/** The next instruction in the block of i, or -1 at the end of the block */
+static int next_insn(const Peephole *p, int i) {
+  InsnKind kind = p->insns[i].kind;
+  if (kind == I_JMP || kind == I_JCC || kind == I_RET)
+    return -1;
+  for (int j = i + 1; j < p->n_insns; j++) {
+    if (p->insns[j].line_kind == LINE_BOUNDARY)
+      return -1;
+    if (p->insns[j].line_kind == LINE_INSN && !p->insns[j].deleted)
+      return j;
+  }
+  return -1;
+}
+
+static int prev_insn(const Peephole *p, int i) {
+  for (int j = i - 1; j >= 0; j--) {
+    if (p->insns[j].line_kind == LINE_BOUNDARY)
+      return -1;
+    if (p->insns[j].line_kind == LINE_INSN && !p->insns[j].deleted)
+      return j;
+  }
+  return -1;
+}
+
+/** Whether the value of reg after i may be read. Only after a return is anything known to be dead at a block end. */
+static int reg_live_after(const Peephole *p, int i, int reg) {
+  int last = i;
+  for (int j = next_insn(p, i); j >= 0; j = next_insn(p, j)) {
+    last = j;
+    if (p->insns[j].uses & BIT(reg))
+      return 1;
+    if (p->insns[j].defs & BIT(reg))
+      return 0;
+  }
+  return p->insns[last].kind != I_RET;
+}
+
+static int flags_live_after(const Peephole *p, int i) {
+  int last = i;
+  for (int j = next_insn(p, i); j >= 0; j = next_insn(p, j)) {
+    last = j;
+    if (p->insns[j].reads_flags)
+      return 1;
+    if (p->insns[j].writes_flags)
+      return 0;
+  }
+  return p->insns[last].kind != I_RET;
+}
+
+// Memory
+
+/**
+ * Parse a frame slot, disp(%rbp), or disp(%rsp) in a function without a frame pointer, into its displacement.
+ * Returns the base register, or -1 if text is not a frame slot.
+ */
+static int frame_slot(const char *text, long *offset) {
+  char *end;
+  *offset = strtol(text, &end, 10);
+  return !strcmp(end, "(%rbp)") ? RBP : !strcmp(end, "(%rsp)") ? RSP : -1;
+}
+
+static const char *mem_text(const Insn *insn) {
+  return insn->operands[insn->mem_operand].text;
+}
+
+/** Whether the memory accessed by a and b may overlap. Only frame slots are told apart. */
+static int may_alias(const Insn *a, const Insn *b) {
+  if (a->barrier || b->barrier || a->mem_operand < 0 || b->mem_operand < 0)
+    return 1;
+  long x, y;
+  int base = frame_slot(mem_text(a), &x);
+  if (base >= 0 && frame_slot(mem_text(b), &y) == base)
+    return x < y + b->mem_size && y < x + a->mem_size;
+  return 1;
+}
+
+static int writes_to(const Insn *insn, const Insn *other) {
+  return insn->barrier || (insn->writes_memory && may_alias(insn, other));
+}
+
+static int reads_from(const Insn *insn, const Insn *other) {
+  return insn->barrier || (insn->reads_memory && may_alias(insn, other));
+}
+
+// Rewriting
+
+static void delete(Peephole *p, int i, PeepholeRule rule) {
+  p->insns[i].deleted = 1;
+  p->stats->counts[rule]++;
+  p->stats->n_removed++;
+}
+
+static void rewrite(Peephole *p, Insn *insn, PeepholeRule rule) {
+  insn->rewritten = 1;
+  analyze(insn);
+  p->stats->counts[rule]++;
+}
+
+static int is_mov(const Insn *insn) {
+  return insn->kind == I_MOV && insn->n_operands == 2;
+}
+
+static int is_reg(const Operand *op, int reg) {
+  return op->kind == OPERAND_REG && op->reg == reg;
+}
+
+/** Whether an immediate operand can be encoded in an instruction of size bytes */
+static int fits_immediate(const Operand *op, int size) {
+  long long value = strtoll(op->text + 1, 0, 0);
+  return size < 8 || (value >= INT32_MIN && value <= INT32_MAX);
+}
+
+// Rules. Each looks at the instruction at i, and the ones after it in its block, and returns whether it applied.
+
+/**
+ * mov M, r or mov r, M, followed by mov M, r with neither changed in between. This assumes, as both backends do,
+ * that the upper half of a register holding a 32-bit value is never read.
+ */
+static int redundant_load(Peephole *p, int i) {
+  Insn *a = &p->insns[i];
+  if (!is_mov(a) || a->mem_operand < 0)
+    return 0;
+  const Operand *reg = &a->operands[1 - a->mem_operand];
+  const Operand *mem = &a->operands[a->mem_operand];
+  if (reg->kind != OPERAND_REG || (mem->address_regs & a->defs))
+    return 0;
+  for (int j = next_insn(p, i); j >= 0; j = next_insn(p, j)) {
+    Insn *b = &p->insns[j];
+    if (is_mov(b) && b->size == a->size && b->mem_operand == 0 && is_reg(&b->operands[1], reg->reg) &&
+        !strcmp(mem_text(b), mem->text)) {
+      delete(p, j, PEEPHOLE_REDUNDANT_LOAD);
+      return 1;
+    }
+    if ((b->defs & (BIT(reg->reg) | mem->address_regs)) || writes_to(b, a))
+      return 0;
+  }
+  return 0;
+}
+
+/** mov r1, M (or mov $imm, M) followed by mov M, r2 becomes mov r1, r2. */
+static int store_forwarding(Peephole *p, int i) {
+  Insn *a = &p->insns[i];
+  if (!is_mov(a) || a->mem_operand != 1 || a->operands[0].kind == OPERAND_MEM)
+    return 0;
+  const Operand *src = &a->operands[0];
+  uint32_t clobbers = a->operands[1].address_regs | (src->kind == OPERAND_REG ? BIT(src->reg) : 0);
+  for (int j = next_insn(p, i); j >= 0; j = next_insn(p, j)) {
+    Insn *b = &p->insns[j];
+    if (is_mov(b) && b->size == a->size && b->mem_operand == 0 && b->operands[1].kind == OPERAND_REG &&
+        !strcmp(mem_text(b), mem_text(a))) {
+      b->operands[0] = *src;
+      rewrite(p, b, PEEPHOLE_STORE_FORWARDING);
+      return 1;
+    }
+    if ((b->defs & clobbers) || writes_to(b, a))
+      return 0;
+  }
+  return 0;
+}
+
+/**
+ * A store overwritten before anything reads it, or into the frame just before returning; or a store of the value
+ * just loaded from the same place.
+ */
+static int dead_store(Peephole *p, int i) {
+  Insn *a = &p->insns[i];
+  if (!is_mov(a) || a->mem_operand < 0)
+    return 0;
+  const Operand *mem = &a->operands[a->mem_operand];
+  if (a->mem_operand == 0) {
+    const Operand *reg = &a->operands[1];
+    if (reg->kind != OPERAND_REG || (mem->address_regs & a->defs))
+      return 0;
+    for (int j = next_insn(p, i); j >= 0; j = next_insn(p, j)) {
+      Insn *b = &p->insns[j];
+      if (is_mov(b) && b->size == a->size && b->mem_operand == 1 && is_reg(&b->operands[0], reg->reg) &&
+          !strcmp(mem_text(b), mem->text)) {
+        delete(p, j, PEEPHOLE_DEAD_STORE);
+        return 1;
+      }
+      if ((b->defs & (BIT(reg->reg) | mem->address_regs)) || writes_to(b, a))
+        return 0;
+    }
+    return 0;
+  }
+
+  // The frame is below %rbp, and all of what %rsp addresses until it is popped.
+  long offset;
+  int base = frame_slot(mem->text, &offset), local = base == RSP || (base == RBP && offset < 0);
+  for (int j = next_insn(p, i); j >= 0; j = next_insn(p, j)) {
+    Insn *b = &p->insns[j];
+    int overwrites = is_mov(b) && b->size >= a->size && b->mem_operand == 1 && !strcmp(mem_text(b), mem->text);
+    if (overwrites || (local && b->kind == I_RET)) {
+      delete(p, i, PEEPHOLE_DEAD_STORE);
+      return 1;
+    }
+    if (local && b->kind == I_LEAVE)
+      continue;  // the frame is gone, but nothing reads it before the return
+    if ((b->defs & mem->address_regs) || reads_from(b, a))
+      return 0;
+  }
+  return 0;
+}
+
+/** mov X, r1 followed by mov r1, Y, where r1 is dead, becomes mov X, Y. */
+static int mov_chain(Peephole *p, int i) {
+  Insn *a = &p->insns[i];
+  if (!is_mov(a) || a->operands[1].kind != OPERAND_REG)
+    return 0;
+  int j = next_insn(p, i);
+  if (j < 0)
+    return 0;
+  Insn *b = &p->insns[j];
+  int r1 = a->operands[1].reg;
+  const Operand *x = &a->operands[0], *y = &b->operands[1];
+  if (!is_mov(b) || b->size != a->size || !is_reg(&b->operands[0], r1) || is_reg(y, r1) ||
+      (y->address_regs & BIT(r1)) || (x->kind == OPERAND_MEM && y->kind == OPERAND_MEM) ||
+      (x->kind == OPERAND_IMM && y->kind == OPERAND_MEM && !fits_immediate(x, a->size)) ||
+      reg_live_after(p, j, r1))
+    return 0;
+  a->operands[1] = *y;
+  a->comment = 0;  // both would name r1
+  rewrite(p, a, PEEPHOLE_MOV_CHAIN);
+  delete(p, j, PEEPHOLE_MOV_CHAIN);
+  p->stats->counts[PEEPHOLE_MOV_CHAIN]--;  // one instruction gone, not two
+  return 1;
+}
+
+/** mov M, r1 (or mov $imm, r1) followed by op r1, r2, where r1 is dead, becomes op M, r2. */
+static int load_folding(Peephole *p, int i) {
+  Insn *a = &p->insns[i];
+  if (!is_mov(a) || a->operands[0].kind == OPERAND_REG || a->operands[1].kind != OPERAND_REG)
+    return 0;
+  int j = next_insn(p, i);
+  if (j < 0)
+    return 0;
+  Insn *b = &p->insns[j];
+  int r1 = a->operands[1].reg;
+  if ((b->kind != I_ALU && b->kind != I_CMP) || b->n_operands != 2 || b->size != a->size ||
+      !is_reg(&b->operands[0], r1) || b->operands[1].kind != OPERAND_REG || is_reg(&b->operands[1], r1) ||
+      (a->operands[0].kind == OPERAND_IMM && !fits_immediate(&a->operands[0], a->size)) ||
+      reg_live_after(p, j, r1))
+    return 0;
+  b->operands[0] = a->operands[0];
+  b->comment = 0;
+  rewrite(p, b, PEEPHOLE_LOAD_FOLDING);
+  p->stats->counts[PEEPHOLE_LOAD_FOLDING]--;
+  delete(p, i, PEEPHOLE_LOAD_FOLDING);
+  return 1;
+}
+
+/** mov r, r, except movl, which clears the upper half */
+static int self_move(Peephole *p, int i) {
+  Insn *a = &p->insns[i];
+  if (!is_mov(a) || a->size == 4 || a->operands[0].kind != OPERAND_REG || !is_reg(&a->operands[1], a->operands[0].reg))
+    return 0;
+  delete(p, i, PEEPHOLE_SELF_MOVE);
+  return 1;
+}
+
+/** cmp or test whose flags are overwritten before anything reads them */
+static int dead_flags(Peephole *p, int i) {
+  if (p->insns[i].kind != I_CMP || flags_live_after(p, i))
+    return 0;
+  delete(p, i, PEEPHOLE_DEAD_FLAGS);
+  return 1;
+}
+
+/** Anything between a jmp or ret and the next label */
+static int unreachable(Peephole *p, int i) {
+  int j = prev_insn(p, i);
+  if (j < 0 || (p->insns[j].kind != I_JMP && p->insns[j].kind != I_RET))
+    return 0;
+  delete(p, i, PEEPHOLE_UNREACHABLE);
+  return 1;
+}
+
+/** The next line after i that is not a comment or deleted, or -1 */
+static int next_line(const Peephole *p, int i) {
+  for (int j = i + 1; j < p->n_insns; j++) {
+    if (p->insns[j].line_kind == LINE_BOUNDARY || (p->insns[j].line_kind == LINE_INSN && !p->insns[j].deleted))
+      return j;
+  }
+  return -1;
+}
+
+/** The condition code opposite to cc, or 0 if unknown */
+static const char *negate_condition(const char *cc) {
+  static const char *pairs[][2] = {
+    {"e", "ne"}, {"z", "nz"}, {"l", "ge"}, {"le", "g"}, {"b", "ae"}, {"be", "a"}, {"s", "ns"}, {"o", "no"},
+    {"p", "np"},
+  };
+  for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+    for (int k = 0; k < 2; k++) {
+      if (!strcmp(cc, pairs[i][k]))
+        return pairs[i][!k];
+    }
+  }
+  return 0;
+}
+
+/** Whether running off the end of the line before reaches what follows: a label or alignment, not another section */
+static int falls_through(const Insn *line) {
+  const char *p = line->text;
+  while (*p == ' ' || *p == '\t') {
+    p++;
+  }
+  return p == line->text || !strncmp(p, ".p2align", strlen(".p2align"));
+}
+
+/** jcc L1; jmp L2; L1: becomes jncc L2; L1:, as a branch to skip a break or continue leaves it. */
+static int branch_over_jump(Peephole *p, int i) {
+  Insn *branch = &p->insns[i];
+  int j = next_line(p, i);
+  if (branch->kind != I_JCC || branch->n_operands != 1 || j < 0 || p->insns[j].kind != I_JMP
+    || p->insns[j].line_kind != LINE_INSN || p->insns[j].n_operands != 1)
+    return 0;
+  const char *negated = negate_condition(branch->mnemonic + 1);
+  if (!negated)
+    return 0;
+  const char *target = fmtstr("%s:", branch->operands[0].text);
+  for (int k = next_line(p, j); k >= 0 && p->insns[k].line_kind == LINE_BOUNDARY && falls_through(&p->insns[k]);
+    k = next_line(p, k)) {
+    if (!strcmp(p->insns[k].text, target)) {
+      branch->mnemonic = fmtstr("j%s", negated);
+      branch->operands[0].text = p->insns[j].operands[0].text;
+      rewrite(p, branch, PEEPHOLE_BRANCH_OVER_JUMP);
+      p->insns[j].deleted = 1;
+      p->stats->n_removed++;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int (*const RULES[])(Peephole *p, int i) = {
+  [PEEPHOLE_REDUNDANT_LOAD] = redundant_load,
+  [PEEPHOLE_STORE_FORWARDING] = store_forwarding,
+  [PEEPHOLE_DEAD_STORE] = dead_store,
+  [PEEPHOLE_MOV_CHAIN] = mov_chain,
+  [PEEPHOLE_LOAD_FOLDING] = load_folding,
+  [PEEPHOLE_SELF_MOVE] = self_move,
+  [PEEPHOLE_DEAD_FLAGS] = dead_flags,
+  [PEEPHOLE_UNREACHABLE] = unreachable,
+  [PEEPHOLE_BRANCH_OVER_JUMP] = branch_over_jump,
+};
+
+char *peephole_optimize(const char *text, PeepholeStats *stats) {
+  Peephole p = { .stats = stats };
+  int capacity = 0;
+  for (const char *line = text; *line;) {
+    const char *end = strchr(line, '\n');
+    if (!end) {
+      end = line + strlen(line);
+    }
+    if (p.n_insns == capacity) {
+      capacity = capacity ? 2 * capacity : 64;
+      p.insns = checked_realloc(p.insns, capacity * sizeof(Insn));
+    }
+    p.insns[p.n_insns] = parse_line(fmtstr("%.*s", (int) (end - line), line));
+    stats->n_instructions += p.insns[p.n_insns].line_kind == LINE_INSN;
+    p.n_insns++;
+    line = *end ? end + 1 : end;
+  }
+
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (int i = 0; i < p.n_insns; i++) {
+      for (int rule = 0; rule < N_PEEPHOLE_RULES && p.insns[i].line_kind == LINE_INSN && !p.insns[i].deleted; rule++) {
+        changed |= RULES[rule](&p, i);
+      }
+    }
+  }
+
+  char *ret;
+  size_t size;
+  FILE *out = checked_open_memstream(&ret, &size);
+  for (int i = 0; i < p.n_insns; i++) {
+    if (!p.insns[i].deleted) {
+      fprintf(out, "%s\n", p.insns[i].rewritten ? format_insn(&p.insns[i]) : p.insns[i].text);
+    }
+  }
+  checked_fclose(out);
+  free(p.insns);
+  return ret;
+}
+
+void fprint_peephole_stats(FILE *out, const PeepholeStats *stats) {
+  fprintf(out, "Peephole: %d of %d instructions removed (", stats->n_removed, stats->n_instructions);
+  for (int rule = 0; rule < N_PEEPHOLE_RULES; rule++) {
+    fprintf(out, "%s%s %d", rule ? ", " : "", RULE_NAMES[rule], stats->counts[rule]);
+  }
+  fprintf(out, ")\n");
+}
@@ -0,0 +1,38 @@
+/**
+ * Peephole optimization of x86_64 assembly (AT&T syntax), shared by the backends. The text of a function is read
+ * into a buffer of instructions, split into basic blocks at labels and jumps, and a table of rules is applied to each
+ * block until none matches.
+ */
+
+#pragma once
+#include <stdio.h>
+
+#define PEEPHOLE_RULES(X) \
+  X(REDUNDANT_LOAD, "redundant load") \
+  X(STORE_FORWARDING, "store forwarding") \
+  X(DEAD_STORE, "dead store") \
+  X(MOV_CHAIN, "mov chain") \
+  X(LOAD_FOLDING, "load folding") \
+  X(SELF_MOVE, "self move") \
+  X(DEAD_FLAGS, "dead flag setter") \
+  X(UNREACHABLE, "unreachable") \
+  X(BRANCH_OVER_JUMP, "branch over jump")
+
+typedef enum {
+#define X(name, description) PEEPHOLE_##name,
+  PEEPHOLE_RULES(X)
+#undef X
+  N_PEEPHOLE_RULES
+} PeepholeRule;
+
+/** Number of instructions each rule removed or replaced by a cheaper one, accumulated over functions */
+typedef struct {
+  int counts[N_PEEPHOLE_RULES];
+  int n_instructions;  ///< instructions seen
+  int n_removed;  ///< instructions removed by any rule
+} PeepholeStats;
+
+/** Optimize the assembly of one function, returning a new heap-allocated text. */
+char *peephole_optimize(const char *text, PeepholeStats *stats);
+/** Print stats on one line, as the other passes report theirs. */
+void fprint_peephole_stats(FILE *out, const PeepholeStats *stats);
@@ -0,0 +1,225 @@
+#include "profile.h"
+
+#include "cache.h"
+#include "common.h"
+#include "vendor/klib/khash.h"
+
+// Blocks running at least this fraction of the times the hottest one in the profile does are hot.
+#define HOT_FRACTION 1000
+// Without a profile, a likely edge is taken this many times for each time an unlikely one is: one leaving a loop, or
+// going where a function that does not return is sure to be called.
+#define LIKELY_WEIGHT 31
+// and a loop goes round at most this many times each time it is entered,
+#define MAX_ITERATIONS 32
+// as often as the entry runs, by the estimate.
+#define ESTIMATED_ENTRY_COUNT 1024
+
+typedef struct {
+  uint64_t shape;
+  uint32_t n_counts;
+  uint64_t *counts;  ///< by block, from block 1
+} FunctionProfile;
+
+KHASH_MAP_INIT_STR(FunctionProfile, FunctionProfile)
+
+struct Profile {
+  kh_FunctionProfile_t *by_name;
+  uint64_t max_count;
+};
+
+// Each line of the file is a function: its name, its shape in hex, the number of its counts, and the counts. It is
+// read as the backend starts, before the parser can catch exceptions, so errors in it are fatal.
+Profile *read_profile(const char *path) {
+  FILE *in = checked_fopen(path, "r");
+  Profile *profile = checked_calloc(1, sizeof(Profile));
+  profile->by_name = kh_init_FunctionProfile();
+  char name[1024];
+  unsigned long long shape, n_counts;
+  int n_read;
+  while ((n_read = fscanf(in, "%1023s %llx %llu", name, &shape, &n_counts)) == 3) {
+    DIE_IF(n_counts > UINT32_MAX, fmtstr("%s: %s has %llu counts", path, name, n_counts));
+    khiter_t iter = kh_get_FunctionProfile(profile->by_name, name);
+    if (iter == kh_end(profile->by_name)) {
+      int ret;
+      iter = kh_put_FunctionProfile(profile->by_name, fmtstr("%s", name), &ret);
+      DIE_IF(ret == -1, "kh_put failed");
+      kh_val(profile->by_name, iter) = (FunctionProfile) {0};
+    }
+    FunctionProfile *function = &kh_val(profile->by_name, iter);
+    if (function->shape != shape || function->n_counts != n_counts) {
+      free(function->counts);
+      *function = (FunctionProfile) {
+        .shape = shape,
+        .n_counts = n_counts,
+        .counts = checked_calloc(n_counts + 1, sizeof(uint64_t)),
+      };
+    }
+    for (uint32_t i = 0; i < n_counts; i++) {
+      unsigned long long count;
+      DIE_IF(fscanf(in, "%llu", &count) != 1, fmtstr("%s: the counts of %s are cut short", path, name));
+      function->counts[i] += count;
+    }
+  }
+  DIE_IF(n_read != EOF, fmtstr("%s: expected a function name, shape and number of counts", path));
+  checked_fclose(in);
+  for (khiter_t iter = kh_begin(profile->by_name); iter != kh_end(profile->by_name); iter++) {
+    if (!kh_exist(profile->by_name, iter))
+      continue;
+    const FunctionProfile *function = &kh_val(profile->by_name, iter);
+    for (uint32_t i = 0; i < function->n_counts; i++) {
+      profile->max_count = MAX(profile->max_count, function->counts[i]);
+    }
+  }
+  return profile;
+}
+
+void free_profile(Profile *profile) {
+  for (khiter_t iter = kh_begin(profile->by_name); iter != kh_end(profile->by_name); iter++) {
+    if (kh_exist(profile->by_name, iter)) {
+      free((char *) kh_key(profile->by_name, iter));
+      free(kh_val(profile->by_name, iter).counts);
+    }
+  }
+  kh_destroy_FunctionProfile(profile->by_name);
+  free(profile);
+}
+
+uint64_t profile_hot_count(const Profile *profile) {
+  uint64_t ret = profile->max_count / HOT_FRACTION;
+  return ret ? ret : 1;
+}
+
+uint64_t ir_shape_hash(const IrFunction *f) {
+  uint64_t h = hash_u64(HASH_INIT, f->n_blocks);
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    const IrBlock *block = &f->blocks[b];
+    h = hash_u64(h, block->n_succs);
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      h = hash_u64(h, block->succs[i]);
+    }
+  }
+  return h;
+}
+
+int instrument_blocks(IrFunction *f, int first) {
+  int symbol = ir_intern_symbol(f, PROFILE_COUNTERS);
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    // Every block ends in a terminator, so there is an instruction to go before.
+    IrRef inst = f->blocks[b].first;
+    while (f->op[inst] == IR_PHI || f->op[inst] == IR_PARAM) {
+      inst = f->next[inst];
+    }
+    IrRef counters = ir_insert_before(f, inst, IR_GLOBAL, IR_PTR, 0, 0, symbol);
+    ir_insert_before(f, inst, IR_COUNT, IR_VOID, 1, &counters, first + b - 1);
+  }
+  return f->n_blocks - 1;
+}
+
+int apply_profile(IrFunction *f, const Profile *profile) {
+  khiter_t iter = kh_get_FunctionProfile(profile->by_name, f->name);
+  if (iter == kh_end(profile->by_name))
+    return 0;
+  const FunctionProfile *function = &kh_val(profile->by_name, iter);
+  if (function->shape != ir_shape_hash(f) || function->n_counts != f->n_blocks - 1)
+    return 0;
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    f->blocks[b].count = function->counts[b - 1];
+  }
+  f->has_profile = 1;
+  return 1;
+}
+
+typedef struct {
+  const IrFunction *f;
+  const IrLoopForest *forest;
+  uint8_t *cold;  ///< by block: every path from it calls a function that does not return
+  double *freq;  ///< by block: the times it runs for each time the header of the region estimated last does
+  double *in;  ///< by block: the frequency the edges into it estimated so far bring
+  double *iterations;  ///< by loop header: the times it runs for each time its loop is entered
+} Estimate;
+
+static int is_loop_header(const Estimate *e, IrBlockRef b) {
+  int loop = e->forest->innermost[b];
+  return loop >= 0 && e->forest->loops[loop].header == b;
+}
+
+/** The chance that b goes on to its successor succs[i], by the weights of its edges */
+static double edge_probability(const Estimate *e, IrBlockRef b, uint32_t i) {
+  const IrBlock *block = &e->f->blocks[b];
+  int loop = e->forest->innermost[b];
+  uint32_t weight = 0, total = 0;
+  for (uint32_t k = 0; k < block->n_succs; k++) {
+    IrBlockRef s = block->succs[k];
+    int unlikely = e->cold[s] || (loop >= 0 && !ir_loop_contains(e->forest, loop, s));
+    uint32_t w = unlikely ? 1 : LIKELY_WEIGHT;
+    weight += k == i ? w : 0;
+    total += w;
+  }
+  return (double) weight / total;
+}
+
+/**
+ * Estimate the frequencies of blocks, those of loop in reverse postorder or all of the function if loop is -1,
+ * relative to the first, by Wu and Larus, "Static Branch Frequency and Program Profile Analysis" (MICRO 1994): each
+ * loop nested in the region, estimated before it, multiplies what enters its header by its iterations. Returns the
+ * chance of going round the loop, the frequency of its back edges.
+ */
+static double estimate_region(Estimate *e, const IrBlockRef *blocks, uint32_t n_blocks, int loop) {
+  for (uint32_t k = 0; k < n_blocks; k++) {
+    e->in[blocks[k]] = 0;
+  }
+  double back = 0;
+  for (uint32_t k = 0; k < n_blocks; k++) {
+    IrBlockRef b = blocks[k];
+    double freq = k ? e->in[b] : 1;
+    e->freq[b] = freq * (is_loop_header(e, b) && (k || loop < 0) ? e->iterations[b] : 1);
+    const IrBlock *block = &e->f->blocks[b];
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      IrBlockRef s = block->succs[i];
+      // Nothing goes on from a cold block but to other cold blocks.
+      double taken = e->cold[b] ? 0 : e->freq[b] * edge_probability(e, b, i);
+      if (is_loop_header(e, s) && ir_loop_contains(e->forest, e->forest->innermost[s], b)) {
+        back += s == blocks[0] && loop >= 0 ? taken : 0;  // the back edges of nested loops are in their iterations
+      } else if (loop < 0 || ir_loop_contains(e->forest, loop, s)) {
+        e->in[s] += taken;
+      }
+    }
+  }
+  return back;
+}
+
+void estimate_counts(IrFunction *f) {
+  IrBlockRef *rpo = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int n_rpo = ir_reverse_postorder(f, rpo);
+  Estimate e = {
+    .f = f,
+    .forest = ir_find_loops(f),
+    .cold = arena_alloc(f->arena, f->n_blocks),
+    .freq = arena_alloc(f->arena, f->n_blocks * sizeof(double)),
+    .in = arena_alloc(f->arena, f->n_blocks * sizeof(double)),
+    .iterations = arena_alloc(f->arena, f->n_blocks * sizeof(double)),
+  };
+  // In postorder, so the successors come first, but for those of back edges, which are taken to be warm.
+  for (int k = n_rpo - 1; k >= 0; k--) {
+    const IrBlock *block = &f->blocks[rpo[k]];
+    uint8_t cold = block->calls_noreturn || block->n_succs;
+    for (uint32_t i = 0; i < block->n_succs && !block->calls_noreturn; i++) {
+      cold &= e.cold[block->succs[i]];
+    }
+    e.cold[rpo[k]] = cold;
+  }
+  // Inner loops first
+  for (int l = 0; l < e.forest->n_loops; l++) {
+    const IrLoop *loop = &e.forest->loops[l];
+    double back = estimate_region(&e, loop->blocks, loop->n_blocks, l);
+    e.iterations[loop->header] = back < 1 - 1.0 / MAX_ITERATIONS ? 1 / (1 - back) : MAX_ITERATIONS;
+  }
+  estimate_region(&e, rpo, n_rpo, -1);
+  for (int k = 0; k < n_rpo; k++) {
+    IrBlockRef b = rpo[k];
+    // Deep nests of loops could run more often than a count holds.
+    double scaled = e.freq[b] * ESTIMATED_ENTRY_COUNT;
+    uint64_t count = scaled < 1e18 ? (uint64_t) (scaled + 0.5) : (uint64_t) 1e18;
+    f->blocks[b].count = e.cold[b] || !e.freq[b] ? 0 : count ? count : 1;
+  }
+}
@@ -0,0 +1,45 @@
+/**
+ * Profile-guided optimization. A program built with -G counts the times each block of each function runs, the blocks
+ * being those the front end built before any optimization, and adds the counts to a file when it exits. A build with
+ * -U reads them back into the blocks of each function whose control flow still has the same shape. Edges need no
+ * counters of their own: the count of an edge is that of its source if it has no other successor, or of its target
+ * if it has no other predecessor, and the rest follow from the counts of the branches they leave.
+ */
+
+#pragma once
+#include <stdint.h>
+#include "ir.h"
+
+/** The symbol of the counters of a translation unit, which are not visible outside it */
+#define PROFILE_COUNTERS "__kuicc_profile_counters"
+
+typedef struct Profile Profile;
+
+/**
+ * Read the counts that programs built with -G added to the file at path. A function recorded more than once, by
+ * several runs, has its counts added up, unless its shape changed, when the later counts replace the earlier ones.
+ */
+Profile *read_profile(const char *path);
+void free_profile(Profile *profile);
+
+/** The count from which a block is hot: a small fraction of the greatest count in the profile, and at least 1 */
+uint64_t profile_hot_count(const Profile *profile);
+
+/** A hash of the shape of the control flow of f: its blocks and their successors */
+uint64_t ir_shape_hash(const IrFunction *f);
+
+/**
+ * Give each block of f a count instruction for counter first + b - 1 of PROFILE_COUNTERS, b being its number, after
+ * its phis and parameters. Returns the number of counters used, one per block.
+ */
+int instrument_blocks(IrFunction *f, int first);
+
+/** Give the blocks of f their counts in profile, if it has them for a function of the same name and shape. */
+int apply_profile(IrFunction *f, const Profile *profile);
+
+/**
+ * Without a profile, give the blocks of f counts guessed from its shape: loops go round, branches split evenly, and
+ * blocks from which every path calls a function that does not return, such as abort, are cold, with a count of 0, as
+ * are those only they lead to.
+ */
+void estimate_counts(IrFunction *f);
@@ -0,0 +1,298 @@
+#include "regalloc.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+
+typedef struct {
+  IrRef value;
+  int start, end;  ///< positions of the first definition and the last use, inclusive
+  uint32_t clobbered;  ///< the registers the instructions within the interval overwrite
+} Interval;
+
+// Sets of values, one bit per IrRef
+#define WORD_BITS 64
+#define HAS_BIT(set, i) (((set)[(i) / WORD_BITS] >> ((i) % WORD_BITS)) & 1)
+#define SET_BIT(set, i) ((set)[(i) / WORD_BITS] |= (uint64_t) 1 << ((i) % WORD_BITS))
+#define CLEAR_BIT(set, i) ((set)[(i) / WORD_BITS] &= ~((uint64_t) 1 << ((i) % WORD_BITS)))
+#define FOR_EACH_BIT(set, n_words, i) \
+  for (uint32_t i##_w_ = 0; i##_w_ < (n_words); i##_w_++) \
+    for (uint64_t i##_bits_ = (set)[i##_w_]; i##_bits_; i##_bits_ &= i##_bits_ - 1) \
+      for (IrRef i = i##_w_ * WORD_BITS + __builtin_ctzll(i##_bits_), i##_once_ = 1; i##_once_; i##_once_ = 0)
+
+static int compare_starts(const void *a, const void *b) {
+  const Interval *x = a, *y = b;
+  if (x->start != y->start)
+    return x->start < y->start ? -1 : 1;
+  return x->value < y->value ? -1 : x->value > y->value;
+}
+
+static void extend(Interval *interval, int pos) {
+  if (pos < interval->start) {
+    interval->start = pos;
+  }
+  if (pos > interval->end) {
+    interval->end = pos;
+  }
+}
+
+/** Add the phi operands that b passes to its successors to live. */
+static void add_phi_uses(const IrFunction *f, IrBlockRef b, const uint8_t *has_location, uint64_t *live) {
+  const IrBlock *block = &f->blocks[b];
+  for (uint32_t i = 0; i < block->n_succs; i++) {
+    const IrBlock *succ = &f->blocks[block->succs[i]];
+    for (uint32_t k = 0; k < succ->n_preds; k++) {
+      if (succ->preds[k] != b)
+        continue;
+      for (IrRef phi = succ->first; phi && f->op[phi] == IR_PHI; phi = f->next[phi]) {
+        IrRef arg = IR_ARG(f, phi, k);
+        if (has_location[arg]) {
+          SET_BIT(live, arg);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * The register of a value joined to this one by a phi, if it has one yet: the phi, for its operands, or an operand,
+ * for the phi. Taking it makes the move between them a no-op.
+ */
+static int coalescing_hint(const IrFunction *f, const RegisterAllocation *ret, const IrRef *phi_of, IrRef value) {
+  if (phi_of[value] && ret->reg[phi_of[value]] != REG_NONE)
+    return ret->reg[phi_of[value]];
+  if (f->op[value] == IR_PHI) {
+    for (uint32_t i = 0; i < f->n_args[value]; i++) {
+      if (ret->reg[IR_ARG(f, value, i)] != REG_NONE)
+        return ret->reg[IR_ARG(f, value, i)];
+    }
+  }
+  return REG_NONE;
+}
+
+RegisterAllocation *linear_scan(IrFunction *f, const IrBlockRef *order, int n_order, const RegisterInfo *info) {
+  Arena *arena = f->arena;
+  uint32_t n_words = (f->n_insts + WORD_BITS - 1) / WORD_BITS;
+
+  // Number instructions two apart, leaving room for the block boundaries.
+  int *pos = arena_alloc(arena, f->n_insts * sizeof(int));
+  int *block_start = arena_alloc(arena, f->n_blocks * sizeof(int));
+  int *block_end = arena_alloc(arena, f->n_blocks * sizeof(int));
+  uint8_t *has_location = arena_alloc(arena, f->n_insts);
+  // Positions of the instructions clobbering registers, in order, and the registers
+  int *calls = arena_alloc(arena, f->n_insts * sizeof(int));
+  uint32_t *call_clobbers = arena_alloc(arena, f->n_insts * sizeof(uint32_t));
+  int n_calls = 0;
+  int p = 0;
+  for (int k = 0; k < n_order; k++) {
+    IrBlockRef b = order[k];
+    block_start[b] = p++;
+    for (IrRef inst = f->blocks[b].first; inst; inst = f->next[inst]) {
+      pos[inst] = p;
+      has_location[inst] = f->type[inst] != IR_VOID && info->needs_location(f, inst);
+      uint32_t clobbers = info->clobbers(f, inst);
+      if (clobbers) {
+        call_clobbers[n_calls] = clobbers;
+        calls[n_calls++] = p;
+      }
+      p += 2;
+    }
+    block_end[b] = p++;
+  }
+
+  // Live values at block boundaries, iterated backwards to a fixed point
+  uint64_t **live_in = arena_alloc(arena, f->n_blocks * sizeof(uint64_t *));
+  uint64_t **live_out = arena_alloc(arena, f->n_blocks * sizeof(uint64_t *));
+  for (int k = 0; k < n_order; k++) {
+    live_in[order[k]] = arena_alloc(arena, n_words * sizeof(uint64_t));
+    live_out[order[k]] = arena_alloc(arena, n_words * sizeof(uint64_t));
+  }
+  uint64_t *live = arena_alloc(arena, n_words * sizeof(uint64_t));
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (int k = n_order - 1; k >= 0; k--) {
+      IrBlockRef b = order[k];
+      const IrBlock *block = &f->blocks[b];
+      memset(live, 0, n_words * sizeof(uint64_t));
+      for (uint32_t i = 0; i < block->n_succs; i++) {
+        const uint64_t *succ_live = live_in[block->succs[i]];
+        for (uint32_t w = 0; w < n_words; w++) {
+          live[w] |= succ_live[w];
+        }
+      }
+      add_phi_uses(f, b, has_location, live);
+      memcpy(live_out[b], live, n_words * sizeof(uint64_t));
+      for (IrRef inst = block->last; inst; inst = f->prev[inst]) {
+        if (has_location[inst]) {
+          CLEAR_BIT(live, inst);
+        }
+        if (f->op[inst] == IR_PHI)
+          continue;  // its operands are used at the ends of the predecessors
+        for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+          IrRef arg = IR_ARG(f, inst, i);
+          if (has_location[arg]) {
+            SET_BIT(live, arg);
+          }
+        }
+      }
+      if (memcmp(live, live_in[b], n_words * sizeof(uint64_t))) {
+        memcpy(live_in[b], live, n_words * sizeof(uint64_t));
+        changed = 1;
+      }
+    }
+  }
+
+  // One interval per value, from its earliest to its latest live position
+  int *interval_of = arena_alloc(arena, f->n_insts * sizeof(int));
+  Interval *intervals = arena_alloc(arena, f->n_insts * sizeof(Interval));
+  int n_intervals = 0;
+  for (int k = 0; k < n_order; k++) {
+    for (IrRef inst = f->blocks[order[k]].first; inst; inst = f->next[inst]) {
+      if (has_location[inst]) {
+        interval_of[inst] = n_intervals;
+        intervals[n_intervals++] = (Interval) { .value = inst, .start = INT_MAX, .end = INT_MIN };
+      }
+    }
+  }
+  for (int k = 0; k < n_order; k++) {
+    IrBlockRef b = order[k];
+    FOR_EACH_BIT(live_in[b], n_words, value) {
+      extend(&intervals[interval_of[value]], block_start[b]);
+    }
+    FOR_EACH_BIT(live_out[b], n_words, value) {
+      extend(&intervals[interval_of[value]], block_end[b]);
+    }
+    for (IrRef inst = f->blocks[b].first; inst; inst = f->next[inst]) {
+      if (has_location[inst]) {
+        extend(&intervals[interval_of[inst]], pos[inst]);
+      }
+      if (f->op[inst] == IR_PHI)
+        continue;
+      for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+        IrRef arg = IR_ARG(f, inst, i);
+        if (has_location[arg]) {
+          extend(&intervals[interval_of[arg]], pos[inst]);
+        }
+      }
+    }
+  }
+  for (int i = 0, c = 0; i < n_intervals; i++) {
+    // A call at either end is fine: the value is either consumed before it or produced after it.
+    for (c = 0; c < n_calls && calls[c] <= intervals[i].start; c++) {
+    }
+    for (; c < n_calls && calls[c] < intervals[i].end; c++) {
+      intervals[i].clobbered |= call_clobbers[c];
+    }
+  }
+  qsort(intervals, n_intervals, sizeof(Interval), compare_starts);
+
+  // By value: the first phi it is an operand of
+  IrRef *phi_of = arena_alloc(arena, f->n_insts * sizeof(IrRef));
+  for (int k = 0; k < n_order; k++) {
+    for (IrRef phi = f->blocks[order[k]].first; phi && f->op[phi] == IR_PHI; phi = f->next[phi]) {
+      for (uint32_t i = 0; i < f->n_args[phi]; i++) {
+        IrRef arg = IR_ARG(f, phi, i);
+        if (has_location[arg] && !phi_of[arg]) {
+          phi_of[arg] = phi;
+        }
+      }
+    }
+  }
+
+  RegisterAllocation *ret = arena_alloc(arena, sizeof(RegisterAllocation));
+  ret->reg = arena_alloc(arena, f->n_insts * sizeof(int8_t));
+  ret->spill_slot = arena_alloc(arena, f->n_insts * sizeof(int));
+  for (IrRef inst = 0; inst < f->n_insts; inst++) {
+    ret->reg[inst] = REG_NONE;
+    ret->spill_slot[inst] = -1;
+  }
+  ret->n_intervals = n_intervals;
+
+  // Active intervals, spilled ones included, sorted by increasing end
+  Interval **active = arena_alloc(arena, (n_intervals + 1) * sizeof(Interval *));
+  int n_active = 0;
+  ret->spill_sizes = arena_alloc(arena, (n_intervals + 1) * sizeof(int));
+  int *free_slots = arena_alloc(arena, (n_intervals + 1) * sizeof(int));
+  int n_free_slots = 0;
+  uint32_t all_regs = ((uint32_t) 1 << info->n_regs) - 1;
+  uint32_t free_regs = all_regs;
+
+  for (int i = 0; i < n_intervals; i++) {
+    Interval *current = &intervals[i];
+    // A value whose last use is where current is defined gives up its location in time to be reused.
+    int n_expired = 0;
+    while (n_expired < n_active && active[n_expired]->end <= current->start) {
+      IrRef value = active[n_expired++]->value;
+      if (ret->reg[value] != REG_NONE) {
+        free_regs |= (uint32_t) 1 << ret->reg[value];
+      } else {
+        free_slots[n_free_slots++] = ret->spill_slot[value];
+      }
+    }
+    memmove(active, active + n_expired, (n_active - n_expired) * sizeof(Interval *));
+    n_active -= n_expired;
+
+    uint32_t allowed = info->allowed_regs(f, current->value) & ~current->clobbered;
+    uint32_t available = free_regs & allowed;
+    Interval *spilled = current;
+    if (available) {
+      // Registers preserved across calls cost a save in the prologue, so only take them when needed.
+      uint32_t preferred = available & ~info->callee_saved;
+      int reg = __builtin_ctz(preferred ? preferred : available);
+      int hint = info->preferred_reg(f, current->value);
+      if (hint == REG_NONE || !(available >> hint & 1)) {
+        hint = coalescing_hint(f, ret, phi_of, current->value);
+        if (hint != REG_NONE && !((preferred | ret->used_regs) >> hint & 1)) {
+          hint = REG_NONE;  // not worth saving another register for
+        }
+      }
+      if (hint != REG_NONE && (available >> hint & 1)) {
+        reg = hint;
+      }
+      ret->reg[current->value] = reg;
+      free_regs &= ~((uint32_t) 1 << reg);
+      spilled = 0;
+    } else {
+      // Spill whichever ends last: current, or an active interval holding a register current could use.
+      for (int k = n_active - 1; k >= 0; k--) {
+        int reg = ret->reg[active[k]->value];
+        if (reg != REG_NONE && (allowed >> reg & 1)) {
+          if (active[k]->end > current->end) {
+            spilled = active[k];
+            ret->reg[current->value] = reg;
+            ret->reg[spilled->value] = REG_NONE;
+          }
+          break;
+        }
+      }
+    }
+    if (spilled) {
+      // Reuse a free slot of the right size, or make a new one.
+      int size = ROUND_UP(IR_TYPE_SIZES[f->type[spilled->value]], 8), k = n_free_slots - 1;
+      while (k >= 0 && ret->spill_sizes[free_slots[k]] != size) {
+        k--;
+      }
+      if (k >= 0) {
+        ret->spill_slot[spilled->value] = free_slots[k];
+        free_slots[k] = free_slots[--n_free_slots];
+      } else {
+        ret->spill_sizes[ret->n_spill_slots] = size;
+        ret->spill_slot[spilled->value] = ret->n_spill_slots++;
+      }
+      ret->n_spilled++;
+    }
+    if (ret->reg[current->value] != REG_NONE) {
+      ret->used_regs |= (uint32_t) 1 << ret->reg[current->value];
+    }
+
+    int k = n_active++;
+    while (k > 0 && active[k - 1]->end > current->end) {
+      active[k] = active[k - 1];
+      k--;
+    }
+    active[k] = current;
+  }
+  return ret;
+}
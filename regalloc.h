@@ -0,0 +1,41 @@
+/**
+ * Linear scan register allocation over SSA values (Poletto and Sarkar, "Linear Scan Register Allocation", TOPLAS
+ * 1999). Each value gets a single live interval covering all of its uses in a linear order of the blocks, and keeps
+ * either one register or one spill slot for all of it.
+ */
+
+#pragma once
+#include <stdint.h>
+#include "ir.h"
+
+#define REG_NONE -1
+
+/** The target's view of registers and instructions */
+typedef struct {
+  int n_regs;  ///< allocatable registers are numbered 0 .. n_regs - 1, in order of preference
+  uint32_t callee_saved;  ///< mask of the registers every call preserves, which cost a save in the prologue to use
+  /** Whether the value of inst lives somewhere; constants that fit in an immediate, say, need not. */
+  int (*needs_location)(const IrFunction *f, IrRef inst);
+  /** The mask of the registers inst overwrites, such as those a call does not preserve, or 0 */
+  uint32_t (*clobbers)(const IrFunction *f, IrRef inst);
+  /** The mask of the registers of the class that can hold the value of inst, such as vector registers for vectors */
+  uint32_t (*allowed_regs)(const IrFunction *f, IrRef inst);
+  /** The register the value of inst arrives in, such as a parameter's, to be kept there if free; or REG_NONE */
+  int (*preferred_reg)(const IrFunction *f, IrRef inst);
+} RegisterInfo;
+
+typedef struct {
+  int8_t *reg;  ///< by value: its register, or REG_NONE
+  int *spill_slot;  ///< by value: its spill slot, or -1
+  int *spill_sizes;  ///< by spill slot: its size, the size of the values it holds rounded up to 8 bytes
+  int n_spill_slots;
+  uint32_t used_regs;  ///< mask of registers assigned to some value
+  int n_intervals;
+  int n_spilled;
+} RegisterAllocation;
+
+/**
+ * Allocate registers for the values of f, emitted with its blocks in the given order, starting with the entry.
+ * Everything is allocated from f's arena.
+ */
+RegisterAllocation *linear_scan(IrFunction *f, const IrBlockRef *order, int n_order, const RegisterInfo *info);
@@ -1,142 +1,756 @@
 #include <assert.h>
-#include "visitor.h"
+#include <stdarg.h>
+#include <string.h>
+#include "ssa_visitor.h"
 #include "common.h"
+#include "vendor/klib/khash.h"
+
+// Builds the SSA IR of each function definition and passes it to the backend. Scalar locals never live in memory:
+// they are promoted to SSA values as they are parsed, with phis placed by the algorithm of Braun et al., "Simple and
+// Efficient Construction of Static Single Assignment Form" (CC 2013). Aggregates get stack slots.
+
+typedef enum {
+  SV_VALUE,  ///< an SSA value in ref
+  SV_VARIABLE,  ///< a scalar local promoted to SSA values, numbered var
+  SV_MEMORY,  ///< an object in memory at address ref
+  SV_GLOBAL,  ///< an object or function at file scope, named symbol; functions using an object materialize its address
+} SsaValueKind;
 
-// hypothetical version for testing
 typedef struct {
-  char *text;
-  int dest;
-  int is_unary_expr;
-} SsaInstruction;
-
-// typedef struct {
-//   const char *text;
-//   int dest;
-//   int src1;
-//   int src2;
-//   union {
-//     int64_t int64_val;
-//     double double_val;
-//   } immediate;
-//   int is_unary_expr;
-// } SsaInstruction;
+  const Type *type;
+  SsaValueKind kind;
+  union {
+    IrRef ref;
+    int var;
+    const char *symbol;
+  };
+} SsaValue;
+
+/** A phi placed in a block whose predecessors are not all known yet */
+typedef struct {
+  IrBlockRef block;
+  int var;
+  IrRef phi;
+} IncompletePhi;
+
+// (variable << 32 | block) -> its value at the end of block
+KHASH_MAP_INIT_INT64(CurrentDef, IrRef)
+// removed trivial phi -> the value that replaced it
+KHASH_MAP_INIT_INT(Replaced, IrRef)
 
 typedef struct {
-  VisitorHeader head;
-  DECLARE_VECTOR(SsaInstruction, instructions)
+  Visitor _visitor;
+  FILE *out;  ///< memstream holding the current function definition, or file_out outside of functions
+  FILE *file_out;
+  char *function_text;  ///< text of the last function definition
+  size_t function_text_size;
+  const char *function_name;  ///< of the last function definition
+  char *cache_entry;  ///< what function_text last returned, with the state of the backend
+  IrFunction *f;  ///< function being built, or NULL at file scope
+  IrBlockRef block;  ///< where instructions are appended
+  DECLARE_VECTOR(IrType, var_types)
+  DECLARE_VECTOR(int, sealed)  ///< indexed by block
+  DECLARE_VECTOR(IncompletePhi, incomplete_phis)
+  kh_CurrentDef_t *current_def;
+  kh_Replaced_t *replaced;
+  const IrBackend *backend;
+  VisitorOptions options;
 } SsaVisitor;
 
-static SsaInstruction *new_instruction(SsaVisitor *v) {
-  APPEND_VECTOR(v->instructions, (SsaInstruction) {0});
-  SsaInstruction *ret = &VECTOR_LAST(v->instructions);
-  int dest = v->instructions_size;
-  ret->dest = dest;
-  return ret;
+static const Type *type_of(const SsaValue *val) {
+  return val->type;
 }
 
-static void set_property(SsaInstruction *result, ParseProperty prop, int val) {
-  switch (prop) {
-    case PROP_IS_UNARY_EXPR:
-      result->is_unary_expr = val;
+static IrType ir_type(const Type *type) {
+  switch (type->kind) {
+    case TY_INTEGER:
+      switch (type->size) {
+        case 1: return IR_I8;
+        case 2: return IR_I16;
+        case 4: return IR_I32;
+        case 8: return IR_I64;
+      }
+      break;
+    case TY_POINTER:
+      return IR_PTR;
+    case TY_FLOAT:
+      switch (type->size) {
+        case 4: return IR_F32;
+        case 8: return IR_F64;
+      }
       break;
     default:
-      assert(0 && "unsupported property");
+      break;
+  }
+  THROWF(EXC_INTERNAL, "no IR type for type kind %d of size %d", type->kind, type->size);
+}
+
+static SsaValue *new_value(SsaVisitor *v, const Type *type, SsaValueKind kind) {
+  // Locals die with the function; globals outlive it.
+  SsaValue *ret = v->f ? arena_alloc(v->f->arena, sizeof(SsaValue)) : checked_calloc(1, sizeof(SsaValue));
+  ret->type = type;
+  ret->kind = kind;
+  return ret;
+}
+
+static SsaValue *new_ssa_value(SsaVisitor *v, const Type *type, IrRef ref) {
+  SsaValue *ret = new_value(v, type, SV_VALUE);
+  ret->ref = ref;
+  return ret;
+}
+
+static IrRef append(SsaVisitor *v, IrOp op, IrType type, int n_args, const IrRef *args, int64_t imm) {
+  return ir_append(v->f, v->block, op, type, n_args, args, imm);
+}
+
+static IrRef append_const(SsaVisitor *v, IrType type, int64_t val) {
+  return append(v, IR_CONST, type, 0, 0, val);
+}
+
+/** Emit an instruction that must dominate everything: after the params, slots and undefs at the top of the entry. */
+static IrRef append_to_entry(SsaVisitor *v, IrOp op, IrType type, int64_t imm) {
+  IrFunction *f = v->f;
+  IrRef inst = f->blocks[IR_ENTRY_BLOCK].first;
+  while (inst && (f->op[inst] == IR_PARAM || f->op[inst] == IR_SLOT || f->op[inst] == IR_UNDEF
+      || f->op[inst] == IR_GLOBAL)) {
+    inst = f->next[inst];
+  }
+  if (inst) {
+    return ir_insert_before(f, inst, op, type, 0, 0, imm);
+  }
+  return ir_append(f, IR_ENTRY_BLOCK, op, type, 0, 0, imm);
+}
+
+static IrBlockRef new_block(SsaVisitor *v) {
+  IrBlockRef b = ir_new_block(v->f);
+  while (v->sealed_size <= (int) b) {
+    APPEND_VECTOR(v->sealed, 0);
+  }
+  return b;
+}
+
+// Variables
+
+static IrRef resolve(SsaVisitor *v, IrRef ref) {
+  for (;;) {
+    khiter_t iter = kh_get_Replaced(v->replaced, ref);
+    if (iter == kh_end(v->replaced))
+      return ref;
+    ref = kh_val(v->replaced, iter);
+  }
+}
+
+static uint64_t def_key(int var, IrBlockRef b) {
+  return (uint64_t) var << 32 | b;
+}
+
+static void write_variable(SsaVisitor *v, int var, IrBlockRef b, IrRef value) {
+  int ret;
+  khiter_t iter = kh_put_CurrentDef(v->current_def, def_key(var, b), &ret);
+  THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+  kh_val(v->current_def, iter) = value;
+}
+
+static IrRef read_variable(SsaVisitor *v, int var, IrBlockRef b);
+
+static IrRef try_remove_trivial_phi(SsaVisitor *v, IrRef phi) {
+  IrFunction *f = v->f;
+  IrRef same = IR_NONE;
+  for (uint32_t i = 0; i < f->n_args[phi]; i++) {
+    IrRef arg = IR_ARG(f, phi, i);
+    if (arg == same || arg == phi)
+      continue;
+    if (same)
+      return phi;  // merges at least two values
+    same = arg;
+  }
+  if (!same) {
+    // unreachable, or in the entry block
+    same = append_to_entry(v, IR_UNDEF, f->type[phi], 0);
+  }
+
+  // Other phis using this one may become trivial in turn.
+  DECLARE_VECTOR(IrRef, phi_users)
+  NEW_VECTOR(phi_users, sizeof(IrRef));
+  IR_FOR_EACH_USE(f, phi, u) {
+    if (f->user[u] != phi && f->op[f->user[u]] == IR_PHI) {
+      APPEND_VECTOR(phi_users, f->user[u]);
+    }
+  }
+  ir_replace_uses(f, phi, same);
+  ir_remove(f, phi);
+  int ret;
+  khiter_t iter = kh_put_Replaced(v->replaced, phi, &ret);
+  THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+  kh_val(v->replaced, iter) = same;
+
+  for (int i = 0; i < phi_users_size; i++) {
+    if (f->block[phi_users[i]]) {
+      try_remove_trivial_phi(v, phi_users[i]);
+    }
+  }
+  free(phi_users);
+  return resolve(v, same);
+}
+
+static IrRef add_phi_operands(SsaVisitor *v, int var, IrRef phi) {
+  IrFunction *f = v->f;
+  const IrBlock *block = &f->blocks[f->block[phi]];
+  IrRef *values = arena_alloc(f->arena, block->n_preds * sizeof(IrRef));
+  for (uint32_t i = 0; i < block->n_preds; i++) {
+    values[i] = read_variable(v, var, block->preds[i]);
+  }
+  ir_set_phi_args(f, phi, values);
+  return try_remove_trivial_phi(v, phi);
+}
+
+static IrRef read_variable_recursive(SsaVisitor *v, int var, IrBlockRef b) {
+  IrFunction *f = v->f;
+  IrRef value;
+  if (!v->sealed[b]) {
+    value = ir_insert_phi(f, b, v->var_types[var]);
+    APPEND_VECTOR(v->incomplete_phis, ((IncompletePhi) { .block = b, .var = var, .phi = value }));
+  } else if (f->blocks[b].n_preds == 0) {
+    value = append_to_entry(v, IR_UNDEF, v->var_types[var], 0);
+  } else {
+    // Break cycles through loops with an operand-less phi. A block with one predecessor needs it too: a loop entered
+    // only from unreachable code has a header whose sole predecessor is its own back edge.
+    value = ir_insert_phi(f, b, v->var_types[var]);
+    write_variable(v, var, b, value);
+    value = add_phi_operands(v, var, value);
+  }
+  write_variable(v, var, b, value);
+  return value;
+}
+
+static IrRef read_variable(SsaVisitor *v, int var, IrBlockRef b) {
+  khiter_t iter = kh_get_CurrentDef(v->current_def, def_key(var, b));
+  if (iter != kh_end(v->current_def)) {
+    return resolve(v, kh_val(v->current_def, iter));
+  }
+  return read_variable_recursive(v, var, b);
+}
+
+/** Declare that all predecessors of b are known, completing the phis placed in it so far. */
+static void seal_block(SsaVisitor *v, IrBlockRef b) {
+  for (int i = 0; i < v->incomplete_phis_size; i++) {
+    IncompletePhi incomplete = v->incomplete_phis[i];
+    if (incomplete.block != b)
+      continue;
+    v->incomplete_phis[i--] = VECTOR_LAST(v->incomplete_phis);
+    POP_VECTOR_VOID(v->incomplete_phis);
+    if (v->f->block[incomplete.phi]) {
+      add_phi_operands(v, incomplete.var, incomplete.phi);
+    }
   }
+  v->sealed[b] = 1;
 }
 
-static int get_property(SsaInstruction *result, ParseProperty prop) {
-  switch (prop) {
-    case PROP_IS_UNARY_EXPR:
-      return result->is_unary_expr;
+// Values
+
+static IrRef address_of(SsaVisitor *v, SsaValue *val) {
+  switch (val->kind) {
+    case SV_MEMORY:
+      return val->ref;
+    case SV_GLOBAL:
+      return append_to_entry(v, IR_GLOBAL, IR_PTR, ir_intern_symbol(v->f, val->symbol));
     default:
-      assert(0 && "unsupported property");
+      THROWF(EXC_INTERNAL, "value of kind %d is not in memory", val->kind);
   }
-  
 }
-static void *visit_ident(SsaVisitor *v, const Type *type, int index, int offset) {
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(&inst->text, "t%d = address of local #%d (= (stack-%d) with size %d)", inst->dest, index, offset, type->size);
-  return inst;
+
+static IrRef rvalue(SsaVisitor *v, SsaValue *val) {
+  switch (val->kind) {
+    case SV_VALUE:
+      return val->ref;
+    case SV_VARIABLE:
+      return read_variable(v, val->var, v->block);
+    case SV_MEMORY: case SV_GLOBAL: {
+      IrRef addr = address_of(v, val);
+      if (val->type->kind == TY_ARRAY)
+        return addr;  // decays to a pointer to the first element
+      THROW_IF(!IS_SCALAR_TYPE(val->type), EXC_INTERNAL, "aggregate rvalues are not supported");
+      return append(v, IR_LOAD, ir_type(val->type), 1, &addr, 0);
+    }
+  }
+  THROWF(EXC_INTERNAL, "unknown value kind %d", val->kind);
 }
 
-static void *visit_float_literal(SsaVisitor *v, double double_val) {
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(&inst->text, "t%d = load immediate F64 $%g", inst->dest, double_val);
-  return inst;
+/** The value of the low bytes of val as an integer of the given type */
+static int64_t extend_constant(int64_t val, const Type *type) {
+  if (type->size == 8)
+    return val;
+  uint64_t mask = ((uint64_t) 1 << type->size * 8) - 1;
+  uint64_t bits = (uint64_t) val & mask;
+  if (!type->is_unsigned && type->kind != TY_POINTER && bits >> (type->size * 8 - 1))
+    bits |= ~mask;
+  return (int64_t) bits;
 }
 
-static void *visit_integer_literal(SsaVisitor *v, int64_t int64_val) {
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(&inst->text, "t%d = load immediate I64 $%llu", inst->dest, int64_val);
-  return inst;
+/**
+ * Convert a value to or from a floating type. Integers go through the signed i32 or i64 that SITOFP and FPTOSI take:
+ * narrower ones are extended to i32 and unsigned ints to i64 first, and conversions to them truncate the result.
+ */
+static IrRef convert_float(SsaVisitor *v, IrRef ref, const Type *from, const Type *to) {
+  IrFunction *f = v->f;
+  IrType to_type = ir_type(to);
+  if (f->op[ref] == IR_CONST) {
+    if (from->kind != TY_FLOAT) {
+      int64_t val = extend_constant(f->imm[ref], from);
+      double d = from->is_unsigned ? (double) (uint64_t) val : (double) val;
+      return append_const(v, to_type, ir_float_bits(to_type, d));
+    }
+    double d = ir_float_value(f->type[ref], f->imm[ref]);
+    if (to->kind == TY_FLOAT)
+      return append_const(v, to_type, ir_float_bits(to_type, d));
+    // Out of range is undefined, as in 6.3.1.4, so the cast to int64_t is as good as any result.
+    int64_t val = to->size == 8 && to->is_unsigned ? (int64_t) (uint64_t) d : (int64_t) d;
+    return append_const(v, to_type, extend_constant(val, to));
+  }
+  if (from->kind == TY_FLOAT && to->kind == TY_FLOAT)
+    return append(v, from->size < to->size ? IR_FPEXT : IR_FPTRUNC, to_type, 1, &ref, 0);
+  THROW_IF((from->kind == TY_FLOAT ? to : from)->size == 8 && (from->kind == TY_FLOAT ? to : from)->is_unsigned,
+    EXC_INTERNAL, "conversion between unsigned long and floating point is not supported yet");
+  if (from->kind != TY_FLOAT) {
+    const Type *wide = from->size < 4 ? &v->_visitor.int_type : from->is_unsigned ? &v->_visitor.long_type : from;
+    if (wide->size != from->size) {
+      IrOp extend = from->is_unsigned || from->kind == TY_POINTER ? IR_ZEXT : IR_SEXT;
+      ref = append(v, extend, ir_type(wide), 1, &ref, 0);
+    }
+    return append(v, IR_SITOFP, to_type, 1, &ref, 0);
+  }
+  const Type *wide = to->size < 4 ? &v->_visitor.int_type : to->is_unsigned ? &v->_visitor.long_type : to;
+  ref = append(v, IR_FPTOSI, ir_type(wide), 1, &ref, 0);
+  return wide->size == to->size ? ref : append(v, IR_TRUNC, to_type, 1, &ref, 0);
 }
 
-// For actual SSA, you need to realize every local variable so you can reassign. This thing is not SSA.
-static void *visit_assign(SsaVisitor *v, SsaInstruction *dest, SsaInstruction *source) {
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(
-    &inst->text,
-    "move content of t%d to t%d\nt%d = t%d",
-    source->dest,
-    dest->dest,
-    inst->dest,
-    dest->dest
-  );
-  return inst;
+/** Convert a value between types, extending integers according to the signedness of the source. */
+static IrRef convert(SsaVisitor *v, IrRef ref, const Type *from, const Type *to) {
+  if (from->kind == TY_FLOAT || to->kind == TY_FLOAT)
+    return changes_representation(from, to) ? convert_float(v, ref, from, to) : ref;
+  if (from->size == to->size)
+    return ref;
+  IrFunction *f = v->f;
+  if (f->op[ref] == IR_CONST) {
+    // Literal indices and offsets are common enough to be worth converting here.
+    return append_const(v, ir_type(to), extend_constant(extend_constant(f->imm[ref], from), to));
+  }
+  IrOp op = from->size > to->size ? IR_TRUNC : from->is_unsigned || from->kind == TY_POINTER ? IR_ZEXT : IR_SEXT;
+  return append(v, op, ir_type(to), 1, &ref, 0);
+}
+
+static IrRef add_offset(SsaVisitor *v, IrRef addr, IrRef offset) {
+  IrRef args[] = {addr, offset};
+  return append(v, IR_ADD, IR_PTR, 2, args, 0);
+}
+
+static SsaValue *visit_integer_literal(SsaVisitor *v, int64_t int64_val) {
+  // As in 6.4.4.1: int if it fits, else long
+  const Type *type = int64_val >= INT32_MIN && int64_val <= INT32_MAX ? &v->_visitor.int_type : &v->_visitor.long_type;
+  return new_ssa_value(v, type, append_const(v, ir_type(type), int64_val));
 }
 
-static void *visit_binop(SsaVisitor *v, TokenKind op, SsaInstruction *left, SsaInstruction *right) {
-  char *ssa_op;
+static SsaValue *visit_float_literal(SsaVisitor *v, double double_val) {
+  return new_ssa_value(v, &v->_visitor.double_type, append_const(v, IR_F64, ir_float_bits(IR_F64, double_val)));
+}
+
+static SsaValue *convert_type(SsaVisitor *v, SsaValue *value, const Type *new_type) {
+  return new_ssa_value(v, new_type, convert(v, rvalue(v, value), value->type, new_type));
+}
+
+static IrOp binop_to_ir(TokenKind op, int is_unsigned) {
   switch (op) {
-    case TOK_ADD_OP:
-      ssa_op = "add";
-      break;
-    case TOK_SUB_OP:
-      ssa_op = "sub";
-      break;
-    case TOK_STAR_OP:
-      ssa_op = "mul";
+    case TOK_ADD_OP: return IR_ADD;
+    case TOK_SUB_OP: return IR_SUB;
+    case TOK_STAR_OP: return IR_MUL;
+    case TOK_DIV_OP: return is_unsigned ? IR_UDIV : IR_SDIV;
+    case TOK_MOD_OP: return is_unsigned ? IR_UREM : IR_SREM;
+    case TOK_AMPERSAND_OP: return IR_AND;
+    case TOK_BIT_OR_OP: return IR_OR;
+    case TOK_XOR_OP: return IR_XOR;
+    case TOK_LEFT_OP: return IR_SHL;
+    case TOK_RIGHT_OP: return is_unsigned ? IR_SHR : IR_SAR;
+    case TOK_LT_OP: return is_unsigned ? IR_ULT : IR_SLT;
+    case TOK_RT_OP: return is_unsigned ? IR_UGT : IR_SGT;
+    case TOK_LE_OP: return is_unsigned ? IR_ULE : IR_SLE;
+    case TOK_GE_OP: return is_unsigned ? IR_UGE : IR_SGE;
+    case TOK_EQ_OP: return IR_EQ;
+    case TOK_NE_OP: return IR_NE;
+    default:
+      THROWF(EXC_INTERNAL, "Binop %s not supported", TOKEN_NAMES[op]);
+  }
+}
+
+static IrOp float_binop_to_ir(TokenKind op) {
+  switch (op) {
+    case TOK_ADD_OP: return IR_FADD;
+    case TOK_SUB_OP: return IR_FSUB;
+    case TOK_STAR_OP: return IR_FMUL;
+    case TOK_DIV_OP: return IR_FDIV;
+    case TOK_LT_OP: return IR_FLT;
+    case TOK_RT_OP: return IR_FGT;
+    case TOK_LE_OP: return IR_FLE;
+    case TOK_GE_OP: return IR_FGE;
+    case TOK_EQ_OP: return IR_FEQ;
+    case TOK_NE_OP: return IR_FNE;
+    default:
+      THROWF(EXC_PARSE_SYNTAX, "invalid operands to %s: floating point", TOKEN_NAMES[op]);
+  }
+}
+
+static SsaValue *visit_binop(SsaVisitor *v, TokenKind op, SsaValue *left, SsaValue *right) {
+  if (op == TOK_COMMA)
+    return right;
+  if (left->type->kind == TY_FLOAT || right->type->kind == TY_FLOAT) {
+    const Type *type = common_arithmetic_type((Visitor *) v, left->type, right->type);
+    IrRef args[] = {
+      convert(v, rvalue(v, left), left->type, type),
+      convert(v, rvalue(v, right), right->type, type),
+    };
+    IrOp ir_op = float_binop_to_ir(op);
+    const Type *result_type = ir_op >= IR_FEQ && ir_op <= IR_FGE ? &v->_visitor.int_type : type;
+    return new_ssa_value(v, result_type, append(v, ir_op, ir_type(result_type), 2, args, 0));
+  }
+  THROW_IF(left->type->kind != TY_INTEGER || right->type->kind != TY_INTEGER, EXC_INTERNAL,
+    "only integer arithmetic is supported yet");
+  // Shifts convert their operands separately, and have the type of the left one.
+  int is_shift = op == TOK_LEFT_OP || op == TOK_RIGHT_OP;
+  const Type *type = is_shift
+    ? promoted_type((Visitor *) v, left->type)
+    : common_arithmetic_type((Visitor *) v, left->type, right->type);
+  const Type *right_type = is_shift ? promoted_type((Visitor *) v, right->type) : type;
+  IrRef args[] = {
+    convert(v, rvalue(v, left), left->type, type),
+    convert(v, rvalue(v, right), right->type, right_type),
+  };
+  IrOp ir_op = binop_to_ir(op, type->is_unsigned);
+  int is_comparison = ir_op >= IR_EQ && ir_op <= IR_UGE;
+  const Type *result_type = is_comparison ? &v->_visitor.int_type : type;
+  return new_ssa_value(v, result_type, append(v, ir_op, ir_type(result_type), 2, args, 0));
+}
+
+static SsaValue *visit_assign(SsaVisitor *v, TokenKind op, SsaValue *left, SsaValue *right) {
+  if (op != TOK_ASSIGN_OP) {
+    right = visit_binop(v, assignment_binop(op), left, right);
+  }
+  if (!IS_SCALAR_TYPE(left->type)) {
+    // 6.5.16.1: the two are the same type, and so the same object or disjoint ones.
+    THROW_IF(total_size(left->type) != total_size(right->type), EXC_PARSE_SYNTAX,
+      "assignment of incompatible aggregates");
+    IrRef args[] = {address_of(v, left), address_of(v, right)};
+    append(v, IR_COPY, IR_VOID, 2, args, total_size(left->type));
+    return left;
+  }
+  IrRef value = convert(v, rvalue(v, right), right->type, left->type);
+  switch (left->kind) {
+    case SV_VARIABLE:
+      write_variable(v, left->var, v->block, value);
       break;
-    case TOK_DIV_OP:
-      ssa_op = "div";
+    case SV_MEMORY: case SV_GLOBAL: {
+      IrRef args[] = {address_of(v, left), value};
+      append(v, IR_STORE, IR_VOID, 2, args, 0);
       break;
-    case TOK_COMMA:
-      // special case; just return right
-      return right;
+    }
     default:
-      THROWF(EXC_INTERNAL, "Binop %s not supported", TOKEN_NAMES[op]);
+      THROW(EXC_PARSE_SYNTAX, "assignment to an rvalue");
   }
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(&inst->text, "t%d = %s t%d, t%d", inst->dest, ssa_op, left->dest, right->dest);
-  return inst;
+  return new_ssa_value(v, left->type, value);
 }
 
-static void dump(SsaVisitor *v, FILE *out) {
-  for (int i = 0; i < v->instructions_size; i++) {
-    fprintf(out, "%s\n", v->instructions[i].text);
+static SsaValue *visit_declaration(SsaVisitor *v, const Type *type, const char *ident) {
+  if (!v->f || type->kind == TY_FUNCTION) {
+    SsaValue *ret = new_value(v, type, SV_GLOBAL);
+    ret->symbol = ident;
+    if (type->kind != TY_FUNCTION) {
+      v->backend->emit_global(v->out, ident, total_size(type), align(type));
+    }
+    return ret;
   }
+  if (IS_SCALAR_TYPE(type)) {
+    SsaValue *ret = new_value(v, type, SV_VARIABLE);
+    ret->var = v->var_types_size;
+    APPEND_VECTOR(v->var_types, ir_type(type));
+    return ret;
+  }
+  SsaValue *ret = new_value(v, type, SV_MEMORY);
+  int slot = ir_new_slot(v->f, total_size(type), align(type));
+  ret->ref = append_to_entry(v, IR_SLOT, IR_PTR, slot);
+  return ret;
 }
 
-static void dump_result(FILE *out, SsaInstruction *expr) {
-  fprintf(out, "t%d", expr->dest);
+static void visit_function_definition_start(
+  SsaVisitor *v,
+  const char *ident,
+  const Type *type,
+  FunctionSpecifiers specifiers
+) {
+  v->f = new_ir_function(ident);
+  v->function_name = ident;
+  v->f->is_static = specifiers.is_static;
+  v->f->is_inline = specifiers.is_inline;
+  v->block = IR_ENTRY_BLOCK;
+  v->var_types_size = 0;
+  v->incomplete_phis_size = 0;
+  v->sealed_size = 0;
+  APPEND_VECTOR(v->sealed, 1);  // IR_NONE
+  APPEND_VECTOR(v->sealed, 1);  // the entry has no predecessors
+  kh_clear_CurrentDef(v->current_def);
+  kh_clear_Replaced(v->replaced);
+  // Buffer each function separately, so the driver can cache its text.
+  free(v->function_text);
+  v->out = checked_open_memstream(&v->function_text, &v->function_text_size);
 }
 
-static void *visit_declarator(SsaVisitor *v, int index, int offset) {
-  // make a new temp
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(&inst->text, "allocate local #%d  # top of stack = stack-%d", index, offset);
-  return inst;
+static SsaValue *visit_function_definition_param(SsaVisitor *v, const Type *type, const char *ident) {
+  SsaValue *ret = visit_declaration(v, type, ident);
+  assert(ret->kind == SV_VARIABLE);
+  IrRef param = append_to_entry(v, IR_PARAM, ir_type(type), v->f->n_params++);
+  write_variable(v, ret->var, IR_ENTRY_BLOCK, param);
+  return ret;
+}
+
+/** Code after a return is unreachable, but still has to go somewhere. */
+static void start_unreachable_block(SsaVisitor *v) {
+  v->block = new_block(v);
+  seal_block(v, v->block);
+}
+
+static void visit_return(SsaVisitor *v, SsaValue *retval) {
+  IrRef value = retval ? rvalue(v, retval) : IR_NONE;
+  append(v, IR_RET, IR_VOID, retval ? 1 : 0, &value, 0);
+  start_unreachable_block(v);
+}
+
+/** Whether the current block is known never to run: it has no predecessors and can get none, as after a jump. */
+static int is_unreachable(SsaVisitor *v) {
+  return v->block != IR_ENTRY_BLOCK && v->sealed[v->block] && !v->f->blocks[v->block].n_preds;
+}
+
+/** A label is the block starting at it. */
+static IrBlockRef *new_label(SsaVisitor *v) {
+  IrBlockRef *ret = arena_alloc(v->f->arena, sizeof(IrBlockRef));
+  *ret = new_block(v);
+  return ret;
 }
 
-static void *visit_function_definition(SsaVisitor *v, int function_name, const Type *function_type) {
-  SsaInstruction *inst = new_instruction(v);
-  checked_asprintf(&inst->text, ".Lfunction_%d  # return type %d, %d parameters", function_name, function_type->return_type->kind, function_type->n_params);
-  return inst;
+static void jump_to(SsaVisitor *v, IrBlockRef b) {
+  append(v, IR_JMP, IR_VOID, 0, 0, 0);
+  ir_add_edge(v->f, v->block, b);
+}
+
+static void visit_label(SsaVisitor *v, IrBlockRef *label) {
+  if (!is_unreachable(v)) {
+    jump_to(v, *label);
+  }
+  v->block = *label;
+}
+
+static void visit_jump(SsaVisitor *v, IrBlockRef *label) {
+  if (!is_unreachable(v)) {
+    jump_to(v, *label);
+  }
+  start_unreachable_block(v);
+}
+
+static void visit_branch(SsaVisitor *v, SsaValue *cond, int jump_if, IrBlockRef *label) {
+  THROW_IF(!IS_SCALAR_TYPE(cond->type), EXC_PARSE_SYNTAX, "condition is not a scalar");
+  if (is_unreachable(v))
+    return;
+  IrRef value = rvalue(v, cond);
+  if (cond->type->kind == TY_FLOAT) {
+    IrType type = ir_type(cond->type);
+    IrRef args[] = {value, append_const(v, type, ir_float_bits(type, 0))};
+    value = append(v, IR_FNE, IR_I32, 2, args, 0);
+  }
+  IrBlockRef from = v->block, fallthrough = new_block(v);
+  append(v, IR_BR, IR_VOID, 1, &value, 0);
+  ir_add_edge(v->f, from, jump_if ? *label : fallthrough);
+  ir_add_edge(v->f, from, jump_if ? fallthrough : *label);
+  v->block = fallthrough;
+  seal_block(v, fallthrough);
+}
+
+/** A switch ends its block; the cases it compares with are constants in it. */
+static void visit_switch(SsaVisitor *v, SsaValue *value, int n_cases, const int64_t *values, IrBlockRef **labels,
+  IrBlockRef *default_label) {
+  if (is_unreachable(v))
+    return;
+  IrType type = ir_type(value->type);
+  IrRef *args = checked_calloc(n_cases + 1, sizeof(IrRef));
+  args[0] = rvalue(v, value);
+  for (int i = 0; i < n_cases; i++) {
+    args[i + 1] = append_const(v, type, values[i]);
+  }
+  append(v, IR_SWITCH, IR_VOID, n_cases + 1, args, 0);
+  free(args);
+  ir_add_edge(v->f, v->block, *default_label);
+  for (int i = 0; i < n_cases; i++) {
+    ir_add_edge(v->f, v->block, *labels[i]);
+  }
+  start_unreachable_block(v);
+}
+
+static void seal_label(SsaVisitor *v, IrBlockRef *label) {
+  seal_block(v, *label);
+}
+
+static SsaValue *visit_array_reference(SsaVisitor *v, SsaValue *array, SsaValue *index, int lvalue) {
+  THROW_IF(array->type->kind != TY_ARRAY, EXC_PARSE_SYNTAX, "subscripted value is not an array");
+  const Type *child_type = array->type->child_type;
+  IrRef offset = convert(v, rvalue(v, index), index->type, &v->_visitor.long_type);
+  int element_size = total_size(child_type);
+  if (v->f->op[offset] == IR_CONST) {
+    offset = append_const(v, IR_I64, v->f->imm[offset] * element_size);
+  } else if (element_size != 1) {
+    IrRef args[] = {offset, append_const(v, IR_I64, element_size)};
+    offset = append(v, IR_MUL, IR_I64, 2, args, 0);
+  }
+  SsaValue *ret = new_value(v, child_type, SV_MEMORY);
+  ret->ref = add_offset(v, address_of(v, array), offset);
+  return ret;
 }
 
-VisitorHeader *new_ssa_visitor() {
+static SsaValue *visit_struct_reference(SsaVisitor *v, SsaValue *left, const Member *member) {
+  SsaValue *ret = new_value(v, member->type, SV_MEMORY);
+  ret->ref = address_of(v, left);
+  if (member->offset) {
+    ret->ref = add_offset(v, ret->ref, append_const(v, IR_I64, member->offset));
+  }
+  return ret;
+}
+
+// Functions of the standard library that do not return, whichever way they were declared
+static const char *const noreturn_functions[] = {"abort", "exit", "_Exit", "quick_exit", "longjmp", "__assert_fail",
+  "__assert_rtn"};
+
+static int is_noreturn(const SsaValue *function) {
+  for (size_t i = 0; i < sizeof(noreturn_functions) / sizeof(noreturn_functions[0]); i++) {
+    if (!strcmp(function->symbol, noreturn_functions[i]))
+      return 1;
+  }
+  return function->type->is_noreturn;
+}
+
+static SsaValue *visit_call(SsaVisitor *v, SsaValue *function, int n_args, SsaValue **args) {
+  assert(function->kind == SV_GLOBAL);
+  v->f->blocks[v->block].calls_noreturn |= is_noreturn(function);
+  IrRef *refs = arena_alloc(v->f->arena, n_args * sizeof(IrRef));
+  for (int i = 0; i < n_args; i++) {
+    refs[i] = rvalue(v, args[i]);
+  }
+  const Type *type = function->type->return_type;
+  IrType ret_type = type->kind == TY_VOID ? IR_VOID : ir_type(type);
+  return new_ssa_value(v, type, append(v, IR_CALL, ret_type, n_args, refs, ir_intern_symbol(v->f, function->symbol)));
+}
+
+static void visit_zero_object(SsaVisitor *v, SsaValue *object) {
+  IrRef addr = address_of(v, object);
+  append(v, IR_ZERO, IR_VOID, 1, &addr, total_size(object->type));
+}
+
+static void visit_assign_offset(SsaVisitor *v, SsaValue *aggregate, int offset, SsaValue *right) {
+  IrRef addr = address_of(v, aggregate);
+  if (offset) {
+    addr = add_offset(v, addr, append_const(v, IR_I64, offset));
+  }
+  IrRef args[] = {addr, rvalue(v, right)};
+  append(v, IR_STORE, IR_VOID, 2, args, 0);
+}
+
+static void visit_function_end(SsaVisitor *v) {
+  if (!ir_terminator(v->f, v->block)) {
+    append(v, IR_RET, IR_VOID, 0, 0, 0);
+  }
+  assert(v->incomplete_phis_size == 0);
+  ir_remove_unreachable_blocks(v->f);
+  ir_verify(v->f);
+  v->backend->emit_function(v->out, v->f, &v->options);
+  free_ir_function(v->f);
+  v->f = 0;
+
+  checked_fclose(v->out);
+  v->out = v->file_out;
+  fputs(v->function_text, v->out);
+}
+
+static void emit_comment(SsaVisitor *v, const char *fmt, ...) {
+  // Source positions would only clutter the dump.
+}
+
+/**
+ * The text of the function. If the backend saves state with it, that comes first, as its decimal length, a newline,
+ * then the state itself, for visit_cached_function to restore.
+ */
+static const char *function_text(SsaVisitor *v) {
+  if (!v->backend->save_function)
+    return v->function_text;
+  char *state;
+  size_t state_size;
+  FILE *out = checked_open_memstream(&state, &state_size);
+  v->backend->save_function(out, v->function_name);
+  checked_fclose(out);
+  free(v->cache_entry);
+  checked_asprintf(&v->cache_entry, "%zu\n%s%s", state_size, state, v->function_text);
+  free(state);
+  return v->cache_entry;
+}
+
+static void visit_cached_function(SsaVisitor *v, const char *text) {
+  assert(v->out == v->file_out && "cannot replay a function inside another");
+  if (v->backend->restore_function) {
+    char *end;
+    size_t len = strtoul(text, &end, 10);
+    THROW_IF(*end != '\n' || strlen(end + 1) < len, EXC_SYSTEM, "corrupt cached function state");
+    if (len) {
+      FILE *in = checked_fmemopen(end + 1, len, "r");
+      v->backend->restore_function(in);
+      checked_fclose(in);
+    }
+    text = end + 1 + len;
+  }
+  fputs(text, v->out);
+}
+
+static void finalize(SsaVisitor *v) {
+  if (v->backend->finish) {
+    v->backend->finish(v->file_out);
+  }
+  checked_fclose(v->file_out);
+}
+
+static void dump_global(FILE *out, const char *name, int size, int align) {
+  fprintf(out, "global @%s (%d bytes, align %d)\n\n", name, size, align);
+}
+
+static void dump_function(FILE *out, IrFunction *f, const VisitorOptions *options) {
+  fprint_ir_function(out, f);
+  fputc('\n', out);
+}
+
+static const IrBackend dump_backend = {
+  .emit_global = dump_global,
+  .emit_function = dump_function,
+};
+
+Visitor *new_ssa_visitor(FILE *out, const VisitorOptions *options) {
+  return new_ssa_backend_visitor(out, options, &dump_backend);
+}
+
+Visitor *new_ssa_backend_visitor(FILE *out, const VisitorOptions *options, const IrBackend *backend) {
   SsaVisitor *v = checked_calloc(1, sizeof(SsaVisitor));
-  NEW_VECTOR(v->instructions, sizeof(SsaInstruction));
   INSTALL_VISITOR_METHODS(v)
-  return (VisitorHeader *) v;
+  init_lp64_types((Visitor *) v);
+  v->out = out;
+  v->file_out = out;
+  NEW_VECTOR(v->var_types, sizeof(IrType));
+  NEW_VECTOR(v->sealed, sizeof(int));
+  NEW_VECTOR(v->incomplete_phis, sizeof(IncompletePhi));
+  v->current_def = kh_init_CurrentDef();
+  v->replaced = kh_init_Replaced();
+  v->backend = backend;
+  v->options = *options;
+  if (backend->start) {
+    backend->start(out, options);
+  }
+  return (Visitor *) v;
 }
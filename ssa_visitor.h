@@ -0,0 +1,29 @@
+/** SSA construction: a visitor that builds the IR of each function definition and hands it to an IR backend. */
+
+#pragma once
+#include <stdio.h>
+#include "ir.h"
+#include "visitor.h"
+
+/** What to do with the IR; the default backend prints it. */
+typedef struct IrBackend {
+  /** Called once, before anything else is written to out */
+  void (*start)(FILE *out, const VisitorOptions *options);
+  /** An object at file scope, without initializer */
+  void (*emit_global)(FILE *out, const char *name, int size, int align);
+  /** A complete, verified function definition. The backend may transform f. */
+  void (*emit_function)(FILE *out, IrFunction *f, const VisitorOptions *options);
+  /** Called once after the translation unit, e.g. to report statistics */
+  void (*finish)(FILE *out);
+  /**
+   * Write what the functions after the one named name take from it besides its text, for the cache to keep with
+   * that. Optional.
+   */
+  void (*save_function)(FILE *out, const char *name);
+  /** Read back what save_function wrote, for a function replayed from the cache instead of emitted */
+  void (*restore_function)(FILE *in);
+} IrBackend;
+
+/** Print the IR of each function, as in golden/\*_ssa.txt. */
+Visitor *new_ssa_visitor(FILE *out, const VisitorOptions *options);
+Visitor *new_ssa_backend_visitor(FILE *out, const VisitorOptions *options, const IrBackend *backend);
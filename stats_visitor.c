@@ -0,0 +1,200 @@
+#include <assert.h>
+#include "visitor.h"
+#include "common.h"
+
+// Statistics about the parsed program, one line per function definition and a total, for tracking how the input
+// exercises the backends. Emits no code.
+
+typedef struct {
+  const Type *type;
+} StatsValue;
+
+typedef struct {
+  int n_params;
+  int n_locals;
+  int local_bytes;
+  int n_literals;
+  int n_operators;  ///< binary operators and conversions
+  int n_assignments;
+  int n_branches;
+  int n_returns;
+  int n_references;  ///< array and struct member references
+  int n_calls;
+} StatsCounts;
+
+typedef struct {
+  Visitor _visitor;
+  FILE *out;
+  const char *function;  ///< name of the function being visited, or NULL at file scope
+  int n_functions;
+  int n_globals;
+  StatsCounts counts;  ///< for the current function
+  StatsCounts total;
+} StatsVisitor;
+
+static const Type *type_of(const StatsValue *val) {
+  return val->type;
+}
+
+static StatsValue *new_value(const Type *type) {
+  StatsValue *ret = checked_calloc(1, sizeof(*ret));
+  ret->type = type;
+  return ret;
+}
+
+static void fprint_counts(FILE *out, const StatsCounts *c) {
+  fprintf(
+    out,
+    "%d params, %d locals (%d bytes), %d literals, %d operators, %d assignments, %d branches, %d returns, "
+    "%d references, %d calls\n",
+    c->n_params, c->n_locals, c->local_bytes, c->n_literals, c->n_operators, c->n_assignments, c->n_branches,
+    c->n_returns, c->n_references, c->n_calls
+  );
+}
+
+static StatsValue *convert_type(StatsVisitor *v, StatsValue *value, const Type *new_type) {
+  v->counts.n_operators++;
+  return new_value(new_type);
+}
+
+static StatsValue *visit_float_literal(StatsVisitor *v, double double_val) {
+  v->counts.n_literals++;
+  return new_value(&v->_visitor.double_type);
+}
+
+static StatsValue *visit_integer_literal(StatsVisitor *v, int64_t int64_val) {
+  v->counts.n_literals++;
+  int fits_int = int64_val >= INT32_MIN && int64_val <= INT32_MAX;
+  return new_value(fits_int ? &v->_visitor.int_type : &v->_visitor.long_type);
+}
+
+static StatsValue *visit_binop(StatsVisitor *v, TokenKind op, StatsValue *left, StatsValue *right) {
+  v->counts.n_operators++;
+  return new_value(right->type->size > left->type->size ? right->type : left->type);
+}
+
+static StatsValue *visit_assign(StatsVisitor *v, TokenKind op, StatsValue *left, StatsValue *right) {
+  v->counts.n_assignments++;
+  return left;
+}
+
+static StatsValue *visit_declaration(StatsVisitor *v, const Type *type, const char *ident) {
+  if (type->kind == TY_FUNCTION) {
+    // counted when defined
+  } else if (v->function) {
+    v->counts.n_locals++;
+    v->counts.local_bytes += total_size(type);
+  } else {
+    v->n_globals++;
+  }
+  return new_value(type);
+}
+
+static void visit_function_definition_start(
+  StatsVisitor *v,
+  const char *ident,
+  const Type *type,
+  FunctionSpecifiers specifiers
+) {
+  v->function = ident;
+  v->counts = (StatsCounts) {0};
+}
+
+static StatsValue *visit_function_definition_param(StatsVisitor *v, const Type *type, const char *ident) {
+  v->counts.n_params++;
+  return new_value(type);
+}
+
+static void visit_function_end(StatsVisitor *v) {
+  assert(v->function);
+  fprintf(v->out, "%s: ", v->function);
+  fprint_counts(v->out, &v->counts);
+  v->n_functions++;
+  v->total.n_params += v->counts.n_params;
+  v->total.n_locals += v->counts.n_locals;
+  v->total.local_bytes += v->counts.local_bytes;
+  v->total.n_literals += v->counts.n_literals;
+  v->total.n_operators += v->counts.n_operators;
+  v->total.n_assignments += v->counts.n_assignments;
+  v->total.n_branches += v->counts.n_branches;
+  v->total.n_returns += v->counts.n_returns;
+  v->total.n_references += v->counts.n_references;
+  v->total.n_calls += v->counts.n_calls;
+  v->function = 0;
+}
+
+static void visit_return(StatsVisitor *v, StatsValue *retval) {
+  v->counts.n_returns++;
+}
+
+static StatsValue *visit_array_reference(StatsVisitor *v, StatsValue *array, StatsValue *index, int lvalue) {
+  v->counts.n_references++;
+  return new_value(array->type->child_type);
+}
+
+static StatsValue *visit_struct_reference(StatsVisitor *v, StatsValue *left, const Member *member) {
+  v->counts.n_references++;
+  return new_value(member->type);
+}
+
+static StatsValue *visit_call(StatsVisitor *v, StatsValue *function, int n_args, StatsValue **args) {
+  v->counts.n_calls++;
+  return new_value(function->type->return_type);
+}
+
+static void visit_zero_object(StatsVisitor *v, StatsValue *object) {
+  v->counts.n_assignments++;
+}
+
+static void visit_assign_offset(StatsVisitor *v, StatsValue *aggregate, int offset, StatsValue *right) {
+  v->counts.n_assignments++;
+}
+
+static void *new_label(StatsVisitor *v) {
+  return 0;
+}
+
+static void visit_label(StatsVisitor *v, void *label) {
+}
+
+static void visit_jump(StatsVisitor *v, void *label) {
+}
+
+static void visit_branch(StatsVisitor *v, StatsValue *cond, int jump_if, void *label) {
+  v->counts.n_branches++;
+}
+
+static void visit_switch(StatsVisitor *v, StatsValue *value, int n_cases, const int64_t *values, void **labels,
+  void *default_label) {
+  v->counts.n_branches++;
+}
+
+static void seal_label(StatsVisitor *v, void *label) {
+}
+
+static void emit_comment(StatsVisitor *v, const char *fmt, ...) {
+}
+
+static const char *function_text(StatsVisitor *v) {
+  return 0;
+}
+
+static void visit_cached_function(StatsVisitor *v, const char *text) {
+  THROW(EXC_INTERNAL, "stats visitor never produces function text to cache");
+}
+
+static void finalize(StatsVisitor *v) {
+  fprintf(v->out, "total: %d functions, %d globals, ", v->n_functions, v->n_globals);
+  fprint_counts(v->out, &v->total);
+  if (v->out != stderr) {
+    checked_fclose(v->out);
+  }
+}
+
+Visitor *new_stats_visitor(FILE *out, const VisitorOptions *options) {
+  StatsVisitor *v = checked_calloc(1, sizeof(StatsVisitor));
+  INSTALL_VISITOR_METHODS(v)
+  init_lp64_types((Visitor *) v);
+  v->out = out;
+  return (Visitor *) v;
+}
@@ -0,0 +1,310 @@
+#include "strength.h"
+
+#include <assert.h>
+#include <string.h>
+#include "common.h"
+
+__extension__ typedef unsigned __int128 uint128;
+
+// Cost in instructions of each kind of step; a shift-and-add copies x first.
+static const int STEP_COSTS[] = {
+  [MUL_SHIFT] = 1,
+  [MUL_LEA] = 1,
+  [MUL_SHIFT_ADD] = 3,
+  [MUL_SHIFT_SUB] = 3,
+  [MUL_NEG] = 1,
+};
+
+// imul has a latency of three cycles; a longer sequence of single-cycle instructions does not pay.
+#define MAX_MUL_COST 3
+
+int exact_log2(uint64_t x) {
+  return x && !(x & (x - 1)) ? __builtin_ctzll(x) : -1;
+}
+
+static int is_lea_factor(uint64_t m) {
+  return m == 3 || m == 5 || m == 9;
+}
+
+static void add_step(MulPlan *plan, MulStepKind kind, int amount) {
+  plan->steps[plan->n_steps++] = (MulStep) { .kind = kind, .amount = amount };
+}
+
+int plan_multiplication(int64_t factor, MulPlan *plan) {
+  if (factor == 0)
+    return 0;
+  uint64_t magnitude = factor < 0 ? -(uint64_t) factor : (uint64_t) factor;
+  int shift = __builtin_ctzll(magnitude);
+  uint64_t odd = magnitude >> shift;
+  plan->n_steps = 0;
+
+  // The odd part by lea, one lea of another, or a shift of a copy; then the power of two and the sign.
+  if (odd == 1) {
+    // a power of two: the shift alone
+  } else if (is_lea_factor(odd)) {
+    add_step(plan, MUL_LEA, odd - 1);
+  } else if (odd % 3 == 0 && is_lea_factor(odd / 3)) {
+    add_step(plan, MUL_LEA, 2);
+    add_step(plan, MUL_LEA, odd / 3 - 1);
+  } else if (odd % 5 == 0 && is_lea_factor(odd / 5)) {
+    add_step(plan, MUL_LEA, 4);
+    add_step(plan, MUL_LEA, odd / 5 - 1);
+  } else if (odd % 9 == 0 && is_lea_factor(odd / 9)) {
+    add_step(plan, MUL_LEA, 8);
+    add_step(plan, MUL_LEA, odd / 9 - 1);
+  } else if (exact_log2(odd - 1) > 0) {
+    add_step(plan, MUL_SHIFT_ADD, exact_log2(odd - 1));
+  } else if (exact_log2(odd + 1) > 0) {
+    add_step(plan, MUL_SHIFT_SUB, exact_log2(odd + 1));
+  } else {
+    return 0;
+  }
+  int cost = 0;
+  for (int i = 0; i < plan->n_steps; i++) {
+    cost += STEP_COSTS[plan->steps[i].kind];
+  }
+  cost += (shift > 0) + (factor < 0);
+  if (cost > MAX_MUL_COST)
+    return 0;
+  if (shift > 0) {
+    add_step(plan, MUL_SHIFT, shift);
+  }
+  if (factor < 0) {
+    add_step(plan, MUL_NEG, 0);
+  }
+  return 1;
+}
+
+/** x, taken as a bits-wide two's complement integer */
+static int64_t sign_extend(uint64_t x, int bits) {
+  if (bits == 64)
+    return (int64_t) x;
+  uint64_t sign = (uint64_t) 1 << (bits - 1);
+  x &= (sign << 1) - 1;
+  return (int64_t) ((x ^ sign) - sign);
+}
+
+DivisionMagic signed_division_magic(int64_t divisor, int bits) {
+  assert(exact_log2(divisor < 0 ? -(uint64_t) divisor : (uint64_t) divisor) < 0);
+  // Hacker's Delight, figure 10-1, for any width up to 64 bits: find the least p such that 2^p exceeds
+  // nc * (|d| - 2^p mod |d|), nc being the largest dividend for which the quotient is exact plus one.
+  uint64_t top = (uint64_t) 1 << (bits - 1);
+  uint64_t ad = divisor < 0 ? -(uint64_t) divisor : (uint64_t) divisor;
+  uint64_t t = top + (divisor < 0);
+  uint64_t anc = t - 1 - t % ad;
+  int p = bits - 1;
+  uint64_t q1 = top / anc, r1 = top - q1 * anc;
+  uint64_t q2 = top / ad, r2 = top - q2 * ad;
+  uint64_t delta;
+  do {
+    p++;
+    q1 *= 2;
+    r1 *= 2;
+    if (r1 >= anc) {
+      q1++;
+      r1 -= anc;
+    }
+    q2 *= 2;
+    r2 *= 2;
+    if (r2 >= ad) {
+      q2++;
+      r2 -= ad;
+    }
+    delta = ad - r2;
+  } while (q1 < delta || (q1 == delta && r1 == 0));
+
+  int64_t multiplier = sign_extend(divisor < 0 ? -(q2 + 1) : q2 + 1, bits);
+  int add = divisor > 0 && multiplier < 0 ? 1 : divisor < 0 && multiplier > 0 ? -1 : 0;
+  return (DivisionMagic) { .multiplier = multiplier, .shift = p - bits, .add = add };
+}
+
+DivisionMagic unsigned_division_magic(uint64_t divisor, int bits) {
+  assert(exact_log2(divisor) < 0 && divisor < (uint64_t) 1 << (bits - 1));
+  int l = 64 - __builtin_clzll(divisor);  // ceil(log2(divisor)), as divisor is no power of two
+  // Granlund and Montgomery, theorem 4.2: m = ceil(2^(bits + s) / d) is exact for every dividend if it overshoots
+  // 2^(bits + s) / d by at most 2^s / d. The smallest such s that leaves m within bits bits needs no correction.
+  for (int s = 0; s < l; s++) {
+    uint128 power = (uint128) 1 << (bits + s);
+    uint128 m = (power + divisor - 1) / divisor;
+    if (m >> bits)
+      break;
+    if (m * divisor - power <= (uint128) 1 << s)
+      return (DivisionMagic) { .multiplier = (int64_t) (uint64_t) m, .shift = s, .add = 0 };
+  }
+  // Otherwise the multiplier has bits + 1 bits. Figure 4.1 keeps the low ones and adds the top one back as x.
+  uint128 m = ((uint128) 1 << bits) * (((uint128) 1 << l) - divisor) / divisor + 1;
+  return (DivisionMagic) { .multiplier = (int64_t) (uint64_t) m, .shift = l, .add = 1 };
+}
+
+static char suffix(int size) {
+  return size == 8 ? 'q' : 'l';
+}
+
+static const char *rax_name(int size) {
+  return size == 8 ? "%rax" : "%eax";
+}
+
+static const char *rdx_name(int size) {
+  return size == 8 ? "%rdx" : "%edx";
+}
+
+void fprint_multiplication(FILE *out, const MulPlan *plan, int size, const char *x, const char *x64) {
+  char s = suffix(size);
+  for (int i = 0; i < plan->n_steps; i++) {
+    MulStep step = plan->steps[i];
+    switch (step.kind) {
+      case MUL_SHIFT:
+        fprintf(out, "\tshl%c\t$%d, %s\n", s, step.amount, x);
+        break;
+      case MUL_LEA:
+        fprintf(out, "\tlea%c\t(%s,%s,%d), %s\n", s, x64, x64, step.amount, x);
+        break;
+      case MUL_SHIFT_ADD:
+      case MUL_SHIFT_SUB:
+        fprintf(out, "\tmov%c\t%s, %s\n", s, x, rax_name(size));
+        fprintf(out, "\tshl%c\t$%d, %s\n", s, step.amount, x);
+        fprintf(out, "\t%s%c\t%s, %s\n", step.kind == MUL_SHIFT_ADD ? "add" : "sub", s, rax_name(size), x);
+        break;
+      case MUL_NEG:
+        fprintf(out, "\tneg%c\t%s\n", s, x);
+        break;
+    }
+  }
+}
+
+/** The divisor as the division reads it */
+static int64_t divisor_value(ConstantDivision division) {
+  if (division.size == 8)
+    return division.divisor;
+  return division.is_signed ? (int32_t) division.divisor : (int64_t) (uint32_t) division.divisor;
+}
+
+static uint64_t divisor_magnitude(ConstantDivision division) {
+  int64_t divisor = divisor_value(division);
+  return division.is_signed && divisor < 0 ? -(uint64_t) divisor : (uint64_t) divisor;
+}
+
+int divides_without_div(ConstantDivision division) {
+  if (division.size != 4 && division.size != 8)
+    return 0;
+  int64_t divisor = divisor_value(division);
+  uint64_t magnitude = divisor_magnitude(division);
+  int exponent = exact_log2(magnitude);
+  if (magnitude == 0 || (!division.is_quotient && (divisor < INT32_MIN || divisor > INT32_MAX)))
+    return 0;
+  if (exponent < 0 && !division.is_signed && magnitude >> (division.size * 8 - 1))
+    return 0;
+  // The bias or mask of a power of two must fit in an immediate.
+  return exponent <= 31 || (!division.is_signed && division.is_quotient);
+}
+
+/** Turn the quotient in rdx into the remainder in result: x - quotient * divisor. */
+static void fprint_remainder(FILE *out, ConstantDivision division, const char *x, const char *result) {
+  char s = suffix(division.size);
+  const char *rdx = rdx_name(division.size);
+  fprintf(out, "\timul%c\t$%lld, %s, %s\n", s, (long long) divisor_value(division), rdx, rdx);
+  if (strcmp(x, result)) {
+    fprintf(out, "\tmov%c\t%s, %s\n", s, x, result);
+  }
+  fprintf(out, "\tsub%c\t%s, %s\n", s, rdx, result);
+}
+
+void fprint_division(FILE *out, ConstantDivision division, const char *x, const char *x64, const char *result) {
+  assert(divides_without_div(division));
+  int size = division.size, bits = size * 8;
+  char s = suffix(size);
+  const char *rax = rax_name(size), *rdx = rdx_name(size);
+  int64_t divisor = divisor_value(division);
+  uint64_t magnitude = divisor_magnitude(division);
+  int exponent = exact_log2(magnitude);
+
+  if (exponent == 0) {
+    if (!division.is_quotient) {
+      fprintf(out, "\tmov%c\t$0, %s\n", s, result);
+      return;
+    }
+    if (strcmp(x, result)) {
+      fprintf(out, "\tmov%c\t%s, %s\n", s, x, result);
+    }
+    if (divisor < 0) {
+      fprintf(out, "\tneg%c\t%s\n", s, result);
+    }
+    return;
+  }
+  if (exponent > 0 && !division.is_signed) {
+    if (strcmp(x, result)) {
+      fprintf(out, "\tmov%c\t%s, %s\n", s, x, result);
+    }
+    if (division.is_quotient) {
+      fprintf(out, "\tshr%c\t$%d, %s\n", s, exponent, result);
+    } else {
+      fprintf(out, "\tand%c\t$%llu, %s\n", s, (unsigned long long) magnitude - 1, result);
+    }
+    return;
+  }
+  if (exponent > 0) {
+    // Negative dividends are biased by |divisor| - 1, so that the arithmetic shift rounds toward zero.
+    fprintf(out, "\tlea%c\t%llu(%s), %s\n", s, (unsigned long long) magnitude - 1, x64, rax);
+    fprintf(out, "\ttest%c\t%s, %s\n", s, x, x);
+    fprintf(out, "\tcmovns%c\t%s, %s\n", s, x, rax);
+    if (division.is_quotient) {
+      fprintf(out, "\tsar%c\t$%d, %s\n", s, exponent, rax);
+      if (divisor < 0) {
+        fprintf(out, "\tneg%c\t%s\n", s, rax);
+      }
+      fprintf(out, "\tmov%c\t%s, %s\n", s, rax, result);
+    } else {
+      fprintf(out, "\tand%c\t$%lld, %s\n", s, -(long long) magnitude, rax);
+      if (strcmp(x, result)) {
+        fprintf(out, "\tmov%c\t%s, %s\n", s, x, result);
+      }
+      fprintf(out, "\tsub%c\t%s, %s\n", s, rax, result);
+    }
+    return;
+  }
+
+  if (division.is_signed) {
+    DivisionMagic magic = signed_division_magic(divisor, bits);
+    if (size == 8 && (magic.multiplier < INT32_MIN || magic.multiplier > INT32_MAX)) {
+      fprintf(out, "\tmovabsq\t$%lld, %%rax\n", (long long) magic.multiplier);
+    } else {
+      fprintf(out, "\tmov%c\t$%lld, %s\n", s, (long long) magic.multiplier, rax);
+    }
+    fprintf(out, "\timul%c\t%s\n", s, x);
+    if (magic.add) {
+      fprintf(out, "\t%s%c\t%s, %s\n", magic.add > 0 ? "add" : "sub", s, x, rdx);
+    }
+    if (magic.shift) {
+      fprintf(out, "\tsar%c\t$%d, %s\n", s, magic.shift, rdx);
+    }
+    // Truncate toward zero: a negative quotient came out one too small.
+    fprintf(out, "\tmov%c\t%s, %s\n", s, rdx, rax);
+    fprintf(out, "\tshr%c\t$%d, %s\n", s, bits - 1, rax);
+    fprintf(out, "\tadd%c\t%s, %s\n", s, rax, rdx);
+  } else {
+    DivisionMagic magic = unsigned_division_magic(magnitude, bits);
+    if (size == 8 && (uint64_t) magic.multiplier > INT32_MAX) {
+      fprintf(out, "\tmovabsq\t$%lld, %%rax\n", (long long) magic.multiplier);
+    } else {
+      fprintf(out, "\tmov%c\t$%lld, %s\n", s, (long long) (size == 4 ? (int32_t) magic.multiplier : magic.multiplier),
+        rax);
+    }
+    fprintf(out, "\tmul%c\t%s\n", s, x);
+    int shift = magic.shift;
+    if (magic.add) {
+      fprintf(out, "\tmov%c\t%s, %s\n", s, x, rax);
+      fprintf(out, "\tsub%c\t%s, %s\n", s, rdx, rax);
+      fprintf(out, "\tshr%c\t%s\n", s, rax);
+      fprintf(out, "\tadd%c\t%s, %s\n", s, rax, rdx);
+      shift--;
+    }
+    if (shift) {
+      fprintf(out, "\tshr%c\t$%d, %s\n", s, shift, rdx);
+    }
+  }
+  if (division.is_quotient) {
+    fprintf(out, "\tmov%c\t%s, %s\n", s, rdx, result);
+  } else {
+    fprint_remainder(out, division, x, result);
+  }
+}
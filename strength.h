@@ -0,0 +1,83 @@
+/**
+ * Strength reduction of multiplication and division by constants, shared by the backends. Multiplication becomes a
+ * short sequence of shifts, lea and add; division becomes a shift, or a multiplication by a "magic" reciprocal keeping
+ * the high half of the product (Granlund and Montgomery, "Division by Invariant Integers using Multiplication", PLDI
+ * 1994; Warren, "Hacker's Delight", chapter 10).
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+  MUL_SHIFT,  ///< x <<= amount
+  MUL_LEA,  ///< x += x * amount, for amount 2, 4 or 8: lea (x,x,amount), x
+  MUL_SHIFT_ADD,  ///< x = (x << amount) + x, through a copy of x
+  MUL_SHIFT_SUB,  ///< x = (x << amount) - x, through a copy of x
+  MUL_NEG,  ///< x = -x
+} MulStepKind;
+
+typedef struct {
+  MulStepKind kind;
+  int amount;
+} MulStep;
+
+#define MAX_MUL_STEPS 3
+
+/** Steps that, applied in order to x, compute x * factor modulo the width of x */
+typedef struct {
+  int n_steps;
+  MulStep steps[MAX_MUL_STEPS];
+} MulPlan;
+
+/** Divide by high_multiply(x, multiplier), corrected by x, then shifted, as in Hacker's Delight 10-1 and 10-8 */
+typedef struct {
+  int64_t multiplier;  ///< bits wide, to be read as signed or unsigned like the division
+  int shift;
+  /**
+   * Signed: +1 or -1 to add or subtract x from the high half before shifting, or 0. Unsigned: 1 if the multiplier
+   * lacks its top bit, which is made up for by computing ((x - high) >> 1) + high, then shifting by shift - 1.
+   */
+  int add;
+} DivisionMagic;
+
+/** log2 of x if x is a power of two, else -1 */
+int exact_log2(uint64_t x);
+
+/** Plan a multiplication by factor cheaper than imul, if there is one; otherwise return 0. */
+int plan_multiplication(int64_t factor, MulPlan *plan);
+
+/** Magic numbers for signed division of bits-wide integers by divisor, which is neither 0, 1, -1 nor a power of two */
+DivisionMagic signed_division_magic(int64_t divisor, int bits);
+
+/**
+ * Magic numbers for unsigned division of bits-wide integers by divisor, which is not a power of two and is below
+ * 2^(bits - 1): larger divisors leave a quotient of 0 or 1, cheaper to get by comparing.
+ */
+DivisionMagic unsigned_division_magic(uint64_t divisor, int bits);
+
+/** A division, or remainder, of size-byte integers by a constant */
+typedef struct {
+  int64_t divisor;  ///< only its low size bytes count, read as signed or unsigned like the division
+  int size;
+  int is_signed;
+  int is_quotient;  ///< or else the remainder
+} ConstantDivision;
+
+/**
+ * Whether division can be done without div: all but division by zero, unsigned division by half the range or more,
+ * and signed division by powers of two beyond 2^31 or remainders by divisors not fitting in an immediate.
+ */
+int divides_without_div(ConstantDivision division);
+
+/**
+ * Print the instructions of a multiplication of the size-byte register x, named by size as "%esi" and by x64 as
+ * "%rsi", planned by plan_multiplication. %rax is clobbered.
+ */
+void fprint_multiplication(FILE *out, const MulPlan *plan, int size, const char *x, const char *x64);
+
+/**
+ * Print the instructions of a division for which divides_without_div holds, of the size-byte register x into the
+ * register result, which may be x. Neither may be %rax or %rdx, which are clobbered.
+ */
+void fprint_division(FILE *out, ConstantDivision division, const char *x, const char *x64, const char *result);
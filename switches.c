@@ -0,0 +1,185 @@
+#include "switches.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+
+// A jump table pays for its indirect jump, which predicts worse than a compare, from this many cases on.
+#define MIN_JUMP_TABLE_CASES 4
+// and while at least one entry in this many is a case: the rest hold the default.
+#define MAX_JUMP_TABLE_SPREAD 4
+// Bit tests cover targets of cases within the bits of one register, at most this many targets.
+#define MAX_BIT_TEST_TARGETS 3
+// A subtree of the compare tree with this many cases or fewer tests them one by one.
+#define MAX_LINEAR_CASES 3
+
+// By number of targets: the cases bit tests need to cost fewer branches than comparing with each case.
+static const int min_bit_test_cases[MAX_BIT_TEST_TARGETS + 1] = {0, 3, 5, 6};
+
+static const char *const accum_names[] = {[4] = "%eax", [8] = "%rax"};
+static const char suffixes[] = {[4] = 'l', [8] = 'q'};
+
+static int compare_cases(const void *a, const void *b) {
+  int64_t x = ((const SwitchCase *) a)->value, y = ((const SwitchCase *) b)->value;
+  return (x > y) - (x < y);
+}
+
+/** The distance from the least value to the greatest, of sorted cases */
+static uint64_t case_range(const SwitchCase *cases, int n_cases) {
+  return (uint64_t) cases[n_cases - 1].value - (uint64_t) cases[0].value;
+}
+
+/** The number of distinct labels of the cases, stopping once it exceeds max */
+static int count_targets(const SwitchCase *cases, int n_cases, int max) {
+  int ret = 0;
+  for (int i = 0; i < n_cases && ret <= max; i++) {
+    int k = 0;
+    while (k < i && strcmp(cases[k].label, cases[i].label)) {
+      k++;
+    }
+    ret += k == i;
+  }
+  return ret;
+}
+
+static SwitchStrategy choose_strategy(const SwitchCase *cases, int n_cases) {
+  if (!n_cases)
+    return SWITCH_COMPARE_TREE;
+  uint64_t range = case_range(cases, n_cases);
+  int n_targets = count_targets(cases, n_cases, MAX_BIT_TEST_TARGETS);
+  // Bit tests first: they need no memory and no indirect jump.
+  if (range < 64 && n_targets <= MAX_BIT_TEST_TARGETS && n_cases >= min_bit_test_cases[n_targets])
+    return SWITCH_BIT_TESTS;
+  if (n_cases >= MIN_JUMP_TABLE_CASES && range < (uint64_t) n_cases * MAX_JUMP_TABLE_SPREAD)
+    return SWITCH_JUMP_TABLE;
+  return SWITCH_COMPARE_TREE;
+}
+
+SwitchStrategy switch_strategy(SwitchCase *cases, int n_cases, int size) {
+  for (int i = 0; i < n_cases && size == 4; i++) {
+    cases[i].value = (int32_t) cases[i].value;
+  }
+  qsort(cases, n_cases, sizeof(SwitchCase), compare_cases);
+  return choose_strategy(cases, n_cases);
+}
+
+/** The source operand for the immediate val, of size bytes; one that does not fit in 32 bits is put in %rdx first. */
+static const char *immediate(FILE *out, int size, int64_t val) {
+  if (size == 4)
+    return fmtstr("$%d", (int32_t) val);
+  if (val >= INT32_MIN && val <= INT32_MAX)
+    return fmtstr("$%lld", (long long) val);
+  fprintf(out, "\tmovabsq\t$%lld, %%rdx\n", (long long) val);
+  return "%rdx";
+}
+
+/** Subtract the least case from the value, and go to default_label unless the result is in the range of the cases. */
+static void fprint_range_check(FILE *out, int size, const SwitchCase *cases, int n_cases, const char *default_label) {
+  if (cases[0].value) {
+    fprintf(out, "\tsub%c\t%s, %s\n", suffixes[size], immediate(out, size, cases[0].value), accum_names[size]);
+  }
+  fprintf(out, "\tcmp%c\t$%llu, %s\n\tja\t%s\n", suffixes[size], (unsigned long long) case_range(cases, n_cases),
+    accum_names[size], default_label);
+}
+
+static void fprint_jump_table(FILE *out, int size, const SwitchCase *cases, int n_cases, const char *default_label,
+  const char *prefix) {
+  fprint_range_check(out, size, cases, n_cases, default_label);
+  // The entries are offsets from the table, which keeps them 4 bytes and the code position-independent.
+  const char *table = fmtstr("%s_table", prefix);
+  fprintf(out, "\tleaq\t%s(%%rip), %%rcx\n\tmovslq\t(%%rcx,%%rax,4), %%rdx\n\taddq\t%%rcx, %%rdx\n\tjmpq\t*%%rdx\n",
+    table);
+  fprintf(out, "\t.const\n\t.p2align\t2\n%s:\n", table);
+  uint64_t range = case_range(cases, n_cases);
+  int i = 0;
+  for (uint64_t offset = 0; offset <= range; offset++) {
+    const char *label = default_label;
+    if ((uint64_t) cases[i].value - (uint64_t) cases[0].value == offset) {
+      label = cases[i++].label;
+    }
+    fprintf(out, "\t.long\t%s-%s\n", label, table);
+  }
+  fputs("\t.text\n", out);
+}
+
+static void fprint_bit_tests(FILE *out, int size, const SwitchCase *cases, int n_cases, const char *default_label) {
+  fprint_range_check(out, size, cases, n_cases, default_label);
+  for (int i = 0; i < n_cases; i++) {
+    int k = 0;
+    while (k < i && strcmp(cases[k].label, cases[i].label)) {
+      k++;
+    }
+    if (k < i)
+      continue;  // its target was tested with the first case going there
+    uint64_t mask = 0;
+    for (int j = i; j < n_cases; j++) {
+      if (!strcmp(cases[j].label, cases[i].label)) {
+        mask |= (uint64_t) 1 << ((uint64_t) cases[j].value - (uint64_t) cases[0].value);
+      }
+    }
+    if (mask <= UINT32_MAX) {
+      fprintf(out, "\tmovl\t$%llu, %%ecx\n", (unsigned long long) mask);  // which clears the upper half
+    } else {
+      fprintf(out, "\tmovabsq\t$%llu, %%rcx\n", (unsigned long long) mask);
+    }
+    fprintf(out, "\tbtq\t%%rax, %%rcx\n\tjb\t%s\n", cases[i].label);
+  }
+  fprintf(out, "\tjmp\t%s\n", default_label);
+}
+
+/** Print the comparisons finding the value among cases[lo] to cases[hi - 1], naming their labels from prefix. */
+static void fprint_compare_tree(FILE *out, int size, const SwitchCase *cases, int lo, int hi,
+  const char *default_label, const char *prefix, int *n_labels) {
+  const char *accum = accum_names[size];
+  if (hi - lo <= MAX_LINEAR_CASES) {
+    // The most taken case first; in the order of the values if none was, or there is no profile
+    uint8_t tested[MAX_LINEAR_CASES] = {0};
+    for (int n = lo; n < hi; n++) {
+      int i = -1;
+      for (int k = lo; k < hi; k++) {
+        i = !tested[k - lo] && (i < 0 || cases[k].count > cases[i].count) ? k : i;
+      }
+      tested[i - lo] = 1;
+      fprintf(out, "\tcmp%c\t%s, %s\n\tje\t%s\n", suffixes[size], immediate(out, size, cases[i].value), accum,
+        cases[i].label);
+    }
+    fprintf(out, "\tjmp\t%s\n", default_label);
+    return;
+  }
+  int mid = lo + (hi - lo) / 2;
+  const char *above = fmtstr("%s_%d", prefix, (*n_labels)++);
+  fprintf(out, "\tcmp%c\t%s, %s\n\tje\t%s\n\tjg\t%s\n", suffixes[size], immediate(out, size, cases[mid].value),
+    accum, cases[mid].label, above);
+  fprint_compare_tree(out, size, cases, lo, mid, default_label, prefix, n_labels);
+  fprintf(out, "%s:\n", above);
+  fprint_compare_tree(out, size, cases, mid + 1, hi, default_label, prefix, n_labels);
+}
+
+void fprint_switch(FILE *out, int size, const SwitchCase *cases, int n_cases, const char *default_label,
+  uint64_t default_count, const char *prefix) {
+  int n_labels = 0;
+  SwitchStrategy strategy = choose_strategy(cases, n_cases);
+  uint64_t total = default_count;
+  int hottest = 0;
+  for (int i = 0; i < n_cases; i++) {
+    total += cases[i].count;
+    hottest = cases[i].count > cases[hottest].count ? i : hottest;
+  }
+  // A tree small enough to test its cases one by one puts the hottest first anyway.
+  if (n_cases && cases[hottest].count > total - cases[hottest].count
+    && (strategy != SWITCH_COMPARE_TREE || n_cases > MAX_LINEAR_CASES)) {
+    fprintf(out, "\tcmp%c\t%s, %s\n\tje\t%s\n", suffixes[size], immediate(out, size, cases[hottest].value),
+      accum_names[size], cases[hottest].label);
+  }
+  switch (strategy) {
+    case SWITCH_JUMP_TABLE:
+      fprint_jump_table(out, size, cases, n_cases, default_label, prefix);
+      break;
+    case SWITCH_BIT_TESTS:
+      fprint_bit_tests(out, size, cases, n_cases, default_label);
+      break;
+    case SWITCH_COMPARE_TREE:
+      fprint_compare_tree(out, size, cases, 0, n_cases, default_label, prefix, &n_labels);
+      break;
+  }
+}
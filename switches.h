@@ -0,0 +1,40 @@
+/**
+ * Dispatching switch statements, shared by the backends. Each switch takes whichever of three forms suits the number
+ * and spread of its cases: an indirect jump through a table of the targets of the values in their range, when enough
+ * of them are cases that a branch per case costs more than the table's holes; a test of a bit of a mask per target,
+ * when a few targets share cases within 64 values of each other; and otherwise a balanced tree of comparisons, which
+ * takes about log2 of the cases of them instead of one per case. With a profile, a case taken more often than all the
+ * others together is tested for before any of that, and the last few tests of a tree go from the most taken case down.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+  SWITCH_COMPARE_TREE,  ///< a binary search of the cases by comparisons, ending in a few tests for equality
+  SWITCH_BIT_TESTS,  ///< a range check, then per target a bt of the mask of its cases
+  SWITCH_JUMP_TABLE,  ///< a range check, then an indirect jump through a table in read-only data
+} SwitchStrategy;
+
+/** The code for value starts at label. Cases with the same label go to the same place. */
+typedef struct {
+  int64_t value;
+  const char *label;
+  uint64_t count;  ///< times the case was taken, from a profile; 0 without one
+} SwitchCase;
+
+/**
+ * Put the cases of a switch on values of size bytes in order, and return how it dispatches to them. Any order of the
+ * values serves to search them, as long as the comparisons follow it; they are sorted as signed, of size bytes.
+ */
+SwitchStrategy switch_strategy(SwitchCase *cases, int n_cases, int size);
+
+/**
+ * Print the dispatch of a switch on the value in %eax, or %rax if size is 8, to the label of its case, or else to
+ * default_label. A 4-byte value must have the upper half of %rax clear, as writing %eax leaves it. The cases are those
+ * switch_strategy sorted. default_count is the times the profile took the default, if there is one. The labels of the
+ * code and of the table are named from prefix. %rax, %rcx and %rdx are clobbered.
+ */
+void fprint_switch(FILE *out, int size, const SwitchCase *cases, int n_cases, const char *default_label,
+  uint64_t default_count, const char *prefix);
@@ -51,6 +51,7 @@ typedef struct Type {
       int n_params;
       const Type *return_type;
       const Type **param_types;
+      unsigned is_noreturn : 1;  ///< declared _Noreturn: calls to it do not return
     };
   };
 } Type;
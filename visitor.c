@@ -0,0 +1,108 @@
+#include <assert.h>
+#include "visitor.h"
+#include "common.h"
+
+int total_size(const Type *type) {
+  // TODO: Support variable sized arrays, and structs with flexible members
+  return type->kind == TY_ARRAY ? type->size * total_size(type->child_type) : type->size;
+}
+
+int child_size(const Type *type) {
+  assert(type->child_type && "child_size called on an object without a child_type!");
+  return total_size(type->child_type);
+}
+
+int align(const Type *type) {
+  if (IS_SCALAR_TYPE(type)) {
+    return type->size;
+  }
+  if (type->kind == TY_ARRAY) {
+    return align(type->child_type);
+  }
+  if (type->kind == TY_STRUCT || type->kind == TY_UNION) {
+    return type->align;
+  }
+  THROWF(EXC_INTERNAL, "Unsupported type kind %d", type->kind);
+}
+
+/** 6.3.1.1 Integer promotions: anything narrower than int becomes int, which can represent all of its values. */
+const Type *promoted_type(const Visitor *v, const Type *type) {
+  if (type->kind == TY_INTEGER && type->size < v->int_type.size)
+    return &v->int_type;
+  return type;
+}
+
+const Type *argument_promoted_type(const Visitor *v, const Type *type) {
+  if (type->kind == TY_FLOAT && type->size < v->double_type.size)
+    return &v->double_type;
+  return promoted_type(v, type);
+}
+
+/** 6.3.1.8 Usual arithmetic conversions. The wider floating type wins over any integer; among integers, width. */
+const Type *common_arithmetic_type(const Visitor *v, const Type *t1, const Type *t2) {
+  if (t1->kind == TY_FLOAT || t2->kind == TY_FLOAT) {
+    if (t1->kind != TY_FLOAT)
+      return t2;
+    if (t2->kind != TY_FLOAT)
+      return t1;
+    return t1->size >= t2->size ? t1 : t2;
+  }
+  t1 = promoted_type(v, t1);
+  t2 = promoted_type(v, t2);
+  if (t1->is_unsigned == t2->is_unsigned)
+    return t1->size >= t2->size ? t1 : t2;
+  const Type *u = t1->is_unsigned ? t1 : t2;
+  const Type *s = t1->is_unsigned ? t2 : t1;
+  // If the signed type is wider, it can represent every value of the unsigned one.
+  return u->size >= s->size ? u : s;
+}
+
+int changes_representation(const Type *from, const Type *to) {
+  return from->size != to->size || (from->kind == TY_FLOAT) != (to->kind == TY_FLOAT);
+}
+
+void init_lp64_types(Visitor *v) {
+  v->char_type        = (Type) { .kind = TY_INTEGER, .size = 1,  .align = 1  };
+  v->short_type       = (Type) { .kind = TY_INTEGER, .size = 2,  .align = 2  };
+  v->int_type         = (Type) { .kind = TY_INTEGER, .size = 4,  .align = 4  };
+  v->long_type        = (Type) { .kind = TY_INTEGER, .size = 8,  .align = 8  };
+  v->long_long_type   = (Type) { .kind = TY_INTEGER, .size = 8,  .align = 8  };
+  v->float_type       = (Type) { .kind = TY_FLOAT,   .size = 4,  .align = 4  };
+  v->double_type      = (Type) { .kind = TY_FLOAT,   .size = 8,  .align = 8  };
+  v->long_double_type = (Type) { .kind = TY_FLOAT,   .size = 16, .align = 16 };
+  MAKE_ALL_UNSIGNED_TYPES(v);
+}
+
+void copy_primitive_types(Visitor *dst, const Visitor *src) {
+  dst->pointer_size = src->pointer_size;
+  dst->char_type = src->char_type;
+  dst->unsigned_char_type = src->unsigned_char_type;
+  dst->short_type = src->short_type;
+  dst->unsigned_short_type = src->unsigned_short_type;
+  dst->int_type = src->int_type;
+  dst->unsigned_int_type = src->unsigned_int_type;
+  dst->long_type = src->long_type;
+  dst->unsigned_long_type = src->unsigned_long_type;
+  dst->long_long_type = src->long_long_type;
+  dst->unsigned_long_long_type = src->unsigned_long_long_type;
+  dst->float_type = src->float_type;
+  dst->double_type = src->double_type;
+  dst->long_double_type = src->long_double_type;
+}
+
+TokenKind assignment_binop(TokenKind op) {
+  switch (op) {
+    case TOK_MUL_ASSIGN: return TOK_STAR_OP;
+    case TOK_DIV_ASSIGN: return TOK_DIV_OP;
+    case TOK_MOD_ASSIGN: return TOK_MOD_OP;
+    case TOK_ADD_ASSIGN: return TOK_ADD_OP;
+    case TOK_SUB_ASSIGN: return TOK_SUB_OP;
+    case TOK_LEFT_ASSIGN: return TOK_LEFT_OP;
+    case TOK_RIGHT_ASSIGN: return TOK_RIGHT_OP;
+    case TOK_AND_ASSIGN: return TOK_AMPERSAND_OP;
+    case TOK_XOR_ASSIGN: return TOK_XOR_OP;
+    case TOK_OR_ASSIGN: return TOK_BIT_OR_OP;
+    default:
+      THROWF(EXC_INTERNAL, "%s is not an assignment operator", TOKEN_NAMES[op]);
+  }
+}
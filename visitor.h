@@ -10,11 +10,17 @@ typedef int (*TypeSize)(const Type *type);
 typedef void *(*VisitFloatLiteral)(Visitor *v, double double_val);
 typedef void *(*VisitIntegerLiteral)(Visitor *v, int64_t int64_val);
 typedef void *(*VisitBinop)(Visitor *v, TokenKind op, void *left, void *right);
-typedef void *(*VisitConditional)(Visitor *v, TokenKind op, int jump, void *left, void *right);
-typedef void *(*ConvertType)(void *value, const Type *new_type);
+typedef void *(*ConvertType)(Visitor *v, void *value, const Type *new_type);
+/** What the specifiers of a function definition say beyond its type */
+typedef struct FunctionSpecifiers {
+  unsigned is_inline : 1;
+  unsigned is_static : 1;  ///< internal linkage: every call to it is in this translation unit
+} FunctionSpecifiers;
 typedef void (*VisitFunctionDefinitionStart)(
   Visitor *v,
-  const char *ident
+  const char *ident,
+  const Type *type,
+  FunctionSpecifiers specifiers
 );
 typedef void *(*VisitDeclaration)(
   Visitor *v,
@@ -30,11 +36,38 @@ typedef void (*VisitVoid1)(Visitor *v, void *left);
 typedef void *(*VisitArrayReference)(void *visitor, void *array, void *element, int lvalue);
 typedef void *(*VisitStructReference)(void *visitor, void *left, const Member *member);
 typedef int (*Predicate)(void *visitor, void *expr);
-typedef Visitor *(*VisitorConstructor)(FILE *out); 
+/** Call function, a value of function type, with args already converted to its parameter types, or promoted. */
+typedef void *(*VisitCall)(Visitor *v, void *function, int n_args, void **args);
+
+/** Options set by the driver. Zero initialized means the defaults, except for opt_level. */
+typedef struct VisitorOptions {
+  int no_timestamp;  ///< Omit the timestamp header, so output is deterministic and cacheable
+  int opt_level;  ///< -O level; the driver defaults to 1, which enables constant folding
+  int vector_size;  ///< bytes in the vectors loops are vectorized to at -O 2: 16 for SSE2, 32 for AVX2, 0 for none
+  int omit_frame_pointer;  ///< at -O 2, address the frame from %rsp in functions that call others too, not only leaves
+  const char *profile_generate;  ///< at -O 2, count the runs of each block, to be added to this file at exit
+  const char *profile_use;  ///< at -O 2, lay out, order and inline functions by the counts in this file
+} VisitorOptions;
+
+typedef Visitor *(*VisitorConstructor)(FILE *out, const VisitorOptions *options);
 typedef void (*VisitorFinalizer)(Visitor *v);
 typedef void *(*VisitAggregateReference)(void *visitor, void *object, int n_indices, const int *indices);
 typedef void (*VisitAssignOffset)(void *visitor, void *aggregate, int offset, void *right);
 typedef void (*EmitComment)(void *visitor, const char *fmt, ...);
+/** Text emitted for the last function definition, or NULL if the backend does not produce text. */
+typedef const char *(*FunctionText)(Visitor *v);
+/** Emit the text of a function definition previously returned by function_text, instead of visiting it. */
+typedef void (*VisitCachedFunction)(Visitor *v, const char *text);
+/** A jump target in the current function, to be placed by visit_label */
+typedef void *(*NewLabel)(Visitor *v);
+/** Jump to label if cond is nonzero and jump_if is set, or if cond is zero and jump_if is not; else fall through. */
+typedef void (*VisitBranch)(Visitor *v, void *cond, int jump_if, void *label);
+/**
+ * Jump to labels[i] if value, of a promoted integer type, equals values[i], or else to default_label. The values are
+ * distinct and of the type of value; cases sharing a label go to the same code.
+ */
+typedef void (*VisitSwitch)(Visitor *v, void *value, int n_cases, const int64_t *values, void **labels,
+  void *default_label);
 
 // TODO: Macrofy this
 // abstract type
@@ -49,7 +82,6 @@ typedef struct Visitor {
   VisitIntegerLiteral visit_integer_literal;
   VisitBinop visit_binop;  // really just arithmetic
   VisitBinop visit_assign;
-  VisitConditional visit_conditional;
   VisitDeclaration visit_declaration;
   VisitFunctionDefinitionStart visit_function_definition_start;
   VisitDeclaration visit_function_definition_param;
@@ -57,9 +89,19 @@ typedef struct Visitor {
   VisitVoid1 visit_return;
   VisitArrayReference visit_array_reference;
   VisitStructReference visit_struct_reference;
+  VisitCall visit_call;
   VisitVoid1 visit_zero_object;
   VisitAssignOffset visit_assign_offset;
   EmitComment emit_comment;
+  FunctionText function_text;
+  VisitCachedFunction visit_cached_function;
+  // Control flow within a function. Code before a label falls through to it.
+  NewLabel new_label;
+  VisitVoid1 visit_label;  // place the label here
+  VisitVoid1 visit_jump;
+  VisitBranch visit_branch;
+  VisitSwitch visit_switch;
+  VisitVoid1 seal_label;  // no more jumps to the label will be visited
   // Primitive types
   int pointer_size;
   Type char_type;
@@ -78,7 +120,24 @@ typedef struct Visitor {
   // child fields go here
 } Visitor;
 
-// TODO: hoist generic methods to visitor.c
+// Generic methods, shared by visitors whose targets lay out types the same way
+int total_size(const Type *type);
+int child_size(const Type *type);
+int align(const Type *type);
+/** 6.3.1.1 Integer promotions of an integer type */
+const Type *promoted_type(const Visitor *v, const Type *type);
+/** 6.5.2.2 Default argument promotions: the integer promotions, and float to double */
+const Type *argument_promoted_type(const Visitor *v, const Type *type);
+/** 6.3.1.8 Usual arithmetic conversions of two arithmetic types */
+const Type *common_arithmetic_type(const Visitor *v, const Type *t1, const Type *t2);
+/** Whether converting a value from one scalar type to another changes its representation, not just its meaning */
+int changes_representation(const Type *from, const Type *to);
+/** The binary operator of a compound assignment operator, e.g. TOK_ADD_OP for TOK_ADD_ASSIGN */
+TokenKind assignment_binop(TokenKind op);
+/** Primitive types of the LP64 data model (x86_64 System V, and Mach-O). */
+void init_lp64_types(Visitor *v);
+/** For visitors that wrap another: take over its target's primitive types. */
+void copy_primitive_types(Visitor *dst, const Visitor *src);
 
 // helper to install methods
 #define INSTALL(v, ty, f) (v)->_visitor.f = (ty) f;
@@ -93,7 +152,6 @@ typedef struct Visitor {
   INSTALL(v, VisitIntegerLiteral, visit_integer_literal); \
   INSTALL(v, VisitBinop, visit_binop); \
   INSTALL(v, VisitBinop, visit_assign); \
-  INSTALL(v, VisitConditional, visit_conditional); \
   INSTALL(v, VisitDeclaration, visit_declaration); \
   INSTALL(v, VisitFunctionDefinitionStart, visit_function_definition_start); \
   INSTALL(v, VisitDeclaration, visit_function_definition_param); \
@@ -101,9 +159,18 @@ typedef struct Visitor {
   INSTALL(v, VisitVoid1, visit_return); \
   INSTALL(v, VisitArrayReference, visit_array_reference); \
   INSTALL(v, VisitStructReference, visit_struct_reference); \
+  INSTALL(v, VisitCall, visit_call); \
   INSTALL(v, VisitVoid1, visit_zero_object); \
   INSTALL(v, VisitAssignOffset, visit_assign_offset); \
   INSTALL(v, EmitComment, emit_comment); \
+  INSTALL(v, FunctionText, function_text); \
+  INSTALL(v, VisitCachedFunction, visit_cached_function); \
+  INSTALL(v, NewLabel, new_label); \
+  INSTALL(v, VisitVoid1, visit_label); \
+  INSTALL(v, VisitVoid1, visit_jump); \
+  INSTALL(v, VisitBranch, visit_branch); \
+  INSTALL(v, VisitSwitch, visit_switch); \
+  INSTALL(v, VisitVoid1, seal_label); \
 
 #define MAKE_UNSIGNED_TYPE(v, ty) v->unsigned_##ty = v->ty; v->unsigned_##ty.is_unsigned = 1
 
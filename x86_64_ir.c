@@ -0,0 +1,1992 @@
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include "ir_opt.h"
+#include "memops.h"
+#include "peephole.h"
+#include "profile.h"
+#include "regalloc.h"
+#include "ssa_visitor.h"
+#include "strength.h"
+#include "switches.h"
+#include "common.h"
+#include "vendor/klib/khash.h"
+
+// The optimizing x86_64 backend: lowers the SSA IR of each function, with values in registers chosen by linear scan.
+// Constants, stack slot and global addresses, and constant offsets from those, never occupy registers; they are folded
+// into the instructions using them as immediates and addressing modes. Floating constants are read from a literal pool
+// after the function instead, as x86 has no floating immediates; floating values live in XMM registers, computed with
+// SSE2's scalar instructions.
+
+typedef enum {
+  RAX, RCX, RDX, RBX, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15,
+  XMM0, XMM1, XMM2, XMM3, XMM4, XMM5, XMM6, XMM7, XMM8, XMM9, XMM10, XMM11, XMM12, XMM13, XMM14, XMM15,
+  N_X86_REGS
+} X86Reg;
+
+#define XMM_NAMES_(n) {[16] = "%xmm" #n, [32] = "%ymm" #n}
+
+static const char *const reg_names[N_X86_REGS][33] = {
+  [RAX] = {[1] = "%al", [2] = "%ax", [4] = "%eax", [8] = "%rax"},
+  [RCX] = {[1] = "%cl", [2] = "%cx", [4] = "%ecx", [8] = "%rcx"},
+  [RDX] = {[1] = "%dl", [2] = "%dx", [4] = "%edx", [8] = "%rdx"},
+  [RBX] = {[1] = "%bl", [2] = "%bx", [4] = "%ebx", [8] = "%rbx"},
+  [RSI] = {[1] = "%sil", [2] = "%si", [4] = "%esi", [8] = "%rsi"},
+  [RDI] = {[1] = "%dil", [2] = "%di", [4] = "%edi", [8] = "%rdi"},
+  [R8] = {[1] = "%r8b", [2] = "%r8w", [4] = "%r8d", [8] = "%r8"},
+  [R9] = {[1] = "%r9b", [2] = "%r9w", [4] = "%r9d", [8] = "%r9"},
+  [R10] = {[1] = "%r10b", [2] = "%r10w", [4] = "%r10d", [8] = "%r10"},
+  [R11] = {[1] = "%r11b", [2] = "%r11w", [4] = "%r11d", [8] = "%r11"},
+  [R12] = {[1] = "%r12b", [2] = "%r12w", [4] = "%r12d", [8] = "%r12"},
+  [R13] = {[1] = "%r13b", [2] = "%r13w", [4] = "%r13d", [8] = "%r13"},
+  [R14] = {[1] = "%r14b", [2] = "%r14w", [4] = "%r14d", [8] = "%r14"},
+  [R15] = {[1] = "%r15b", [2] = "%r15w", [4] = "%r15d", [8] = "%r15"},
+  [XMM0] = XMM_NAMES_(0), [XMM1] = XMM_NAMES_(1), [XMM2] = XMM_NAMES_(2), [XMM3] = XMM_NAMES_(3),
+  [XMM4] = XMM_NAMES_(4), [XMM5] = XMM_NAMES_(5), [XMM6] = XMM_NAMES_(6), [XMM7] = XMM_NAMES_(7),
+  [XMM8] = XMM_NAMES_(8), [XMM9] = XMM_NAMES_(9), [XMM10] = XMM_NAMES_(10), [XMM11] = XMM_NAMES_(11),
+  [XMM12] = XMM_NAMES_(12), [XMM13] = XMM_NAMES_(13), [XMM14] = XMM_NAMES_(14), [XMM15] = XMM_NAMES_(15),
+};
+
+static const char suffixes[] = {[1] = 'b', [2] = 'w', [4] = 'l', [8] = 'q'};
+
+// Registers handed out by the allocator, caller-saved first, then the vector registers, none of which calls preserve,
+// which hold floating values too.
+// RAX, RCX, RDX and R11 stay free as scratch: RAX and RDX for division and results, RCX for shift counts, and R11 for
+// memory to memory moves. So do XMM13-XMM15, for the same among vectors and the steps of multiplying them.
+static const X86Reg allocatable[] = {
+  RSI, RDI, R8, R9, R10, RBX, R12, R13, R14, R15,
+  XMM0, XMM1, XMM2, XMM3, XMM4, XMM5, XMM6, XMM7, XMM8, XMM9, XMM10, XMM11, XMM12,
+};
+#define N_ALLOCATABLE ((int) (sizeof(allocatable) / sizeof(allocatable[0])))
+#define CALLEE_SAVED_MASK 0x3e0  // RBX and R12-R15 above
+#define CALLER_SAVED_MASK 0x7ffc1f  // the rest
+#define GENERAL_MASK 0x3ff
+#define VECTOR_MASK 0x7ffc00  // XMM0-XMM12 above
+
+static const X86Reg param_regs[] = {RDI, RSI, RDX, RCX, R8, R9};
+#define N_FLOAT_PARAM_REGS 8  // XMM0-XMM7
+#define RED_ZONE_SIZE 128  // bytes below %rsp that the SysV ABI keeps signal handlers from
+// Sections of the text segment for the code of hot functions, and for code that hardly ever runs, which the linker
+// keeps apart from the rest so the code that does run shares fewer cache lines and pages with the code that does not
+#define HOT_SECTION "\t.section\t__TEXT,__text_hot,regular,pure_instructions\n"
+#define COLD_SECTION "\t.section\t__TEXT,__text_unlikely,regular,pure_instructions\n"
+
+
+typedef enum {
+  LOC_NONE,
+  LOC_REG,
+  LOC_MEM,  ///< in the frame
+  LOC_IMM,
+  LOC_ADDR,  ///< the address of a stack slot or global plus a constant, computed with leaq
+  LOC_POOL,  ///< a floating constant in the literal pool, whose bits are imm
+} LocKind;
+
+typedef struct {
+  LocKind kind;
+  union {
+    X86Reg reg;
+    int frame_offset;
+    int64_t imm;
+  };
+  const char *symbol;  ///< for LOC_ADDR of a global, or the label of LOC_POOL; otherwise LOC_ADDR is in the frame
+} Loc;
+
+typedef struct {
+  FILE *out;
+  IrFunction *f;
+  RegisterAllocation *alloc;
+  int *slot_offsets;
+  int *spill_offsets;
+  uint32_t saved_regs;  ///< mask of callee-saved registers pushed in the prologue, in allocatable numbering
+  const char *frame_base;  ///< %rbp, or %rsp if the function has no frame pointer; frame offsets are from it
+  int frame_size;  ///< bytes subtracted from %rsp after pushing the saved registers
+  int n_outgoing;  ///< 8-byte slots at %rsp for the arguments calls pass on the stack
+  int outgoing_offset;  ///< the frame offset of those, at %rsp
+  int incoming_offset;  ///< the frame offset of the first parameter passed on the stack, above the return address
+  IrBlockRef next_block;  ///< block emitted after the current one, or IR_NONE
+  IrBlockRef *forward;  ///< by block: the block a jump to it goes to instead, as it would only jump there; or itself
+  const char *section;  ///< the section of the function, or 0 for the text section
+  uint8_t *is_cold;  ///< by block: whether it goes in the cold section, apart from the rest of the function
+  int vex;  ///< whether to use the AVX encodings of vector instructions, as for 32-byte vectors
+  int uses_ymm;  ///< whether the function has 32-byte vectors, whose upper halves must be cleared before leaving it
+  int may_tail_call;  ///< whether no slot escapes, so the frame can be released before a call in tail position
+  int *literal_of;  ///< by instruction: for floating constants, their entry in the literal pool
+  IrRef *literals;  ///< the literal pool: a constant with the bits and type of each entry
+  int n_literals;
+} Lowering;
+
+// Totals for the translation unit
+static int n_values_allocated;
+static int n_values_spilled;
+static int n_tail_calls;
+static IrOptStats ir_opt_stats;
+static PeepholeStats peephole_stats;
+static InlineBodies *inline_bodies;  ///< of the functions emitted so far
+static Profile *profile;  ///< the counts to optimize by, from -U
+static int n_functions, n_profiled;
+
+/** A function given counters, with -G */
+typedef struct {
+  const char *name;
+  uint64_t shape;
+  int first, n_counters;
+} InstrumentedFunction;
+
+static const char *profile_path;  ///< where the instrumented program adds up its counts, from -G
+static InstrumentedFunction *instrumented;  // a vector
+static int instrumented_size, instrumented_capacity;
+static int n_counters;
+
+/** The code of a function, held back to be put in order of its count, with -U */
+typedef struct {
+  char *text;
+  uint64_t count;  ///< the times the function was called in the profile
+  int index;  ///< in the translation unit
+} EmittedFunction;
+
+static EmittedFunction *emitted;  // a vector
+static int emitted_size, emitted_capacity;
+
+static int fits_int32(int64_t val) {
+  return val >= INT32_MIN && val <= INT32_MAX;
+}
+
+static int value_size(const IrFunction *f, IrRef value) {
+  return IR_TYPE_SIZES[f->type[value]];
+}
+
+/** Arithmetic on narrow values happens in 32 bits; their upper bits are don't-cares. */
+static int alu_size(const IrFunction *f, IrRef value) {
+  int size = value_size(f, value);
+  return size < 4 ? 4 : size;
+}
+
+/** If value is a slot or global address plus a constant, which needs no register, describe it in *loc. */
+static int is_constant_address(const IrFunction *f, IrRef value, Loc *loc) {
+  switch (f->op[value]) {
+    case IR_SLOT:
+      *loc = (Loc) { .kind = LOC_ADDR, .imm = 0 };
+      return 1;
+    case IR_GLOBAL:
+      *loc = (Loc) { .kind = LOC_ADDR, .imm = 0, .symbol = f->symbols[f->imm[value]] };
+      return 1;
+    case IR_ADD: {
+      IrRef offset = IR_ARG(f, value, 1);
+      if (f->type[value] != IR_PTR || f->op[offset] != IR_CONST)
+        return 0;
+      if (!is_constant_address(f, IR_ARG(f, value, 0), loc) || !fits_int32(loc->imm + f->imm[offset]))
+        return 0;
+      loc->imm += f->imm[offset];
+      return 1;
+    }
+    default:
+      return 0;
+  }
+}
+
+static int is_comparison(IrOp op) {
+  return (op >= IR_EQ && op <= IR_UGE) || (op >= IR_FEQ && op <= IR_FGE);
+}
+
+/** Whether inst is a comparison whose result one condition code of the flags it sets stands for */
+static int is_flag_comparison(const IrFunction *f, IrRef inst) {
+  return is_comparison(f->op[inst]) && f->op[inst] != IR_FEQ && f->op[inst] != IR_FNE;
+}
+
+/**
+ * Whether inst is a comparison only the branch or select right after it uses, as its condition, which can test the
+ * flags it sets instead. Floating equality needs the parity flag as well, which no one condition tests, so it is
+ * computed like other values.
+ */
+static int is_fused_comparison(const IrFunction *f, IrRef inst) {
+  IrRef next = f->next[inst];
+  IrUse use = f->first_use[inst];
+  return is_flag_comparison(f, inst) && next && (f->op[next] == IR_BR || f->op[next] == IR_SELECT) && use
+    && use == f->args[next] && !f->next_use[use];
+}
+
+static int needs_location(const IrFunction *f, IrRef inst) {
+  Loc unused;
+  if (is_fused_comparison(f, inst))
+    return 0;
+  switch (f->op[inst]) {
+    case IR_CONST:
+      return !IR_IS_FLOAT_TYPE(f->type[inst]) && !fits_int32(f->imm[inst]);
+    case IR_UNDEF:
+      return 0;
+    case IR_PARAM:
+      return f->first_use[inst] != IR_NONE;
+    default:
+      return !is_constant_address(f, inst, &unused);
+  }
+}
+
+/**
+ * The register parameter param arrives in, or N_X86_REGS if it is passed on the stack. Integer and floating parameters
+ * each take the registers of their class in order.
+ */
+static X86Reg param_reg(const IrFunction *f, IrRef param) {
+  int is_float = IR_IS_FLOAT_TYPE(f->type[param]), index = 0;
+  for (IrRef inst = f->blocks[IR_ENTRY_BLOCK].first; inst; inst = f->next[inst]) {
+    index += f->op[inst] == IR_PARAM && f->imm[inst] < f->imm[param] && IR_IS_FLOAT_TYPE(f->type[inst]) == is_float;
+  }
+  if (is_float)
+    return index < N_FLOAT_PARAM_REGS ? XMM0 + index : N_X86_REGS;
+  return index < 6 ? param_regs[index] : N_X86_REGS;
+}
+
+/** The number of a register in the allocator's numbering, or REG_NONE if it is not allocatable */
+static int allocatable_index(X86Reg reg) {
+  for (int r = 0; r < N_ALLOCATABLE; r++) {
+    if (allocatable[r] == reg)
+      return r;
+  }
+  return REG_NONE;
+}
+
+static uint32_t allocatable_bit(X86Reg reg) {
+  int r = allocatable_index(reg);
+  return r == REG_NONE ? 0 : (uint32_t) 1 << r;
+}
+
+static int preferred_reg(const IrFunction *f, IrRef inst) {
+  return f->op[inst] == IR_PARAM ? allocatable_index(param_reg(f, inst)) : REG_NONE;
+}
+
+/** The register an argument of class is_float goes in, given how many of each class come before it */
+static X86Reg argument_reg(int is_float, int n_int, int n_float) {
+  if (is_float)
+    return n_float < N_FLOAT_PARAM_REGS ? XMM0 + n_float : N_X86_REGS;
+  return n_int < 6 ? param_regs[n_int] : N_X86_REGS;
+}
+
+/** The number of arguments of call passed on the stack, those its classes run out of registers for */
+static int n_stack_args(const IrFunction *f, IrRef call) {
+  int n_int = 0, n_float = 0, ret = 0;
+  for (uint32_t i = 0; i < f->n_args[call]; i++) {
+    int is_float = IR_IS_FLOAT_TYPE(f->type[IR_ARG(f, call, i)]);
+    ret += argument_reg(is_float, n_int, n_float) == N_X86_REGS;
+    n_float += is_float;
+    n_int += !is_float;
+  }
+  return ret;
+}
+
+KHASH_MAP_INIT_STR(Clobbers, uint32_t)
+
+/** By name, the allocatable registers each function emitted so far in the translation unit may overwrite */
+static kh_Clobbers_t *known_clobbers;
+
+static void set_clobbers(const char *name, uint32_t clobbered) {
+  int ret;
+  khiter_t iter = kh_put_Clobbers(known_clobbers, fmtstr("%s", name), &ret);
+  THROW_IF(ret == -1, EXC_SYSTEM, "kh_put failed");
+  kh_val(known_clobbers, iter) = clobbered;
+}
+
+/**
+ * The allocatable registers inst overwrites. A call takes its argument and result registers, and what the function
+ * called overwrites: the caller-saved registers, unless it was emitted before in the translation unit and uses fewer,
+ * so values can live across it in the others. Zeros and copies too big to unroll take RDI and RSI.
+ */
+static uint32_t clobbers(const IrFunction *f, IrRef inst) {
+  switch (f->op[inst]) {
+    case IR_CALL: {
+      khiter_t iter = kh_get_Clobbers(known_clobbers, f->symbols[f->imm[inst]]);
+      uint32_t ret = iter == kh_end(known_clobbers) ? CALLER_SAVED_MASK : kh_val(known_clobbers, iter);
+      int n_int = 0, n_float = 0;
+      for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+        int is_float = IR_IS_FLOAT_TYPE(f->type[IR_ARG(f, inst, i)]);
+        ret |= allocatable_bit(argument_reg(is_float, n_int, n_float));
+        n_float += is_float;
+        n_int += !is_float;
+      }
+      return ret | (IR_IS_FLOAT_TYPE(f->type[inst]) ? allocatable_bit(XMM0) : 0);
+    }
+    case IR_ZERO:
+    case IR_COPY:
+      return block_strategy(f->imm[inst]) == BLOCK_INLINE ? 0 : allocatable_bit(RDI) | allocatable_bit(RSI);
+    default:
+      return 0;
+  }
+}
+
+static uint32_t allowed_regs(const IrFunction *f, IrRef inst) {
+  return IR_IS_VECTOR_TYPE(f->type[inst]) || IR_IS_FLOAT_TYPE(f->type[inst]) ? VECTOR_MASK : GENERAL_MASK;
+}
+
+static const RegisterInfo register_info = {
+  .n_regs = N_ALLOCATABLE,
+  .callee_saved = CALLEE_SAVED_MASK,
+  .needs_location = needs_location,
+  .clobbers = clobbers,
+  .allowed_regs = allowed_regs,
+  .preferred_reg = preferred_reg,
+};
+
+static Loc reg_loc(X86Reg reg) {
+  return (Loc) { .kind = LOC_REG, .reg = reg };
+}
+
+static Loc loc_of(const Lowering *l, IrRef value) {
+  const IrFunction *f = l->f;
+  Loc ret;
+  if (f->op[value] == IR_CONST && IR_IS_FLOAT_TYPE(f->type[value])) {
+    const char *label = fmtstr("LCPI_%s_%d", f->name, l->literal_of[value]);
+    return (Loc) { .kind = LOC_POOL, .imm = f->imm[value], .symbol = label };
+  }
+  if (f->op[value] == IR_CONST && fits_int32(f->imm[value]))
+    return (Loc) { .kind = LOC_IMM, .imm = f->imm[value] };
+  if (f->op[value] == IR_UNDEF)
+    return (Loc) { .kind = LOC_IMM, .imm = 0 };
+  if (is_constant_address(f, value, &ret)) {
+    IrRef base = value;
+    while (f->op[base] == IR_ADD) {
+      base = IR_ARG(f, base, 0);
+    }
+    if (f->op[base] == IR_SLOT) {
+      int displacement = (int) ret.imm;
+      ret.frame_offset = l->slot_offsets[f->imm[base]] + displacement;
+    }
+    return ret;
+  }
+  int reg = l->alloc->reg[value];
+  if (reg != REG_NONE)
+    return reg_loc(allocatable[reg]);
+  assert(l->alloc->spill_slot[value] >= 0 && "value without location");
+  return (Loc) { .kind = LOC_MEM, .frame_offset = l->spill_offsets[l->alloc->spill_slot[value]] };
+}
+
+static int same_loc(Loc a, Loc b) {
+  if (a.kind != b.kind)
+    return 0;
+  return (a.kind == LOC_REG && a.reg == b.reg) || (a.kind == LOC_MEM && a.frame_offset == b.frame_offset);
+}
+
+/** The memory operand for an address loc */
+static const char *address_text(const Lowering *l, Loc loc) {
+  assert(loc.kind == LOC_ADDR);
+  if (loc.symbol) {
+    return loc.imm ? fmtstr("_%s+%lld(%%rip)", loc.symbol, (long long) loc.imm) : fmtstr("_%s(%%rip)", loc.symbol);
+  }
+  return fmtstr("%d(%s)", loc.frame_offset, l->frame_base);
+}
+
+static int is_xmm(Loc loc) {
+  return loc.kind == LOC_REG && loc.reg >= XMM0;
+}
+
+static const char *loc_text(const Lowering *l, Loc loc, int size) {
+  switch (loc.kind) {
+    case LOC_REG:
+      return reg_names[loc.reg][is_xmm(loc) && size <= 8 ? 16 : size];
+    case LOC_MEM:
+      return fmtstr("%d(%s)", loc.frame_offset, l->frame_base);
+    case LOC_IMM:
+      return fmtstr("$%lld", (long long) loc.imm);
+    case LOC_POOL:
+      return fmtstr("%s(%%rip)", loc.symbol);
+    default:
+      THROWF(EXC_INTERNAL, "location kind %d has no operand text", loc.kind);
+  }
+}
+
+/** The mnemonic of a vector instruction, in its AVX encoding if the function uses those */
+static const char *vector_op(const Lowering *l, const char *mnemonic) {
+  return l->vex ? fmtstr("v%s", mnemonic) : mnemonic;
+}
+
+static void emit_vector_move(Lowering *l, int size, Loc src, Loc dst) {
+  if (src.kind == LOC_MEM && dst.kind == LOC_MEM) {
+    emit_vector_move(l, size, src, reg_loc(XMM15));
+    src = reg_loc(XMM15);
+  }
+  // Spill slots are only 8-byte aligned.
+  const char *mnemonic = src.kind == LOC_REG && dst.kind == LOC_REG ? "movdqa" : "movdqu";
+  fprintf(l->out, "\t%s\t%s, %s\n", vector_op(l, mnemonic), loc_text(l, src, size), loc_text(l, dst, size));
+}
+
+/** The scalar SSE instruction op on floating values of size bytes, such as addsd */
+static const char *float_op(const char *op, int size) {
+  return fmtstr("%s%s", op, size == 8 ? "sd" : "ss");
+}
+
+/** Move a float or double to or from an XMM register, or from the literal pool. */
+static void emit_float_move(Lowering *l, int size, Loc src, Loc dst) {
+  if (is_xmm(dst) && (src.kind == LOC_IMM || (src.kind == LOC_POOL && src.imm == 0))) {
+    // positive zero, or undefined
+    fprintf(l->out, "\txorps\t%s, %s\n", loc_text(l, dst, 16), loc_text(l, dst, 16));
+    return;
+  }
+  if (src.kind == LOC_POOL && !is_xmm(dst)) {
+    emit_float_move(l, size, src, reg_loc(XMM15));
+    src = reg_loc(XMM15);
+  }
+  if (is_xmm(src) && is_xmm(dst)) {
+    fprintf(l->out, "\tmovaps\t%s, %s\n", loc_text(l, src, 16), loc_text(l, dst, 16));
+  } else if (src.kind == LOC_REG && dst.kind == LOC_REG) {
+    // between an XMM register and a general one
+    fprintf(l->out, "\t%s\t%s, %s\n", size == 8 ? "movq" : "movd", loc_text(l, src, size), loc_text(l, dst, size));
+  } else {
+    fprintf(l->out, "\t%s\t%s, %s\n", float_op("mov", size), loc_text(l, src, size), loc_text(l, dst, size));
+  }
+}
+
+static void emit_move(Lowering *l, int size, Loc src, Loc dst) {
+  if (same_loc(src, dst))
+    return;
+  assert(dst.kind == LOC_REG || dst.kind == LOC_MEM);
+  if (size >= 16) {
+    emit_vector_move(l, size, src, dst);
+    return;
+  }
+  if (is_xmm(src) || is_xmm(dst) || src.kind == LOC_POOL) {
+    emit_float_move(l, size, src, dst);
+    return;
+  }
+  int needs_register = src.kind == LOC_MEM || src.kind == LOC_ADDR || (src.kind == LOC_IMM && !fits_int32(src.imm));
+  if (dst.kind == LOC_MEM && needs_register) {
+    emit_move(l, size, src, reg_loc(R11));
+    src = reg_loc(R11);
+  }
+  switch (src.kind) {
+    case LOC_ADDR:
+      fprintf(l->out, "\tleaq\t%s, %s\n", address_text(l, src), reg_names[dst.reg][8]);
+      break;
+    case LOC_IMM:
+      if (dst.kind == LOC_REG && src.imm == 0) {
+        fprintf(l->out, "\txorl\t%s, %s\n", reg_names[dst.reg][4], reg_names[dst.reg][4]);
+      } else if (!fits_int32(src.imm)) {
+        fprintf(l->out, "\tmovabsq\t$%lld, %s\n", (long long) src.imm, reg_names[dst.reg][8]);
+      } else {
+        fprintf(l->out, "\tmov%c\t$%lld, %s\n", suffixes[size], (long long) src.imm, loc_text(l, dst, size));
+      }
+      break;
+    default:
+      fprintf(l->out, "\tmov%c\t%s, %s\n", suffixes[size], loc_text(l, src, size), loc_text(l, dst, size));
+      break;
+  }
+}
+
+/** Operand text for the source of an ALU instruction; addresses are computed into scratch first. */
+static const char *source_text(Lowering *l, IrRef value, int size, X86Reg scratch) {
+  Loc loc = loc_of(l, value);
+  if (loc.kind == LOC_ADDR) {
+    emit_move(l, 8, loc, reg_loc(scratch));
+    loc = reg_loc(scratch);
+  }
+  return loc_text(l, loc, size);
+}
+
+/** The memory operand for the object at address value */
+static const char *memory_text(Lowering *l, IrRef address) {
+  Loc loc = loc_of(l, address);
+  switch (loc.kind) {
+    case LOC_ADDR:
+      return address_text(l, loc);
+    case LOC_REG:
+      return fmtstr("(%s)", reg_names[loc.reg][8]);
+    default:
+      emit_move(l, 8, loc, reg_loc(RAX));
+      return "(%rax)";
+  }
+}
+
+/** Likewise, as a MemRef, computing a variable address into scratch if it is not in a register */
+static MemRef block_ref(Lowering *l, IrRef address, X86Reg scratch) {
+  Loc loc = loc_of(l, address);
+  switch (loc.kind) {
+    case LOC_ADDR:
+      return loc.symbol ? (MemRef) { .symbol = loc.symbol, .disp = loc.imm }
+                        : (MemRef) { .base = l->frame_base, .disp = loc.frame_offset };
+    case LOC_REG:
+      return (MemRef) { .base = reg_names[loc.reg][8] };
+    default:
+      emit_move(l, 8, loc, reg_loc(scratch));
+      return (MemRef) { .base = reg_names[scratch][8] };
+  }
+}
+
+/** Where to compute a result before moving it to dst: dst itself if it is a register that does not hold avoid. */
+static Loc target(Loc dst, Loc avoid) {
+  return dst.kind == LOC_REG && !same_loc(dst, avoid) ? dst : reg_loc(R11);
+}
+
+typedef struct {
+  Loc src, dst;
+  int size;  ///< 8 bytes, or those of a vector or floating value
+} Move;
+
+/**
+ * Perform moves as if simultaneously, breaking cycles through RAX, or XMM15 for vectors and floats. Sources may be
+ * anything.
+ */
+static void emit_parallel_moves(Lowering *l, Move *moves, int n_moves) {
+  while (n_moves > 0) {
+    int progress = 0;
+    for (int i = 0; i < n_moves; i++) {
+      int blocked = 0;
+      for (int k = 0; k < n_moves; k++) {
+        blocked |= k != i && same_loc(moves[k].src, moves[i].dst);
+      }
+      if (!blocked) {
+        emit_move(l, moves[i].size, moves[i].src, moves[i].dst);
+        moves[i--] = moves[--n_moves];
+        progress = 1;
+      }
+    }
+    if (!progress) {
+      // Every destination is still to be read: a cycle. Free one by saving its contents.
+      Loc saved = moves[0].dst, scratch = reg_loc(moves[0].size == 8 && !is_xmm(saved) ? RAX : XMM15);
+      emit_move(l, moves[0].size, saved, scratch);
+      for (int k = 0; k < n_moves; k++) {
+        if (same_loc(moves[k].src, saved)) {
+          moves[k].src = scratch;
+        }
+      }
+    }
+  }
+}
+
+static const char *block_label(const Lowering *l, IrBlockRef b) {
+  return fmtstr("L%s_%u", l->f->name, b);
+}
+
+static void emit_jump(Lowering *l, IrBlockRef to) {
+  to = l->forward[to];
+  if (to != l->next_block) {
+    fprintf(l->out, "\tjmp\t%s\n", block_label(l, to));
+  }
+}
+
+/**
+ * If b only jumps on, its phi moves all being no-ops, as is common for the blocks splitting back edges, return the
+ * block it jumps to, else b.
+ */
+static IrBlockRef forwarded_block(const Lowering *l, IrBlockRef b) {
+  const IrFunction *f = l->f;
+  const IrBlock *block = &f->blocks[b];
+  if (b == IR_ENTRY_BLOCK || block->first != block->last || f->op[block->first] != IR_JMP)
+    return b;
+  const IrBlock *succ = &f->blocks[block->succs[0]];
+  for (uint32_t k = 0; k < succ->n_preds; k++) {
+    if (succ->preds[k] != b)
+      continue;
+    for (IrRef phi = succ->first; phi && f->op[phi] == IR_PHI; phi = f->next[phi]) {
+      if (needs_location(f, phi) && !same_loc(loc_of(l, IR_ARG(f, phi, k)), loc_of(l, phi)))
+        return b;
+    }
+  }
+  return block->succs[0];
+}
+
+/** Copy the values the phis of the successor of b expect from b. */
+static void emit_phi_moves(Lowering *l, IrBlockRef b) {
+  IrFunction *f = l->f;
+  const IrBlock *block = &f->blocks[b];
+  if (block->n_succs != 1)
+    return;  // edges out of branches were split unless the target has one predecessor, and thus no phis
+  const IrBlock *succ = &f->blocks[block->succs[0]];
+  Move *moves = arena_alloc(f->arena, f->n_insts * sizeof(Move));
+  int n_moves = 0;
+  for (uint32_t k = 0; k < succ->n_preds; k++) {
+    if (succ->preds[k] != b)
+      continue;
+    for (IrRef phi = succ->first; phi && f->op[phi] == IR_PHI; phi = f->next[phi]) {
+      if (needs_location(f, phi)) {
+        int size = IR_IS_VECTOR_TYPE(f->type[phi]) || IR_IS_FLOAT_TYPE(f->type[phi]) ? value_size(f, phi) : 8;
+        moves[n_moves++] = (Move) { .src = loc_of(l, IR_ARG(f, phi, k)), .dst = loc_of(l, phi), .size = size };
+      }
+    }
+  }
+  emit_parallel_moves(l, moves, n_moves);
+}
+
+/** Restore the callee-saved registers and pop the frame, leaving the return address on top of the stack. */
+static void emit_frame_release(Lowering *l) {
+  int n_saved = __builtin_popcount(l->saved_regs);
+  if (l->uses_ymm) {
+    fputs("\tvzeroupper\n", l->out);  // else SSE code after the return pays for the dirty upper halves
+  }
+  if (!strcmp(l->frame_base, "%rsp")) {
+    if (l->frame_size) {
+      fprintf(l->out, "\taddq\t$%d, %%rsp\n", l->frame_size);
+    }
+    for (int r = N_ALLOCATABLE - 1; r >= 0; r--) {
+      if (l->saved_regs >> r & 1) {
+        fprintf(l->out, "\tpopq\t%s\n", reg_names[allocatable[r]][8]);
+      }
+    }
+  } else if (n_saved) {
+    fprintf(l->out, "\tleaq\t%d(%%rbp), %%rsp\n", -8 * n_saved);
+    for (int r = N_ALLOCATABLE - 1; r >= 0; r--) {
+      if (l->saved_regs >> r & 1) {
+        fprintf(l->out, "\tpopq\t%s\n", reg_names[allocatable[r]][8]);
+      }
+    }
+    fputs("\tpopq\t%rbp\n", l->out);
+  } else {
+    fputs("\tleave\n", l->out);
+  }
+}
+
+static void emit_epilogue(Lowering *l) {
+  emit_frame_release(l);
+  fputs("\tretq\n", l->out);
+}
+
+/**
+ * Whether call is made by jumping to the function called, which then returns to our caller. Not if it passes arguments
+ * on the stack, as they would have to go where our caller put ours, which may be too small.
+ */
+static int is_jump_call(const Lowering *l, IrRef call) {
+  return l->may_tail_call && is_tail_call(l->f, call) && !n_stack_args(l->f, call);
+}
+
+static void emit_binary(Lowering *l, IrRef inst, const char *mnemonic) {
+  IrFunction *f = l->f;
+  int size = alu_size(f, inst);
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  Loc dst = loc_of(l, inst);
+  if ((IR_OP_FLAGS[f->op[inst]] & IR_COMMUTATIVE) && same_loc(dst, loc_of(l, b))) {
+    IrRef tmp = a;
+    a = b;
+    b = tmp;
+  }
+  Loc t = target(dst, loc_of(l, b));
+  emit_move(l, size, loc_of(l, a), t);
+  fprintf(l->out, "\t%s%c\t%s, %s\n", mnemonic, suffixes[size], source_text(l, b, size, RAX), loc_text(l, t, size));
+  emit_move(l, size, t, dst);
+}
+
+/** Multiply by a constant with shifts, lea and add when that beats imul. */
+static void emit_multiplication(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  if (f->op[a] == IR_CONST) {
+    IrRef tmp = a;
+    a = b;
+    b = tmp;
+  }
+  MulPlan plan;
+  if (f->op[b] != IR_CONST || !plan_multiplication(f->imm[b], &plan)) {
+    emit_binary(l, inst, "imul");
+    return;
+  }
+  int size = alu_size(f, inst);
+  Loc dst = loc_of(l, inst);
+  Loc t = target(dst, (Loc) {0});
+  emit_move(l, size, loc_of(l, a), t);
+  fprint_multiplication(l->out, &plan, size, reg_names[t.reg][size], reg_names[t.reg][8]);
+  emit_move(l, size, t, dst);
+}
+
+/** Divide, or take the remainder, by a constant without div where possible; return whether it was. */
+static int emit_division_by_constant(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrOp op = f->op[inst];
+  IrRef b = IR_ARG(f, inst, 1);
+  if (f->op[b] != IR_CONST)
+    return 0;
+  ConstantDivision division = {
+    .divisor = f->imm[b],
+    .size = value_size(f, inst),
+    .is_signed = op == IR_SDIV || op == IR_SREM,
+    .is_quotient = op == IR_SDIV || op == IR_UDIV,
+  };
+  if (!divides_without_div(division))
+    return 0;
+  int size = division.size;
+  Loc x = loc_of(l, IR_ARG(f, inst, 0));
+  if (x.kind != LOC_REG) {
+    emit_move(l, size, x, reg_loc(R11));
+    x = reg_loc(R11);
+  }
+  Loc dst = loc_of(l, inst);
+  Loc t = target(dst, (Loc) {0});
+  fprint_division(l->out, division, reg_names[x.reg][size], reg_names[x.reg][8], reg_names[t.reg][size]);
+  emit_move(l, size, t, dst);
+  return 1;
+}
+
+static void emit_division(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrOp op = f->op[inst];
+  if (emit_division_by_constant(l, inst))
+    return;
+  int size = alu_size(f, inst);
+  Loc divisor = loc_of(l, IR_ARG(f, inst, 1));
+  emit_move(l, size, loc_of(l, IR_ARG(f, inst, 0)), reg_loc(RAX));
+  if (divisor.kind == LOC_IMM) {
+    emit_move(l, size, divisor, reg_loc(R11));
+    divisor = reg_loc(R11);
+  }
+  int is_signed = op == IR_SDIV || op == IR_SREM;
+  if (is_signed) {
+    fputs(size == 8 ? "\tcqto\n" : "\tcltd\n", l->out);
+  } else {
+    fputs("\txorl\t%edx, %edx\n", l->out);
+  }
+  fprintf(l->out, "\t%s%c\t%s\n", is_signed ? "idiv" : "div", suffixes[size], loc_text(l, divisor, size));
+  emit_move(l, size, reg_loc(op == IR_SDIV || op == IR_UDIV ? RAX : RDX), loc_of(l, inst));
+}
+
+static void emit_shift(Lowering *l, IrRef inst, const char *mnemonic) {
+  IrFunction *f = l->f;
+  int size = alu_size(f, inst);
+  Loc count = loc_of(l, IR_ARG(f, inst, 1));
+  const char *count_text;
+  if (count.kind == LOC_IMM) {
+    count_text = fmtstr("$%d", (int) (count.imm & (size * 8 - 1)));
+  } else {
+    emit_move(l, 4, count, reg_loc(RCX));
+    count_text = "%cl";
+  }
+  Loc dst = loc_of(l, inst);
+  Loc t = target(dst, (Loc) {0});
+  emit_move(l, size, loc_of(l, IR_ARG(f, inst, 0)), t);
+  fprintf(l->out, "\t%s%c\t%s, %s\n", mnemonic, suffixes[size], count_text, loc_text(l, t, size));
+  emit_move(l, size, t, dst);
+}
+
+static const char *condition_code(IrOp op) {
+  switch (op) {
+    case IR_EQ: return "e";
+    case IR_NE: return "ne";
+    case IR_SLT: return "l";
+    case IR_SLE: return "le";
+    case IR_SGT: return "g";
+    case IR_SGE: return "ge";
+    case IR_ULT: return "b";
+    case IR_ULE: return "be";
+    case IR_UGT: return "a";
+    case IR_UGE: return "ae";
+    // ucomis sets the flags as an unsigned comparison would; see emit_float_compare
+    case IR_FEQ: return "e";
+    case IR_FNE: return "ne";
+    case IR_FGT: return "a";
+    case IR_FGE: return "ae";
+    default:
+      THROWF(EXC_INTERNAL, "%s is not a comparison", IR_OP_NAMES[op]);
+  }
+}
+
+static IrOp negate_comparison(IrOp op) {
+  switch (op) {
+    case IR_EQ: return IR_NE;
+    case IR_NE: return IR_EQ;
+    case IR_SLT: return IR_SGE;
+    case IR_SLE: return IR_SGT;
+    case IR_SGT: return IR_SLE;
+    case IR_SGE: return IR_SLT;
+    case IR_ULT: return IR_UGE;
+    case IR_ULE: return IR_UGT;
+    case IR_UGT: return IR_ULE;
+    case IR_UGE: return IR_ULT;
+    // Not FLE and FLT, which would be false if either operand is NaN, but the unsigned conditions true then too
+    case IR_FGT: return IR_ULE;
+    case IR_FGE: return IR_ULT;
+    default:
+      THROWF(EXC_INTERNAL, "%s is not a comparison", IR_OP_NAMES[op]);
+  }
+}
+
+/** The operand text of value, a float or double, for an SSE instruction: a register, memory or the literal pool */
+static const char *float_source_text(Lowering *l, IrRef value, X86Reg scratch) {
+  Loc loc = loc_of(l, value);
+  if (loc.kind == LOC_IMM) {
+    emit_move(l, value_size(l->f, value), loc, reg_loc(scratch));
+    loc = reg_loc(scratch);
+  }
+  return loc_text(l, loc, value_size(l->f, value));
+}
+
+/**
+ * Set the flags by comparing the floating operands of inst, and return the comparison to test them for. ucomis sets
+ * the carry, zero and parity flags if either operand is NaN, so FLT and FLE are turned around into FGT and FGE, whose
+ * conditions are false then.
+ */
+static IrOp emit_float_compare(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrOp op = f->op[inst];
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  if (op == IR_FLT || op == IR_FLE) {
+    IrRef tmp = a;
+    a = b;
+    b = tmp;
+    op = op == IR_FLT ? IR_FGT : IR_FGE;
+  }
+  int size = value_size(f, a);
+  Loc left = loc_of(l, a);
+  if (!is_xmm(left)) {
+    emit_move(l, size, left, reg_loc(XMM15));
+    left = reg_loc(XMM15);
+  }
+  fprintf(l->out, "\t%s\t%s, %s\n", float_op("ucomi", size), float_source_text(l, b, XMM14), loc_text(l, left, size));
+  return op;
+}
+
+/** Set the flags by comparing the operands of inst, and return the comparison to test them for. */
+static IrOp emit_compare(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  if (f->op[inst] >= IR_FEQ)
+    return emit_float_compare(l, inst);
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  int size = alu_size(f, a);
+  Loc left = loc_of(l, a), right = loc_of(l, b);
+  if (left.kind == LOC_IMM || left.kind == LOC_ADDR || (left.kind == LOC_MEM && right.kind == LOC_MEM)) {
+    emit_move(l, size, left, reg_loc(R11));
+    left = reg_loc(R11);
+  }
+  fprintf(l->out, "\tcmp%c\t%s, %s\n", suffixes[size], source_text(l, b, size, RAX), loc_text(l, left, size));
+  return f->op[inst];
+}
+
+static void emit_comparison(Lowering *l, IrRef inst) {
+  IrOp op = emit_compare(l, inst);
+  fprintf(l->out, "\tset%s\t%%al\n", condition_code(op));
+  if (op == IR_FEQ || op == IR_FNE) {
+    // unordered, with the parity flag set, is unequal
+    fprintf(l->out, "\tset%s\t%%cl\n\t%s\t%%cl, %%al\n", op == IR_FEQ ? "np" : "p", op == IR_FEQ ? "andb" : "orb");
+  }
+  fputs("\tmovzbl\t%al, %eax\n", l->out);
+  emit_move(l, 4, reg_loc(RAX), loc_of(l, inst));
+}
+
+/** Where to compute a floating value before moving it to dst: dst itself if it is an XMM register not holding avoid */
+static Loc float_target(Loc dst, Loc avoid) {
+  return is_xmm(dst) && !same_loc(dst, avoid) ? dst : reg_loc(XMM15);
+}
+
+static void emit_float_binary(Lowering *l, IrRef inst, const char *mnemonic) {
+  IrFunction *f = l->f;
+  int size = value_size(f, inst);
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  Loc dst = loc_of(l, inst);
+  if ((IR_OP_FLAGS[f->op[inst]] & IR_COMMUTATIVE) && same_loc(dst, loc_of(l, b))) {
+    IrRef tmp = a;
+    a = b;
+    b = tmp;
+  }
+  // Scalar SSE instructions take unaligned memory operands.
+  Loc t = float_target(dst, loc_of(l, b));
+  emit_move(l, size, loc_of(l, a), t);
+  fprintf(l->out, "\t%s\t%s, %s\n", float_op(mnemonic, size), float_source_text(l, b, XMM14), loc_text(l, t, size));
+  emit_move(l, size, t, dst);
+}
+
+/** Convert between integers and floating values, or floats and doubles. */
+static void emit_float_conversion(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef arg = IR_ARG(f, inst, 0);
+  int from = value_size(f, arg), to = value_size(f, inst);
+  Loc src = loc_of(l, arg), dst = loc_of(l, inst);
+  if (f->op[inst] == IR_FPTOSI) {
+    Loc t = target(dst, (Loc) {0});
+    fprintf(l->out, "\tcvtt%s2si\t%s, %s\n", from == 8 ? "sd" : "ss", float_source_text(l, arg, XMM14),
+      loc_text(l, t, to));
+    emit_move(l, to, t, dst);
+    return;
+  }
+  Loc t = float_target(dst, (Loc) {0});
+  if (f->op[inst] == IR_SITOFP) {
+    if (src.kind == LOC_IMM || src.kind == LOC_ADDR) {
+      emit_move(l, from, src, reg_loc(RAX));
+      src = reg_loc(RAX);
+    }
+    // cvtsi2sd only writes the low lane; clearing the register first breaks the dependence on the rest.
+    fprintf(l->out, "\txorps\t%s, %s\n", loc_text(l, t, 16), loc_text(l, t, 16));
+    fprintf(l->out, "\tcvtsi2%s%c\t%s, %s\n", to == 8 ? "sd" : "ss", suffixes[from], loc_text(l, src, from),
+      loc_text(l, t, to));
+  } else {
+    fprintf(l->out, "\t%s\t%s, %s\n", f->op[inst] == IR_FPEXT ? "cvtss2sd" : "cvtsd2ss",
+      float_source_text(l, arg, XMM14), loc_text(l, t, to));
+  }
+  emit_move(l, to, t, dst);
+}
+
+static void emit_extension(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef arg = IR_ARG(f, inst, 0);
+  int from = value_size(f, arg), to = alu_size(f, inst);
+  Loc src = loc_of(l, arg), dst = loc_of(l, inst);
+  if (src.kind == LOC_IMM || src.kind == LOC_ADDR || from == to || f->op[inst] == IR_TRUNC) {
+    // constants were extended when built, and truncation keeps the low bytes where they are
+    emit_move(l, to, src, dst);
+    return;
+  }
+  Loc t = target(dst, (Loc) {0});
+  if (f->op[inst] == IR_SEXT) {
+    fprintf(l->out, "\tmovs%c%c\t%s, %s\n", suffixes[from], suffixes[to], loc_text(l, src, from), loc_text(l, t, to));
+  } else if (from == 4) {
+    // writing a 32-bit register clears the upper half
+    fprintf(l->out, "\tmovl\t%s, %s\n", loc_text(l, src, 4), loc_text(l, t, 4));
+  } else {
+    fprintf(l->out, "\tmovz%c%c\t%s, %s\n", suffixes[from], suffixes[to], loc_text(l, src, from), loc_text(l, t, to));
+  }
+  emit_move(l, to, t, dst);
+}
+
+static void emit_load(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int size = value_size(f, inst);
+  const char *memory = memory_text(l, IR_ARG(f, inst, 0));
+  Loc dst = loc_of(l, inst);
+  if (IR_IS_FLOAT_TYPE(f->type[inst])) {
+    Loc t = float_target(dst, (Loc) {0});
+    fprintf(l->out, "\t%s\t%s, %s\n", float_op("mov", size), memory, loc_text(l, t, size));
+    emit_move(l, size, t, dst);
+    return;
+  }
+  Loc t = target(dst, (Loc) {0});
+  if (size < 4) {
+    fprintf(l->out, "\tmovz%cl\t%s, %s\n", suffixes[size], memory, loc_text(l, t, 4));
+  } else {
+    fprintf(l->out, "\tmov%c\t%s, %s\n", suffixes[size], memory, loc_text(l, t, size));
+  }
+  emit_move(l, alu_size(f, inst), t, dst);
+}
+
+static void emit_store(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef value = IR_ARG(f, inst, 1);
+  int size = value_size(f, value);
+  Loc src = loc_of(l, value);
+  if (IR_IS_FLOAT_TYPE(f->type[value])) {
+    if (!is_xmm(src)) {
+      emit_move(l, size, src, reg_loc(XMM15));
+      src = reg_loc(XMM15);
+    }
+    const char *memory = memory_text(l, IR_ARG(f, inst, 0));
+    fprintf(l->out, "\t%s\t%s, %s\n", float_op("mov", size), loc_text(l, src, size), memory);
+    return;
+  }
+  if (src.kind == LOC_MEM || src.kind == LOC_ADDR) {
+    emit_move(l, size < 4 ? 4 : size, src, reg_loc(R11));
+    src = reg_loc(R11);
+  } else if (src.kind == LOC_IMM && size < 4) {
+    src.imm = size == 1 ? (int8_t) src.imm : (int16_t) src.imm;
+  }
+  const char *memory = memory_text(l, IR_ARG(f, inst, 0));
+  fprintf(l->out, "\tmov%c\t%s, %s\n", suffixes[size], loc_text(l, src, size), memory);
+}
+
+/**
+ * Move the addresses a block zero or copy of more than the inline limit takes into RDI and, for a copy, RSI. Values
+ * living across it are in callee-saved registers, as across a call, so anything in those registers dies here.
+ */
+static void emit_block_addresses(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  Move moves[2];
+  for (uint32_t i = 0; i < f->n_args[inst]; i++) {
+    moves[i] = (Move) { .src = loc_of(l, IR_ARG(f, inst, i)), .dst = reg_loc(i ? RSI : RDI), .size = 8 };
+  }
+  emit_parallel_moves(l, moves, f->n_args[inst]);
+}
+
+static void emit_zero(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int64_t size = f->imm[inst];
+  if (block_strategy(size) == BLOCK_INLINE) {
+    fprint_inline_zero(l->out, block_ref(l, IR_ARG(f, inst, 0), RAX), size, l->vex);
+    return;
+  }
+  emit_block_addresses(l, inst);
+  fprint_block_zero(l->out, size, fmtstr("L%s_zero%u", f->name, inst));
+}
+
+static void emit_copy(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int64_t size = f->imm[inst];
+  if (block_strategy(size) == BLOCK_INLINE) {
+    // The copy moves its data through RAX, so the addresses go elsewhere.
+    MemRef dst = block_ref(l, IR_ARG(f, inst, 0), RDX), src = block_ref(l, IR_ARG(f, inst, 1), RCX);
+    fprint_inline_copy(l->out, dst, src, size, l->vex);
+    return;
+  }
+  emit_block_addresses(l, inst);
+  fprint_block_copy(l->out, size, fmtstr("L%s_copy%u", f->name, inst));
+}
+
+/** A relaxed atomic increment, so that threads running the same code do not lose each other's counts */
+static void emit_count(Lowering *l, IrRef inst) {
+  const IrFunction *f = l->f;
+  Loc loc = loc_of(l, IR_ARG(f, inst, 0));
+  loc.imm += 8 * f->imm[inst];
+  fprintf(l->out, "\tlock incq\t%s\n", address_text(l, loc));
+}
+
+static void emit_call(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int n_args = f->n_args[inst];
+  // Nothing in the argument registers outlives the call, as clobbers tells the allocator.
+  Move *moves = arena_alloc(f->arena, (n_args + 1) * sizeof(Move));
+  int n_int = 0, n_float = 0, n_stack = 0;
+  for (int i = 0; i < n_args; i++) {
+    IrRef arg = IR_ARG(f, inst, i);
+    int is_float = IR_IS_FLOAT_TYPE(f->type[arg]);
+    X86Reg reg = argument_reg(is_float, n_int, n_float);
+    // The rest go in the slots at %rsp, in order.
+    Loc dst = reg_loc(reg);
+    if (reg == N_X86_REGS) {
+      dst = (Loc) { .kind = LOC_MEM, .frame_offset = l->outgoing_offset + 8 * n_stack++ };
+    }
+    moves[i] = (Move) { .src = loc_of(l, arg), .dst = dst, .size = is_float ? value_size(f, arg) : 8 };
+    n_float += is_float;
+    n_int += !is_float;
+  }
+  emit_parallel_moves(l, moves, n_args);
+  if (is_jump_call(l, inst)) {
+    // The arguments are all in registers, so nothing the callee reads is in the frame released.
+    emit_frame_release(l);
+    fprintf(l->out, "\tjmp\t_%s\n", f->symbols[f->imm[inst]]);
+    n_tail_calls++;
+    return;
+  }
+  if (l->uses_ymm) {
+    fputs("\tvzeroupper\n", l->out);
+  }
+  fprintf(l->out, "\tcallq\t_%s\n", f->symbols[f->imm[inst]]);
+  if (f->type[inst] != IR_VOID && needs_location(f, inst)) {
+    emit_move(l, alu_size(f, inst), reg_loc(IR_IS_FLOAT_TYPE(f->type[inst]) ? XMM0 : RAX), loc_of(l, inst));
+  }
+}
+
+/** Whether cond, the condition of a branch or select, is known when the function is emitted; if so, set *is_true. */
+static int is_constant_condition(Lowering *l, IrRef cond, int *is_true) {
+  if (is_fused_comparison(l->f, cond))
+    return 0;
+  Loc loc = loc_of(l, cond);
+  *is_true = loc.kind != LOC_IMM || loc.imm != 0;
+  return loc.kind == LOC_IMM || loc.kind == LOC_ADDR;
+}
+
+/**
+ * Set the flags for cond, the condition of a branch or select, and return the comparison to test them for: that of
+ * cond, if fused, or else inequality to zero.
+ */
+static IrOp emit_condition(Lowering *l, IrRef cond) {
+  IrFunction *f = l->f;
+  if (is_fused_comparison(f, cond))
+    return emit_compare(l, cond);
+  Loc loc = loc_of(l, cond);
+  int size = alu_size(f, cond);
+  if (loc.kind == LOC_REG) {
+    fprintf(l->out, "\ttest%c\t%s, %s\n", suffixes[size], loc_text(l, loc, size), loc_text(l, loc, size));
+  } else {
+    fprintf(l->out, "\tcmp%c\t$0, %s\n", suffixes[size], loc_text(l, loc, size));
+  }
+  return IR_NE;
+}
+
+static void emit_branch(Lowering *l, IrBlockRef b, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef cond = IR_ARG(f, inst, 0);
+  IrBlockRef if_true = l->forward[f->blocks[b].succs[0]], if_false = l->forward[f->blocks[b].succs[1]];
+  int is_true;
+  if (is_constant_condition(l, cond, &is_true)) {
+    emit_jump(l, is_true ? if_true : if_false);
+    return;
+  }
+  IrOp op = emit_condition(l, cond);
+  const char *if_set = condition_code(op), *if_clear = condition_code(negate_comparison(op));
+  if (if_true == l->next_block) {
+    fprintf(l->out, "\tj%s\t%s\n", if_clear, block_label(l, if_false));
+  } else {
+    fprintf(l->out, "\tj%s\t%s\n", if_set, block_label(l, if_true));
+    emit_jump(l, if_false);
+  }
+}
+
+/** The value is moved to RAX, which is free for scratch, for fprint_switch to compare or index with. */
+static void emit_switch(Lowering *l, IrBlockRef b, IrRef inst) {
+  IrFunction *f = l->f;
+  const IrBlock *block = &f->blocks[b];
+  IrRef value = IR_ARG(f, inst, 0);
+  int size = alu_size(f, value), n_cases = f->n_args[inst] - 1;
+  SwitchCase *cases = arena_alloc(f->arena, (n_cases + 1) * sizeof(SwitchCase));
+  for (int i = 0; i < n_cases; i++) {
+    IrBlockRef target = l->forward[block->succs[i + 1]];
+    cases[i] = (SwitchCase) {
+      .value = f->imm[IR_ARG(f, inst, i + 1)],
+      .label = block_label(l, target),
+      .count = ir_edge_count(f, b, i + 1),
+    };
+  }
+  emit_move(l, size, loc_of(l, value), reg_loc(RAX));
+  SwitchStrategy strategy = switch_strategy(cases, n_cases, size);
+  const char *prefix = fmtstr("LSW_%s_%u", f->name, b);
+  fprint_switch(l->out, size, cases, n_cases, block_label(l, l->forward[block->succs[0]]), ir_edge_count(f, b, 0),
+    prefix);
+  // A jump table goes back to the text section after itself, which need not be the section of the block.
+  const char *section = l->is_cold[b] ? COLD_SECTION : l->section;
+  if (strategy == SWITCH_JUMP_TABLE && section) {
+    fputs(section, l->out);
+  }
+}
+
+/**
+ * cmov overwrites the value if false, moved to where the result is computed, with the value if true, which must be in
+ * a register or memory, when the condition holds. The flags are set in between, so that clearing a register with xor
+ * does not clobber them. The result is computed in RDX unless the destination is a register holding neither the value
+ * if true nor an operand of the comparison.
+ */
+static void emit_select(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int size = alu_size(f, inst);
+  IrRef cond = IR_ARG(f, inst, 0);
+  Loc if_true = loc_of(l, IR_ARG(f, inst, 1)), if_false = loc_of(l, IR_ARG(f, inst, 2)), dst = loc_of(l, inst);
+  int is_true;
+  if (is_constant_condition(l, cond, &is_true)) {
+    emit_move(l, size, is_true ? if_true : if_false, dst);
+    return;
+  }
+  if (if_true.kind != LOC_REG && if_true.kind != LOC_MEM) {
+    emit_move(l, size, if_true, reg_loc(RCX));
+    if_true = reg_loc(RCX);
+  }
+  int is_fused = is_fused_comparison(f, cond);
+  int holds_operand = is_fused
+    ? same_loc(dst, loc_of(l, IR_ARG(f, cond, 0))) || same_loc(dst, loc_of(l, IR_ARG(f, cond, 1)))
+    : same_loc(dst, loc_of(l, cond));
+  Loc t = dst.kind == LOC_REG && !same_loc(dst, if_true) && !holds_operand ? dst : reg_loc(RDX);
+  emit_move(l, size, if_false, t);
+  const char *cc = condition_code(emit_condition(l, cond));
+  fprintf(l->out, "\tcmov%s%c\t%s, %s\n", cc, suffixes[size], loc_text(l, if_true, size), loc_text(l, t, size));
+  emit_move(l, size, t, dst);
+}
+
+// Vectors
+
+/** The register holding value, a vector, loading it into scratch first if it was spilled */
+static const char *vector_register(Lowering *l, IrRef value, X86Reg scratch) {
+  int size = value_size(l->f, value);
+  Loc loc = loc_of(l, value);
+  if (loc.kind != LOC_REG) {
+    emit_move(l, size, loc, reg_loc(scratch));
+    loc = reg_loc(scratch);
+  }
+  return loc_text(l, loc, size);
+}
+
+/** Where to compute a vector before moving it to dst: dst itself if it is a register that does not hold avoid. */
+static Loc vector_target(Loc dst, Loc avoid) {
+  return dst.kind == LOC_REG && !same_loc(dst, avoid) ? dst : reg_loc(XMM15);
+}
+
+static void emit_vector_binary(Lowering *l, IrRef inst, const char *mnemonic) {
+  IrFunction *f = l->f;
+  int size = value_size(f, inst);
+  IrRef a = IR_ARG(f, inst, 0), b = IR_ARG(f, inst, 1);
+  Loc dst = loc_of(l, inst);
+  if (l->vex) {
+    Loc t = vector_target(dst, (Loc) {0});
+    const char *a_text = vector_register(l, a, XMM15), *b_text = vector_register(l, b, XMM14);
+    fprintf(l->out, "\tv%s\t%s, %s, %s\n", mnemonic, b_text, a_text, loc_text(l, t, size));
+    emit_move(l, size, t, dst);
+    return;
+  }
+  if ((IR_OP_FLAGS[f->op[inst]] & IR_COMMUTATIVE) && same_loc(dst, loc_of(l, b))) {
+    IrRef tmp = a;
+    a = b;
+    b = tmp;
+  }
+  // SSE takes memory operands only if aligned, which spill slots are not.
+  Loc t = vector_target(dst, loc_of(l, b));
+  const char *b_text = vector_register(l, b, XMM14);
+  emit_move(l, size, loc_of(l, a), t);
+  fprintf(l->out, "\t%s\t%s, %s\n", mnemonic, b_text, loc_text(l, t, size));
+  emit_move(l, size, t, dst);
+}
+
+static void emit_vector_shift(Lowering *l, IrRef inst, const char *mnemonic) {
+  IrFunction *f = l->f;
+  int size = value_size(f, inst);
+  IrRef a = IR_ARG(f, inst, 0);
+  long long count = f->imm[IR_ARG(f, inst, 1)];
+  Loc dst = loc_of(l, inst);
+  Loc t = vector_target(dst, (Loc) {0});
+  if (l->vex) {
+    fprintf(l->out, "\tv%s\t$%lld, %s, %s\n", mnemonic, count, vector_register(l, a, XMM15), loc_text(l, t, size));
+  } else {
+    emit_move(l, size, loc_of(l, a), t);
+    fprintf(l->out, "\t%s\t$%lld, %s\n", mnemonic, count, loc_text(l, t, size));
+  }
+  emit_move(l, size, t, dst);
+}
+
+/** Multiply lane by lane. SSE2 only multiplies the even lanes, to 64 bits, so the odd ones are shifted down to them. */
+static void emit_vector_multiplication(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  if (l->vex) {
+    emit_vector_binary(l, inst, "pmulld");
+    return;
+  }
+  Loc a = loc_of(l, IR_ARG(f, inst, 0)), b = loc_of(l, IR_ARG(f, inst, 1));
+  emit_move(l, 16, a, reg_loc(XMM15));
+  emit_move(l, 16, b, reg_loc(XMM14));
+  emit_move(l, 16, a, reg_loc(XMM13));
+  fputs(
+    "\tpmuludq\t%xmm14, %xmm15\n"
+    "\tpsrlq\t$32, %xmm14\n"
+    "\tpsrlq\t$32, %xmm13\n"
+    "\tpmuludq\t%xmm14, %xmm13\n"
+    "\tpshufd\t$8, %xmm15, %xmm15\n"
+    "\tpshufd\t$8, %xmm13, %xmm13\n"
+    "\tpunpckldq\t%xmm13, %xmm15\n",
+    l->out
+  );
+  emit_move(l, 16, reg_loc(XMM15), loc_of(l, inst));
+}
+
+static void emit_splat(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int size = value_size(f, inst);
+  Loc src = loc_of(l, IR_ARG(f, inst, 0)), dst = loc_of(l, inst);
+  Loc t = vector_target(dst, (Loc) {0});
+  const char *t_text = loc_text(l, t, size);
+  if (src.kind == LOC_IMM && src.imm == 0) {
+    if (l->vex) {
+      fprintf(l->out, "\tvpxor\t%s, %s, %s\n", t_text, t_text, t_text);
+    } else {
+      fprintf(l->out, "\tpxor\t%s, %s\n", t_text, t_text);
+    }
+  } else {
+    if (src.kind == LOC_IMM) {
+      emit_move(l, 4, src, reg_loc(RAX));
+      src = reg_loc(RAX);
+    }
+    fprintf(l->out, "\t%s\t%s, %s\n", vector_op(l, "movd"), loc_text(l, src, 4), loc_text(l, t, 16));
+    if (l->vex) {
+      fprintf(l->out, "\tvpbroadcastd\t%s, %s\n", loc_text(l, t, 16), t_text);
+    } else {
+      fprintf(l->out, "\tpshufd\t$0, %s, %s\n", t_text, t_text);
+    }
+  }
+  emit_move(l, size, t, dst);
+}
+
+/** Add up the lanes: fold the upper half onto the lower until one lane is left. */
+static void emit_horizontal_sum(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef vector = IR_ARG(f, inst, 0);
+  Loc src = loc_of(l, vector);
+  if (value_size(f, vector) == 32) {
+    const char *src_text = vector_register(l, vector, XMM15);
+    fprintf(l->out, "\tvextracti128\t$1, %s, %%xmm14\n", src_text);
+    fprintf(l->out, "\tvpaddd\t%%xmm14, %s, %%xmm15\n", reg_names[src.kind == LOC_REG ? src.reg : XMM15][16]);
+  } else {
+    emit_move(l, 16, src, reg_loc(XMM15));
+  }
+  if (l->vex) {
+    fputs(
+      "\tvpshufd\t$78, %xmm15, %xmm14\n"
+      "\tvpaddd\t%xmm14, %xmm15, %xmm15\n"
+      "\tvpshufd\t$177, %xmm15, %xmm14\n"
+      "\tvpaddd\t%xmm14, %xmm15, %xmm15\n"
+      "\tvmovd\t%xmm15, %eax\n",
+      l->out
+    );
+  } else {
+    fputs(
+      "\tpshufd\t$78, %xmm15, %xmm14\n"
+      "\tpaddd\t%xmm14, %xmm15\n"
+      "\tpshufd\t$177, %xmm15, %xmm14\n"
+      "\tpaddd\t%xmm14, %xmm15\n"
+      "\tmovd\t%xmm15, %eax\n",
+      l->out
+    );
+  }
+  emit_move(l, 4, reg_loc(RAX), loc_of(l, inst));
+}
+
+static void emit_vector_load(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  int size = value_size(f, inst);
+  const char *memory = memory_text(l, IR_ARG(f, inst, 0));
+  Loc dst = loc_of(l, inst);
+  Loc t = vector_target(dst, (Loc) {0});
+  fprintf(l->out, "\t%s\t%s, %s\n", vector_op(l, "movdqu"), memory, loc_text(l, t, size));
+  emit_move(l, size, t, dst);
+}
+
+static void emit_vector_store(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrRef value = IR_ARG(f, inst, 1);
+  const char *src = vector_register(l, value, XMM15);
+  const char *memory = memory_text(l, IR_ARG(f, inst, 0));
+  fprintf(l->out, "\t%s\t%s, %s\n", vector_op(l, "movdqu"), src, memory);
+}
+
+/** Lower inst if it computes or stores a vector, and return whether it did. */
+static int emit_vector_instruction(Lowering *l, IrRef inst) {
+  IrFunction *f = l->f;
+  IrOp op = f->op[inst];
+  if (op == IR_HSUM) {
+    emit_horizontal_sum(l, inst);
+    return 1;
+  }
+  if (op == IR_STORE && IR_IS_VECTOR_TYPE(f->type[IR_ARG(f, inst, 1)])) {
+    emit_vector_store(l, inst);
+    return 1;
+  }
+  if (!IR_IS_VECTOR_TYPE(f->type[inst]))
+    return 0;
+  switch (op) {
+    case IR_PHI: break;
+    case IR_SPLAT: emit_splat(l, inst); break;
+    case IR_LOAD: emit_vector_load(l, inst); break;
+    case IR_ADD: emit_vector_binary(l, inst, "paddd"); break;
+    case IR_SUB: emit_vector_binary(l, inst, "psubd"); break;
+    case IR_MUL: emit_vector_multiplication(l, inst); break;
+    case IR_AND: emit_vector_binary(l, inst, "pand"); break;
+    case IR_OR: emit_vector_binary(l, inst, "por"); break;
+    case IR_XOR: emit_vector_binary(l, inst, "pxor"); break;
+    case IR_SHL: emit_vector_shift(l, inst, "pslld"); break;
+    case IR_SHR: emit_vector_shift(l, inst, "psrld"); break;
+    case IR_SAR: emit_vector_shift(l, inst, "psrad"); break;
+    default:
+      THROWF(EXC_INTERNAL, "cannot lower %s of vectors", IR_OP_NAMES[op]);
+  }
+  return 1;
+}
+
+static void emit_instruction(Lowering *l, IrBlockRef b, IrRef inst) {
+  IrFunction *f = l->f;
+  IrOp op = f->op[inst];
+  if (f->type[inst] != IR_VOID && (!needs_location(f, inst) || (IR_IS_PURE(f, inst) && !f->first_use[inst])))
+    return;  // folded into its uses, or dead
+  if (emit_vector_instruction(l, inst))
+    return;
+  switch (op) {
+    case IR_PARAM: case IR_PHI: case IR_NOP:
+      break;  // moved into place on entry to the function or the block
+    case IR_CONST:
+      emit_move(l, 8, (Loc) { .kind = LOC_IMM, .imm = f->imm[inst] }, loc_of(l, inst));
+      break;
+    case IR_ADD: emit_binary(l, inst, "add"); break;
+    case IR_SUB: emit_binary(l, inst, "sub"); break;
+    case IR_MUL: emit_multiplication(l, inst); break;
+    case IR_AND: emit_binary(l, inst, "and"); break;
+    case IR_OR: emit_binary(l, inst, "or"); break;
+    case IR_XOR: emit_binary(l, inst, "xor"); break;
+    case IR_SDIV: case IR_UDIV: case IR_SREM: case IR_UREM:
+      emit_division(l, inst);
+      break;
+    case IR_SHL: emit_shift(l, inst, "shl"); break;
+    case IR_SHR: emit_shift(l, inst, "shr"); break;
+    case IR_SAR: emit_shift(l, inst, "sar"); break;
+    case IR_EQ: case IR_NE: case IR_SLT: case IR_SLE: case IR_SGT: case IR_SGE:
+    case IR_ULT: case IR_ULE: case IR_UGT: case IR_UGE:
+    case IR_FEQ: case IR_FNE: case IR_FLT: case IR_FLE: case IR_FGT: case IR_FGE:
+      emit_comparison(l, inst);
+      break;
+    case IR_FADD: emit_float_binary(l, inst, "add"); break;
+    case IR_FSUB: emit_float_binary(l, inst, "sub"); break;
+    case IR_FMUL: emit_float_binary(l, inst, "mul"); break;
+    case IR_FDIV: emit_float_binary(l, inst, "div"); break;
+    case IR_SEXT: case IR_ZEXT: case IR_TRUNC:
+      emit_extension(l, inst);
+      break;
+    case IR_SITOFP: case IR_FPTOSI: case IR_FPEXT: case IR_FPTRUNC:
+      emit_float_conversion(l, inst);
+      break;
+    case IR_LOAD:
+      emit_load(l, inst);
+      break;
+    case IR_STORE:
+      emit_store(l, inst);
+      break;
+    case IR_ZERO:
+      emit_zero(l, inst);
+      break;
+    case IR_COPY:
+      emit_copy(l, inst);
+      break;
+    case IR_COUNT:
+      emit_count(l, inst);
+      break;
+    case IR_CALL:
+      emit_call(l, inst);
+      break;
+    case IR_RET:
+      if (f->prev[inst] && f->op[f->prev[inst]] == IR_CALL && is_jump_call(l, f->prev[inst]))
+        break;  // the callee returns for us
+      if (f->n_args[inst]) {
+        IrRef value = IR_ARG(f, inst, 0);
+        X86Reg reg = IR_IS_FLOAT_TYPE(f->type[value]) ? XMM0 : RAX;
+        emit_move(l, alu_size(f, value), loc_of(l, value), reg_loc(reg));
+      }
+      emit_epilogue(l);
+      break;
+    case IR_JMP:
+      emit_phi_moves(l, b);
+      emit_jump(l, f->blocks[b].succs[0]);
+      break;
+    case IR_BR:
+      emit_branch(l, b, inst);
+      break;
+    case IR_SELECT:
+      emit_select(l, inst);
+      break;
+    case IR_SWITCH:
+      emit_switch(l, b, inst);
+      break;
+    default:
+      THROWF(EXC_INTERNAL, "cannot lower %s", IR_OP_NAMES[op]);
+  }
+}
+
+/**
+ * Emit the literal pool after the function. Mach-O's literal sections let the linker merge equal constants across the
+ * whole program.
+ */
+/** Where parameter param arrives: in its register, or else the next of the slots above the return address */
+static Loc param_loc(const Lowering *l, IrRef param) {
+  const IrFunction *f = l->f;
+  X86Reg reg = param_reg(f, param);
+  if (reg != N_X86_REGS)
+    return reg_loc(reg);
+  int index = 0;
+  for (IrRef inst = f->blocks[IR_ENTRY_BLOCK].first; inst; inst = f->next[inst]) {
+    index += f->op[inst] == IR_PARAM && f->imm[inst] < f->imm[param] && param_reg(f, inst) == N_X86_REGS;
+  }
+  return (Loc) { .kind = LOC_MEM, .frame_offset = l->incoming_offset + 8 * index };
+}
+
+static void emit_literal_pool(FILE *out, const Lowering *l) {
+  const IrFunction *f = l->f;
+  for (int k = 0; k < l->n_literals; k++) {
+    IrRef literal = l->literals[k];
+    int size = value_size(f, literal);
+    fprintf(out, "\t.literal%d\n\t.p2align\t%d\nLCPI_%s_%d:\n\t.%s\t0x%llx\t\t# %g\n", size, size == 8 ? 3 : 2,
+      f->name, k, size == 8 ? "quad" : "long", (unsigned long long) f->imm[literal],
+      ir_float_value(f->type[literal], f->imm[literal]));
+  }
+  if (l->n_literals) {
+    fputs("\t.text\n", out);
+  }
+}
+
+/**
+ * Lay out IR slots and then spill slots below the saved registers, and set the frame size, keeping %rsp 16-byte
+ * aligned. Offsets are from where %rbp points, or would if it were pushed, which is 16-byte aligned; without a frame
+ * pointer they are then made relative to %rsp. A leaf function whose frame fits in the red zone below %rsp subtracts
+ * nothing from it.
+ */
+static void lay_out_frame(Lowering *l, int is_leaf) {
+  IrFunction *f = l->f;
+  int saved_size = 8 * __builtin_popcount(l->saved_regs);
+  int has_frame_pointer = !strcmp(l->frame_base, "%rbp");
+  // Without a frame pointer, the first saved register takes the place of %rbp.
+  int offset = has_frame_pointer ? saved_size : MAX(saved_size - 8, 0);
+  l->slot_offsets = arena_alloc(f->arena, (f->n_slots + 1) * sizeof(int));
+  for (uint32_t i = 0; i < f->n_slots; i++) {
+    offset = ROUND_UP(offset + f->slots[i].size, f->slots[i].align);
+    l->slot_offsets[i] = -offset;
+  }
+  l->spill_offsets = arena_alloc(f->arena, (l->alloc->n_spill_slots + 1) * sizeof(int));
+  for (int i = 0; i < l->alloc->n_spill_slots; i++) {
+    offset = ROUND_UP(offset + l->alloc->spill_sizes[i], 8);
+    l->spill_offsets[i] = -offset;
+  }
+  // The slots for stack arguments go at the bottom, where %rsp points during calls.
+  int bottom = ROUND_UP(offset + 8 * l->n_outgoing, 16);
+  l->incoming_offset = 16;
+  if (has_frame_pointer) {
+    l->frame_size = bottom - saved_size;
+    l->outgoing_offset = -bottom;
+    return;
+  }
+  l->frame_size = is_leaf && offset + 8 - saved_size <= RED_ZONE_SIZE ? 0 : bottom + 8 - saved_size;
+  l->outgoing_offset = 0;
+  int from_rsp = saved_size + l->frame_size - 8;
+  l->incoming_offset += from_rsp;
+  for (uint32_t i = 0; i < f->n_slots; i++) {
+    l->slot_offsets[i] += from_rsp;
+  }
+  for (int i = 0; i < l->alloc->n_spill_slots; i++) {
+    l->spill_offsets[i] += from_rsp;
+  }
+}
+
+/** The successor of b not placed yet along the edge taken most often, if any was taken */
+static IrBlockRef likeliest_successor(const IrFunction *f, const uint8_t *placed, IrBlockRef b) {
+  const IrBlock *block = &f->blocks[b];
+  IrBlockRef ret = IR_NONE;
+  uint64_t taken = 0;
+  for (uint32_t i = 0; i < block->n_succs; i++) {
+    uint64_t count = ir_edge_count(f, b, i);
+    if (!placed[block->succs[i]] && count > taken) {
+      taken = count;
+      ret = block->succs[i];
+    }
+  }
+  return ret;
+}
+
+/**
+ * Order the blocks by their counts: chain them so that each falls through to its successor along the edge taken most
+ * often, unless that one is placed already. Each chain starts from the first block in reverse postorder that ran and
+ * is not placed yet, and the blocks that never ran come last, out of the way.
+ */
+static int lay_out_by_counts(const IrFunction *f, const IrBlockRef *rpo, int n_rpo, IrBlockRef *order) {
+  uint8_t *placed = arena_alloc(f->arena, f->n_blocks);
+  int n = 0;
+  for (int k = 0; k < n_rpo; k++) {
+    IrBlockRef prev = IR_NONE;
+    for (IrBlockRef b = rpo[k]; b && !placed[b] && f->blocks[b].count;) {
+      placed[b] = 1;
+      order[n++] = b;
+      IrBlockRef next = likeliest_successor(f, placed, b);
+      // A block going back where the chain has been, as one splitting a back edge does, leaves by a jump anyway, and
+      // is often dropped for only jumping; the chain goes on from the branch before it.
+      if (!next && prev) {
+        next = likeliest_successor(f, placed, prev);
+      }
+      prev = b;
+      b = next;
+    }
+  }
+  for (int k = 0; k < n_rpo; k++) {
+    if (!placed[rpo[k]]) {
+      order[n++] = rpo[k];
+    }
+  }
+  assert(n == n_rpo);
+  return n;
+}
+
+/**
+ * Order the blocks for allocation and emission by their counts, so the likely path falls through. A function that
+ * never ran, or never returns, is cold throughout and goes in reverse postorder, except that a block splitting a back
+ * edge follows the branch it comes from, rather than the return where the order leaves it. The values carried around
+ * the loop are then live only within it.
+ */
+static int lay_out_blocks(IrFunction *f, IrBlockRef *order) {
+  IrBlockRef *rpo = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int n_order = ir_reverse_postorder(f, rpo);
+  if (f->blocks[IR_ENTRY_BLOCK].count)
+    return lay_out_by_counts(f, rpo, n_order, order);
+  int *position = arena_alloc(f->arena, f->n_blocks * sizeof(int));
+  for (int k = 0; k < n_order; k++) {
+    position[rpo[k]] = k;
+  }
+  uint8_t *trails = arena_alloc(f->arena, f->n_blocks);
+  for (int k = 0; k < n_order; k++) {
+    const IrBlock *block = &f->blocks[rpo[k]];
+    trails[rpo[k]] = block->n_preds == 1 && block->n_succs == 1 && f->blocks[block->preds[0]].n_succs > 1
+      && position[block->succs[0]] <= position[block->preds[0]];
+  }
+  int n = 0;
+  for (int k = 0; k < n_order; k++) {
+    if (trails[rpo[k]])
+      continue;
+    order[n++] = rpo[k];
+    const IrBlock *block = &f->blocks[rpo[k]];
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      if (trails[block->succs[i]]) {
+        order[n++] = block->succs[i];
+      }
+    }
+  }
+  assert(n == n_order);
+  return n_order;
+}
+
+/**
+ * Give each select on a comparison a copy of it right before, whose flags it can test, unless it already has the
+ * comparison to itself there. Comparing again is cheaper than materializing the result with setcc and testing that.
+ */
+static void fuse_select_conditions(IrFunction *f) {
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    if (!f->block[inst] || f->op[inst] != IR_SELECT)
+      continue;
+    IrRef cond = IR_ARG(f, inst, 0);
+    if (is_flag_comparison(f, cond) && !is_fused_comparison(f, cond)) {
+      IrRef args[] = {IR_ARG(f, cond, 0), IR_ARG(f, cond, 1)};
+      ir_set_arg(f, inst, 0, ir_insert_before(f, inst, f->op[cond], f->type[cond], 2, args, 0));
+    }
+  }
+}
+
+static void emit_function(FILE *file_out, IrFunction *f, const VisitorOptions *options) {
+  // Buffer the function for the peephole pass.
+  char *text;
+  size_t text_size;
+  FILE *out = checked_open_memstream(&text, &text_size);
+  // Counting and instrumenting find the blocks as the front end built them, before anything changes them.
+  n_functions++;
+  int is_hot = 0;
+  if (profile && apply_profile(f, profile)) {
+    n_profiled++;
+    for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+      is_hot |= f->blocks[b].count >= profile_hot_count(profile);
+    }
+  } else {
+    estimate_counts(f);
+  }
+  // Functions that never ran, or never return, go with the cold blocks of the rest, and hot ones together.
+  int is_cold = !f->blocks[IR_ENTRY_BLOCK].count;
+  const char *section = is_cold ? COLD_SECTION : is_hot ? HOT_SECTION : 0;
+  uint64_t count = f->has_profile ? f->blocks[IR_ENTRY_BLOCK].count : 0;
+  if (profile_path) {
+    InstrumentedFunction function = { .name = fmtstr("%s", f->name), .shape = ir_shape_hash(f), .first = n_counters };
+    function.n_counters = instrument_blocks(f, n_counters);
+    n_counters += function.n_counters;
+    APPEND_VECTOR(instrumented, function);
+  }
+  eliminate_tail_recursion(f, &ir_opt_stats);
+  inline_calls(f, inline_bodies, &ir_opt_stats);
+  number_values(f, &ir_opt_stats);
+  fold_constant_branches(f, &ir_opt_stats);
+  eliminate_dead_stores(f, &ir_opt_stats);
+  // Kept before the loop passes, which callers run again on the copies along with their own code
+  eliminate_dead_code(f, &ir_opt_stats);
+  convert_branches_to_selects(f, &ir_opt_stats);
+  keep_inline_body(inline_bodies, f);
+  hoist_loop_invariants(f, &ir_opt_stats);
+  vectorize_loops(f, options->vector_size, &ir_opt_stats);
+  reduce_induction_variables(f, &ir_opt_stats);
+  fuse_select_conditions(f);
+  eliminate_dead_code(f, &ir_opt_stats);
+  ir_split_critical_edges(f);
+  IrBlockRef *order = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int n_order = lay_out_blocks(f, order);
+
+  Lowering l = { .out = out, .f = f, .vex = options->vector_size == 32, .may_tail_call = !frame_escapes(f) };
+  l.literal_of = arena_alloc(f->arena, f->n_insts * sizeof(int));
+  l.literals = arena_alloc(f->arena, f->n_insts * sizeof(IrRef));
+  int is_leaf = 1;
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    if (f->block[inst] && f->op[inst] == IR_CALL) {
+      is_leaf = 0;
+      l.n_outgoing = MAX(l.n_outgoing, n_stack_args(f, inst));
+    }
+    l.uses_ymm |= f->block[inst] && f->type[inst] == IR_V8I32;
+    // Unrolled zeros and copies of 32 bytes or more use YMM15 in AVX encodings.
+    l.uses_ymm |= l.vex && f->block[inst] && (f->op[inst] == IR_ZERO || f->op[inst] == IR_COPY)
+      && f->imm[inst] >= 32 && block_strategy(f->imm[inst]) == BLOCK_INLINE;
+    if (f->block[inst] && f->op[inst] == IR_CONST && IR_IS_FLOAT_TYPE(f->type[inst])) {
+      int k = 0;
+      while (k < l.n_literals && (f->imm[l.literals[k]] != f->imm[inst] || f->type[l.literals[k]] != f->type[inst])) {
+        k++;
+      }
+      if (k == l.n_literals) {
+        l.literals[l.n_literals++] = inst;
+      }
+      l.literal_of[inst] = k;
+    }
+  }
+  l.alloc = linear_scan(f, order, n_order, &register_info);
+  l.saved_regs = l.alloc->used_regs & CALLEE_SAVED_MASK;
+  // A leaf has no callers below it to unwind through its frame pointer.
+  l.frame_base = is_leaf || options->omit_frame_pointer ? "%rsp" : "%rbp";
+  lay_out_frame(&l, is_leaf);
+  n_values_allocated += l.alloc->n_intervals;
+  n_values_spilled += l.alloc->n_spilled;
+
+  if (section) {
+    fputs(section, out);
+  }
+  if (!f->is_static) {
+    fprintf(out, "\t.globl\t_%s\n", f->name);
+  }
+  fprintf(out, "\t.p2align\t4, 0x90\n_%s:\n", f->name);
+  if (!strcmp(l.frame_base, "%rbp")) {
+    fputs("\tpushq\t%rbp\n\tmovq\t%rsp, %rbp\n", out);
+  }
+  for (int r = 0; r < N_ALLOCATABLE; r++) {
+    if (l.saved_regs >> r & 1) {
+      fprintf(out, "\tpushq\t%s\n", reg_names[allocatable[r]][8]);
+    }
+  }
+  if (l.frame_size) {
+    fprintf(out, "\tsubq\t$%d, %%rsp\n", l.frame_size);
+  }
+
+  Move *moves = arena_alloc(f->arena, (f->n_params + 1) * sizeof(Move));
+  int n_moves = 0;
+  for (IrRef inst = f->blocks[IR_ENTRY_BLOCK].first; inst; inst = f->next[inst]) {
+    if (f->op[inst] == IR_PARAM && needs_location(f, inst)) {
+      int size = IR_IS_FLOAT_TYPE(f->type[inst]) ? value_size(f, inst) : 8;
+      moves[n_moves++] = (Move) { .src = param_loc(&l, inst), .dst = loc_of(&l, inst), .size = size };
+    }
+  }
+  emit_parallel_moves(&l, moves, n_moves);
+
+  // A function cold throughout has its blocks together; the rest have those that never ran, or never return, last.
+  l.section = section;
+  l.is_cold = arena_alloc(f->arena, f->n_blocks);
+  for (int k = 0; k < n_order && !is_cold; k++) {
+    l.is_cold[order[k]] = !f->blocks[order[k]].count;
+  }
+
+  // Drop the blocks that only jump on from the layout, resolving chains of them.
+  l.forward = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    l.forward[b] = forwarded_block(&l, b);
+  }
+  for (IrBlockRef b = IR_ENTRY_BLOCK; b < f->n_blocks; b++) {
+    int n = 0;
+    for (; l.forward[l.forward[b]] != l.forward[b] && n < n_order; n++) {
+      l.forward[b] = l.forward[l.forward[b]];
+    }
+    if (n == n_order) {
+      l.forward[b] = b;  // a cycle of jumps, as an empty infinite loop has
+    }
+  }
+  int n_kept = 0;
+  for (int k = 0; k < n_order; k++) {
+    if (l.forward[order[k]] == order[k]) {
+      order[n_kept++] = order[k];
+    }
+  }
+  n_order = n_kept;
+
+  // Align loop headers, the targets of edges going back in reverse postorder, so each iteration starts on a fresh
+  // fetch block. Not those of backward jumps: a profile may put cold blocks after the blocks they jump back to.
+  IrBlockRef *rpo = arena_alloc(f->arena, f->n_blocks * sizeof(IrBlockRef));
+  int n_rpo = ir_reverse_postorder(f, rpo);
+  int *position = arena_alloc(f->arena, f->n_blocks * sizeof(int));
+  for (int k = 0; k < n_rpo; k++) {
+    position[rpo[k]] = k;
+  }
+  uint8_t *is_loop_header = arena_alloc(f->arena, f->n_blocks);
+  for (int k = 0; k < n_order; k++) {
+    const IrBlock *block = &f->blocks[order[k]];
+    for (uint32_t i = 0; i < block->n_succs; i++) {
+      is_loop_header[l.forward[block->succs[i]]] |= position[l.forward[block->succs[i]]] <= position[order[k]];
+    }
+  }
+  for (int k = 0; k < n_order; k++) {
+    IrBlockRef b = order[k];
+    // Nothing falls through from one section to the other.
+    l.next_block = k + 1 < n_order && l.is_cold[order[k + 1]] == l.is_cold[b] ? order[k + 1] : IR_NONE;
+    if (k > 0) {
+      if (l.is_cold[b] && !l.is_cold[order[k - 1]]) {
+        fputs(COLD_SECTION, out);
+      }
+      if (is_loop_header[b]) {
+        fputs("\t.p2align\t4, 0x90\n", out);
+      }
+      fprintf(out, "%s:\n", block_label(&l, b));
+    }
+    IR_FOR_EACH_INST(f, b, inst) {
+      emit_instruction(&l, b, inst);
+    }
+  }
+  if (section || l.is_cold[order[n_order - 1]]) {
+    fputs("\t.text\n", out);
+  }
+
+  // What calls to f from the functions after it overwrite; the callee-saved registers it uses are restored.
+  uint32_t clobbered = (l.alloc->used_regs & ~CALLEE_SAVED_MASK) | (l.uses_ymm ? VECTOR_MASK : 0);
+  for (IrRef inst = 1; inst < f->n_insts; inst++) {
+    clobbered |= f->block[inst] ? clobbers(f, inst) : 0;
+  }
+  set_clobbers(f->name, clobbered);
+
+  checked_fclose(out);
+  char *optimized = peephole_optimize(text, &peephole_stats);
+  // With a profile, the functions go out at the end, the most called first.
+  char *held_text;
+  size_t held_size;
+  FILE *dest = profile ? checked_open_memstream(&held_text, &held_size) : file_out;
+  fputs(optimized, dest);
+  free(optimized);
+  free(text);
+  emit_literal_pool(dest, &l);
+  if (profile) {
+    checked_fclose(dest);
+    APPEND_VECTOR(emitted, ((EmittedFunction) { .text = held_text, .count = count, .index = emitted_size }));
+  }
+}
+
+static void start(FILE *out, const VisitorOptions *options) {
+  if (options->profile_use) {
+    profile = read_profile(options->profile_use);
+    NEW_VECTOR(emitted, sizeof(EmittedFunction));
+  }
+  profile_path = options->profile_generate;
+  if (profile_path) {
+    NEW_VECTOR(instrumented, sizeof(InstrumentedFunction));
+  }
+  inline_bodies = new_inline_bodies(profile ? profile_hot_count(profile) : 0);
+  known_clobbers = kh_init_Clobbers();
+  if (!options->no_timestamp) {
+    time_t curr_time = time(0);
+    char timebuf[27];
+    ctime_r(&curr_time, timebuf);
+    fprintf(out, "# KUI'S COMPILER at %s", timebuf);
+  }
+}
+
+static void emit_global(FILE *out, const char *name, int size, int align) {
+  // Mach-O takes the alignment as a power of two
+  fprintf(out, "\t.comm\t_%s,%d,%d\n", name, size, __builtin_ctz(align));
+}
+
+/** The most called first, and those called as often in the order they were defined */
+static int compare_emitted(const void *a, const void *b) {
+  const EmittedFunction *x = a, *y = b;
+  if (x->count != y->count)
+    return x->count < y->count ? 1 : -1;
+  return x->index - y->index;
+}
+
+// Called at exit, to add a line per function to the profile, as read_profile reads it. %rbx holds the file, %r12 the
+// entry of the function in the table, %r13 the number of its counters left and %r14 the next of them; %r15 is saved
+// only to keep %rsp aligned for the calls.
+static const char profile_writer[] =
+  "\t.p2align\t4, 0x90\n"
+  "___kuicc_profile_write:\n"
+  "\tpushq\t%rbx\n\tpushq\t%r12\n\tpushq\t%r13\n\tpushq\t%r14\n\tpushq\t%r15\n"
+  "\tleaq\tLprofile_path(%rip), %rdi\n"
+  "\tleaq\tLprofile_mode(%rip), %rsi\n"
+  "\tcallq\t_fopen\n"
+  "\ttestq\t%rax, %rax\n"
+  "\tje\tLprofile_done\n"
+  "\tmovq\t%rax, %rbx\n"
+  "\tleaq\tLprofile_functions(%rip), %r12\n"
+  "Lprofile_function:\n"
+  "\tmovq\t(%r12), %rdx\n"
+  "\ttestq\t%rdx, %rdx\n"
+  "\tje\tLprofile_close\n"
+  "\tmovq\t%rbx, %rdi\n"
+  "\tleaq\tLprofile_header(%rip), %rsi\n"
+  "\tmovq\t8(%r12), %rcx\n"
+  "\tmovq\t16(%r12), %r8\n"
+  "\txorl\t%eax, %eax\n"
+  "\tcallq\t_fprintf\n"
+  "\tmovq\t16(%r12), %r13\n"
+  "\tmovq\t24(%r12), %r14\n"
+  "Lprofile_counter:\n"
+  "\ttestq\t%r13, %r13\n"
+  "\tje\tLprofile_line_end\n"
+  "\tmovq\t%rbx, %rdi\n"
+  "\tleaq\tLprofile_count(%rip), %rsi\n"
+  "\tmovq\t(%r14), %rdx\n"
+  "\txorl\t%eax, %eax\n"
+  "\tcallq\t_fprintf\n"
+  "\taddq\t$8, %r14\n"
+  "\tdecq\t%r13\n"
+  "\tjmp\tLprofile_counter\n"
+  "Lprofile_line_end:\n"
+  "\tmovl\t$10, %edi\n"
+  "\tmovq\t%rbx, %rsi\n"
+  "\tcallq\t_fputc\n"
+  "\taddq\t$32, %r12\n"
+  "\tjmp\tLprofile_function\n"
+  "Lprofile_close:\n"
+  "\tmovq\t%rbx, %rdi\n"
+  "\tcallq\t_fclose\n"
+  "Lprofile_done:\n"
+  "\tpopq\t%r15\n\tpopq\t%r14\n\tpopq\t%r13\n\tpopq\t%r12\n\tpopq\t%rbx\n"
+  "\tretq\n"
+  "\t.p2align\t4, 0x90\n"
+  "___kuicc_profile_start:\n"
+  "\tleaq\t___kuicc_profile_write(%rip), %rdi\n"
+  "\tjmp\t_atexit\n"
+  "\t.mod_init_func\n"
+  "\t.p2align\t3\n"
+  "\t.quad\t___kuicc_profile_start\n";
+
+/**
+ * The counters of the translation unit, which are its own, a table of the functions they count the blocks of, and
+ * code to write them out at exit, which a static constructor registers with atexit. Every function instrumented gets
+ * a line, so -U can tell one that never ran from one it has no counts for.
+ */
+static void emit_profile_runtime(FILE *out) {
+  fprintf(out, "\t.lcomm\t_%s,%d,3\n", PROFILE_COUNTERS, 8 * n_counters);
+  fputs("\t.cstring\nLprofile_path:\n\t.asciz\t\"", out);
+  for (const char *p = profile_path; *p; p++) {
+    fprintf(out, *p == '"' || *p == '\\' ? "\\%c" : "%c", *p);
+  }
+  fputs("\"\nLprofile_mode:\n\t.asciz\t\"a\"\n", out);
+  fputs("Lprofile_header:\n\t.asciz\t\"%s %llx %llu\"\nLprofile_count:\n\t.asciz\t\" %llu\"\n", out);
+  for (int i = 0; i < instrumented_size; i++) {
+    fprintf(out, "Lprofile_name_%d:\n\t.asciz\t\"%s\"\n", i, instrumented[i].name);
+  }
+  // Per function: its name, shape, number of counters and first counter; then a null name
+  fputs("\t.data\n\t.p2align\t3\nLprofile_functions:\n", out);
+  for (int i = 0; i < instrumented_size; i++) {
+    const InstrumentedFunction *function = &instrumented[i];
+    fprintf(out, "\t.quad\tLprofile_name_%d\n\t.quad\t0x%llx\n\t.quad\t%d\n\t.quad\t_%s+%d\n", i,
+      (unsigned long long) function->shape, function->n_counters, PROFILE_COUNTERS, 8 * function->first);
+  }
+  fputs("\t.quad\t0\n\t.text\n", out);
+  fputs(profile_writer, out);
+}
+
+static void finish(FILE *out) {
+  if (profile) {
+    qsort(emitted, emitted_size, sizeof(EmittedFunction), compare_emitted);
+    for (int i = 0; i < emitted_size; i++) {
+      fputs(emitted[i].text, out);
+      free(emitted[i].text);
+    }
+    free(emitted);
+    free_profile(profile);
+    fprintf(stderr, "Profile: counts for %d of %d functions\n", n_profiled, n_functions);
+  }
+  if (profile_path) {
+    if (n_counters) {
+      emit_profile_runtime(out);
+    }
+    for (int i = 0; i < instrumented_size; i++) {
+      free((char *) instrumented[i].name);
+    }
+    free(instrumented);
+    fprintf(stderr, "Profile: %d functions instrumented with %d counters\n", n_functions, n_counters);
+  }
+  fprintf(stderr, "Register allocation: %d values, %d spilled\n", n_values_allocated, n_values_spilled);
+  fprintf(stderr, "Tail calls: %d made jumps\n", n_tail_calls);
+  fprint_ir_opt_stats(stderr, &ir_opt_stats);
+  fprint_peephole_stats(stderr, &peephole_stats);
+  free_inline_bodies(inline_bodies);
+  for (khiter_t iter = kh_begin(known_clobbers); iter != kh_end(known_clobbers); iter++) {
+    if (kh_exist(known_clobbers, iter)) {
+      free((char *) kh_key(known_clobbers, iter));
+    }
+  }
+  kh_destroy_Clobbers(known_clobbers);
+}
+
+/**
+ * The registers the function overwrites and the body kept to inline it, so that callers compiled after it is replayed
+ * from the cache get the code they would get after it is compiled.
+ */
+static void save_function(FILE *out, const char *name) {
+  khiter_t iter = kh_get_Clobbers(known_clobbers, name);
+  assert(iter != kh_end(known_clobbers));
+  fprintf(out, "%s %x\n", name, kh_val(known_clobbers, iter));
+  const IrFunction *body = kept_inline_body(inline_bodies, name);
+  if (body) {
+    fwrite_ir_function(out, body);
+  }
+}
+
+static void restore_function(FILE *in) {
+  char name[1024];
+  unsigned clobbered;
+  THROW_IF(fscanf(in, "%1023s %x", name, &clobbered) != 2, EXC_SYSTEM, "corrupt cached clobbers");
+  set_clobbers(name, clobbered);
+  IrFunction *body = read_ir_function(in);
+  if (body) {
+    restore_inline_body(inline_bodies, body);
+  }
+}
+
+static const IrBackend x86_64_backend = {
+  .start = start,
+  .emit_global = emit_global,
+  .emit_function = emit_function,
+  .finish = finish,
+  .save_function = save_function,
+  .restore_function = restore_function,
+};
+
+Visitor *new_x86_64_ir_visitor(FILE *out, const VisitorOptions *options) {
+  return new_ssa_backend_visitor(out, options, &x86_64_backend);
+}
@@ -1,12 +1,18 @@
 #include <assert.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 #include "visitor.h"
 #include "types.h"
 #include "stdio.h"
 #include "common.h"
+#include "memops.h"
+#include "peephole.h"
+#include "strength.h"
+#include "switches.h"
 
-// every value has a PERMANENT location that is not in a register.
+// every variable has a PERMANENT location that is not in a register. Expression temporaries are not stored at all
+// until they are used: see evaluate().
 typedef enum {
   LOC_NONE = 0,
   // these locations represent the user's program variables or constants
@@ -15,6 +21,8 @@ typedef enum {
   LOC_GLOBAL,
   // these derived locations are generated by the codegen
   LOC_INDEXED,
+  LOC_EXPR,  // a deferred operation on other values
+  LOC_REGISTER,  // a scratch register, holding an evaluated LOC_EXPR until its single use
 } LocationKind;
 
 typedef struct {
@@ -27,6 +35,13 @@ typedef struct {
 #define IS_CONST_INDEX(index) !(index).index_expr
 #define IS_SCALED_INDEX(index) ((index).scale > 0)
 
+typedef struct {
+  TokenKind op;
+  struct x86_64_Value *left;
+  struct x86_64_Value *right;  // NULL for a conversion of left to the type of the expression, which ignores op
+  int need;  // registers needed to evaluate it without spilling (Sethi-Ullman number)
+} Expr;
+
 typedef struct x86_64_Value {
   const Type *type;
   LocationKind location_kind;
@@ -36,49 +51,56 @@ typedef struct x86_64_Value {
     int64_t integer_immediate;  // for LOC_IMMEDIATE
     double float_immediate;  // ditto
     Index index;
+    Expr expr;
+    int reg;  // for LOC_REGISTER: index into scratch_registers, or float_scratch_registers if floating
   };
-  int in_accum;  // if it is TEMPORARILY in the accumulator
-  int in_flags;  // ... or flags register
+  int in_flags;  // if it is TEMPORARILY in the flags register
   const char *debug_name;
 } x86_64_Value;
 
 
+/** A floating constant in the literal pool of the current function, by its bits */
+typedef struct {
+  int64_t bits;
+  int size;
+} FloatLiteral;
+
+/** An object cleared for its initializer; the stores of the initializer are tracked so only the rest is cleared. */
+typedef struct {
+  x86_64_Value *object;
+  uint8_t *written;  // by byte of the object: whether the initializer stores to it
+} ZeroedObject;
+
 typedef struct {
   Visitor _visitor;
   // current contents
   x86_64_Value *flags_contents;
-  x86_64_Value *accum_contents;  // are they the same now?
-  int curr_rbp_offset;
+  uint32_t free_scratch;  // mask of the scratch registers not holding a value
+  uint32_t free_float_scratch;  // likewise of the float scratch registers
+  int frame_size;  // bytes of locals and temporaries below %rbp so far; the prologue reserves them all at once
+  DECLARE_VECTOR(x86_64_Value *, free_temporaries)  // stack slots of temporaries no longer in use
+  DECLARE_VECTOR(ZeroedObject, zeroed_objects)  // in the current function; see visit_zero_object
+  DECLARE_VECTOR(FloatLiteral, literals)  // the literal pool of the current function; see literal_address
   int curr_temp_id;
+  int curr_label_id;
   int curr_func_param;
-  FILE *out;  // should be a memstream
+  int curr_func_float_param;
+  int curr_func_stack_param;  // parameters so far passed on the stack, for want of registers
+  FILE *out;  // memstream holding the current function definition, or file_out outside of functions
+  FILE *file_out;
+  char *function_text;  // text of the last function definition
+  size_t function_text_size;
   const Type *curr_func_return_type;
+  const char *curr_func_name;
+  int curr_func_is_static;
+  PeepholeStats peephole_stats;
+  VisitorOptions options;
 } x86_64_Visitor;
 
 const Type *type_of(const x86_64_Value *val) {
   return val->type;
 }
 
-static int total_size(const Type *type) {
-  // TODO: Support variable sized arrays, and structs with flexible members
-  return type->kind == TY_ARRAY ? type->size * total_size(type->child_type) : type->size;
-}
-
-static int child_size(const Type *type) {
-  assert(type->child_type && "child_size called on an object without a child_type!");
-  return total_size(type->child_type);
-}
-
-static int align(const Type *type) {
-  if (IS_SCALAR_TYPE(type)) {
-    return type->size;
-  }
-  if (type->kind == TY_ARRAY) {
-    return align(type->child_type);
-  }
-  THROWF(EXC_INTERNAL, "Unsupported type kind %d", type->kind);
-}
-
 // generalize to more registers
 static char *accum_register(int size) {
   switch (size) {
@@ -126,11 +148,52 @@ static const char param_registers[][6][5] = {
   [8] = {"%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9"},
 };
 
-static const char *operator(char *op, int size) {
+// Caller-saved registers for expression temporaries. rax and rdx are left to division, rcx and r10 to indexed_addr.
+#define N_SCRATCH 5
+#define ALL_SCRATCH ((1u << N_SCRATCH) - 1)
+static const char scratch_registers[][N_SCRATCH][6] = {
+  [1] = {"%sil", "%dil", "%r8b", "%r9b", "%r11b"},
+  [2] = {"%si", "%di", "%r8w", "%r9w", "%r11w"},
+  [4] = {"%esi", "%edi", "%r8d", "%r9d", "%r11d"},
+  [8] = {"%rsi", "%rdi", "%r8", "%r9", "%r11"},
+};
+
+// Floating values are computed in XMM registers, with SSE2's scalar instructions. These are all caller-saved too, and
+// clear of xmm0-xmm7, which pass arguments.
+#define N_FLOAT_SCRATCH 5
+#define ALL_FLOAT_SCRATCH ((1u << N_FLOAT_SCRATCH) - 1)
+static const char float_scratch_registers[N_FLOAT_SCRATCH][7] = {"%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12"};
+
+static const char *operator(const char *op, int size) {
   return fmtstr("%s%c", op, suffixes[size]);
 }
 
+static int is_float(const Type *type) {
+  return type->kind == TY_FLOAT;
+}
+
+/** The scalar SSE instruction op on a float or a double, such as addsd */
+static const char *float_operator(const char *op, int size) {
+  return fmtstr("%s%s", op, size == 8 ? "sd" : "ss");
+}
+
+/** The instruction moving a value of type between a register and memory */
+static const char *move_op(const Type *type) {
+  return is_float(type) ? float_operator("mov", type->size) : operator("mov", type->size);
+}
+
+static const char *register_name(const Type *type, int reg) {
+  return is_float(type) ? float_scratch_registers[reg] : scratch_registers[type->size][reg];
+}
+
+/** Where a value of type is returned, and left by a call */
+static const char *return_register(const Type *type) {
+  return is_float(type) ? "%xmm0" : accum_register(type->size);
+}
+
 static const char *addr(x86_64_Visitor *v, x86_64_Value *val);
+static x86_64_Value *evaluate(x86_64_Visitor *v, x86_64_Value *val, const Type *type);
+static void release(x86_64_Visitor *v, x86_64_Value *val);
 
 // THIS ONLY SUPPORTS 32 BIT INDICES
 static const char *indexed_addr(x86_64_Visitor *v, x86_64_Value *val) {
@@ -139,13 +202,18 @@ static const char *indexed_addr(x86_64_Visitor *v, x86_64_Value *val) {
   // If we have a const index, convert it to bytes if we use the scale format. Otherwise, copy the index value to %rax
   // so we can address it via (%base,%rcx).
   int const_offset = -1;
+  int scale = val->index.scale;
   if (IS_CONST_INDEX(val->index)) {
-    int scale = IS_SCALED_INDEX(val->index) ? val->index.scale : 1;
-    const_offset = val->index.index_const * scale;
-    val->index.scale = 0;
+    const_offset = val->index.index_const * (IS_SCALED_INDEX(val->index) ? scale : 1);
+    scale = 0;
   } else {
-    assert(val->type->kind == TY_INTEGER && val->type->size == 4);
-    fprintf(v->out, "\tmovslq\t%s, %%rcx\n", addr(v, val->index.index_expr));
+    x86_64_Value *index = val->index.index_expr;
+    assert(index->type->kind == TY_INTEGER && index->type->size == 4);
+    if (index->location_kind == LOC_EXPR) {
+      index = evaluate(v, index, index->type);
+      release(v, index);
+    }
+    fprintf(v->out, "\tmovslq\t%s, %%rcx\n", addr(v, index));
   }
 
   // If base is on the stack, then we use -offset(%base. Otherwise, we put it in %r10. If we have a const index (now
@@ -160,11 +228,11 @@ static const char *indexed_addr(x86_64_Visitor *v, x86_64_Value *val) {
       }
       break;
     case LOC_GLOBAL:
-      fprintf(v->out, "\tmovq\t%s, %%r10\n", base_val->global_name);
+      fprintf(v->out, "\tleaq\t%s, %%r10\n", base_val->global_name);
       if (const_offset >= 0) {
         prefix = fmtstr("%d(%%r10", const_offset);
       } else {
-        prefix = "(%%r10,%%rcx";
+        prefix = "(%r10,%rcx";
       }
       break;
     default:
@@ -174,8 +242,8 @@ static const char *indexed_addr(x86_64_Visitor *v, x86_64_Value *val) {
 
   // Finally, scale the address. The interpretation of index (whether it represents bytes or elements) depends on
   // whether the index value is "scaled."
-  if (IS_SCALED_INDEX(val->index)) {
-    suffix = fmtstr(",%d)", val->index.scale);
+  if (scale > 0) {
+    suffix = fmtstr(",%d)", scale);
   } else {
     suffix = ")";
   }
@@ -183,9 +251,35 @@ static const char *indexed_addr(x86_64_Visitor *v, x86_64_Value *val) {
   return fmtstr("%s%s", prefix, suffix);
 }
 
+/**
+ * The address of the floating immediate val in the literal pool of the function, which gets an entry for it unless it
+ * has one for the same bits. x86 has no floating immediates.
+ */
+static const char *literal_address(x86_64_Visitor *v, const x86_64_Value *val) {
+  FloatLiteral literal = { .size = val->type->size };
+  if (literal.size == 4) {
+    float narrow = (float) val->float_immediate;
+    uint32_t bits;
+    memcpy(&bits, &narrow, sizeof(bits));
+    literal.bits = bits;
+  } else {
+    memcpy(&literal.bits, &val->float_immediate, sizeof(literal.bits));
+  }
+  int i = 0;
+  while (i < v->literals_size && (v->literals[i].bits != literal.bits || v->literals[i].size != literal.size)) {
+    i++;
+  }
+  if (i == v->literals_size) {
+    APPEND_VECTOR(v->literals, literal);
+  }
+  return fmtstr("LCPI_%s_%d(%%rip)", v->curr_func_name, i);
+}
+
 static const char *addr(x86_64_Visitor *v, x86_64_Value *val) {
   switch (val->location_kind) {
     case LOC_IMMEDIATE:
+      if (is_float(val->type))
+        return literal_address(v, val);
       return fmtstr("$%lld", val->integer_immediate);
     case LOC_STACK:
       return fmtstr("%d(%%rbp)", val->rbp_offset);
@@ -193,6 +287,8 @@ static const char *addr(x86_64_Visitor *v, x86_64_Value *val) {
       return val->global_name;
     case LOC_INDEXED:
       return indexed_addr(v, val);
+    case LOC_REGISTER:
+      return register_name(val->type, val->reg);
     default:
       THROWF(EXC_INTERNAL, "Unsupported location %d", val->location_kind);
   }
@@ -201,36 +297,44 @@ static const char *addr(x86_64_Visitor *v, x86_64_Value *val) {
 static char *BINARY_TEMPLATE = "\t%s\t%s, %s\t\t# %s = %s\n";
 
 /**
- * Allocate a temporary variable holding a value of type on the stack. The contents are still UNDEFINED and must be
- * filled in subsequent instructions.
+ * Allocate a variable holding a value of type on the stack. The contents are still UNDEFINED and must be filled in
+ * subsequent instructions.
  *
- * This function does NOT modify rsp; that will be done right before the subroutine call (if any). Further, the stack
- * is not required to be aligned.
+ * This function does NOT modify rsp: visit_function_end sizes the frame once, in the prologue, rounding it up so that
+ * rsp stays 16-byte aligned at every call.
  */
-
 static x86_64_Value *new_variable(x86_64_Visitor *v, const Type *type, const char *debug_name) {
   int size = total_size(type);
-  // TODO: deal with alignment
-  v->curr_rbp_offset -= size;
+  v->frame_size = ROUND_UP(v->frame_size + size, align(type));
   v->curr_temp_id++;
 
   x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
   ret->location_kind = LOC_STACK;
-  ret->rbp_offset = v->curr_rbp_offset;
+  ret->rbp_offset = -v->frame_size;
   ret->type = type;
   ret->debug_name = debug_name ? debug_name : fmtstr("t%d", v->curr_temp_id);
 
-  fprintf(
-    v->out,
-    "\tsubq\t$%d, %%rsp\t\t# alloc %s (%d bytes) at %d(%%rbp) \n",
-    size,
-    ret->debug_name,
-    size,
-    ret->rbp_offset
-  );
+  fprintf(v->out, "# alloc %s (%d bytes) at %d(%%rbp)\n", ret->debug_name, size, ret->rbp_offset);
   return ret;
 }
 
+/** A stack slot for an intermediate result, taken from a temporary of the same size no longer in use if possible. */
+static x86_64_Value *new_temporary(x86_64_Visitor *v, const Type *type) {
+  for (int i = 0; i < v->free_temporaries_size; i++) {
+    x86_64_Value *slot = v->free_temporaries[i];
+    if (total_size(slot->type) == total_size(type) && align(slot->type) >= align(type)) {
+      v->free_temporaries[i] = VECTOR_LAST(v->free_temporaries);
+      POP_VECTOR_VOID(v->free_temporaries);
+      return slot;
+    }
+  }
+  return new_variable(v, type, NULL);
+}
+
+static void free_temporary(x86_64_Visitor *v, x86_64_Value *slot) {
+  APPEND_VECTOR(v->free_temporaries, slot);
+}
+
 /*
 const Type *indexed_base_type(x86_64_Value *val) {
   assert(val->location_kind == LOC_INDEXED);
@@ -250,41 +354,362 @@ static int scalar_size(x86_64_Value *val) {
 }
 */
 
-static void copy_from_accum(x86_64_Visitor *v, x86_64_Value *val) {
-  assert(IS_SCALAR_TYPE(val->type));
-  // update
-  v->accum_contents = val;
-  val->in_accum = 1;
+static const char *BINOP_MNEMONICS[] = {
+  [TOK_ADD_OP] = "add",
+  [TOK_SUB_OP] = "sub",
+  [TOK_STAR_OP] = "imul",
+  [TOK_DIV_OP] = "idiv",
+  [TOK_LT_OP] = "cmp",
+  [TOK_RT_OP] = "cmp",
+  [TOK_LE_OP] = "cmp",
+  [TOK_GE_OP] = "cmp",
+  [TOK_EQ_OP] = "cmp",
+  [TOK_NE_OP] = "cmp",
+};
 
-  int size = val->type->size;
-  fprintf(
-    v->out,
-    BINARY_TEMPLATE,
-    operator("mov", size), accum_register(size), addr(v, val),
-    fmtstr("%s <%s>", val->debug_name, addr(v, val)),
-    accum_register(size)
+static const char *BINOP_SYMBOLS[] = {
+  [TOK_ADD_OP] = "+",
+  [TOK_SUB_OP] = "-",
+  [TOK_STAR_OP] = "*",
+  [TOK_DIV_OP] = "/",
+  [TOK_LT_OP] = "<",
+  [TOK_RT_OP] = ">",
+  [TOK_LE_OP] = "<=",
+  [TOK_GE_OP] = ">=",
+  [TOK_EQ_OP] = "==",
+  [TOK_NE_OP] = "!=",
+};
+
+// For floating operands; see evaluate
+static const char *FLOAT_MNEMONICS[] = {
+  [TOK_ADD_OP] = "add",
+  [TOK_SUB_OP] = "sub",
+  [TOK_STAR_OP] = "mul",
+  [TOK_DIV_OP] = "div",
+  [TOK_RT_OP] = "ucomi",
+  [TOK_GE_OP] = "ucomi",
+  [TOK_EQ_OP] = "ucomi",
+  [TOK_NE_OP] = "ucomi",
+};
+
+static int is_comparison(TokenKind op) {
+  return op == TOK_LT_OP || op == TOK_RT_OP || op == TOK_LE_OP || op == TOK_GE_OP || op == TOK_EQ_OP
+    || op == TOK_NE_OP;
+}
+
+/** The comparison that holds exactly when op does not */
+static TokenKind negate_comparison(TokenKind op) {
+  switch (op) {
+    case TOK_LT_OP: return TOK_GE_OP;
+    case TOK_RT_OP: return TOK_LE_OP;
+    case TOK_LE_OP: return TOK_RT_OP;
+    case TOK_GE_OP: return TOK_LT_OP;
+    case TOK_EQ_OP: return TOK_NE_OP;
+    case TOK_NE_OP: return TOK_EQ_OP;
+    default: THROWF(EXC_INTERNAL, "%s is not a comparison", TOKEN_NAMES[op]);
+  }
+}
+
+/** The condition code of setcc and jcc under which op holds, after a cmp of its operands */
+static const char *condition_code(TokenKind op, int is_unsigned) {
+  switch (op) {
+    case TOK_LT_OP: return is_unsigned ? "b" : "l";
+    case TOK_RT_OP: return is_unsigned ? "a" : "g";
+    case TOK_LE_OP: return is_unsigned ? "be" : "le";
+    case TOK_GE_OP: return is_unsigned ? "ae" : "ge";
+    case TOK_EQ_OP: return "e";
+    case TOK_NE_OP: return "ne";
+    default: THROWF(EXC_INTERNAL, "%s is not a comparison", TOKEN_NAMES[op]);
+  }
+}
+
+/** The type a comparison compares its operands as: the left one's, unless that is a literal. */
+static const Type *comparison_type(const x86_64_Value *val) {
+  const x86_64_Value *left = val->expr.left;
+  return left->location_kind == LOC_IMMEDIATE ? val->expr.right->type : left->type;
+}
+
+/** The mask of free scratch registers that can hold a value of type */
+static uint32_t *free_mask(x86_64_Visitor *v, const Type *type) {
+  return is_float(type) ? &v->free_float_scratch : &v->free_scratch;
+}
+
+static x86_64_Value *take_scratch(x86_64_Visitor *v, const Type *type) {
+  THROW_IF(is_float(type) && type->size > 8, EXC_INTERNAL, "long double is not supported yet");
+  uint32_t *mask = free_mask(v, type);
+  THROW_IF(!*mask, EXC_INTERNAL, "out of scratch registers");
+  x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+  ret->location_kind = LOC_REGISTER;
+  ret->type = type;
+  ret->reg = __builtin_ctz(*mask);
+  ret->debug_name = register_name(type, ret->reg);
+  *mask &= ~(1u << ret->reg);
+  return ret;
+}
+
+/** Give back the scratch register of val, if any, once its value has been used. */
+static void release(x86_64_Visitor *v, x86_64_Value *val) {
+  if (val->location_kind == LOC_REGISTER) {
+    *free_mask(v, val->type) |= 1u << val->reg;
+  }
+}
+
+/** The division of a value of type by right, if right is a constant */
+static ConstantDivision constant_division(const x86_64_Value *right, const Type *type) {
+  return (ConstantDivision) {
+    .divisor = right->location_kind == LOC_IMMEDIATE ? right->integer_immediate : 0,
+    .size = type->size,
+    .is_signed = !type->is_unsigned,
+    .is_quotient = 1,
+  };
+}
+
+/**
+ * Registers needed to evaluate val as the left (destination) or right (source) operand of op on values of type. A leaf
+ * on the right is used in place, except for an immediate divisor left to idiv, which takes none; an indexed leaf needs
+ * registers for its index.
+ */
+static int operand_need(const x86_64_Value *val, int is_left, TokenKind op, const Type *type) {
+  if (val->location_kind == LOC_EXPR)
+    return val->expr.need;
+  int need = is_left || (op == TOK_DIV_OP && val->location_kind == LOC_IMMEDIATE && !is_float(type)
+                         && !divides_without_div(constant_division(val, type)));
+  if (val->location_kind == LOC_INDEXED && !IS_CONST_INDEX(val->index)) {
+    int index_need = operand_need(val->index.index_expr, 0, TOK_ADD_OP, val->index.index_expr->type);
+    need = MAX(need, index_need);
+  }
+  return need;
+}
+
+static x86_64_Value *spill(x86_64_Visitor *v, x86_64_Value *val) {
+  x86_64_Value *ret = new_temporary(v, val->type);
+  fprintf(v->out, BINARY_TEMPLATE, move_op(val->type), addr(v, val), addr(v, ret), ret->debug_name, val->debug_name);
+  release(v, val);
+  return ret;
+}
+
+/**
+ * Emit code converting the operand of a conversion to the type of val, and return the scratch register holding the
+ * result. cvtsi2sd only takes signed 32 and 64-bit integers, so other integers are extended to 64 bits first.
+ */
+static x86_64_Value *evaluate_conversion(x86_64_Visitor *v, x86_64_Value *val) {
+  const Type *from = val->expr.left->type, *to = val->type;
+  x86_64_Value *src = val->expr.left;
+  if (src->location_kind == LOC_EXPR) {
+    src = evaluate(v, src, from);
+  }
+  x86_64_Value *ret;
+  if (!is_float(from) && !is_float(to)) {
+    // Narrowing keeps the low bytes, which are where they were; widening extends by the signedness of the operand.
+    if (to->size < from->size && src->location_kind == LOC_REGISTER) {
+      src->type = to;
+      return src;
+    }
+    const char *operand = addr(v, src);
+    release(v, src);
+    ret = take_scratch(v, to);
+    if (to->size < from->size) {
+      fprintf(v->out, "\t%s\t%s, %s\t\t# %s\n", operator("mov", to->size), operand, addr(v, ret), val->debug_name);
+    } else if (from->size == 4 && from->is_unsigned) {
+      // writing the 32-bit register clears the upper half
+      fprintf(v->out, "\tmovl\t%s, %s\t\t# %s\n", operand, scratch_registers[4][ret->reg], val->debug_name);
+    } else {
+      fprintf(v->out, "\tmov%c%c%c\t%s, %s\t\t# %s\n", from->is_unsigned ? 'z' : 's', suffixes[from->size],
+        suffixes[to->size], operand, addr(v, ret), val->debug_name);
+    }
+    return ret;
+  }
+  if (!is_float(from)) {
+    THROW_IF(from->size == 8 && from->is_unsigned, EXC_INTERNAL,
+      "conversion of unsigned long to floating point is not supported yet");
+    const char *operand = addr(v, src);
+    int operand_size = from->size;
+    if (from->size < 4 || from->is_unsigned) {
+      x86_64_Value *wide = src->location_kind == LOC_REGISTER ? src : take_scratch(v, &v->_visitor.long_type);
+      if (from->size == 4) {
+        // writing the 32-bit register clears the upper half
+        fprintf(v->out, "\tmovl\t%s, %s\n", operand, scratch_registers[4][wide->reg]);
+      } else {
+        fprintf(v->out, "\tmov%c%cq\t%s, %s\n", from->is_unsigned ? 'z' : 's', suffixes[from->size], operand,
+          scratch_registers[8][wide->reg]);
+      }
+      operand = scratch_registers[8][wide->reg];
+      operand_size = 8;
+      if (wide != src) {
+        release(v, src);
+        src = wide;
+      }
+    }
+    ret = take_scratch(v, to);
+    fprintf(v->out, "\tcvtsi2%s%c\t%s, %s\t\t# %s\n", to->size == 8 ? "sd" : "ss", suffixes[operand_size], operand,
+      addr(v, ret), val->debug_name);
+  } else if (!is_float(to)) {
+    // Truncated toward zero, as 6.3.1.4 says; narrower results are the low bytes, and unsigned ints need 64 bits.
+    ret = take_scratch(v, to);
+    int size = to->size == 8 || (to->size == 4 && to->is_unsigned) ? 8 : 4;
+    fprintf(v->out, "\tcvtt%s2si\t%s, %s\t\t# %s\n", from->size == 8 ? "sd" : "ss", addr(v, src),
+      scratch_registers[size][ret->reg], val->debug_name);
+  } else {
+    ret = take_scratch(v, to);
+    fprintf(v->out, "\tcvt%s\t%s, %s\t\t# %s\n", from->size == 8 ? "sd2ss" : "ss2sd", addr(v, src), addr(v, ret),
+      val->debug_name);
+  }
+  release(v, src);
+  return ret;
+}
+
+/**
+ * Emit code computing val into a scratch register, as a value of type, and return that register. The operand of an
+ * expression needing more registers goes first, so the other is computed while a single register holds its result;
+ * only when the scratch registers run out does the first result go to the stack (Sethi and Ullman, "The Generation of
+ * Optimal Code for Arithmetic Expressions", JACM 1970).
+ */
+static x86_64_Value *evaluate(x86_64_Visitor *v, x86_64_Value *val, const Type *type) {
+  int size = type->size;
+  if (val->location_kind != LOC_EXPR) {
+    const char *src = addr(v, val);
+    x86_64_Value *ret = take_scratch(v, type);
+    fprintf(v->out, BINARY_TEMPLATE, move_op(type), src, addr(v, ret), ret->debug_name, val->debug_name);
+    return ret;
+  }
+  if (!val->expr.right)
+    return evaluate_conversion(v, val);
+
+  TokenKind op = val->expr.op;
+  const Type *result_type = type;
+  if (is_comparison(op)) {
+    // The operands are evaluated as they are; only the result is an int.
+    type = comparison_type(val);
+    size = type->size;
+  }
+  x86_64_Value *left = val->expr.left, *right = val->expr.right;
+  int is_float_op = is_float(type);
+  ConstantDivision division = constant_division(right, type);
+  int reduce_division = op == TOK_DIV_OP && right->location_kind == LOC_IMMEDIATE && !is_float_op
+    && divides_without_div(division);
+  MulPlan plan;
+  int reduce_multiplication = op == TOK_STAR_OP && right->location_kind == LOC_IMMEDIATE && !is_float_op
+    && plan_multiplication(right->integer_immediate, &plan);
+  // A plain dividend is loaded straight into the accumulator, unless the division is done by multiplication.
+  int load_left = op != TOK_DIV_OP || is_float_op || reduce_division || left->location_kind == LOC_EXPR
+    || left->location_kind == LOC_INDEXED;
+  int left_need = load_left ? operand_need(left, 1, op, type) : 0;
+  int right_need = operand_need(right, 0, op, type);
+  int n_free = __builtin_popcount(*free_mask(v, type));
+  x86_64_Value *spilled_right = 0;
+  if (right_need > left_need) {
+    right = evaluate(v, right, type);
+    if (n_free - 1 < left_need) {
+      right = spilled_right = spill(v, right);
+    }
+    if (load_left) {
+      left = evaluate(v, left, type);
+    }
+  } else {
+    if (load_left) {
+      left = evaluate(v, left, type);
+    }
+    if (right_need > 0) {
+      x86_64_Value *spilled = load_left && n_free - 1 < right_need ? spill(v, left) : 0;
+      right = evaluate(v, right, type);
+      if (spilled) {
+        left = evaluate(v, spilled, type);
+        free_temporary(v, spilled);
+      }
+    }
+  }
+
+  // Name evaluated operands by where they are now, so the comments stay short.
+  const char *src = addr(v, right);
+  const char *comment = fmtstr(
+    "%s %s %s",
+    (val->expr.left->location_kind == LOC_EXPR ? left : val->expr.left)->debug_name,
+    BINOP_SYMBOLS[op],
+    (val->expr.right->location_kind == LOC_EXPR ? right : val->expr.right)->debug_name
   );
+  x86_64_Value *ret;
+  if (reduce_multiplication || reduce_division) {
+    // The reduced sequences work on whole 32 or 64-bit registers; narrower results are their low bytes.
+    ret = left;
+    int wide_size = MAX(size, 4);
+    const char *reg = scratch_registers[wide_size][ret->reg], *reg64 = scratch_registers[8][ret->reg];
+    fprintf(v->out, "\t# %s = %s\n", ret->debug_name, comment);
+    if (reduce_multiplication) {
+      fprint_multiplication(v->out, &plan, wide_size, reg, reg64);
+    } else {
+      fprint_division(v->out, division, reg, reg64, reg);
+    }
+  } else if (is_float_op) {
+    // ucomis compares like cmp, but sets the carry and zero flags as an unsigned comparison would, and all of them
+    // along with parity if either operand is NaN. visit_binop has turned < and <= around, so the conditions used
+    // are false then, except for !=.
+    ret = left;
+    fprintf(v->out, BINARY_TEMPLATE, float_operator(FLOAT_MNEMONICS[op], size), src, addr(v, ret), ret->debug_name,
+      comment);
+    release(v, right);
+    if (is_comparison(op) && val != v->flags_contents) {
+      release(v, ret);
+      ret = take_scratch(v, result_type);
+      const char *byte_reg = scratch_registers[1][ret->reg];
+      fprintf(v->out, "\tset%s\t%s\n", condition_code(op, 1), byte_reg);
+      if (op == TOK_EQ_OP || op == TOK_NE_OP) {
+        fprintf(v->out, "\tset%s\t%%al\n", op == TOK_EQ_OP ? "np" : "p");
+        fprintf(v->out, "\t%s\t%%al, %s\n", op == TOK_EQ_OP ? "andb" : "orb", byte_reg);
+      }
+      fprintf(v->out, "\tmovzbl\t%s, %s\n", byte_reg, scratch_registers[4][ret->reg]);
+    }
+  } else if (op == TOK_DIV_OP) {
+    const char *accum_reg = accum_register(size);
+    fprintf(v->out, BINARY_TEMPLATE, operator("mov", size), addr(v, left), accum_reg, accum_reg, left->debug_name);
+    char *ct;
+    switch (size) {
+      case 1: ct = "cbw"; break;
+      case 2: ct = "cwd"; break;
+      case 4: ct = "cdq"; break;
+      case 8: ct = "cqo"; break;
+      default: THROWF(EXC_INTERNAL, "wrong size for division: %d", size);
+    }
+    const char *mnemonic = "idiv";
+    if (type->is_unsigned) {
+      // The dividend is zero-extended instead.
+      ct = size == 1 ? "movzbw\t%al, %ax" : "xorl\t%edx, %edx";
+      mnemonic = "div";
+    }
+    fprintf(v->out, "\t%s\n", ct);
+    fprintf(v->out, "\t%s\t%s\t\t# %s = %s\n", operator(mnemonic, size), src, accum_reg, comment);
+    release(v, right);
+    ret = load_left ? left : take_scratch(v, type);
+    fprintf(v->out, "\t%s\t%s, %s\n", operator("mov", size), accum_reg, addr(v, ret));
+  } else {
+    ret = left;
+    fprintf(v->out, BINARY_TEMPLATE, operator(BINOP_MNEMONICS[op], size), src, addr(v, ret), ret->debug_name, comment);
+    release(v, right);
+    if (is_comparison(op) && val != v->flags_contents) {
+      const char *byte_reg = scratch_registers[1][ret->reg];
+      fprintf(v->out, "\tset%s\t%s\n", condition_code(op, type->is_unsigned), byte_reg);
+      fprintf(v->out, "\tmovzbl\t%s, %s\n", byte_reg, scratch_registers[4][ret->reg]);
+      ret->type = result_type;
+    }
+  }
+  if (spilled_right) {
+    free_temporary(v, spilled_right);
+  }
+  return ret;
 }
 
+/** Move val to the accumulator, or to xmm0 if it is floating: where functions return it. */
 static void copy_to_accum(x86_64_Visitor *v, x86_64_Value *val) {
   assert(IS_SCALAR_TYPE(val->type));
-  if (v->accum_contents == val)  // no-op
-    return;
-
-  // evict the previous contents
-  if (v->accum_contents) {
-    v->accum_contents->in_accum = 0;
+  if (val->location_kind == LOC_EXPR) {
+    val = evaluate(v, val, val->type);
+    release(v, val);
   }
 
-  v->accum_contents = val;
-  val->in_accum = 1;
-
-  int size = val->type->size;
   fprintf(
     v->out,
     BINARY_TEMPLATE,
-    operator("mov", size), addr(v, val), accum_register(size),
-    accum_register(size),
+    move_op(val->type), addr(v, val), return_register(val->type),
+    return_register(val->type),
     val->debug_name
   );
 }
@@ -307,8 +732,8 @@ static x86_64_Value *visit_integer_literal(x86_64_Visitor *v, int64_t int64_val)
   x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
   ret->location_kind = LOC_IMMEDIATE;
   ret->integer_immediate = int64_val;
-  ret->debug_name = addr(v, ret);
   ret->type = &INTEGER_LITERAL_TYPE;
+  ret->debug_name = addr(v, ret);
   return ret;
 }
 
@@ -323,11 +748,26 @@ static x86_64_Value *visit_int64_literal(x86_64_Visitor *v, int64_t int64_val) {
 }
 */
 
-static x86_64_Value *visit_float_literal(x86_64_Visitor *v, int64_t int64_val) {
-  assert(0 && "Unimplemented!");
+/** A double immediate, which goes in the literal pool once an instruction uses it */
+static x86_64_Value *visit_float_literal(x86_64_Visitor *v, double double_val) {
+  x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+  ret->location_kind = LOC_IMMEDIATE;
+  ret->float_immediate = double_val;
+  ret->debug_name = fmtstr("%g", double_val);
+  ret->type = &v->_visitor.double_type;
+  return ret;
 }
 
-static x86_64_Value *convert_type(x86_64_Value *value, const Type *new_type) {
+/** The name of an arithmetic type, for comments */
+static const char *arithmetic_type_name(const Type *type) {
+  static const char *const integer_names[] = {[1] = "char", [2] = "short", [4] = "int", [8] = "long"};
+  if (is_float(type))
+    return type->size == 8 ? "double" : "float";
+  return integer_names[type->size];
+}
+
+/** Immediates are converted here; other conversions that change the representation are deferred like operations. */
+static x86_64_Value *convert_type(x86_64_Visitor *v, x86_64_Value *value, const Type *new_type) {
   // assert((compare_type(value->type, new_type) != 0) && "Unnecessary convert_type call");
   // handle all the cases later
   x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
@@ -336,84 +776,98 @@ static x86_64_Value *convert_type(x86_64_Value *value, const Type *new_type) {
     // Copy everything
     // TODO: Handle other cases later...
     *ret = *value;
-    if (value->type->kind == TY_INTEGER && new_type->kind == TY_FLOAT) {
-      value->float_immediate = (double) value->integer_immediate;
+    ret->type = new_type;
+    if (!is_float(value->type) && is_float(new_type)) {
+      ret->float_immediate = value->type->is_unsigned ? (double) (uint64_t) value->integer_immediate
+        : (double) value->integer_immediate;
+    } else if (is_float(value->type) && !is_float(new_type)) {
+      ret->integer_immediate = (int64_t) value->float_immediate;
+    }
+    if (is_float(new_type)) {
+      if (new_type->size == 4) {
+        ret->float_immediate = (float) ret->float_immediate;
+      }
+      ret->debug_name = fmtstr("%g", ret->float_immediate);
     }
+  } else if (is_float(value->type) || is_float(new_type) || value->type->size != new_type->size) {
+    ret->location_kind = LOC_EXPR;
+    ret->type = new_type;
+    ret->expr.left = value;
+    ret->expr.need = MAX(1, operand_need(value, 1, TOK_ADD_OP, value->type));
+    ret->debug_name = fmtstr("(%s) %s", arithmetic_type_name(new_type), value->debug_name);
+  } else {
+    // Only the signedness changes, which is in the operations on the bits rather than the bits.
+    *ret = *value;
+    ret->type = new_type;
   }
   return ret;
 }
 
+static void *visit_binop(x86_64_Visitor *v, TokenKind op, x86_64_Value *left, x86_64_Value *right);
+
+/** Labels are local to the function; Mach-O assembler local symbols start with L. */
+static const char *new_label(x86_64_Visitor *v) {
+  return fmtstr("L%s_%d", v->curr_func_name, v->curr_label_id++);
+}
+
+/** Copy the aggregate right to left, both in the frame, by moves or a string instruction as block_strategy says. */
+static void emit_aggregate_copy(x86_64_Visitor *v, x86_64_Value *left, x86_64_Value *right) {
+  THROW_IF(left->location_kind != LOC_STACK || right->location_kind != LOC_STACK, EXC_INTERNAL,
+    "aggregates outside the frame are not supported yet");
+  int size = total_size(left->type);
+  if (block_strategy(size) == BLOCK_INLINE) {
+    MemRef dst = { .base = "%rbp", .disp = left->rbp_offset }, src = { .base = "%rbp", .disp = right->rbp_offset };
+    fprint_inline_copy(v->out, dst, src, size, 0);
+    return;
+  }
+  THROW_IF(v->free_scratch != ALL_SCRATCH, EXC_INTERNAL, "aggregate copies within expressions are not supported yet");
+  fprintf(v->out, "\tleaq\t%d(%%rbp), %%rdi\n\tleaq\t%d(%%rbp), %%rsi\n", left->rbp_offset, right->rbp_offset);
+  fprint_block_copy(v->out, size, new_label(v));
+}
+
 static void *visit_assign(x86_64_Visitor *v, TokenKind op, x86_64_Value *left, x86_64_Value *right) {
-  assert(IS_SCALAR_TYPE(left->type) && IS_SCALAR_TYPE(right->type) && left->type->size == right->type->size);
-  int size = left->type->size;
-  if (right->location_kind == LOC_IMMEDIATE) {
-    fprintf(v->out,
-      BINARY_TEMPLATE,
-      operator("mov", size), addr(v, right), addr(v, left),
-      left->debug_name, right->debug_name
-    );
-  } else {
-    fprintf(v->out, "\t%s\t%s, %s\n", operator("mov", size), addr(v, right), param_registers[size][0]);
-    fprintf(v->out, "\t%s\t%s, %s", operator("mov", size), param_registers[size][0], addr(v, left));
-    fprintf(v->out, "\t\t# %s = %s\n", left->debug_name, right->debug_name);
+  if (op == TOK_ASSIGN_OP && !IS_SCALAR_TYPE(left->type)) {
+    THROW_IF(total_size(left->type) != total_size(right->type), EXC_PARSE_SYNTAX,
+      "assignment of incompatible aggregates");
+    emit_aggregate_copy(v, left, right);
+    return left;
+  }
+  if (op != TOK_ASSIGN_OP) {
+    right = visit_binop(v, assignment_binop(op), left, right);
+  }
+  if ((is_float(left->type) || is_float(right->type)) && changes_representation(right->type, left->type)) {
+    right = convert_type(v, right, left->type);
   }
+  assert(IS_SCALAR_TYPE(left->type) && IS_SCALAR_TYPE(right->type) && left->type->size == right->type->size);
+  // Floating immediates are in memory, and x86 has no memory to memory move.
+  int is_store_immediate = right->location_kind == LOC_IMMEDIATE && !is_float(left->type);
+  x86_64_Value *src = is_store_immediate ? right : evaluate(v, right, left->type);
+  fprintf(v->out,
+    BINARY_TEMPLATE,
+    move_op(left->type), addr(v, src), addr(v, left),
+    left->debug_name, src->debug_name
+  );
+  release(v, src);
   return left;
 }
 
+/** Defer the operation, to be evaluated into scratch registers once the whole expression is known. */
 static void *visit_binop(x86_64_Visitor *v, TokenKind op, x86_64_Value *left, x86_64_Value *right) {
   if (!left || !right) {
     raise(SIGTRAP);
   }
   assert(IS_SCALAR_TYPE(left->type) && IS_SCALAR_TYPE(right->type));
-  const Type *type = left->type;
-  int size = type->size;
-  const char *accum_reg = accum_register(size);
   switch (op) {
     case TOK_ADD_OP:
-      copy_to_accum(v, left);
-      fprintf(
-        v->out,
-        BINARY_TEMPLATE,
-        operator("add", size), addr(v, right), accum_reg,
-        accum_reg, fmtstr("%s + %s", left->debug_name, right->debug_name)
-      );
-      break;
     case TOK_SUB_OP:
-      copy_to_accum(v, left);
-      fprintf(
-        v->out,
-        BINARY_TEMPLATE,
-        operator("sub", size), addr(v, right), accum_reg,
-        accum_reg, fmtstr("%s - %s", left->debug_name, right->debug_name)
-      );
-      break;
     case TOK_STAR_OP:
-      copy_to_accum(v, left);
-      fprintf(
-        v->out,
-        BINARY_TEMPLATE,
-        operator("imul", size), addr(v, right), accum_reg,
-        accum_reg, fmtstr("%s * %s", left->debug_name, right->debug_name)
-      );
-      break;
     case TOK_DIV_OP:
-      copy_to_accum(v, left);
-      char *ct;
-      switch (size) {
-        case 1: ct = "cbw"; break;
-        case 2: ct = "cwd"; break;
-        case 4: ct = "cdq"; break;
-        case 8: ct = "cqo"; break;
-        default: THROWF(EXC_INTERNAL, "wrong size for division: %d", size);
-      }
-      fprintf(v->out, "\t%s\n", ct);
-      fprintf(
-        v->out,
-        "\t%s\t%s\t\t# %s = %s\n",
-        operator("idiv", size), addr(v, right),
-        accum_reg,
-        fmtstr("%s / %s", left->debug_name, right->debug_name)
-      );
+    case TOK_LT_OP:
+    case TOK_RT_OP:
+    case TOK_LE_OP:
+    case TOK_GE_OP:
+    case TOK_EQ_OP:
+    case TOK_NE_OP:
       break;
     case TOK_COMMA:
       // special case; just return right
@@ -421,28 +875,71 @@ static void *visit_binop(x86_64_Visitor *v, TokenKind op, x86_64_Value *left, x8
     default:
       THROWF(EXC_INTERNAL, "Binop %s not supported", TOKEN_NAMES[op]);
   }
-  x86_64_Value *result = new_variable(v, type, NULL);
-  copy_from_accum(v, result);
-  return result;
-}
-
-x86_64_Value *visit_conditional(x86_64_Visitor *v, TokenKind op, int jump, void *left, void *right) {
-  assert(0 && "Unimplemented!");
+  // A comparison is 0 or 1 already, as when a condition is turned into a value.
+  if (op == TOK_NE_OP && left->location_kind == LOC_EXPR && is_comparison(left->expr.op)
+    && right->location_kind == LOC_IMMEDIATE && !is_float(right->type) && !right->integer_immediate)
+    return left;
+  if (is_float(left->type) || is_float(right->type)) {
+    // 6.3.1.8: both operands become the wider floating type.
+    const Type *type = common_arithmetic_type((Visitor *) v, left->type, right->type);
+    if (changes_representation(left->type, type)) {
+      left = convert_type(v, left, type);
+    }
+    if (changes_representation(right->type, type)) {
+      right = convert_type(v, right, type);
+    }
+    if (op == TOK_LT_OP || op == TOK_LE_OP) {
+      // a < b is tested as b > a, whose condition is false for the unordered result of a NaN; see evaluate.
+      x86_64_Value *tmp = left;
+      left = right;
+      right = tmp;
+      op = op == TOK_LT_OP ? TOK_RT_OP : TOK_GE_OP;
+    }
+  }
+  x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+  ret->location_kind = LOC_EXPR;
+  ret->type = is_comparison(op) ? &v->_visitor.int_type : left->type;
+  ret->expr.op = op;
+  ret->expr.left = left;
+  ret->expr.right = right;
+  int left_need = operand_need(left, 1, op, left->type), right_need = operand_need(right, 0, op, left->type);
+  ret->expr.need = left_need == right_need ? left_need + 1 : MAX(left_need, right_need);
+  ret->debug_name = fmtstr("(%s %s %s)", left->debug_name, BINOP_SYMBOLS[op], right->debug_name);
+  return ret;
 }
 
 // http://6.s081.scripts.mit.edu/sp18/x86-64-architecture-guide.html
-static char *prologue = "\t.globl	_%s\n_%s:\n\tpushq\t%%rbp\n\tmovq\t%%rsp, %%rbp\n";
+// Functions start on a 16-byte boundary, padded with nops, like clang's. Static ones are not exported.
+static char *export = "\t.globl\t_%s\n";
+static char *prologue = "\t.p2align\t4, 0x90\n_%s:\n\tpushq\t%%rbp\n\tmovq\t%%rsp, %%rbp\n";
 static void visit_function_definition_start(
   x86_64_Visitor *v,
-  const char *ident
+  const char *ident,
+  const Type *type,
+  FunctionSpecifiers specifiers
 ) {
   v->flags_contents = 0;
-  v->accum_contents = 0;
-  v->curr_rbp_offset = 0;
+  v->free_scratch = ALL_SCRATCH;
+  v->free_float_scratch = ALL_FLOAT_SCRATCH;
+  v->frame_size = 0;
+  v->free_temporaries_size = 0;
+  for (int i = 0; i < v->zeroed_objects_size; i++) {
+    free(v->zeroed_objects[i].written);
+  }
+  v->zeroed_objects_size = 0;
+  v->literals_size = 0;
   v->curr_temp_id = 0;
+  v->curr_label_id = 0;
   v->curr_func_param = 0;
-  v->curr_func_return_type = 0;
-  fprintf(v->out, prologue, ident, ident);
+  v->curr_func_float_param = 0;
+  v->curr_func_stack_param = 0;
+  v->curr_func_return_type = type->return_type;
+  v->curr_func_name = ident;
+  v->curr_func_is_static = specifiers.is_static;
+  // Buffer each function separately, so the driver can cache its text, and so the prologue can be written once the
+  // frame size is known.
+  free(v->function_text);
+  v->out = checked_open_memstream(&v->function_text, &v->function_text_size);
 }
 
 static void *visit_declaration(
@@ -450,6 +947,24 @@ static void *visit_declaration(
   const Type *type,
   const char *ident_string
 ) {
+  if (type->kind == TY_FUNCTION) {
+    x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+    ret->location_kind = LOC_GLOBAL;
+    ret->type = type;
+    ret->global_name = fmtstr("_%s", ident_string);
+    ret->debug_name = ident_string;
+    return ret;
+  }
+  // Objects at file scope are common symbols, zeroed by the loader; Mach-O takes the alignment as a power of two.
+  if (v->out == v->file_out) {
+    fprintf(v->out, "\t.comm\t_%s,%d,%d\n", ident_string, total_size(type), __builtin_ctz(align(type)));
+    x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+    ret->location_kind = LOC_GLOBAL;
+    ret->type = type;
+    ret->global_name = fmtstr("_%s(%%rip)", ident_string);
+    ret->debug_name = ident_string;
+    return ret;
+  }
   x86_64_Value *ret = new_variable(v, type, ident_string);
   return ret;
 }
@@ -461,14 +976,18 @@ static void *visit_function_definition_param(
 ) {
   x86_64_Value *ret = visit_declaration(v, type, ident_string);
   int size = ret->type->size;
-  fprintf(
-    v->out,
-    "\t%s\t%s, %s\n",
-    operator("mov", size),
-    param_registers[size][v->curr_func_param],
-    addr(v, ret)
-  );
-  v->curr_func_param++;
+  // Integers and floating values are passed in registers of their own, each taken in order. Those left over are in
+  // 8-byte slots above the return address, in order; the parameters in registers before them are stored already.
+  const char *reg;
+  if (is_float(type) ? v->curr_func_float_param == 8 : v->curr_func_param == 6) {
+    reg = return_register(type);
+    fprintf(v->out, "\t%s\t%d(%%rbp), %s\n", move_op(type), 16 + 8 * v->curr_func_stack_param++, reg);
+  } else if (is_float(type)) {
+    reg = fmtstr("%%xmm%d", v->curr_func_float_param++);
+  } else {
+    reg = param_registers[size][v->curr_func_param++];
+  }
+  fprintf(v->out, "\t%s\t%s, %s\n", move_op(type), reg, addr(v, ret));
   return ret;
 }
 
@@ -574,21 +1093,227 @@ static x86_64_Value *visit_struct_reference(x86_64_Visitor *v, x86_64_Value *lef
   if (left->location_kind != LOC_INDEXED) {
     return visit_struct_reference_base(v, left, member);
   }
+  if (IS_CONST_INDEX(left->index) && !IS_SCALED_INDEX(left->index)) {
+    // A member of a member at a constant offset: the offsets add up.
+    x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+    *ret = *left;
+    ret->type = member->type;
+    ret->index.index_const += member->offset;
+    ret->debug_name = fmtstr("%s.%s", left->debug_name, member->ident);
+    return ret;
+  }
   assert(0 && "Unimplemented!");
 }
 
+/**
+ * Each argument that needs computing but the last goes to a temporary first, as computing a later one may need the
+ * registers of earlier ones; the last is computed into a scratch register and moved straight to where it is passed.
+ * Then all are loaded into the parameter registers: the integer ones, or xmm0-xmm7 for floating arguments, each in
+ * order. Those left over go in 8-byte slots at rsp, in order, below which rsp is lowered for the call if need be to
+ * keep it 16-byte aligned. The result is kept in a temporary, as rax and xmm0 are not scratch registers.
+ */
+static x86_64_Value *visit_call(x86_64_Visitor *v, x86_64_Value *function, int n_args, x86_64_Value **args) {
+  assert(function->location_kind == LOC_GLOBAL && v->free_scratch == ALL_SCRATCH);
+  assert(v->free_float_scratch == ALL_FLOAT_SCRATCH);
+  int last_computed = -1;
+  for (int i = 0; i < n_args; i++) {
+    if (args[i]->location_kind == LOC_EXPR || args[i]->location_kind == LOC_INDEXED) {
+      last_computed = i;
+    }
+  }
+  x86_64_Value **staged = checked_calloc(n_args + 1, sizeof(x86_64_Value *));
+  const char **dsts = checked_calloc(n_args + 1, sizeof(const char *));
+  int *on_stack = checked_calloc(n_args + 1, sizeof(int));
+  int n_int = 0, n_float = 0, n_stack = 0;
+  for (int i = 0; i < n_args; i++) {
+    const Type *type = args[i]->type;
+    staged[i] = args[i];
+    if (i == last_computed) {
+      staged[i] = evaluate(v, args[i], type);
+    } else if (args[i]->location_kind == LOC_EXPR || args[i]->location_kind == LOC_INDEXED) {
+      staged[i] = spill(v, evaluate(v, args[i], type));
+    }
+    on_stack[i] = is_float(type) ? n_float == 8 : n_int == 6;
+    if (on_stack[i]) {
+      dsts[i] = fmtstr("%d(%%rsp)", 8 * n_stack++);
+    } else {
+      dsts[i] = is_float(type) ? fmtstr("%%xmm%d", n_float++) : param_registers[type->size][n_int++];
+    }
+  }
+  int stack_size = ROUND_UP(8 * n_stack, 16);
+  if (stack_size) {
+    fprintf(v->out, "\tsubq\t$%d, %%rsp\n", stack_size);
+  }
+  // The computed argument first, as its scratch register may be another one's parameter register; then the stack
+  // arguments, through rax or xmm0, before those are loaded.
+  if (last_computed >= 0) {
+    const char *src = addr(v, staged[last_computed]);
+    if (strcmp(src, dsts[last_computed])) {
+      fprintf(v->out, "\t%s\t%s, %s\n", move_op(args[last_computed]->type), src, dsts[last_computed]);
+    }
+    release(v, staged[last_computed]);
+  }
+  for (int stack_pass = 1; stack_pass >= 0; stack_pass--) {
+    for (int i = 0; i < n_args; i++) {
+      const Type *type = staged[i]->type;
+      if (i == last_computed || on_stack[i] != stack_pass)
+        continue;
+      const char *src = addr(v, staged[i]);
+      if (stack_pass) {
+        fprintf(v->out, "\t%s\t%s, %s\n", move_op(type), src, return_register(type));
+        src = return_register(type);
+      }
+      fprintf(v->out, "\t%s\t%s, %s\n", move_op(type), src, dsts[i]);
+      if (staged[i] != args[i]) {
+        free_temporary(v, staged[i]);
+      }
+    }
+  }
+  free(staged);
+  free(dsts);
+  free(on_stack);
+  fprintf(v->out, "\tcallq\t%s\n", function->global_name);
+  if (stack_size) {
+    fprintf(v->out, "\taddq\t$%d, %%rsp\n", stack_size);
+  }
+
+  const Type *type = function->type->return_type;
+  if (!IS_SCALAR_TYPE(type)) {
+    x86_64_Value *ret = checked_calloc(1, sizeof(x86_64_Value));
+    ret->type = type;
+    ret->debug_name = fmtstr("%s()", function->debug_name);
+    return ret;
+  }
+  x86_64_Value *ret = new_temporary(v, type);
+  fprintf(v->out, BINARY_TEMPLATE, move_op(type), return_register(type), addr(v, ret), ret->debug_name,
+    fmtstr("%s()", function->debug_name));
+  return ret;
+}
+
+static void visit_label(x86_64_Visitor *v, const char *label) {
+  fprintf(v->out, "%s:\n", label);
+}
+
+static void visit_jump(x86_64_Visitor *v, const char *label) {
+  fprintf(v->out, "\tjmp\t%s\n", label);
+}
+
+/** A comparison is evaluated into the flags and branched on with jcc; anything else is compared with zero. */
+static void visit_branch(x86_64_Visitor *v, x86_64_Value *cond, int jump_if, const char *label) {
+  assert(IS_SCALAR_TYPE(cond->type));
+  if (cond->location_kind == LOC_IMMEDIATE) {
+    int is_true = is_float(cond->type) ? cond->float_immediate != 0 : cond->integer_immediate != 0;
+    if (is_true == !!jump_if) {
+      visit_jump(v, label);
+    }
+    return;
+  }
+  if (is_float(cond->type)) {
+    cond = visit_binop(v, TOK_NE_OP, cond, convert_type(v, visit_float_literal(v, 0), cond->type));
+  }
+  // Floating == and != need the parity flag as well, so they are computed into an int like other values.
+  int is_parity_test = cond->location_kind == LOC_EXPR && is_float(comparison_type(cond))
+    && (cond->expr.op == TOK_EQ_OP || cond->expr.op == TOK_NE_OP);
+  const char *cc;
+  if (cond->location_kind == LOC_EXPR && is_comparison(cond->expr.op) && !is_parity_test) {
+    v->flags_contents = cond;
+    release(v, evaluate(v, cond, cond->type));
+    v->flags_contents = 0;
+    TokenKind op = jump_if ? cond->expr.op : negate_comparison(cond->expr.op);
+    const Type *type = comparison_type(cond);
+    cc = condition_code(op, type->is_unsigned || is_float(type));
+  } else {
+    int size = cond->type->size;
+    x86_64_Value *val = cond->location_kind == LOC_EXPR ? evaluate(v, cond, cond->type) : cond;
+    if (val->location_kind == LOC_REGISTER) {
+      fprintf(v->out, "\t%s\t%s, %s\n", operator("test", size), addr(v, val), addr(v, val));
+    } else {
+      fprintf(v->out, "\t%s\t$0, %s\t\t# %s\n", operator("cmp", size), addr(v, val), val->debug_name);
+    }
+    release(v, val);
+    cc = jump_if ? "ne" : "e";
+  }
+  fprintf(v->out, "\tj%s\t%s\n", cc, label);
+}
+
+/** The value goes in the accumulator, where fprint_switch dispatches on it. */
+static void visit_switch(x86_64_Visitor *v, x86_64_Value *value, int n_cases, const int64_t *values,
+  const char **labels, const char *default_label) {
+  assert(value->type->kind == TY_INTEGER && value->type->size >= 4);
+  copy_to_accum(v, value);
+  SwitchCase *cases = checked_calloc(n_cases + 1, sizeof(SwitchCase));
+  for (int i = 0; i < n_cases; i++) {
+    cases[i] = (SwitchCase) { .value = values[i], .label = labels[i] };
+  }
+  switch_strategy(cases, n_cases, value->type->size);
+  fprint_switch(v->out, value->type->size, cases, n_cases, default_label, 0, new_label(v));
+  free(cases);
+}
+
+static void seal_label(x86_64_Visitor *v, const char *label) {
+}
+
 static void visit_return(x86_64_Visitor *v, x86_64_Value *retval) {
   copy_to_accum(v, retval);
   fputs("\tleave\n\tretq\n", v->out);
 }
 
+#define ZERO_PLACEHOLDER "# zero object "
+
+/** Clear size bytes of the frame, by stores or a string instruction according to block_strategy */
+static void emit_zero(x86_64_Visitor *v, FILE *out, int rbp_offset, int size) {
+  if (block_strategy(size) == BLOCK_INLINE) {
+    fprint_inline_zero(out, (MemRef) { .base = "%rbp", .disp = rbp_offset }, size, 0);
+    return;
+  }
+  // Objects are cleared between statements, when no scratch register holds a value.
+  fprintf(out, "\tleaq\t%d(%%rbp), %%rdi\n", rbp_offset);
+  fprint_block_zero(out, size, new_label(v));
+}
+
+/**
+ * Clear object before its initializer list is stored. Without optimization this is a memset of all of it. Otherwise a
+ * placeholder stands in until the end of the function, by when visit_assign_offset has recorded the bytes the
+ * initializer writes, and only the holes between them are cleared. Clearing them ahead of the stores is as good as
+ * clearing everything, as the two write different bytes.
+ */
 static void visit_zero_object(x86_64_Visitor *v, x86_64_Value *object) {
-  assert(!IS_SCALAR_TYPE(object->type));
-  void *size = visit_integer_literal(v, total_size(object->type));
-  fprintf(v->out, "\tleaq\t%s, %%rdi\n", addr(v, object));
-  fprintf(v->out, "\txorl\t%%esi, %%esi\n");
-  fprintf(v->out, "\tmovl\t%s, %%edx\n", addr(v, size));
-  fprintf(v->out, "\tcallq\t_memset\n");
+  assert(!IS_SCALAR_TYPE(object->type) && object->location_kind == LOC_STACK);
+  if (v->options.opt_level < 1) {
+    emit_zero(v, v->out, object->rbp_offset, total_size(object->type));
+    return;
+  }
+  ZeroedObject zeroed = { .object = object, .written = checked_calloc(total_size(object->type), 1) };
+  fprintf(v->out, "%s%d\n", ZERO_PLACEHOLDER, v->zeroed_objects_size);
+  APPEND_VECTOR(v->zeroed_objects, zeroed);
+}
+
+/** Replace the placeholders of visit_zero_object in the text of a function, returning the new text. */
+static char *fill_zero_placeholders(x86_64_Visitor *v, const char *text) {
+  char *ret;
+  size_t ret_size;
+  FILE *out = checked_open_memstream(&ret, &ret_size);
+  const char *p = text, *placeholder;
+  while ((placeholder = strstr(p, ZERO_PLACEHOLDER))) {
+    fwrite(p, 1, placeholder - p, out);
+    char *end;
+    ZeroedObject *zeroed = &v->zeroed_objects[strtol(placeholder + strlen(ZERO_PLACEHOLDER), &end, 10)];
+    p = end + 1;  // past the newline
+    int size = total_size(zeroed->object->type);
+    for (int start = 0; start < size; start++) {
+      if (zeroed->written[start])
+        continue;
+      int hole_end = start;
+      while (hole_end < size && !zeroed->written[hole_end]) {
+        hole_end++;
+      }
+      emit_zero(v, out, zeroed->object->rbp_offset + start, hole_end - start);
+      start = hole_end;
+    }
+  }
+  fputs(p, out);
+  checked_fclose(out);
+  return ret;
 }
 
 static void visit_assign_offset(x86_64_Visitor *v, x86_64_Value *aggregate, int offset, x86_64_Value *right) {
@@ -596,28 +1321,101 @@ static void visit_assign_offset(x86_64_Visitor *v, x86_64_Value *aggregate, int
   int size = right->type->size;
   assert(aggregate->location_kind == LOC_STACK);
   int total_rbp_offset = aggregate->rbp_offset + offset;
+  for (int i = v->zeroed_objects_size - 1; i >= 0; i--) {
+    ZeroedObject *zeroed = &v->zeroed_objects[i];
+    if (zeroed->object->rbp_offset == aggregate->rbp_offset) {
+      int n_bytes = MIN(size, total_size(aggregate->type) - offset);
+      memset(zeroed->written + offset, 1, n_bytes);
+      break;
+    }
+  }
 
   const char *src;
-  if (right->location_kind == LOC_IMMEDIATE) {
+  if (right->location_kind == LOC_IMMEDIATE && !is_float(right->type)) {
     src = addr(v, right);
   } else {
     copy_to_accum(v, right);
-    src = accum_register(size);
+    src = return_register(right->type);
   }
   fprintf(
     v->out,
     "\t%s\t%s,%d(%%rbp)\t\t# %s[..%d] = %s\n",
-    operator("mov", size), src, total_rbp_offset,
+    move_op(right->type), src, total_rbp_offset,
     aggregate->debug_name, offset, right->debug_name
   );
 }
 
+/**
+ * The literal pool of the function, after its text. Mach-O's literal sections let the linker merge equal constants
+ * across the whole program.
+ */
+static const char *literal_pool(x86_64_Visitor *v) {
+  const char *ret = "";
+  for (int i = 0; i < v->literals_size; i++) {
+    FloatLiteral *literal = &v->literals[i];
+    double value;
+    if (literal->size == 4) {
+      float narrow;
+      uint32_t bits = (uint32_t) literal->bits;
+      memcpy(&narrow, &bits, sizeof(narrow));
+      value = narrow;
+    } else {
+      memcpy(&value, &literal->bits, sizeof(value));
+    }
+    ret = fmtstr("%s\t.literal%d\n\t.p2align\t%d\nLCPI_%s_%d:\n\t.%s\t0x%llx\t\t# %g\n", ret, literal->size,
+      literal->size == 8 ? 3 : 2, v->curr_func_name, i, literal->size == 8 ? "quad" : "long",
+      (unsigned long long) literal->bits, value);
+  }
+  return fmtstr("%s\t.text\n", ret);
+}
+
 static void visit_function_end(x86_64_Visitor *v) {
   fputs("\tleave\n\tretq\n", v->out);
+  checked_fclose(v->out);
+  v->out = v->file_out;
+
+  char *body = v->function_text;
+  if (v->zeroed_objects_size) {
+    body = fill_zero_placeholders(v, v->function_text);
+    free(v->function_text);
+  }
+
+  // rsp is 16-byte aligned before the call, so after pushing the return address and rbp a frame of a multiple of 16
+  // keeps it aligned for any call in the body.
+  const char *reserve = v->frame_size ? fmtstr("\tsubq\t$%d, %%rsp\n", ROUND_UP(v->frame_size, 16)) : "";
+  checked_asprintf(
+    &v->function_text, "%s%s%s%s",
+    v->curr_func_is_static ? "" : fmtstr(export, v->curr_func_name),
+    fmtstr(prologue, v->curr_func_name), reserve, body
+  );
+  free(body);
+  if (v->options.opt_level >= 1) {
+    body = v->function_text;
+    v->function_text = peephole_optimize(body, &v->peephole_stats);
+    free(body);
+  }
+  if (v->literals_size) {
+    body = v->function_text;
+    checked_asprintf(&v->function_text, "%s%s", body, literal_pool(v));
+    free(body);
+  }
+  fputs(v->function_text, v->out);
+}
+
+static const char *function_text(x86_64_Visitor *v) {
+  return v->function_text;
+}
+
+static void visit_cached_function(x86_64_Visitor *v, const char *text) {
+  assert(v->out == v->file_out && "cannot replay a function inside another");
+  fputs(text, v->out);
 }
 
 static void finalize(x86_64_Visitor *v) {
-  checked_fclose(v->out);
+  checked_fclose(v->file_out);
+  if (v->options.opt_level >= 1) {
+    fprint_peephole_stats(stderr, &v->peephole_stats);
+  }
 }
 
 static void emit_comment(x86_64_Visitor *v, const char *fmt, ...) {
@@ -628,28 +1426,24 @@ static void emit_comment(x86_64_Visitor *v, const char *fmt, ...) {
   fprintf(v->out, "\n");
 }
 
-Visitor *new_x86_64_visitor(FILE *out) {
+Visitor *new_x86_64_visitor(FILE *out, const VisitorOptions *options) {
   x86_64_Visitor *v = checked_calloc(1, sizeof(x86_64_Visitor));
   INSTALL_VISITOR_METHODS(v)
 
-  // Create the primitive types
-  Visitor *super = (Visitor *) v;
-  super->char_type        = (Type) { .kind = TY_INTEGER, .size = 1,  .align = 1  };
-  super->short_type       = (Type) { .kind = TY_INTEGER, .size = 2,  .align = 2  };
-  super->int_type         = (Type) { .kind = TY_INTEGER, .size = 4,  .align = 4  };
-  super->long_type        = (Type) { .kind = TY_INTEGER, .size = 8,  .align = 8  };
-  super->long_long_type   = (Type) { .kind = TY_INTEGER, .size = 8,  .align = 8  };
-  super->float_type       = (Type) { .kind = TY_FLOAT,   .size = 4,  .align = 4  };
-  super->double_type      = (Type) { .kind = TY_FLOAT,   .size = 8,  .align = 8  };
-  super->long_double_type = (Type) { .kind = TY_FLOAT,   .size = 16, .align = 16 };
-  MAKE_ALL_UNSIGNED_TYPES(super);
-
-  v->curr_rbp_offset = 0;
+  init_lp64_types((Visitor *) v);
+
+  NEW_VECTOR(v->free_temporaries, sizeof(x86_64_Value *));
+  NEW_VECTOR(v->zeroed_objects, sizeof(ZeroedObject));
+  NEW_VECTOR(v->literals, sizeof(FloatLiteral));
   v->curr_temp_id = 0;
   v->out = out;
-  time_t curr_time = time(0);
-  char timebuf[27];
-  ctime_r(&curr_time, timebuf);
-  fprintf(v->out, "# KUI'S COMPILER at %s", timebuf);
+  v->file_out = out;
+  v->options = *options;
+  if (!v->options.no_timestamp) {
+    time_t curr_time = time(0);
+    char timebuf[27];
+    ctime_r(&curr_time, timebuf);
+    fprintf(v->out, "# KUI'S COMPILER at %s", timebuf);
+  }
   return (Visitor *) v;
 }